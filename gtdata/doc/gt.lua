@@ -11,5 +11,10 @@ for some program parts if implemented.
 Set the environment variable `GT_SEED` to an integer value to supply a seed for
 the random number generator. Can be overridden by the `-seed` option.
 
+Type checkers compiled from OBO files are cached in the directory given by
+the environment variable `GT_OBO_CACHE_DIR` (default:
+`$XDG_CACHE_HOME/genometools` or `~/.cache/genometools`). Set it to an empty
+value to disable the cache.
+
 Combinations are possible. Running the `gt` binary with `GT_ENV_OPTIONS=-help`
 shows all possible "environment options".]])
@@ -0,0 +1,32 @@
+#!/bin/sh
+
+# compare the running time and space peak of the induced suffix sorting
+# (gt dev sain) with the bucket sorting of gt suffixerator for different
+# numbers of threads
+
+set -e
+
+if test $# -lt 1
+then
+  echo "Usage: $0 <inputfile> [threads ...]"
+  exit 1
+fi
+
+inputfile=$1
+shift
+if test $# -eq 0
+then
+  set -- 1 4 16
+fi
+
+GTCALL="env GT_ENV_OPTIONS=-showtime GT_MEM_BOOKKEEPING=on bin/gt"
+bin/gt encseq encode -indexname sain-bench ${inputfile}
+for threads in $*
+do
+  echo "# sain threads=${threads}"
+  ${GTCALL} -j ${threads} dev sain -esq sain-bench
+  echo "# suffixerator threads=${threads}"
+  ${GTCALL} -j ${threads} suffixerator -suf -ii sain-bench \
+                                       -indexname sain-bench
+done
+rm -f sain-bench.*
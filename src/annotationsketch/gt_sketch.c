@@ -32,6 +32,7 @@
 #include "core/warning_api.h"
 #include "extended/add_introns_stream_api.h"
 #include "extended/bed_in_stream.h"
+#include "extended/feature_index_mapped_api.h"
 #include "extended/feature_index_memory_api.h"
 #include "extended/feature_stream_api.h"
 #include "extended/gff3_in_stream.h"
@@ -56,7 +57,7 @@ typedef struct {
        unsafe,
        force,
        use_streams;
-  GtStr *seqid, *format, *stylefile, *input;
+  GtStr *seqid, *format, *stylefile, *input, *writeindex;
   GtUword start,
                 end;
   unsigned int width;
@@ -69,6 +70,7 @@ static void* gt_sketch_arguments_new(void)
   arguments->format = gt_str_new();
   arguments->input = gt_str_new();
   arguments->stylefile = gt_str_new();
+  arguments->writeindex = gt_str_new();
   return arguments;
 }
 
@@ -80,6 +82,7 @@ static void gt_sketch_arguments_delete(void *tool_arguments)
   gt_str_delete(arguments->format);
   gt_str_delete(arguments->input);
   gt_str_delete(arguments->stylefile);
+  gt_str_delete(arguments->writeindex);
   gt_free(arguments);
 }
 
@@ -104,6 +107,7 @@ static GtOptionParser* gt_sketch_option_parser_new(void *tool_arguments)
     "gff",
     "bed",
     "gtf",
+    "index",
     NULL
   };
   gt_assert(arguments);
@@ -177,10 +181,19 @@ static GtOptionParser* gt_sketch_option_parser_new(void *tool_arguments)
 
   /* -input */
   option = gt_option_new_choice("input", "input data format\n"
-                                       "choose from gff|bed|gtf",
+                                       "choose from gff|bed|gtf|index\n"
+                                       "(index: a feature index file written "
+                                       "with -writeindex)",
                              arguments->input, inputs[0], inputs);
   gt_option_parser_add_option(op, option);
 
+  /* -writeindex */
+  option = gt_option_new_string("writeindex", "write the features read from "
+                                "the input files to the given feature index "
+                                "file, which can be drawn much faster with "
+                                "-input index", arguments->writeindex, NULL);
+  gt_option_parser_add_option(op, option);
+
   /* -addintrons */
   option = gt_option_new_bool("addintrons", "add intron features between "
                               "existing exon features (before drawing)",
@@ -219,7 +232,7 @@ static GtOptionParser* gt_sketch_option_parser_new(void *tool_arguments)
   return op;
 }
 
-static int gt_sketch_arguments_check(GT_UNUSED int rest_argc,
+static int gt_sketch_arguments_check(int rest_argc,
                                      void *tool_arguments,
                                      GT_UNUSED GtError *err)
 {
@@ -236,6 +249,19 @@ static int gt_sketch_arguments_check(GT_UNUSED int rest_argc,
                       arguments->start, arguments->end);
     had_err = -1;
   }
+  if (!had_err && strcmp(gt_str_get(arguments->input), "index") == 0) {
+    if (arguments->pipe || arguments->addintrons
+          || gt_str_length(arguments->writeindex) > 0) {
+      gt_error_set(err, "options -pipe, -addintrons and -writeindex cannot "
+                        "be used with -input index");
+      had_err = -1;
+    }
+    else if (rest_argc != 2) {
+      gt_error_set(err, "-input index requires exactly one feature index "
+                        "file");
+      had_err = -1;
+    }
+  }
 
   return had_err;
 }
@@ -289,7 +315,13 @@ static int gt_sketch_runner(int argc, const char **argv, int parsed_args,
   }
 
   file = argv[parsed_args];
-  if (!had_err) {
+  if (!had_err && strcmp(gt_str_get(arguments->input), "index") == 0) {
+    /* map the feature index file instead of parsing annotations */
+    features = gt_feature_index_mapped_new(argv[parsed_args + 1], err);
+    if (!features)
+      had_err = -1;
+  }
+  else if (!had_err) {
     /* create feature index */
     features = gt_feature_index_memory_new();
     parsed_args++;
@@ -340,6 +372,11 @@ static int gt_sketch_runner(int argc, const char **argv, int parsed_args,
     gt_node_stream_delete(sort_stream);
     gt_node_stream_delete(add_introns_stream);
     gt_node_stream_delete(in_stream);
+    if (!had_err && gt_str_length(arguments->writeindex) > 0) {
+      had_err = gt_feature_index_mapped_write(features,
+                                              gt_str_get(arguments->writeindex),
+                                              err);
+    }
   }
 
   if (!had_err) {
@@ -0,0 +1,254 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/arena.h"
+#include "core/ensure.h"
+#include "core/ma.h"
+
+/* the alignment of all blocks, which is also the granularity of the size
+   classes */
+#define GT_ARENA_ALIGNMENT      ((size_t) 16)
+#define GT_ARENA_NUM_OF_CLASSES 32
+/* blocks larger than this are allocated individually */
+#define GT_ARENA_MAX_SMALL      (GT_ARENA_ALIGNMENT * GT_ARENA_NUM_OF_CLASSES)
+#define GT_ARENA_CHUNKSIZE      ((size_t) 1 << 16)
+
+#define GT_ARENA_ROUNDUP(SIZE)\
+        (((SIZE) + GT_ARENA_ALIGNMENT - 1) & ~(GT_ARENA_ALIGNMENT - 1))
+
+typedef struct GtArenaChunk GtArenaChunk;
+
+/* the header of a chunk or an individually allocated block, padded to the
+   alignment */
+struct GtArenaChunk {
+  GtArenaChunk *prev,
+               *next;
+  size_t size;
+};
+
+#define GT_ARENA_HEADERSIZE GT_ARENA_ROUNDUP(sizeof (GtArenaChunk))
+
+typedef struct GtArenaFreeBlock {
+  struct GtArenaFreeBlock *next;
+} GtArenaFreeBlock;
+
+struct GtArena {
+  size_t chunksize,
+         nextfree,   /* offset of the next free byte in <chunks> */
+         chunkend;
+  GtArenaChunk *chunks, /* the current chunk is the first one */
+               *large;
+  GtArenaFreeBlock *freelists[GT_ARENA_NUM_OF_CLASSES];
+  GtUword size_in_use,
+          space_current,
+          space_peak;
+};
+
+static void arena_add_space(GtArena *arena, size_t size)
+{
+  arena->space_current += size;
+  if (arena->space_current > arena->space_peak)
+    arena->space_peak = arena->space_current;
+}
+
+GtArena* gt_arena_new(size_t chunksize)
+{
+  GtArena *arena = gt_calloc(1, sizeof *arena);
+  arena->chunksize = chunksize == 0 ? GT_ARENA_CHUNKSIZE
+                                    : GT_ARENA_ROUNDUP(chunksize);
+  if (arena->chunksize < GT_ARENA_MAX_SMALL)
+    arena->chunksize = GT_ARENA_MAX_SMALL;
+  return arena;
+}
+
+static void arena_new_chunk(GtArena *arena)
+{
+  GtArenaChunk *chunk = gt_malloc(GT_ARENA_HEADERSIZE + arena->chunksize);
+  chunk->size = arena->chunksize;
+  chunk->prev = NULL;
+  chunk->next = arena->chunks;
+  if (arena->chunks != NULL)
+    arena->chunks->prev = chunk;
+  arena->chunks = chunk;
+  arena->nextfree = GT_ARENA_HEADERSIZE;
+  arena->chunkend = GT_ARENA_HEADERSIZE + chunk->size;
+  arena_add_space(arena, GT_ARENA_HEADERSIZE + chunk->size);
+}
+
+void* gt_arena_alloc(GtArena *arena, size_t size)
+{
+  size_t rounded;
+  void *ptr;
+
+  gt_assert(arena);
+  rounded = GT_ARENA_ROUNDUP(size == 0 ? 1 : size);
+  if (rounded > GT_ARENA_MAX_SMALL) {
+    GtArenaChunk *block = gt_malloc(GT_ARENA_HEADERSIZE + rounded);
+    block->size = rounded;
+    block->prev = NULL;
+    block->next = arena->large;
+    if (arena->large != NULL)
+      arena->large->prev = block;
+    arena->large = block;
+    arena_add_space(arena, GT_ARENA_HEADERSIZE + rounded);
+    arena->size_in_use += rounded;
+    return (char *) block + GT_ARENA_HEADERSIZE;
+  } else {
+    const size_t sizeclass = rounded / GT_ARENA_ALIGNMENT - 1;
+
+    if (arena->freelists[sizeclass] != NULL) {
+      ptr = arena->freelists[sizeclass];
+      arena->freelists[sizeclass] = arena->freelists[sizeclass]->next;
+    } else {
+      if (arena->chunks == NULL || arena->nextfree + rounded > arena->chunkend)
+        arena_new_chunk(arena);
+      ptr = (char *) arena->chunks + arena->nextfree;
+      arena->nextfree += rounded;
+    }
+    arena->size_in_use += rounded;
+    return ptr;
+  }
+}
+
+void* gt_arena_calloc(GtArena *arena, size_t nmemb, size_t size)
+{
+  void *ptr = gt_arena_alloc(arena, nmemb * size);
+  memset(ptr, 0, nmemb * size);
+  return ptr;
+}
+
+void gt_arena_free(GtArena *arena, void *ptr, size_t size)
+{
+  size_t rounded;
+
+  gt_assert(arena);
+  if (ptr == NULL) return;
+  rounded = GT_ARENA_ROUNDUP(size == 0 ? 1 : size);
+  gt_assert(arena->size_in_use >= rounded);
+  arena->size_in_use -= rounded;
+  if (rounded > GT_ARENA_MAX_SMALL) {
+    GtArenaChunk *block = (GtArenaChunk *) ((char *) ptr - GT_ARENA_HEADERSIZE);
+    gt_assert(block->size == rounded);
+    if (block->prev != NULL)
+      block->prev->next = block->next;
+    else
+      arena->large = block->next;
+    if (block->next != NULL)
+      block->next->prev = block->prev;
+    gt_assert(arena->space_current >= GT_ARENA_HEADERSIZE + rounded);
+    arena->space_current -= GT_ARENA_HEADERSIZE + rounded;
+    gt_free(block);
+  } else {
+    const size_t sizeclass = rounded / GT_ARENA_ALIGNMENT - 1;
+    GtArenaFreeBlock *block = ptr;
+
+    block->next = arena->freelists[sizeclass];
+    arena->freelists[sizeclass] = block;
+  }
+}
+
+static void arena_free_list(GtArenaChunk *chunk)
+{
+  while (chunk != NULL) {
+    GtArenaChunk *next = chunk->next;
+    gt_free(chunk);
+    chunk = next;
+  }
+}
+
+void gt_arena_reset(GtArena *arena)
+{
+  gt_assert(arena);
+  arena_free_list(arena->large);
+  arena->large = NULL;
+  if (arena->chunks != NULL) {
+    /* keep the most recent chunk */
+    arena_free_list(arena->chunks->next);
+    arena->chunks->next = NULL;
+    arena->nextfree = GT_ARENA_HEADERSIZE;
+    arena->space_current = GT_ARENA_HEADERSIZE + arena->chunks->size;
+  } else {
+    arena->space_current = 0;
+  }
+  memset(arena->freelists, 0, sizeof arena->freelists);
+  arena->size_in_use = 0;
+}
+
+GtUword gt_arena_size_in_use(const GtArena *arena)
+{
+  gt_assert(arena);
+  return arena->size_in_use;
+}
+
+GtUword gt_arena_space_peak(const GtArena *arena)
+{
+  gt_assert(arena);
+  return arena->space_peak;
+}
+
+void gt_arena_delete(GtArena *arena)
+{
+  if (!arena) return;
+  arena_free_list(arena->large);
+  arena_free_list(arena->chunks);
+  gt_free(arena);
+}
+
+int gt_arena_unit_test(GtError *err)
+{
+  const size_t sizes[] = {1, 7, 16, 17, 100, 512, 513, 4000};
+  const GtUword numofsizes = sizeof sizes / sizeof sizes[0];
+  GtArena *arena;
+  unsigned char *blocks[64];
+  GtUword idx, round, peak;
+  int had_err = 0;
+
+  gt_error_check(err);
+  arena = gt_arena_new(1024);
+  for (round = 0; !had_err && round < 3UL; round++) {
+    /* fill blocks of different sizes with their index and check that they
+       do not overlap */
+    for (idx = 0; idx < 64UL; idx++) {
+      const size_t size = sizes[idx % numofsizes];
+      blocks[idx] = idx % 2 ? gt_arena_calloc(arena, 1, size)
+                            : gt_arena_alloc(arena, size);
+      gt_ensure(((size_t) blocks[idx]) % GT_ARENA_ALIGNMENT == 0);
+      memset(blocks[idx], (int) idx, size);
+    }
+    for (idx = 0; !had_err && idx < 64UL; idx++) {
+      const size_t size = sizes[idx % numofsizes];
+      gt_ensure(blocks[idx][0] == (unsigned char) idx &&
+                blocks[idx][size - 1] == (unsigned char) idx);
+    }
+    /* freed small blocks are reused for the same size class */
+    if (!had_err) {
+      unsigned char *reused;
+
+      gt_arena_free(arena, blocks[2], sizes[2]);
+      reused = gt_arena_alloc(arena, sizes[2] - 1);
+      gt_ensure(reused == blocks[2]);
+      gt_arena_free(arena, blocks[7], sizes[7]);
+      gt_arena_free(arena, reused, sizes[2] - 1);
+    }
+    peak = gt_arena_space_peak(arena);
+    gt_arena_reset(arena);
+    gt_ensure(gt_arena_size_in_use(arena) == 0);
+    gt_ensure(peak > 0 && gt_arena_space_peak(arena) == peak);
+  }
+  gt_arena_delete(arena);
+  return had_err;
+}
@@ -0,0 +1,54 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdlib.h>
+#include "core/error_api.h"
+#include "core/types_api.h"
+
+/* A <GtArena> hands out memory blocks carved from large chunks. It is meant
+   to be owned by a single thread (e.g., one stage of a stream pipeline), so it
+   does not use any locks, and the memory management (including the memory
+   bookkeeping) only sees the chunks instead of every single block.
+   Small blocks given back by <gt_arena_free()> are kept in free lists per size
+   class and reused by later allocations of the same class. All blocks are
+   released at once by <gt_arena_reset()> or <gt_arena_delete()>. */
+typedef struct GtArena GtArena;
+
+/* Return a new <GtArena> allocating chunks of <chunksize> bytes (a default
+   size is used if <chunksize> is 0). */
+GtArena* gt_arena_new(size_t chunksize);
+/* Return a block of <size> bytes from <arena>, aligned for all basic types. */
+void*    gt_arena_alloc(GtArena *arena, size_t size);
+/* Return a block for <nmemb> elements of <size> bytes, initialized to 0. */
+void*    gt_arena_calloc(GtArena *arena, size_t nmemb, size_t size);
+/* Give the block <ptr> of <size> bytes (as requested from <arena>) back for
+   reuse. */
+void     gt_arena_free(GtArena *arena, void *ptr, size_t size);
+/* Release all blocks of <arena> at once. The first chunk is kept. */
+void     gt_arena_reset(GtArena *arena);
+/* Return the number of bytes in the blocks of <arena> currently in use. */
+GtUword  gt_arena_size_in_use(const GtArena *arena);
+/* Return the maximum number of bytes <arena> has obtained from the memory
+   management since its creation. */
+GtUword  gt_arena_space_peak(const GtArena *arena);
+void     gt_arena_delete(GtArena *arena);
+
+int      gt_arena_unit_test(GtError *err);
+
+#endif
@@ -0,0 +1,59 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef ATOMIC_H
+#define ATOMIC_H
+
+/* Atomic operations on integer variables pointed to by <PTR>. They are used
+   for counters which are too frequently updated to be guarded by a <GtMutex>
+   (e.g., reference counts of small objects). If threads are not enabled,
+   plain operations are used. */
+
+#ifdef GT_THREADS_ENABLED
+
+/* Increment <*PTR> and return the new value. */
+#define gt_atomic_increment(PTR) \
+        __sync_add_and_fetch(PTR, 1)
+/* Decrement <*PTR> and return the value it had before. */
+#define gt_atomic_fetch_and_decrement(PTR) \
+        __sync_fetch_and_sub(PTR, 1)
+/* Add <VALUE> to <*PTR> and return the new value. */
+#define gt_atomic_add(PTR, VALUE) \
+        __sync_add_and_fetch(PTR, VALUE)
+/* Subtract <VALUE> from <*PTR> and return the new value. */
+#define gt_atomic_subtract(PTR, VALUE) \
+        __sync_sub_and_fetch(PTR, VALUE)
+/* Set <*PTR> to <NEWVALUE> if it equals <OLDVALUE>. Returns true if the
+   value was set. */
+#define gt_atomic_compare_and_swap(PTR, OLDVALUE, NEWVALUE) \
+        __sync_bool_compare_and_swap(PTR, OLDVALUE, NEWVALUE)
+
+#else
+
+#define gt_atomic_increment(PTR) \
+        (++(*(PTR)))
+#define gt_atomic_fetch_and_decrement(PTR) \
+        ((*(PTR))--)
+#define gt_atomic_add(PTR, VALUE) \
+        ((*(PTR)) += (VALUE))
+#define gt_atomic_subtract(PTR, VALUE) \
+        ((*(PTR)) -= (VALUE))
+#define gt_atomic_compare_and_swap(PTR, OLDVALUE, NEWVALUE) \
+        (*(PTR) == (OLDVALUE) ? (*(PTR) = (NEWVALUE), true) : false)
+
+#endif
+
+#endif
@@ -73,6 +73,7 @@ static void remove_bioseq_files(GtBioseq *bs)
   remove_indexfile(GT_SDSTABFILESUFFIX, gt_str_get(base));
   remove_indexfile(GT_MD5TABFILESUFFIX, gt_str_get(base));
   remove_indexfile(GT_OISTABFILESUFFIX, gt_str_get(base));
+  remove_indexfile(GT_BCSTABFILESUFFIX, gt_str_get(base));
   gt_str_delete(base);
 }
 
@@ -85,6 +86,7 @@ static void remove_bioseq_files_sig(int sigraised)
   remove_indexfile(GT_SDSTABFILESUFFIX, gt_bioseq_index_filename);
   remove_indexfile(GT_MD5TABFILESUFFIX, gt_bioseq_index_filename);
   remove_indexfile(GT_OISTABFILESUFFIX, gt_bioseq_index_filename);
+  remove_indexfile(GT_BCSTABFILESUFFIX, gt_bioseq_index_filename);
   (void) gt_xsignal(sigraised, SIG_DFL);
   gt_xraise(sigraised);
 }
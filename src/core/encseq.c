@@ -23,6 +23,7 @@
 #include <limits.h>
 #include <errno.h>
 #include <ctype.h>
+#include <string.h>
 #include "core/alphabet.h"
 #include "core/array.h"
 #include "core/arraydef.h"
@@ -57,6 +58,8 @@
 #include "core/sequence_buffer_fasta.h"
 #include "core/sequence_buffer_plain.h"
 #include "core/str.h"
+#include "core/thread_api.h"
+#include "core/thread_pool.h"
 #include "core/timer_api.h"
 #include "core/types_api.h"
 #include "core/undef_api.h"
@@ -65,6 +68,12 @@
 #include "core/xposix.h"
 #include "core/yarandom.h"
 
+#if defined (__SSE2__) && defined (__GNUC__) && \
+    (defined (_LP64) || defined (_WIN64))
+#include <emmintrin.h>
+#define GT_ENCSEQ_DECODE_SSE2
+#endif
+
 #undef GT_RANGEDEBUG
 
 /* The following implements the access functions to the bit encoding */
@@ -129,6 +138,181 @@ void gt_encseq_plainseq2bytecode(GtUchar *bytecode,
   }
 }
 
+/* For GT_ACCESS_TYPE_BLOCKCOMPRESS the sequence is stored as a list of
+   phrases, similar to relative Lempel-Ziv compression. The characters of the
+   alphabet are bit packed into a store of literals. Each phrase covers a
+   substring of the sequence which is a copy of a substring of the store.
+   Literals are only added to the store if the encoder finds no long enough
+   copy of the next characters in the store, so a sequence similar to an
+   earlier one (e.g. a further genome of a pan-genome collection) mainly
+   costs its phrases. Special characters are stored as ranges and are
+   represented by character 0 in the phrases. The start positions and
+   sources of the phrases, the special ranges and the literals are bit
+   packed into the .bcs file, their numbers are stored in the .esq file.
+
+   At load time the phrase and the special range at every
+   2^<GT_ENCSEQ_PHRASESAMPLE_LOG>-th position are sampled, which restricts
+   the binary searches for random access. Each <GtEncseqReader> keeps its
+   current phrase and special range, so sequential scans do not search at
+   all. No access needs a lock. */
+
+#define GT_ENCSEQ_PHRASESAMPLE_LOG 16
+
+static inline uint64_t blockcompress_value(const uint64_t *words,
+                                           unsigned int width, GtUword idx)
+{
+  const GtUword bitpos = idx * width;
+  const unsigned int shift = (unsigned int) (bitpos & 63);
+  uint64_t value = words[bitpos >> 6] >> shift;
+
+  if (shift + width > 64U)
+    value |= words[(bitpos >> 6) + 1] << (64U - shift);
+  return (width < 64U) ? (value & ((((uint64_t) 1) << width) - 1)) : value;
+}
+
+static inline GtUword blockcompress_phrasestart(const GtEncseq *encseq,
+                                                GtUword phrasenum)
+{
+  return (GtUword) blockcompress_value(encseq->phrasestarts,
+                                       encseq->positionbits, phrasenum);
+}
+
+static inline GtUword blockcompress_phraseend(const GtEncseq *encseq,
+                                              GtUword phrasenum)
+{
+  return (phrasenum + 1 < encseq->numofphrases)
+         ? blockcompress_phrasestart(encseq, phrasenum + 1)
+         : encseq->totallength;
+}
+
+static inline GtUword blockcompress_specialstart(const GtEncseq *encseq,
+                                                 GtUword specialnum)
+{
+  return (GtUword) blockcompress_value(encseq->specialstarts,
+                                       encseq->positionbits, specialnum);
+}
+
+/* the lowest bit tells whether the range consists of separators, the other
+   bits store the length minus one */
+static inline GtUword blockcompress_speciallength(const GtEncseq *encseq,
+                                                  GtUword specialnum)
+{
+  return (GtUword) (blockcompress_value(encseq->speciallengths,
+                                        encseq->speciallengthbits + 1,
+                                        specialnum) >> 1) + 1;
+}
+
+static inline GtUchar blockcompress_specialchar(const GtEncseq *encseq,
+                                                GtUword specialnum)
+{
+  return (blockcompress_value(encseq->speciallengths,
+                              encseq->speciallengthbits + 1,
+                              specialnum) & 1)
+         ? (GtUchar) SEPARATOR
+         : (GtUchar) WILDCARD;
+}
+
+/* Return the number of the phrase covering position <pos>. */
+static GtUword blockcompress_findphrase(const GtEncseq *encseq, GtUword pos)
+{
+  const GtUword sample = pos >> GT_ENCSEQ_PHRASESAMPLE_LOG;
+  GtUword left = encseq->phrasesample[sample],
+          right = encseq->phrasesample[sample + 1];
+
+  gt_assert(pos < encseq->totallength);
+  while (left < right) {
+    GtUword mid = left + (right - left + 1) / 2;
+
+    if (blockcompress_phrasestart(encseq, mid) <= pos)
+      left = mid;
+    else
+      right = mid - 1;
+  }
+  return left;
+}
+
+/* Return the number of special ranges starting at or before <pos>. */
+static GtUword blockcompress_findspecial(const GtEncseq *encseq, GtUword pos)
+{
+  const GtUword sample = pos >> GT_ENCSEQ_PHRASESAMPLE_LOG;
+  GtUword left = encseq->specialsample[sample],
+          right = encseq->specialsample[sample + 1];
+
+  gt_assert(pos < encseq->totallength);
+  while (left < right) {
+    GtUword mid = left + (right - left) / 2;
+
+    if (blockcompress_specialstart(encseq, mid) <= pos)
+      left = mid + 1;
+    else
+      right = mid;
+  }
+  return left;
+}
+
+/* Return the character at position <pos>. <*phrasenum> and <*specialnum>
+   are the results of <blockcompress_findphrase> and
+   <blockcompress_findspecial> for a position near <pos> or GT_UNDEF_UWORD,
+   they are updated for <pos>. */
+static inline GtUchar blockcompress_char(const GtEncseq *encseq,
+                                         GtUword *phrasenum,
+                                         GtUword *specialnum,
+                                         GtUword pos)
+{
+  GtUword start;
+
+  if (encseq->numofspecialranges > 0) {
+    if (*specialnum == GT_UNDEF_UWORD)
+      *specialnum = blockcompress_findspecial(encseq, pos);
+    else if (*specialnum < encseq->numofspecialranges &&
+             blockcompress_specialstart(encseq, *specialnum) <= pos) {
+      (*specialnum)++;
+      if (*specialnum < encseq->numofspecialranges &&
+          blockcompress_specialstart(encseq, *specialnum) <= pos)
+        *specialnum = blockcompress_findspecial(encseq, pos);
+    }
+    else if (*specialnum > 0 &&
+             blockcompress_specialstart(encseq, *specialnum - 1) > pos) {
+      (*specialnum)--;
+      if (*specialnum > 0 &&
+          blockcompress_specialstart(encseq, *specialnum - 1) > pos)
+        *specialnum = blockcompress_findspecial(encseq, pos);
+    }
+    if (*specialnum > 0 &&
+        pos < blockcompress_specialstart(encseq, *specialnum - 1) +
+              blockcompress_speciallength(encseq, *specialnum - 1))
+      return blockcompress_specialchar(encseq, *specialnum - 1);
+  }
+  if (*phrasenum == GT_UNDEF_UWORD)
+    *phrasenum = blockcompress_findphrase(encseq, pos);
+  else if (pos < blockcompress_phrasestart(encseq, *phrasenum)) {
+    (*phrasenum)--;
+    if (pos < blockcompress_phrasestart(encseq, *phrasenum))
+      *phrasenum = blockcompress_findphrase(encseq, pos);
+  }
+  else if (pos >= blockcompress_phraseend(encseq, *phrasenum)) {
+    (*phrasenum)++;
+    if (pos >= blockcompress_phraseend(encseq, *phrasenum))
+      *phrasenum = blockcompress_findphrase(encseq, pos);
+  }
+  start = blockcompress_phrasestart(encseq, *phrasenum);
+  return (GtUchar) blockcompress_value(encseq->literals, encseq->literalbits,
+                                       (GtUword)
+                                       blockcompress_value(
+                                                        encseq->phrasesources,
+                                                        encseq->sourcebits,
+                                                        *phrasenum)
+                                       + pos - start);
+}
+
+static GtUchar delivercharViablockcompress(const GtEncseq *encseq,
+                                           GtUword pos)
+{
+  GtUword phrasenum = GT_UNDEF_UWORD, specialnum = GT_UNDEF_UWORD;
+
+  return blockcompress_char(encseq, &phrasenum, &specialnum, pos);
+}
+
 static void encseq2bytecode(GtUchar *dest,
                             const GtEncseq *encseq,
                             const GtUword startindex,
@@ -202,6 +386,18 @@ static void encseq2bytecode(GtUchar *dest,
                 | (GtUchar) (bitpackarray_get_uint32(encseq->bitpackarray,
                                                      (BitOffset) i+2) << 2);
     }
+  } else if (encseq->sat == GT_ACCESS_TYPE_BLOCKCOMPRESS) {
+    GtUword phrasenum = GT_UNDEF_UWORD, specialnum = GT_UNDEF_UWORD;
+    GtUchar cc;
+
+    for (i = 0; i < len; i++) {
+      if (GT_MOD4(i) == 0)
+        dest[GT_DIV4(i)] = 0;
+      cc = blockcompress_char(encseq, &phrasenum, &specialnum,
+                              startindex + i);
+      if (ISNOTSPECIAL(cc))
+        dest[GT_DIV4(i)] |= (GtUchar) ((cc & 3U) << (6 - GT_MULT2(GT_MOD4(i))));
+    }
   }
 }
 
@@ -318,6 +514,13 @@ GtUchar gt_encseq_get_encoded_char(const GtEncseq *encseq,
     gt_assert(!GT_ISDIRCOMPLEMENT(readmode));
     return delivercharViabytecompress(encseq, pos);
   }
+  else if (encseq->sat == GT_ACCESS_TYPE_BLOCKCOMPRESS) {
+    GtUchar cc = delivercharViablockcompress(encseq, pos);
+
+    return (ISNOTSPECIAL(cc) && GT_ISDIRCOMPLEMENT(readmode))
+           ? GT_COMPLEMENTBASE(cc)
+           : cc;
+  }
   else {
     GtUchar cc;
 
@@ -404,6 +607,14 @@ GtUchar gt_encseq_get_encoded_char_nospecial(const GtEncseq *encseq,
     gt_assert(!GT_ISDIRCOMPLEMENT(readmode));
     return delivercharViabytecompress(encseq, pos);
   }
+  else if (encseq->sat == GT_ACCESS_TYPE_BLOCKCOMPRESS) {
+    GtUchar cc = delivercharViablockcompress(encseq, pos);
+
+    gt_assert(ISNOTSPECIAL(cc));
+    return GT_ISDIRCOMPLEMENT(readmode)
+           ? GT_COMPLEMENTBASE(cc)
+           : cc;
+  }
   else {
     GtUchar cc;
     gt_assert(encseq->sat == GT_ACCESS_TYPE_DIRECTACCESS);
@@ -495,6 +706,9 @@ struct GtEncseqReader
   bool startedonmiddle;
   GtEncseqReaderViatablesinfo *wildcardrangestate,
                               *ssptabstate;
+  /* only for GT_ACCESS_TYPE_BLOCKCOMPRESS */
+  GtUword phrasenum, /* phrase and special range of the last position */
+          specialnum;
 };
 
 typedef enum
@@ -722,15 +936,11 @@ void gt_encseq_extract_encoded_with_reader(GtEncseqReader *esr,
                                GtUword frompos,
                                GtUword topos)
 {
-  GtUword idx, pos;
-
   gt_assert(frompos <= topos && encseq != NULL &&
             topos < encseq->logicaltotallength && buffer != NULL);
   gt_encseq_reader_reinit_with_readmode(esr, encseq, GT_READMODE_FORWARD,
                                         frompos);
-  for (pos=frompos, idx = 0; pos <= topos; pos++, idx++) {
-    buffer[idx] = gt_encseq_reader_next_encoded_char(esr);
-  }
+  gt_encseq_reader_next_encoded_chars(esr, buffer, topos - frompos + 1);
 }
 
 void gt_encseq_extract_encoded(const GtEncseq *encseq,
@@ -739,16 +949,13 @@ void gt_encseq_extract_encoded(const GtEncseq *encseq,
                                GtUword topos)
 {
   GtEncseqReader *esr;
-  GtUword idx, pos;
 
   gt_assert(frompos <= topos && encseq != NULL &&
             topos < encseq->logicaltotallength && buffer != NULL);
   esr = gt_encseq_create_reader_with_readmode(encseq,
                                               GT_READMODE_FORWARD,
                                               frompos);
-  for (pos=frompos, idx = 0; pos <= topos; pos++, idx++) {
-    buffer[idx] = gt_encseq_reader_next_encoded_char(esr);
-  }
+  gt_encseq_reader_next_encoded_chars(esr, buffer, topos - frompos + 1);
   gt_encseq_reader_delete(esr);
 }
 
@@ -788,6 +995,20 @@ void gt_encseq_extract_decoded(const GtEncseq *encseq,
   gt_encseq_reader_delete(esr);
 }
 
+void gt_encseq_madvise(const GtEncseq *encseq, GtFaAdvice advice)
+{
+  gt_assert(encseq != NULL);
+  gt_fa_madvise(encseq->mappedptr, advice);
+  gt_fa_madvise(encseq->ssptabmappedptr, advice);
+  gt_fa_madvise(encseq->oistabmappedptr, advice);
+  if (!encseq->hasallocatedblockcompressspace)
+    gt_fa_madvise(encseq->blockcompressspace, advice);
+  if (!encseq->hasallocateddestab)
+    gt_fa_madvise((void *) encseq->destab, advice);
+  if (!encseq->hasallocatedsdstab)
+    gt_fa_madvise((void *) encseq->sdstab, advice);
+}
+
 const char* gt_encseq_accessname(const GtEncseq *encseq)
 {
   gt_assert(encseq != NULL);
@@ -817,7 +1038,7 @@ bool gt_encseq_has_twobitencoding(const GtEncseq *encseq)
 {
   gt_assert(encseq != NULL);
   return (encseq->accesstype_via_utables ||
-          encseq->sat >= GT_ACCESS_TYPE_EQUALLENGTH ||
+          encseq->sat == GT_ACCESS_TYPE_EQUALLENGTH ||
           encseq->sat == GT_ACCESS_TYPE_BITACCESS) ? true : false;
 }
 
@@ -1397,6 +1618,9 @@ static void gt_encseq_assign_sequence_mapspec(GtMapspec *mapspec,
                                encseq->totallength,
                                encseq->sat);
       break;
+    case GT_ACCESS_TYPE_BLOCKCOMPRESS:
+      gt_mapspec_add_uint64(mapspec, encseq->blockcompresssizes, 4UL);
+      break;
     default: break;
   }
 }
@@ -1990,6 +2214,9 @@ void gt_encseq_delete(GtEncseq *encseq)
         gt_free(encseq->wildcardrangetable.st_uint32.endidxinpage);
         gt_free(encseq->wildcardrangetable.st_uint32.rangelengths);
         break;
+      case GT_ACCESS_TYPE_BLOCKCOMPRESS:
+        gt_free(encseq->blockcompresssizes);
+        break;
       default: break;
     }
     if (encseq->has_exceptiontable) {
@@ -2004,6 +2231,17 @@ void gt_encseq_delete(GtEncseq *encseq)
     gt_fa_xmunmap(encseq->ssptabmappedptr);
   if (encseq->oistabmappedptr != NULL)
     gt_fa_xmunmap(encseq->oistabmappedptr);
+  if (encseq->blockcompressspace != NULL) {
+    if (encseq->hasallocatedblockcompressspace)
+      gt_free(encseq->blockcompressspace);
+    else
+      gt_fa_xmunmap(encseq->blockcompressspace);
+  }
+  gt_free(encseq->phrasesample);
+  gt_free(encseq->specialsample);
+  encseq->blockcompresssizes = NULL;
+  encseq->blockcompressspace = NULL;
+  encseq->phrasesample = encseq->specialsample = NULL;
   encseq->headerptr.characterdistribution = NULL;
   encseq->plainseq = NULL;
   encseq->specialbits = NULL;
@@ -2516,6 +2754,699 @@ static bool issinglepositionseparatorViabytecompress(const GtEncseq *encseq,
              : false;
 }
 
+/* GT_ACCESS_TYPE_BLOCKCOMPRESS */
+
+/* number of characters parsed into phrases at once */
+#define GT_ENCSEQ_PHRASECHUNK       (1UL << 20)
+/* every <GT_ENCSEQ_KMERSTEP>-th position of the store is added to the
+   k-mer table used to find copies */
+#define GT_ENCSEQ_KMERSTEP          16UL
+#define GT_ENCSEQ_KMERTABLEBITS_MIN 12U
+#define GT_ENCSEQ_KMERTABLEBITS_MAX 22U
+
+static unsigned int blockcompress_bits(GtUword maxvalue)
+{
+  unsigned int bits = gt_determinebitspervalue(maxvalue);
+
+  return (bits > 0) ? bits : 1U;
+}
+
+static GtUword blockcompress_words(GtUword numofvalues, unsigned int width)
+{
+  return (numofvalues * width + 63) / 64;
+}
+
+static void blockcompress_setvalue(uint64_t *words, unsigned int width,
+                                   GtUword idx, uint64_t value)
+{
+  const GtUword bitpos = idx * width;
+  const unsigned int shift = (unsigned int) (bitpos & 63);
+  const uint64_t mask = (width < 64U) ? (((uint64_t) 1) << width) - 1
+                                      : ~((uint64_t) 0);
+
+  words[bitpos >> 6] = (words[bitpos >> 6] & ~(mask << shift)) |
+                       (value << shift);
+  if (shift + width > 64U)
+    words[(bitpos >> 6) + 1] = (words[(bitpos >> 6) + 1] &
+                                ~(mask >> (64U - shift))) |
+                               (value >> (64U - shift));
+}
+
+typedef struct
+{
+  GtUword start, length;
+  GtUchar cc;
+} GtPhraseencoderSpecialrange;
+
+typedef struct
+{
+  uint64_t *literals;
+  GtUword *phrasestarts,
+          *phrasesources,
+          numofphrases,
+          allocatedphrases,
+          numofspecialranges,
+          allocatedspecialranges,
+          numofliterals,
+          allocatedliterals, /* number of words */
+          sourceend, /* end of the store part copied by the last phrase */
+          openliterals, /* number of literals added by the last phrase */
+          *kmertable;
+  GtPhraseencoderSpecialrange *specialranges;
+  GtWord diagonal; /* store position minus sequence position of last copy */
+  bool hasdiagonal;
+  unsigned int literalbits,
+               kmersize,
+               kmertablebits,
+               minmatchlength;
+} GtPhraseencoder;
+
+static void phraseencoder_init(GtPhraseencoder *pe, unsigned int numofchars,
+                               GtUword totallength)
+{
+  pe->literals = NULL;
+  pe->phrasestarts = pe->phrasesources = NULL;
+  pe->numofphrases = pe->allocatedphrases = 0;
+  pe->specialranges = NULL;
+  pe->numofspecialranges = pe->allocatedspecialranges = 0;
+  pe->numofliterals = pe->allocatedliterals = 0;
+  pe->sourceend = GT_UNDEF_UWORD;
+  pe->openliterals = 0;
+  pe->diagonal = 0;
+  pe->hasdiagonal = false;
+  pe->literalbits = blockcompress_bits((GtUword) numofchars - 1);
+  /* a k-mer fills 32 bits, a copy replaces at least 64 bits of literals */
+  pe->kmersize = 32U / pe->literalbits;
+  pe->minmatchlength = 64U / pe->literalbits;
+  pe->kmertablebits = GT_ENCSEQ_KMERTABLEBITS_MIN;
+  while (pe->kmertablebits < GT_ENCSEQ_KMERTABLEBITS_MAX &&
+         (GT_ENCSEQ_KMERSTEP << pe->kmertablebits) < totallength)
+    pe->kmertablebits++;
+  pe->kmertable = gt_calloc((size_t) 1 << pe->kmertablebits,
+                            sizeof (*pe->kmertable));
+}
+
+static void phraseencoder_delete(GtPhraseencoder *pe)
+{
+  gt_free(pe->literals);
+  gt_free(pe->phrasestarts);
+  gt_free(pe->phrasesources);
+  gt_free(pe->specialranges);
+  gt_free(pe->kmertable);
+}
+
+static void phraseencoder_addphrase(GtPhraseencoder *pe, GtUword startpos,
+                                    GtUword source)
+{
+  if (pe->numofphrases == pe->allocatedphrases) {
+    pe->allocatedphrases += pe->allocatedphrases/2 + 1024UL;
+    pe->phrasestarts = gt_realloc(pe->phrasestarts,
+                                  sizeof (*pe->phrasestarts) *
+                                  pe->allocatedphrases);
+    pe->phrasesources = gt_realloc(pe->phrasesources,
+                                   sizeof (*pe->phrasesources) *
+                                   pe->allocatedphrases);
+  }
+  pe->phrasestarts[pe->numofphrases] = startpos;
+  pe->phrasesources[pe->numofphrases++] = source;
+}
+
+static void phraseencoder_addspecial(GtPhraseencoder *pe, GtUword pos,
+                                     GtUchar cc)
+{
+  GtPhraseencoderSpecialrange *last = (pe->numofspecialranges > 0)
+                                      ? pe->specialranges +
+                                        pe->numofspecialranges - 1
+                                      : NULL;
+
+  if (last != NULL && last->cc == cc && last->start + last->length == pos) {
+    last->length++;
+    return;
+  }
+  if (pe->numofspecialranges == pe->allocatedspecialranges) {
+    pe->allocatedspecialranges += pe->allocatedspecialranges/2 + 1024UL;
+    pe->specialranges = gt_realloc(pe->specialranges,
+                                   sizeof (*pe->specialranges) *
+                                   pe->allocatedspecialranges);
+  }
+  pe->specialranges[pe->numofspecialranges].start = pos;
+  pe->specialranges[pe->numofspecialranges].length = 1UL;
+  pe->specialranges[pe->numofspecialranges++].cc = cc;
+}
+
+static GtUword phraseencoder_kmerslot(const GtPhraseencoder *pe,
+                                      uint64_t kmer)
+{
+  return (GtUword) ((kmer * 0x9E3779B97F4A7C15ULL) >>
+                    (64U - pe->kmertablebits));
+}
+
+static void phraseencoder_addliteral(GtPhraseencoder *pe, GtUword pos,
+                                     GtUchar cc)
+{
+  /* a literal directly following the store part copied by the last phrase
+     extends this phrase */
+  if (pe->sourceend != pe->numofliterals) {
+    phraseencoder_addphrase(pe, pos, pe->numofliterals);
+    pe->openliterals = 0;
+  }
+  if (blockcompress_words(pe->numofliterals + 1, pe->literalbits)
+      > pe->allocatedliterals) {
+    GtUword oldallocated = pe->allocatedliterals;
+    pe->allocatedliterals += pe->allocatedliterals/2 + 1024UL;
+    pe->literals = gt_realloc(pe->literals, sizeof (*pe->literals) *
+                                            pe->allocatedliterals);
+    /* blockcompress_setvalue() keeps the other bits of a word */
+    memset(pe->literals + oldallocated, 0, sizeof (*pe->literals) *
+                                           (pe->allocatedliterals -
+                                            oldallocated));
+  }
+  blockcompress_setvalue(pe->literals, pe->literalbits, pe->numofliterals,
+                         (uint64_t) cc);
+  pe->numofliterals++;
+  pe->sourceend = pe->numofliterals;
+  pe->openliterals++;
+  if (pe->numofliterals >= pe->kmersize &&
+      (pe->numofliterals - pe->kmersize) % GT_ENCSEQ_KMERSTEP == 0) {
+    uint64_t kmer = 0;
+    GtUword idx;
+
+    for (idx = pe->numofliterals - pe->kmersize; idx < pe->numofliterals;
+         idx++) {
+      kmer = (kmer << pe->literalbits) |
+             blockcompress_value(pe->literals, pe->literalbits, idx);
+    }
+    pe->kmertable[phraseencoder_kmerslot(pe, kmer)]
+      = pe->numofliterals - pe->kmersize + 1;
+  }
+}
+
+/* Return the length of the longest copy of <seq> starting at position
+   <source> of the store. <*back> is set to the number of literals just added
+   to the store by which the copy can be extended to the left. */
+static GtUword phraseencoder_copylength(const GtPhraseencoder *pe,
+                                        GtUword source, const GtUchar *seq,
+                                        GtUword len, GtUword *back)
+{
+  GtUword forward = 0;
+
+  while (forward < len && source + forward < pe->numofliterals &&
+         blockcompress_value(pe->literals, pe->literalbits,
+                             source + forward) == (uint64_t) seq[forward])
+    forward++;
+  *back = 0;
+  while (*back < pe->openliterals && *back < source &&
+         source + forward + *back + 1 <= pe->numofliterals &&
+         blockcompress_value(pe->literals, pe->literalbits,
+                             source - *back - 1) ==
+         blockcompress_value(pe->literals, pe->literalbits,
+                             pe->numofliterals - *back - 1))
+    (*back)++;
+  return forward;
+}
+
+static void phraseencoder_addcopy(GtPhraseencoder *pe, GtUword pos,
+                                  GtUword source, GtUword forward,
+                                  GtUword back)
+{
+  if (back > 0) {
+    pe->numofliterals -= back;
+    /* the last phrase consisted of the removed literals only */
+    if (pe->phrasestarts[pe->numofphrases - 1] == pos - back)
+      pe->numofphrases--;
+  }
+  phraseencoder_addphrase(pe, pos - back, source - back);
+  pe->sourceend = source + forward;
+  pe->openliterals = 0;
+  pe->diagonal = (GtWord) source - (GtWord) pos;
+  pe->hasdiagonal = true;
+}
+
+/* Parse the characters <seq>[0..<len>-1], which start at position
+   <startpos> of the sequence, into phrases. */
+static void phraseencoder_parse(GtPhraseencoder *pe, const GtUchar *seq,
+                                GtUword len, GtUword startpos)
+{
+  GtUword idx = 0;
+
+  while (idx < len) {
+    GtUword pos = startpos + idx, source, forward, back,
+            bestsource = 0, bestforward = 0, bestback = 0;
+    int delta;
+
+    /* continue the copy of the last phrase */
+    if (pe->sourceend < pe->numofliterals &&
+        blockcompress_value(pe->literals, pe->literalbits, pe->sourceend)
+        == (uint64_t) seq[idx]) {
+      pe->sourceend++;
+      idx++;
+      continue;
+    }
+    /* after a substitution, insertion or deletion the copy usually
+       continues near the diagonal of the last copy */
+    for (delta = -1; pe->hasdiagonal && delta <= 1; delta++) {
+      GtWord candidate = (GtWord) pos + pe->diagonal + delta;
+
+      if (candidate < 0 || (GtUword) candidate >= pe->numofliterals)
+        continue;
+      source = (GtUword) candidate;
+      forward = phraseencoder_copylength(pe, source, seq + idx, len - idx,
+                                         &back);
+      if (forward + back > bestforward + bestback) {
+        bestsource = source;
+        bestforward = forward;
+        bestback = back;
+      }
+    }
+    if (bestforward + bestback < pe->minmatchlength &&
+        idx + pe->kmersize <= len) {
+      uint64_t kmer = 0;
+      GtUword offset;
+
+      for (offset = 0; offset < pe->kmersize; offset++)
+        kmer = (kmer << pe->literalbits) | seq[idx + offset];
+      source = pe->kmertable[phraseencoder_kmerslot(pe, kmer)];
+      if (source > 0) {
+        source--;
+        forward = phraseencoder_copylength(pe, source, seq + idx, len - idx,
+                                           &back);
+        if (forward + back > bestforward + bestback) {
+          bestsource = source;
+          bestforward = forward;
+          bestback = back;
+        }
+      }
+    }
+    if (bestforward + bestback >= pe->minmatchlength) {
+      phraseencoder_addcopy(pe, pos, bestsource, bestforward, bestback);
+      idx += bestforward;
+    }
+    else {
+      phraseencoder_addliteral(pe, pos, seq[idx]);
+      idx++;
+    }
+  }
+}
+
+static GtUword blockcompress_numofwords(const GtEncseq *encseq)
+{
+  return blockcompress_words(encseq->numofphrases, encseq->positionbits) +
+         blockcompress_words(encseq->numofphrases, encseq->sourcebits) +
+         blockcompress_words(encseq->numofspecialranges,
+                             encseq->positionbits) +
+         blockcompress_words(encseq->numofspecialranges,
+                             encseq->speciallengthbits + 1) +
+         blockcompress_words(encseq->numofliterals, encseq->literalbits);
+}
+
+/* Set the sizes of the tables from <encseq->blockcompresssizes> and, if the
+   space is available, the pointers into <encseq->blockcompressspace>. */
+static void blockcompress_assign(GtEncseq *encseq)
+{
+  encseq->numofliterals = (GtUword) encseq->blockcompresssizes[0];
+  encseq->numofphrases = (GtUword) encseq->blockcompresssizes[1];
+  encseq->numofspecialranges = (GtUword) encseq->blockcompresssizes[2];
+  encseq->speciallengthbits = (unsigned int) encseq->blockcompresssizes[3];
+  encseq->positionbits = blockcompress_bits(encseq->totallength);
+  encseq->sourcebits = blockcompress_bits(encseq->numofliterals);
+  encseq->literalbits = blockcompress_bits((GtUword) encseq->numofchars - 1);
+  if (encseq->blockcompressspace == NULL)
+    return;
+  encseq->phrasestarts = encseq->blockcompressspace;
+  encseq->phrasesources = encseq->phrasestarts +
+                          blockcompress_words(encseq->numofphrases,
+                                              encseq->positionbits);
+  encseq->specialstarts = encseq->phrasesources +
+                          blockcompress_words(encseq->numofphrases,
+                                              encseq->sourcebits);
+  encseq->speciallengths = encseq->specialstarts +
+                           blockcompress_words(encseq->numofspecialranges,
+                                               encseq->positionbits);
+  encseq->literals = encseq->speciallengths +
+                     blockcompress_words(encseq->numofspecialranges,
+                                         encseq->speciallengthbits + 1);
+}
+
+/* Return a description of the first inconsistency found in the phrases,
+   special ranges and literals of <encseq>, which occupy <numofwords> words,
+   or NULL if there is none. */
+static const char *blockcompress_corruption(GtEncseq *encseq,
+                                            GtUword numofwords)
+{
+  const uint64_t *sizes = encseq->blockcompresssizes;
+  GtUword idx, start, end = 0, separators = 0, wildcards = 0;
+
+  if (sizes[0] > (uint64_t) encseq->totallength ||
+      sizes[1] > (uint64_t) encseq->totallength ||
+      sizes[2] > (uint64_t) encseq->totallength ||
+      (sizes[1] == 0 && encseq->totallength > 0) ||
+      sizes[3] == 0 || sizes[3] >= (uint64_t) 64)
+    return "sizes in index do not fit the sequence";
+  blockcompress_assign(encseq);
+  if (numofwords != blockcompress_numofwords(encseq))
+    return "size does not match the number of phrases and literals";
+  for (idx = 0; idx < encseq->numofphrases; idx++) {
+    start = blockcompress_phrasestart(encseq, idx);
+    if ((idx == 0 && start > 0) ||
+        (idx > 0 && start <= blockcompress_phrasestart(encseq, idx - 1)) ||
+        start >= encseq->totallength)
+      return "phrases are not sorted by their start position";
+    if ((GtUword) blockcompress_value(encseq->phrasesources,
+                                      encseq->sourcebits, idx) +
+        blockcompress_phraseend(encseq, idx) - start > encseq->numofliterals)
+      return "phrase exceeds the literals";
+  }
+  for (idx = 0; idx < encseq->numofspecialranges; idx++) {
+    start = blockcompress_specialstart(encseq, idx);
+    if (start < end || start >= encseq->totallength ||
+        blockcompress_speciallength(encseq, idx) >
+          encseq->totallength - start)
+      return "special ranges are not sorted by their start position";
+    end = start + blockcompress_speciallength(encseq, idx);
+    if (blockcompress_specialchar(encseq, idx) == (GtUchar) SEPARATOR)
+      separators += blockcompress_speciallength(encseq, idx);
+    else
+      wildcards += blockcompress_speciallength(encseq, idx);
+  }
+  if (separators + 1 != encseq->numofdbsequences ||
+      wildcards != encseq->specialcharinfo.wildcards)
+    return "wrong number of special characters";
+  if ((1U << encseq->literalbits) > encseq->numofchars) {
+    for (idx = 0; idx < encseq->numofliterals; idx++) {
+      if (blockcompress_value(encseq->literals, encseq->literalbits, idx)
+          >= (uint64_t) encseq->numofchars)
+        return "literal is not a character of the alphabet";
+    }
+  }
+  return NULL;
+}
+
+/* Sample the phrases and special ranges for <blockcompress_findphrase> and
+   <blockcompress_findspecial>. */
+static void blockcompress_sample(GtEncseq *encseq)
+{
+  GtUword numofsamples, sample, phrasenum = 0, specialnum = 0;
+
+  if (encseq->totallength == 0)
+    return;
+  numofsamples = ((encseq->totallength - 1) >> GT_ENCSEQ_PHRASESAMPLE_LOG) + 1;
+  encseq->phrasesample = gt_malloc(sizeof (*encseq->phrasesample) *
+                                   (numofsamples + 1));
+  encseq->specialsample = gt_malloc(sizeof (*encseq->specialsample) *
+                                    (numofsamples + 1));
+  for (sample = 0; sample < numofsamples; sample++) {
+    const GtUword pos = sample << GT_ENCSEQ_PHRASESAMPLE_LOG;
+
+    while (blockcompress_phraseend(encseq, phrasenum) <= pos)
+      phrasenum++;
+    encseq->phrasesample[sample] = phrasenum;
+    while (specialnum < encseq->numofspecialranges &&
+           blockcompress_specialstart(encseq, specialnum) < pos)
+      specialnum++;
+    encseq->specialsample[sample] = specialnum;
+  }
+  encseq->phrasesample[numofsamples] = encseq->numofphrases - 1;
+  encseq->specialsample[numofsamples] = encseq->numofspecialranges;
+}
+
+static void phraseencoder_store(GtEncseq *encseq, const GtPhraseencoder *pe)
+{
+  GtUword idx, maxlength = 1UL;
+
+  for (idx = 0; idx < pe->numofspecialranges; idx++) {
+    if (pe->specialranges[idx].length > maxlength)
+      maxlength = pe->specialranges[idx].length;
+  }
+  encseq->blockcompresssizes
+    = gt_malloc(sizeof (*encseq->blockcompresssizes) * 4);
+  encseq->blockcompresssizes[0] = (uint64_t) pe->numofliterals;
+  encseq->blockcompresssizes[1] = (uint64_t) pe->numofphrases;
+  encseq->blockcompresssizes[2] = (uint64_t) pe->numofspecialranges;
+  encseq->blockcompresssizes[3] = (uint64_t) blockcompress_bits(maxlength-1);
+  encseq->blockcompressspace = NULL;
+  blockcompress_assign(encseq);
+  encseq->blockcompressspace
+    = gt_calloc((size_t) blockcompress_numofwords(encseq) + 1,
+                sizeof (*encseq->blockcompressspace));
+  encseq->hasallocatedblockcompressspace = true;
+  blockcompress_assign(encseq);
+  for (idx = 0; idx < pe->numofphrases; idx++) {
+    blockcompress_setvalue((uint64_t *) encseq->phrasestarts,
+                           encseq->positionbits, idx,
+                           (uint64_t) pe->phrasestarts[idx]);
+    blockcompress_setvalue((uint64_t *) encseq->phrasesources,
+                           encseq->sourcebits, idx,
+                           (uint64_t) pe->phrasesources[idx]);
+  }
+  for (idx = 0; idx < pe->numofspecialranges; idx++) {
+    blockcompress_setvalue((uint64_t *) encseq->specialstarts,
+                           encseq->positionbits, idx,
+                           (uint64_t) pe->specialranges[idx].start);
+    blockcompress_setvalue((uint64_t *) encseq->speciallengths,
+                           encseq->speciallengthbits + 1, idx,
+                           ((uint64_t) (pe->specialranges[idx].length - 1)
+                            << 1) |
+                           (pe->specialranges[idx].cc == (GtUchar) SEPARATOR
+                            ? 1 : 0));
+  }
+  if (pe->numofliterals > 0) {
+    const GtUword numofwords = blockcompress_words(pe->numofliterals,
+                                                   pe->literalbits),
+                  tailbits = (pe->numofliterals * pe->literalbits) & 63;
+    uint64_t *literals = (uint64_t *) encseq->literals;
+
+    memcpy(literals, pe->literals, sizeof (*pe->literals) * numofwords);
+    /* clear the bits of literals removed by phraseencoder_addcopy() */
+    if (tailbits > 0)
+      literals[numofwords - 1] &= (((uint64_t) 1) << tailbits) - 1;
+  }
+}
+static int fillViablockcompress(GtEncseq *encseq,
+                                Gtssptaboutinfo *ssptaboutinfo,
+                                GtSequenceBuffer *fb,
+                                GtError *err)
+{
+  GtUword currentposition,
+          fillexceptionrangeidx = 0,
+          mapposition = 0,
+          nextcheckpos = GT_UNDEF_UWORD,
+          pagenumber = 0,
+          lastexceptionrangelength = 0,
+          chunkfill = 0;
+  int retval;
+  GtUchar cc, *chunk;
+  char orig;
+  bool haserr = false;
+  GtSWtable_uint32 *exceptiontable = &(encseq->exceptiontable.st_uint32);
+  GtPhraseencoder pe;
+  gt_error_check(err);
+
+  if (encseq->has_exceptiontable) {
+    exceptiontable->positions = gt_malloc(sizeof (*exceptiontable->positions) *
+                                         exceptiontable->numofpositionstostore);
+    exceptiontable->rangelengths =
+                               gt_malloc(sizeof(*exceptiontable->rangelengths) *
+                                         exceptiontable->numofpositionstostore);
+    exceptiontable->endidxinpage =
+                               gt_malloc(sizeof(*exceptiontable->endidxinpage) *
+                                         exceptiontable->numofpages);
+    exceptiontable->mappositions =
+                              gt_malloc(sizeof (*exceptiontable->mappositions) *
+                                        exceptiontable->numofpositionstostore);
+    nextcheckpos = exceptiontable->maxrangevalue;
+  }
+  phraseencoder_init(&pe, encseq->numofchars, encseq->totallength);
+  chunk = gt_malloc(sizeof (*chunk) * GT_ENCSEQ_PHRASECHUNK);
+  for (currentposition=0; !haserr; currentposition++) {
+    retval = gt_sequence_buffer_next_with_original(fb, &cc, &orig, err);
+    if (retval == 1) {
+      if (encseq->has_exceptiontable && cc != (GtUchar) SEPARATOR) {
+        if (orig == encseq->maxchars[cc]) {
+          if (lastexceptionrangelength > 0) {
+            exceptiontable->rangelengths[fillexceptionrangeidx-1]
+              = (uint32_t) (lastexceptionrangelength-1);
+            lastexceptionrangelength = 0;
+          }
+        }
+        else {
+          /* at beginning of exception range */
+          if (lastexceptionrangelength == 0) {
+            /* store remainder of currentposition: this value is not larger
+               than maxrangevalue and this can be stored in a page */
+            exceptiontable->positions[fillexceptionrangeidx++]
+              = (uint32_t) (currentposition & exceptiontable->maxrangevalue);
+            exceptiontable->mappositions[fillexceptionrangeidx-1]
+              = mapposition;
+            lastexceptionrangelength = 1UL;
+          }
+          else /* extend exception range */ {
+            if (lastexceptionrangelength == exceptiontable->maxrangevalue) {
+              gt_assert(fillexceptionrangeidx > 0);
+              exceptiontable->rangelengths[fillexceptionrangeidx-1]
+                = (uint32_t) exceptiontable->maxrangevalue;
+              lastexceptionrangelength = 0;
+            }
+            else
+              lastexceptionrangelength++;
+          }
+          bitpackarray_store_uint32(encseq->exceptions,
+                                   (BitOffset) mapposition,
+                                   (uint32_t) encseq->subsymbolmap[(int) orig]);
+          mapposition++;
+        }
+      }
+      if (cc == (GtUchar) SEPARATOR)
+        ssptaboutinfo_processseppos(ssptaboutinfo, currentposition);
+      gt_assert(currentposition < encseq->totallength);
+      ssptaboutinfo_processanyposition(ssptaboutinfo, currentposition);
+      if (ISSPECIAL(cc)) {
+        phraseencoder_addspecial(&pe, currentposition, cc);
+        cc = 0;
+      }
+      chunk[chunkfill++] = cc;
+      if (chunkfill == GT_ENCSEQ_PHRASECHUNK) {
+        phraseencoder_parse(&pe, chunk, chunkfill,
+                            currentposition + 1 - chunkfill);
+        chunkfill = 0;
+      }
+    }
+    else {
+      if (retval < 0) {
+        haserr = true;
+        break;
+      }
+      if (encseq->has_exceptiontable && lastexceptionrangelength > 0) {
+        /* note that we store one less than the length to prevent overflows */
+        gt_assert(fillexceptionrangeidx > 0 &&
+                  fillexceptionrangeidx <=
+                  exceptiontable->numofpositionstostore);
+        exceptiontable->rangelengths[fillexceptionrangeidx-1]
+          = (uint32_t) (lastexceptionrangelength-1);
+      }
+      gt_assert(retval == 0);
+      break;
+    }
+    if (encseq->has_exceptiontable && currentposition == nextcheckpos) {
+      exceptiontable->endidxinpage[pagenumber] = fillexceptionrangeidx;
+      pagenumber++;
+      nextcheckpos += 1UL + exceptiontable->maxrangevalue;
+    }
+  }
+  if (!haserr) {
+    phraseencoder_parse(&pe, chunk, chunkfill, currentposition - chunkfill);
+    phraseencoder_store(encseq, &pe);
+    blockcompress_sample(encseq);
+  }
+  gt_free(chunk);
+  phraseencoder_delete(&pe);
+  if (haserr)
+    return -1;
+  if (encseq->has_exceptiontable) {
+    while (pagenumber < exceptiontable->numofpages) {
+      exceptiontable->endidxinpage[pagenumber] = fillexceptionrangeidx;
+      pagenumber++;
+    }
+  }
+  ssptaboutinfo_finalize(ssptaboutinfo);
+  return 0;
+}
+
+static GtUchar seqdelivercharViablockcompress(GtEncseqReader *esr)
+{
+  return blockcompress_char(esr->encseq, &esr->phrasenum, &esr->specialnum,
+                            esr->currentpos);
+}
+
+static bool containsspecialViablockcompress(const GtEncseq *encseq,
+                                            GtReadmode readmode,
+                                            GT_UNUSED GtEncseqReader *esr,
+                                            GtUword startpos,
+                                            GtUword len)
+{
+  GtUword specialnum;
+
+  if (GT_ISDIRREVERSE(readmode)) {
+    gt_assert(startpos < encseq->totallength);
+    startpos = GT_REVERSEPOS(encseq->totallength, startpos);
+    gt_assert (startpos + 1 >= len);
+    startpos = startpos + 1 - len;
+  }
+  if (len == 0 || encseq->numofspecialranges == 0)
+    return false;
+  specialnum = blockcompress_findspecial(encseq, startpos);
+  return ((specialnum > 0 &&
+           startpos < blockcompress_specialstart(encseq, specialnum - 1) +
+                      blockcompress_speciallength(encseq, specialnum - 1)) ||
+          (specialnum < encseq->numofspecialranges &&
+           blockcompress_specialstart(encseq, specialnum) < startpos + len))
+         ? true
+         : false;
+}
+
+static bool issinglepositioninwildcardrangeViablockcompress(
+                                                   const GtEncseq *encseq,
+                                                   GtUword pos)
+{
+  return (delivercharViablockcompress(encseq, pos) == (GtUchar) WILDCARD)
+             ? true
+             : false;
+}
+
+static bool issinglepositionseparatorViablockcompress(const GtEncseq *encseq,
+                                                      GtUword pos)
+{
+  return (delivercharViablockcompress(encseq, pos) == (GtUchar) SEPARATOR)
+             ? true
+             : false;
+}
+
+static int flushblockcompressspace2file(const char *indexname,
+                                        const GtEncseq *encseq,
+                                        GtError *err)
+{
+  FILE *fp;
+  GtUword numofwords = blockcompress_numofwords(encseq);
+
+  gt_error_check(err);
+  fp = gt_fa_fopen_with_suffix(indexname, GT_BCSTABFILESUFFIX, "wb", err);
+  if (fp == NULL)
+    return -1;
+  if (numofwords > 0)
+    gt_xfwrite(encseq->blockcompressspace,
+               sizeof (*encseq->blockcompressspace), (size_t) numofwords, fp);
+  gt_fa_xfclose(fp);
+  return 0;
+}
+
+static int mapblockcompressspace(GtEncseq *encseq, const char *indexname,
+                                 GtError *err)
+{
+  size_t numofbytes;
+  const char *corruption = NULL;
+
+  gt_error_check(err);
+  encseq->hasallocatedblockcompressspace = false;
+  encseq->blockcompressspace
+    = gt_fa_mmap_read_with_suffix(indexname, GT_BCSTABFILESUFFIX,
+                                  &numofbytes, err);
+  if (encseq->blockcompressspace == NULL)
+    return -1;
+  if (numofbytes % sizeof (*encseq->blockcompressspace) != 0)
+    corruption = "size is not a multiple of 8 bytes";
+  else
+    corruption = blockcompress_corruption(encseq,
+                                          (GtUword) (numofbytes /
+                                          sizeof (*encseq->
+                                                  blockcompressspace)));
+  if (corruption != NULL) {
+    gt_error_set(err, "corrupt compressed sequence in %s%s: %s", indexname,
+                 GT_BCSTABFILESUFFIX, corruption);
+    return -1;
+  }
+  blockcompress_sample(encseq);
+  return 0;
+}
+
 /* GT_ACCESS_TYPE_EQUALLENGTH */
 
 static int fillViaequallength(GtEncseq *encseq,
@@ -3045,6 +3976,7 @@ void gt_encseq_reader_reinit_with_readmode(GtEncseqReader *esr,
     if (esr->encseq != NULL)
       gt_encseq_delete(esr->encseq);
     esr->encseq = gt_encseq_ref((GtEncseq*) encseq);
+    esr->phrasenum = esr->specialnum = GT_UNDEF_UWORD;
   }
   gt_assert(esr->encseq);
 
@@ -3159,6 +4091,7 @@ GtEncseqReader* gt_encseq_create_reader_with_readmode(const GtEncseq *encseq,
   /* the following is implicit by using calloc, but we better initialize
      it for documentation */
   esr->wildcardrangestate = esr->ssptabstate = NULL;
+  esr->phrasenum = esr->specialnum = GT_UNDEF_UWORD;
   gt_encseq_reader_reinit_with_readmode(esr, encseq, readmode, startpos);
   return esr;
 }
@@ -3261,7 +4194,8 @@ bool gt_encseq_has_wildcardranges(const GtEncseq *encseq)
 bool gt_encseq_bitwise_cmp_ok(const GtEncseq *encseq)
 {
   return (encseq->sat == GT_ACCESS_TYPE_DIRECTACCESS ||
-          encseq->sat == GT_ACCESS_TYPE_BYTECOMPRESS) ? false : true;
+          encseq->sat == GT_ACCESS_TYPE_BYTECOMPRESS ||
+          encseq->sat == GT_ACCESS_TYPE_BLOCKCOMPRESS) ? false : true;
 }
 
 typedef struct
@@ -3366,6 +4300,8 @@ static bool gt_dabc_specialrangeiterator_next(bool directaccess,
   while (!success) {
     if (directaccess)
       cc = sri->esr->encseq->plainseq[sri->jumppos];
+    else if (sri->esr->encseq->sat == GT_ACCESS_TYPE_BLOCKCOMPRESS)
+      cc = delivercharViablockcompress(sri->esr->encseq, sri->jumppos);
     else
       cc = delivercharViabytecompress(sri->esr->encseq, sri->jumppos);
     if (ISSPECIAL(cc))
@@ -3670,6 +4606,7 @@ static inline bool gt_specialrangeiterator_deliver_range(
     case  GT_ACCESS_TYPE_DIRECTACCESS:
       return gt_dabc_specialrangeiterator_next(true, range, sri);
     case GT_ACCESS_TYPE_BYTECOMPRESS:
+    case GT_ACCESS_TYPE_BLOCKCOMPRESS:
       return gt_dabc_specialrangeiterator_next(false, range, sri);
     case GT_ACCESS_TYPE_EQUALLENGTH:
       return gt_equallength_specialrangeiterator_next(range, sri);
@@ -4128,7 +5065,9 @@ static GtEncseq *determineencseqkeyvalues(GtEncseqAccessType sat,
   }
   encseq->satname = gt_encseq_access_type_str(sat);
   encseq->twobitencoding = NULL;
-  if (sat == GT_ACCESS_TYPE_DIRECTACCESS || sat == GT_ACCESS_TYPE_BYTECOMPRESS)
+  if (sat == GT_ACCESS_TYPE_DIRECTACCESS ||
+      sat == GT_ACCESS_TYPE_BYTECOMPRESS ||
+      sat == GT_ACCESS_TYPE_BLOCKCOMPRESS)
     encseq->unitsoftwobitencoding = 0;
   else
     encseq->unitsoftwobitencoding = gt_unitsoftwobitencoding(totallength);
@@ -4137,6 +5076,16 @@ static GtEncseq *determineencseqkeyvalues(GtEncseqAccessType sat,
   encseq->bitpackarray = NULL;
   encseq->exceptions = NULL;
   encseq->hasplainseqptr = false;
+  encseq->blockcompresssizes = NULL;
+  encseq->blockcompressspace = NULL;
+  encseq->phrasestarts = encseq->phrasesources = NULL;
+  encseq->specialstarts = encseq->speciallengths = encseq->literals = NULL;
+  encseq->numofphrases = encseq->numofspecialranges = 0;
+  encseq->numofliterals = 0;
+  encseq->phrasesample = encseq->specialsample = NULL;
+  encseq->positionbits = encseq->sourcebits = 0;
+  encseq->speciallengthbits = encseq->literalbits = 0;
+  encseq->hasallocatedblockcompressspace = false;
   encseq->specialbits = NULL;
   setencsequtablesNULL(encseq->sat, &encseq->wildcardrangetable);
   setencsequtablesNULL(encseq->satsep, &encseq->ssptab);
@@ -4377,6 +5326,19 @@ static GtEncseqfunctions encodedseqfunctab[] =
            issinglepositionseparatorViauint32),
       NFCT(getexceptionmapping,
            issinglepositioninexceptionrangeViauint32)
+    },
+
+    { /* GT_ACCESS_TYPE_BLOCKCOMPRESS */
+      NFCT(fillposition, fillViablockcompress),
+      NFCT(seqdelivercharnospecial, seqdelivercharViablockcompress),
+      NFCT(seqdelivercharspecial, seqdelivercharViablockcompress),
+      NFCT(delivercontainsspecial, containsspecialViablockcompress),
+      NFCT(issinglepositioninwildcardrange,
+           issinglepositioninwildcardrangeViablockcompress),
+      NFCT(issinglepositionseparator,
+           issinglepositionseparatorViablockcompress),
+      NFCT(getexceptionmapping,
+           issinglepositioninexceptionrangeViauint32)
     }
   };
 
@@ -4596,6 +5558,18 @@ static GtEncseq *files2encodedsequence(const GtStrArray *filenametab,
       haserr = true;
     ssptaboutinfo_delete(ssptaboutinfo);
   }
+  if (!haserr && sat == GT_ACCESS_TYPE_BLOCKCOMPRESS) {
+    GtUword compressedsize
+      = sizeof (*encseq->blockcompressspace) *
+        blockcompress_numofwords(encseq);
+
+    gt_logger_log(logger, "compressed sequence into "GT_WU" phrases, "GT_WU
+                          " special ranges and "GT_WU" literals, "GT_WU
+                          " bytes (%.2f bits/symbol)",
+                  encseq->numofphrases, encseq->numofspecialranges,
+                  encseq->numofliterals, compressedsize,
+                  determine_spaceinbitsperchar(compressedsize, totallength));
+  }
 #ifdef GT_RANGEDEBUG
   if (!haserr)
     showallSWtables(encseq);
@@ -4680,6 +5654,10 @@ static GtEncseq* gt_encseq_new_from_index(const char *indexname,
     if (fillencseqmapspecstartptr(encseq, indexname, logger, err) != 0)
       haserr = true;
   }
+  if (!haserr && encseq->sat == GT_ACCESS_TYPE_BLOCKCOMPRESS) {
+    if (mapblockcompressspace(encseq, indexname, err) != 0)
+      haserr = true;
+  }
   if (!haserr) {
     gt_assert(encseq != NULL);
     encseq->indexname = gt_cstr_dup(indexname);
@@ -5149,6 +6127,11 @@ uint64_t gt_encseq_determine_size(GtEncseqAccessType sat,
                gt_encseq_sizeofSWtable(sat, true, false, totallength,
                                        wildcardranges);
          break;
+    case GT_ACCESS_TYPE_BLOCKCOMPRESS:
+         /* only the sizes of the phrases, special ranges and literals,
+            which are stored separately */
+         sum = (uint64_t) sizeof (uint64_t) * (uint64_t) 4;
+         break;
     default:
          fprintf(stderr, "gt_encseq_determine_size(%d) undefined\n", (int) sat);
          exit(GT_EXIT_PROGRAMMING_ERROR);
@@ -5353,31 +6336,566 @@ static int countnumberofexceptionranges(const GtAlphabet *alpha,
             if (!in_range) {
               in_range = true;
             }
-            specialcharinfo->exceptioncharacters++;
-          } else {
-            if (in_range) {
-              specialcharinfo->realexceptionranges++;
-              in_range = false;
+            specialcharinfo->exceptioncharacters++;
+          } else {
+            if (in_range) {
+              specialcharinfo->realexceptionranges++;
+              in_range = false;
+            }
+          }
+        }
+      }
+      else {
+        if (retval == 0) {
+          if (in_range) {
+            specialcharinfo->realexceptionranges++;
+          }
+        }
+        else /* retval < 0 */ {
+          gt_assert(gt_error_is_set(err));
+          had_err = -1;
+        }
+        break;
+      }
+    }
+  }
+  gt_sequence_buffer_delete(fb);
+  return had_err;
+}
+
+#if !(defined (_LP64) || defined (_WIN64))
+#define MAXSFXLENFOR32BIT 4294000000UL
+#endif
+
+/* Statistics of a single input file, collected by
+   <gt_encseq_filekeyvalues_collect> and merged in file order by
+   <gt_encseq_filekeyvalues_merge>. Separators between files are not part of
+   any file, and a special range at the end of a file is not added to
+   <distspecialrangelength>, as it continues in the next file. */
+typedef struct
+{
+  GtUword length,
+          numofseparators,
+          lengthofcurrentsequence,
+          minseqlen,
+          maxseqlen,
+          descmaxlength,
+          exceptionranges,
+          *characterdistribution,
+          *originaldistribution;
+  GtSpecialcharinfo specialcharinfo;
+  Definedunsignedlong equallength;
+  GtFilelengthvalues filelengthvalues;
+  GtDiscDistri *distspecialrangelength,
+               *distwildcardrangelength;
+  FILE *desfp,
+       *sdsfp,
+       *md5fp;
+  bool exceptionatstart,
+       exceptionatend,
+       hasnonseparator,
+       empty; /* the file adds nothing to the input */
+  GtError *err;
+} GtEncseqFilekeyvalues;
+
+typedef struct
+{
+  const GtStrArray *filenametab;
+  const GtSequenceBuffer *guessedbuffer;
+  const GtAlphabet *alpha;
+  const char *maxchars;
+  bool clip_desc,
+       outoistab;
+  GtUword lastfilenum; /* last file with a sequence */
+  GtEncseqFilekeyvalues *filekeyvalues;
+} GtEncseqFilekeyvaluesinfo;
+
+static int gt_encseq_filekeyvalues_scan(const GtEncseqFilekeyvaluesinfo *info,
+                                        GtEncseqFilekeyvalues *fkv,
+                                        bool firstfile,
+                                        GtStrArray *filenametab)
+{
+  GtSequenceBuffer *fb;
+  GtUchar charcode;
+  int retval;
+  GtUword currentpos,
+          lastspecialrangelength = 0,
+          lastwildcardrangelength = 0,
+          lastnonspecialrangelength = 0,
+          lengthofcurrentsequence = 0,
+          md5_blockcount = 0,
+          *numofseparators = &fkv->numofseparators,
+          *minseqlen = &fkv->minseqlen,
+          *maxseqlen = &fkv->maxseqlen,
+          *originaldistribution = fkv->originaldistribution;
+  bool specialprefix = true, wildcardprefix = true, haserr = false;
+  const bool plainformat = false, outoistab = info->outoistab;
+  GtSpecialcharinfo *specialcharinfo = &fkv->specialcharinfo;
+  Definedunsignedlong *equallength = &fkv->equallength;
+  GtDiscDistri *distspecialrangelength = fkv->distspecialrangelength,
+               *distwildcardrangelength = fkv->distwildcardrangelength;
+  GtDescBuffer *descqueue = NULL;
+  GtMD5Encoder *md5enc = NULL;
+  FILE *desfp = fkv->desfp, *sdsfp = fkv->sdsfp, *md5fp = fkv->md5fp;
+  GtError *err = fkv->err;
+  const GtAlphabet *a = info->alpha;
+  char cc, *desc, md5_blockbuf[64], md5_outbuf[33];
+  unsigned char md5_output[16];
+
+  fb = gt_sequence_buffer_new_same_type(info->guessedbuffer, filenametab);
+  gt_sequence_buffer_set_symbolmap(fb, gt_alphabet_symbolmap(a));
+  gt_sequence_buffer_set_filelengthtab(fb, &fkv->filelengthvalues);
+  gt_sequence_buffer_set_chardisttab(fb, fkv->characterdistribution);
+  if (desfp != NULL) {
+    descqueue = gt_desc_buffer_new();
+    if (info->clip_desc)
+      gt_desc_buffer_set_clip_at_whitespace(descqueue);
+    gt_sequence_buffer_set_desc_buffer(fb, descqueue);
+  }
+  if (md5fp != NULL)
+    md5enc = gt_md5_encoder_new();
+  for (currentpos = 0; !haserr; currentpos++) {
+    retval = gt_sequence_buffer_next_with_original(fb, &charcode, &cc, err);
+    if (retval > 0) {
+#define WITHEQUALLENGTH_DES_SSP
+#define WITHOISTAB
+#define WITHCOUNTMINMAX
+#define WITHORIGDIST
+#define WITHMD5FP
+#include "encseq_charproc.gen"
+    }
+    else {
+      if (retval == 0) {
+        if (*maxseqlen == GT_UNDEF_UWORD
+              || lengthofcurrentsequence > *maxseqlen) {
+          *maxseqlen = lengthofcurrentsequence;
+        }
+        if (*minseqlen == GT_UNDEF_UWORD
+             || lengthofcurrentsequence < *minseqlen) {
+          *minseqlen = lengthofcurrentsequence;
+        }
+        if (lastnonspecialrangelength
+              > specialcharinfo->lengthoflongestnonspecial) {
+          specialcharinfo->lengthoflongestnonspecial =
+                                                  lastnonspecialrangelength;
+        }
+        /* a file is followed by a separator or ends the input, both of
+           which end the current wildcard range */
+        if (lastwildcardrangelength > 0) {
+          gt_disc_distri_add(distwildcardrangelength,
+                             lastwildcardrangelength);
+        }
+        if (md5enc != NULL) {
+          gt_md5_encoder_add_block(md5enc, md5_blockbuf, md5_blockcount);
+          gt_md5_encoder_finish(md5enc, md5_output, md5_outbuf);
+          gt_xfwrite(md5_outbuf, sizeof (char), (size_t) 33, md5fp);
+        }
+        if (equallength->defined) {
+          if (equallength->valueunsignedlong > 0) {
+            if (lengthofcurrentsequence != equallength->valueunsignedlong) {
+              equallength->defined = false;
+            }
+          }
+          else {
+            if (lengthofcurrentsequence == 0) {
+              gt_error_set(err, "sequence must not be empty");
+              haserr = true;
             }
+            equallength->valueunsignedlong = lengthofcurrentsequence;
           }
         }
-      }
-      else {
-        if (retval == 0) {
-          if (in_range) {
-            specialcharinfo->realexceptionranges++;
+        if (!haserr && desfp != NULL) {
+          desc = (char*) gt_desc_buffer_get_next(descqueue);
+          gt_xfputs(desc, desfp);
+          /* the merge drops the offset after the last sequence */
+          if (sdsfp != NULL) {
+            GtUword desoffset = (GtUword) ftello(desfp);
+            gt_xfwrite(&desoffset, sizeof desoffset, (size_t) 1, sdsfp);
           }
+          gt_xfputc((int) '\n', desfp);
+          fkv->descmaxlength = gt_desc_buffer_max_length(descqueue);
         }
-        else /* retval < 0 */ {
-          gt_assert(gt_error_is_set(err));
-          had_err = -1;
+      }
+      else /* retval < 0 */ {
+        haserr = true;
+      }
+      break;
+    }
+  }
+  if (haserr && retval >= 0 && !firstfile && equallength->defined
+        && equallength->valueunsignedlong == 0) {
+    /* only the first sequence of the input is reported this way */
+    gt_error_set(err, "file '%s' contains an empty sequence",
+                 gt_str_array_get(filenametab, 0));
+  }
+  fkv->length = currentpos;
+  fkv->lengthofcurrentsequence = lengthofcurrentsequence;
+  specialcharinfo->lengthofspecialsuffix = lastspecialrangelength;
+  specialcharinfo->lengthofwildcardsuffix = lastwildcardrangelength;
+  gt_md5_encoder_delete(md5enc);
+  gt_desc_buffer_delete(descqueue);
+  gt_sequence_buffer_delete(fb);
+  return haserr ? -1 : 0;
+}
+
+/* Per-file part of <countnumberofexceptionranges>. Ranges touching the file
+   borders are counted and recorded, so that ranges spanning several files can
+   be subtracted when merging. */
+static int gt_encseq_filekeyvalues_exceptions(const GtEncseqFilekeyvaluesinfo
+                                                *info,
+                                              GtEncseqFilekeyvalues *fkv,
+                                              GtStrArray *filenametab)
+{
+  GtSequenceBuffer *fb;
+  GtUchar charcode;
+  char cc;
+  int retval;
+  bool in_range = false;
+
+  fb = gt_sequence_buffer_new_same_type(info->guessedbuffer, filenametab);
+  gt_sequence_buffer_set_symbolmap(fb, gt_alphabet_symbolmap(info->alpha));
+  while ((retval = gt_sequence_buffer_next_with_original(fb, &charcode, &cc,
+                                                         fkv->err)) > 0) {
+    if (charcode != (GtUchar) SEPARATOR) {
+      const bool isexception = (cc != info->maxchars[charcode]) ? true : false;
+
+      if (!fkv->hasnonseparator) {
+        fkv->hasnonseparator = true;
+        fkv->exceptionatstart = isexception;
+      }
+      if (isexception) {
+        in_range = true;
+        fkv->specialcharinfo.exceptioncharacters++;
+      } else {
+        if (in_range) {
+          fkv->exceptionranges++;
+          in_range = false;
         }
-        break;
       }
     }
   }
+  if (in_range)
+    fkv->exceptionranges++;
+  fkv->exceptionatend = in_range;
   gt_sequence_buffer_delete(fb);
-  return had_err;
+  return retval < 0 ? -1 : 0;
+}
+
+/* Returns true if the file <filename> adds nothing to the input when read
+   together with other files, because it is empty or, depending on the format,
+   contains white space only. Its length is stored in <fkv>. */
+static bool gt_encseq_filekeyvalues_isempty(const GtEncseqFilekeyvaluesinfo
+                                              *info,
+                                            GtEncseqFilekeyvalues *fkv,
+                                            const char *filename)
+{
+  const GtSequenceBuffer *fb = info->guessedbuffer;
+  GtFile *file = gt_file_xopen(filename, "rb");
+  uint64_t length = 0;
+  int cc;
+
+  while ((cc = gt_file_xfgetc(file)) != EOF && isspace(cc))
+    length++;
+  gt_file_delete(file);
+  if (cc != EOF || (length > 0 && !gt_sequence_buffer_ignores_blank_files(fb)))
+    return false;
+  fkv->filelengthvalues.length = length;
+  return true;
+}
+
+static void gt_encseq_filekeyvalues_collect(GtUword start, GtUword end,
+                                            void *data)
+{
+  const GtEncseqFilekeyvaluesinfo *info = data;
+  GtUword filenum;
+
+  for (filenum = start; filenum < end; filenum++) {
+    GtEncseqFilekeyvalues *fkv = info->filekeyvalues + filenum;
+    GtStrArray *filenametab;
+    int had_err;
+
+    if (info->maxchars == NULL)
+      fkv->empty = gt_encseq_filekeyvalues_isempty(info, fkv,
+                                      gt_str_array_get(info->filenametab,
+                                                       filenum));
+    if (fkv->empty)
+      continue;
+    filenametab = gt_str_array_new();
+    gt_str_array_add_cstr(filenametab,
+                          gt_str_array_get(info->filenametab, filenum));
+    if (info->maxchars == NULL)
+      had_err = gt_encseq_filekeyvalues_scan(info, fkv, filenum == 0,
+                                             filenametab);
+    else
+      had_err = gt_encseq_filekeyvalues_exceptions(info, fkv, filenametab);
+    if (had_err)
+      gt_assert(gt_error_is_set(fkv->err));
+    gt_str_array_delete(filenametab);
+  }
+}
+
+static int gt_encseq_filekeyvalues_run(GtEncseqFilekeyvaluesinfo *info,
+                                       GtError *err)
+{
+  const GtUword numoffiles = gt_str_array_size(info->filenametab);
+  GtUword filenum;
+
+  gt_thread_pool_parallel_for(gt_thread_pool_get(), 0, numoffiles, 1UL,
+                              gt_encseq_filekeyvalues_collect, info);
+  info->lastfilenum = 0;
+  for (filenum = 0; filenum < numoffiles; filenum++) {
+    if (gt_error_is_set(info->filekeyvalues[filenum].err)) {
+      gt_error_set(err, "%s",
+                   gt_error_get(info->filekeyvalues[filenum].err));
+      return -1;
+    }
+    if (!info->filekeyvalues[filenum].empty)
+      info->lastfilenum = filenum;
+  }
+  /* the format was guessed from the contents of the first file */
+  gt_assert(!info->filekeyvalues[0].empty);
+  return 0;
+}
+
+static void gt_encseq_filekeyvalues_copyfile(FILE *outfp, FILE *infp)
+{
+  char buf[BUFSIZ];
+  size_t len;
+
+  rewind(infp);
+  while ((len = gt_xfread(buf, sizeof (char), sizeof buf, infp)) > 0)
+    gt_xfwrite(buf, sizeof (char), len, outfp);
+}
+
+typedef struct
+{
+  GtDiscDistri *dist;
+  GtUword skipkey;
+} GtEncseqDistriMerge;
+
+static void gt_encseq_distri_merge(GtUword key, GtUint64 value, void *data)
+{
+  GtEncseqDistriMerge *merge = data;
+
+  if (key == merge->skipkey) {
+    merge->skipkey = 0;
+    value--;
+  }
+  if (value > 0)
+    gt_disc_distri_add_multi(merge->dist, key, value);
+}
+
+/* Merge the per-file statistics of <info> as if the files had been scanned
+   as one sequence, with separators in between. Returns the length of the
+   special range at the end of the input. */
+static GtUword gt_encseq_filekeyvalues_merge(GtEncseqFilekeyvaluesinfo *info,
+                                             GtUword *totallength,
+                                             GtSpecialcharinfo
+                                               *specialcharinfo,
+                                             Definedunsignedlong *equallength,
+                                             GtFilelengthvalues *filelengthtab,
+                                             GtUword *characterdistribution,
+                                             GtUword *originaldistribution,
+                                             GtDiscDistri
+                                               *distspecialrangelength,
+                                             GtDiscDistri
+                                               *distwildcardrangelength,
+                                             GtUword *numofseparators,
+                                             GtUword *minseqlen,
+                                             GtUword *maxseqlen,
+                                             GtUword *descmaxlength,
+                                             FILE *desfp,
+                                             FILE *sdsfp,
+                                             FILE *md5fp)
+{
+  const GtUword numoffiles = gt_str_array_size(info->filenametab);
+  const unsigned int numofchars = gt_alphabet_num_of_chars(info->alpha);
+  const bool fileendswithseparator
+    = gt_sequence_buffer_file_ends_with_separator(info->guessedbuffer);
+  GtUword filenum, specialcarry = 0, desoffset = 0;
+  bool specialprefix = true;
+  unsigned int idx;
+
+  for (filenum = 0; filenum < numoffiles; filenum++) {
+    const GtEncseqFilekeyvalues *fkv = info->filekeyvalues + filenum;
+    const GtSpecialcharinfo *fsci = &fkv->specialcharinfo;
+    const bool allspecial = (fsci->lengthofspecialprefix == fkv->length)
+                            ? true : false;
+    GtEncseqDistriMerge merge;
+
+    filelengthtab[filenum] = fkv->filelengthvalues;
+    /* empty files are skipped, the first file is never empty */
+    if (fkv->empty)
+      continue;
+    if (fileendswithseparator && filenum < info->lastfilenum)
+      filelengthtab[filenum].effectivelength++;
+    if (filenum > 0) {
+      /* the separator between two files */
+      specialcarry++;
+      specialcharinfo->specialcharacters++;
+      (*numofseparators)++;
+    }
+    *totallength += fkv->length + (filenum > 0 ? 1UL : 0);
+    for (idx = 0; idx < numofchars; idx++)
+      characterdistribution[idx] += fkv->characterdistribution[idx];
+    for (idx = 0; idx < (unsigned int) UCHAR_MAX; idx++)
+      originaldistribution[idx] += fkv->originaldistribution[idx];
+    *numofseparators += fkv->numofseparators;
+    specialcharinfo->specialcharacters += fsci->specialcharacters;
+    specialcharinfo->wildcards += fsci->wildcards;
+    if (fsci->lengthoflongestnonspecial
+          > specialcharinfo->lengthoflongestnonspecial)
+      specialcharinfo->lengthoflongestnonspecial
+        = fsci->lengthoflongestnonspecial;
+    /* the special prefix of a file was added to its distribution, but
+       continues the special suffix of the previous file */
+    merge.dist = distspecialrangelength;
+    merge.skipkey = allspecial ? 0 : fsci->lengthofspecialprefix;
+    gt_disc_distri_foreach(fkv->distspecialrangelength,
+                           gt_encseq_distri_merge, &merge);
+    if (allspecial) {
+      specialcarry += fkv->length;
+    } else {
+      specialcarry += fsci->lengthofspecialprefix;
+      if (specialprefix) {
+        specialcharinfo->lengthofspecialprefix = specialcarry;
+        specialprefix = false;
+      }
+      if (specialcarry > 0)
+        gt_disc_distri_add(distspecialrangelength, specialcarry);
+      specialcarry = fsci->lengthofspecialsuffix;
+    }
+    merge.dist = distwildcardrangelength;
+    merge.skipkey = 0;
+    gt_disc_distri_foreach(fkv->distwildcardrangelength,
+                           gt_encseq_distri_merge, &merge);
+    if (fkv->minseqlen != GT_UNDEF_UWORD
+          && (*minseqlen == GT_UNDEF_UWORD || fkv->minseqlen < *minseqlen))
+      *minseqlen = fkv->minseqlen;
+    if (fkv->maxseqlen != GT_UNDEF_UWORD
+          && (*maxseqlen == GT_UNDEF_UWORD || fkv->maxseqlen > *maxseqlen))
+      *maxseqlen = fkv->maxseqlen;
+    if (equallength->defined) {
+      if (!fkv->equallength.defined
+            || (filenum > 0 && fkv->equallength.valueunsignedlong
+                                 != equallength->valueunsignedlong))
+        equallength->defined = false;
+      else
+        equallength->valueunsignedlong = fkv->equallength.valueunsignedlong;
+    }
+    if (fkv->descmaxlength > *descmaxlength)
+      *descmaxlength = fkv->descmaxlength;
+    if (desfp != NULL) {
+      if (sdsfp != NULL) {
+        GtUword offset, nextoffset;
+        bool hasoffset;
+
+        rewind(fkv->sdsfp);
+        hasoffset = gt_xfread_one(&offset, fkv->sdsfp) == (size_t) 1;
+        while (hasoffset) {
+          hasoffset = gt_xfread_one(&nextoffset, fkv->sdsfp) == (size_t) 1;
+          /* no offset follows the last sequence of the input */
+          if (!hasoffset && filenum == info->lastfilenum)
+            break;
+          offset += desoffset;
+          gt_xfwrite_one(&offset, sdsfp);
+          offset = nextoffset;
+        }
+      }
+      gt_encseq_filekeyvalues_copyfile(desfp, fkv->desfp);
+      desoffset = (GtUword) ftello(desfp);
+    }
+    if (md5fp != NULL)
+      gt_encseq_filekeyvalues_copyfile(md5fp, fkv->md5fp);
+  }
+  if (specialprefix)
+    specialcharinfo->lengthofspecialprefix = specialcarry;
+  specialcharinfo->lengthofwildcardprefix
+    = info->filekeyvalues[0].specialcharinfo.lengthofwildcardprefix;
+  return specialcarry;
+}
+
+static void gt_encseq_filekeyvalues_merge_exceptions(
+                                          const GtEncseqFilekeyvaluesinfo *info,
+                                          GtSpecialcharinfo *specialcharinfo)
+{
+  const GtUword numoffiles = gt_str_array_size(info->filenametab);
+  GtUword filenum;
+  bool in_range = false;
+
+  for (filenum = 0; filenum < numoffiles; filenum++) {
+    const GtEncseqFilekeyvalues *fkv = info->filekeyvalues + filenum;
+
+    specialcharinfo->exceptioncharacters
+      += fkv->specialcharinfo.exceptioncharacters;
+    specialcharinfo->realexceptionranges += fkv->exceptionranges;
+    if (fkv->hasnonseparator) {
+      /* separators do not end exception ranges */
+      if (in_range && fkv->exceptionatstart)
+        specialcharinfo->realexceptionranges--;
+      in_range = fkv->exceptionatend;
+    }
+  }
+}
+
+static GtEncseqFilekeyvalues *gt_encseq_filekeyvalues_new(
+                                                  const GtStrArray *filenametab,
+                                                  const GtAlphabet *alpha,
+                                                  bool outdestab,
+                                                  bool outsdstab,
+                                                  bool outmd5tab)
+{
+  const GtUword numoffiles = gt_str_array_size(filenametab);
+  GtEncseqFilekeyvalues *filekeyvalues;
+  GtUword filenum;
+
+  filekeyvalues = gt_calloc((size_t) numoffiles, sizeof (*filekeyvalues));
+  for (filenum = 0; filenum < numoffiles; filenum++) {
+    GtEncseqFilekeyvalues *fkv = filekeyvalues + filenum;
+
+    fkv->minseqlen = fkv->maxseqlen = GT_UNDEF_UWORD;
+    fkv->equallength.defined = true;
+    fkv->characterdistribution
+      = gt_calloc((size_t) gt_alphabet_num_of_chars(alpha),
+                  sizeof (*fkv->characterdistribution));
+    fkv->originaldistribution = gt_calloc((size_t) UCHAR_MAX,
+                                          sizeof (GtUword));
+    fkv->distspecialrangelength = gt_disc_distri_new();
+    fkv->distwildcardrangelength = gt_disc_distri_new();
+    if (outdestab) {
+      fkv->desfp = gt_xtmpfp_generic(NULL, TMPFP_OPENBINARY | TMPFP_AUTOREMOVE);
+      if (outsdstab)
+        fkv->sdsfp = gt_xtmpfp_generic(NULL,
+                                       TMPFP_OPENBINARY | TMPFP_AUTOREMOVE);
+    }
+    if (outmd5tab)
+      fkv->md5fp = gt_xtmpfp_generic(NULL, TMPFP_OPENBINARY | TMPFP_AUTOREMOVE);
+    fkv->err = gt_error_new();
+  }
+  return filekeyvalues;
+}
+
+static void gt_encseq_filekeyvalues_delete(GtEncseqFilekeyvalues
+                                             *filekeyvalues,
+                                           GtUword numoffiles)
+{
+  GtUword filenum;
+
+  if (filekeyvalues == NULL)
+    return;
+  for (filenum = 0; filenum < numoffiles; filenum++) {
+    GtEncseqFilekeyvalues *fkv = filekeyvalues + filenum;
+
+    gt_free(fkv->characterdistribution);
+    gt_free(fkv->originaldistribution);
+    gt_disc_distri_delete(fkv->distspecialrangelength);
+    gt_disc_distri_delete(fkv->distwildcardrangelength);
+    gt_fa_xfclose(fkv->desfp);
+    gt_fa_xfclose(fkv->sdsfp);
+    gt_fa_xfclose(fkv->md5fp);
+    gt_error_delete(fkv->err);
+  }
+  gt_free(filekeyvalues);
 }
 
 static int gt_inputfiles2sequencekeyvalues(const char *indexname,
@@ -5420,8 +6938,10 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
                 lengthofcurrentsequence = 0,
                 lengthofalphadef,
                 *originaldistribution = NULL,
-                md5_blockcount = 0;
+                md5_blockcount = 0,
+                descmaxlength = 0;
   bool specialprefix = true, wildcardprefix = true, haserr = false;
+  GtEncseqFilekeyvaluesinfo fkvinfo;
   GtDiscDistri *distspecialrangelength = NULL, *distwildcardrangelength = NULL;
   GtDescBuffer *descqueue = NULL;
   GtMD5Encoder *md5enc = NULL;
@@ -5441,6 +6961,9 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
   specialcharinfo->lengthofwildcardprefix = 0;
   specialcharinfo->lengthofwildcardsuffix = 0;
 
+  /* with several threads, multiple files are scanned in parallel and their
+     statistics are merged afterwards */
+  fkvinfo.filekeyvalues = NULL;
   if (plainformat) {
     fb = gt_sequence_buffer_plain_new(filenametab);
     equallength->defined = false;
@@ -5450,10 +6973,24 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
   }
   if (!fb)
     haserr = true;
+  if (!haserr && !plainformat && gt_jobs > 1U
+        && gt_str_array_size(filenametab) > 1UL) {
+    fkvinfo.filenametab = filenametab;
+    fkvinfo.guessedbuffer = fb;
+    fkvinfo.alpha = alpha;
+    fkvinfo.maxchars = NULL;
+    fkvinfo.clip_desc = clip_desc;
+    fkvinfo.outoistab = outoistab;
+    fkvinfo.filekeyvalues = gt_encseq_filekeyvalues_new(filenametab, alpha,
+                                                        outdestab, outsdstab,
+                                                        outmd5tab);
+  }
   if (!haserr && outdestab) {
-    descqueue = gt_desc_buffer_new();
-    if (clip_desc)
-      gt_desc_buffer_set_clip_at_whitespace(descqueue);
+    if (fkvinfo.filekeyvalues == NULL) {
+      descqueue = gt_desc_buffer_new();
+      if (clip_desc)
+        gt_desc_buffer_set_clip_at_whitespace(descqueue);
+    }
     desfp = gt_fa_fopen_with_suffix(indexname, GT_DESTABFILESUFFIX, "wb", err);
     if (desfp == NULL)
       haserr = true;
@@ -5469,24 +7006,55 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
       haserr = true;
   }
   if (!haserr) {
+    *filelengthtab = gt_calloc((size_t) gt_str_array_size(filenametab),
+                               sizeof (GtFilelengthvalues));
+    distspecialrangelength = gt_disc_distri_new();
+    distwildcardrangelength = gt_disc_distri_new();
+    originaldistribution = gt_calloc((size_t) UCHAR_MAX,
+                                     sizeof (GtUword));
+  }
+  if (!haserr && fkvinfo.filekeyvalues != NULL) {
+    if (gt_encseq_filekeyvalues_run(&fkvinfo, err) != 0)
+      haserr = true;
+    else {
+      const GtEncseqFilekeyvalues *lastfkv
+        = fkvinfo.filekeyvalues + fkvinfo.lastfilenum;
+
+      lastspecialrangelength
+        = gt_encseq_filekeyvalues_merge(&fkvinfo, &currentpos, specialcharinfo,
+                                        equallength, *filelengthtab,
+                                        characterdistribution,
+                                        originaldistribution,
+                                        distspecialrangelength,
+                                        distwildcardrangelength,
+                                        numofseparators, minseqlen, maxseqlen,
+                                        &descmaxlength, desfp, sdsfp, md5fp);
+      if (lastspecialrangelength > 0)
+        gt_disc_distri_add(distspecialrangelength, lastspecialrangelength);
+      lastwildcardrangelength
+        = lastfkv->specialcharinfo.lengthofwildcardsuffix;
+      lengthofcurrentsequence = lastfkv->lengthofcurrentsequence;
+#if !(defined (_LP64) || defined (_WIN64))
+      if (currentpos > MAXSFXLENFOR32BIT) {
+        gt_error_set(err, "input sequence must not be longer than "GT_WU"",
+                     MAXSFXLENFOR32BIT);
+        haserr = true;
+      }
+#endif
+    }
+  }
+  else if (!haserr) {
     char cc;
     const GtAlphabet *a = alpha;
     gt_sequence_buffer_set_symbolmap(fb, gt_alphabet_symbolmap(alpha));
-    *filelengthtab = gt_calloc((size_t) gt_str_array_size(filenametab),
-                               sizeof (GtFilelengthvalues));
     gt_sequence_buffer_set_filelengthtab(fb, *filelengthtab);
     if (descqueue != NULL)
       gt_sequence_buffer_set_desc_buffer(fb, descqueue);
     gt_sequence_buffer_set_chardisttab(fb, characterdistribution);
-    distspecialrangelength = gt_disc_distri_new();
-    distwildcardrangelength = gt_disc_distri_new();
-    originaldistribution = gt_calloc((size_t) UCHAR_MAX,
-                                     sizeof (GtUword));
     if (md5fp != NULL)
       md5enc = gt_md5_encoder_new();
     for (currentpos = 0; !haserr; currentpos++) {
 #if !(defined (_LP64) || defined (_WIN64))
-#define MAXSFXLENFOR32BIT 4294000000UL
       if (currentpos > MAXSFXLENFOR32BIT) {
         gt_error_set(err, "input sequence must not be longer than "GT_WU"",
                      MAXSFXLENFOR32BIT);
@@ -5564,7 +7132,14 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
     determine_original_subdist(alpha, maxchars, allchars, subsymbolmap,
                                maxsubalphasize, numofallchars,
                                classstartpositions, originaldistribution);
-    if (outoistab) {
+    if (outoistab && fkvinfo.filekeyvalues != NULL) {
+      fkvinfo.maxchars = maxchars;
+      if (gt_encseq_filekeyvalues_run(&fkvinfo, err) != 0)
+        haserr = true;
+      else
+        gt_encseq_filekeyvalues_merge_exceptions(&fkvinfo, specialcharinfo);
+    }
+    else if (outoistab) {
       retval = countnumberofexceptionranges(alpha, plainformat, filenametab,
                                             specialcharinfo, maxchars, err);
       if (retval != 0)
@@ -5575,10 +7150,13 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
     if (desfp != NULL) {
       GtUword longestdesc,
                     fin = ~0UL;
-      desc = (char*) gt_desc_buffer_get_next(descqueue);
-      longestdesc = gt_desc_buffer_max_length(descqueue) - 1;
-      gt_xfputs(desc, desfp);
-      gt_xfputc((int) '\n', desfp);
+      if (descqueue != NULL) {
+        desc = (char*) gt_desc_buffer_get_next(descqueue);
+        descmaxlength = gt_desc_buffer_max_length(descqueue);
+        gt_xfputs(desc, desfp);
+        gt_xfputc((int) '\n', desfp);
+      }
+      longestdesc = descmaxlength - 1;
       gt_xfwrite_one(&longestdesc, desfp);
       gt_xfwrite_one(&fin, desfp); /* to ensure that there is no \n in new-style
                                       .des files */
@@ -5628,6 +7206,8 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
   gt_fa_xfclose(md5fp);
   gt_sequence_buffer_delete(fb);
   gt_desc_buffer_delete(descqueue);
+  gt_encseq_filekeyvalues_delete(fkvinfo.filekeyvalues,
+                                 gt_str_array_size(filenametab));
 #ifndef NDEBUG
   gt_GtSpecialcharinfo_check(specialcharinfo, *numofseparators);
 #endif
@@ -5800,6 +7380,339 @@ static inline GtBitsequence revextractspecialbits(
   }
 }
 
+void gt_encseq_extract_twobitwords(GtTwobitencoding *words,
+                                   const GtEncseq *encseq,
+                                   GtUword frompos,
+                                   GtUword numofwords)
+{
+  const GtTwobitencoding *tbe;
+  GtUword idx, unit, remain;
+
+  gt_assert(encseq != NULL && encseq->twobitencoding != NULL);
+  tbe = encseq->twobitencoding;
+  unit = GT_DIVBYUNITSIN2BITENC(frompos);
+  remain = GT_MODBYUNITSIN2BITENC(frompos);
+  for (idx = 0; idx < numofwords; idx++, unit++) {
+    GtTwobitencoding left, right;
+
+    left = unit < encseq->unitsoftwobitencoding ? tbe[unit] : 0;
+    if (remain == 0) {
+      words[idx] = left;
+    } else {
+      right = unit + 1 < encseq->unitsoftwobitencoding ? tbe[unit+1] : 0;
+      words[idx] = (GtTwobitencoding)
+                   ((left << GT_MULT2(remain)) |
+                    (right >> GT_MULT2(GT_UNITSIN2BITENC - remain)));
+    }
+  }
+}
+
+#define GT_ENCSEQ_BLOCKTWOBITS(BLOCK,IDX)\
+        ((GtUchar) (((BLOCK)->tbe[GT_DIVBYUNITSIN2BITENC(IDX)] >>\
+                     GT_MULT2(GT_UNITSIN2BITENC - 1 -\
+                              GT_MODBYUNITSIN2BITENC(IDX))) & 3))
+
+/* Fill <block> for <frompos> position by position. This handles all access
+   types and the virtual mirror sequence. */
+static void gt_encseq_extract_block_bruteforce(GtEncseqBlock *block,
+                                               GtUchar *specialchars,
+                                               const GtEncseq *encseq,
+                                               GtUword frompos)
+{
+  GtUword idx;
+
+  memset(block->tbe, 0, sizeof block->tbe);
+  block->specialmask = 0;
+  for (idx = 0; idx < (GtUword) GT_ENCSEQ_BLOCKSIZE; idx++) {
+    GtUchar cc;
+
+    if (frompos + idx >= encseq->logicaltotallength) {
+      block->specialmask |= GT_ENCSEQ_BLOCKBIT(idx);
+      continue;
+    }
+    cc = gt_encseq_get_encoded_char(encseq, frompos + idx,
+                                    GT_READMODE_FORWARD);
+    if (ISSPECIAL(cc)) {
+      block->specialmask |= GT_ENCSEQ_BLOCKBIT(idx);
+      if (specialchars != NULL)
+        specialchars[idx] = cc;
+    } else {
+      block->tbe[GT_DIVBYUNITSIN2BITENC(idx)]
+        |= ((GtTwobitencoding) cc)
+           << GT_MULT2(GT_UNITSIN2BITENC - 1 - GT_MODBYUNITSIN2BITENC(idx));
+    }
+  }
+}
+
+/* As <gt_encseq_extract_block()>, but if <specialchars> is not NULL, it also
+   stores the special character of each position marked in the mask which is
+   smaller than the total length. */
+static void gt_encseq_extract_block_specialchars(GtEncseqBlock *block,
+                                                 GtUchar *specialchars,
+                                                 const GtEncseq *encseq,
+                                                 GtEncseqReader *esr,
+                                                 GtUword frompos)
+{
+  GtUword idx, width;
+
+  gt_assert(encseq != NULL && encseq->numofchars == 4U &&
+            frompos < encseq->logicaltotallength);
+  if (encseq->twobitencoding == NULL ||
+      (encseq->hasmirror &&
+       frompos + GT_ENCSEQ_BLOCKSIZE > encseq->totallength)) {
+    gt_encseq_extract_block_bruteforce(block, specialchars, encseq, frompos);
+    return;
+  }
+  gt_assert(frompos < encseq->totallength);
+  gt_encseq_extract_twobitwords(block->tbe, encseq, frompos,
+                                (GtUword) GT_ENCSEQ_BLOCKSIZE/
+                                          GT_UNITSIN2BITENC);
+  width = encseq->totallength - frompos;
+  if (width < (GtUword) GT_ENCSEQ_BLOCKSIZE) {
+    block->specialmask = ~((uint64_t) 0) >> width;
+  } else {
+    width = (GtUword) GT_ENCSEQ_BLOCKSIZE;
+    block->specialmask = 0;
+  }
+  if (!encseq->has_specialranges)
+    return;
+  if (encseq->accesstype_via_utables) {
+    if (esr != NULL) {
+      if (!gt_encseq_contains_special(encseq, GT_READMODE_FORWARD, esr,
+                                      frompos, width)) {
+        return;
+      }
+      /* the reader delivers runs of special characters more efficiently
+         than single position lookups */
+      gt_encseq_reader_reinit_with_readmode(esr, encseq, GT_READMODE_FORWARD,
+                                            frompos);
+      for (idx = 0; idx < width; idx++) {
+        GtUchar cc = gt_encseq_reader_next_encoded_char(esr);
+        if (ISSPECIAL(cc)) {
+          block->specialmask |= GT_ENCSEQ_BLOCKBIT(idx);
+          if (specialchars != NULL)
+            specialchars[idx] = cc;
+        }
+      }
+      return;
+    }
+    /* specials are stored as the least probable character, so only these
+       positions need to be looked up */
+    for (idx = 0; idx < width; idx++) {
+      if (GT_ENCSEQ_BLOCKTWOBITS(block, idx) ==
+          (GtUchar) encseq->leastprobablecharacter) {
+        GtUchar cc = gt_encseq_get_encoded_char(encseq, frompos + idx,
+                                                GT_READMODE_FORWARD);
+        if (ISSPECIAL(cc)) {
+          block->specialmask |= GT_ENCSEQ_BLOCKBIT(idx);
+          if (specialchars != NULL)
+            specialchars[idx] = cc;
+        }
+      }
+    }
+    return;
+  }
+  switch (encseq->sat) {
+    case GT_ACCESS_TYPE_EQUALLENGTH:
+      if (encseq->numofdbsequences > 1UL) {
+        GtUword seplen = encseq->equallength.valueunsignedlong + 1,
+                seppos = encseq->equallength.valueunsignedlong;
+
+        if (frompos > seppos)
+          seppos += ((frompos - seppos + seplen - 1)/seplen) * seplen;
+        for (/* Nothing */; seppos < frompos + width; seppos += seplen) {
+          block->specialmask |= GT_ENCSEQ_BLOCKBIT(seppos - frompos);
+          if (specialchars != NULL)
+            specialchars[seppos - frompos] = (GtUchar) SEPARATOR;
+        }
+      }
+      break;
+    case GT_ACCESS_TYPE_BITACCESS:
+      for (idx = 0; idx < width; idx += GT_INTWORDSIZE) {
+        GtUword unit = GT_DIVWORDSIZE(frompos + idx),
+                remain = GT_MODWORDSIZE(frompos + idx);
+        GtBitsequence bits = encseq->specialbits[unit] << remain;
+        uint64_t mask;
+
+        if (remain > 0)
+          bits |= encseq->specialbits[unit+1] >> (GT_INTWORDSIZE - remain);
+        mask = ((uint64_t) bits) << (GT_ENCSEQ_BLOCKSIZE - GT_INTWORDSIZE);
+        block->specialmask |= mask >> idx;
+      }
+      if (width < (GtUword) GT_ENCSEQ_BLOCKSIZE) {
+        block->specialmask |= ~((uint64_t) 0) >> width;
+      }
+      if (specialchars != NULL) {
+        uint64_t mask;
+
+        for (mask = block->specialmask, idx = 0; idx < width;
+             idx++, mask <<= 1) {
+          if (mask & GT_ENCSEQ_BLOCKBIT(0)) {
+            specialchars[idx] = GT_ENCSEQ_BLOCKTWOBITS(block, idx)
+                                  == (GtUchar) GT_TWOBITS_FOR_SEPARATOR
+                                ? (GtUchar) SEPARATOR
+                                : (GtUchar) WILDCARD;
+          }
+        }
+      }
+      break;
+    default:
+      gt_encseq_extract_block_bruteforce(block, specialchars, encseq,
+                                         frompos);
+      break;
+  }
+}
+
+void gt_encseq_extract_block(GtEncseqBlock *block,
+                             const GtEncseq *encseq,
+                             GtEncseqReader *esr,
+                             GtUword frompos)
+{
+  gt_encseq_extract_block_specialchars(block, NULL, encseq, esr, frompos);
+}
+
+void gt_encseq_twobitencoding_decode(GtUchar *buffer,
+                                     const GtTwobitencoding *words,
+                                     GtUword numofchars)
+{
+  GtUword idx, widx = 0;
+
+#ifdef GT_ENCSEQ_DECODE_SSE2
+  /* 2 words of 32 characters are decoded at once: the bytes are brought into
+     sequence order and the four characters of each byte are extracted into
+     four vectors which are then interleaved */
+  const __m128i charmask = _mm_set1_epi8(3);
+
+  for (/* Nothing */; numofchars >= (GtUword) GT_MULT2(GT_UNITSIN2BITENC);
+       numofchars -= GT_MULT2(GT_UNITSIN2BITENC), widx += 2,
+       buffer += GT_MULT2(GT_UNITSIN2BITENC)) {
+    __m128i bytes, c0, c1, c2, c3, c01, c23;
+
+    bytes = _mm_set_epi64x((long long) __builtin_bswap64(words[widx+1]),
+                           (long long) __builtin_bswap64(words[widx]));
+    c0 = _mm_and_si128(_mm_srli_epi16(bytes, 6), charmask);
+    c1 = _mm_and_si128(_mm_srli_epi16(bytes, 4), charmask);
+    c2 = _mm_and_si128(_mm_srli_epi16(bytes, 2), charmask);
+    c3 = _mm_and_si128(bytes, charmask);
+    c01 = _mm_unpacklo_epi8(c0, c1);
+    c23 = _mm_unpacklo_epi8(c2, c3);
+    _mm_storeu_si128((__m128i *) buffer, _mm_unpacklo_epi16(c01, c23));
+    _mm_storeu_si128((__m128i *) (buffer + 16),
+                     _mm_unpackhi_epi16(c01, c23));
+    c01 = _mm_unpackhi_epi8(c0, c1);
+    c23 = _mm_unpackhi_epi8(c2, c3);
+    _mm_storeu_si128((__m128i *) (buffer + 32),
+                     _mm_unpacklo_epi16(c01, c23));
+    _mm_storeu_si128((__m128i *) (buffer + 48),
+                     _mm_unpackhi_epi16(c01, c23));
+  }
+#endif
+  for (/* Nothing */; numofchars >= (GtUword) GT_UNITSIN2BITENC;
+       numofchars -= GT_UNITSIN2BITENC, widx++,
+       buffer += GT_UNITSIN2BITENC) {
+    GtTwobitencoding tbe = words[widx];
+
+    for (idx = 0; idx < (GtUword) GT_UNITSIN2BITENC; idx++) {
+      buffer[idx] = (GtUchar) ((tbe >> GT_MULT2(GT_UNITSIN2BITENC - 1 - idx))
+                               & 3);
+    }
+  }
+  for (idx = 0; idx < numofchars; idx++) {
+    buffer[idx] = (GtUchar) ((words[widx] >>
+                              GT_MULT2(GT_UNITSIN2BITENC - 1 - idx)) & 3);
+  }
+}
+
+/* Decode the <numofchars> characters beginning at <frompos> in forward
+   direction into <buffer>, using <esr> as workspace. */
+static void gt_encseq_extract_encoded_blockwise(GtEncseqReader *esr,
+                                                const GtEncseq *encseq,
+                                                GtUchar *buffer,
+                                                GtUword frompos,
+                                                GtUword numofchars)
+{
+  GtEncseqBlock block;
+  GtUchar specialchars[GT_ENCSEQ_BLOCKSIZE],
+          charbuffer[GT_ENCSEQ_BLOCKSIZE];
+  GtUword offset;
+
+  for (offset = 0; offset < numofchars; offset += GT_ENCSEQ_BLOCKSIZE) {
+    GtUword idx, width = MIN((GtUword) GT_ENCSEQ_BLOCKSIZE,
+                             numofchars - offset);
+    GtUchar *dest = buffer + offset;
+    uint64_t mask;
+
+    gt_encseq_extract_block_specialchars(&block, specialchars, encseq, esr,
+                                         frompos + offset);
+    if (width == (GtUword) GT_ENCSEQ_BLOCKSIZE) {
+      gt_encseq_twobitencoding_decode(dest, block.tbe, width);
+    } else {
+      gt_encseq_twobitencoding_decode(charbuffer, block.tbe,
+                                      (GtUword) GT_ENCSEQ_BLOCKSIZE);
+      memcpy(dest, charbuffer, sizeof *dest * width);
+    }
+    for (mask = block.specialmask, idx = 0; mask != 0 && idx < width;
+         idx++, mask <<= 1) {
+      if (mask & GT_ENCSEQ_BLOCKBIT(0))
+        dest[idx] = specialchars[idx];
+    }
+  }
+}
+
+void gt_encseq_reader_next_encoded_chars(GtEncseqReader *esr,
+                                         GtUchar *buffer,
+                                         GtUword numofchars)
+{
+  const GtEncseq *encseq;
+  GtReadmode readmode;
+  GtUword idx, frompos, nextpos;
+
+  gt_assert(esr != NULL && esr->encseq != NULL);
+  encseq = esr->encseq;
+  readmode = esr->readmode;
+  if (numofchars < (GtUword) GT_ENCSEQ_BLOCKSIZE ||
+      encseq->twobitencoding == NULL || encseq->hasmirror) {
+    for (idx = 0; idx < numofchars; idx++)
+      buffer[idx] = gt_encseq_reader_next_encoded_char(esr);
+    return;
+  }
+  if (GT_ISDIRREVERSE(readmode)) {
+    gt_assert(esr->currentpos + 1 >= numofchars);
+    frompos = esr->currentpos + 1 - numofchars;
+    nextpos = GT_REVERSEPOS(encseq->totallength, frompos) + 1;
+  } else {
+    gt_assert(esr->currentpos + numofchars <= encseq->totallength);
+    frompos = esr->currentpos;
+    nextpos = frompos + numofchars;
+  }
+  gt_encseq_extract_encoded_blockwise(esr, encseq, buffer, frompos,
+                                      numofchars);
+  if (GT_ISDIRREVERSE(readmode)) {
+    GtUchar tmp;
+
+    for (idx = 0; idx < GT_DIV2(numofchars); idx++) {
+      tmp = buffer[idx];
+      buffer[idx] = buffer[numofchars - 1 - idx];
+      buffer[numofchars - 1 - idx] = tmp;
+    }
+  }
+  if (GT_ISDIRCOMPLEMENT(readmode)) {
+    for (idx = 0; idx < numofchars; idx++) {
+      if (ISNOTSPECIAL(buffer[idx]))
+        buffer[idx] = GT_COMPLEMENTBASE(buffer[idx]);
+    }
+  }
+  /* continue behind the extracted characters; <nextpos> is given with
+     respect to <readmode> */
+  if (nextpos < encseq->totallength) {
+    gt_encseq_reader_reinit_with_readmode(esr, encseq, readmode, nextpos);
+  } else {
+    esr->readmode = readmode;
+    esr->currentpos = GT_ISDIRREVERSE(readmode) ? GT_UWORD_MAX
+                                                : encseq->totallength;
+  }
+}
+
 static inline unsigned int numberoftrailingzeros32 (uint32_t x)
 {
   static const unsigned int MultiplyDeBruijnBitPosition[32] =
@@ -6664,6 +8577,10 @@ size_t gt_encseq_sequence_mapoffset(const GtEncseq *encseq)
       return (size_t) ((unsigned char *) encseq->plainseq -
                        (unsigned char *) encseq->mappedptr);
     }
+    else if (encseq->sat == GT_ACCESS_TYPE_BLOCKCOMPRESS) {
+      return (size_t) ((unsigned char *) encseq->blockcompresssizes -
+                       (unsigned char *) encseq->mappedptr);
+    }
     else {
       return (size_t) ((unsigned char *) encseq->bitpackarray -
                        (unsigned char *) encseq->mappedptr);
@@ -7658,6 +9575,11 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
     if (flushoistab2file(indexname, encseq, err) != 0)
       haserr = true;
   }
+  if (!haserr && encseq != NULL &&
+      encseq->sat == GT_ACCESS_TYPE_BLOCKCOMPRESS) {
+    if (flushblockcompressspace2file(indexname, encseq, err) != 0)
+      haserr = true;
+  }
   if (maxchars != NULL)
     gt_free(maxchars);
   if (allchars != NULL)
@@ -7731,6 +9653,62 @@ static void runscanatpostrial(const GtEncseq *encseq,
   }
 }
 
+static void checkextractblocks(const GtEncseq *encseq, GtReadmode readmode)
+{
+  GtEncseqReader *esr1, *esr2;
+  GtEncseqBlock block;
+  GtUchar buffer[GT_ENCSEQ_BLOCKSIZE + 256 + 1];
+  GtUword frompos, idx, step, totallength = encseq->logicaltotallength;
+
+  step = totallength <= 4096UL ? 1UL : 61UL;
+  esr1 = gt_encseq_create_reader_with_readmode(encseq, readmode, 0);
+  esr2 = gt_encseq_create_reader_with_readmode(encseq, readmode, 0);
+  for (frompos = 0; frompos < totallength; frompos += step) {
+    GtUword numofchars = MIN(totallength - frompos,
+                             (GtUword) GT_ENCSEQ_BLOCKSIZE + frompos % 256);
+
+    if (encseq->numofchars == 4U && readmode == GT_READMODE_FORWARD) {
+      gt_encseq_extract_block(&block, encseq, esr1, frompos);
+      for (idx = 0; idx < (GtUword) GT_ENCSEQ_BLOCKSIZE; idx++) {
+        GtUchar cc = frompos + idx < totallength
+                       ? gt_encseq_get_encoded_char(encseq, frompos + idx,
+                                                    GT_READMODE_FORWARD)
+                       : (GtUchar) SEPARATOR;
+        bool special = (block.specialmask & GT_ENCSEQ_BLOCKBIT(idx))
+                         ? true : false;
+
+        if (special != (bool) ISSPECIAL(cc) ||
+            (!special && GT_ENCSEQ_BLOCKTWOBITS(&block, idx) != cc)) {
+          fprintf(stderr, "checkextractblocks: block at "GT_WU" differs at "
+                          "offset "GT_WU"\n", frompos, idx);
+          exit(GT_EXIT_PROGRAMMING_ERROR);
+        }
+      }
+    }
+    gt_encseq_reader_reinit_with_readmode(esr1, encseq, readmode, frompos);
+    gt_encseq_reader_reinit_with_readmode(esr2, encseq, readmode, frompos);
+    gt_encseq_reader_next_encoded_chars(esr1, buffer, numofchars);
+    /* after the bulk extraction, the reader continues sequentially */
+    if (frompos + numofchars < totallength) {
+      buffer[numofchars] = gt_encseq_reader_next_encoded_char(esr1);
+      numofchars++;
+    }
+    for (idx = 0; idx < numofchars; idx++) {
+      GtUchar cc = gt_encseq_reader_next_encoded_char(esr2);
+
+      if (buffer[idx] != cc) {
+        fprintf(stderr, "checkextractblocks: reading from "GT_WU" in readmode "
+                        "%s delivers %u instead of %u at offset "GT_WU"\n",
+                        frompos, gt_readmode_show(readmode),
+                        (unsigned int) buffer[idx], (unsigned int) cc, idx);
+        exit(GT_EXIT_PROGRAMMING_ERROR);
+      }
+    }
+  }
+  gt_encseq_reader_delete(esr1);
+  gt_encseq_reader_delete(esr2);
+}
+
 static void testseqnumextraction(const GtEncseq *encseq)
 {
   GtUchar cc;
@@ -7925,6 +9903,7 @@ int gt_encseq_check_consistency(const GtEncseq *encseq,
 
   if (encseq->sat != GT_ACCESS_TYPE_DIRECTACCESS &&
       encseq->sat != GT_ACCESS_TYPE_BYTECOMPRESS &&
+      encseq->sat != GT_ACCESS_TYPE_BLOCKCOMPRESS &&
       !encseq->hasmirror) {
     if (withcheckunit) {
       gt_logger_log(logger, "run checkextractunitatpos");
@@ -7943,6 +9922,8 @@ int gt_encseq_check_consistency(const GtEncseq *encseq,
     gt_logger_log(logger, "run testscanatpos for "GT_WU" trials", scantrials);
     testscanatpos(encseq, readmode, scantrials);
   }
+  gt_logger_log(logger, "run checkextractblocks");
+  checkextractblocks(encseq, readmode);
   if (withseqnumcheck && readmode == GT_READMODE_FORWARD) {
     gt_logger_log(logger, "run testseqnumextraction");
     testseqnumextraction(encseq);
@@ -8482,6 +10463,7 @@ struct GtEncseqLoader {
        md5tab,
        mirrored,
        autodiscover;
+  GtFaAdvice mmapadvice;
   GtLogger *logger;
 };
 
@@ -8494,6 +10476,7 @@ GtEncseqLoader* gt_encseq_loader_new()
   gt_encseq_loader_drop_description_support(el);
   gt_encseq_loader_enable_autosupport(el);
   gt_encseq_loader_do_not_mirror(el);
+  el->mmapadvice = GT_FA_ADVICE_NORMAL;
   return el;
 }
 
@@ -8674,6 +10657,12 @@ void gt_encseq_loader_set_logger(GtEncseqLoader *el, GtLogger *l)
   el->logger = l;
 }
 
+void gt_encseq_loader_set_mmap_advice(GtEncseqLoader *el, GtFaAdvice advice)
+{
+  gt_assert(el);
+  el->mmapadvice = advice;
+}
+
 void gt_encseq_loader_mirror(GtEncseqLoader *el)
 {
   gt_assert(el);
@@ -8729,6 +10718,8 @@ GtEncseq* gt_encseq_loader_load(GtEncseqLoader *el, const char *indexname,
       encseq = NULL;
     }
   }
+  if (encseq && el->mmapadvice != GT_FA_ADVICE_NORMAL)
+    gt_encseq_madvise(encseq, el->mmapadvice);
   return encseq;
 }
 
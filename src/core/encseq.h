@@ -27,6 +27,7 @@
 #include "core/encseq_api.h"
 #include "core/encseq_access_type.h"
 #include "core/encseq_options.h"
+#include "core/fa.h"
 #include "core/filelengthvalues.h"
 #include "core/intbits.h"
 #include "core/md5_tab.h"
@@ -56,6 +57,19 @@ GtEncseqEncoder* gt_encseq_encoder_new_from_options(GtEncseqOptions *opts,
 GtEncseqLoader* gt_encseq_loader_new_from_options(GtEncseqOptions *opts,
                                                   GtError *err);
 
+/* Sets the access pattern which is announced to the operating system for
+   the memory mapped tables of encoded sequences loaded by <el>, see
+   <gt_encseq_madvise()>. Default is <GT_FA_ADVICE_NORMAL>. */
+void gt_encseq_loader_set_mmap_advice(GtEncseqLoader *el, GtFaAdvice advice);
+
+/* Announces that the memory mapped tables of <encseq> are accessed according
+   to <advice>. As the tables are mapped read-only from the index files, all
+   processes using the same index share one copy of them in the page cache;
+   with <GT_FA_ADVICE_WILLNEED> this copy is filled in the background, so that
+   later accesses do not wait for the disk. Tables which are not mapped are
+   not affected. */
+void gt_encseq_madvise(const GtEncseq *encseq, GtFaAdvice advice);
+
 /* Do not output the header of the esq-file. This is needed
    for generating testcases for Timo Beller. */
 
@@ -333,6 +347,60 @@ unsigned int gt_encseq_relpos_extract2bitencvector(
                                           GtUword relpos,
                                           GtUword maxnofelem);
 
+/* The number of positions covered by a <GtEncseqBlock>. */
+#define GT_ENCSEQ_BLOCKSIZE 64
+
+/* The bit of <GtEncseqBlock.specialmask> for the position with offset <IDX>
+   in the block. */
+#define GT_ENCSEQ_BLOCKBIT(IDX)\
+        (((uint64_t) 1) << (GT_ENCSEQ_BLOCKSIZE - 1 - (IDX)))
+
+/* The following type stores the characters of <GT_ENCSEQ_BLOCKSIZE>
+   consecutive positions of an encoded sequence over a DNA alphabet in
+   forward direction: <tbe> stores their two bit encodings and
+   <specialmask> marks the positions which are special characters or beyond
+   the end of the sequence. The two bit encodings of the marked positions are
+   undefined. */
+typedef struct
+{
+  GtTwobitencoding tbe[GT_ENCSEQ_BLOCKSIZE/GT_UNITSIN2BITENC];
+  uint64_t specialmask;
+} GtEncseqBlock;
+
+/* The following function stores in <words> the <numofwords> two bit
+   encodings of the <numofwords> * <GT_UNITSIN2BITENC> characters beginning
+   at position <frompos> of <encseq>, which must have a two bit encoding (see
+   <gt_encseq_has_twobitencoding()>). The two bit encodings of special
+   characters and of positions beyond the end of the sequence are
+   undefined. */
+void gt_encseq_extract_twobitwords(GtTwobitencoding *words,
+                                   const GtEncseq *encseq,
+                                   GtUword frompos,
+                                   GtUword numofwords);
+
+/* The following function stores in <block> the characters of the
+   <GT_ENCSEQ_BLOCKSIZE> positions beginning at position <frompos> of <encseq>,
+   which must be over a DNA alphabet. <esr> is used as workspace for some
+   access types and is reinitialized. */
+void gt_encseq_extract_block(GtEncseqBlock *block,
+                             const GtEncseq *encseq,
+                             GtEncseqReader *esr,
+                             GtUword frompos);
+
+/* The following function stores the <numofchars> characters encoded by the
+   two bit encodings <words> (beginning with the first character of
+   <words[0]>) as bytes in <buffer>. */
+void gt_encseq_twobitencoding_decode(GtUchar *buffer,
+                                     const GtTwobitencoding *words,
+                                     GtUword numofchars);
+
+/* The following function stores the next <numofchars> encoded characters
+   delivered by <esr> in <buffer>, like <numofchars> calls of
+   <gt_encseq_reader_next_encoded_char()>. */
+void gt_encseq_reader_next_encoded_chars(GtEncseqReader *esr,
+                                         GtUchar *buffer,
+                                         GtUword numofchars);
+
 /* The following function compares the two bit encodings <ptbe1> and <ptbe2>
   and stores the result of the comparison in <commonunits>. The comparison is
   done in forward direction iff <fwd> is true.
@@ -41,12 +41,14 @@ static GtWrittenAccessType wpa[] = {
   {GT_ACCESS_TYPE_BITACCESS, "bit"},
   {GT_ACCESS_TYPE_UCHARTABLES, "uchar"},
   {GT_ACCESS_TYPE_USHORTTABLES, "ushort"},
-  {GT_ACCESS_TYPE_UINT32TABLES, "uint32"}
+  {GT_ACCESS_TYPE_UINT32TABLES, "uint32"},
+  {GT_ACCESS_TYPE_BLOCKCOMPRESS, "blockcompress"}
 };
 
 const char* gt_encseq_access_type_list(void)
 {
-  return "direct, bytecompress, eqlen, bit, uchar, ushort, uint32";
+  return "direct, bytecompress, eqlen, bit, uchar, ushort, uint32, "
+         "blockcompress";
 }
 
 const char* gt_encseq_access_type_str(GtEncseqAccessType at)
@@ -73,7 +75,8 @@ GtEncseqAccessType gt_encseq_access_type_get(const char *str)
 bool gt_encseq_access_type_isviautables(GtEncseqAccessType sat)
 {
   gt_assert(sat != GT_ACCESS_TYPE_UNDEFINED);
-  return (sat >= GT_ACCESS_TYPE_UCHARTABLES) ? true : false;
+  return (sat >= GT_ACCESS_TYPE_UCHARTABLES &&
+          sat <= GT_ACCESS_TYPE_UINT32TABLES) ? true : false;
 }
 
 #define CHECKANDUPDATE(SAT,IDX)\
@@ -181,6 +184,7 @@ int gt_encseq_access_type_determine(GtUword *specialranges,
           break;
         case GT_ACCESS_TYPE_DIRECTACCESS:
         case GT_ACCESS_TYPE_BITACCESS:
+        case GT_ACCESS_TYPE_BLOCKCOMPRESS:
           break;
         case GT_ACCESS_TYPE_EQUALLENGTH:
           if (equallength == NULL || !equallength->defined) {
@@ -208,13 +212,17 @@ int gt_encseq_access_type_determine(GtUword *specialranges,
     } else
     {
       if (sat != GT_ACCESS_TYPE_BYTECOMPRESS &&
-          sat != GT_ACCESS_TYPE_DIRECTACCESS)
+          sat != GT_ACCESS_TYPE_DIRECTACCESS &&
+          sat != GT_ACCESS_TYPE_BLOCKCOMPRESS)
       {
         gt_error_set(err,"illegal argument \"%s\" to option -sat: "
-                        "as the sequence is not DNA, you can choose %s or %s",
+                        "as the sequence is not DNA, you can choose %s, %s "
+                        "or %s",
                         str_sat,
                         gt_encseq_access_type_str(GT_ACCESS_TYPE_BYTECOMPRESS),
-                        gt_encseq_access_type_str(GT_ACCESS_TYPE_DIRECTACCESS));
+                        gt_encseq_access_type_str(GT_ACCESS_TYPE_DIRECTACCESS),
+                        gt_encseq_access_type_str(
+                                                GT_ACCESS_TYPE_BLOCKCOMPRESS));
         haserr = true;
       }
     }
@@ -30,6 +30,7 @@ typedef enum
   GT_ACCESS_TYPE_UCHARTABLES,
   GT_ACCESS_TYPE_USHORTTABLES,
   GT_ACCESS_TYPE_UINT32TABLES,
+  GT_ACCESS_TYPE_BLOCKCOMPRESS,
   GT_ACCESS_TYPE_UNDEFINED
 } GtEncseqAccessType;
 
@@ -76,6 +76,8 @@ typedef struct GtEncseqReader GtEncseqReader;
 #define GT_OISTABFILESUFFIX ".ois"
 /* The file suffix used for MD5 fingerprints. */
 #define GT_MD5TABFILESUFFIX ".md5"
+/* The file suffix used for the phrases of compressed sequence data. */
+#define GT_BCSTABFILESUFFIX ".bcs"
 
 /* Returns the indexname (as given at loading time) of <encseq> or the string
    "generated" if the GtEncseq was build in memory only. */
@@ -226,7 +226,7 @@ gt_encseq_options_register_generic(GtOptionParser *op,
                                          "representation\n"
                                          "by one of the keywords direct, "
                                          "bytecompress, eqlen, bit, uchar, "
-                                         "ushort, uint32",
+                                         "ushort, uint32, blockcompress",
                                          oi->sat, NULL);
     gt_option_parser_add_option(op, oi->optionsat);
 
@@ -199,6 +199,25 @@ struct GtEncseq
               GT_ACCESS_TYPE_UINT32TABLES */
   GtSWtable wildcardrangetable;
 
+  /* only for GT_ACCESS_TYPE_BLOCKCOMPRESS */
+  uint64_t *blockcompresssizes, /* sizes of the following tables */
+           *blockcompressspace; /* the following tables */
+  const uint64_t *phrasestarts,
+                 *phrasesources,
+                 *specialstarts,
+                 *speciallengths,
+                 *literals;
+  GtUword numofphrases,
+          numofspecialranges,
+          numofliterals,
+          *phrasesample,
+          *specialsample;
+  unsigned int positionbits,
+               sourcebits,
+               speciallengthbits,
+               literalbits;
+  bool hasallocatedblockcompressspace;
+
   /* for lossless reproduction of original sequences */
   bool has_exceptiontable;
   GtSWtable exceptiontable;
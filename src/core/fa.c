@@ -687,6 +687,38 @@ void gt_fa_xmunmap(void *addr)
   gt_mutex_unlock(fa->mmap_mutex);
 }
 
+void gt_fa_madvise(void *addr, GT_UNUSED GtFaAdvice advice)
+{
+#ifndef _WIN32
+  FAMapInfo *mapinfo;
+  int posixadvice;
+#endif
+  gt_assert(fa);
+  if (!addr) return;
+#ifndef _WIN32
+  switch (advice) {
+    case GT_FA_ADVICE_SEQUENTIAL:
+      posixadvice = POSIX_MADV_SEQUENTIAL;
+      break;
+    case GT_FA_ADVICE_RANDOM:
+      posixadvice = POSIX_MADV_RANDOM;
+      break;
+    case GT_FA_ADVICE_WILLNEED:
+      posixadvice = POSIX_MADV_WILLNEED;
+      break;
+    default:
+      posixadvice = POSIX_MADV_NORMAL;
+      break;
+  }
+  gt_mutex_lock(fa->mmap_mutex);
+  mapinfo = gt_hashmap_get(fa->memory_maps, addr);
+  gt_assert(mapinfo);
+  /* advice is only a hint, so errors are ignored */
+  (void) posix_madvise(addr, mapinfo->len, posixadvice);
+  gt_mutex_unlock(fa->mmap_mutex);
+#endif
+}
+
 void* gt_fa_mmap_read_with_suffix_func(const char *path, const char *suffix,
                                        size_t *len, const char *src_file,
                                        int src_line, GtError *err)
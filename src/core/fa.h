@@ -146,6 +146,22 @@ void*   gt_fa_xmmap_write_func_range(const char *path, size_t len,
 
 void    gt_fa_xmunmap(void *addr);
 
+/* The expected access pattern of a memory map, see <gt_fa_madvise()>. */
+typedef enum {
+  GT_FA_ADVICE_NORMAL,
+  GT_FA_ADVICE_SEQUENTIAL,
+  GT_FA_ADVICE_RANDOM,
+  GT_FA_ADVICE_WILLNEED
+} GtFaAdvice;
+
+/* Tell the operating system that the memory map beginning at <addr> (which
+   must have been returned by one of the mmap functions above) is accessed
+   according to <advice>. <GT_FA_ADVICE_WILLNEED> starts reading the mapped
+   file into the page cache in the background, which is shared by all
+   processes mapping the file. Does nothing if <addr> is NULL or the
+   operating system does not support such advice. */
+void    gt_fa_madvise(void *addr, GtFaAdvice advice);
+
 #define gt_fa_mmap_generic_fd(fd, filename_to_map, len, offset, mapwritable, \
                               hard_fail, err) \
         gt_fa_mmap_generic_fd_func(fd, filename_to_map, len, offset, \
@@ -16,14 +16,21 @@
 */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "core/cstr_api.h"
+#include "core/ensure.h"
 #include "core/fa.h"
+#include "core/file_readahead.h"
 #include "core/ma.h"
+#include "core/thread_api.h"
 #include "core/xansi_api.h"
 #include "core/xbzlib.h"
 #include "core/xzlib.h"
 
+/* initial size of the read buffer, it grows for lines which do not fit */
+#define GT_FILE_BUFFER_SIZE  (1 << 17)
+
 struct GtFile {
   GtFileMode mode;
   GtUword reference_count;
@@ -34,11 +41,25 @@ struct GtFile {
   } fileptr;
   char *orig_path,
        *orig_mode,
-       unget_char;
+       unget_char,
+       *buffer; /* read buffer, created on demand */
+  GtUword buffer_size,
+          buffer_pos, /* next unread byte in <buffer> */
+          buffer_end; /* end of the valid data in <buffer> */
+  GtFileReadAhead *readahead; /* decompresses in the background, only used
+                                 for buffered compressed files with
+                                 multiple jobs */
   bool is_stdin,
-       unget_used;
+       unget_used,
+       buffered; /* read ahead into <buffer>, only if we own the handle */
 };
 
+/* reading files opened for update must not read ahead */
+static bool file_mode_allows_buffering(const char *mode)
+{
+  return mode[0] == 'r' && !strchr(mode, '+');
+}
+
 GtFileMode gt_file_mode_determine(const char *path)
 {
   size_t path_length;
@@ -122,6 +143,7 @@ GtFile* gt_file_open(GtFileMode file_mode, const char *path, const char *mode,
           gt_file_delete_without_handle(file);
           return NULL;
         }
+        file->orig_path = gt_cstr_dup(path);
         break;
       case GT_FILE_MODE_BZIP2:
         file->fileptr.bzfile = gt_fa_bzopen(path, mode, err);
@@ -140,6 +162,7 @@ GtFile* gt_file_open(GtFileMode file_mode, const char *path, const char *mode,
     file->fileptr.file = stdin;
     file->is_stdin = true;
   }
+  file->buffered = file_mode_allows_buffering(mode);
   return file;
 }
 
@@ -158,6 +181,7 @@ GtFile* gt_file_xopen_file_mode(GtFileMode file_mode, const char *path,
         break;
       case GT_FILE_MODE_GZIP:
         file->fileptr.gzfile = gt_fa_xgzopen(path, mode);
+        file->orig_path = gt_cstr_dup(path);
         break;
       case GT_FILE_MODE_BZIP2:
         file->fileptr.bzfile = gt_fa_xbzopen(path, mode);
@@ -172,6 +196,7 @@ GtFile* gt_file_xopen_file_mode(GtFileMode file_mode, const char *path,
     file->fileptr.file = stdin;
     file->is_stdin = true;
   }
+  file->buffered = file_mode_allows_buffering(mode);
   return file;
 }
 
@@ -198,6 +223,145 @@ GtFileMode gt_file_mode(const GtFile *file)
   return file->mode;
 }
 
+#ifdef GT_THREADS_ENABLED
+static int file_gzread(void *handle, void *buf, unsigned nbytes, GtError *err)
+{
+  int errnum, rval;
+  gt_error_check(err);
+  if ((rval = gzread(handle, buf, nbytes)) == -1) {
+    gt_error_set(err, "cannot read from compressed file: %s",
+                 gzerror(handle, &errnum));
+  }
+  return rval;
+}
+
+static int file_bzread(void *handle, void *buf, unsigned nbytes, GtError *err)
+{
+  int rval;
+  gt_error_check(err);
+  if ((rval = BZ2_bzread(handle, buf, nbytes)) == -1)
+    gt_error_set(err, "cannot read from compressed file");
+  return rval;
+}
+
+/* Starts decompressing <file> in the background. BGZF files are inflated
+   with <gt_jobs> threads, other compressed files with one thread. If no
+   thread can be started, the read-ahead decompresses on demand. */
+static void file_start_readahead(GtFile *file)
+{
+  FILE *fp;
+  gt_assert(file && !file->readahead && file->orig_path);
+  if (file->mode == GT_FILE_MODE_GZIP) {
+    fp = gt_fa_xfopen(file->orig_path, "rb");
+    if (gt_file_readahead_is_bgzf(fp)) {
+      file->readahead = gt_file_readahead_new_bgzf(fp, file->orig_path,
+                                                   gt_jobs);
+    }
+    else {
+      gt_fa_xfclose(fp);
+      file->readahead = gt_file_readahead_new(file_gzread,
+                                              file->fileptr.gzfile);
+    }
+  }
+  else {
+    gt_assert(file->mode == GT_FILE_MODE_BZIP2);
+    file->readahead = gt_file_readahead_new(file_bzread,
+                                            file->fileptr.bzfile);
+  }
+}
+
+/* reads from the read-ahead of <file>, errors are fatal as for the
+   synchronous reads */
+static size_t file_xread_readahead(GtFile *file, void *buf, size_t nbytes)
+{
+  GtError *err;
+  GtWord rval;
+  if (!file->readahead)
+    file_start_readahead(file);
+  err = gt_error_new();
+  if ((rval = gt_file_readahead_read(file->readahead, buf, nbytes, err)) < 0) {
+    fprintf(stderr, "%s\n", gt_error_get(err));
+    exit(EXIT_FAILURE);
+  }
+  gt_error_delete(err);
+  return (size_t) rval;
+}
+#endif
+
+static size_t file_xread_unbuffered(GtFile *file, void *buf, size_t nbytes)
+{
+  size_t rval = 0;
+  gt_assert(file);
+#ifdef GT_THREADS_ENABLED
+  if (file->buffered && file->mode != GT_FILE_MODE_UNCOMPRESSED &&
+      gt_jobs > 1) {
+    return file_xread_readahead(file, buf, nbytes);
+  }
+#endif
+  switch (file->mode) {
+    case GT_FILE_MODE_UNCOMPRESSED:
+      rval = gt_xfread(buf, 1, nbytes, file->fileptr.file);
+      break;
+    case GT_FILE_MODE_GZIP:
+      rval = gt_xgzread(file->fileptr.gzfile, buf, nbytes);
+      break;
+    case GT_FILE_MODE_BZIP2:
+      rval = gt_xbzread(file->fileptr.bzfile, buf, nbytes);
+      break;
+    default: gt_assert(0);
+  }
+  return rval;
+}
+
+/* Moves the unread data to the start of the read buffer (growing it if it is
+   full) and appends at most <max_bytes> new bytes (as many as fit, if
+   <max_bytes> equals 0). Returns the number of bytes read. */
+static GtUword file_fill_buffer(GtFile *file, GtUword max_bytes)
+{
+  GtUword nof_bytes;
+  if (!file->buffer) {
+    file->buffer_size = GT_FILE_BUFFER_SIZE;
+    file->buffer = gt_malloc(file->buffer_size * sizeof (char));
+  }
+  if (file->buffer_pos > 0) {
+    memmove(file->buffer, file->buffer + file->buffer_pos,
+            file->buffer_end - file->buffer_pos);
+    file->buffer_end -= file->buffer_pos;
+    file->buffer_pos = 0;
+  }
+  if (file->buffer_end == file->buffer_size) {
+    file->buffer_size *= 2;
+    file->buffer = gt_realloc(file->buffer,
+                              file->buffer_size * sizeof (char));
+  }
+  nof_bytes = file->buffer_size - file->buffer_end;
+  if (max_bytes && max_bytes < nof_bytes)
+    nof_bytes = max_bytes;
+  nof_bytes = file_xread_unbuffered(file, file->buffer + file->buffer_end,
+                                    nof_bytes);
+  file->buffer_end += nof_bytes;
+  return nof_bytes;
+}
+
+/* puts an ungot character in front of the unread data of the read buffer */
+static void file_move_unget_char_to_buffer(GtFile *file)
+{
+  gt_assert(file->unget_used);
+  if (!file->buffer_pos) {
+    if (!file->buffer || file->buffer_end == file->buffer_size) {
+      file->buffer_size = file->buffer ? 2 * file->buffer_size
+                                       : GT_FILE_BUFFER_SIZE;
+      file->buffer = gt_realloc(file->buffer,
+                                file->buffer_size * sizeof (char));
+    }
+    memmove(file->buffer + 1, file->buffer, file->buffer_end);
+    file->buffer_end++;
+    file->buffer_pos++;
+  }
+  file->buffer[--file->buffer_pos] = file->unget_char;
+  file->unget_used = false;
+}
+
 int gt_file_xfgetc(GtFile *file)
 {
   int c = -1;
@@ -206,6 +370,15 @@ int gt_file_xfgetc(GtFile *file)
       c = file->unget_char;
       file->unget_used = false;
     }
+    else if (file->buffered) {
+      if (file->buffer_pos == file->buffer_end && !file_fill_buffer(file, 0))
+        return EOF;
+      c = (unsigned char) file->buffer[file->buffer_pos++];
+    }
+    else if (file->buffer_pos < file->buffer_end) {
+      /* data left over from a block or line read */
+      c = (unsigned char) file->buffer[file->buffer_pos++];
+    }
     else {
       switch (file->mode) {
         case GT_FILE_MODE_UNCOMPRESSED:
@@ -226,6 +399,50 @@ int gt_file_xfgetc(GtFile *file)
   return c;
 }
 
+GtUword gt_file_xread_block(GtFile *file, const char **block)
+{
+  GtUword length;
+  gt_assert(file && block);
+  if (file->unget_used)
+    file_move_unget_char_to_buffer(file);
+  if (file->buffer_pos == file->buffer_end && !file_fill_buffer(file, 0))
+    return 0;
+  *block = file->buffer + file->buffer_pos;
+  length = file->buffer_end - file->buffer_pos;
+  file->buffer_pos = file->buffer_end;
+  return length;
+}
+
+int gt_file_xread_line(GtFile *file, const char **line, GtUword *length)
+{
+  GtUword scanned = 0; /* number of unread bytes known to contain no '\n' */
+  char *newline;
+  gt_assert(file && line && length);
+  if (file->unget_used)
+    file_move_unget_char_to_buffer(file);
+  for (;;) {
+    if (file->buffer_pos + scanned < file->buffer_end &&
+        (newline = memchr(file->buffer + file->buffer_pos + scanned, '\n',
+                          file->buffer_end - file->buffer_pos - scanned))) {
+      *line = file->buffer + file->buffer_pos;
+      *length = newline - *line;
+      file->buffer_pos += *length + 1;
+      /* remove carriage return of Windows newline "\r\n" */
+      if (*length && (*line)[*length - 1] == '\r')
+        (*length)--;
+      return 0;
+    }
+    scanned = file->buffer_end - file->buffer_pos;
+    /* we must not read beyond the line if the handle is shared */
+    if (!file_fill_buffer(file, file->buffered ? 0 : 1)) {
+      *line = file->buffer + file->buffer_pos;
+      *length = file->buffer_end - file->buffer_pos;
+      file->buffer_pos = file->buffer_end;
+      return EOF;
+    }
+  }
+}
+
 void gt_file_unget_char(GtFile *file, char c)
 {
   if (file) {
@@ -365,18 +582,24 @@ int gt_file_xread(GtFile *file, void *buf, size_t nbytes)
 {
   int rval = -1;
   if (file) {
-    switch (file->mode) {
-      case GT_FILE_MODE_UNCOMPRESSED:
-        rval = gt_xfread(buf, 1, nbytes, file->fileptr.file);
-        break;
-      case GT_FILE_MODE_GZIP:
-        rval = gt_xgzread(file->fileptr.gzfile, buf, nbytes);
-        break;
-      case GT_FILE_MODE_BZIP2:
-        rval = gt_xbzread(file->fileptr.bzfile, buf, nbytes);
-        break;
-      default: gt_assert(0);
+    if (file->unget_used || file->buffer_pos < file->buffer_end) {
+      /* deliver buffered data first */
+      GtUword buffered;
+      if (file->unget_used)
+        file_move_unget_char_to_buffer(file);
+      buffered = file->buffer_end - file->buffer_pos;
+      if (buffered > nbytes)
+        buffered = nbytes;
+      memcpy(buf, file->buffer + file->buffer_pos, buffered);
+      file->buffer_pos += buffered;
+      rval = buffered;
+      if (buffered < nbytes) {
+        rval += file_xread_unbuffered(file, (char*) buf + buffered,
+                                      nbytes - buffered);
+      }
     }
+    else
+      rval = file_xread_unbuffered(file, buf, nbytes);
   }
   else
     rval = gt_xfread(buf, 1, nbytes, stdin);
@@ -406,6 +629,11 @@ void gt_file_xwrite(GtFile *file, void *buf, size_t nbytes)
 void gt_file_xrewind(GtFile *file)
 {
   gt_assert(file);
+  file->buffer_pos = file->buffer_end = 0;
+  file->unget_used = false;
+  /* the read-ahead uses the handle, restart it on the next read */
+  gt_file_readahead_delete(file->readahead);
+  file->readahead = NULL;
   switch (file->mode) {
     case GT_FILE_MODE_UNCOMPRESSED:
       rewind(file->fileptr.file);
@@ -423,8 +651,10 @@ void gt_file_xrewind(GtFile *file)
 void gt_file_delete_without_handle(GtFile *file)
 {
   if (!file) return;
+  gt_file_readahead_delete(file->readahead);
   gt_free(file->orig_path);
   gt_free(file->orig_mode);
+  gt_free(file->buffer);
   gt_free(file);
 }
 
@@ -435,6 +665,8 @@ void gt_file_delete(GtFile *file)
     file->reference_count--;
     return;
   }
+  gt_file_readahead_delete(file->readahead);
+  file->readahead = NULL;
   switch (file->mode) {
     case GT_FILE_MODE_UNCOMPRESSED:
         if (!file->is_stdin)
@@ -450,3 +682,120 @@ void gt_file_delete(GtFile *file)
   }
   gt_file_delete_without_handle(file);
 }
+
+static int file_check_reading(const char *path, const char *content,
+                              GtUword content_length, GtError *err)
+{
+  static const char *lines[] = { "a", "bb", "c\rd", NULL, "last" };
+  const char *line, *block;
+  GtUword i, length, nof_bytes;
+  GtFile *file;
+  char buf[3];
+  int had_err = 0, rval;
+  gt_error_check(err);
+
+  file = gt_file_xopen(path, "r");
+
+  /* line reading */
+  for (i = 0; !had_err && i < sizeof lines / sizeof lines[0]; i++) {
+    rval = gt_file_xread_line(file, &line, &length);
+    if (lines[i]) {
+      gt_ensure(length == strlen(lines[i]));
+      gt_ensure(!memcmp(line, lines[i], length));
+    }
+    else {
+      /* the long line */
+      gt_ensure(length == 3 * GT_FILE_BUFFER_SIZE);
+      gt_ensure(line[0] == 'x' && line[length - 1] == 'x');
+    }
+    gt_ensure(rval == (i + 1 < sizeof lines / sizeof lines[0] ? 0 : EOF));
+  }
+  if (!had_err) {
+    gt_ensure(gt_file_xread_line(file, &line, &length) == EOF);
+    gt_ensure(length == 0);
+  }
+
+  /* mixing character, line and copying reads */
+  if (!had_err) {
+    gt_file_xrewind(file);
+    gt_ensure(gt_file_xfgetc(file) == 'a');
+    gt_file_unget_char(file, 'a');
+    gt_ensure(gt_file_xread_line(file, &line, &length) == 0);
+    gt_ensure(length == 1 && line[0] == 'a');
+  }
+  if (!had_err) {
+    gt_ensure(gt_file_xread(file, buf, 3) == 3);
+    gt_ensure(!memcmp(buf, "bb\r", 3));
+    gt_ensure(gt_file_xfgetc(file) == '\n');
+    gt_ensure(gt_file_xfgetc(file) == 'c');
+  }
+
+  /* block reading */
+  if (!had_err) {
+    gt_file_xrewind(file);
+    nof_bytes = 0;
+    while (!had_err && (length = gt_file_xread_block(file, &block)) > 0) {
+      gt_ensure(nof_bytes + length <= content_length);
+      if (!had_err)
+        gt_ensure(!memcmp(block, content + nof_bytes, length));
+      nof_bytes += length;
+    }
+    gt_ensure(nof_bytes == content_length);
+  }
+
+  gt_file_delete(file);
+  return had_err;
+}
+
+int gt_file_unit_test(GtError *err)
+{
+  GtStr *path, *gzpath;
+  GtUword content_length;
+  GtFile *file;
+  char *content;
+  FILE *fp;
+  int had_err = 0;
+  gt_error_check(err);
+
+  /* test content: different line endings, a line which is longer than the
+     initial read buffer, and an unterminated last line */
+  content_length = strlen("a\nbb\r\nc\rd\n") + 3 * GT_FILE_BUFFER_SIZE
+                   + strlen("\nlast");
+  content = gt_malloc(content_length + 1);
+  strcpy(content, "a\nbb\r\nc\rd\n");
+  memset(content + strlen(content), 'x', 3 * GT_FILE_BUFFER_SIZE);
+  strcpy(content + content_length - strlen("\nlast"), "\nlast");
+
+  path = gt_str_new();
+  fp = gt_xtmpfp(path);
+  gt_xfwrite(content, sizeof (char), content_length, fp);
+  gt_fa_xfclose(fp);
+  gzpath = gt_str_clone(path);
+  gt_str_append_cstr(gzpath, ".gz");
+  file = gt_file_xopen(gt_str_get(gzpath), "w");
+  gt_file_xwrite(file, content, content_length);
+  gt_file_delete(file);
+
+  had_err = file_check_reading(gt_str_get(path), content, content_length, err);
+  if (!had_err) {
+    had_err = file_check_reading(gt_str_get(gzpath), content, content_length,
+                                 err);
+  }
+#ifdef GT_THREADS_ENABLED
+  /* with multiple jobs the compressed file is read ahead in the background */
+  if (!had_err) {
+    unsigned int jobs = gt_jobs;
+    gt_jobs = 4;
+    had_err = file_check_reading(gt_str_get(gzpath), content, content_length,
+                                 err);
+    gt_jobs = jobs;
+  }
+#endif
+
+  gt_xremove(gt_str_get(gzpath));
+  gt_xremove(gt_str_get(path));
+  gt_str_delete(gzpath);
+  gt_str_delete(path);
+  gt_free(content);
+  return had_err;
+}
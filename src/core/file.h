@@ -20,6 +20,7 @@
 
 #include <stdlib.h>
 #include "core/file_api.h"
+#include "core/types_api.h"
 
 typedef enum {
   GT_FILE_MODE_UNCOMPRESSED,
@@ -63,4 +64,21 @@ GtFileMode  gt_file_mode(const GtFile *file);
    Can only be used once at a time. */
 void        gt_file_unget_char(GtFile *file, char c);
 
+/* Store a pointer to the next block of unread bytes of <file> (which cannot
+   be <NULL>) in <block> and return its length, 0 at the end of the file. The
+   bytes count as read afterwards. The block is only valid until the next read
+   operation on <file>. */
+GtUword     gt_file_xread_block(GtFile *file, const char **block);
+
+/* Store a pointer to the next line of <file> (which cannot be <NULL>) in
+   <line> and its length (without the terminating "\n" or "\r\n") in <length>.
+   The line is not '\0'-terminated and only valid until the next read
+   operation on <file>. Returns 0 if a terminated line was read and EOF
+   otherwise, in which case <line> contains the unterminated rest of <file>
+   (<length> is 0 if there is none). */
+int         gt_file_xread_line(GtFile *file, const char **line,
+                               GtUword *length);
+
+int         gt_file_unit_test(GtError *err);
+
 #endif
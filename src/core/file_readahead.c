@@ -0,0 +1,538 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+#include "core/cstr_api.h"
+#include "core/ensure.h"
+#include "core/fa.h"
+#include "core/file_readahead.h"
+#include "core/ma.h"
+#include "core/ordered_ring.h"
+#include "core/str_api.h"
+#include "core/unused_api.h"
+#include "core/xansi_api.h"
+#include "core/xzlib.h"
+
+/* number of decompressed bytes requested per block in sequential mode */
+#define GT_FILE_READAHEAD_BLOCKSIZE  (1 << 20)
+/* number of compressed bytes collected per batch in BGZF mode */
+#define GT_FILE_READAHEAD_BATCHSIZE  (1 << 18)
+#define GT_FILE_READAHEAD_SLOTS_PER_THREAD 2
+
+/* length of a BGZF block header and trailer (CRC32 and ISIZE) */
+#define GT_BGZF_HEADER_LENGTH   18
+#define GT_BGZF_TRAILER_LENGTH  8
+#define GT_BGZF_MAX_BLOCK_SIZE  (1 << 16)
+
+typedef struct {
+  char *data;          /* decompressed data */
+  size_t length;
+  unsigned char *raw;  /* compressed BGZF blocks (BGZF mode only) */
+  size_t raw_length;
+  bool last;           /* the end of the file was reached with this block */
+} GtFileReadAheadBlock;
+
+struct GtFileReadAhead {
+  GtFileReadAheadFunc read_func;
+  void *handle;
+  FILE *fp;            /* BGZF mode only */
+  char *path;
+  GtOrderedRing *ring;
+  GtFileReadAheadBlock *current;
+  size_t current_pos;
+  char *error;         /* the message of the first error, if any */
+};
+
+static void file_readahead_block_delete(GtFileReadAheadBlock *block)
+{
+  if (!block) return;
+  gt_free(block->data);
+  gt_free(block->raw);
+  gt_free(block);
+}
+
+static GtUword bgzf_get_uint16(const unsigned char *ptr)
+{
+  return (GtUword) ptr[0] | ((GtUword) ptr[1] << 8);
+}
+
+static GtUword bgzf_get_uint32(const unsigned char *ptr)
+{
+  return bgzf_get_uint16(ptr) | (bgzf_get_uint16(ptr + 2) << 16);
+}
+
+/* Returns the total size of the BGZF block starting with <header>, or 0 if
+   <header> is not a BGZF block header. */
+static GtUword bgzf_block_size(const unsigned char *header)
+{
+  if (header[0] != 31 || header[1] != 139 || header[2] != 8 ||
+      !(header[3] & 4) || bgzf_get_uint16(header + 10) != 6 ||
+      header[12] != 'B' || header[13] != 'C' ||
+      bgzf_get_uint16(header + 14) != 2) {
+    return 0;
+  }
+  return bgzf_get_uint16(header + 16) + 1;
+}
+
+static int file_readahead_corrupt(const GtFileReadAhead *readahead,
+                                  GtError *err)
+{
+  if (ferror(readahead->fp)) {
+    gt_error_set(err, "cannot read file '%s': %s", readahead->path,
+                 strerror(errno));
+  }
+  else
+    gt_error_set(err, "corrupt BGZF block in file '%s'", readahead->path);
+  return -1;
+}
+
+/* Collects the next batch of compressed BGZF blocks, the decompressed length
+   is determined from their ISIZE fields. */
+static int file_readahead_read_bgzf(GtFileReadAhead *readahead,
+                                    GtFileReadAheadBlock *block, GtError *err)
+{
+  GtUword raw_size = 0, block_size;
+  unsigned char *header;
+  size_t nof_bytes;
+  gt_error_check(err);
+  while (block->raw_length < GT_FILE_READAHEAD_BATCHSIZE) {
+    /* make room for a BGZF block of maximal size (64KB) */
+    if (block->raw_length + GT_BGZF_MAX_BLOCK_SIZE > raw_size) {
+      raw_size = block->raw_length + GT_BGZF_MAX_BLOCK_SIZE;
+      block->raw = gt_realloc(block->raw, raw_size);
+    }
+    header = block->raw + block->raw_length;
+    nof_bytes = fread(header, 1, GT_BGZF_HEADER_LENGTH, readahead->fp);
+    if (nof_bytes == 0 && !ferror(readahead->fp)) {
+      block->last = true;
+      break;
+    }
+    if (nof_bytes < GT_BGZF_HEADER_LENGTH ||
+        (block_size = bgzf_block_size(header)) <
+        GT_BGZF_HEADER_LENGTH + GT_BGZF_TRAILER_LENGTH) {
+      return file_readahead_corrupt(readahead, err);
+    }
+    nof_bytes = block_size - GT_BGZF_HEADER_LENGTH;
+    if (fread(header + GT_BGZF_HEADER_LENGTH, 1, nof_bytes, readahead->fp)
+        != nof_bytes) {
+      return file_readahead_corrupt(readahead, err);
+    }
+    block->length += bgzf_get_uint32(header + block_size - 4);
+    block->raw_length += block_size;
+  }
+  return 0;
+}
+
+/* Inflates the compressed BGZF blocks of <block>, this is the part which runs
+   in parallel. */
+static int file_readahead_inflate(const GtFileReadAhead *readahead,
+                                  GtFileReadAheadBlock *block, GtError *err)
+{
+  GtUword pos = 0, block_size, out = 0, isize;
+  z_stream strm;
+  int had_err = 0;
+  gt_error_check(err);
+  memset(&strm, 0, sizeof strm);
+  /* 16 + MAX_WBITS: expect a gzip wrapper and check its CRC */
+  if (inflateInit2(&strm, 16 + MAX_WBITS) != Z_OK) {
+    gt_error_set(err, "cannot initialize decompression of file '%s'",
+                 readahead->path);
+    return -1;
+  }
+  block->data = gt_malloc(block->length ? block->length : 1);
+  while (!had_err && pos < block->raw_length) {
+    block_size = bgzf_block_size(block->raw + pos);
+    isize = bgzf_get_uint32(block->raw + pos + block_size - 4);
+    strm.next_in = block->raw + pos;
+    strm.avail_in = (uInt) block_size;
+    strm.next_out = (unsigned char*) block->data + out;
+    strm.avail_out = (uInt) isize;
+    if (inflate(&strm, Z_FINISH) != Z_STREAM_END ||
+        strm.avail_out != 0 || strm.avail_in != 0) {
+      gt_error_set(err, "corrupt BGZF block in file '%s'", readahead->path);
+      had_err = -1;
+    }
+    (void) inflateReset(&strm);
+    out += isize;
+    pos += block_size;
+  }
+  (void) inflateEnd(&strm);
+  if (!had_err) {
+    gt_assert(out == block->length);
+    gt_free(block->raw);
+    block->raw = NULL;
+  }
+  return had_err;
+}
+
+static void* file_readahead_read(void *data, bool *last, GtError *err)
+{
+  GtFileReadAhead *readahead = data;
+  GtFileReadAheadBlock *block = gt_calloc(1, sizeof *block);
+  int rval;
+  gt_error_check(err);
+  if (readahead->fp) {
+    if (file_readahead_read_bgzf(readahead, block, err)) {
+      file_readahead_block_delete(block);
+      return NULL;
+    }
+  }
+  else {
+    block->data = gt_malloc(GT_FILE_READAHEAD_BLOCKSIZE);
+    if ((rval = readahead->read_func(readahead->handle, block->data,
+                                     GT_FILE_READAHEAD_BLOCKSIZE, err)) < 0) {
+      file_readahead_block_delete(block);
+      return NULL;
+    }
+    block->length = (size_t) rval;
+    if (block->length == 0)
+      block->last = true;
+  }
+  *last = block->last;
+  return block;
+}
+
+static int file_readahead_process(void *item, void *data, GtError *err)
+{
+  GtFileReadAhead *readahead = data;
+  gt_error_check(err);
+  if (readahead->fp)
+    return file_readahead_inflate(readahead, item, err);
+  return 0;
+}
+
+static void file_readahead_free(void *item)
+{
+  file_readahead_block_delete(item);
+}
+
+static GtFileReadAhead* file_readahead_new(GtFileReadAheadFunc read_func,
+                                           void *handle, FILE *fp,
+                                           const char *path,
+                                           unsigned int nof_threads)
+{
+  GtFileReadAhead *readahead;
+  readahead = gt_calloc(1, sizeof *readahead);
+  readahead->read_func = read_func;
+  readahead->handle = handle;
+  readahead->fp = fp;
+  if (path)
+    readahead->path = gt_cstr_dup(path);
+#ifndef GT_THREADS_ENABLED
+  nof_threads = 0;
+#endif
+  readahead->ring = gt_ordered_ring_new(file_readahead_read,
+                                        file_readahead_process,
+                                        file_readahead_free, readahead,
+                                        nof_threads,
+                                        nof_threads *
+                                        GT_FILE_READAHEAD_SLOTS_PER_THREAD);
+  return readahead;
+}
+
+GtFileReadAhead* gt_file_readahead_new(GtFileReadAheadFunc read_func,
+                                       void *handle)
+{
+  gt_assert(read_func);
+  return file_readahead_new(read_func, handle, NULL, NULL, 1);
+}
+
+bool gt_file_readahead_is_bgzf(FILE *fp)
+{
+  unsigned char header[GT_BGZF_HEADER_LENGTH];
+  bool is_bgzf;
+  gt_assert(fp);
+  is_bgzf = fread(header, 1, GT_BGZF_HEADER_LENGTH, fp)
+            == GT_BGZF_HEADER_LENGTH && bgzf_block_size(header) > 0;
+  rewind(fp);
+  return is_bgzf;
+}
+
+GtFileReadAhead* gt_file_readahead_new_bgzf(FILE *fp, const char *path,
+                                            unsigned int nof_threads)
+{
+  gt_assert(fp && path);
+  return file_readahead_new(NULL, NULL, fp, path, nof_threads);
+}
+
+GtWord gt_file_readahead_read(GtFileReadAhead *readahead, void *buf,
+                              size_t nbytes, GtError *err)
+{
+  size_t copied = 0, nof_bytes;
+  gt_error_check(err);
+  gt_assert(readahead && buf);
+  while (copied < nbytes) {
+    if (!readahead->current ||
+        readahead->current_pos == readahead->current->length) {
+      void *block;
+      if (readahead->current && readahead->current->last)
+        break;
+      file_readahead_block_delete(readahead->current);
+      readahead->current = NULL;
+      if (!readahead->error &&
+          gt_ordered_ring_next(readahead->ring, &block, err)) {
+        readahead->error = gt_cstr_dup(gt_error_get(err));
+        gt_error_unset(err);
+      }
+      if (readahead->error) {
+        /* deliver the bytes before the error first */
+        if (copied)
+          break;
+        gt_error_set(err, "%s", readahead->error);
+        return -1;
+      }
+      gt_assert(block);
+      readahead->current = block;
+      readahead->current_pos = 0;
+      continue;
+    }
+    nof_bytes = readahead->current->length - readahead->current_pos;
+    if (nof_bytes > nbytes - copied)
+      nof_bytes = nbytes - copied;
+    memcpy((char*) buf + copied,
+           readahead->current->data + readahead->current_pos, nof_bytes);
+    readahead->current_pos += nof_bytes;
+    copied += nof_bytes;
+  }
+  return (GtWord) copied;
+}
+
+void gt_file_readahead_delete(GtFileReadAhead *readahead)
+{
+  if (!readahead) return;
+  gt_ordered_ring_delete(readahead->ring);
+  file_readahead_block_delete(readahead->current);
+  gt_fa_xfclose(readahead->fp);
+  gt_free(readahead->path);
+  gt_free(readahead->error);
+  gt_free(readahead);
+}
+
+static void bgzf_put_uint16(unsigned char *ptr, GtUword value)
+{
+  ptr[0] = value & 0xff;
+  ptr[1] = (value >> 8) & 0xff;
+}
+
+static void bgzf_put_uint32(unsigned char *ptr, GtUword value)
+{
+  bgzf_put_uint16(ptr, value & 0xffff);
+  bgzf_put_uint16(ptr + 2, (value >> 16) & 0xffff);
+}
+
+/* Writes <length> bytes of <data> as one BGZF block to <fp>. */
+static void bgzf_write_block(FILE *fp, const char *data, GtUword length)
+{
+  static const unsigned char header[] = { 31, 139, 8, 4, 0, 0, 0, 0, 0, 255,
+                                          6, 0, 'B', 'C', 2, 0 };
+  unsigned char buf[GT_BGZF_MAX_BLOCK_SIZE];
+  GtUword block_size;
+  z_stream strm;
+  GT_UNUSED int rval;
+  memset(&strm, 0, sizeof strm);
+  gt_assert(length < (1 << 15));
+  /* raw deflate, the gzip wrapper with the BGZF extra field is added below */
+  rval = deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8,
+                      Z_DEFAULT_STRATEGY);
+  gt_assert(rval == Z_OK);
+  strm.next_in = (unsigned char*) data;
+  strm.avail_in = (uInt) length;
+  strm.next_out = buf + GT_BGZF_HEADER_LENGTH;
+  strm.avail_out = (uInt) (sizeof buf - GT_BGZF_HEADER_LENGTH
+                           - GT_BGZF_TRAILER_LENGTH);
+  rval = deflate(&strm, Z_FINISH);
+  gt_assert(rval == Z_STREAM_END);
+  block_size = GT_BGZF_HEADER_LENGTH + strm.total_out + GT_BGZF_TRAILER_LENGTH;
+  (void) deflateEnd(&strm);
+  memcpy(buf, header, sizeof header);
+  bgzf_put_uint16(buf + 16, block_size - 1);
+  bgzf_put_uint32(buf + block_size - 8,
+                  crc32(crc32(0, NULL, 0), (const unsigned char*) data,
+                        (uInt) length));
+  bgzf_put_uint32(buf + block_size - 4, length);
+  gt_xfwrite(buf, 1, block_size, fp);
+}
+
+static int file_readahead_gzread(void *handle, void *buf, unsigned nbytes,
+                                 GT_UNUSED GtError *err)
+{
+  return gt_xgzread(handle, buf, nbytes);
+}
+
+/* a read function which fails after delivering <*handle> bytes */
+static int file_readahead_failing_read(void *handle, void *buf,
+                                       unsigned nbytes, GtError *err)
+{
+  GtUword *remaining = handle;
+  if (!*remaining) {
+    gt_error_set(err, "read failure");
+    return -1;
+  }
+  if (nbytes > *remaining)
+    nbytes = (unsigned) *remaining;
+  memset(buf, 'a', nbytes);
+  *remaining -= nbytes;
+  return (int) nbytes;
+}
+
+static int file_readahead_check(GtFileReadAhead *readahead,
+                                const char *content, GtUword content_length,
+                                GtUword piece, GtError *err)
+{
+  GtUword pos = 0;
+  GtWord nof_bytes = 0;
+  char *buf;
+  int had_err = 0;
+  gt_error_check(err);
+  buf = gt_malloc(piece);
+  while (!had_err &&
+         (nof_bytes = gt_file_readahead_read(readahead, buf, piece, err)) > 0) {
+    gt_ensure(pos + nof_bytes <= content_length);
+    if (!had_err)
+      gt_ensure(!memcmp(buf, content + pos, nof_bytes));
+    if (!had_err && nof_bytes < (GtWord) piece)
+      gt_ensure(pos + nof_bytes == content_length);
+    pos += nof_bytes;
+  }
+  if (!had_err)
+    gt_ensure(nof_bytes == 0 && pos == content_length);
+  gt_free(buf);
+  return had_err;
+}
+
+int gt_file_readahead_unit_test(GtError *err)
+{
+  GtUword content_length = 3 * GT_FILE_READAHEAD_BLOCKSIZE / 2, i, length;
+  GtFileReadAhead *readahead;
+  GtStr *path;
+  char *content, buf[7];
+  unsigned int seed = 1;
+  GtWord nof_bytes;
+  gzFile gzfile;
+  FILE *fp;
+  int had_err = 0;
+  gt_error_check(err);
+
+  /* poorly compressible content, to get several batches of BGZF blocks */
+  content = gt_malloc(content_length);
+  for (i = 0; i < content_length; i++) {
+    seed = seed * 1103515245 + 12345;
+    content[i] = "acgtn\n"[(seed >> 16) % 6];
+  }
+  path = gt_str_new();
+  fp = gt_xtmpfp(path);
+  for (i = 0; i < content_length; i += length) {
+    length = content_length - i < 20000 ? content_length - i : 20000;
+    bgzf_write_block(fp, content + i, length);
+  }
+  bgzf_write_block(fp, content, 0); /* the BGZF end-of-file marker */
+  gt_fa_xfclose(fp);
+
+  /* parallel inflation of the BGZF blocks */
+  fp = gt_fa_xfopen(gt_str_get(path), "rb");
+  gt_ensure(gt_file_readahead_is_bgzf(fp));
+  if (!had_err) {
+    readahead = gt_file_readahead_new_bgzf(fp, gt_str_get(path), 3);
+    had_err = file_readahead_check(readahead, content, content_length, 12345,
+                                   err);
+    gt_file_readahead_delete(readahead);
+  }
+  else
+    gt_fa_xfclose(fp);
+
+  /* a BGZF file is a valid gzip file, read it sequentially */
+  if (!had_err) {
+    gzfile = gt_xgzopen(gt_str_get(path), "rb");
+    readahead = gt_file_readahead_new(file_readahead_gzread, gzfile);
+    had_err = file_readahead_check(readahead, content, content_length,
+                                   GT_FILE_READAHEAD_BLOCKSIZE + 1, err);
+    gt_file_readahead_delete(readahead);
+    gt_xgzclose(gzfile);
+  }
+
+  /* stop reading early */
+  if (!had_err) {
+    fp = gt_fa_xfopen(gt_str_get(path), "rb");
+    readahead = gt_file_readahead_new_bgzf(fp, gt_str_get(path), 2);
+    gt_ensure(gt_file_readahead_read(readahead, buf, sizeof buf, err)
+              == sizeof buf);
+    gt_ensure(!memcmp(buf, content, sizeof buf));
+    gt_file_readahead_delete(readahead);
+  }
+
+  /* a corrupt BGZF block is reported after the data before it */
+  if (!had_err) {
+    /* beyond the first batch of blocks */
+    fp = gt_fa_xfopen(gt_str_get(path), "r+b");
+    gt_xfseek(fp, 0, SEEK_END);
+    gt_xfseek(fp, ftell(fp) / 4 * 3, SEEK_SET);
+    gt_xfputc('x', fp);
+    gt_fa_xfclose(fp);
+    fp = gt_fa_xfopen(gt_str_get(path), "rb");
+    readahead = gt_file_readahead_new_bgzf(fp, gt_str_get(path), 3);
+    i = 0;
+    while ((nof_bytes = gt_file_readahead_read(readahead, content, 1000,
+                                               err)) > 0) {
+      i += nof_bytes;
+    }
+    gt_ensure(nof_bytes == -1 && gt_error_is_set(err));
+    gt_ensure(i > 0 && i < content_length && i % 20000 == 0);
+    if (!had_err) {
+      gt_ensure(strstr(gt_error_get(err), "corrupt BGZF block") != NULL);
+      gt_error_unset(err);
+    }
+    /* the error persists */
+    gt_ensure(gt_file_readahead_read(readahead, content, 1000, err) == -1);
+    gt_error_unset(err);
+    gt_file_readahead_delete(readahead);
+  }
+
+  /* a failing read function */
+  if (!had_err) {
+    length = GT_FILE_READAHEAD_BLOCKSIZE + 10;
+    readahead = gt_file_readahead_new(file_readahead_failing_read, &length);
+    i = 0;
+    while ((nof_bytes = gt_file_readahead_read(readahead, content, 12345,
+                                               err)) > 0) {
+      i += nof_bytes;
+    }
+    gt_ensure(nof_bytes == -1);
+    gt_ensure(i == GT_FILE_READAHEAD_BLOCKSIZE + 10);
+    if (!had_err) {
+      gt_ensure(!strcmp(gt_error_get(err), "read failure"));
+      gt_error_unset(err);
+    }
+    gt_file_readahead_delete(readahead);
+  }
+
+  /* an ordinary gzip file is not a BGZF file */
+  if (!had_err) {
+    gzfile = gt_xgzopen(gt_str_get(path), "wb");
+    gt_xgzwrite(gzfile, content, 1000);
+    gt_xgzclose(gzfile);
+    fp = gt_fa_xfopen(gt_str_get(path), "rb");
+    gt_ensure(!gt_file_readahead_is_bgzf(fp));
+    gt_fa_xfclose(fp);
+  }
+
+  gt_xremove(gt_str_get(path));
+  gt_str_delete(path);
+  gt_free(content);
+  return had_err;
+}
@@ -0,0 +1,63 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef FILE_READAHEAD_H
+#define FILE_READAHEAD_H
+
+#include <stdio.h>
+#include "core/error_api.h"
+#include "core/types_api.h"
+
+/* A <GtFileReadAhead> decompresses a file ahead of its consumer. In a threaded
+   build the decompression runs on background threads into a small ring of
+   blocks, so that parsing and inflating overlap. Otherwise the blocks are
+   produced on demand by the consumer itself. */
+typedef struct GtFileReadAhead GtFileReadAhead;
+
+/* Reads at most <nbytes> decompressed bytes from <handle> into <buf> and
+   returns the number of bytes read (0 at the end of the file). Returns -1 and
+   sets <err> on error. */
+typedef int (*GtFileReadAheadFunc)(void *handle, void *buf, unsigned nbytes,
+                                   GtError *err);
+
+/* Return a new <GtFileReadAhead> which reads <handle> sequentially with
+   <read_func> on one background thread (double buffering). If the thread
+   cannot be started, <handle> is read on demand by the consumer. <handle> is
+   not owned by the read-ahead and must not be used until it has been
+   deleted. */
+GtFileReadAhead* gt_file_readahead_new(GtFileReadAheadFunc read_func,
+                                       void *handle);
+/* Return true if <fp> (positioned at the file start) begins with a BGZF
+   block, i.e., a gzip member carrying its compressed size in a 'BC' extra
+   subfield. <fp> is rewound afterwards. */
+bool             gt_file_readahead_is_bgzf(FILE *fp);
+/* Return a new <GtFileReadAhead> which inflates the BGZF file <fp> (which was
+   opened from <path>) with <nof_threads> threads in parallel batches of
+   blocks. Takes ownership of <fp>. */
+GtFileReadAhead* gt_file_readahead_new_bgzf(FILE *fp, const char *path,
+                                            unsigned int nof_threads);
+/* Copy the next at most <nbytes> decompressed bytes to <buf>. Returns the
+   number of copied bytes, which is less than <nbytes> only at the end of the
+   file. If the file could not be read or is corrupt, -1 is returned and <err>
+   is set (after the bytes before the error have been delivered). All later
+   calls fail with the same error. */
+GtWord           gt_file_readahead_read(GtFileReadAhead *readahead, void *buf,
+                                        size_t nbytes, GtError *err);
+void             gt_file_readahead_delete(GtFileReadAhead *readahead);
+
+int              gt_file_readahead_unit_test(GtError *err);
+
+#endif
@@ -36,6 +36,7 @@
 #include "core/spacepeak.h"
 #include "core/splitter.h"
 #include "core/symbol.h"
+#include "core/thread_pool.h"
 #include "core/versionfunc.h"
 #include "core/warning_api.h"
 #include "core/xansi_api.h"
@@ -114,6 +115,7 @@ void gt_lib_init(void)
   gt_log_init();
   if (showtime) gt_showtime_enable();
   gt_symbol_init();
+  gt_thread_pool_init();
   gt_class_alloc_lock_init();
   gt_ya_rand_init(0);
 #ifdef HAVE_MYSQL
@@ -143,6 +145,7 @@ int gt_lib_clean(void)
   }
   fa_fptr_rval = gt_fa_check_fptr_leak();
   fa_mmap_rval = gt_fa_check_mmap_leak();
+  gt_thread_pool_clean();
   gt_fa_clean();
   gt_symbol_clean();
   gt_class_alloc_clean();
@@ -0,0 +1,614 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/ensure.h"
+#include "core/interval_index.h"
+#include "core/ma.h"
+#include "core/mathsupport.h"
+#include "core/minmax.h"
+#include "core/range.h"
+#include "core/unused_api.h"
+
+/* subtrees with at most this level are scanned linearly */
+#define GT_INTERVAL_INDEX_SMALLTREE 3UL
+
+struct GtIntervalIndex {
+  GtUword *starts,
+          *ends,
+          *maxends,
+          size,
+          allocated,
+          max_level,
+          nof_removed;
+  void **elems;
+  bool sorted,
+       augmented;
+  GtFree free_func;
+};
+
+typedef struct {
+  GtUword start,
+          end,
+          order;
+  void *elem;
+} GtIntervalIndexEntry;
+
+typedef struct {
+  GtUword node,
+          level;
+  bool left_done;
+} GtIntervalIndexStackElem;
+
+/* removed intervals keep their slot with this element pointer until the next
+   build, so that removing many intervals does not move the arrays each time */
+static char interval_index_removed;
+#define GT_INTERVAL_INDEX_REMOVED ((void*) &interval_index_removed)
+
+GtIntervalIndex* gt_interval_index_new(GtFree free_func)
+{
+  GtIntervalIndex *ii = gt_calloc(1, sizeof (GtIntervalIndex));
+  ii->sorted = ii->augmented = true;
+  ii->free_func = free_func;
+  return ii;
+}
+
+void gt_interval_index_add(GtIntervalIndex *ii, void *elem, GtUword start,
+                           GtUword end)
+{
+  gt_assert(ii && start <= end);
+  if (ii->size == ii->allocated) {
+    ii->allocated = ii->allocated ? 2 * ii->allocated : 16UL;
+    ii->starts = gt_realloc(ii->starts, ii->allocated * sizeof (GtUword));
+    ii->ends = gt_realloc(ii->ends, ii->allocated * sizeof (GtUword));
+    ii->elems = gt_realloc(ii->elems, ii->allocated * sizeof (void*));
+  }
+  if (ii->size > 0 && start < ii->starts[ii->size - 1])
+    ii->sorted = false;
+  ii->starts[ii->size] = start;
+  ii->ends[ii->size] = end;
+  ii->elems[ii->size++] = elem;
+  ii->augmented = false;
+}
+
+static int interval_index_entry_cmp(const void *a, const void *b)
+{
+  const GtIntervalIndexEntry *ea = a, *eb = b;
+  if (ea->start != eb->start)
+    return ea->start < eb->start ? -1 : 1;
+  if (ea->order != eb->order)
+    return ea->order < eb->order ? -1 : 1;
+  return 0;
+}
+
+GtUword gt_interval_index_augment(const GtUword *ends, GtUword *maxends,
+                                  GtUword n)
+{
+  GtUword i, k, last_i = 0, last = 0;
+
+  if (n == 0)
+    return 0;
+  for (i = 0; i < n; i += 2) {
+    last_i = i;
+    last = maxends[i] = ends[i];
+  }
+  for (k = 1UL; (1UL << k) <= n; k++) {
+    const GtUword x = 1UL << (k - 1), step = x << 2;
+
+    for (i = (x << 1) - 1; i < n; i += step) {
+      GtUword maxend = MAX(ends[i], maxends[i - x]);
+      maxend = MAX(maxend, i + x < n ? maxends[i + x] : last);
+      maxends[i] = maxend;
+    }
+    /* move to the parent of the rightmost node of the previous level */
+    last_i = ((last_i >> k) & 1) ? last_i - x : last_i + x;
+    if (last_i < n && maxends[last_i] > last)
+      last = maxends[last_i];
+  }
+  return k - 1;
+}
+
+static void interval_index_compact(GtIntervalIndex *ii)
+{
+  GtUword i, j;
+  for (i = j = 0; i < ii->size; i++) {
+    if (ii->elems[i] != GT_INTERVAL_INDEX_REMOVED) {
+      ii->starts[j] = ii->starts[i];
+      ii->ends[j] = ii->ends[i];
+      ii->elems[j++] = ii->elems[i];
+    }
+  }
+  gt_assert(ii->size - j == ii->nof_removed);
+  ii->size = j;
+  ii->nof_removed = 0;
+}
+
+static void interval_index_sort(GtIntervalIndex *ii)
+{
+  GtIntervalIndexEntry *entries;
+  GtUword i;
+
+  if (ii->nof_removed > 0)
+    interval_index_compact(ii);
+  entries = gt_malloc(ii->size * sizeof (GtIntervalIndexEntry));
+  for (i = 0; i < ii->size; i++) {
+    entries[i].start = ii->starts[i];
+    entries[i].end = ii->ends[i];
+    entries[i].order = i;
+    entries[i].elem = ii->elems[i];
+  }
+  qsort(entries, (size_t) ii->size, sizeof (GtIntervalIndexEntry),
+        interval_index_entry_cmp);
+  for (i = 0; i < ii->size; i++) {
+    ii->starts[i] = entries[i].start;
+    ii->ends[i] = entries[i].end;
+    ii->elems[i] = entries[i].elem;
+  }
+  gt_free(entries);
+  ii->sorted = true;
+}
+
+bool gt_interval_index_remove(GtIntervalIndex *ii, void *elem, GtUword start,
+                              GtUword end)
+{
+  GtUword i = 0, right;
+  gt_assert(ii);
+
+  /* sorting once makes each removal a binary search */
+  if (!ii->sorted)
+    interval_index_sort(ii);
+  /* binary search for the first interval with the given start position */
+  right = ii->size;
+  while (i < right) {
+    GtUword mid = i + (right - i) / 2;
+    if (ii->starts[mid] < start)
+      i = mid + 1;
+    else
+      right = mid;
+  }
+  for (; i < ii->size && ii->starts[i] == start; i++) {
+    if (ii->elems[i] == elem && ii->ends[i] == end) {
+      ii->elems[i] = GT_INTERVAL_INDEX_REMOVED;
+      ii->nof_removed++;
+      ii->augmented = false;
+      if (ii->free_func)
+        ii->free_func(elem);
+      return true;
+    }
+  }
+  return false;
+}
+
+void gt_interval_index_build(GtIntervalIndex *ii)
+{
+  gt_assert(ii);
+  if (!ii->sorted)
+    interval_index_sort(ii);
+  else if (ii->nof_removed > 0)
+    interval_index_compact(ii);
+  if (!ii->augmented) {
+    ii->maxends = gt_realloc(ii->maxends, ii->allocated * sizeof (GtUword));
+    ii->max_level = gt_interval_index_augment(ii->ends, ii->maxends, ii->size);
+    ii->augmented = true;
+  }
+}
+
+bool gt_interval_index_is_built(const GtIntervalIndex *ii)
+{
+  gt_assert(ii);
+  return ii->sorted && ii->augmented;
+}
+
+GtUword gt_interval_index_size(const GtIntervalIndex *ii)
+{
+  gt_assert(ii);
+  return ii->size - ii->nof_removed;
+}
+
+int gt_interval_index_overlap(const GtUword *starts, const GtUword *ends,
+                              const GtUword *maxends, GtUword n,
+                              GtUword max_level, GtUword start, GtUword end,
+                              GtIntervalIndexOverlapFunc func, void *data,
+                              GtError *err)
+{
+  GtIntervalIndexStackElem stack[2 * sizeof (GtUword) * CHAR_BIT];
+  GtUword top = 0;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(func);
+
+  if (n == 0)
+    return 0;
+
+#define GT_INTERVAL_INDEX_PUSH(NODE, LEVEL, LEFT_DONE)\
+        stack[top].node = NODE;\
+        stack[top].level = LEVEL;\
+        stack[top++].left_done = LEFT_DONE
+
+  GT_INTERVAL_INDEX_PUSH((1UL << max_level) - 1, max_level, false);
+  while (!had_err && top > 0) {
+    const GtIntervalIndexStackElem elem = stack[--top];
+
+    if (elem.level <= GT_INTERVAL_INDEX_SMALLTREE) {
+      /* scan the small subtree linearly */
+      const GtUword first = (elem.node >> elem.level) << elem.level,
+                    last = MIN(first + (1UL << (elem.level + 1)) - 1, n);
+      GtUword i;
+
+      for (i = first; !had_err && i < last && starts[i] <= end; i++) {
+        if (start <= ends[i])
+          had_err = func(i, data, err);
+      }
+    } else if (!elem.left_done) {
+      const GtUword left = elem.node - (1UL << (elem.level - 1));
+
+      GT_INTERVAL_INDEX_PUSH(elem.node, elem.level, true);
+      /* the left subtree can only contain overlaps if it reaches the query */
+      if (left >= n || maxends[left] >= start) {
+        GT_INTERVAL_INDEX_PUSH(left, elem.level - 1, false);
+      }
+    } else if (elem.node < n && starts[elem.node] <= end) {
+      if (start <= ends[elem.node])
+        had_err = func(elem.node, data, err);
+      GT_INTERVAL_INDEX_PUSH(elem.node + (1UL << (elem.level - 1)),
+                             elem.level - 1, false);
+    }
+  }
+#undef GT_INTERVAL_INDEX_PUSH
+  return had_err;
+}
+
+typedef struct {
+  const GtIntervalIndex *ii;
+  GtIntervalIndexIteratorFunc func;
+  GtIntervalIndexBatchFunc batch_func;
+  GtUword query;
+  void *data;
+  GtArray *results;
+} GtIntervalIndexOverlapInfo;
+
+static int interval_index_collect(GtUword idx, void *data,
+                                  GT_UNUSED GtError *err)
+{
+  GtIntervalIndexOverlapInfo *info = data;
+  gt_array_add(info->results, info->ii->elems[idx]);
+  return 0;
+}
+
+static int interval_index_iterate(GtUword idx, void *data,
+                                  GT_UNUSED GtError *err)
+{
+  GtIntervalIndexOverlapInfo *info = data;
+  return info->func(info->ii->elems[idx], info->ii->starts[idx],
+                    info->ii->ends[idx], info->data);
+}
+
+static int interval_index_iterate_batch(GtUword idx, void *data,
+                                        GT_UNUSED GtError *err)
+{
+  GtIntervalIndexOverlapInfo *info = data;
+  return info->batch_func(info->query, info->ii->elems[idx], info->data);
+}
+
+void gt_interval_index_find_all_overlapping(const GtIntervalIndex *ii,
+                                            GtUword start, GtUword end,
+                                            GtArray *results)
+{
+  GtIntervalIndexOverlapInfo info;
+  GT_UNUSED int rval;
+  gt_assert(ii && gt_interval_index_is_built(ii) && results);
+  info.ii = ii;
+  info.results = results;
+  rval = gt_interval_index_overlap(ii->starts, ii->ends, ii->maxends, ii->size,
+                                   ii->max_level, start, end,
+                                   interval_index_collect, &info, NULL);
+  gt_assert(!rval); /* interval_index_collect() is sane */
+}
+
+int gt_interval_index_iterate_overlapping(const GtIntervalIndex *ii,
+                                          GtUword start, GtUword end,
+                                          GtIntervalIndexIteratorFunc func,
+                                          void *data)
+{
+  GtIntervalIndexOverlapInfo info;
+  gt_assert(ii && gt_interval_index_is_built(ii) && func);
+  info.ii = ii;
+  info.func = func;
+  info.data = data;
+  return gt_interval_index_overlap(ii->starts, ii->ends, ii->maxends, ii->size,
+                                   ii->max_level, start, end,
+                                   interval_index_iterate, &info, NULL);
+}
+
+int gt_interval_index_iterate_overlapping_batch(const GtIntervalIndex *ii,
+                                                const GtRange *queries,
+                                                GtUword nof_queries,
+                                                GtIntervalIndexBatchFunc func,
+                                                void *data)
+{
+  GtUword q, next = 0, nof_active = 0, allocated_active = 0, *active = NULL;
+  int had_err = 0;
+  gt_assert(ii && gt_interval_index_is_built(ii) && func);
+  gt_assert(nof_queries == 0 || queries);
+
+  if (nof_queries * (ii->max_level + 1) < ii->size) {
+    /* few queries, search the tree for each of them */
+    GtIntervalIndexOverlapInfo info;
+    info.ii = ii;
+    info.batch_func = func;
+    info.data = data;
+    for (q = 0; !had_err && q < nof_queries; q++) {
+      gt_assert(q == 0 || queries[q - 1].start <= queries[q].start);
+      info.query = q;
+      had_err = gt_interval_index_overlap(ii->starts, ii->ends, ii->maxends,
+                                          ii->size, ii->max_level,
+                                          queries[q].start, queries[q].end,
+                                          interval_index_iterate_batch, &info,
+                                          NULL);
+    }
+    return had_err;
+  }
+
+  /* sweep over the intervals once, keeping those which may still overlap a
+     query in an active list sorted by start position */
+  for (q = 0; !had_err && q < nof_queries; q++) {
+    const GtRange *query = queries + q;
+    GtUword i, j;
+
+    gt_assert(q == 0 || queries[q - 1].start <= query->start);
+    /* the following queries do not start before this one, so intervals
+       ending before it will never overlap again */
+    for (i = j = 0; i < nof_active; i++) {
+      if (ii->ends[active[i]] >= query->start)
+        active[j++] = active[i];
+    }
+    nof_active = j;
+    for (; next < ii->size && ii->starts[next] <= query->end; next++) {
+      if (ii->ends[next] >= query->start) {
+        if (nof_active == allocated_active) {
+          allocated_active = allocated_active ? 2 * allocated_active : 16UL;
+          active = gt_realloc(active, allocated_active * sizeof (GtUword));
+        }
+        active[nof_active++] = next;
+      }
+    }
+    /* a previous query may have activated intervals beyond this query */
+    for (i = 0; !had_err && i < nof_active; i++) {
+      if (ii->starts[active[i]] <= query->end)
+        had_err = func(q, ii->elems[active[i]], data);
+    }
+  }
+  gt_free(active);
+  return had_err;
+}
+
+int gt_interval_index_traverse(const GtIntervalIndex *ii,
+                               GtIntervalIndexIteratorFunc func, void *data)
+{
+  GtUword i;
+  int had_err = 0;
+  gt_assert(ii && gt_interval_index_is_built(ii) && func);
+  for (i = 0; !had_err && i < ii->size; i++)
+    had_err = func(ii->elems[i], ii->starts[i], ii->ends[i], data);
+  return had_err;
+}
+
+void gt_interval_index_delete(GtIntervalIndex *ii)
+{
+  if (!ii) return;
+  if (ii->free_func) {
+    GtUword i;
+    for (i = 0; i < ii->size; i++) {
+      if (ii->elems[i] != GT_INTERVAL_INDEX_REMOVED)
+        ii->free_func(ii->elems[i]);
+    }
+  }
+  gt_free(ii->starts);
+  gt_free(ii->ends);
+  gt_free(ii->maxends);
+  gt_free(ii->elems);
+  gt_free(ii);
+}
+
+static int interval_index_test_collect(void *elem, GT_UNUSED GtUword start,
+                                       GT_UNUSED GtUword end, void *data)
+{
+  gt_array_add((GtArray*) data, elem);
+  return 0;
+}
+
+static int interval_index_test_batch(GtUword query, void *elem, void *data)
+{
+  GtArray **results = data;
+  gt_array_add(results[query], elem);
+  return 0;
+}
+
+static int interval_index_test_range_cmp(const void *a, const void *b)
+{
+  return gt_range_compare((const GtRange*) a, (const GtRange*) b);
+}
+
+/* compares the results of all query methods with a linear scan */
+static int interval_index_test_queries(GtIntervalIndex *ii, GtArray *sorted,
+                                       GtUword maxpos, GtUword query_width,
+                                       GtUword nof_queries, GtError *err)
+{
+  GtRange *queries;
+  GtArray *expected, *res, **batch_res;
+  GtUword i, j;
+  int had_err = 0;
+
+  queries = gt_malloc(nof_queries * sizeof (GtRange));
+  batch_res = gt_malloc(nof_queries * sizeof (GtArray*));
+  for (i = 0; i < nof_queries; i++) {
+    queries[i].start = gt_rand_max(maxpos);
+    queries[i].end = queries[i].start + gt_rand_max(query_width);
+    batch_res[i] = gt_array_new(sizeof (GtRange*));
+  }
+  qsort(queries, (size_t) nof_queries, sizeof (GtRange),
+        interval_index_test_range_cmp);
+  gt_ensure(!gt_interval_index_iterate_overlapping_batch(ii, queries,
+                                                         nof_queries,
+                                                      interval_index_test_batch,
+                                                         batch_res));
+  expected = gt_array_new(sizeof (GtRange*));
+  res = gt_array_new(sizeof (GtRange*));
+  for (i = 0; !had_err && i < nof_queries; i++) {
+    gt_array_reset(expected);
+    for (j = 0; j < gt_array_size(sorted); j++) {
+      GtRange *rng = *(GtRange**) gt_array_get(sorted, j);
+      if (gt_range_overlap(rng, queries + i))
+        gt_array_add(expected, rng);
+    }
+    gt_array_reset(res);
+    gt_interval_index_find_all_overlapping(ii, queries[i].start,
+                                           queries[i].end, res);
+    gt_ensure(gt_array_size(res) == gt_array_size(expected)
+              && !gt_array_cmp(res, expected));
+    gt_array_reset(res);
+    gt_ensure(!gt_interval_index_iterate_overlapping(ii, queries[i].start,
+                                                     queries[i].end,
+                                                    interval_index_test_collect,
+                                                     res));
+    gt_ensure(gt_array_size(res) == gt_array_size(expected)
+              && !gt_array_cmp(res, expected));
+    gt_ensure(gt_array_size(batch_res[i]) == gt_array_size(expected)
+              && !gt_array_cmp(batch_res[i], expected));
+  }
+  for (i = 0; i < nof_queries; i++)
+    gt_array_delete(batch_res[i]);
+  gt_array_delete(res);
+  gt_array_delete(expected);
+  gt_free(batch_res);
+  gt_free(queries);
+  return had_err;
+}
+
+int gt_interval_index_unit_test(GtError *err)
+{
+  GtIntervalIndex *ii;
+  GtArray *sorted, *res;
+  GtUword i, nof_ranges = 3000, maxpos = 90000, width = 700,
+          query_width = 5000;
+  GtRange *rng;
+  int had_err = 0;
+  gt_error_check(err);
+
+  /* empty index */
+  ii = gt_interval_index_new(gt_free_func);
+  gt_interval_index_build(ii);
+  gt_ensure(gt_interval_index_size(ii) == 0);
+  res = gt_array_new(sizeof (GtRange*));
+  gt_interval_index_find_all_overlapping(ii, 0, maxpos, res);
+  gt_ensure(gt_array_size(res) == 0);
+
+  /* equal start positions keep their insertion order */
+  for (i = 0; i < 3UL; i++) {
+    rng = gt_malloc(sizeof (GtRange));
+    rng->start = maxpos / 2;
+    rng->end = rng->start + 2 - i;
+    gt_interval_index_add(ii, rng, rng->start, rng->end);
+  }
+  gt_interval_index_build(ii);
+  gt_interval_index_find_all_overlapping(ii, maxpos / 2, maxpos / 2, res);
+  gt_ensure(gt_array_size(res) == 3UL);
+  for (i = 0; !had_err && i < 3UL; i++) {
+    gt_ensure((*(GtRange**) gt_array_get(res, i))->end == maxpos / 2 + 2 - i);
+  }
+  gt_interval_index_delete(ii);
+
+  /* intervals can be removed before the index is built */
+  ii = gt_interval_index_new(gt_free_func);
+  gt_array_reset(res);
+  for (i = 0; i < 10UL; i++) {
+    rng = gt_malloc(sizeof (GtRange));
+    rng->start = rng->end = 10UL - i;
+    gt_interval_index_add(ii, rng, rng->start, rng->end);
+    gt_array_add(res, rng);
+  }
+  for (i = 0; !had_err && i < 10UL; i += 2) {
+    rng = *(GtRange**) gt_array_get(res, i);
+    gt_ensure(gt_interval_index_remove(ii, rng, 10UL - i, 10UL - i));
+    gt_ensure(!gt_interval_index_remove(ii, rng, 10UL - i, 10UL - i));
+  }
+  gt_ensure(gt_interval_index_size(ii) == 5UL);
+  gt_array_reset(res);
+  gt_interval_index_build(ii);
+  gt_ensure(!gt_interval_index_traverse(ii, interval_index_test_collect, res));
+  gt_ensure(gt_array_size(res) == 5UL);
+  for (i = 0; !had_err && i < gt_array_size(res); i++) {
+    gt_ensure((*(GtRange**) gt_array_get(res, i))->start == 2 * i + 1);
+  }
+  gt_array_reset(res);
+  gt_interval_index_delete(ii);
+
+  /* random intervals */
+  ii = gt_interval_index_new(gt_free_func);
+  sorted = gt_array_new(sizeof (GtRange*));
+  for (i = 0; i < nof_ranges; i++) {
+    rng = gt_malloc(sizeof (GtRange));
+    rng->start = gt_rand_max(maxpos);
+    rng->end = rng->start + gt_rand_max(width);
+    gt_interval_index_add(ii, rng, rng->start, rng->end);
+  }
+  gt_ensure(!gt_interval_index_is_built(ii));
+  gt_interval_index_build(ii);
+  gt_ensure(gt_interval_index_is_built(ii));
+  gt_ensure(gt_interval_index_size(ii) == nof_ranges);
+  gt_ensure(!gt_interval_index_traverse(ii, interval_index_test_collect,
+                                        sorted));
+  for (i = 1; !had_err && i < gt_array_size(sorted); i++) {
+    gt_ensure((*(GtRange**) gt_array_get(sorted, i - 1))->start
+                <= (*(GtRange**) gt_array_get(sorted, i))->start);
+  }
+
+  /* few and many queries take different paths in the batch query */
+  if (!had_err)
+    had_err = interval_index_test_queries(ii, sorted, maxpos, query_width, 10,
+                                          err);
+  if (!had_err)
+    had_err = interval_index_test_queries(ii, sorted, maxpos, query_width,
+                                          5000, err);
+
+  /* remove every third interval */
+  if (!had_err) {
+    GtArray *remaining = gt_array_new(sizeof (GtRange*));
+    for (i = 0; !had_err && i < gt_array_size(sorted); i++) {
+      rng = *(GtRange**) gt_array_get(sorted, i);
+      if (i % 3 == 0) {
+        gt_ensure(gt_interval_index_remove(ii, rng, rng->start, rng->end));
+      }
+      else
+        gt_array_add(remaining, rng);
+    }
+    gt_array_delete(sorted);
+    sorted = remaining;
+    gt_ensure(!gt_interval_index_is_built(ii));
+    gt_interval_index_build(ii);
+    gt_ensure(gt_interval_index_size(ii) == gt_array_size(sorted));
+    if (!had_err)
+      had_err = interval_index_test_queries(ii, sorted, maxpos, query_width,
+                                            1000, err);
+  }
+  gt_array_delete(sorted);
+  gt_array_delete(res);
+  gt_interval_index_delete(ii);
+  return had_err;
+}
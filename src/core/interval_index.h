@@ -0,0 +1,49 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef INTERVAL_INDEX_H
+#define INTERVAL_INDEX_H
+
+#include "core/error_api.h"
+#include "core/interval_index_api.h"
+
+/* Function called by <gt_interval_index_overlap()> for the interval with
+   index <idx>. A return value != 0 stops the search. */
+typedef int (*GtIntervalIndexOverlapFunc)(GtUword idx, void *data,
+                                          GtError *err);
+
+/* Computes in <maxends> the maximal end position in the subtree of each node
+   of the implicit interval tree over the <n> intervals sorted by start
+   position with end positions <ends>, in which the nodes of level k are the
+   indices with k trailing one bits. Returns the level of the root. */
+GtUword gt_interval_index_augment(const GtUword *ends, GtUword *maxends,
+                                  GtUword n);
+
+/* Calls <func> for the index of each interval overlapping the query range from
+   <start> to <end> in ascending order, given the sorted <starts> and the
+   <ends> of <n> intervals and the <maxends> computed by
+   <gt_interval_index_augment()>, which returned <max_level>. Returns the first
+   return value != 0 of <func>, 0 otherwise. */
+int     gt_interval_index_overlap(const GtUword *starts, const GtUword *ends,
+                                  const GtUword *maxends, GtUword n,
+                                  GtUword max_level, GtUword start, GtUword end,
+                                  GtIntervalIndexOverlapFunc func, void *data,
+                                  GtError *err);
+
+int     gt_interval_index_unit_test(GtError *err);
+
+#endif
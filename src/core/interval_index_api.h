@@ -0,0 +1,125 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef INTERVAL_INDEX_API_H
+#define INTERVAL_INDEX_API_H
+
+#include "core/array_api.h"
+#include "core/fptr_api.h"
+#include "core/range_api.h"
+#include "core/types_api.h"
+
+/* <GtIntervalIndex> is a static interval index for read-mostly overlap
+   queries. In contrast to <GtIntervalTree>, no node is allocated per element:
+   the intervals are kept in flat arrays sorted by start position, which are
+   augmented with the maximal end position in each subtree of an implicit
+   binary search tree over the sorted array. Intervals are added in bulk with
+   <gt_interval_index_add()> and the index is (re)built lazily by
+   <gt_interval_index_build()>, which must be called after the last
+   modification and before querying. All query functions report overlapping
+   intervals in order of ascending start position. */
+typedef struct GtIntervalIndex GtIntervalIndex;
+
+/* Function called for each element with the interval from <start> to <end>
+   in <gt_interval_index_iterate_overlapping()> and
+   <gt_interval_index_traverse()>. Use <data> to pass in arbitrary user data.
+   A return value != 0 stops the iteration. */
+typedef int (*GtIntervalIndexIteratorFunc)(void *elem, GtUword start,
+                                           GtUword end, void *data);
+
+/* Function called in <gt_interval_index_iterate_overlapping_batch()> for each
+   element <elem> overlapping the query with number <query>. A return value
+   != 0 stops the iteration. */
+typedef int (*GtIntervalIndexBatchFunc)(GtUword query, void *elem,
+                                        void *data);
+
+/* Creates a new empty <GtIntervalIndex>. If a <GtFree> function is given as
+   an argument, it is applied on the element pointers when they are removed
+   or when the <GtIntervalIndex> is deleted. */
+GtIntervalIndex* gt_interval_index_new(GtFree);
+
+/* Adds the element <elem> with the interval from <start> to <end> to
+   <interval_index>. Transfers ownership of <elem> to <interval_index> if a
+   <GtFree> function was given. */
+void             gt_interval_index_add(GtIntervalIndex *interval_index,
+                                       void *elem, GtUword start, GtUword end);
+
+/* Removes the element <elem> which was added with the interval from <start>
+   to <end> from <interval_index> and frees it according to the free function
+   given in the constructor. Returns true if the element was found. The
+   interval is only marked as removed and dropped by the next
+   <gt_interval_index_build()>, so removing many intervals in a row does not
+   move the remaining ones for each removal. */
+bool             gt_interval_index_remove(GtIntervalIndex *interval_index,
+                                          void *elem, GtUword start,
+                                          GtUword end);
+
+/* Prepares <interval_index> for queries after it has been modified. Elements
+   with equal start positions keep the order in which they were added. Does
+   nothing if <interval_index> has not been modified since the last call. */
+void             gt_interval_index_build(GtIntervalIndex *interval_index);
+
+/* Returns true if <interval_index> can be queried, that is, if it has not
+   been modified since the last call of <gt_interval_index_build()>. */
+bool             gt_interval_index_is_built(const GtIntervalIndex
+                                                               *interval_index);
+
+/* Returns the number of elements in <interval_index>. */
+GtUword          gt_interval_index_size(const GtIntervalIndex *interval_index);
+
+/* Adds the element pointers of all intervals in <interval_index> which overlap
+   the query range from <start> to <end> to <results>. */
+void             gt_interval_index_find_all_overlapping(const GtIntervalIndex
+                                                                *interval_index,
+                                                        GtUword start,
+                                                        GtUword end,
+                                                        GtArray *results);
+
+/* Calls <func> for all intervals in <interval_index> which overlap the query
+   range from <start> to <end>. Returns the first return value != 0 of <func>,
+   0 otherwise. */
+int              gt_interval_index_iterate_overlapping(const GtIntervalIndex
+                                                                *interval_index,
+                                                    GtUword start, GtUword end,
+                                               GtIntervalIndexIteratorFunc func,
+                                                       void *data);
+
+/* Calls <func> for all pairs of the <nof_queries> query ranges in <queries>,
+   which must be sorted by start position, and overlapping intervals in
+   <interval_index>, query by query. For large query sets this sweeps over
+   <interval_index> once instead of searching it for each query. Returns the
+   first return value != 0 of <func>, 0 otherwise. */
+int              gt_interval_index_iterate_overlapping_batch(
+                                         const GtIntervalIndex *interval_index,
+                                                         const GtRange *queries,
+                                                         GtUword nof_queries,
+                                                  GtIntervalIndexBatchFunc func,
+                                                         void *data);
+
+/* Calls <func> for all intervals in <interval_index> in order of ascending
+   start position. Returns the first return value != 0 of <func>, 0
+   otherwise. */
+int              gt_interval_index_traverse(const GtIntervalIndex
+                                                                *interval_index,
+                                            GtIntervalIndexIteratorFunc func,
+                                            void *data);
+
+/* Deletes <interval_index>, freeing all elements according to the free
+   function given in the constructor. */
+void             gt_interval_index_delete(GtIntervalIndex *interval_index);
+
+#endif
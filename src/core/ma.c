@@ -18,6 +18,7 @@
 #include <errno.h>
 #include <string.h>
 #include "core/array_api.h"
+#include "core/atomic.h"
 #include "core/compat.h"
 #include "core/hashmap.h"
 #include "core/ma.h"
@@ -28,18 +29,30 @@
 #include "core/unused_api.h"
 #include "core/xansi_api.h"
 
-/* the memory allocator class */
+/* The bookkeeping table is split into shards, each guarded by a lock of its
+   own, so that threads allocating and freeing memory concurrently rarely
+   wait for each other. The shard of a pointer only depends on its address,
+   so a block freed by another thread than the one which allocated it is found
+   in the same shard. */
+#define GT_MA_NUM_OF_SHARDS_LOG 6
+#define GT_MA_NUM_OF_SHARDS     (1U << GT_MA_NUM_OF_SHARDS_LOG)
+
 typedef struct {
+  GtMutex *lock;
   GtHashmap *allocated_pointer;
+  GtUint64 mallocevents;
+} MAShard;
+
+/* the memory allocator class */
+typedef struct {
+  MAShard shards[GT_MA_NUM_OF_SHARDS];
   bool bookkeeping,
        global_space_peak;
-  GtUint64 mallocevents;
-  GtUword current_size,
-                max_size;
+  GtUword current_size, /* updated atomically */
+          max_size;
 } MA;
 
 static MA *ma = NULL;
-static GtMutex *bookkeeping_lock = NULL;
 
 typedef struct {
   size_t size;
@@ -103,131 +116,133 @@ static void ma_info_free(MAInfo *mainfo)
 
 void gt_ma_init(bool bookkeeping)
 {
+  unsigned int idx;
   gt_assert(!ma);
   ma = xcalloc(1, sizeof (MA), 0, __FILE__, __LINE__);
   gt_assert(!ma->bookkeeping);
-  ma->allocated_pointer = gt_hashmap_new_no_ma(GT_HASH_DIRECT, NULL,
-                                               (GtFree) ma_info_free);
+  for (idx = 0; idx < GT_MA_NUM_OF_SHARDS; idx++) {
+    ma->shards[idx].allocated_pointer
+      = gt_hashmap_new_no_ma(GT_HASH_DIRECT, NULL, (GtFree) ma_info_free);
+    ma->shards[idx].lock = gt_mutex_new();
+  }
   /* MA is ready to use */
   ma->bookkeeping = bookkeeping;
-  bookkeeping_lock = gt_mutex_new();
   ma->global_space_peak = false;
 }
 
+static MAShard* ma_shard(MA *ma, const void *ptr)
+{
+  /* multiplicative hashing of the address without the alignment bits */
+  const GtUint64 key = (GtUint64) ((size_t) ptr >> 4);
+  return ma->shards + (size_t) ((key * 0x9E3779B97F4A7C15ULL) >>
+                                (64 - GT_MA_NUM_OF_SHARDS_LOG));
+}
+
 static void add_size(MA* ma, GtUword size)
 {
+  GtUword current, max;
   gt_assert(ma);
-  ma->current_size += size;
+  current = gt_atomic_add(&ma->current_size, size);
   if (ma->global_space_peak)
     gt_spacepeak_add(size);
-  if (ma->current_size > ma->max_size)
-    ma->max_size = ma->current_size;
+  while ((max = ma->max_size) < current &&
+         !gt_atomic_compare_and_swap(&ma->max_size, max, current))
+    /* retry */;
 }
 
 static void subtract_size(MA *ma, GtUword size)
 {
   gt_assert(ma);
   gt_assert(ma->current_size >= size);
-  ma->current_size -= size;
+  (void) gt_atomic_subtract(&ma->current_size, size);
   if (ma->global_space_peak)
     gt_spacepeak_free(size);
 }
 
-void* gt_malloc_mem(size_t size, const char *src_file, int src_line)
+/* Record the allocation of <mem> in its shard. */
+static void ma_register(MA *ma, void *mem, size_t size, const char *src_file,
+                        int src_line)
 {
+  MAShard *shard = ma_shard(ma, mem);
+  MAInfo *mainfo = xmalloc(sizeof *mainfo, ma->current_size, src_file,
+                           src_line);
+  mainfo->size = size;
+  mainfo->src_file = src_file;
+  mainfo->src_line = src_line;
+  gt_mutex_lock(shard->lock);
+  shard->mallocevents++;
+  gt_hashmap_add(shard->allocated_pointer, mem, mainfo);
+  gt_mutex_unlock(shard->lock);
+  add_size(ma, size);
+}
+
+/* Remove the record of <ptr> from its shard. */
+static void ma_unregister(MA *ma, void *ptr, GT_UNUSED const char *src_file,
+                          GT_UNUSED int src_line)
+{
+  MAShard *shard = ma_shard(ma, ptr);
   MAInfo *mainfo;
+  size_t size;
+  gt_mutex_lock(shard->lock);
+  mainfo = gt_hashmap_get(shard->allocated_pointer, ptr);
+#ifndef NDEBUG
+  if (!mainfo) {
+    fprintf(stderr, "bug: double free() attempted on line %d in file "
+            "\"%s\"\n", src_line, src_file);
+    exit(GT_EXIT_PROGRAMMING_ERROR);
+  }
+#endif
+  gt_assert(mainfo);
+  size = mainfo->size;
+  gt_hashmap_remove(shard->allocated_pointer, ptr);
+  gt_mutex_unlock(shard->lock);
+  subtract_size(ma, size);
+}
+
+void* gt_malloc_mem(size_t size, const char *src_file, int src_line)
+{
   void *mem;
   gt_assert(ma);
-  if (ma->bookkeeping) {
-    gt_mutex_lock(bookkeeping_lock);
-    ma->mallocevents++;
-    mainfo = xmalloc(sizeof *mainfo, ma->current_size, src_file, src_line);
-    mainfo->size = size;
-    mainfo->src_file = src_file;
-    mainfo->src_line = src_line;
-    mem = xmalloc(size, ma->current_size, src_file, src_line);
-    gt_hashmap_add(ma->allocated_pointer, mem, mainfo);
-    add_size(ma, size);
-    gt_mutex_unlock(bookkeeping_lock);
-    return mem;
-  }
-  return xmalloc(size, ma->current_size, src_file, src_line);
+  mem = xmalloc(size, ma->current_size, src_file, src_line);
+  if (ma->bookkeeping)
+    ma_register(ma, mem, size, src_file, src_line);
+  return mem;
 }
 
 void* gt_calloc_mem(size_t nmemb, size_t size, const char *src_file,
                     int src_line)
 {
-  MAInfo *mainfo;
   void *mem;
   gt_assert(ma);
-  if (ma->bookkeeping) {
-    gt_mutex_lock(bookkeeping_lock);
-    ma->mallocevents++;
-    mainfo = xmalloc(sizeof *mainfo, ma->current_size, src_file, src_line);
-    mainfo->size = nmemb * size;
-    mainfo->src_file = src_file;
-    mainfo->src_line = src_line;
-    mem = xcalloc(nmemb, size, ma->current_size, src_file, src_line);
-    gt_hashmap_add(ma->allocated_pointer, mem, mainfo);
-    add_size(ma, nmemb * size);
-    gt_mutex_unlock(bookkeeping_lock);
-    return mem;
-  }
-  return xcalloc(nmemb, size, ma->current_size, src_file, src_line);
+  mem = xcalloc(nmemb, size, ma->current_size, src_file, src_line);
+  if (ma->bookkeeping)
+    ma_register(ma, mem, nmemb * size, src_file, src_line);
+  return mem;
 }
 
 void* gt_realloc_mem(void *ptr, size_t size, const char *src_file, int src_line)
 {
-  MAInfo *mainfo;
   void *mem;
   gt_assert(ma);
   if (ma->bookkeeping) {
-    gt_mutex_lock(bookkeeping_lock);
-    ma->mallocevents++;
-    if (ptr) {
-      mainfo = gt_hashmap_get(ma->allocated_pointer, ptr);
-      gt_assert(mainfo);
-      subtract_size(ma, mainfo->size);
-      gt_hashmap_remove(ma->allocated_pointer, ptr);
-    }
-    mainfo = xmalloc(sizeof *mainfo, ma->current_size, src_file, src_line);
-    mainfo->size = size;
-    mainfo->src_file = src_file;
-    mainfo->src_line = src_line;
+    /* the old block is unregistered before it can be released by realloc(),
+       as another thread may get the same address afterwards */
+    if (ptr)
+      ma_unregister(ma, ptr, src_file, src_line);
     mem = xrealloc(ptr, size, ma->current_size, src_file, src_line);
-    gt_hashmap_add(ma->allocated_pointer, mem, mainfo);
-    add_size(ma, size);
-    gt_mutex_unlock(bookkeeping_lock);
+    ma_register(ma, mem, size, src_file, src_line);
     return mem;
   }
   return xrealloc(ptr, size, ma->current_size, src_file, src_line);
 }
 
-void gt_free_mem(void *ptr, GT_UNUSED const char *src_file,
-                 GT_UNUSED int src_line)
+void gt_free_mem(void *ptr, const char *src_file, int src_line)
 {
-  MAInfo *mainfo;
   gt_assert(ma);
   if (ptr == NULL) return;
-  if (ma->bookkeeping) {
-    gt_mutex_lock(bookkeeping_lock);
-#ifndef NDEBUG
-    if (!gt_hashmap_get(ma->allocated_pointer, ptr)) {
-      fprintf(stderr, "bug: double free() attempted on line %d in file "
-              "\"%s\"\n", src_line, src_file);
-      exit(GT_EXIT_PROGRAMMING_ERROR);
-    }
-#endif
-    mainfo = gt_hashmap_get(ma->allocated_pointer, ptr);
-    gt_assert(mainfo);
-    subtract_size(ma, mainfo->size);
-    gt_hashmap_remove(ma->allocated_pointer, ptr);
-    free(ptr);
-    gt_mutex_unlock(bookkeeping_lock);
-  }
-  else {
-    free(ptr);
-  }
+  if (ma->bookkeeping)
+    ma_unregister(ma, ptr, src_file, src_line);
+  free(ptr);
 }
 
 void gt_free_func(void *ptr)
@@ -278,23 +293,34 @@ GtUword gt_ma_get_space_current(void)
 
 void gt_ma_show_space_peak(FILE *fp)
 {
+  GtUint64 mallocevents = 0;
+  unsigned int idx;
   gt_assert(ma);
+  /* merge the statistics of the shards */
+  for (idx = 0; idx < GT_MA_NUM_OF_SHARDS; idx++) {
+    gt_mutex_lock(ma->shards[idx].lock);
+    mallocevents += ma->shards[idx].mallocevents;
+    gt_mutex_unlock(ma->shards[idx].lock);
+  }
   fprintf(fp, "# space peak in megabytes: %.2f (in "GT_LLU" events)\n",
           GT_MEGABYTES(ma->max_size),
-          ma->mallocevents);
+          mallocevents);
 }
 
 int gt_ma_check_space_leak(void)
 {
   CheckSpaceLeakInfo info;
   GT_UNUSED int had_err;
+  unsigned int idx;
   gt_assert(ma);
-  gt_mutex_lock(bookkeeping_lock);
   info.has_leak = false;
-  had_err = gt_hashmap_foreach(ma->allocated_pointer, check_space_leak, &info,
-                               NULL);
-  gt_assert(!had_err); /* cannot happen, check_space_leak() is sane */
-  gt_mutex_unlock(bookkeeping_lock);
+  for (idx = 0; idx < GT_MA_NUM_OF_SHARDS; idx++) {
+    gt_mutex_lock(ma->shards[idx].lock);
+    had_err = gt_hashmap_foreach(ma->shards[idx].allocated_pointer,
+                                 check_space_leak, &info, NULL);
+    gt_assert(!had_err); /* cannot happen, check_space_leak() is sane */
+    gt_mutex_unlock(ma->shards[idx].lock);
+  }
   if (info.has_leak)
     return -1;
   return 0;
@@ -321,22 +347,26 @@ static int print_allocation(GT_UNUSED void *key, void *value,
 void gt_ma_show_allocations(FILE *outfp)
 {
   GT_UNUSED int had_err;
+  unsigned int idx;
   gt_assert(ma);
-  gt_mutex_lock(bookkeeping_lock);
-  had_err = gt_hashmap_foreach(ma->allocated_pointer, print_allocation,
-                               outfp, NULL);
-  gt_mutex_unlock(bookkeeping_lock);
-  gt_assert(!had_err); /* cannot happen, print_allocation() is sane */
+  for (idx = 0; idx < GT_MA_NUM_OF_SHARDS; idx++) {
+    gt_mutex_lock(ma->shards[idx].lock);
+    had_err = gt_hashmap_foreach(ma->shards[idx].allocated_pointer,
+                                 print_allocation, outfp, NULL);
+    gt_mutex_unlock(ma->shards[idx].lock);
+    gt_assert(!had_err); /* cannot happen, print_allocation() is sane */
+  }
 }
 
 void gt_ma_clean(void)
 {
+  unsigned int idx;
   gt_assert(ma);
-  gt_mutex_lock(bookkeeping_lock);
   ma->bookkeeping = false;
-  gt_hashmap_delete(ma->allocated_pointer);
-  gt_mutex_unlock(bookkeeping_lock);
-  gt_mutex_delete(bookkeeping_lock);
+  for (idx = 0; idx < GT_MA_NUM_OF_SHARDS; idx++) {
+    gt_hashmap_delete(ma->shards[idx].allocated_pointer);
+    gt_mutex_delete(ma->shards[idx].lock);
+  }
   free(ma);
   ma = NULL;
 }
@@ -0,0 +1,364 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include "core/array.h"
+#include "core/assert_api.h"
+#include "core/cstr_api.h"
+#include "core/ensure.h"
+#include "core/ma.h"
+#include "core/minmax.h"
+#include "core/ordered_ring.h"
+#include "core/thread_api.h"
+#include "core/undef_api.h"
+#include "core/unused_api.h"
+
+typedef struct {
+  void *item;
+  char *error; /* the error message if the item could not be produced */
+  bool filled;
+} GtOrderedRingSlot;
+
+struct GtOrderedRing {
+  GtOrderedRingReadFunc read_func;
+  GtOrderedRingProcessFunc process_func;
+  GtOrderedRingFreeFunc free_func;
+  void *data;
+  bool read_done;      /* the last item has been read or reading failed */
+  GtUword next_served,
+          end;         /* number of items to deliver, undefined until known */
+#ifdef GT_THREADS_ENABLED
+  GtArray *threads;
+  GtMutex *read_mutex, /* serializes the reading of items */
+          *mutex;      /* protects the slots and counters */
+  GtCond *item_added,
+         *slot_freed;
+  GtOrderedRingSlot *slots; /* item number <i> is stored in slot
+                               <i> % <nof_slots>, NULL without workers */
+  GtUword nof_slots,
+          next_read;
+  bool cancelled;
+#endif
+};
+
+static void* ordered_ring_read(GtOrderedRing *ring, GtError *err)
+{
+  bool last = false;
+  void *item;
+  if (!(item = ring->read_func(ring->data, &last, err)) || last)
+    ring->read_done = true;
+  return item;
+}
+
+static void* ordered_ring_process(GtOrderedRing *ring, void *item,
+                                  GtError *err)
+{
+  if (item && ring->process_func &&
+      ring->process_func(item, ring->data, err)) {
+    ring->free_func(item);
+    return NULL;
+  }
+  return item;
+}
+
+#ifdef GT_THREADS_ENABLED
+
+static void* ordered_ring_thread(void *data)
+{
+  GtOrderedRing *ring = data;
+  GtOrderedRingSlot *slot;
+  GtError *err = gt_error_new();
+  GtUword num;
+  void *item;
+  bool last;
+  for (;;) {
+    gt_mutex_lock(ring->read_mutex);
+    if (ring->read_done) {
+      gt_mutex_unlock(ring->read_mutex);
+      break;
+    }
+    /* wait for a free slot */
+    gt_mutex_lock(ring->mutex);
+    while (!ring->cancelled &&
+           ring->next_read >= ring->next_served + ring->nof_slots) {
+      gt_cond_wait(ring->slot_freed, ring->mutex);
+    }
+    if (ring->cancelled) {
+      gt_mutex_unlock(ring->mutex);
+      gt_mutex_unlock(ring->read_mutex);
+      break;
+    }
+    num = ring->next_read++;
+    gt_mutex_unlock(ring->mutex);
+    item = ordered_ring_read(ring, err);
+    last = ring->read_done;
+    gt_mutex_unlock(ring->read_mutex);
+    /* the processing is done in parallel */
+    item = ordered_ring_process(ring, item, err);
+    gt_mutex_lock(ring->mutex);
+    slot = ring->slots + num % ring->nof_slots;
+    slot->item = item;
+    slot->error = item ? NULL : gt_cstr_dup(gt_error_get(err));
+    slot->filled = true;
+    if (last && num + 1 < ring->end)
+      ring->end = num + 1;
+    gt_cond_broadcast(ring->item_added);
+    gt_mutex_unlock(ring->mutex);
+    gt_error_unset(err);
+  }
+  gt_error_delete(err);
+  return NULL;
+}
+
+/* Takes the next item from the slots, returns the error message if it could
+   not be produced. */
+static char* ordered_ring_take(GtOrderedRing *ring, void **item)
+{
+  GtOrderedRingSlot *slot;
+  char *error = NULL;
+  gt_mutex_lock(ring->mutex);
+  slot = ring->slots + ring->next_served % ring->nof_slots;
+  while (ring->next_served < ring->end && !slot->filled)
+    gt_cond_wait(ring->item_added, ring->mutex);
+  if (ring->next_served < ring->end) {
+    *item = slot->item;
+    error = slot->error;
+    slot->item = NULL;
+    slot->error = NULL;
+    slot->filled = false;
+    ring->next_served++;
+    /* nothing is delivered after an error */
+    if (error)
+      ring->end = ring->next_served;
+    gt_cond_broadcast(ring->slot_freed);
+  }
+  gt_mutex_unlock(ring->mutex);
+  return error;
+}
+
+#endif
+
+GtOrderedRing* gt_ordered_ring_new(GtOrderedRingReadFunc read_func,
+                                   GtOrderedRingProcessFunc process_func,
+                                   GtOrderedRingFreeFunc free_func,
+                                   void *data,
+                                   GT_UNUSED unsigned int nof_threads,
+                                   GT_UNUSED GtUword nof_slots)
+{
+  GtOrderedRing *ring;
+  gt_assert(read_func && free_func);
+  ring = gt_calloc(1, sizeof *ring);
+  ring->read_func = read_func;
+  ring->process_func = process_func;
+  ring->free_func = free_func;
+  ring->data = data;
+  ring->end = GT_UNDEF_UWORD;
+#ifdef GT_THREADS_ENABLED
+  if (nof_threads > 0) {
+    GtError *err = gt_error_new();
+    GtThread *thread;
+    unsigned int i;
+    gt_assert(nof_slots >= nof_threads);
+    ring->threads = gt_array_new(sizeof (GtThread*));
+    ring->read_mutex = gt_mutex_new();
+    ring->mutex = gt_mutex_new();
+    ring->item_added = gt_cond_new();
+    ring->slot_freed = gt_cond_new();
+    ring->nof_slots = nof_slots;
+    ring->slots = gt_calloc(nof_slots, sizeof (GtOrderedRingSlot));
+    for (i = 0; i < nof_threads; i++) {
+      if (!(thread = gt_thread_new(ordered_ring_thread, ring, err)))
+        break;
+      gt_array_add(ring->threads, thread);
+    }
+    /* without any worker, produce the items on demand */
+    if (!gt_array_size(ring->threads)) {
+      gt_free(ring->slots);
+      ring->slots = NULL;
+    }
+    gt_error_delete(err);
+  }
+#endif
+  return ring;
+}
+
+int gt_ordered_ring_next(GtOrderedRing *ring, void **item, GtError *err)
+{
+  gt_error_check(err);
+  gt_assert(ring && item);
+  *item = NULL;
+#ifdef GT_THREADS_ENABLED
+  if (ring->slots) {
+    char *error;
+    if ((error = ordered_ring_take(ring, item))) {
+      gt_error_set(err, "%s", error);
+      gt_free(error);
+      return -1;
+    }
+    return 0;
+  }
+#endif
+  if (ring->next_served < ring->end) {
+    *item = ordered_ring_process(ring, ordered_ring_read(ring, err), err);
+    ring->next_served++;
+    if (!*item || ring->read_done)
+      ring->end = ring->next_served;
+    if (!*item)
+      return -1;
+  }
+  return 0;
+}
+
+void gt_ordered_ring_delete(GtOrderedRing *ring)
+{
+  if (!ring) return;
+#ifdef GT_THREADS_ENABLED
+  if (ring->threads) {
+    GtUword i;
+    gt_mutex_lock(ring->mutex);
+    ring->cancelled = true;
+    gt_cond_broadcast(ring->slot_freed);
+    gt_mutex_unlock(ring->mutex);
+    for (i = 0; i < gt_array_size(ring->threads); i++) {
+      GtThread *thread = *(GtThread**) gt_array_get(ring->threads, i);
+      gt_thread_join(thread);
+      gt_thread_delete(thread);
+    }
+    gt_array_delete(ring->threads);
+    for (i = 0; ring->slots && i < ring->nof_slots; i++) {
+      if (ring->slots[i].item)
+        ring->free_func(ring->slots[i].item);
+      gt_free(ring->slots[i].error);
+    }
+    gt_free(ring->slots);
+    gt_cond_delete(ring->item_added);
+    gt_cond_delete(ring->slot_freed);
+    gt_mutex_delete(ring->mutex);
+    gt_mutex_delete(ring->read_mutex);
+  }
+#endif
+  gt_free(ring);
+}
+
+typedef struct {
+  GtUword next,
+          nof_items,
+          fail_read, /* number of the item which cannot be read */
+          fail_process;
+} GtOrderedRingTestInfo;
+
+static void* ordered_ring_test_read(void *data, bool *last, GtError *err)
+{
+  GtOrderedRingTestInfo *info = data;
+  GtUword *item;
+  if (info->next == info->fail_read) {
+    gt_error_set(err, "cannot read item " GT_WU, info->next);
+    return NULL;
+  }
+  item = gt_malloc(sizeof *item);
+  *item = info->next++;
+  *last = info->next == info->nof_items;
+  return item;
+}
+
+static int ordered_ring_test_process(void *item, void *data, GtError *err)
+{
+  GtOrderedRingTestInfo *info = data;
+  GtUword *value = item;
+  if (*value == info->fail_process) {
+    gt_error_set(err, "cannot process item " GT_WU, *value);
+    return -1;
+  }
+  *value = *value * 3 + 1;
+  return 0;
+}
+
+static void ordered_ring_test_free(void *item)
+{
+  gt_free(item);
+}
+
+/* Delivers the items of <info> with <nof_threads> workers, stopping after
+   <stop> items, and checks their order. */
+static int ordered_ring_test_run(GtOrderedRingTestInfo *info,
+                                 unsigned int nof_threads, GtUword stop,
+                                 GtError *err)
+{
+  GtOrderedRing *ring;
+  GtError *ring_err = gt_error_new();
+  GtUword i, expected_end;
+  void *item;
+  int had_err = 0, rval = 0;
+  info->next = 0;
+  expected_end = MIN(MIN(info->nof_items, info->fail_read),
+                     info->fail_process);
+  ring = gt_ordered_ring_new(ordered_ring_test_read, ordered_ring_test_process,
+                             ordered_ring_test_free, info, nof_threads,
+                             2 * nof_threads);
+  for (i = 0; !had_err && i < stop; i++) {
+    rval = gt_ordered_ring_next(ring, &item, ring_err);
+    if (i < expected_end) {
+      gt_ensure(!rval && item && *(GtUword*) item == i * 3 + 1);
+    }
+    else if (i == expected_end && expected_end < info->nof_items) {
+      gt_ensure(rval && !item && gt_error_is_set(ring_err));
+      gt_error_unset(ring_err);
+    }
+    else
+      gt_ensure(!rval && !item);
+    gt_free(item);
+  }
+  gt_ordered_ring_delete(ring);
+  gt_error_delete(ring_err);
+  return had_err;
+}
+
+int gt_ordered_ring_unit_test(GtError *err)
+{
+  GtOrderedRingTestInfo info;
+  unsigned int nof_threads;
+  int had_err = 0;
+  gt_error_check(err);
+
+  for (nof_threads = 0; !had_err && nof_threads <= 4; nof_threads++) {
+    /* all items */
+    info.nof_items = 1000;
+    info.fail_read = info.fail_process = GT_UNDEF_UWORD;
+    had_err = ordered_ring_test_run(&info, nof_threads, 1002, err);
+    /* a single item */
+    if (!had_err) {
+      info.nof_items = 1;
+      had_err = ordered_ring_test_run(&info, nof_threads, 3, err);
+    }
+    /* stop early */
+    if (!had_err) {
+      info.nof_items = 1000;
+      had_err = ordered_ring_test_run(&info, nof_threads, 17, err);
+    }
+    /* reading fails */
+    if (!had_err) {
+      info.fail_read = 500;
+      had_err = ordered_ring_test_run(&info, nof_threads, 502, err);
+    }
+    /* processing fails */
+    if (!had_err) {
+      info.fail_read = GT_UNDEF_UWORD;
+      info.fail_process = 321;
+      had_err = ordered_ring_test_run(&info, nof_threads, 323, err);
+    }
+  }
+  return had_err;
+}
@@ -0,0 +1,63 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef ORDERED_RING_H
+#define ORDERED_RING_H
+
+#include "core/error_api.h"
+
+/* A <GtOrderedRing> produces a sequence of items ahead of a single consumer.
+   Worker threads take turns reading the next item (reading is serialized),
+   process the items they have read in parallel and store them in a bounded
+   ring of slots, from which the consumer takes them in their original order.
+   Without threading support (or if no worker thread could be started), the
+   items are read and processed on demand by the consumer itself. */
+typedef struct GtOrderedRing GtOrderedRing;
+
+/* Reads the next item of the sequence and returns it. Sets <last> to true if
+   the returned item is the last one. Returns NULL and sets <err> on error.
+   Never called concurrently. */
+typedef void* (*GtOrderedRingReadFunc)(void *data, bool *last, GtError *err);
+/* Processes <item> after it has been read. Called concurrently for different
+   items. Returns 0 on success and -1 (setting <err>) on error. */
+typedef int   (*GtOrderedRingProcessFunc)(void *item, void *data,
+                                          GtError *err);
+typedef void  (*GtOrderedRingFreeFunc)(void *item);
+
+/* Return a new <GtOrderedRing> which reads items with <read_func> and
+   processes them with <process_func> (can be NULL) using <nof_threads>
+   worker threads, which fill up to <nof_slots> (>= <nof_threads>) slots ahead
+   of the consumer. If <nof_threads> is 0, the items are produced on demand.
+   <data> is passed to both functions, <free_func> frees items which are not
+   delivered. */
+GtOrderedRing* gt_ordered_ring_new(GtOrderedRingReadFunc read_func,
+                                   GtOrderedRingProcessFunc process_func,
+                                   GtOrderedRingFreeFunc free_func,
+                                   void *data, unsigned int nof_threads,
+                                   GtUword nof_slots);
+/* Store the next item of <ring> in <item> (NULL if all items have been
+   delivered) and return 0. If reading or processing the item failed, -1 is
+   returned and <err> is set, no items follow afterwards. The consumer owns
+   the delivered items. */
+int            gt_ordered_ring_next(GtOrderedRing *ring, void **item,
+                                    GtError *err);
+/* Stop the workers of <ring> and free the items not delivered yet. */
+void           gt_ordered_ring_delete(GtOrderedRing *ring);
+
+int            gt_ordered_ring_unit_test(GtError *err);
+
+#endif
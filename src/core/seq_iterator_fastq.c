@@ -26,8 +26,6 @@
 #include "core/str_array.h"
 #include "core/unused_api.h"
 
-#define GT_SEQIT_QUAL_INBUFSIZE  8192
-
 struct GtSeqIteratorFastQ
 {
   const GtSeqIterator parent_instance;
@@ -52,8 +50,8 @@ struct GtSeqIteratorFastQ
   GtUint64 maxread,
                      currentread;
   const GtStrArray *filenametab;
-  unsigned char ungetchar,
-                inbuf[GT_SEQIT_QUAL_INBUFSIZE];
+  unsigned char ungetchar;
+  const char *inbuf; /* points into the read buffer of <curfile> */
   const GtUchar *symbolmap, **qualities;
 };
 
@@ -73,8 +71,8 @@ static inline int fastq_buf_getchar(GtSeqIteratorFastQ *seqit)
     return seqit->ungetchar;
   } else {
     if (seqit->currentinpos >= seqit->currentfillpos) {
-      seqit->currentfillpos = gt_file_xread(seqit->curfile, seqit->inbuf,
-                                             GT_SEQIT_QUAL_INBUFSIZE);
+      seqit->currentfillpos = gt_file_xread_block(seqit->curfile,
+                                                  &seqit->inbuf);
       if (seqit->currentfillpos == 0)
          return EOF;
       seqit->currentinpos = 0;
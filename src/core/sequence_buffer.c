@@ -102,6 +102,33 @@ GtSequenceBuffer* gt_sequence_buffer_new_guess_type(const GtStrArray *seqs,
   return sb;
 }
 
+GtSequenceBuffer* gt_sequence_buffer_new_same_type(const GtSequenceBuffer *sb,
+                                                   const GtStrArray *seqs)
+{
+  gt_assert(sb && seqs);
+  if (sb->c_class == gt_sequence_buffer_embl_class())
+    return gt_sequence_buffer_embl_new(seqs);
+  if (sb->c_class == gt_sequence_buffer_fasta_class())
+    return gt_sequence_buffer_fasta_new(seqs);
+  if (sb->c_class == gt_sequence_buffer_gb_class())
+    return gt_sequence_buffer_gb_new(seqs);
+  gt_assert(sb->c_class == gt_sequence_buffer_fastq_class());
+  return gt_sequence_buffer_fastq_new(seqs);
+}
+
+bool gt_sequence_buffer_file_ends_with_separator(const GtSequenceBuffer *sb)
+{
+  gt_assert(sb);
+  return sb->c_class != gt_sequence_buffer_fasta_class();
+}
+
+bool gt_sequence_buffer_ignores_blank_files(const GtSequenceBuffer *sb)
+{
+  gt_assert(sb);
+  return sb->c_class == gt_sequence_buffer_fasta_class() ||
+         sb->c_class == gt_sequence_buffer_gb_class();
+}
+
 GtUword gt_sequence_buffer_get_file_index(GtSequenceBuffer *si)
 {
   gt_assert(si && si->c_class && si->c_class->get_file_index);
@@ -44,6 +44,19 @@ GtSequenceBuffer*  gt_sequence_buffer_ref(GtSequenceBuffer*);
 GtSequenceBuffer*  gt_sequence_buffer_new_guess_type(const GtStrArray*,
                                                      GtError*);
 
+/* Creates a new <GtSequenceBuffer> of the same type as <sb> for the files
+   <seqs>, e.g. to read some of the files of <sb> independently. */
+GtSequenceBuffer*  gt_sequence_buffer_new_same_type(const GtSequenceBuffer *sb,
+                                                    const GtStrArray *seqs);
+/* Returns true if <sb> counts the separator following the last sequence of a
+   file in the effective length of that file, which all formats except FASTA
+   do for all but the last file. */
+bool               gt_sequence_buffer_file_ends_with_separator(
+                                                 const GtSequenceBuffer *sb);
+/* Returns true if <sb> reads a file containing white space only like an empty
+   file, which adds nothing to the input. */
+bool               gt_sequence_buffer_ignores_blank_files(
+                                                 const GtSequenceBuffer *sb);
 /* Fetches next character from <GtSequenceBuffer>.
    Returns 1 if a new character could be read, 0 if all files are exhausted, or
    -1 on error (see the <GtError> object for details). */
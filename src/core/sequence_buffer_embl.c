@@ -324,7 +324,12 @@ static int gt_sequence_buffer_embl_advance(GtSequenceBuffer *sb, GtError *err)
         gt_assert(pvt->outbuf[currentoutpos-1] == SEPARATOR);
         pvt->outbuf[--currentoutpos] = (GtUchar) '\0';
         if (pvt->filelengthtab) {
-          pvt->filelengthtab[pvt->filenum].effectivelength--;
+          /* the separator belongs to the last file with a sequence */
+          unsigned int filenum = pvt->filenum;
+          while (filenum > 0 &&
+                 pvt->filelengthtab[filenum].effectivelength == 0)
+            filenum--;
+          pvt->filelengthtab[filenum].effectivelength--;
         }
         had_err = 0;
         break;
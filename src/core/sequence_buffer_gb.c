@@ -415,7 +415,12 @@ static int gt_sequence_buffer_gb_advance(GtSequenceBuffer *sb, GtError *err)
         /* remove last separator */
         pvt->outbuf[--currentoutpos] = (GtUchar) '\0';
         if (pvt->filelengthtab) {
-          pvt->filelengthtab[pvt->filenum].effectivelength--;
+          /* the separator belongs to the last file with a sequence */
+          unsigned int filenum = pvt->filenum;
+          while (filenum > 0 &&
+                 pvt->filelengthtab[filenum].effectivelength == 0)
+            filenum--;
+          pvt->filelengthtab[filenum].effectivelength--;
         }
         had_err = 0;
         break;
@@ -67,8 +67,7 @@
     return (int) pvt->ungetchar;
   } else {
     if (pvt->currentinpos >= pvt->currentfillpos) {
-      pvt->currentfillpos = (GtUword) gt_file_xread(f, pvt->inbuf,
-                                                          (size_t) INBUFSIZE);
+      pvt->currentfillpos = gt_file_xread_block(f, &pvt->inbuf);
       if (pvt->currentfillpos == 0)
          return EOF;
       pvt->currentinpos = 0;
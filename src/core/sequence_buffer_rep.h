@@ -26,7 +26,6 @@
 #include "core/sequence_buffer.h"
 #include "core/str_array.h"
 
-#define INBUFSIZE  8192
 #define OUTBUFSIZE 8192
 
 struct GtSequenceBufferClass {
@@ -60,8 +59,8 @@ struct GtSequenceBufferMembers {
   uint64_t lastspeciallength;
   GtUint64 counter;
   const GtStrArray *filenametab;
+  const char *inbuf; /* points into the read buffer of the input file */
   unsigned char ungetchar,
-                inbuf[INBUFSIZE],
                 outbuf[OUTBUFSIZE],
                 outbuforig[OUTBUFSIZE];
   const unsigned char *symbolmap;
@@ -18,9 +18,11 @@
 #include <math.h>
 #include <string.h>
 #include "core/assert_api.h"
+#include "core/atomic.h"
 #include "core/cstr_api.h"
 #include "core/dynalloc.h"
 #include "core/ensure.h"
+#include "core/file.h"
 #include "core/ma.h"
 #include "core/str.h"
 #include "core/unused_api.h"
@@ -30,7 +32,8 @@ struct GtStr {
   char *cstr;           /* the actual string (always '\0' terminated) */
   GtUword length; /* currently used length (without trailing '\0') */
   size_t allocated;     /* currently allocated memory */
-  unsigned int reference_count;
+  unsigned int reference_count; /* modified atomically, strings are shared
+                                   between threaded node stream stages */
 };
 
 GtStr* gt_str_new(void)
@@ -247,7 +250,7 @@ GtStr* gt_str_clone(const GtStr *s)
 GtStr* gt_str_ref(GtStr *s)
 {
   if (!s) return NULL;
-  s->reference_count++; /* increase the reference counter */
+  gt_atomic_increment(&s->reference_count); /* increase the ref. counter */
   return s;
 }
 
@@ -312,60 +315,20 @@ int gt_str_read_next_line(GtStr *s, FILE *fpin)
 
 int gt_str_read_next_line_generic(GtStr *s, GtFile *fpin)
 {
-  int cc;
-  char c;
+  const char *line;
+  GtUword length;
+  int rval;
   gt_assert(s);
-  for (;;) {
-    cc = gt_file_xfgetc(fpin);
-    if (cc == EOF)
-      return EOF;
-    if (cc == '\n') {
-      if ((s->length+1) * sizeof (char) > s->allocated) {
-        s->cstr = gt_dynalloc(s->cstr, &s->allocated,
-                              (s->length+1) * sizeof (char));
-      }
-      s->cstr[s->length] = '\0';
-      return 0;
-    }
-    else if (cc == '\r') {
-      /* check if we have a Windows newline "\r\n" */
-      int ncc;
-      char nc;
-      ncc = gt_file_xfgetc(fpin);
-      if (ncc == EOF) {
-        c = cc;
-        if ((s->length+2) * sizeof (char) > s->allocated) {
-          s->cstr = gt_dynalloc(s->cstr, &s->allocated,
-                                (s->length+2) * sizeof (char));
-        }
-        s->cstr[s->length++] = c;
-        return EOF;
-      }
-      if (ncc == '\n') {
-        if ((s->length+1) * sizeof (char) > s->allocated) {
-          s->cstr = gt_dynalloc(s->cstr, &s->allocated,
-                                (s->length+1) * sizeof (char));
-        }
-        s->cstr[s->length] = '\0';
-        return 0;
-      }
-      c = cc;
-      nc = ncc;
-      if ((s->length+3) * sizeof (char) > s->allocated) {
-        s->cstr = gt_dynalloc(s->cstr, &s->allocated,
-                              (s->length+3) * sizeof (char));
-      }
-      s->cstr[s->length++] = c;
-      s->cstr[s->length++] = nc;
-      continue;
-    }
-    c = cc;
-    if ((s->length+2) * sizeof (char) > s->allocated) {
-      s->cstr = gt_dynalloc(s->cstr, &s->allocated,
-                            (s->length+2) * sizeof (char));
-    }
-    s->cstr[s->length++] = c;
-  }
+  if (!fpin)
+    return gt_str_read_next_line(s, stdin);
+  rval = gt_file_xread_line(fpin, &line, &length);
+  s->cstr = gt_dynalloc(s->cstr, &s->allocated,
+                        (s->length + length + 1) * sizeof (char));
+  memcpy(s->cstr + s->length, line, length);
+  s->length += length;
+  if (!rval)
+    s->cstr[s->length] = '\0';
+  return rval;
 }
 
 int gt_str_unit_test(GtError *err)
@@ -458,10 +421,10 @@ int gt_str_unit_test(GtError *err)
 void gt_str_delete(GtStr *s)
 {
   if (!s) return;           /* return without action if 's' is NULL */
-  if (s->reference_count) { /* there are multiple references to this string */
-    s->reference_count--;   /* decrement the reference counter */
-    return;                 /* return without freeing the object */
-  }
+  /* decrement the reference counter, if there are multiple references to
+     this string, and return without freeing the object */
+  if (gt_atomic_fetch_and_decrement(&s->reference_count))
+    return;
   gt_free(s->cstr);         /* free the stored the C string */
   gt_free(s);               /* free the actual string object */
 }
@@ -16,57 +16,198 @@
 */
 
 #include <string.h>
-#include "core/cstr_table.h"
+#include "core/atomic.h"
+#include "core/cstr_api.h"
+#include "core/hashtable.h"
+#include "core/ma.h"
 #include "core/mathsupport.h"
 #include "core/multithread_api.h"
+#include "core/str_api.h"
 #include "core/symbol.h"
 #include "core/unused_api.h"
 
-static GtCstrTable *symbols = NULL;
-static GtMutex *symbol_mutex = NULL;
+/* Symbols are distributed over independent shards by their hash value. Each
+   shard is a chained hash table, which is read without locking: entries are
+   completely initialized before they are linked into a bucket, and a table is
+   never changed except by linking new entries into its buckets. Inserts into a
+   shard are serialized by its mutex. To grow a shard, a new table with new
+   chain entries (for the same symbol strings) is published, and the old table
+   is kept until <gt_symbol_clean()>, as concurrent readers may still traverse
+   it. */
+
+#define GT_SYMBOL_SHARD_BITS      6
+#define GT_SYMBOL_NOF_SHARDS      (1U << GT_SYMBOL_SHARD_BITS)
+#define GT_SYMBOL_INITIAL_BUCKETS 64UL
+
+typedef struct GtSymbolEntry {
+  struct GtSymbolEntry *next;
+  uint32_t hash;
+  char *symbol;
+} GtSymbolEntry;
+
+typedef struct GtSymbolTable {
+  GtUword mask;
+  GtSymbolEntry **buckets;
+  struct GtSymbolTable *retired; /* table replaced by this one */
+} GtSymbolTable;
+
+typedef struct {
+  GtSymbolTable *table;
+  GtUword nof_symbols;
+  GtMutex *mutex;
+} GtSymbolShard;
+
+static GtSymbolShard *symbol_shards = NULL;
+
+static GtSymbolTable* symbol_table_new(GtUword nof_buckets)
+{
+  GtSymbolTable *table = gt_malloc(sizeof (GtSymbolTable));
+  table->mask = nof_buckets - 1;
+  table->buckets = gt_calloc((size_t) nof_buckets, sizeof (GtSymbolEntry*));
+  table->retired = NULL;
+  return table;
+}
+
+static void symbol_table_add(GtSymbolTable *table, GtSymbolEntry *entry)
+{
+  GtSymbolEntry **bucket = table->buckets + (entry->hash & table->mask);
+  GT_UNUSED bool linked;
+  entry->next = *bucket;
+  /* the full barrier publishes the initialized entry to lock-free readers */
+  linked = gt_atomic_compare_and_swap(bucket, entry->next, entry);
+  gt_assert(linked); /* inserts are serialized */
+}
 
 void gt_symbol_init(void)
 {
-  if (!symbols)
-    symbols = gt_cstr_table_new();
-  if (!symbol_mutex)
-    symbol_mutex = gt_mutex_new();
+  unsigned int i;
+  if (symbol_shards)
+    return;
+  symbol_shards = gt_malloc(GT_SYMBOL_NOF_SHARDS * sizeof (GtSymbolShard));
+  for (i = 0; i < GT_SYMBOL_NOF_SHARDS; i++) {
+    symbol_shards[i].table = symbol_table_new(GT_SYMBOL_INITIAL_BUCKETS);
+    symbol_shards[i].nof_symbols = 0;
+    symbol_shards[i].mutex = gt_mutex_new();
+  }
+}
+
+static const char* symbol_find(const GtSymbolTable *table, const char *cstr,
+                               uint32_t hash)
+{
+  const GtSymbolEntry *entry;
+  for (entry = table->buckets[hash & table->mask]; entry; entry = entry->next) {
+    if (entry->hash == hash && !strcmp(entry->symbol, cstr))
+      return entry->symbol;
+  }
+  return NULL;
+}
+
+/* Replaces the table of <shard> by one with twice as many buckets. */
+static void symbol_shard_grow(GtSymbolShard *shard)
+{
+  GtSymbolTable *old_table = shard->table, *new_table;
+  GT_UNUSED bool published;
+  GtUword i;
+  new_table = symbol_table_new(2 * (old_table->mask + 1));
+  for (i = 0; i <= old_table->mask; i++) {
+    const GtSymbolEntry *entry;
+    for (entry = old_table->buckets[i]; entry; entry = entry->next) {
+      GtSymbolEntry *new_entry = gt_malloc(sizeof (GtSymbolEntry));
+      new_entry->hash = entry->hash;
+      new_entry->symbol = entry->symbol;
+      symbol_table_add(new_table, new_entry);
+    }
+  }
+  new_table->retired = old_table;
+  published = gt_atomic_compare_and_swap(&shard->table, old_table, new_table);
+  gt_assert(published);
 }
 
 const char* gt_symbol(const char *cstr)
 {
+  GtSymbolShard *shard;
   const char *symbol;
+  uint32_t hash;
   if (!cstr)
     return NULL;
-  gt_mutex_lock(symbol_mutex);
-  if (!(symbol = gt_cstr_table_get(symbols, cstr))) {
-    gt_cstr_table_add(symbols, cstr);
-    symbol = gt_cstr_table_get(symbols, cstr);
+  gt_assert(symbol_shards);
+  hash = gt_ht_cstr_elem_hash(&cstr);
+  /* use the well mixed high bits of the product for the shard */
+  shard = symbol_shards + ((hash * 2654435761U) >> (32 - GT_SYMBOL_SHARD_BITS));
+  if ((symbol = symbol_find(shard->table, cstr, hash)))
+    return symbol;
+  gt_mutex_lock(shard->mutex);
+  /* another thread may have added it in the meantime */
+  if (!(symbol = symbol_find(shard->table, cstr, hash))) {
+    GtSymbolEntry *entry;
+    if (shard->nof_symbols > shard->table->mask)
+      symbol_shard_grow(shard);
+    entry = gt_malloc(sizeof (GtSymbolEntry));
+    entry->hash = hash;
+    entry->symbol = gt_cstr_dup(cstr);
+    symbol_table_add(shard->table, entry);
+    shard->nof_symbols++;
+    symbol = entry->symbol;
   }
-  gt_mutex_unlock(symbol_mutex);
+  gt_mutex_unlock(shard->mutex);
   return symbol;
 }
 
 void gt_symbol_clean(void)
 {
-  gt_cstr_table_delete(symbols);
-  gt_mutex_delete(symbol_mutex);
+  unsigned int i;
+  if (!symbol_shards)
+    return;
+  for (i = 0; i < GT_SYMBOL_NOF_SHARDS; i++) {
+    GtSymbolTable *table = symbol_shards[i].table;
+    bool current = true;
+    while (table) {
+      GtSymbolTable *retired = table->retired;
+      GtUword j;
+      for (j = 0; j <= table->mask; j++) {
+        GtSymbolEntry *entry = table->buckets[j];
+        while (entry) {
+          GtSymbolEntry *next = entry->next;
+          /* the symbols are shared by all tables of the shard */
+          if (current)
+            gt_free(entry->symbol);
+          gt_free(entry);
+          entry = next;
+        }
+      }
+      gt_free(table->buckets);
+      gt_free(table);
+      table = retired;
+      current = false;
+    }
+    gt_mutex_delete(symbol_shards[i].mutex);
+  }
+  gt_free(symbol_shards);
+  symbol_shards = NULL;
 }
 
 /* we use randomly generated numbers to test the symbol mechanism */
 #define NUMBER_OF_SYMBOLS 10000
-#define MAX_SYMBOL        1000
+#define MAX_SYMBOL        20000
 
-static void* test_symbol(GT_UNUSED void *data)
+static void* test_symbol(void *data)
 {
+  const char **first = data;
   GtStr *symbol;
   GtUword i;
   symbol = gt_str_new();
   for (i = 0; i < NUMBER_OF_SYMBOLS; i++) {
+    GtUword num = gt_rand_max(MAX_SYMBOL - 1);
+    const char *sym;
     gt_str_reset(symbol);
-    gt_str_append_uword(symbol, gt_rand_max(MAX_SYMBOL));
-    gt_symbol(gt_str_get(symbol));
-    gt_assert(!strcmp(gt_symbol(gt_str_get(symbol)), gt_str_get(symbol)));
+    gt_str_append_cstr(symbol, "symbol test ");
+    gt_str_append_uword(symbol, num);
+    sym = gt_symbol(gt_str_get(symbol));
+    gt_assert(!strcmp(sym, gt_str_get(symbol)));
+    gt_assert(gt_symbol(gt_str_get(symbol)) == sym);
+    /* all threads must get the same symbol for equal strings */
+    if (!gt_atomic_compare_and_swap(first + num, NULL, sym))
+      gt_assert(first[num] == sym);
   }
   gt_str_delete(symbol);
   return NULL;
@@ -74,6 +215,11 @@ static void* test_symbol(GT_UNUSED void *data)
 
 int gt_symbol_unit_test(GtError *err)
 {
+  const char **first;
+  int had_err;
   gt_error_check(err);
-  return gt_multithread(test_symbol, NULL, err);
+  first = gt_calloc(MAX_SYMBOL, sizeof (const char*));
+  had_err = gt_multithread(test_symbol, first, err);
+  gt_free(first);
+  return had_err;
 }
@@ -30,6 +30,9 @@ typedef struct GtThread GtThread;
 typedef struct GtRWLock GtRWLock;
 /* The <GtMutex> class represents a simple mutex structure. */
 typedef struct GtMutex GtMutex;
+/* The <GtCond> class represents a condition variable which can be used
+   together with a <GtMutex> to wait for a condition to become true. */
+typedef struct GtCond GtCond;
 
 /* A function to be multithreaded. */
 typedef void* (*GtThreadFunc)(void *data);
@@ -108,4 +111,43 @@ void      gt_mutex_unlock_func(GtMutex *mutex);
           ((void) 0)
 #endif
 
+/* Return a new <GtCond*> object. */
+GtCond*   gt_cond_new(void);
+
+/* Delete the given <cond>. */
+void      gt_cond_delete(GtCond *cond);
+
+#ifdef GT_THREADS_ENABLED
+/* Atomically unlock <mutex> (which must be locked by the calling thread) and
+   wait for <cond> to be signaled. <mutex> is locked again before returning.
+   Spurious wakeups are possible, so always call this in a loop which checks
+   the condition waited for. */
+#define   gt_cond_wait(cond, mutex) \
+          gt_cond_wait_func(cond, mutex)
+void      gt_cond_wait_func(GtCond *cond, GtMutex *mutex);
+#else
+#define   gt_cond_wait(cond, mutex) \
+          ((void) 0)
+#endif
+
+#ifdef GT_THREADS_ENABLED
+/* Wake up at least one thread waiting on <cond>. */
+#define   gt_cond_signal(cond) \
+          gt_cond_signal_func(cond)
+void      gt_cond_signal_func(GtCond *cond);
+#else
+#define   gt_cond_signal(cond) \
+          ((void) 0)
+#endif
+
+#ifdef GT_THREADS_ENABLED
+/* Wake up all threads waiting on <cond>. */
+#define   gt_cond_broadcast(cond) \
+          gt_cond_broadcast_func(cond)
+void      gt_cond_broadcast_func(GtCond *cond);
+#else
+#define   gt_cond_broadcast(cond) \
+          ((void) 0)
+#endif
+
 #endif
@@ -0,0 +1,619 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/ensure.h"
+#include "core/ma.h"
+#include "core/thread_pool.h"
+#include "core/unused_api.h"
+
+#ifdef GT_THREADS_ENABLED
+#include <pthread.h>
+#endif
+
+typedef struct {
+  GtThreadFunc function;
+  void *data;
+  GtTaskGroup *group;
+} GtThreadPoolTask;
+
+struct GtTaskGroup {
+  GtThreadPool *pool;
+  GtUword pending; /* protected by the mutex of the pool */
+};
+
+#ifdef GT_THREADS_ENABLED
+
+#define GT_THREAD_POOL_DEQUE_INITSIZE 64
+
+/* A circular buffer of tasks, the owner works at the bottom (the end), thieves
+   take from the top (the beginning). */
+typedef struct {
+  GtMutex *mutex;
+  GtThreadPoolTask *tasks;
+  GtUword allocated,
+          top,
+          numoftasks;
+} GtThreadPoolDeque;
+
+typedef struct {
+  GtThreadPool *pool;
+  unsigned int idx;
+} GtThreadPoolWorker;
+
+struct GtThreadPool {
+  unsigned int num_workers,
+               num_started;
+  /* <num_workers> + 1 deques, the last one is shared by all threads which are
+     not workers of the pool */
+  GtThreadPoolDeque *deques;
+  GtThreadPoolWorker *workers;
+  GtThread **threads;
+  GtMutex *mutex;   /* protects the counters below and the pending counters of
+                       the task groups */
+  GtCond *changed;  /* signaled when a task was added or a group finished */
+  GtUword num_queued,
+          active_groups;
+  bool shutdown;
+};
+
+static pthread_key_t thread_pool_worker_key;
+static GtMutex *thread_pool_global_mutex = NULL;
+static GtThreadPool *thread_pool_global = NULL;
+
+static void thread_pool_deque_init(GtThreadPoolDeque *deque)
+{
+  deque->mutex = gt_mutex_new();
+  deque->allocated = GT_THREAD_POOL_DEQUE_INITSIZE;
+  deque->tasks = gt_malloc(sizeof *deque->tasks * deque->allocated);
+  deque->top = 0;
+  deque->numoftasks = 0;
+}
+
+static void thread_pool_deque_clean(GtThreadPoolDeque *deque)
+{
+  gt_assert(deque->numoftasks == 0);
+  gt_mutex_delete(deque->mutex);
+  gt_free(deque->tasks);
+}
+
+static void thread_pool_deque_push(GtThreadPoolDeque *deque,
+                                   const GtThreadPoolTask *task)
+{
+  gt_mutex_lock(deque->mutex);
+  if (deque->numoftasks == deque->allocated) {
+    GtUword idx, newsize = 2 * deque->allocated;
+    GtThreadPoolTask *tasks = gt_malloc(sizeof *tasks * newsize);
+
+    for (idx = 0; idx < deque->numoftasks; idx++)
+      tasks[idx] = deque->tasks[(deque->top + idx) % deque->allocated];
+    gt_free(deque->tasks);
+    deque->tasks = tasks;
+    deque->allocated = newsize;
+    deque->top = 0;
+  }
+  deque->tasks[(deque->top + deque->numoftasks) % deque->allocated] = *task;
+  deque->numoftasks++;
+  gt_mutex_unlock(deque->mutex);
+}
+
+static bool thread_pool_deque_pop_bottom(GtThreadPoolDeque *deque,
+                                         GtThreadPoolTask *task)
+{
+  bool found = false;
+
+  gt_mutex_lock(deque->mutex);
+  if (deque->numoftasks > 0) {
+    deque->numoftasks--;
+    *task = deque->tasks[(deque->top + deque->numoftasks) % deque->allocated];
+    found = true;
+  }
+  gt_mutex_unlock(deque->mutex);
+  return found;
+}
+
+static bool thread_pool_deque_steal_top(GtThreadPoolDeque *deque,
+                                        GtThreadPoolTask *task)
+{
+  bool found = false;
+
+  gt_mutex_lock(deque->mutex);
+  if (deque->numoftasks > 0) {
+    *task = deque->tasks[deque->top];
+    deque->top = (deque->top + 1) % deque->allocated;
+    deque->numoftasks--;
+    found = true;
+  }
+  gt_mutex_unlock(deque->mutex);
+  return found;
+}
+
+/* Returns the index of the deque of the calling thread in <pool>. */
+static unsigned int thread_pool_own_deque(const GtThreadPool *pool)
+{
+  const GtThreadPoolWorker *worker
+    = pthread_getspecific(thread_pool_worker_key);
+
+  if (worker != NULL && worker->pool == pool)
+    return worker->idx;
+  return pool->num_workers;
+}
+
+/* Take a task from the own deque of the calling thread or steal one from the
+   other deques, starting with the neighbour. */
+static bool thread_pool_take(GtThreadPool *pool, unsigned int own,
+                             GtThreadPoolTask *task)
+{
+  unsigned int idx;
+  bool found = thread_pool_deque_pop_bottom(pool->deques + own, task);
+
+  for (idx = 1; !found && idx <= pool->num_workers; idx++) {
+    found = thread_pool_deque_steal_top(pool->deques +
+                                        (own + idx) % (pool->num_workers + 1),
+                                        task);
+  }
+  if (found) {
+    gt_mutex_lock(pool->mutex);
+    gt_assert(pool->num_queued > 0);
+    pool->num_queued--;
+    gt_mutex_unlock(pool->mutex);
+  }
+  return found;
+}
+
+static void thread_pool_run(GtThreadPool *pool, const GtThreadPoolTask *task)
+{
+  (void) task->function(task->data);
+  gt_mutex_lock(pool->mutex);
+  gt_assert(task->group->pending > 0);
+  if (--task->group->pending == 0)
+    gt_cond_broadcast(pool->changed);
+  gt_mutex_unlock(pool->mutex);
+}
+
+static void* thread_pool_worker_thread(void *data)
+{
+  GtThreadPoolWorker *worker = data;
+  GtThreadPool *pool = worker->pool;
+  GtThreadPoolTask task;
+
+  (void) pthread_setspecific(thread_pool_worker_key, worker);
+  while (true) {
+    if (thread_pool_take(pool, worker->idx, &task)) {
+      thread_pool_run(pool, &task);
+      continue;
+    }
+    gt_mutex_lock(pool->mutex);
+    while (pool->num_queued == 0 && !pool->shutdown)
+      gt_cond_wait(pool->changed, pool->mutex);
+    if (pool->num_queued == 0 && pool->shutdown) {
+      gt_mutex_unlock(pool->mutex);
+      break;
+    }
+    gt_mutex_unlock(pool->mutex);
+  }
+  return NULL;
+}
+
+void gt_thread_pool_init(void)
+{
+  GT_UNUSED int rval;
+
+  rval = pthread_key_create(&thread_pool_worker_key, NULL);
+  gt_assert(rval == 0);
+  thread_pool_global_mutex = gt_mutex_new();
+}
+
+void gt_thread_pool_clean(void)
+{
+  if (thread_pool_global_mutex == NULL)
+    return;
+  gt_thread_pool_delete(thread_pool_global);
+  thread_pool_global = NULL;
+  gt_mutex_delete(thread_pool_global_mutex);
+  thread_pool_global_mutex = NULL;
+  (void) pthread_key_delete(thread_pool_worker_key);
+}
+
+GtThreadPool* gt_thread_pool_new(unsigned int num_workers, GtError *err)
+{
+  GtThreadPool *pool;
+  unsigned int idx;
+
+  gt_error_check(err);
+  pool = gt_malloc(sizeof *pool);
+  pool->num_workers = num_workers;
+  pool->num_started = 0;
+  pool->deques = gt_malloc(sizeof *pool->deques * (num_workers + 1));
+  for (idx = 0; idx <= num_workers; idx++)
+    thread_pool_deque_init(pool->deques + idx);
+  pool->workers = gt_malloc(sizeof *pool->workers * (num_workers + 1));
+  pool->threads = gt_malloc(sizeof *pool->threads * (num_workers + 1));
+  pool->mutex = gt_mutex_new();
+  pool->changed = gt_cond_new();
+  pool->num_queued = 0;
+  pool->active_groups = 0;
+  pool->shutdown = false;
+  for (idx = 0; idx < num_workers; idx++) {
+    pool->workers[idx].pool = pool;
+    pool->workers[idx].idx = idx;
+    pool->threads[idx] = gt_thread_new(thread_pool_worker_thread,
+                                       pool->workers + idx, err);
+    if (pool->threads[idx] == NULL) {
+      gt_thread_pool_delete(pool);
+      return NULL;
+    }
+    pool->num_started++;
+  }
+  return pool;
+}
+
+unsigned int gt_thread_pool_num_workers(const GtThreadPool *pool)
+{
+  gt_assert(pool);
+  return pool->num_workers;
+}
+
+void gt_thread_pool_delete(GtThreadPool *pool)
+{
+  unsigned int idx;
+
+  if (!pool) return;
+  gt_mutex_lock(pool->mutex);
+  gt_assert(pool->active_groups == 0 && pool->num_queued == 0);
+  pool->shutdown = true;
+  gt_cond_broadcast(pool->changed);
+  gt_mutex_unlock(pool->mutex);
+  for (idx = 0; idx < pool->num_started; idx++) {
+    gt_thread_join(pool->threads[idx]);
+    gt_thread_delete(pool->threads[idx]);
+  }
+  for (idx = 0; idx <= pool->num_workers; idx++)
+    thread_pool_deque_clean(pool->deques + idx);
+  gt_free(pool->deques);
+  gt_free(pool->threads);
+  gt_free(pool->workers);
+  gt_mutex_delete(pool->mutex);
+  gt_cond_delete(pool->changed);
+  gt_free(pool);
+}
+
+GtThreadPool* gt_thread_pool_get(void)
+{
+  GtThreadPool *pool;
+  unsigned int num_workers = gt_jobs > 1U ? gt_jobs - 1 : 0;
+
+  gt_assert(thread_pool_global_mutex != NULL);
+  gt_mutex_lock(thread_pool_global_mutex);
+  /* the pool is never replaced, as other threads may still use it without
+     having created a task group yet */
+  if (thread_pool_global == NULL) {
+    GtError *err = gt_error_new();
+
+    /* fall back to fewer workers if threads cannot be created */
+    while ((thread_pool_global = gt_thread_pool_new(num_workers, err))
+           == NULL) {
+      gt_assert(num_workers > 0);
+      num_workers--;
+      gt_error_unset(err);
+    }
+    gt_error_delete(err);
+  }
+  pool = thread_pool_global;
+  gt_mutex_unlock(thread_pool_global_mutex);
+  return pool;
+}
+
+GtTaskGroup* gt_task_group_new(GtThreadPool *pool)
+{
+  GtTaskGroup *group;
+
+  gt_assert(pool);
+  group = gt_malloc(sizeof *group);
+  group->pool = pool;
+  group->pending = 0;
+  gt_mutex_lock(pool->mutex);
+  pool->active_groups++;
+  gt_mutex_unlock(pool->mutex);
+  return group;
+}
+
+void gt_task_group_submit(GtTaskGroup *group, GtThreadFunc function,
+                          void *data)
+{
+  GtThreadPool *pool;
+  GtThreadPoolTask task;
+
+  gt_assert(group && function);
+  pool = group->pool;
+  task.function = function;
+  task.data = data;
+  task.group = group;
+  /* count the task before it becomes visible, so that a thief never sees
+     more tasks than counted */
+  gt_mutex_lock(pool->mutex);
+  group->pending++;
+  pool->num_queued++;
+  gt_mutex_unlock(pool->mutex);
+  thread_pool_deque_push(pool->deques + thread_pool_own_deque(pool), &task);
+  gt_mutex_lock(pool->mutex);
+  gt_cond_signal(pool->changed);
+  gt_mutex_unlock(pool->mutex);
+}
+
+void gt_task_group_join(GtTaskGroup *group)
+{
+  GtThreadPool *pool;
+  GtThreadPoolTask task;
+  unsigned int own;
+
+  gt_assert(group);
+  pool = group->pool;
+  own = thread_pool_own_deque(pool);
+  while (true) {
+    bool finished;
+
+    gt_mutex_lock(pool->mutex);
+    finished = group->pending == 0;
+    gt_mutex_unlock(pool->mutex);
+    if (finished)
+      break;
+    if (thread_pool_take(pool, own, &task)) {
+      thread_pool_run(pool, &task);
+    } else {
+      gt_mutex_lock(pool->mutex);
+      while (group->pending > 0 && pool->num_queued == 0)
+        gt_cond_wait(pool->changed, pool->mutex);
+      gt_mutex_unlock(pool->mutex);
+    }
+  }
+}
+
+void gt_task_group_delete(GtTaskGroup *group)
+{
+  if (!group) return;
+  gt_mutex_lock(group->pool->mutex);
+  gt_assert(group->pending == 0 && group->pool->active_groups > 0);
+  group->pool->active_groups--;
+  gt_mutex_unlock(group->pool->mutex);
+  gt_free(group);
+}
+
+#else
+
+struct GtThreadPool {
+  unsigned int num_workers;
+};
+
+static GtThreadPool thread_pool_global = {0};
+
+void gt_thread_pool_init(void)
+{
+  return;
+}
+
+void gt_thread_pool_clean(void)
+{
+  return;
+}
+
+GtThreadPool* gt_thread_pool_get(void)
+{
+  return &thread_pool_global;
+}
+
+GtThreadPool* gt_thread_pool_new(GT_UNUSED unsigned int num_workers,
+                                 GT_UNUSED GtError *err)
+{
+  GtThreadPool *pool;
+
+  gt_error_check(err);
+  pool = gt_malloc(sizeof *pool);
+  pool->num_workers = 0;
+  return pool;
+}
+
+unsigned int gt_thread_pool_num_workers(const GtThreadPool *pool)
+{
+  gt_assert(pool);
+  return pool->num_workers;
+}
+
+void gt_thread_pool_delete(GtThreadPool *pool)
+{
+  if (!pool || pool == &thread_pool_global) return;
+  gt_free(pool);
+}
+
+GtTaskGroup* gt_task_group_new(GtThreadPool *pool)
+{
+  GtTaskGroup *group;
+
+  gt_assert(pool);
+  group = gt_malloc(sizeof *group);
+  group->pool = pool;
+  group->pending = 0;
+  return group;
+}
+
+void gt_task_group_submit(GtTaskGroup *group, GtThreadFunc function,
+                          void *data)
+{
+  gt_assert(group && function);
+  (void) function(data);
+}
+
+void gt_task_group_join(GT_UNUSED GtTaskGroup *group)
+{
+  gt_assert(group);
+}
+
+void gt_task_group_delete(GtTaskGroup *group)
+{
+  if (!group) return;
+  gt_free(group);
+}
+
+#endif
+
+typedef struct {
+  GtTaskGroup *group;
+  GtUword grainsize;
+  GtThreadPoolForFunc function;
+  void *data;
+} GtThreadPoolForInfo;
+
+typedef struct {
+  const GtThreadPoolForInfo *info;
+  GtUword start,
+          end;
+} GtThreadPoolForRange;
+
+static void* thread_pool_for_task(void *data)
+{
+  GtThreadPoolForRange *range = data;
+  const GtThreadPoolForInfo *info = range->info;
+
+  /* hand the upper halves to other workers and continue with the lower
+     half, so the largest pieces are at the top of the deque */
+  while (range->end - range->start > info->grainsize) {
+    GtThreadPoolForRange *upper = gt_malloc(sizeof *upper);
+
+    upper->info = info;
+    upper->start = range->start + (range->end - range->start) / 2;
+    upper->end = range->end;
+    range->end = upper->start;
+    gt_task_group_submit(info->group, thread_pool_for_task, upper);
+  }
+  info->function(range->start, range->end, info->data);
+  gt_free(range);
+  return NULL;
+}
+
+void gt_thread_pool_parallel_for(GtThreadPool *pool,
+                                 GtUword start,
+                                 GtUword end,
+                                 GtUword grainsize,
+                                 GtThreadPoolForFunc function,
+                                 void *data)
+{
+  GtThreadPoolForInfo info;
+  GtThreadPoolForRange *range;
+
+  gt_assert(pool && function && grainsize > 0);
+  if (start >= end)
+    return;
+  if (end - start <= grainsize) {
+    function(start, end, data);
+    return;
+  }
+  info.group = gt_task_group_new(pool);
+  info.grainsize = grainsize;
+  info.function = function;
+  info.data = data;
+  range = gt_malloc(sizeof *range);
+  range->info = &info;
+  range->start = start;
+  range->end = end;
+  (void) thread_pool_for_task(range);
+  gt_task_group_join(info.group);
+  gt_task_group_delete(info.group);
+}
+
+static void thread_pool_test_mark(GtUword start, GtUword end, void *data)
+{
+  unsigned int *marks = data;
+  GtUword idx;
+
+  for (idx = start; idx < end; idx++)
+    marks[idx]++;
+}
+
+typedef struct {
+  GtThreadPool *pool;
+  GtUword n,
+          result;
+} GtThreadPoolTestFib;
+
+/* computes the Fibonacci numbers recursively with nested task groups */
+static void* thread_pool_test_fib(void *data)
+{
+  GtThreadPoolTestFib *fib = data;
+
+  if (fib->n < 2) {
+    fib->result = fib->n;
+  } else {
+    GtTaskGroup *group = gt_task_group_new(fib->pool);
+    GtThreadPoolTestFib left, right;
+
+    left.pool = right.pool = fib->pool;
+    left.n = fib->n - 1;
+    right.n = fib->n - 2;
+    gt_task_group_submit(group, thread_pool_test_fib, &left);
+    (void) thread_pool_test_fib(&right);
+    gt_task_group_join(group);
+    gt_task_group_delete(group);
+    fib->result = left.result + right.result;
+  }
+  return NULL;
+}
+
+static int thread_pool_test(GtThreadPool *pool, GtError *err)
+{
+  const GtUword numofmarks = 10007UL;
+  unsigned int *marks;
+  GtUword idx, grainsize;
+  GtThreadPoolTestFib fib;
+  int had_err = 0;
+
+  gt_error_check(err);
+  marks = gt_calloc((size_t) numofmarks, sizeof *marks);
+  for (grainsize = 1UL; !had_err && grainsize <= 2 * numofmarks;
+       grainsize *= 7) {
+    gt_thread_pool_parallel_for(pool, 0, numofmarks, grainsize,
+                                thread_pool_test_mark, marks);
+    for (idx = 0; !had_err && idx < numofmarks; idx++) {
+      gt_ensure(marks[idx] == 1U);
+      marks[idx] = 0;
+    }
+  }
+  gt_free(marks);
+  if (!had_err) {
+    fib.pool = pool;
+    fib.n = 18UL;
+    (void) thread_pool_test_fib(&fib);
+    gt_ensure(fib.result == 2584UL);
+  }
+  return had_err;
+}
+
+int gt_thread_pool_unit_test(GtError *err)
+{
+  GtThreadPool *pool;
+  unsigned int num_workers;
+  int had_err = 0;
+
+  gt_error_check(err);
+  for (num_workers = 0; !had_err && num_workers <= 3U; num_workers += 3U) {
+    if (!(pool = gt_thread_pool_new(num_workers, err)))
+      had_err = -1;
+    if (!had_err)
+      had_err = thread_pool_test(pool, err);
+    gt_thread_pool_delete(pool);
+  }
+  if (!had_err)
+    had_err = thread_pool_test(gt_thread_pool_get(), err);
+  return had_err;
+}
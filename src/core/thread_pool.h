@@ -0,0 +1,83 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include "core/error_api.h"
+#include "core/thread_api.h"
+#include "core/types_api.h"
+
+/* A <GtThreadPool> is a persistent set of worker threads executing tasks.
+   Every worker owns a deque of tasks: tasks submitted by a worker are pushed
+   to and taken from the bottom of its own deque, idle workers steal tasks from
+   the top of the deques of the others. Threads which are not workers of the
+   pool (e.g., the main thread) submit to an additional shared deque and help
+   executing tasks while waiting for a <GtTaskGroup>. Without threading
+   support, tasks are executed immediately when submitted. */
+typedef struct GtThreadPool GtThreadPool;
+
+/* A <GtTaskGroup> collects tasks submitted to a <GtThreadPool> which can be
+   waited for together. */
+typedef struct GtTaskGroup GtTaskGroup;
+
+/* A function processing the index range [<start>,<end>) of a parallel
+   loop, see <gt_thread_pool_parallel_for()>. */
+typedef void (*GtThreadPoolForFunc)(GtUword start, GtUword end, void *data);
+
+void          gt_thread_pool_init(void);
+void          gt_thread_pool_clean(void);
+
+/* Return the global thread pool with <gt_jobs> - 1 workers (the thread
+   waiting for a task group being the remaining one). The pool is created on
+   first use, with fewer workers if not all threads can be created, and kept
+   until <gt_thread_pool_clean()>. Later changes of <gt_jobs> do not affect
+   it. */
+GtThreadPool* gt_thread_pool_get(void);
+
+/* Return a new <GtThreadPool> with <num_workers> worker threads. Returns NULL
+   and sets <err> if a thread could not be created. */
+GtThreadPool* gt_thread_pool_new(unsigned int num_workers, GtError *err);
+unsigned int  gt_thread_pool_num_workers(const GtThreadPool *pool);
+/* Stop the workers of <pool>, all task groups must have been joined. */
+void          gt_thread_pool_delete(GtThreadPool *pool);
+
+/* Execute <function> for all subranges of [<start>,<end>) of at most
+   <grainsize> (> 0) indices in parallel, with <data> passed to it. The range
+   is split recursively, so that idle workers steal the largest remaining
+   subranges. Returns when all subranges have been processed. */
+void          gt_thread_pool_parallel_for(GtThreadPool *pool,
+                                          GtUword start,
+                                          GtUword end,
+                                          GtUword grainsize,
+                                          GtThreadPoolForFunc function,
+                                          void *data);
+
+/* Return a new <GtTaskGroup> for tasks executed by <pool>. */
+GtTaskGroup*  gt_task_group_new(GtThreadPool *pool);
+/* Submit <function> (with <data> passed to it) as a task of <group>. The
+   return value of <function> is ignored. */
+void          gt_task_group_submit(GtTaskGroup *group, GtThreadFunc function,
+                                   void *data);
+/* Wait until all tasks submitted to <group> are finished, executing pending
+   tasks of the pool in the meantime. */
+void          gt_task_group_join(GtTaskGroup *group);
+/* Delete <group>, which must have been joined. */
+void          gt_task_group_delete(GtTaskGroup *group);
+
+int           gt_thread_pool_unit_test(GtError *err);
+
+#endif
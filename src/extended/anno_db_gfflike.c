@@ -33,6 +33,7 @@
 #include "core/unused_api.h"
 #include "core/fa.h"
 #include "core/unused_api.h"
+#include "core/warning_api.h"
 #include "core/xansi_api.h"
 #include "core/xposix.h"
 #include "extended/anno_db_gfflike_api.h"
@@ -49,11 +50,18 @@
 #include "extended/rdb_api.h"
 #include "extended/rdb_sqlite_api.h"
 #include "extended/rdb_visitor_rep.h"
+#include "extended/region_node_api.h"
+
+/* number of features inserted into a SQLite database before the running
+   bulk loading transaction is committed */
+#define GT_ANNO_DB_GFFLIKE_BATCH_SIZE  50000
 
 struct GtAnnoDBGFFlike {
   const GtAnnoDBSchema parent_instance;
   GtRDB *db;
   GtRDBVisitor *visitor;
+  bool use_rtree,
+       defer_indexes;
 };
 
 typedef struct {
@@ -77,7 +85,12 @@ typedef struct {
   GtFeatureNodeObserver *obs;
   GtRDB *db;
   GtMutex *dblock;
-  bool transaction_lock;
+  bool transaction_lock,
+       use_rtree,
+       indexes_pending,
+       in_bulk_transaction;
+  GtUword nof_bulk_inserts,
+          first_unindexed_id;
 } GtFeatureIndexGFFlike;
 
 const GtAnnoDBSchemaClass* gt_anno_db_gfflike_class(void);
@@ -218,6 +231,75 @@ static int anno_db_gfflike_create_tables_sqlite(GtRDBSqlite *db, GtError *err)
   return 0;
 }
 
+/* The R*Tree holds the sequence region and the range of each feature and
+   answers range queries without scanning all features on a sequence region.
+   Features already present in an existing database are indexed right away. */
+static int anno_db_gfflike_create_rtree_sqlite(GtRDBSqlite *db, GtError *err)
+{
+  int had_err = 0;
+  GtRDBStmt *stmt;
+  gt_assert(db);
+
+  stmt = gt_rdb_prepare((GtRDB*) db,
+                           "CREATE VIRTUAL TABLE IF NOT EXISTS features_rtree "
+                           "USING rtree(id, seqid_min, seqid_max, "
+                                       "range_start, range_end)",
+                           0,
+                           err);
+  if (!stmt || (had_err = gt_rdb_stmt_exec(stmt, err)) < 0) {
+    gt_rdb_stmt_delete(stmt);
+    return -1;
+  } else gt_rdb_stmt_delete(stmt);
+  stmt = gt_rdb_prepare((GtRDB*) db,
+                           "INSERT INTO features_rtree "
+                           "SELECT id, seqid, seqid, start, end FROM features",
+                           0,
+                           err);
+  if (!stmt || (had_err = gt_rdb_stmt_exec(stmt, err)) < 0) {
+    gt_rdb_stmt_delete(stmt);
+    return -1;
+  } else gt_rdb_stmt_delete(stmt);
+  return 0;
+}
+
+/* Returns true if <query> can be run on <db>, errors are discarded. */
+static bool anno_db_gfflike_probe_sqlite(GtRDBSqlite *db, const char *query)
+{
+  GtRDBStmt *stmt;
+  bool success;
+  gt_assert(db && query);
+  stmt = gt_rdb_prepare((GtRDB*) db, query, 0, NULL);
+  success = (stmt != NULL && gt_rdb_stmt_exec(stmt, NULL) >= 0);
+  gt_rdb_stmt_delete(stmt);
+  return success;
+}
+
+/* Checks whether the R*Tree can be used on <db>: an existing R*Tree needs the
+   rtree module of SQLite, creating one also needs write access to the
+   database. Otherwise range queries fall back to the B-tree indexes. */
+static bool anno_db_gfflike_rtree_usable_sqlite(GtRDBSqlite *db,
+                                                bool has_rtree)
+{
+  bool writable;
+  gt_assert(db);
+  if (has_rtree)
+    return anno_db_gfflike_probe_sqlite(db, "SELECT id FROM features_rtree "
+                                            "LIMIT 1");
+  /* the temporary table does not touch the database file */
+  if (!anno_db_gfflike_probe_sqlite(db, "CREATE VIRTUAL TABLE "
+                                        "temp.gt_rtree_probe "
+                                        "USING rtree(id, lo, hi)"))
+    return false;
+  (void) anno_db_gfflike_probe_sqlite(db, "DROP TABLE temp.gt_rtree_probe");
+  /* fails with SQLITE_READONLY if the database file cannot be written */
+  if (!anno_db_gfflike_probe_sqlite(db, "BEGIN TRANSACTION"))
+    return false;
+  writable = anno_db_gfflike_probe_sqlite(db, "CREATE TABLE gt_write_probe "
+                                              "(id INTEGER)");
+  (void) anno_db_gfflike_probe_sqlite(db, "ROLLBACK TRANSACTION");
+  return writable;
+}
+
 static int anno_db_gfflike_create_indexes_sqlite(GtRDBSqlite *db, GtError *err)
 {
   int had_err = 0;
@@ -546,14 +628,19 @@ static int anno_db_gfflike_create_indexes_mysql(GtRDBMySQL *db, GtError *err)
   return 0;
 }
 
-int anno_db_gfflike_init_sqlite(GT_UNUSED GtRDBVisitor *rdbv, GtRDBSqlite *db,
+int anno_db_gfflike_init_sqlite(GtRDBVisitor *rdbv, GtRDBSqlite *db,
                                 GtError *err)
 {
+  GFFlikeSetupVisitor *sv;
   GtCstrTable *cst = NULL;
   GtStrArray *arr = NULL;
-  bool check = true;
+  bool check = true,
+       new_db = false,
+       has_rtree = false,
+       use_rtree = false;
   int had_err = 0;
-  gt_assert(db);
+  gt_assert(rdbv && db);
+  sv = gfflike_setup_visitor_cast(rdbv);
 
   cst = gt_rdb_get_tables((GtRDB*) db, err);
   if (!cst) {
@@ -565,8 +652,10 @@ int anno_db_gfflike_init_sqlite(GT_UNUSED GtRDBVisitor *rdbv, GtRDBSqlite *db,
       had_err = -1;
   }
   if (!had_err) {
+    has_rtree = (gt_cstr_table_get(cst, "features_rtree") != NULL);
     if (gt_str_array_size(arr) == 0) {
       had_err = anno_db_gfflike_create_tables_sqlite(db, err);
+      new_db = true;
     }
   }
   gt_cstr_table_delete(cst);
@@ -578,9 +667,20 @@ int anno_db_gfflike_init_sqlite(GT_UNUSED GtRDBVisitor *rdbv, GtRDBSqlite *db,
                       "tables are missing");
     had_err = -1;
   }
-  if (!had_err) {
+  if (!had_err)
+    use_rtree = anno_db_gfflike_rtree_usable_sqlite(db, has_rtree);
+  if (!had_err && use_rtree && !has_rtree) {
+    had_err = anno_db_gfflike_create_rtree_sqlite(db, err);
+  }
+  /* a new database is usually bulk loaded right away, so create the indexes
+     after the data is in place instead of maintaining them during loading */
+  if (!had_err && (!new_db || !use_rtree)) {
     had_err = anno_db_gfflike_create_indexes_sqlite(db, err);
   }
+  if (!had_err) {
+    sv->annodb->use_rtree = use_rtree;
+    sv->annodb->defer_indexes = new_db && use_rtree;
+  }
 
   return had_err;
 }
@@ -768,6 +868,73 @@ static int set_parents(void *key, void *value, void *data,
   return had_err;
 }
 
+/* The following functions implement bulk loading into SQLite databases:
+   features are inserted in batched transactions without updating the R*Tree,
+   which is filled in one go (together with creating deferred indexes) before
+   the next query. They must be called with <fi->dblock> held. */
+static int feature_index_gfflike_bulk_begin(GtFeatureIndexGFFlike *fi,
+                                            GtError *err)
+{
+  gt_assert(fi && fi->use_rtree);
+  if (fi->in_bulk_transaction)
+    return 0;
+  gt_rdb_stmt_reset(fi->stmts[GT_PSTMT_BULK_BEGIN], err);
+  if (gt_rdb_stmt_exec(fi->stmts[GT_PSTMT_BULK_BEGIN], err) < 0)
+    return -1;
+  fi->in_bulk_transaction = true;
+  return 0;
+}
+
+static int feature_index_gfflike_bulk_commit(GtFeatureIndexGFFlike *fi,
+                                             GtError *err)
+{
+  gt_assert(fi && fi->use_rtree);
+  if (!fi->in_bulk_transaction)
+    return 0;
+  fi->in_bulk_transaction = false;
+  gt_rdb_stmt_reset(fi->stmts[GT_PSTMT_BULK_COMMIT], err);
+  return gt_rdb_stmt_exec(fi->stmts[GT_PSTMT_BULK_COMMIT], err) < 0 ? -1 : 0;
+}
+
+static int feature_index_gfflike_bulk_finish(GtFeatureIndexGFFlike *fi,
+                                             GtError *err)
+{
+  GtUword i;
+  int had_err = 0;
+  gt_assert(fi);
+  if (!fi->use_rtree)
+    return 0;
+  if (fi->first_unindexed_id == GT_UNDEF_UWORD && !fi->indexes_pending)
+    return feature_index_gfflike_bulk_commit(fi, err);
+
+  /* do not keep read statements pending while changing the schema */
+  for (i = 0; i < GT_PSTMT_NOF_STATEMENTS; i++) {
+    if (fi->stmts[i])
+      (void) gt_rdb_stmt_reset(fi->stmts[i], NULL);
+  }
+  had_err = feature_index_gfflike_bulk_begin(fi, err);
+  if (!had_err && fi->first_unindexed_id != GT_UNDEF_UWORD) {
+    gt_rdb_stmt_bind_ulong(fi->stmts[GT_PSTMT_RTREE_FILL], 0,
+                           fi->first_unindexed_id, err);
+    if (gt_rdb_stmt_exec(fi->stmts[GT_PSTMT_RTREE_FILL], err) < 0)
+      had_err = -1;
+    else
+      fi->first_unindexed_id = GT_UNDEF_UWORD;
+  }
+  if (!had_err && fi->indexes_pending) {
+    had_err = anno_db_gfflike_create_indexes_sqlite((GtRDBSqlite*) fi->db,
+                                                    err);
+    if (!had_err)
+      fi->indexes_pending = false;
+  }
+  /* commit what has been loaded in any case, but keep the first error */
+  if (feature_index_gfflike_bulk_commit(fi, had_err ? NULL : err))
+    had_err = -1;
+  fi->nof_bulk_inserts = 0;
+  return had_err;
+}
+
+/* The insertion functions must be called with <fi->dblock> held. */
 static int insert_single_node(GtFeatureIndexGFFlike *fi,
                               GtUword *id,
                               GtFeatureNode *fn,
@@ -791,7 +958,8 @@ static int insert_single_node(GtFeatureIndexGFFlike *fi,
     return had_err;
   }
 
-  gt_mutex_lock(fi->dblock);
+  if (fi->use_rtree && feature_index_gfflike_bulk_begin(fi, err))
+    return -1;
 
   /* insert details */
   if (!gt_feature_node_is_pseudo(fn)) {
@@ -863,6 +1031,9 @@ static int insert_single_node(GtFeatureIndexGFFlike *fi,
   if (rval < 0) gt_error_check(err);
 
   *id = gt_rdb_last_inserted_id(fi->db, "features", err);
+  /* the R*Tree entry is added when the bulk load is finished */
+  if (fi->use_rtree && fi->first_unindexed_id == GT_UNDEF_UWORD)
+    fi->first_unindexed_id = *id;
   /* cache DB keys to avoid redundant saving of nodes with
      multiple parents */
   node_ul_gt_hashmap_add(fi->cache_node2id, fn, *id);
@@ -884,7 +1055,10 @@ static int insert_single_node(GtFeatureIndexGFFlike *fi,
       had_err = -1;
   }
   gt_str_array_delete(attribs);
-  gt_mutex_unlock(fi->dblock);
+  if (!had_err && fi->use_rtree
+        && ++fi->nof_bulk_inserts % GT_ANNO_DB_GFFLIKE_BATCH_SIZE == 0) {
+    had_err = feature_index_gfflike_bulk_commit(fi, err);
+  }
   return had_err;
 }
 
@@ -1013,6 +1187,20 @@ static void node_strand_changed_callback(GtFeatureNode *changed,
   }
 }
 
+static int add_feature_node(GtFeatureIndexGFFlike *fi, GtFeatureNode *gf,
+                            GtError *err)
+{
+  int had_err = 0;
+  gt_assert(fi && gf);
+  had_err = insert_feature_node(fi,
+                                (GtFeatureNode*)
+                                         gt_genome_node_ref((GtGenomeNode*) gf),
+                                err);
+  if (!had_err)
+    gt_hashmap_add(fi->ref_nodes, gf, (void*) 1);
+  return had_err;
+}
+
 int gt_feature_index_gfflike_add_feature_node(GtFeatureIndex *gfi,
                                               GtFeatureNode *gf,
                                               GtError *err)
@@ -1022,12 +1210,9 @@ int gt_feature_index_gfflike_add_feature_node(GtFeatureIndex *gfi,
   gt_assert(gfi && gf);
 
   fi = feature_index_gfflike_cast(gfi);
-  had_err = insert_feature_node(fi,
-                                (GtFeatureNode*)
-                                         gt_genome_node_ref((GtGenomeNode*) gf),
-                                err);
-  if (!had_err)
-    gt_hashmap_add(fi->ref_nodes, gf, (void*) 1);
+  gt_mutex_lock(fi->dblock);
+  had_err = add_feature_node(fi, gf, err);
+  gt_mutex_unlock(fi->dblock);
   return had_err;
 }
 
@@ -1066,6 +1251,13 @@ static int remove_node_by_id(GtFeatureIndexGFFlike *fis, GtUword id,
           had_err = gt_rdb_stmt_exec(fis->stmts[GT_PSTMT_NODE_DELETE_FEATURE],
                                      err);
         }
+        if (had_err >= 0 && fis->use_rtree) {
+          gt_rdb_stmt_reset(fis->stmts[GT_PSTMT_NODE_DELETE_RTREE], err);
+          gt_rdb_stmt_bind_int(fis->stmts[GT_PSTMT_NODE_DELETE_RTREE],
+                               0, id, err);
+          had_err = gt_rdb_stmt_exec(fis->stmts[GT_PSTMT_NODE_DELETE_RTREE],
+                                     err);
+        }
         if (had_err >= 0) {
           gt_rdb_stmt_reset(fis->stmts[GT_PSTMT_NODE_DELETE_ATTRIB_FOR_NODE],
                             err);
@@ -1142,8 +1334,9 @@ static int gt_feature_index_gfflike_save_add(void *key, GT_UNUSED void *val,
   ObserverCallbackInfo *oci = (ObserverCallbackInfo*) data;
   int had_err = 0;
 
-  had_err = gt_feature_index_add_feature_node((GtFeatureIndex*) oci->fis, fn,
-                                              err);
+  /* called from gt_feature_index_gfflike_save(), which holds the locks of
+     the feature index and of the database already */
+  had_err = add_feature_node(oci->fis, fn, err);
 
   return had_err;
 }
@@ -1237,6 +1430,7 @@ static int gt_feature_index_gfflike_save_chg(void *key, GT_UNUSED void *val,
                                 err);
       }
     }
+    gt_feature_node_iterator_delete(fni);
   }
 
   return (had_err >= 0) ? 0  : -1;
@@ -1254,6 +1448,10 @@ static int gt_feature_index_gfflike_save(GtFeatureIndex *fi,
   oci = (ObserverCallbackInfo*) fig->obs->data;
 
   gt_mutex_lock(fig->dblock);
+  if (feature_index_gfflike_bulk_finish(fig, err)) {
+    gt_mutex_unlock(fig->dblock);
+    return -1;
+  }
   stmt_b = gt_rdb_prepare(fig->db, "BEGIN TRANSACTION;", 0, err);
   stmt_e = gt_rdb_prepare(fig->db, "END TRANSACTION;", 0, err);
   gt_rdb_stmt_exec(stmt_b, err);
@@ -1265,16 +1463,24 @@ static int gt_feature_index_gfflike_save(GtFeatureIndex *fi,
   gt_hashmap_reset(fig->deleted);
   gt_rdb_stmt_exec(stmt_e, err);
 
-  gt_rdb_stmt_reset(stmt_b, err);
-  gt_rdb_stmt_exec(stmt_b, err);
+  /* with the R*Tree, added features are inserted in the bulk loading
+     transaction, which also adds them to the R*Tree when it is finished */
+  if (!fig->use_rtree) {
+    gt_rdb_stmt_reset(stmt_b, err);
+    gt_rdb_stmt_exec(stmt_b, err);
+  }
   if (oci && fig->added) {
     had_err = gt_hashmap_foreach(fig->added,
                                  gt_feature_index_gfflike_save_add,
                                  oci, err);
   }
   gt_hashmap_reset(fig->added);
-  gt_rdb_stmt_reset(stmt_e, err);
-  gt_rdb_stmt_exec(stmt_e, err);
+  if (!fig->use_rtree) {
+    gt_rdb_stmt_reset(stmt_e, err);
+    gt_rdb_stmt_exec(stmt_e, err);
+  } else if (feature_index_gfflike_bulk_finish(fig, had_err ? NULL : err)) {
+    had_err = -1;
+  }
 
   gt_rdb_stmt_reset(stmt_b, err);
   gt_rdb_stmt_exec(stmt_b, err);
@@ -1289,7 +1495,7 @@ static int gt_feature_index_gfflike_save(GtFeatureIndex *fi,
 
   gt_rdb_stmt_delete(stmt_e);
   gt_rdb_stmt_delete(stmt_b);
-  gt_mutex_lock(fig->dblock);
+  gt_mutex_unlock(fig->dblock);
 
   return had_err;
 }
@@ -1315,7 +1521,8 @@ static int get_nodes_for_stmt(GtFeatureIndexGFFlike *fi,
     gt_ht_ptr_elem_cmp,
     NULL,
     NULL };
-  GtHashtable *seen_as_children = gt_hashtable_new(node_hashtype);
+  GtHashtable *seen_as_children = gt_hashtable_new(node_hashtype),
+              *created = gt_hashtable_new(node_hashtype);
 
   while (!had_err && gt_rdb_stmt_exec(stmt, err) == 0) {
     GtUword id = GT_UNDEF_UWORD, multi_rep = GT_UNDEF_UWORD, *idp;
@@ -1361,6 +1568,7 @@ static int get_nodes_for_stmt(GtFeatureIndexGFFlike *fi,
 
       /* cache node */
       ul_node_gt_hashmap_add(fi->cache_id2node, id, newfn);
+      gt_hashtable_add(created, &newfn);
       if (!(idp = node_ul_gt_hashmap_get(fi->cache_node2id, newfn)))
       {
         node_ul_gt_hashmap_add(fi->cache_node2id, newfn, id);
@@ -1386,11 +1594,13 @@ static int get_nodes_for_stmt(GtFeatureIndexGFFlike *fi,
         if (multi_rep == 0UL) {
           gt_feature_node_make_multi_representative(newfn);
         } else {
-          GtFeatureNode *rep;
-          rep = *(GtFeatureNode**) ul_node_gt_hashmap_get(fi->cache_id2node,
-                                                          multi_rep);
-          gt_assert(rep);
-          gt_feature_node_set_multi_representative(newfn, rep);
+          GtFeatureNode **rep;
+          rep = ul_node_gt_hashmap_get(fi->cache_id2node, multi_rep);
+          /* the representative may lie outside of a queried range */
+          if (rep)
+            gt_feature_node_set_multi_representative(newfn, *rep);
+          else
+            gt_feature_node_make_multi_representative(newfn);
         }
       }
       gt_array_add(nodes, id);
@@ -1418,6 +1628,9 @@ static int get_nodes_for_stmt(GtFeatureIndexGFFlike *fi,
       parent = *(GtFeatureNode**) ul_node_gt_hashmap_get(fi->cache_id2node,
                                                        par_id);
       gt_assert(parent);
+      /* nodes handed out by an earlier query are linked already */
+      if (!gt_hashtable_get(created, &newfn))
+        continue;
       /* if a child has multiple parents, increase refcount */
       if (gt_hashtable_get(seen_as_children, &newfn)) {
         gt_genome_node_ref((GtGenomeNode*) newfn);
@@ -1438,6 +1651,7 @@ static int get_nodes_for_stmt(GtFeatureIndexGFFlike *fi,
   }
   gt_array_delete(nodes);
   gt_hashtable_delete(seen_as_children);
+  gt_hashtable_delete(created);
   return had_err;
 }
 
@@ -1445,17 +1659,21 @@ GtArray* gt_feature_index_gfflike_get_features_for_seqid(GtFeatureIndex *gfi,
                                                          const char *seqid,
                                                          GtError *err)
 {
-  GtArray *a;
+  GtArray *a = NULL;
   GtFeatureIndexGFFlike *fi;
   GtRDBStmt *stmt;
   gt_assert(gfi && seqid);
   gt_error_check(err);
   fi = feature_index_gfflike_cast(gfi);
   stmt = fi->stmts[GT_PSTMT_GET_BY_SEQID_SELECT];
-  a = gt_array_new(sizeof (GtFeatureNode*));
-  gt_rdb_stmt_reset(stmt, err);
-  gt_rdb_stmt_bind_string(stmt, 0, seqid, err);
-  get_nodes_for_stmt(fi, a, stmt, err);
+  gt_mutex_lock(fi->dblock);
+  if (!feature_index_gfflike_bulk_finish(fi, err)) {
+    a = gt_array_new(sizeof (GtFeatureNode*));
+    gt_rdb_stmt_reset(stmt, err);
+    gt_rdb_stmt_bind_string(stmt, 0, seqid, err);
+    get_nodes_for_stmt(fi, a, stmt, err);
+  }
+  gt_mutex_unlock(fi->dblock);
   return a;
 }
 
@@ -1474,6 +1692,10 @@ int gt_feature_index_gfflike_get_features_for_range(GtFeatureIndex *gfi,
   fi = feature_index_gfflike_cast(gfi);
   stmt = fi->stmts[GT_PSTMT_GET_RANGE_SELECT];
   gt_mutex_lock(fi->dblock);
+  if (feature_index_gfflike_bulk_finish(fi, err)) {
+    gt_mutex_unlock(fi->dblock);
+    return -1;
+  }
   gt_rdb_stmt_reset(stmt, err);
   gt_rdb_stmt_bind_string(stmt, 0, seqid, err);
   gt_rdb_stmt_bind_ulong(stmt, 1, qry_range->end, err);
@@ -1650,6 +1872,14 @@ void gt_feature_index_gfflike_delete(GtFeatureIndex *gfi)
   GtUword i;
   if (!gfi) return;
   fi = feature_index_gfflike_cast(gfi);
+  if (fi->use_rtree) {
+    GtError *err = gt_error_new();
+    if (feature_index_gfflike_bulk_finish(fi, err)) {
+      gt_warning("could not finish loading the feature index: %s",
+                 gt_error_get(err));
+    }
+    gt_error_delete(err);
+  }
   for (i=0;i<GT_PSTMT_NOF_STATEMENTS;i++) {
     gt_rdb_stmt_delete(fi->stmts[i]);
   }
@@ -1770,7 +2000,33 @@ static int prepstmt_init(GtFeatureIndexGFFlike *fis, GtError *err)
                          3,
                          err);
   if (!r) return -1;
-  r = fis->stmts[GT_PSTMT_GET_RANGE_SELECT] = gt_rdb_prepare(fis->db,
+  if (fis->use_rtree) {
+    /* the CROSS JOINs make SQLite look up the candidates in the R*Tree instead
+       of scanning all features on the sequence region, the R*Tree stores
+       rounded coordinates so the range is checked again on the features */
+    r = fis->stmts[GT_PSTMT_GET_RANGE_SELECT] = gt_rdb_prepare(fis->db,
+                        "SELECT f.id, s.sequenceregion_name, src.source_name, "
+                        "       t.type_name, f.start, f.end, f.score, "
+                        "       f.strand, f.phase, f.is_multi, "
+                        "       f.multi_representative "
+                        "FROM sequenceregions s "
+                        "     CROSS JOIN features_rtree r "
+                        "     CROSS JOIN features f, "
+                        "     sources src, types t "
+                        "WHERE s.sequenceregion_name = ?1 "
+                        "AND r.seqid_min <= s.sequenceregion_id "
+                        "AND r.seqid_max >= s.sequenceregion_id "
+                        "AND (r.range_start <= ?2 AND r.range_end >= ?3) "
+                        "AND f.id = r.id "
+                        "AND s.sequenceregion_id = f.seqid "
+                        "AND (f.start <= ?2 AND f.end >= ?3) "
+                        "AND src.source_id = f.source "
+                        "AND t.type_id = f.type "
+                        "ORDER BY f.id ASC",
+                         3,
+                         err);
+  } else {
+    r = fis->stmts[GT_PSTMT_GET_RANGE_SELECT] = gt_rdb_prepare(fis->db,
                         "SELECT f.id, s.sequenceregion_name, src.source_name, "
                         "       t.type_name, f.start, f.end, f.score, "
                         "       f.strand, f.phase, f.is_multi, "
@@ -1785,6 +2041,7 @@ static int prepstmt_init(GtFeatureIndexGFFlike *fis, GtError *err)
                         "ORDER BY f.id ASC",
                          3,
                          err);
+  }
   if (!r) return -1;
   r = fis->stmts[GT_PSTMT_GET_ALL] = gt_rdb_prepare(fis->db,
                         "SELECT f.id, s.sequenceregion_name, src.source_name, "
@@ -1920,6 +2177,31 @@ static int prepstmt_init(GtFeatureIndexGFFlike *fis, GtError *err)
                          2,
                          err);
   if (!r) return -1;
+  if (fis->use_rtree) {
+    r = fis->stmts[GT_PSTMT_NODE_DELETE_RTREE] = gt_rdb_prepare(fis->db,
+                        "DELETE FROM features_rtree "
+                        "WHERE id = ? ",
+                         1,
+                         err);
+    if (!r) return -1;
+    r = fis->stmts[GT_PSTMT_RTREE_FILL] = gt_rdb_prepare(fis->db,
+                        "INSERT INTO features_rtree "
+                        "SELECT id, seqid, seqid, start, end FROM features "
+                        "WHERE id >= ?",
+                         1,
+                         err);
+    if (!r) return -1;
+    r = fis->stmts[GT_PSTMT_BULK_BEGIN] = gt_rdb_prepare(fis->db,
+                        "BEGIN TRANSACTION",
+                         0,
+                         err);
+    if (!r) return -1;
+    r = fis->stmts[GT_PSTMT_BULK_COMMIT] = gt_rdb_prepare(fis->db,
+                        "COMMIT TRANSACTION",
+                         0,
+                         err);
+    if (!r) return -1;
+  }
   return 0;
 }
 
@@ -1941,6 +2223,7 @@ GtFeatureIndex* anno_db_gfflike_build(GtAnnoDBSchema *schema, GtRDB *db,
   gt_error_check(err);
 
   adg = anno_db_gfflike_cast(schema);
+  adg->use_rtree = adg->defer_indexes = false;
   had_err = gt_rdb_accept(db, adg->visitor, err);
 
   if (!had_err) {
@@ -1978,8 +2261,12 @@ GtFeatureIndex* anno_db_gfflike_build(GtAnnoDBSchema *schema, GtRDB *db,
     fis->obs->attribute_deleted = node_attribute_delete_callback;
     fis->obs->child_added = node_child_add_callback;
     fis->db = gt_rdb_ref(db);
+    fis->use_rtree = adg->use_rtree;
+    fis->indexes_pending = adg->defer_indexes;
+    fis->first_unindexed_id = GT_UNDEF_UWORD;
 
     if (prepstmt_init(fis, err)) {
+      fis->use_rtree = false;
       gt_feature_index_delete(fi);
       fi = NULL;
     }
@@ -2005,7 +2292,7 @@ static const GtRDBVisitorClass* gfflike_setup_visitor_class()
   static const GtRDBVisitorClass *svc = NULL;
   gt_class_alloc_lock_enter();
   if (!svc) {
-    svc = gt_rdb_visitor_class_new(sizeof (GtAnnoDBGFFlike),
+    svc = gt_rdb_visitor_class_new(sizeof (GFFlikeSetupVisitor),
                                    NULL,
                                    anno_db_gfflike_init_sqlite,
                                    anno_db_gfflike_init_mysql);
@@ -2040,6 +2327,11 @@ int gt_anno_db_gfflike_unit_test(GtError *err)
   FILE *tmpfp;
 #ifdef HAVE_SQLITE
   GtRDB *rdb;
+  GtGenomeNode *gn;
+  GtArray *results;
+  GtRange rng;
+  GtStr *seqid;
+  GtUword i, nof_exons = 0;
 #endif
   GtStr* tmpfilename;
   gt_error_check(err);
@@ -2070,6 +2362,62 @@ int gt_anno_db_gfflike_unit_test(GtError *err)
     gt_ensure(status == 0);
   }
 
+#ifdef HAVE_SQLITE
+  /* a child added to an indexed feature is written by the next save */
+  seqid = gt_str_new_cstr("savetest");
+  gn = gt_region_node_new(seqid, 1, 1000);
+  if (!had_err) {
+    status = gt_feature_index_add_region_node(fi, (GtRegionNode*) gn, testerr);
+    gt_ensure(status == 0);
+  }
+  gt_genome_node_delete(gn);
+  gn = gt_feature_node_new(seqid, "gene", 100, 900, GT_STRAND_FORWARD);
+  if (!had_err) {
+    status = gt_feature_index_add_feature_node(fi, (GtFeatureNode*) gn,
+                                               testerr);
+    gt_ensure(status == 0);
+  }
+  if (!had_err) {
+    gt_feature_node_add_child((GtFeatureNode*) gn,
+                              (GtFeatureNode*)
+                              gt_feature_node_new(seqid, "exon", 200, 300,
+                                                  GT_STRAND_FORWARD));
+    status = gt_feature_index_save(fi, testerr);
+    gt_ensure(status == 0);
+  }
+  gt_genome_node_delete(gn);
+  gt_str_delete(seqid);
+
+  /* a new index on the same database reads the exon from the file */
+  if (!had_err) {
+    gt_feature_index_delete(fi);
+    fi = gt_anno_db_schema_get_feature_index(adb, rdb, testerr);
+    gt_ensure(fi != NULL);
+  }
+  if (!had_err) {
+    results = gt_array_new(sizeof (GtFeatureNode*));
+    rng.start = 250;
+    rng.end = 260;
+    status = gt_feature_index_get_features_for_range(fi, results, "savetest",
+                                                     &rng, testerr);
+    gt_ensure(status == 0);
+    for (i = 0; i < gt_array_size(results); i++) {
+      GtFeatureNodeIterator *fni;
+      GtFeatureNode *fn;
+      fni = gt_feature_node_iterator_new(*(GtFeatureNode**)
+                                         gt_array_get(results, i));
+      while ((fn = gt_feature_node_iterator_next(fni))) {
+        if (strcmp(gt_feature_node_get_type(fn), "exon") == 0)
+          nof_exons++;
+      }
+      gt_feature_node_iterator_delete(fni);
+      gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(results, i));
+    }
+    gt_ensure(nof_exons == 1);
+    gt_array_delete(results);
+  }
+#endif
+
   gt_xremove(gt_str_get(tmpfilename));
   gt_str_delete(tmpfilename);
   gt_feature_index_delete(fi);
@@ -51,6 +51,10 @@ enum GtAnnoDBPreparedStmt {
   GT_PSTMT_NODE_DELETE_ATTRIB,
   GT_PSTMT_NODE_DELETE_ATTRIB_FOR_NODE,
   GT_PSTMT_NODE_ADD_CHILD,
+  GT_PSTMT_NODE_DELETE_RTREE,
+  GT_PSTMT_RTREE_FILL,
+  GT_PSTMT_BULK_BEGIN,
+  GT_PSTMT_BULK_COMMIT,
   GT_PSTMT_NOF_STATEMENTS
 };
 
@@ -0,0 +1,822 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/array.h"
+#include "core/class_alloc_lock.h"
+#include "core/cstr_api.h"
+#include "core/ensure.h"
+#include "core/fa.h"
+#include "core/interval_index.h"
+#include "core/ma.h"
+#include "core/mathsupport.h"
+#include "core/multithread_api.h"
+#include "core/thread_api.h"
+#include "core/undef_api.h"
+#include "core/unused_api.h"
+#include "core/xansi_api.h"
+#include "extended/feature_index_mapped.h"
+#include "extended/feature_index_memory_api.h"
+#include "extended/feature_index_rep.h"
+#include "extended/feature_node.h"
+#include "extended/genome_node.h"
+#include "extended/genome_node_serializer.h"
+
+#define GT_FEATURE_INDEX_MAPPED_MAGIC     "GTFIDX01"
+#define GT_FEATURE_INDEX_MAPPED_MAGICLEN  8
+
+/* The file starts with the header, followed by the regions (sorted by
+   sequence ID), the columns of feature start positions, end positions,
+   maximal end positions in the implicit interval tree and offsets of the
+   serialized feature node graphs, each grouped by region and sorted by
+   start position within a region, and the pool of sequence ID strings. The
+   serialized feature node graphs follow at the end of the file. */
+typedef struct {
+  char magic[GT_FEATURE_INDEX_MAPPED_MAGICLEN];
+  GtUword wordsize,
+          nof_regions,
+          nof_features,
+          first_region,
+          strpool_size;
+} GtFeatureIndexMappedHeader;
+
+typedef struct {
+  GtUword seqid_offset,
+          first_feature,
+          nof_features,
+          max_level,
+          range_start,
+          range_end,
+          orig_range_start,
+          orig_range_end,
+          has_orig_range;
+} GtFeatureIndexMappedRegion;
+
+struct GtFeatureIndexMapped {
+  const GtFeatureIndex parent_instance;
+  void *map;
+  const GtFeatureIndexMappedHeader *header;
+  const GtFeatureIndexMappedRegion *regions;
+  const GtUword *starts,
+                *ends,
+                *maxends,
+                *offsets;
+  const char *strpool;
+  FILE *fp;
+  GtGenomeNodeSerializer *serializer;
+  /* the feature node graphs read so far, by feature number */
+  GtGenomeNode **nodes;
+  /* guards <fp>, <serializer> and <nodes> against concurrent queries */
+  GtMutex *node_lock;
+};
+
+#define gt_feature_index_mapped_cast(FI)\
+        gt_feature_index_cast(gt_feature_index_mapped_class(), FI)
+
+static int feature_index_mapped_cmp_seqid(const void *a, const void *b)
+{
+  return strcmp(*(const char**) a, *(const char**) b);
+}
+
+int gt_feature_index_mapped_write(GtFeatureIndex *feature_index,
+                                  const char *filename, GtError *err)
+{
+  GtFeatureIndexMappedHeader header;
+  GtFeatureIndexMappedRegion *regions = NULL;
+  GtStrArray *seqids;
+  GtArray **features = NULL;
+  const char **names = NULL;
+  char *first_seqid = NULL;
+  GtUword i, j, *starts = NULL, *ends = NULL, *maxends = NULL,
+          *offsets = NULL;
+  GtGenomeNodeSerializer *serializer = NULL;
+  FILE *fp = NULL;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(feature_index && filename);
+
+  if (!(seqids = gt_feature_index_get_seqids(feature_index, err)))
+    return -1;
+  memset(&header, 0, sizeof header);
+  memcpy(header.magic, GT_FEATURE_INDEX_MAPPED_MAGIC,
+         (size_t) GT_FEATURE_INDEX_MAPPED_MAGICLEN);
+  header.wordsize = (GtUword) sizeof (GtUword);
+  header.nof_regions = gt_str_array_size(seqids);
+  header.first_region = GT_UNDEF_UWORD;
+  names = gt_malloc(sizeof (*names) * (header.nof_regions + 1));
+  for (i = 0; i < header.nof_regions; i++)
+    names[i] = gt_str_array_get(seqids, i);
+  qsort(names, (size_t) header.nof_regions, sizeof (*names),
+        feature_index_mapped_cmp_seqid);
+  regions = gt_calloc((size_t) header.nof_regions + 1, sizeof (*regions));
+  features = gt_calloc((size_t) header.nof_regions + 1, sizeof (*features));
+  if (header.nof_regions > 0)
+    first_seqid = gt_feature_index_get_first_seqid(feature_index, err);
+
+  /* collect the features and ranges of all regions */
+  for (i = 0; !had_err && i < header.nof_regions; i++) {
+    GtFeatureIndexMappedRegion *region = regions + i;
+    GtRange range;
+
+    if (first_seqid && strcmp(first_seqid, names[i]) == 0)
+      header.first_region = i;
+    features[i] = gt_feature_index_get_features_for_seqid(feature_index,
+                                                          names[i], err);
+    if (!features[i]) {
+      had_err = -1;
+      break;
+    }
+    gt_genome_nodes_sort(features[i]);
+    region->seqid_offset = header.strpool_size;
+    header.strpool_size += strlen(names[i]) + 1;
+    region->first_feature = header.nof_features;
+    region->nof_features = gt_array_size(features[i]);
+    header.nof_features += region->nof_features;
+    range.start = range.end = GT_UNDEF_UWORD;
+    had_err = gt_feature_index_get_range_for_seqid(feature_index, &range,
+                                                   names[i], err);
+    region->range_start = range.start;
+    region->range_end = range.end;
+    range.start = range.end = GT_UNDEF_UWORD;
+    if (!had_err)
+      had_err = gt_feature_index_get_orig_range_for_seqid(feature_index,
+                                                          &range, names[i],
+                                                          err);
+    region->has_orig_range = range.start != GT_UNDEF_UWORD ? 1UL : 0;
+    region->orig_range_start = range.start;
+    region->orig_range_end = range.end;
+  }
+
+  /* write the serialized feature node graphs behind the columns, recording
+     their offsets */
+  if (!had_err) {
+    fp = gt_fa_fopen(filename, "wb", err);
+    if (!fp)
+      had_err = -1;
+  }
+  if (!had_err) {
+    const GtUword nof_columns = 4UL;
+    GtWord payload_offset = (GtWord) (sizeof header
+                                      + sizeof (*regions) * header.nof_regions
+                                      + sizeof (GtUword) * nof_columns
+                                        * header.nof_features
+                                      + header.strpool_size);
+
+    starts = gt_malloc(sizeof (*starts) * (header.nof_features + 1));
+    ends = gt_malloc(sizeof (*ends) * (header.nof_features + 1));
+    maxends = gt_malloc(sizeof (*maxends) * (header.nof_features + 1));
+    offsets = gt_malloc(sizeof (*offsets) * (header.nof_features + 1));
+    gt_xfseek(fp, payload_offset, SEEK_SET);
+    serializer = gt_genome_node_serializer_new(fp);
+    for (i = 0; !had_err && i < header.nof_regions; i++) {
+      GtFeatureIndexMappedRegion *region = regions + i;
+
+      for (j = 0; !had_err && j < region->nof_features; j++) {
+        GtGenomeNode *gn = *(GtGenomeNode**) gt_array_get(features[i], j);
+        GtRange range = gt_genome_node_get_range(gn);
+        const GtUword idx = region->first_feature + j;
+
+        starts[idx] = range.start;
+        ends[idx] = range.end;
+        offsets[idx] = (GtUword) ftello(fp);
+        had_err = gt_genome_node_serializer_write(serializer, gn, err);
+      }
+      region->max_level
+        = gt_interval_index_augment(ends + region->first_feature,
+                                     maxends + region->first_feature,
+                                     region->nof_features);
+    }
+  }
+  if (!had_err) {
+    gt_xfseek(fp, 0, SEEK_SET);
+    gt_xfwrite_one(&header, fp);
+    gt_xfwrite(regions, sizeof (*regions), (size_t) header.nof_regions, fp);
+    gt_xfwrite(starts, sizeof (*starts), (size_t) header.nof_features, fp);
+    gt_xfwrite(ends, sizeof (*ends), (size_t) header.nof_features, fp);
+    gt_xfwrite(maxends, sizeof (*maxends), (size_t) header.nof_features, fp);
+    gt_xfwrite(offsets, sizeof (*offsets), (size_t) header.nof_features, fp);
+    for (i = 0; i < header.nof_regions; i++)
+      gt_xfwrite(names[i], sizeof (char), strlen(names[i]) + 1, fp);
+  }
+
+  gt_genome_node_serializer_delete(serializer);
+  gt_fa_fclose(fp);
+  for (i = 0; i < header.nof_regions; i++)
+    gt_array_delete(features[i]);
+  gt_free(features);
+  gt_free(regions);
+  gt_free(names);
+  gt_free(first_seqid);
+  gt_free(starts);
+  gt_free(ends);
+  gt_free(maxends);
+  gt_free(offsets);
+  gt_str_array_delete(seqids);
+  return had_err;
+}
+
+static const GtFeatureIndexMappedRegion*
+feature_index_mapped_get_region(const GtFeatureIndexMapped *fim,
+                                const char *seqid)
+{
+  GtUword left = 0, right = fim->header->nof_regions;
+
+  while (left < right) {
+    const GtUword mid = left + (right - left) / 2;
+    const int cmp = strcmp(seqid, fim->strpool
+                                  + fim->regions[mid].seqid_offset);
+    if (cmp == 0)
+      return fim->regions + mid;
+    if (cmp < 0)
+      right = mid;
+    else
+      left = mid + 1;
+  }
+  return NULL;
+}
+
+static const GtFeatureIndexMappedRegion*
+feature_index_mapped_get_region_with_err(const GtFeatureIndexMapped *fim,
+                                         const char *seqid, GtError *err)
+{
+  const GtFeatureIndexMappedRegion *region;
+
+  if (!(region = feature_index_mapped_get_region(fim, seqid)))
+    gt_error_set(err, "feature index does not contain the given sequence id");
+  return region;
+}
+
+/* Returns the feature node graph with number <idx>, which is read from the
+   file on first access. */
+static GtGenomeNode* feature_index_mapped_get_node(GtFeatureIndexMapped *fim,
+                                                   GtUword idx, GtError *err)
+{
+  GtGenomeNode *gn;
+
+  gt_mutex_lock(fim->node_lock);
+  if (!(gn = fim->nodes[idx])) {
+    gt_xfseek(fim->fp, (GtWord) fim->offsets[idx], SEEK_SET);
+    if (gt_genome_node_serializer_read(fim->serializer, &gn, err))
+      gn = NULL;
+    else if (!gn)
+      gt_error_set(err, "feature index file is truncated");
+    else
+      fim->nodes[idx] = gn;
+  }
+  gt_mutex_unlock(fim->node_lock);
+  return gn;
+}
+
+static int feature_index_mapped_read_only(GT_UNUSED GtFeatureIndex *gfi,
+                                          GT_UNUSED void *node, GtError *err)
+{
+  gt_error_set(err, "cannot change a memory mapped feature index");
+  return -1;
+}
+
+static int gt_feature_index_mapped_add_region_node(GtFeatureIndex *gfi,
+                                                   GtRegionNode *rn,
+                                                   GtError *err)
+{
+  return feature_index_mapped_read_only(gfi, rn, err);
+}
+
+static int gt_feature_index_mapped_add_feature_node(GtFeatureIndex *gfi,
+                                                    GtFeatureNode *fn,
+                                                    GtError *err)
+{
+  return feature_index_mapped_read_only(gfi, fn, err);
+}
+
+static int gt_feature_index_mapped_remove_node(GtFeatureIndex *gfi,
+                                               GtFeatureNode *fn,
+                                               GtError *err)
+{
+  return feature_index_mapped_read_only(gfi, fn, err);
+}
+
+static GtArray* gt_feature_index_mapped_get_features_for_seqid(GtFeatureIndex
+                                                                 *gfi,
+                                                               const char
+                                                                 *seqid,
+                                                               GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  const GtFeatureIndexMappedRegion *region;
+  GtArray *a;
+  GtUword idx;
+  gt_assert(gfi && seqid);
+
+  fim = gt_feature_index_mapped_cast(gfi);
+  a = gt_array_new(sizeof (GtFeatureNode*));
+  if ((region = feature_index_mapped_get_region(fim, seqid))) {
+    for (idx = region->first_feature;
+         idx < region->first_feature + region->nof_features; idx++) {
+      GtGenomeNode *gn = feature_index_mapped_get_node(fim, idx, err);
+      if (!gn) {
+        gt_array_delete(a);
+        return NULL;
+      }
+      gt_array_add(a, gn);
+    }
+  }
+  return a;
+}
+
+typedef struct {
+  GtFeatureIndexMapped *fim;
+  const GtFeatureIndexMappedRegion *region;
+  GtArray *results;
+} GtFeatureIndexMappedOverlapInfo;
+
+static int feature_index_mapped_collect(GtUword idx, void *data, GtError *err)
+{
+  GtFeatureIndexMappedOverlapInfo *info = data;
+  GtGenomeNode *gn;
+
+  if (!(gn = feature_index_mapped_get_node(info->fim,
+                                           info->region->first_feature + idx,
+                                           err)))
+    return -1;
+  gt_array_add(info->results, gn);
+  return 0;
+}
+
+static int gt_feature_index_mapped_get_features_for_range(GtFeatureIndex *gfi,
+                                                          GtArray *results,
+                                                          const char *seqid,
+                                                          const GtRange
+                                                            *qry_range,
+                                                          GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  const GtFeatureIndexMappedRegion *region;
+  GtFeatureIndexMappedOverlapInfo info;
+  GtUword matches;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(gfi && results && qry_range);
+
+  fim = gt_feature_index_mapped_cast(gfi);
+  if (!(region = feature_index_mapped_get_region_with_err(fim, seqid, err)))
+    return -1;
+  matches = gt_array_size(results);
+  info.fim = fim;
+  info.region = region;
+  info.results = results;
+  had_err = gt_interval_index_overlap(fim->starts + region->first_feature,
+                                      fim->ends + region->first_feature,
+                                      fim->maxends + region->first_feature,
+                                      region->nof_features, region->max_level,
+                                      qry_range->start, qry_range->end,
+                                      feature_index_mapped_collect, &info,
+                                      err);
+  if (!had_err && gt_array_size(results) > matches + 1) {
+    qsort((GtGenomeNode**) gt_array_get_space(results) + matches,
+          (size_t) (gt_array_size(results) - matches), sizeof (GtGenomeNode*),
+          (GtCompare) gt_genome_node_compare);
+  }
+  return had_err;
+}
+
+static char* gt_feature_index_mapped_get_first_seqid(const GtFeatureIndex *gfi,
+                                                     GT_UNUSED GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  gt_assert(gfi);
+
+  fim = gt_feature_index_mapped_cast((GtFeatureIndex*) gfi);
+  if (fim->header->first_region == GT_UNDEF_UWORD)
+    return NULL;
+  return gt_cstr_dup(fim->strpool
+                     + fim->regions[fim->header->first_region].seqid_offset);
+}
+
+static GtStrArray* gt_feature_index_mapped_get_seqids(const GtFeatureIndex
+                                                        *gfi,
+                                                      GT_UNUSED GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  GtStrArray *seqids;
+  GtUword i;
+  gt_assert(gfi);
+
+  fim = gt_feature_index_mapped_cast((GtFeatureIndex*) gfi);
+  seqids = gt_str_array_new();
+  for (i = 0; i < fim->header->nof_regions; i++)
+    gt_str_array_add_cstr(seqids, fim->strpool + fim->regions[i].seqid_offset);
+  return seqids;
+}
+
+static int gt_feature_index_mapped_get_range_for_seqid(GtFeatureIndex *gfi,
+                                                       GtRange *range,
+                                                       const char *seqid,
+                                                       GtError *err)
+{
+  const GtFeatureIndexMappedRegion *region;
+  gt_assert(gfi && range && seqid);
+
+  region = feature_index_mapped_get_region_with_err(
+                                          gt_feature_index_mapped_cast(gfi),
+                                          seqid, err);
+  if (!region)
+    return -1;
+  if (region->range_start != GT_UNDEF_UWORD) {
+    range->start = region->range_start;
+    range->end = region->range_end;
+  }
+  return 0;
+}
+
+static int gt_feature_index_mapped_get_orig_range_for_seqid(GtFeatureIndex
+                                                              *gfi,
+                                                            GtRange *range,
+                                                            const char *seqid,
+                                                            GtError *err)
+{
+  const GtFeatureIndexMappedRegion *region;
+  gt_assert(gfi && range && seqid);
+
+  region = feature_index_mapped_get_region_with_err(
+                                          gt_feature_index_mapped_cast(gfi),
+                                          seqid, err);
+  if (!region)
+    return -1;
+  if (region->has_orig_range) {
+    range->start = region->orig_range_start;
+    range->end = region->orig_range_end;
+  }
+  return 0;
+}
+
+static int gt_feature_index_mapped_has_seqid(const GtFeatureIndex *gfi,
+                                             bool *has_seqid,
+                                             const char *seqid,
+                                             GT_UNUSED GtError *err)
+{
+  gt_assert(gfi && has_seqid && seqid);
+  *has_seqid = feature_index_mapped_get_region(
+                          gt_feature_index_mapped_cast((GtFeatureIndex*) gfi),
+                          seqid) != NULL;
+  return 0;
+}
+
+static void gt_feature_index_mapped_delete(GtFeatureIndex *gfi)
+{
+  GtFeatureIndexMapped *fim;
+  GtUword i;
+  if (!gfi) return;
+  fim = gt_feature_index_mapped_cast(gfi);
+  if (fim->nodes) {
+    for (i = 0; i < fim->header->nof_features; i++)
+      gt_genome_node_delete(fim->nodes[i]);
+    gt_free(fim->nodes);
+  }
+  gt_genome_node_serializer_delete(fim->serializer);
+  gt_fa_fclose(fim->fp);
+  gt_fa_xmunmap(fim->map);
+  gt_mutex_delete(fim->node_lock);
+}
+
+const GtFeatureIndexClass* gt_feature_index_mapped_class(void)
+{
+  static const GtFeatureIndexClass *fic = NULL;
+  gt_class_alloc_lock_enter();
+  if (!fic) {
+    fic = gt_feature_index_class_new(sizeof (GtFeatureIndexMapped),
+                     gt_feature_index_mapped_add_region_node,
+                     gt_feature_index_mapped_add_feature_node,
+                     gt_feature_index_mapped_remove_node,
+                     gt_feature_index_mapped_get_features_for_seqid,
+                     gt_feature_index_mapped_get_features_for_range,
+                     gt_feature_index_mapped_get_first_seqid,
+                     NULL,
+                     gt_feature_index_mapped_get_seqids,
+                     gt_feature_index_mapped_get_range_for_seqid,
+                     gt_feature_index_mapped_get_orig_range_for_seqid,
+                     gt_feature_index_mapped_has_seqid,
+                     gt_feature_index_mapped_delete);
+  }
+  gt_class_alloc_lock_leave();
+  return fic;
+}
+
+/* checks the header and the regions of the mapped file, so that queries
+   cannot access memory outside of the map */
+static int feature_index_mapped_check(const char *filename, const void *map,
+                                      size_t len, GtError *err)
+{
+  const GtFeatureIndexMappedHeader *header = map;
+  const GtFeatureIndexMappedRegion *regions;
+  const char *strpool;
+  GtUword i, expected;
+
+  if (len < sizeof (*header)
+        || memcmp(header->magic, GT_FEATURE_INDEX_MAPPED_MAGIC,
+                  (size_t) GT_FEATURE_INDEX_MAPPED_MAGICLEN) != 0) {
+    gt_error_set(err, "file '%s' is not a feature index file", filename);
+    return -1;
+  }
+  if (header->wordsize != (GtUword) sizeof (GtUword)) {
+    gt_error_set(err, "feature index file '%s' was created on a %d-bit "
+                      "platform, but this is a %d-bit platform", filename,
+                 (int) (header->wordsize * CHAR_BIT),
+                 (int) (sizeof (GtUword) * CHAR_BIT));
+    return -1;
+  }
+  expected = sizeof (*header);
+  if (header->nof_regions > (len - expected) / sizeof (*regions))
+    expected = GT_UNDEF_UWORD;
+  else {
+    expected += sizeof (*regions) * header->nof_regions;
+    if (header->nof_features > (len - expected) / (4 * sizeof (GtUword)))
+      expected = GT_UNDEF_UWORD;
+    else
+      expected += 4 * sizeof (GtUword) * header->nof_features
+                  + header->strpool_size;
+  }
+  if (expected == GT_UNDEF_UWORD || expected > (GtUword) len
+        || (header->nof_regions > 0
+            && (header->first_region >= header->nof_regions
+                || header->strpool_size == 0))) {
+    gt_error_set(err, "feature index file '%s' is corrupt", filename);
+    return -1;
+  }
+  regions = (const GtFeatureIndexMappedRegion*) (header + 1);
+  strpool = (const char*) map + expected - header->strpool_size;
+  if (header->strpool_size > 0 && strpool[header->strpool_size - 1] != '\0') {
+    gt_error_set(err, "feature index file '%s' is corrupt", filename);
+    return -1;
+  }
+  for (i = 0; i < header->nof_regions; i++) {
+    if (regions[i].seqid_offset >= header->strpool_size
+          || regions[i].first_feature > header->nof_features
+          || regions[i].nof_features
+               > header->nof_features - regions[i].first_feature
+          || regions[i].max_level >= sizeof (GtUword) * CHAR_BIT) {
+      gt_error_set(err, "feature index file '%s' is corrupt", filename);
+      return -1;
+    }
+  }
+  return 0;
+}
+
+GtFeatureIndex* gt_feature_index_mapped_new(const char *filename,
+                                            GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  GtFeatureIndex *fi;
+  void *map;
+  FILE *fp = NULL;
+  size_t len;
+  gt_error_check(err);
+  gt_assert(filename);
+
+  if (!(map = gt_fa_mmap_read(filename, &len, err)))
+    return NULL;
+  if (feature_index_mapped_check(filename, map, len, err)
+        || !(fp = gt_fa_fopen(filename, "rb", err))) {
+    gt_fa_xmunmap(map);
+    return NULL;
+  }
+  /* queries touch a few pages at arbitrary positions */
+  gt_fa_madvise(map, GT_FA_ADVICE_RANDOM);
+  fi = gt_feature_index_create(gt_feature_index_mapped_class());
+  fim = gt_feature_index_mapped_cast(fi);
+  fim->map = map;
+  fim->header = map;
+  fim->regions = (const GtFeatureIndexMappedRegion*) (fim->header + 1);
+  fim->starts = (const GtUword*) (fim->regions + fim->header->nof_regions);
+  fim->ends = fim->starts + fim->header->nof_features;
+  fim->maxends = fim->ends + fim->header->nof_features;
+  fim->offsets = fim->maxends + fim->header->nof_features;
+  fim->strpool = (const char*) (fim->offsets + fim->header->nof_features);
+  fim->fp = fp;
+  fim->serializer = gt_genome_node_serializer_new(fp);
+  fim->nodes = gt_calloc((size_t) fim->header->nof_features + 1,
+                         sizeof (*fim->nodes));
+  fim->node_lock = gt_mutex_new();
+  return fi;
+}
+
+#define GT_FIM_TEST_FEATURES      1000UL
+#define GT_FIM_TEST_END           100000UL
+#define GT_FIM_TEST_FEATURE_WIDTH 2000UL
+#define GT_FIM_TEST_QUERIES       200UL
+
+typedef struct {
+  GtFeatureIndex *fi,
+                 *fim;
+  GtMutex *mutex;
+  GtUword error_count;
+} GtFeatureIndexMappedTestShared;
+
+/* queries a freshly mapped index, so that the threads read the same feature
+   node graphs from the file concurrently */
+static void* feature_index_mapped_unit_test_query(void *data)
+{
+  GtFeatureIndexMappedTestShared *shm = data;
+  GtError *err = gt_error_new();
+  GtArray *a, *b;
+  GtRange range;
+  GtUword i, j, error_count = 0;
+
+  a = gt_array_new(sizeof (GtFeatureNode*));
+  b = gt_array_new(sizeof (GtFeatureNode*));
+  for (i = 0; i < GT_FIM_TEST_QUERIES; i++) {
+    const char *seqid = (i % 2) ? "seqB" : "seqA";
+
+    range.start = i * (GT_FIM_TEST_END / GT_FIM_TEST_QUERIES) + 1;
+    range.end = range.start + GT_FIM_TEST_FEATURE_WIDTH;
+    gt_array_reset(a);
+    gt_array_reset(b);
+    if (gt_feature_index_get_features_for_range(shm->fi, a, seqid, &range,
+                                                err) != 0
+          || gt_feature_index_get_features_for_range(shm->fim, b, seqid,
+                                                     &range, err) != 0
+          || gt_array_size(a) != gt_array_size(b)) {
+      error_count++;
+      continue;
+    }
+    for (j = 0; j < gt_array_size(a); j++) {
+      if (!gt_feature_node_is_similar(*(GtFeatureNode**) gt_array_get(a, j),
+                                      *(GtFeatureNode**) gt_array_get(b, j)))
+        error_count++;
+    }
+  }
+  gt_array_delete(a);
+  gt_array_delete(b);
+  gt_error_delete(err);
+  gt_mutex_lock(shm->mutex);
+  shm->error_count += error_count;
+  gt_mutex_unlock(shm->mutex);
+  return NULL;
+}
+
+int gt_feature_index_mapped_unit_test(GtError *err)
+{
+  GtFeatureIndex *fi, *fim = NULL;
+  GtStr *tmpfilename, *seqids[2];
+  GtStrArray *seqids_fi = NULL, *seqids_fim = NULL;
+  GtRegionNode *rn;
+  GtGenomeNode *gene;
+  GtArray *a, *b;
+  GtRange range, range_fim;
+  GtUword i, j;
+  bool has_seqid;
+  char *first_seqid;
+  FILE *fp;
+  int had_err = 0;
+  gt_error_check(err);
+
+  /* fill an index in memory, with one region node added explicitly */
+  fi = gt_feature_index_memory_new();
+  seqids[0] = gt_str_new_cstr("seqA");
+  seqids[1] = gt_str_new_cstr("seqB");
+  rn = (GtRegionNode*) gt_region_node_new(seqids[1], 1, GT_FIM_TEST_END);
+  gt_ensure(gt_feature_index_add_region_node(fi, rn, err) == 0);
+  gt_genome_node_delete((GtGenomeNode*) rn);
+  for (i = 0; i < GT_FIM_TEST_FEATURES; i++) {
+    GtUword start = gt_rand_max(GT_FIM_TEST_END - GT_FIM_TEST_FEATURE_WIDTH)
+                    + 1;
+    GtGenomeNode *gn;
+
+    gn = gt_feature_node_new(seqids[i % 2], "gene", start,
+                             start + gt_rand_max(GT_FIM_TEST_FEATURE_WIDTH),
+                             GT_STRAND_FORWARD);
+    gt_ensure(gt_feature_index_add_feature_node(fi, (GtFeatureNode*) gn,
+                                                err) == 0);
+    gt_genome_node_delete(gn);
+  }
+  gene = gt_feature_node_new_standard_gene();
+  gt_ensure(gt_feature_index_add_feature_node(fi, (GtFeatureNode*) gene,
+                                              err) == 0);
+  gt_genome_node_delete(gene);
+
+  /* write it and map it */
+  tmpfilename = gt_str_new();
+  fp = gt_xtmpfp(tmpfilename);
+  gt_fa_xfclose(fp);
+  if (!had_err) {
+    had_err = gt_feature_index_mapped_write(fi, gt_str_get(tmpfilename), err);
+    gt_ensure(!had_err);
+  }
+  if (!had_err) {
+    fim = gt_feature_index_mapped_new(gt_str_get(tmpfilename), err);
+    gt_ensure(fim != NULL);
+  }
+
+  /* compare the sequence regions */
+  if (!had_err) {
+    seqids_fi = gt_feature_index_get_seqids(fi, err);
+    seqids_fim = gt_feature_index_get_seqids(fim, err);
+    gt_ensure(gt_str_array_size(seqids_fi) == 3UL);
+    gt_ensure(gt_str_array_size(seqids_fim) == 3UL);
+  }
+  for (i = 0; !had_err && i < gt_str_array_size(seqids_fi); i++) {
+    const char *seqid = gt_str_array_get(seqids_fi, i);
+
+    gt_ensure(strcmp(seqid, gt_str_array_get(seqids_fim, i)) == 0);
+    gt_ensure(gt_feature_index_has_seqid(fim, &has_seqid, seqid, err) == 0);
+    gt_ensure(has_seqid);
+    gt_feature_index_get_range_for_seqid(fi, &range, seqid, err);
+    gt_ensure(gt_feature_index_get_range_for_seqid(fim, &range_fim, seqid,
+                                                   err) == 0);
+    gt_ensure(gt_range_compare(&range, &range_fim) == 0);
+    a = gt_feature_index_get_features_for_seqid(fi, seqid, err);
+    b = gt_feature_index_get_features_for_seqid(fim, seqid, err);
+    gt_ensure(b && gt_array_size(a) == gt_array_size(b));
+    gt_array_delete(a);
+    gt_array_delete(b);
+  }
+  if (!had_err) {
+    range.start = range.end = GT_UNDEF_UWORD;
+    gt_ensure(gt_feature_index_get_orig_range_for_seqid(fim, &range, "seqB",
+                                                        err) == 0);
+    gt_ensure(range.start == 1UL && range.end == GT_FIM_TEST_END);
+    gt_ensure(gt_feature_index_has_seqid(fim, &has_seqid, "seqC", err) == 0);
+    gt_ensure(!has_seqid);
+    first_seqid = gt_feature_index_get_first_seqid(fim, err);
+    gt_ensure(first_seqid && strcmp(first_seqid, "seqB") == 0);
+    gt_free(first_seqid);
+  }
+
+  /* range queries must deliver the same features */
+  a = gt_array_new(sizeof (GtFeatureNode*));
+  b = gt_array_new(sizeof (GtFeatureNode*));
+  for (i = 0; !had_err && i < GT_FIM_TEST_QUERIES; i++) {
+    range.start = gt_rand_max(GT_FIM_TEST_END);
+    range.end = range.start + gt_rand_max(GT_FIM_TEST_FEATURE_WIDTH);
+    gt_array_reset(a);
+    gt_array_reset(b);
+    gt_ensure(gt_feature_index_get_features_for_range(fi, a,
+                                              gt_str_get(seqids[i % 2]),
+                                              &range, err) == 0);
+    gt_ensure(gt_feature_index_get_features_for_range(fim, b,
+                                              gt_str_get(seqids[i % 2]),
+                                              &range, err) == 0);
+    gt_ensure(gt_array_size(a) == gt_array_size(b));
+    for (j = 0; !had_err && j < gt_array_size(a); j++) {
+      gt_ensure(gt_feature_node_is_similar(
+                                   *(GtFeatureNode**) gt_array_get(a, j),
+                                   *(GtFeatureNode**) gt_array_get(b, j)));
+    }
+  }
+  gt_array_delete(a);
+  gt_array_delete(b);
+
+  /* concurrent queries must deliver the same features */
+  if (!had_err) {
+    GtFeatureIndexMappedTestShared shm;
+
+    shm.fi = fi;
+    shm.fim = gt_feature_index_mapped_new(gt_str_get(tmpfilename), err);
+    shm.mutex = gt_mutex_new();
+    shm.error_count = 0;
+    gt_ensure(shm.fim != NULL);
+    if (!had_err) {
+      gt_ensure(gt_multithread(feature_index_mapped_unit_test_query, &shm,
+                               err) == 0);
+      gt_ensure(shm.error_count == 0);
+    }
+    gt_feature_index_delete(shm.fim);
+    gt_mutex_delete(shm.mutex);
+  }
+
+  /* the mapped index cannot be changed */
+  if (!had_err) {
+    GtError *testerr = gt_error_new();
+    gene = gt_feature_node_new_standard_gene();
+    gt_ensure(gt_feature_index_add_feature_node(fim, (GtFeatureNode*) gene,
+                                                testerr) == -1);
+    gt_ensure(gt_error_is_set(testerr));
+    gt_genome_node_delete(gene);
+    gt_error_delete(testerr);
+  }
+
+  gt_xremove(gt_str_get(tmpfilename));
+  gt_str_delete(tmpfilename);
+  gt_str_array_delete(seqids_fi);
+  gt_str_array_delete(seqids_fim);
+  gt_str_delete(seqids[0]);
+  gt_str_delete(seqids[1]);
+  gt_feature_index_delete(fim);
+  gt_feature_index_delete(fi);
+  return had_err;
+}
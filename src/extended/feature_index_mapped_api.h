@@ -0,0 +1,45 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef FEATURE_INDEX_MAPPED_API_H
+#define FEATURE_INDEX_MAPPED_API_H
+
+#include "extended/feature_index_api.h"
+
+/* The <GtFeatureIndexMapped> class implements a read-only <GtFeatureIndex>
+   stored in a binary file, which is mapped into memory instead of being
+   rebuilt from annotation files. The file contains sorted columns of the
+   feature ranges per sequence region, organized as an implicit interval tree,
+   and the serialized feature node graphs, which are only read when a feature
+   is returned by a query. The file format uses the native byte order and word
+   size. */
+typedef struct GtFeatureIndexMapped GtFeatureIndexMapped;
+
+/* Write the contents of <feature_index> to the file <filename> in the format
+   read by <gt_feature_index_mapped_new()>. Returns 0 on success, or -1 and
+   sets <err> on error. */
+int             gt_feature_index_mapped_write(GtFeatureIndex *feature_index,
+                                              const char *filename,
+                                              GtError *err);
+
+/* Returns a new <GtFeatureIndexMapped> object for the feature index file
+   <filename>, or NULL and sets <err> on error. Adding or removing nodes fails
+   for the returned index. */
+GtFeatureIndex* gt_feature_index_mapped_new(const char *filename,
+                                            GtError *err);
+
+#endif
@@ -0,0 +1,744 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/array.h"
+#include "core/assert_api.h"
+#include "core/cstr_api.h"
+#include "core/ensure.h"
+#include "core/fa.h"
+#include "core/hashmap_api.h"
+#include "core/ma_api.h"
+#include "core/undef_api.h"
+#include "core/unused_api.h"
+#include "core/xansi_api.h"
+#include "extended/comment_node_api.h"
+#include "extended/eof_node_api.h"
+#include "extended/feature_node.h"
+#include "extended/genome_node_rep.h"
+#include "extended/genome_node_serializer.h"
+#include "extended/meta_node_api.h"
+#include "extended/region_node_api.h"
+#include "extended/sequence_node_api.h"
+
+/* record types */
+#define GNS_EOF_NODE       'E'
+#define GNS_COMMENT_NODE   'C'
+#define GNS_META_NODE      'M'
+#define GNS_REGION_NODE    'R'
+#define GNS_SEQUENCE_NODE  'S'
+#define GNS_FEATURE_NODE   'F'
+
+/* feature node flags */
+#define GNS_PSEUDO         (1 << 0)
+#define GNS_HAS_SOURCE     (1 << 1)
+#define GNS_SCORE_DEFINED  (1 << 2)
+#define GNS_MULTI          (1 << 3)
+#define GNS_HAS_ORIGIN     (1 << 4)
+
+struct GtGenomeNodeSerializer {
+  FILE *fp;
+  /* read buffer for strings */
+  char *buf;
+  GtUword bufsize;
+  /* the last filename and sequence ID read, to share them between nodes */
+  GtStr *filename,
+        *seqid;
+  /* feature graph serialization */
+  GtArray *features;
+  GtHashmap *feature_indices;
+};
+
+GtGenomeNodeSerializer* gt_genome_node_serializer_new(FILE *fp)
+{
+  GtGenomeNodeSerializer *serializer;
+  gt_assert(fp);
+  serializer = gt_calloc(1, sizeof *serializer);
+  serializer->fp = fp;
+  serializer->features = gt_array_new(sizeof (GtFeatureNode*));
+  serializer->feature_indices = gt_hashmap_new(GT_HASH_DIRECT, NULL, NULL);
+  return serializer;
+}
+
+static void write_cstr(const char *cstr, FILE *fp)
+{
+  GtUword length = strlen(cstr);
+  gt_xfwrite_one(&length, fp);
+  gt_xfwrite(cstr, sizeof (char), length, fp);
+}
+
+static void write_origin(GtGenomeNode *gn, FILE *fp)
+{
+  gt_xfwrite_one(&gn->line_number, fp);
+  write_cstr(gt_str_get(gn->filename), fp);
+}
+
+static void write_simple_node(GtGenomeNode *gn, unsigned char type, FILE *fp)
+{
+  unsigned char has_origin = gn->filename ? 1 : 0;
+  gt_xfwrite_one(&type, fp);
+  gt_xfwrite_one(&has_origin, fp);
+  if (has_origin)
+    write_origin(gn, fp);
+}
+
+static void write_attribute(const char *attr_name, const char *attr_value,
+                            void *data)
+{
+  FILE *fp = data;
+  write_cstr(attr_name, fp);
+  write_cstr(attr_value, fp);
+}
+
+static void count_attribute(GT_UNUSED const char *attr_name,
+                            GT_UNUSED const char *attr_value, void *data)
+{
+  GtUword *nof_attributes = data;
+  (*nof_attributes)++;
+}
+
+static int add_child_to_table(GtFeatureNode *child, void *data,
+                              GT_UNUSED GtError *err)
+{
+  GtGenomeNodeSerializer *serializer = data;
+  if (!gt_hashmap_get(serializer->feature_indices, child)) {
+    gt_array_add(serializer->features, child);
+    /* store index + 1 to distinguish index 0 from an undefined entry */
+    gt_hashmap_add(serializer->feature_indices, child,
+                   (void*) gt_array_size(serializer->features));
+  }
+  return 0;
+}
+
+static int write_child_index(GtFeatureNode *child, void *data,
+                             GT_UNUSED GtError *err)
+{
+  GtGenomeNodeSerializer *serializer = data;
+  GtUword idx = (GtUword) gt_hashmap_get(serializer->feature_indices, child);
+  gt_assert(idx);
+  idx--;
+  gt_xfwrite_one(&idx, serializer->fp);
+  return 0;
+}
+
+static void write_feature_node(GtGenomeNodeSerializer *serializer,
+                               GtFeatureNode *fn)
+{
+  GtGenomeNode *gn = (GtGenomeNode*) fn;
+  unsigned char flags = 0, strand, phase;
+  GtUword idx;
+  GtRange range;
+  float score;
+  FILE *fp = serializer->fp;
+
+  if (gt_feature_node_is_pseudo(fn))
+    flags |= GNS_PSEUDO;
+  if (gt_feature_node_has_source(fn))
+    flags |= GNS_HAS_SOURCE;
+  if (gt_feature_node_score_is_defined(fn))
+    flags |= GNS_SCORE_DEFINED;
+  if (gt_feature_node_is_multi(fn))
+    flags |= GNS_MULTI;
+  if (gn->filename)
+    flags |= GNS_HAS_ORIGIN;
+  gt_xfwrite_one(&flags, fp);
+  if (flags & GNS_HAS_ORIGIN)
+    write_origin(gn, fp);
+  if (!(flags & GNS_PSEUDO))
+    write_cstr(gt_feature_node_get_type(fn), fp);
+  if (flags & GNS_HAS_SOURCE)
+    write_cstr(gt_feature_node_get_source(fn), fp);
+  range = gt_genome_node_get_range(gn);
+  gt_xfwrite_one(&range.start, fp);
+  gt_xfwrite_one(&range.end, fp);
+  strand = (unsigned char) gt_feature_node_get_strand(fn);
+  phase = (unsigned char) gt_feature_node_get_phase(fn);
+  gt_xfwrite_one(&strand, fp);
+  gt_xfwrite_one(&phase, fp);
+  if (flags & GNS_SCORE_DEFINED) {
+    score = gt_feature_node_get_score(fn);
+    gt_xfwrite_one(&score, fp);
+  }
+  if (flags & GNS_MULTI) {
+    /* a representative outside of this graph cannot be referenced, the node
+       becomes its own representative then */
+    idx = (GtUword)
+          gt_hashmap_get(serializer->feature_indices,
+                         gt_feature_node_get_multi_representative(fn));
+    if (!idx)
+      idx = (GtUword) gt_hashmap_get(serializer->feature_indices, fn);
+    idx--;
+    gt_xfwrite_one(&idx, fp);
+  }
+  idx = 0;
+  gt_feature_node_foreach_attribute(fn, count_attribute, &idx);
+  gt_xfwrite_one(&idx, fp);
+  gt_feature_node_foreach_attribute(fn, write_attribute, fp);
+  idx = gt_feature_node_number_of_children(fn);
+  gt_xfwrite_one(&idx, fp);
+  (void) gt_feature_node_traverse_direct_children(fn, serializer,
+                                                  write_child_index, NULL);
+}
+
+static void write_feature_graph(GtGenomeNodeSerializer *serializer,
+                                GtFeatureNode *root)
+{
+  unsigned char type = GNS_FEATURE_NODE;
+  GtUword i, nof_features;
+  /* collect all nodes of the graph in breadth-first order, nodes with multiple
+     parents are stored only once */
+  gt_array_reset(serializer->features);
+  gt_hashmap_reset(serializer->feature_indices);
+  (void) add_child_to_table(root, serializer, NULL);
+  for (i = 0; i < gt_array_size(serializer->features); i++) {
+    GtFeatureNode *fn = *(GtFeatureNode**) gt_array_get(serializer->features,
+                                                        i);
+    (void) gt_feature_node_traverse_direct_children(fn, serializer,
+                                                    add_child_to_table, NULL);
+  }
+  nof_features = gt_array_size(serializer->features);
+  gt_xfwrite_one(&type, serializer->fp);
+  write_cstr(gt_str_get(gt_genome_node_get_seqid((GtGenomeNode*) root)),
+             serializer->fp);
+  gt_xfwrite_one(&nof_features, serializer->fp);
+  for (i = 0; i < nof_features; i++) {
+    write_feature_node(serializer,
+                       *(GtFeatureNode**) gt_array_get(serializer->features,
+                                                       i));
+  }
+}
+
+int gt_genome_node_serializer_write(GtGenomeNodeSerializer *serializer,
+                                    GtGenomeNode *gn, GtError *err)
+{
+  GtFeatureNode *fn;
+  GtRegionNode *rn;
+  GtCommentNode *cn;
+  GtMetaNode *mn;
+  GtSequenceNode *sn;
+  const char *data;
+  unsigned char has_data;
+  GtRange range;
+  gt_error_check(err);
+  gt_assert(serializer && gn);
+
+  if ((fn = gt_feature_node_try_cast(gn)))
+    write_feature_graph(serializer, fn);
+  else if ((rn = gt_region_node_try_cast(gn))) {
+    write_simple_node(gn, GNS_REGION_NODE, serializer->fp);
+    write_cstr(gt_str_get(gt_genome_node_get_seqid(gn)), serializer->fp);
+    range = gt_genome_node_get_range(gn);
+    gt_xfwrite_one(&range.start, serializer->fp);
+    gt_xfwrite_one(&range.end, serializer->fp);
+  }
+  else if ((cn = gt_comment_node_try_cast(gn))) {
+    write_simple_node(gn, GNS_COMMENT_NODE, serializer->fp);
+    write_cstr(gt_comment_node_get_comment(cn), serializer->fp);
+  }
+  else if ((mn = gt_meta_node_try_cast(gn))) {
+    write_simple_node(gn, GNS_META_NODE, serializer->fp);
+    write_cstr(gt_meta_node_get_directive(mn), serializer->fp);
+    data = gt_meta_node_get_data(mn);
+    has_data = data ? 1 : 0;
+    gt_xfwrite_one(&has_data, serializer->fp);
+    if (has_data)
+      write_cstr(data, serializer->fp);
+  }
+  else if ((sn = gt_sequence_node_try_cast(gn))) {
+    write_simple_node(gn, GNS_SEQUENCE_NODE, serializer->fp);
+    write_cstr(gt_sequence_node_get_description(sn), serializer->fp);
+    write_cstr(gt_sequence_node_get_sequence(sn), serializer->fp);
+  }
+  else if (gt_eof_node_try_cast(gn))
+    write_simple_node(gn, GNS_EOF_NODE, serializer->fp);
+  else {
+    gt_error_set(err, "cannot serialize genome node of unknown type");
+    return -1;
+  }
+  return 0;
+}
+
+void gt_genome_node_serializer_rewind(GtGenomeNodeSerializer *serializer)
+{
+  gt_assert(serializer);
+  gt_xfflush(serializer->fp);
+  gt_xfseek(serializer->fp, 0, SEEK_SET);
+}
+
+static int read_data(GtGenomeNodeSerializer *serializer, void *ptr,
+                     size_t size, GtError *err)
+{
+  if (size && gt_xfread(ptr, size, 1, serializer->fp) != 1) {
+    gt_error_set(err, "unexpected end of serialized genome node file");
+    return -1;
+  }
+  return 0;
+}
+
+#define read_one(SERIALIZER, PTR, ERR)\
+        read_data(SERIALIZER, PTR, sizeof (*(PTR)), ERR)
+
+/* reads a string into the buffer of <serializer> */
+static int read_cstr(GtGenomeNodeSerializer *serializer, GtError *err)
+{
+  GtUword length;
+  if (read_one(serializer, &length, err))
+    return -1;
+  if (length + 1 > serializer->bufsize) {
+    serializer->bufsize = length + 1;
+    serializer->buf = gt_realloc(serializer->buf, serializer->bufsize);
+  }
+  if (read_data(serializer, serializer->buf, length, err))
+    return -1;
+  serializer->buf[length] = '\0';
+  return 0;
+}
+
+/* reads a string and returns it as a <GtStr> shared with previously read
+   strings of the same content */
+static GtStr* read_shared_str(GtGenomeNodeSerializer *serializer,
+                              GtStr **last, GtError *err)
+{
+  if (read_cstr(serializer, err))
+    return NULL;
+  if (!*last || strcmp(gt_str_get(*last), serializer->buf)) {
+    gt_str_delete(*last);
+    *last = gt_str_new_cstr(serializer->buf);
+  }
+  return *last;
+}
+
+
+static int read_origin(GtGenomeNodeSerializer *serializer,
+                       unsigned int *line_number, GtStr **filename,
+                       GtError *err)
+{
+  if (read_one(serializer, line_number, err))
+    return -1;
+  if (!(*filename = read_shared_str(serializer, &serializer->filename, err)))
+    return -1;
+  return 0;
+}
+
+static int read_simple_node(GtGenomeNodeSerializer *serializer,
+                            unsigned char type, GtGenomeNode **gn,
+                            GtError *err)
+{
+  unsigned char has_origin, has_data;
+  unsigned int line_number = 0;
+  GtStr *filename = NULL, *seqid;
+  GtRange range;
+  char *directive;
+  int had_err;
+
+  had_err = read_one(serializer, &has_origin, err);
+  if (!had_err && has_origin)
+    had_err = read_origin(serializer, &line_number, &filename, err);
+  /* keep the shared filename alive while reading the node data */
+  if (filename)
+    filename = gt_str_ref(filename);
+  if (!had_err) {
+    switch (type) {
+      case GNS_EOF_NODE:
+        *gn = gt_eof_node_new();
+        break;
+      case GNS_REGION_NODE:
+        if (!(seqid = read_shared_str(serializer, &serializer->seqid, err)) ||
+            read_one(serializer, &range.start, err) ||
+            read_one(serializer, &range.end, err)) {
+          had_err = -1;
+        }
+        else
+          *gn = gt_region_node_new(seqid, range.start, range.end);
+        break;
+      case GNS_COMMENT_NODE:
+        if (!(had_err = read_cstr(serializer, err)))
+          *gn = gt_comment_node_new(serializer->buf);
+        break;
+      case GNS_META_NODE:
+        if ((had_err = read_cstr(serializer, err)))
+          break;
+        directive = gt_cstr_dup(serializer->buf);
+        had_err = read_one(serializer, &has_data, err);
+        if (!had_err && has_data)
+          had_err = read_cstr(serializer, err);
+        if (!had_err)
+          *gn = gt_meta_node_new(directive, has_data ? serializer->buf : NULL);
+        gt_free(directive);
+        break;
+      case GNS_SEQUENCE_NODE:
+        if ((had_err = read_cstr(serializer, err)))
+          break;
+        directive = gt_cstr_dup(serializer->buf); /* the description */
+        if (!(had_err = read_cstr(serializer, err))) {
+          GtStr *sequence = gt_str_new_cstr(serializer->buf);
+          *gn = gt_sequence_node_new(directive, sequence);
+          gt_str_delete(sequence);
+        }
+        gt_free(directive);
+        break;
+      default:
+        gt_error_set(err, "unknown record type in serialized genome node "
+                          "file");
+        had_err = -1;
+    }
+  }
+  if (!had_err && filename)
+    gt_genome_node_set_origin(*gn, filename, line_number);
+  gt_str_delete(filename);
+  return had_err;
+}
+
+static int read_feature_node(GtGenomeNodeSerializer *serializer, GtStr *seqid,
+                             GtFeatureNode **fn, GtUword *representative,
+                             GtArray *children, GtError *err)
+{
+  unsigned char flags, strand, phase;
+  unsigned int line_number = 0;
+  GtStr *filename = NULL, *source;
+  GtUword i, nof_items, child;
+  GtRange range;
+  float score;
+  char *type = NULL;
+  int had_err;
+
+  *fn = NULL;
+  had_err = read_one(serializer, &flags, err);
+  if (!had_err && (flags & GNS_HAS_ORIGIN)) {
+    if (!(had_err = read_origin(serializer, &line_number, &filename, err)))
+      filename = gt_str_ref(filename);
+  }
+  if (!had_err && !(flags & GNS_PSEUDO)) {
+    if (!(had_err = read_cstr(serializer, err)))
+      type = gt_cstr_dup(serializer->buf);
+  }
+  if (!had_err && (flags & GNS_HAS_SOURCE))
+    had_err = read_cstr(serializer, err);
+  if (!had_err) {
+    source = (flags & GNS_HAS_SOURCE) ? gt_str_new_cstr(serializer->buf)
+                                      : NULL;
+    if (read_one(serializer, &range.start, err) ||
+        read_one(serializer, &range.end, err) ||
+        read_one(serializer, &strand, err) ||
+        read_one(serializer, &phase, err)) {
+      had_err = -1;
+    }
+    if (!had_err) {
+      if (flags & GNS_PSEUDO) {
+        *fn = gt_feature_node_cast(gt_feature_node_new_pseudo(seqid,
+                                                              range.start,
+                                                              range.end,
+                                                              strand));
+      }
+      else {
+        *fn = gt_feature_node_cast(gt_feature_node_new(seqid, type,
+                                                       range.start, range.end,
+                                                       strand));
+      }
+      if (source)
+        gt_feature_node_set_source(*fn, source);
+      gt_feature_node_set_phase(*fn, phase);
+      if (filename)
+        gt_genome_node_set_origin((GtGenomeNode*) *fn, filename, line_number);
+    }
+    gt_str_delete(source);
+  }
+  gt_free(type);
+  gt_str_delete(filename);
+  if (!had_err && (flags & GNS_SCORE_DEFINED)) {
+    if (!(had_err = read_one(serializer, &score, err)))
+      gt_feature_node_set_score(*fn, score);
+  }
+  *representative = GT_UNDEF_UWORD;
+  if (!had_err && (flags & GNS_MULTI))
+    had_err = read_one(serializer, representative, err);
+  if (!had_err)
+    had_err = read_one(serializer, &nof_items, err);
+  for (i = 0; !had_err && i < nof_items; i++) {
+    char *attr_name;
+    if ((had_err = read_cstr(serializer, err)))
+      break;
+    attr_name = gt_cstr_dup(serializer->buf);
+    if (!(had_err = read_cstr(serializer, err)))
+      gt_feature_node_add_attribute(*fn, attr_name, serializer->buf);
+    gt_free(attr_name);
+  }
+  if (!had_err)
+    had_err = read_one(serializer, &nof_items, err);
+  gt_array_reset(children);
+  for (i = 0; !had_err && i < nof_items; i++) {
+    if (!(had_err = read_one(serializer, &child, err)))
+      gt_array_add(children, child);
+  }
+  if (had_err) {
+    gt_genome_node_delete((GtGenomeNode*) *fn);
+    *fn = NULL;
+  }
+  return had_err;
+}
+
+static int read_feature_graph(GtGenomeNodeSerializer *serializer,
+                              GtGenomeNode **gn, GtError *err)
+{
+  GtUword i, j, nof_features, *representatives = NULL;
+  GtFeatureNode **features = NULL;
+  GtArray *children, *child_offsets, *child_indices;
+  unsigned char *nof_parents = NULL;
+  GtStr *seqid;
+  int had_err = 0;
+
+  if (!(seqid = read_shared_str(serializer, &serializer->seqid, err)) ||
+      read_one(serializer, &nof_features, err) ||
+      nof_features == 0) {
+    if (seqid && !gt_error_is_set(err)) {
+      gt_error_set(err, "empty feature graph in serialized genome node file");
+    }
+    return -1;
+  }
+  seqid = gt_str_ref(seqid);
+  features = gt_calloc(nof_features, sizeof *features);
+  representatives = gt_malloc(nof_features * sizeof *representatives);
+  nof_parents = gt_calloc(nof_features, sizeof *nof_parents);
+  children = gt_array_new(sizeof (GtUword));
+  child_offsets = gt_array_new(sizeof (GtUword));
+  child_indices = gt_array_new(sizeof (GtUword));
+
+  /* read all nodes first, the children of a node may come later */
+  for (i = 0; !had_err && i < nof_features; i++) {
+    had_err = read_feature_node(serializer, seqid, features + i,
+                                representatives + i, children, err);
+    if (!had_err) {
+      GtUword offset = gt_array_size(child_indices);
+      gt_array_add(child_offsets, offset);
+      for (j = 0; !had_err && j < gt_array_size(children); j++) {
+        GtUword child = *(GtUword*) gt_array_get(children, j);
+        if (child == 0 || child >= nof_features) {
+          gt_error_set(err, "invalid child in serialized genome node file");
+          had_err = -1;
+        }
+        else
+          gt_array_add(child_indices, child);
+      }
+    }
+  }
+  if (!had_err) {
+    GtUword offset = gt_array_size(child_indices);
+    gt_array_add(child_offsets, offset);
+  }
+
+  if (!had_err) {
+    /* connect the nodes, in the original order of the children */
+    for (i = 0; i < nof_features; i++) {
+      GtUword start = *(GtUword*) gt_array_get(child_offsets, i),
+              end = *(GtUword*) gt_array_get(child_offsets, i + 1);
+      for (j = start; j < end; j++) {
+        GtUword child = *(GtUword*) gt_array_get(child_indices, j);
+        /* the parents share the ownership of a child */
+        if (nof_parents[child])
+          gt_genome_node_ref((GtGenomeNode*) features[child]);
+        else
+          nof_parents[child] = 1;
+        gt_feature_node_add_child(features[i], features[child]);
+      }
+    }
+    /* restore the multi-features, the representatives first */
+    for (i = 0; i < nof_features; i++) {
+      if (representatives[i] == i)
+        gt_feature_node_make_multi_representative(features[i]);
+    }
+    for (i = 0; i < nof_features; i++) {
+      if (representatives[i] != GT_UNDEF_UWORD && representatives[i] != i &&
+          representatives[i] < nof_features) {
+        if (!gt_feature_node_is_multi(features[representatives[i]]))
+          gt_feature_node_make_multi_representative(features
+                                                    [representatives[i]]);
+        gt_feature_node_set_multi_representative(features[i],
+                                                 features[representatives[i]]);
+      }
+    }
+    *gn = (GtGenomeNode*) features[0];
+  }
+  else {
+    /* the nodes are not connected yet */
+    for (i = 0; i < nof_features; i++)
+      gt_genome_node_delete((GtGenomeNode*) features[i]);
+  }
+
+  gt_array_delete(child_indices);
+  gt_array_delete(child_offsets);
+  gt_array_delete(children);
+  gt_free(nof_parents);
+  gt_free(representatives);
+  gt_free(features);
+  gt_str_delete(seqid);
+  return had_err;
+}
+
+int gt_genome_node_serializer_read(GtGenomeNodeSerializer *serializer,
+                                   GtGenomeNode **gn, GtError *err)
+{
+  unsigned char type;
+  gt_error_check(err);
+  gt_assert(serializer && gn);
+  *gn = NULL;
+  if (gt_xfread(&type, sizeof type, 1, serializer->fp) != 1)
+    return 0; /* all nodes read */
+  if (type == GNS_FEATURE_NODE)
+    return read_feature_graph(serializer, gn, err);
+  return read_simple_node(serializer, type, gn, err);
+}
+
+void gt_genome_node_serializer_delete(GtGenomeNodeSerializer *serializer)
+{
+  if (!serializer) return;
+  gt_hashmap_delete(serializer->feature_indices);
+  gt_array_delete(serializer->features);
+  gt_str_delete(serializer->seqid);
+  gt_str_delete(serializer->filename);
+  gt_free(serializer->buf);
+  gt_free(serializer);
+}
+
+static bool files_are_equal(FILE *fp_a, FILE *fp_b)
+{
+  int cc_a, cc_b;
+  gt_xfseek(fp_a, 0, SEEK_SET);
+  gt_xfseek(fp_b, 0, SEEK_SET);
+  do {
+    cc_a = getc(fp_a);
+    cc_b = getc(fp_b);
+    if (cc_a != cc_b)
+      return false;
+  } while (cc_a != EOF);
+  return true;
+}
+
+int gt_genome_node_serializer_unit_test(GtError *err)
+{
+  GtGenomeNodeSerializer *serializer, *reserializer;
+  GtGenomeNode *gn, *gene, *mrna_a, *mrna_b, *exon, *cds_a, *cds_b, *pseudo;
+  GtArray *nodes;
+  GtStr *seqid, *filename, *sequence;
+  FILE *fp, *refp;
+  GtUword i;
+  int had_err = 0;
+  gt_error_check(err);
+
+  nodes = gt_array_new(sizeof (GtGenomeNode*));
+  seqid = gt_str_new_cstr("seqid");
+  filename = gt_str_new_cstr("file.gff3");
+
+  gn = gt_comment_node_new("comment");
+  gt_genome_node_set_origin(gn, filename, 1);
+  gt_array_add(nodes, gn);
+  gn = gt_meta_node_new("directive", "data");
+  gt_array_add(nodes, gn);
+  gn = gt_meta_node_new("directive", NULL);
+  gt_array_add(nodes, gn);
+  gn = gt_region_node_new(seqid, 1, 1000);
+  gt_genome_node_set_origin(gn, filename, 2);
+  gt_array_add(nodes, gn);
+  gn = gt_feature_node_new_standard_gene();
+  gt_array_add(nodes, gn);
+
+  /* a gene whose two transcripts share an exon and have a multi-feature CDS */
+  gene = gt_feature_node_new(seqid, "gene", 100, 900, GT_STRAND_FORWARD);
+  gt_genome_node_set_origin(gene, filename, 3);
+  gt_feature_node_set_source((GtFeatureNode*) gene, filename);
+  gt_feature_node_set_score((GtFeatureNode*) gene, 0.5);
+  gt_feature_node_add_attribute((GtFeatureNode*) gene, "ID", "gene1");
+  gt_feature_node_add_attribute((GtFeatureNode*) gene, "Name", "foo");
+  mrna_a = gt_feature_node_new(seqid, "mRNA", 100, 900, GT_STRAND_FORWARD);
+  mrna_b = gt_feature_node_new(seqid, "mRNA", 100, 800, GT_STRAND_FORWARD);
+  exon = gt_feature_node_new(seqid, "exon", 100, 200, GT_STRAND_FORWARD);
+  cds_a = gt_feature_node_new(seqid, "CDS", 150, 200, GT_STRAND_FORWARD);
+  cds_b = gt_feature_node_new(seqid, "CDS", 300, 400, GT_STRAND_FORWARD);
+  gt_feature_node_set_phase((GtFeatureNode*) cds_b, GT_PHASE_TWO);
+  gt_feature_node_make_multi_representative((GtFeatureNode*) cds_a);
+  gt_feature_node_set_multi_representative((GtFeatureNode*) cds_b,
+                                           (GtFeatureNode*) cds_a);
+  gt_feature_node_add_child((GtFeatureNode*) gene, (GtFeatureNode*) mrna_a);
+  gt_feature_node_add_child((GtFeatureNode*) gene, (GtFeatureNode*) mrna_b);
+  gt_feature_node_add_child((GtFeatureNode*) mrna_a, (GtFeatureNode*) exon);
+  gt_feature_node_add_child((GtFeatureNode*) mrna_b,
+                            (GtFeatureNode*) gt_genome_node_ref(exon));
+  gt_feature_node_add_child((GtFeatureNode*) mrna_a, (GtFeatureNode*) cds_a);
+  gt_feature_node_add_child((GtFeatureNode*) mrna_a, (GtFeatureNode*) cds_b);
+  gt_array_add(nodes, gene);
+
+  /* a pseudo-feature */
+  pseudo = gt_feature_node_new_pseudo(seqid, 950, 1000, GT_STRAND_REVERSE);
+  gn = gt_feature_node_new(seqid, "gene", 950, 960, GT_STRAND_REVERSE);
+  gt_feature_node_add_child((GtFeatureNode*) pseudo, (GtFeatureNode*) gn);
+  gn = gt_feature_node_new(seqid, "gene", 970, 1000, GT_STRAND_REVERSE);
+  gt_feature_node_add_child((GtFeatureNode*) pseudo, (GtFeatureNode*) gn);
+  gt_array_add(nodes, pseudo);
+
+  sequence = gt_str_new_cstr("acgt");
+  gn = gt_sequence_node_new("description", sequence);
+  gt_str_delete(sequence);
+  gt_array_add(nodes, gn);
+  gn = gt_eof_node_new();
+  gt_array_add(nodes, gn);
+
+  /* serialize the nodes */
+  fp = gt_xtmpfp_generic(NULL, TMPFP_OPENBINARY | TMPFP_AUTOREMOVE);
+  serializer = gt_genome_node_serializer_new(fp);
+  for (i = 0; !had_err && i < gt_array_size(nodes); i++) {
+    had_err = gt_genome_node_serializer_write(serializer,
+                                              *(GtGenomeNode**)
+                                              gt_array_get(nodes, i), err);
+  }
+
+  /* read them back and serialize them again */
+  refp = gt_xtmpfp_generic(NULL, TMPFP_OPENBINARY | TMPFP_AUTOREMOVE);
+  reserializer = gt_genome_node_serializer_new(refp);
+  if (!had_err) {
+    gt_genome_node_serializer_rewind(serializer);
+    i = 0;
+    while (!(had_err = gt_genome_node_serializer_read(serializer, &gn, err)) &&
+           gn) {
+      if (i < gt_array_size(nodes)) {
+        GtGenomeNode *orig = *(GtGenomeNode**) gt_array_get(nodes, i);
+        gt_ensure(gn->c_class == orig->c_class);
+        gt_ensure(gt_genome_node_get_line_number(gn) ==
+                  gt_genome_node_get_line_number(orig));
+        gt_ensure(!strcmp(gt_genome_node_get_filename(gn),
+                          gt_genome_node_get_filename(orig)));
+      }
+      if (!had_err)
+        had_err = gt_genome_node_serializer_write(reserializer, gn, err);
+      gt_genome_node_delete(gn);
+      i++;
+    }
+    gt_ensure(i == gt_array_size(nodes));
+  }
+  if (!had_err) {
+    gt_xfflush(refp);
+    gt_ensure(files_are_equal(fp, refp));
+  }
+
+  gt_genome_node_serializer_delete(reserializer);
+  gt_genome_node_serializer_delete(serializer);
+  gt_fa_xfclose(refp);
+  gt_fa_xfclose(fp);
+  for (i = 0; i < gt_array_size(nodes); i++)
+    gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(nodes, i));
+  gt_array_delete(nodes);
+  gt_str_delete(filename);
+  gt_str_delete(seqid);
+  return had_err;
+}
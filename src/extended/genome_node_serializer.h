@@ -0,0 +1,56 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef GENOME_NODE_SERIALIZER_H
+#define GENOME_NODE_SERIALIZER_H
+
+#include <stdio.h>
+#include "core/error_api.h"
+#include "extended/genome_node_api.h"
+
+/* A <GtGenomeNodeSerializer> writes <GtGenomeNode> objects (including complete
+   feature node graphs) to a binary file and reads them back. The format uses
+   the native byte order and is only meant for temporary files which are read
+   back by the same process (e.g., the sorted runs of a <GtSortStream>).
+   User data attached to the nodes is not serialized. */
+typedef struct GtGenomeNodeSerializer GtGenomeNodeSerializer;
+
+/* Return a new <GtGenomeNodeSerializer> object which reads from and writes to
+   <fp> (which must have been opened in binary mode). Does not take ownership
+   of <fp>. */
+GtGenomeNodeSerializer* gt_genome_node_serializer_new(FILE *fp);
+/* Append <gn> to the file of <serializer>. Returns -1 and sets <err> if <gn>
+   is of a node type which cannot be serialized, 0 otherwise. */
+int                     gt_genome_node_serializer_write(GtGenomeNodeSerializer
+                                                        *serializer,
+                                                        GtGenomeNode *gn,
+                                                        GtError *err);
+/* Rewind the file of <serializer> to read back the written nodes. */
+void                    gt_genome_node_serializer_rewind(GtGenomeNodeSerializer
+                                                         *serializer);
+/* Read the next node from the file of <serializer> and store it in <gn>.
+   <gn> is set to NULL if all nodes have been read. Returns -1 and sets <err>
+   if the file is corrupt, 0 otherwise. */
+int                     gt_genome_node_serializer_read(GtGenomeNodeSerializer
+                                                       *serializer,
+                                                       GtGenomeNode **gn,
+                                                       GtError *err);
+void                    gt_genome_node_serializer_delete(GtGenomeNodeSerializer
+                                                         *serializer);
+
+int                     gt_genome_node_serializer_unit_test(GtError *err);
+
+#endif
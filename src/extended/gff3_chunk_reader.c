@@ -0,0 +1,335 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <ctype.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/arena.h"
+#include "core/array.h"
+#include "core/assert_api.h"
+#include "core/ma.h"
+#include "core/ordered_ring.h"
+#include "core/unused_api.h"
+#include "extended/gff3_chunk_reader.h"
+
+/* number of bytes read at once */
+#define GT_GFF3_CHUNK_READER_CHUNKSIZE     (1UL << 20)
+/* number of chunks which can be read ahead per worker thread */
+#define GT_GFF3_CHUNK_READER_SLOTS_PER_JOB 4
+/* size of the arena chunks holding the lines of a chunk */
+#define GT_GFF3_CHUNK_READER_ARENASIZE     (1UL << 16)
+
+typedef struct GtGFF3ChunkLineEntry GtGFF3ChunkLineEntry;
+
+struct GtGFF3ChunkLineEntry {
+  GtGFF3ChunkLine line;
+  GtGFF3ChunkLineEntry *next;
+};
+
+typedef struct {
+  char *data;
+  size_t length;
+  GtArena *arena; /* the lines and their attribute tokens, which are all
+                     released together with the chunk */
+  GtGFF3ChunkLineEntry *lines;
+  bool last;
+} GtGFF3Chunk;
+
+struct GtGFF3ChunkReader {
+  GtFile *fpin;
+  char *carry;          /* incomplete line at the end of the last chunk read */
+  size_t carry_length;
+  bool eof_read;
+  GtOrderedRing *ring;
+  GtGFF3Chunk *current;
+  GtGFF3ChunkLineEntry *next_line, /* the next line of <current> to deliver */
+                       *last_line; /* the line delivered last */
+  bool unget_used;
+};
+
+static void gff3_chunk_delete(GtGFF3Chunk *chunk)
+{
+  if (!chunk) return;
+  gt_arena_delete(chunk->arena);
+  gt_free(chunk->data);
+  gt_free(chunk);
+}
+
+static char* gff3_chunk_last_newline(char *start, char *end)
+{
+  char *ptr;
+  for (ptr = end; ptr > start; ptr--) {
+    if (ptr[-1] == '\n')
+      return ptr - 1;
+  }
+  return NULL;
+}
+
+/* Read the next chunk of complete lines from the input file. */
+static void* gff3_chunk_reader_read(void *data, bool *last,
+                                    GT_UNUSED GtError *err)
+{
+  GtGFF3ChunkReader *reader = data;
+  GtGFF3Chunk *chunk;
+  char *newline;
+  size_t length, allocated;
+  int rval;
+  chunk = gt_calloc(1, sizeof *chunk);
+  chunk->arena = gt_arena_new(GT_GFF3_CHUNK_READER_ARENASIZE);
+  if (reader->eof_read) {
+    chunk->last = *last = true;
+    return chunk;
+  }
+  /* start with the incomplete line left over from the previous chunk */
+  chunk->data = reader->carry;
+  length = reader->carry_length;
+  allocated = length;
+  reader->carry = NULL;
+  reader->carry_length = 0;
+  for (;;) {
+    if (length + GT_GFF3_CHUNK_READER_CHUNKSIZE + 1 > allocated) {
+      allocated = length + GT_GFF3_CHUNK_READER_CHUNKSIZE + 1;
+      chunk->data = gt_realloc(chunk->data, allocated);
+    }
+    rval = gt_file_xread(reader->fpin, chunk->data + length,
+                         GT_GFF3_CHUNK_READER_CHUNKSIZE);
+    if (rval <= 0) {
+      /* keep an unterminated last line as part of the last chunk */
+      reader->eof_read = true;
+      chunk->last = true;
+      break;
+    }
+    newline = gff3_chunk_last_newline(chunk->data + length,
+                                      chunk->data + length + rval);
+    length += rval;
+    if (newline) {
+      /* carry the incomplete line over to the next chunk */
+      reader->carry_length = chunk->data + length - (newline + 1);
+      if (reader->carry_length) {
+        reader->carry = gt_malloc(reader->carry_length);
+        memcpy(reader->carry, newline + 1, reader->carry_length);
+      }
+      length = newline + 1 - chunk->data;
+      break;
+    }
+  }
+  chunk->length = length;
+  *last = chunk->last;
+  return chunk;
+}
+
+static void gff3_chunk_split_fields(GtGFF3ChunkLine *cl)
+{
+  char *ptr = cl->line, *end = cl->line + cl->length;
+  cl->nof_fields = 0;
+  for (;;) {
+    if (cl->nof_fields < GT_GFF3_CHUNK_READER_MAXFIELDS)
+      cl->fields[cl->nof_fields] = ptr;
+    cl->nof_fields++;
+    if (!(ptr = memchr(ptr, '\t', end - ptr)))
+      break;
+    ptr++;
+  }
+}
+
+/* Stores the attribute token starting at <ptr> in <attr> and returns the start
+   of the next token, or NULL if the token is the last one before <end>. */
+static char* gff3_chunk_next_attribute(char *ptr, char *end,
+                                       GtGFF3ChunkAttribute *attr)
+{
+  char *semicolon = memchr(ptr, ';', end - ptr);
+  attr->token = ptr;
+  attr->end = semicolon ? semicolon : end;
+  attr->equals = memchr(ptr, '=', attr->end - ptr);
+  if (!attr->equals)
+    attr->nof_equals = 0;
+  else {
+    attr->nof_equals = memchr(attr->equals + 1, '=',
+                              attr->end - (attr->equals + 1)) ? 2 : 1;
+  }
+  return semicolon ? semicolon + 1 : NULL;
+}
+
+void gt_gff3_chunk_split_attributes(char *start, char *end,
+                                    GtArray *attributes)
+{
+  GtGFF3ChunkAttribute attr;
+  char *ptr = start;
+  gt_assert(start && end && attributes);
+  do {
+    ptr = gff3_chunk_next_attribute(ptr, end, &attr);
+    gt_array_add(attributes, attr);
+  } while (ptr);
+}
+
+/* Parses the positive number at the start of the field <ptr> into <value>,
+   only the well-formed cases are accepted, all others are left to the
+   parser (which reports them). */
+static bool gff3_chunk_parse_position(const char *ptr, GtUword *value)
+{
+  GtWord val;
+  char *ep;
+  if (*ptr < '1' || *ptr > '9')
+    return false;
+  errno = 0;
+  val = strtol(ptr, &ep, 10);
+  if ((*ep != '\t' && *ep != '\0') || errno == ERANGE)
+    return false;
+  *value = val;
+  return true;
+}
+
+/* Parse the fields of a feature line which do not depend on the parser
+   state. */
+static void gff3_chunk_parse_feature_line(GtGFF3Chunk *chunk,
+                                          GtGFF3ChunkLine *cl)
+{
+  char *attributes_end, *ptr;
+  const char *score = cl->fields[5];
+  GtUword i;
+  cl->range_parsed = gff3_chunk_parse_position(cl->fields[3],
+                                               &cl->range.start) &&
+                     gff3_chunk_parse_position(cl->fields[4],
+                                               &cl->range.end) &&
+                     cl->range.start <= cl->range.end;
+  if (score[0] == '.' && score[1] == '\t') {
+    cl->score_parsed = true;
+    cl->score_is_defined = false;
+  }
+  else if (!isspace((unsigned char) score[0]) &&
+           sscanf(score, "%f", &cl->score) == 1) {
+    cl->score_parsed = cl->score_is_defined = true;
+  }
+  attributes_end = cl->nof_fields == GT_GFF3_CHUNK_READER_MAXFIELDS
+                   ? cl->fields[9] - 1 : cl->line + cl->length;
+  /* every ';' starts another token */
+  cl->nof_attributes = 1;
+  for (ptr = cl->fields[8];
+       (ptr = memchr(ptr, ';', attributes_end - ptr)) != NULL; ptr++) {
+    cl->nof_attributes++;
+  }
+  cl->attributes = gt_arena_alloc(chunk->arena, cl->nof_attributes *
+                                                sizeof *cl->attributes);
+  ptr = cl->fields[8];
+  for (i = 0; i < cl->nof_attributes; i++)
+    ptr = gff3_chunk_next_attribute(ptr, attributes_end, cl->attributes + i);
+}
+
+/* Split <chunk> into lines and the feature lines into their fields. */
+static int gff3_chunk_split(void *item, GT_UNUSED void *data,
+                            GT_UNUSED GtError *err)
+{
+  GtGFF3Chunk *chunk = item;
+  GtGFF3ChunkLineEntry *entry, **tail = &chunk->lines;
+  GtGFF3ChunkLine *cl;
+  char *ptr, *end, *newline;
+  ptr = chunk->data;
+  end = chunk->data + chunk->length;
+  while (ptr < end) {
+    entry = gt_arena_calloc(chunk->arena, 1, sizeof *entry);
+    cl = &entry->line;
+    newline = memchr(ptr, '\n', end - ptr);
+    cl->line = ptr;
+    cl->terminated = newline != NULL;
+    cl->length = (newline ? newline : end) - ptr;
+    ptr[cl->length] = '\0';
+    /* strip Windows newlines */
+    if (cl->terminated && cl->length && ptr[cl->length-1] == '\r')
+      ptr[--cl->length] = '\0';
+    if (cl->length && ptr[0] != '#' && ptr[0] != '>') {
+      gff3_chunk_split_fields(cl);
+      if (cl->nof_fields == 9 ||
+          cl->nof_fields == GT_GFF3_CHUNK_READER_MAXFIELDS) {
+        gff3_chunk_parse_feature_line(chunk, cl);
+      }
+    }
+    *tail = entry;
+    tail = &entry->next;
+    if (!newline)
+      break;
+    ptr = newline + 1;
+  }
+  return 0;
+}
+
+static void gff3_chunk_free(void *item)
+{
+  gff3_chunk_delete(item);
+}
+
+GtGFF3ChunkReader* gt_gff3_chunk_reader_new(GtFile *fpin,
+                                            unsigned int nof_threads,
+                                            GtError *err)
+{
+  GtGFF3ChunkReader *reader;
+  gt_error_check(err);
+  reader = gt_calloc(1, sizeof *reader);
+  reader->fpin = fpin;
+#ifndef GT_THREADS_ENABLED
+  nof_threads = 0;
+#endif
+  reader->ring = gt_ordered_ring_new(gff3_chunk_reader_read, gff3_chunk_split,
+                                     gff3_chunk_free, reader, nof_threads,
+                                     nof_threads *
+                                     GT_GFF3_CHUNK_READER_SLOTS_PER_JOB);
+  return reader;
+}
+
+int gt_gff3_chunk_reader_next(GtGFF3ChunkReader *reader,
+                              GtGFF3ChunkLine **line)
+{
+  gt_assert(reader && line);
+  if (reader->unget_used) {
+    gt_assert(reader->last_line);
+    reader->unget_used = false;
+    *line = &reader->last_line->line;
+    return 0;
+  }
+  while (!reader->next_line) {
+    void *chunk;
+    GT_UNUSED int had_err;
+    if (reader->current && reader->current->last)
+      return EOF;
+    gff3_chunk_delete(reader->current);
+    /* reading and splitting cannot fail */
+    had_err = gt_ordered_ring_next(reader->ring, &chunk, NULL);
+    gt_assert(!had_err && chunk);
+    reader->current = chunk;
+    reader->next_line = reader->current->lines;
+    reader->last_line = NULL;
+  }
+  reader->last_line = reader->next_line;
+  reader->next_line = reader->next_line->next;
+  *line = &reader->last_line->line;
+  return 0;
+}
+
+void gt_gff3_chunk_reader_unget(GtGFF3ChunkReader *reader)
+{
+  gt_assert(reader && !reader->unget_used && reader->last_line);
+  reader->unget_used = true;
+}
+
+void gt_gff3_chunk_reader_delete(GtGFF3ChunkReader *reader)
+{
+  if (!reader) return;
+  gt_ordered_ring_delete(reader->ring);
+  gff3_chunk_delete(reader->current);
+  gt_free(reader->carry);
+  gt_free(reader);
+}
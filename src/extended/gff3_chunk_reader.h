@@ -0,0 +1,91 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef GFF3_CHUNK_READER_H
+#define GFF3_CHUNK_READER_H
+
+#include "core/array.h"
+#include "core/file.h"
+#include "core/range_api.h"
+
+/* Maximal number of fields recorded for a pre-split line. A GFF3 feature line
+   has 9 fields, in tidy mode a superfluous 10th one is dropped. */
+#define GT_GFF3_CHUNK_READER_MAXFIELDS 10
+
+/* An attribute token of a pre-split feature line. The token is not
+   '\0'-terminated, it ends at <end> (the ';' terminating it or the end of the
+   attributes field). */
+typedef struct {
+  char *token,
+       *end,
+       *equals;             /* the first '=' in the token, NULL if none */
+  unsigned int nof_equals; /* 0, 1, or 2 for two and more */
+} GtGFF3ChunkAttribute;
+
+/* A line as delivered by a <GtGFF3ChunkReader>. */
+typedef struct {
+  char *line;        /* '\0'-terminated, without line terminator */
+  GtUword length,
+          nof_fields; /* number of tab separated fields if the line looks like
+                         a feature line, 0 otherwise */
+  char *fields[GT_GFF3_CHUNK_READER_MAXFIELDS]; /* the start positions of the
+                                                   first fields in <line>, the
+                                                   tabs in between are not
+                                                   overwritten */
+  GtGFF3ChunkAttribute *attributes; /* the tokens of the attributes field */
+  GtUword nof_attributes;           /* 0 unless the line has 9 or 10 fields */
+  GtRange range;     /* the parsed range, if <range_parsed> */
+  float score;       /* the parsed score, if <score_parsed> and
+                        <score_is_defined> */
+  bool range_parsed, /* the range is well-formed (positive and ordered) */
+       score_parsed,
+       score_is_defined,
+       terminated;   /* false for the last line of a file, if it is not
+                        terminated by a newline */
+} GtGFF3ChunkLine;
+
+/* A <GtGFF3ChunkReader> reads a GFF3 file in large chunks of complete lines.
+   The chunks are read and split into lines by a number of worker threads,
+   which also split the feature lines into their fields and attribute tokens
+   and parse their ranges and scores, while the lines are delivered in
+   their original order to a single consumer (i.e., the GFF3 parser). */
+typedef struct GtGFF3ChunkReader GtGFF3ChunkReader;
+
+/* Return a new <GtGFF3ChunkReader> which reads from <fpin> (<NULL> denotes
+   <stdin>) using <nof_threads> worker threads. <fpin> must not be read
+   otherwise as long as the reader exists. If threads are not enabled (or no
+   worker thread can be started), the chunks are read on demand by the calling
+   thread. */
+GtGFF3ChunkReader* gt_gff3_chunk_reader_new(GtFile *fpin,
+                                            unsigned int nof_threads,
+                                            GtError *err);
+/* Store the next line of <reader> in <line> and return 0. Return <EOF> if all
+   lines have been delivered. <line> stays valid until the next call of this
+   function. */
+int                gt_gff3_chunk_reader_next(GtGFF3ChunkReader *reader,
+                                             GtGFF3ChunkLine **line);
+/* Push back the last line returned by <reader>, so that it is delivered again
+   by the next call of <gt_gff3_chunk_reader_next()>. */
+void               gt_gff3_chunk_reader_unget(GtGFF3ChunkReader *reader);
+void               gt_gff3_chunk_reader_delete(GtGFF3ChunkReader *reader);
+
+/* Add the ';'-separated attribute tokens of the attributes field ranging from
+   <start> to <end> (exclusive) to <attributes> (which contains elements of
+   type <GtGFF3ChunkAttribute>). */
+void               gt_gff3_chunk_split_attributes(char *start, char *end,
+                                                  GtArray *attributes);
+
+#endif
@@ -77,6 +77,15 @@ void gt_gff3_in_stream_check_id_attributes(GtGFF3InStream *is)
                                               is->gff3_in_stream_plain);
 }
 
+void gt_gff3_in_stream_enable_parallel_parsing(GtGFF3InStream *is,
+                                               unsigned int nof_threads)
+{
+  gt_assert(is);
+  gt_gff3_in_stream_plain_enable_parallel_parsing((GtGFF3InStreamPlain*)
+                                                  is->gff3_in_stream_plain,
+                                                  nof_threads);
+}
+
 void gt_gff3_in_stream_show_progress_bar(GtGFF3InStream *is)
 {
   gt_assert(is);
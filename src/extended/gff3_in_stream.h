@@ -33,5 +33,10 @@ int                      gt_gff3_in_stream_set_offsetfile(GtNodeStream*, GtStr*,
 void                     gt_gff3_in_stream_disable_add_ids(GtNodeStream*);
 void                     gt_gff3_in_stream_fix_region_boundaries(
                                                                GtGFF3InStream*);
+/* Let <nof_threads> worker threads read and tokenize the input of the given
+   <GtGFF3InStream>. */
+void                     gt_gff3_in_stream_enable_parallel_parsing(
+                                                               GtGFF3InStream*,
+                                                     unsigned int nof_threads);
 
 #endif
@@ -24,6 +24,7 @@
 #include "core/progressbar.h"
 #include "core/str_array.h"
 #include "extended/genome_node.h"
+#include "extended/gff3_chunk_reader.h"
 #include "extended/gff3_in_stream_plain.h"
 #include "extended/gff3_parser.h"
 #include "extended/node_stream_api.h"
@@ -39,6 +40,8 @@ struct GtGFF3InStreamPlain {
        file_is_open,
        progress_bar;
   GtFile *fpin;
+  GtGFF3ChunkReader *chunk_reader;
+  unsigned int parsing_threads;
   GtUint64 line_number;
   GtQueue *genome_node_buffer;
   GtGFF3Parser *gff3_parser;
@@ -71,6 +74,26 @@ static int buffer_is_sorted(void **elem, void *info, GtError *err)
   return 0;
 }
 
+static int gff3_in_stream_plain_parse(GtGFF3InStreamPlain *is,
+                                      int *status_code, GtStr *filenamestr,
+                                      GtError *err)
+{
+  if (is->chunk_reader) {
+    return gt_gff3_parser_parse_genome_nodes_from_reader(is->gff3_parser,
+                                                         status_code,
+                                                       is->genome_node_buffer,
+                                                         is->used_types,
+                                                         filenamestr,
+                                                         &is->line_number,
+                                                         is->chunk_reader,
+                                                         err);
+  }
+  return gt_gff3_parser_parse_genome_nodes(is->gff3_parser, status_code,
+                                           is->genome_node_buffer,
+                                           is->used_types, filenamestr,
+                                           &is->line_number, is->fpin, err);
+}
+
 static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
                                      GtError *err)
 {
@@ -131,6 +154,14 @@ static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
                             gt_file_number_of_lines(gt_str_array_get(is->files,
                                                              is->next_file-1)));
       }
+      if (!had_err && is->parsing_threads) {
+        if (!(is->chunk_reader = gt_gff3_chunk_reader_new(is->fpin,
+                                                          is->parsing_threads,
+                                                          err))) {
+          had_err = -1;
+          break;
+        }
+      }
     }
 
     gt_assert(is->file_is_open);
@@ -139,19 +170,11 @@ static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
                   ? gt_str_array_get_str(is->files, is->next_file-1)
                   : is->stdinstr;
     /* read two nodes */
-    had_err = gt_gff3_parser_parse_genome_nodes(is->gff3_parser, &status_code,
-                                                is->genome_node_buffer,
-                                                is->used_types, filenamestr,
-                                                &is->line_number, is->fpin,
-                                                err);
+    had_err = gff3_in_stream_plain_parse(is, &status_code, filenamestr, err);
     if (had_err)
       break;
     if (status_code != EOF) {
-      had_err = gt_gff3_parser_parse_genome_nodes(is->gff3_parser, &status_code,
-                                                  is->genome_node_buffer,
-                                                  is->used_types, filenamestr,
-                                                  &is->line_number, is->fpin,
-                                                  err);
+      had_err = gff3_in_stream_plain_parse(is, &status_code, filenamestr, err);
       if (had_err)
         break;
     }
@@ -159,6 +182,8 @@ static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
     if (status_code == EOF) {
       /* end of current file */
       if (is->progress_bar) gt_progressbar_stop();
+      gt_gff3_chunk_reader_delete(is->chunk_reader);
+      is->chunk_reader = NULL;
       gt_file_delete(is->fpin);
       is->fpin = NULL;
       is->file_is_open = false;
@@ -203,6 +228,7 @@ static void gff3_in_stream_plain_free(GtNodeStream *ns)
   gt_queue_delete(gff3_in_stream_plain->genome_node_buffer);
   gt_gff3_parser_delete(gff3_in_stream_plain->gff3_parser);
   gt_cstr_table_delete(gff3_in_stream_plain->used_types);
+  gt_gff3_chunk_reader_delete(gff3_in_stream_plain->chunk_reader);
   gt_file_delete(gff3_in_stream_plain->fpin);
 }
 
@@ -254,6 +280,13 @@ void gt_gff3_in_stream_plain_do_not_check_region_boundaries(GtGFF3InStreamPlain
   gt_gff3_parser_do_not_check_region_boundaries(is->gff3_parser);
 }
 
+void gt_gff3_in_stream_plain_enable_parallel_parsing(GtGFF3InStreamPlain *is,
+                                                     unsigned int nof_threads)
+{
+  gt_assert(is && nof_threads);
+  is->parsing_threads = nof_threads;
+}
+
 void gt_gff3_in_stream_plain_show_progress_bar(GtGFF3InStreamPlain *is)
 {
   gt_assert(is);
@@ -39,6 +39,11 @@ void          gt_gff3_in_stream_plain_do_not_check_region_boundaries(
                                                           GtGFF3InStreamPlain*);
 void          gt_gff3_in_stream_plain_enable_tidy_mode(GtNodeStream*);
 void          gt_gff3_in_stream_plain_enable_strict_mode(GtNodeStream*);
+/* Split the input into chunks which are read and tokenized by <nof_threads>
+   worker threads, while the nodes are still built by a single thread. */
+void          gt_gff3_in_stream_plain_enable_parallel_parsing(
+                                                          GtGFF3InStreamPlain*,
+                                                    unsigned int nof_threads);
 void          gt_gff3_in_stream_plain_show_progress_bar(GtGFF3InStreamPlain*);
 void          gt_gff3_in_stream_plain_set_type_checker(GtNodeStream*,
                                                        GtTypeChecker*);
@@ -1187,33 +1187,32 @@ static bool invalid_uppercase_gvf_attribute(const char *attr_tag)
           strcmp(attr_tag, GT_GVF_ZYGOSITY));
 }
 
-static int parse_attributes(char *attributes, GtGenomeNode *feature_node,
+static int parse_attributes(GtGFF3ChunkAttribute *attributes,
+                            GtUword nof_attributes, GtGenomeNode *feature_node,
                             bool *is_child, GtGFF3Parser *parser,
                             const char *seqid, GtQueue *genome_nodes,
                             const char *filename, unsigned int line_number,
                             GtError *err)
 {
-  GtSplitter *attribute_splitter, *tmp_splitter, *parent_splitter;
+  GtSplitter *parent_splitter;
   char *id_value = NULL, *parent_value = NULL;
   GtUword i;
   int had_err = 0;
 
   gt_error_check(err);
-  gt_assert(attributes);
+  gt_assert(attributes && nof_attributes);
 
-  attribute_splitter = gt_splitter_new();
-  tmp_splitter = gt_splitter_new();
   parent_splitter = gt_splitter_new();
-  gt_splitter_split(attribute_splitter, attributes, strlen(attributes), ';');
 
-  for (i = 0; !had_err && i < gt_splitter_size(attribute_splitter); i++) {
+  for (i = 0; !had_err && i < nof_attributes; i++) {
     const char *old_value;
     bool attr_valid = true;
     char *attr_tag = NULL,
          *attr_value = NULL,
-         *token = gt_splitter_get_token(attribute_splitter, i);
+         *token = attributes[i].token;
+    *attributes[i].end = '\0';
     if (strncmp(token, ".", 1) == 0) {
-      if (gt_splitter_size(attribute_splitter) > 1) {
+      if (nof_attributes > 1) {
         gt_error_set(err, "more than one attribute token defined on line %u in "
                      "file \"%s\", although the first one is '.'", line_number,
                      filename);
@@ -1225,10 +1224,8 @@ static int parse_attributes(char *attributes, GtGenomeNode *feature_node,
     else if (is_blank_attribute(token))
       continue;
     else {
-      gt_splitter_reset(tmp_splitter);
-      gt_splitter_split(tmp_splitter, token, strlen(token), '=');
-      if (gt_splitter_size(tmp_splitter) != 2) {
-        if (parser->tidy && gt_splitter_size(tmp_splitter) == 1) {
+      if (attributes[i].nof_equals != 1) {
+        if (parser->tidy && attributes[i].nof_equals == 0) {
           gt_warning("token \"%s\" on line %u in file \"%s\" does not "
                      "contain exactly one '='", token, line_number, filename);
           continue;
@@ -1241,7 +1238,8 @@ static int parse_attributes(char *attributes, GtGenomeNode *feature_node,
         }
       }
       else {
-        attr_tag = gt_splitter_get_token(tmp_splitter, 0);
+        *attributes[i].equals = '\0';
+        attr_tag = token;
         /* Skip leading blanks of attribute tag.
            Iit is not mentioned in the GFF3 spec that attribute tags cannot
            start with blanks, but if a Parent or ID attribute is prepended by a
@@ -1253,7 +1251,7 @@ static int parse_attributes(char *attributes, GtGenomeNode *feature_node,
            construction. */
         while (attr_tag[0] == ' ')
           attr_tag++;
-        attr_value = gt_splitter_get_token(tmp_splitter, 1);
+        attr_value = attributes[i].equals + 1;
       }
     }
     if (!had_err && !strlen(attr_tag)) {
@@ -1454,8 +1452,6 @@ static int parse_attributes(char *attributes, GtGenomeNode *feature_node,
   }
 
   gt_splitter_delete(parent_splitter);
-  gt_splitter_delete(tmp_splitter);
-  gt_splitter_delete(attribute_splitter);
 
   return had_err;
 }
@@ -1491,11 +1487,12 @@ void chomp_seqid(char *seqid, const char *filename, unsigned int line_number)
 static int parse_gff3_feature_line(GtGFF3Parser *parser,
                                    GtQueue *genome_nodes,
                                    GtCstrTable *used_types, char *line,
-                                   size_t line_length, GtStr *filenamestr,
+                                   size_t line_length, GtGFF3ChunkLine *cl,
+                                   GtStr *filenamestr,
                                    unsigned int line_number, GtError *err)
 {
   GtGenomeNode *gn = NULL, *feature_node = NULL;
-  GtSplitter *splitter;
+  GtSplitter *splitter = NULL;
   GtStr *seqid_str = NULL;
   GtStrand gt_strand_value;
   float score_value;
@@ -1505,6 +1502,7 @@ static int parse_gff3_feature_line(GtGFF3Parser *parser,
        *end = NULL, *score = NULL, *strand = NULL, *phase = NULL,
        *attributes = NULL, **tokens;
   const char *filename;
+  GtUword nof_fields;
   bool score_is_defined, is_child = false;
   int had_err = 0;
 
@@ -1512,13 +1510,25 @@ static int parse_gff3_feature_line(GtGFF3Parser *parser,
 
   filename = gt_str_get(filenamestr);
 
-  /* create splitter */
-  splitter = gt_splitter_new();
+  if (cl) {
+    GtUword i;
+    /* the line has already been split by a <GtGFF3ChunkReader>, only the tabs
+       have to be replaced */
+    nof_fields = cl->nof_fields;
+    for (i = 1; i < nof_fields && i < GT_GFF3_CHUNK_READER_MAXFIELDS; i++)
+      cl->fields[i][-1] = '\0';
+    tokens = cl->fields;
+  }
+  else {
+    splitter = gt_splitter_new();
+    gt_splitter_split(splitter, line, line_length, '\t');
+    nof_fields = gt_splitter_size(splitter);
+    tokens = gt_splitter_get_tokens(splitter);
+  }
 
   /* parse */
-  gt_splitter_split(splitter, line, line_length, '\t');
-  if (gt_splitter_size(splitter) != 9) {
-    if (parser->tidy && gt_splitter_size(splitter) == 10) {
+  if (nof_fields != 9) {
+    if (parser->tidy && nof_fields == 10) {
       gt_warning("line %u in file \"%s\" does not contain 9 tab (\\t) "
                  "separated fields, dropping 10th field",
                  line_number, filename);
@@ -1530,7 +1540,6 @@ static int parse_gff3_feature_line(GtGFF3Parser *parser,
     }
   }
   if (!had_err) {
-    tokens = gt_splitter_get_tokens(splitter);
     seqid      = tokens[0];
     source     = tokens[1];
     type       = tokens[2];
@@ -1563,7 +1572,9 @@ static int parse_gff3_feature_line(GtGFF3Parser *parser,
 
   /* parse the range */
   if (!had_err) {
-    if (parser->strict)
+    if (cl && cl->range_parsed)
+      range = cl->range; /* well-formed, parsed by the chunk reader */
+    else if (parser->strict)
       had_err = gt_parse_range(&range, start, end, line_number, filename, err);
     else if (parser->tidy) {
       had_err = gt_parse_range_tidy(&range, start, end, line_number, filename,
@@ -1586,8 +1597,14 @@ static int parse_gff3_feature_line(GtGFF3Parser *parser,
 
   /* parse the score */
   if (!had_err) {
-    had_err = gt_parse_score(&score_is_defined, &score_value, score,
-                             line_number, filename, err);
+    if (cl && cl->score_parsed) {
+      score_is_defined = cl->score_is_defined;
+      score_value = cl->score;
+    }
+    else {
+      had_err = gt_parse_score(&score_is_defined, &score_value, score,
+                               line_number, filename, err);
+    }
   }
 
   /* parse the strand */
@@ -1627,8 +1644,22 @@ static int parse_gff3_feature_line(GtGFF3Parser *parser,
 
   /* parse the attributes */
   if (!had_err) {
-    had_err = parse_attributes(attributes, feature_node, &is_child, parser,
-                               seqid, genome_nodes, filename, line_number, err);
+    if (cl) {
+      had_err = parse_attributes(cl->attributes, cl->nof_attributes,
+                                 feature_node, &is_child, parser, seqid,
+                                 genome_nodes, filename, line_number, err);
+    }
+    else {
+      GtArray *attribute_tokens = gt_array_new(sizeof (GtGFF3ChunkAttribute));
+      gt_gff3_chunk_split_attributes(attributes,
+                                     attributes + strlen(attributes),
+                                     attribute_tokens);
+      had_err = parse_attributes(gt_array_get_space(attribute_tokens),
+                                 gt_array_size(attribute_tokens), feature_node,
+                                 &is_child, parser, seqid, genome_nodes,
+                                 filename, line_number, err);
+      gt_array_delete(attribute_tokens);
+    }
   }
 
   if (!had_err && score_is_defined)
@@ -1731,7 +1762,9 @@ static int parse_first_gff3_line(const char *line, const char *filename,
 static int gff3_parser_parse_fasta_entry(GtQueue *genome_nodes,
                                          const char *line, GtStr *filename,
                                          unsigned int line_number,
-                                         GtFile *fpin, GtError *err)
+                                         GtFile *fpin,
+                                         GtGFF3ChunkReader *reader,
+                                         GtError *err)
 {
   int had_err = 0;
   gt_error_check(err);
@@ -1744,18 +1777,38 @@ static int gff3_parser_parse_fasta_entry(GtQueue *genome_nodes,
   if (!had_err) {
     GtGenomeNode *sequence_node;
     GtStr *sequence = gt_str_new();
+    /* copy the description, reading from <reader> can invalidate <line> */
+    char *description = gt_cstr_dup(line+1);
     int cc;
-    while ((cc = gt_file_xfgetc(fpin)) != EOF) {
-      if (cc == '>') {
-        gt_file_unget_char(fpin, cc);
-        break;
+    if (reader) {
+      GtGFF3ChunkLine *cl;
+      GtUword i;
+      while (gt_gff3_chunk_reader_next(reader, &cl) != EOF) {
+        if (cl->line[0] == '>') {
+          gt_gff3_chunk_reader_unget(reader);
+          break;
+        }
+        for (i = 0; i < cl->length; i++) {
+          cc = cl->line[i];
+          if (cc != '\r' && cc != ' ')
+            gt_str_append_char(sequence, cc);
+        }
+      }
+    }
+    else {
+      while ((cc = gt_file_xfgetc(fpin)) != EOF) {
+        if (cc == '>') {
+          gt_file_unget_char(fpin, cc);
+          break;
+        }
+        if (cc != '\n' && cc != '\r' && cc != ' ')
+          gt_str_append_char(sequence, cc);
       }
-      if (cc != '\n' && cc != '\r' && cc != ' ')
-        gt_str_append_char(sequence, cc);
     }
-    sequence_node = gt_sequence_node_new(line+1, sequence);
+    sequence_node = gt_sequence_node_new(description, sequence);
     gt_genome_node_set_origin(sequence_node, filename, line_number);
     gt_queue_add(genome_nodes, sequence_node);
+    gt_free(description);
     gt_str_delete(sequence);
   }
   return had_err;
@@ -2102,15 +2155,42 @@ static int parse_meta_gff3_line(GtGFF3Parser *parser, GtQueue *genome_nodes,
   return had_err;
 }
 
-int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
-                                      GtQueue *genome_nodes,
-                                      GtCstrTable *used_types,
-                                      GtStr *filenamestr,
-                                      GtUint64 *line_number,
-                                      GtFile *fpin, GtError *err)
+/* Read the next line from <reader>, if given, and from <fpin> otherwise. */
+static int gff3_parser_next_line(GtFile *fpin, GtGFF3ChunkReader *reader,
+                                 GtStr *line_buffer, char **line,
+                                 size_t *line_length, GtGFF3ChunkLine **cl)
+{
+  if (reader) {
+    /* an unterminated last line is ignored, as by
+       <gt_str_read_next_line_generic()> */
+    if (gt_gff3_chunk_reader_next(reader, cl) == EOF || !(*cl)->terminated)
+      return EOF;
+    *line = (*cl)->line;
+    *line_length = (*cl)->length;
+    return 0;
+  }
+  *cl = NULL;
+  gt_str_reset(line_buffer);
+  if (gt_str_read_next_line_generic(line_buffer, fpin) == EOF)
+    return EOF;
+  *line = gt_str_get(line_buffer);
+  *line_length = gt_str_length(line_buffer);
+  return 0;
+}
+
+static int gff3_parser_parse_genome_nodes(GtGFF3Parser *parser,
+                                          int *status_code,
+                                          GtQueue *genome_nodes,
+                                          GtCstrTable *used_types,
+                                          GtStr *filenamestr,
+                                          GtUint64 *line_number,
+                                          GtFile *fpin,
+                                          GtGFF3ChunkReader *reader,
+                                          GtError *err)
 {
   size_t line_length;
   GtStr *line_buffer;
+  GtGFF3ChunkLine *cl;
   char *line;
   const char *filename;
   int rval, had_err = 0;
@@ -2123,9 +2203,8 @@ int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
   /* init */
   line_buffer = gt_str_new();
 
-  while ((rval = gt_str_read_next_line_generic(line_buffer, fpin)) != EOF) {
-    line = gt_str_get(line_buffer);
-    line_length = gt_str_length(line_buffer);
+  while ((rval = gff3_parser_next_line(fpin, reader, line_buffer, &line,
+                                       &line_length, &cl)) != EOF) {
     (*line_number)++;
 
     if (*line_number == 1) {
@@ -2135,7 +2214,6 @@ int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
       if (had_err == -1) /* error */
         break;
       if (had_err == 1) { /* line processed */
-        gt_str_reset(line_buffer);
         had_err = 0;
         continue;
       }
@@ -2148,7 +2226,7 @@ int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
     else if (parser->fasta_parsing || line[0] == '>') {
       parser->fasta_parsing = true;
       had_err = gff3_parser_parse_fasta_entry(genome_nodes, line, filenamestr,
-                                              *line_number, fpin, err);
+                                              *line_number, fpin, reader, err);
       break;
     }
     else if (line[0] == '#') {
@@ -2161,12 +2239,11 @@ int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
     }
     else {
       had_err = parse_gff3_feature_line(parser, genome_nodes, used_types, line,
-                                        line_length, filenamestr, *line_number,
-                                        err);
+                                        line_length, cl, filenamestr,
+                                        *line_number, err);
       if (had_err || (!parser->incomplete_node && gt_queue_size(genome_nodes)))
         break;
     }
-    gt_str_reset(line_buffer);
   }
 
   if (!had_err && rval == EOF && *line_number == 0) {
@@ -2203,6 +2280,33 @@ int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
   return had_err;
 }
 
+int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
+                                      GtQueue *genome_nodes,
+                                      GtCstrTable *used_types,
+                                      GtStr *filenamestr,
+                                      GtUint64 *line_number,
+                                      GtFile *fpin, GtError *err)
+{
+  return gff3_parser_parse_genome_nodes(parser, status_code, genome_nodes,
+                                        used_types, filenamestr, line_number,
+                                        fpin, NULL, err);
+}
+
+int gt_gff3_parser_parse_genome_nodes_from_reader(GtGFF3Parser *parser,
+                                                  int *status_code,
+                                                  GtQueue *genome_nodes,
+                                                  GtCstrTable *used_types,
+                                                  GtStr *filenamestr,
+                                                  GtUint64 *line_number,
+                                                  GtGFF3ChunkReader *reader,
+                                                  GtError *err)
+{
+  gt_assert(reader);
+  return gff3_parser_parse_genome_nodes(parser, status_code, genome_nodes,
+                                        used_types, filenamestr, line_number,
+                                        NULL, reader, err);
+}
+
 void gt_gff3_parser_reset(GtGFF3Parser *parser)
 {
   gt_assert(parser);
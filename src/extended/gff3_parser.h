@@ -18,10 +18,21 @@
 #ifndef GFF3_PARSER_H
 #define GFF3_PARSER_H
 
+#include "extended/gff3_chunk_reader.h"
 #include "extended/gff3_parser_api.h"
 
 void gt_gff3_parser_enable_strict_mode(GtGFF3Parser*);
 int  gt_gff3_parser_set_offsetfile(GtGFF3Parser*, GtStr*, GtError*);
+/* Like <gt_gff3_parser_parse_genome_nodes()>, but the lines are taken from
+   <reader>, which has already split them in parallel. */
+int  gt_gff3_parser_parse_genome_nodes_from_reader(GtGFF3Parser *gff3_parser,
+                                                   int *status_code,
+                                                   GtQueue *genome_nodes,
+                                                   GtCstrTable *used_types,
+                                                   GtStr *filenamestr,
+                                                   GtUint64 *line_number,
+                                                   GtGFF3ChunkReader *reader,
+                                                   GtError *err);
 int  gt_gff3_parser_parse_target_attributes(const char *values,
                                             GtUword *num_of_targets,
                                             GtStr *first_target_id,
@@ -27,16 +27,20 @@
 #include "core/array2dim_api.h"
 #include "core/assert_api.h"
 #ifdef GT_THREADS_ENABLED
-#include "core/thread_api.h"
+#include "core/thread_pool.h"
 #endif
 #include "core/unused_api.h"
 #include "core/divmodmul.h"
+#include "core/ensure.h"
+#include "core/mathsupport.h"
 #include "match/squarededist.h"
 #include "extended/alignment.h"
 #include "extended/maxcoordvalue.h"
 #include "extended/reconstructalignment.h"
 #include "extended/squarealign.h"
 
+#include "extended/linearalign_simd.h"
+
 #include "extended/linearalign.h"
 #define LINEAR_EDIST_GAP          ((GtUchar) UCHAR_MAX)
 
@@ -125,9 +129,16 @@ static GtUword evaluateallEDtabRtabcolumns(GtUword *EDtabcolumn,
                                            GtUword vstart,
                                            GtUword vlen)
 {
-  GtUword gapcost, colindex;
+  GtUword gapcost, colindex, distance;
   gt_assert(scorehandler && EDtabcolumn && Rtabcolumn);
 
+  if (gt_linearalign_simd_evaluate(scorehandler, useq, ustart, ulen,
+                                   vseq, vstart, vlen, midcol,
+                                   &distance, Rtabcolumn + ulen))
+  {
+    EDtabcolumn[ulen] = distance;
+    return distance;
+  }
   gapcost = gt_scorehandler_get_gapscore(scorehandler);
   firstEDtabRtabcolumn(EDtabcolumn, Rtabcolumn, ulen, gapcost);
 
@@ -261,7 +272,7 @@ static GtUword evaluatelinearcrosspoints(GtLinspaceManagement *spacemanager,
 {
   GtUword midrow, midcol, distance, *EDtabcolumn = NULL, *Rtabcolumn = NULL;
 #ifdef GT_THREADS_ENABLED
-  GtThread *t1 = NULL, *t2 = NULL;
+  GtTaskGroup *group;
   GtLinearCrosspointthreadinfo threadinfo1, threadinfo2;
 #endif
 
@@ -334,8 +345,9 @@ static GtUword evaluatelinearcrosspoints(GtLinspaceManagement *spacemanager,
                                                    Ctab, rowoffset,
                                                    threadidx, threadcount);
       (*threadcount)++;
-      t1 = gt_thread_new(evaluatelinearcrosspoints_thread_caller,
-                         &threadinfo1, NULL);
+      group = gt_task_group_new(gt_thread_pool_get());
+      gt_task_group_submit(group, evaluatelinearcrosspoints_thread_caller,
+                           &threadinfo1);
 
       threadinfo2 = set_LinearCrosspointthreadinfo(spacemanager, scorehandler,
                                                    useq, ustart + midrow,
@@ -347,15 +359,13 @@ static GtUword evaluatelinearcrosspoints(GtLinspaceManagement *spacemanager,
                                                    threadidx + GT_DIV2(midcol),
                                                    threadcount);
       (*threadcount)++;
-      t2 = gt_thread_new(evaluatelinearcrosspoints_thread_caller,
-                         &threadinfo2, NULL);
-
-      gt_thread_join(t1);
+      /* the bottom right corner is computed by this thread while the upper
+         left one can be taken by an idle worker */
+      (void) evaluatelinearcrosspoints_thread_caller(&threadinfo2);
       (*threadcount)--;
-      gt_thread_join(t2);
+      gt_task_group_join(group);
       (*threadcount)--;
-      gt_thread_delete(t1);
-      gt_thread_delete(t2);
+      gt_task_group_delete(group);
     }
 #endif
     return distance;
@@ -866,3 +876,58 @@ void gt_linearalign_check_local(GT_UNUSED bool forward,
   }
   gt_alignment_delete(align);
 }
+
+/* compares the SIMD kernels with the scalar evaluation of the columns */
+int gt_linearalign_unit_test(GtError *err)
+{
+  static const GtWord costs[][3] = {{0, 1, 1}, {0, 4, 3}, {2, 3, 1}};
+  static const char *alphabets[] = {"acgt", "ACDEFGHIKLMNPQRSTVWY"};
+  GtUword i, j, ulen, vlen, midcol, alphasize, distance[2], midrow[2],
+          *EDtabcolumn, *Rtabcolumn;
+  GtScoreHandler *scorehandler;
+  GtUchar *useq, *vseq;
+  int had_err = 0, simd;
+  gt_error_check(err);
+
+  useq = gt_malloc(sizeof *useq * 500);
+  vseq = gt_malloc(sizeof *vseq * 500);
+  EDtabcolumn = gt_malloc(sizeof *EDtabcolumn * 501);
+  Rtabcolumn = gt_malloc(sizeof *Rtabcolumn * 501);
+  for (i = 0; !had_err && i < 300UL; i++)
+  {
+    const char *alphabet = alphabets[i % 2];
+    alphasize = strlen(alphabet);
+    ulen = 1 + gt_rand_max(499);
+    vlen = 2 + gt_rand_max(498);
+    midcol = gt_rand_max(vlen);
+    for (j = 0; j < ulen; j++)
+      useq[j] = (GtUchar) alphabet[gt_rand_max(alphasize - 1)];
+    /* mostly similar sequences */
+    for (j = 0; j < vlen; j++)
+    {
+      vseq[j] = j < ulen && gt_rand_max(3) > 0
+                  ? useq[j] : (GtUchar) alphabet[gt_rand_max(alphasize - 1)];
+    }
+    scorehandler = gt_scorehandler_new(costs[i % 3][0], costs[i % 3][1], 0,
+                                       costs[i % 3][2]);
+    gt_scorehandler_plain(scorehandler);
+    for (simd = 0; simd < 2; simd++)
+    {
+      gt_linearalign_simd_enable(simd ? true : false);
+      distance[simd] = evaluateallEDtabRtabcolumns(EDtabcolumn, Rtabcolumn,
+                                                   scorehandler, midcol,
+                                                   useq, 0, ulen,
+                                                   vseq, 0, vlen);
+      midrow[simd] = Rtabcolumn[ulen];
+    }
+    gt_ensure(distance[0] == distance[1]);
+    gt_ensure(midrow[0] == midrow[1]);
+    gt_scorehandler_delete(scorehandler);
+  }
+  gt_linearalign_simd_enable(true);
+  gt_free(useq);
+  gt_free(vseq);
+  gt_free(EDtabcolumn);
+  gt_free(Rtabcolumn);
+  return had_err;
+}
@@ -19,14 +19,17 @@
 #include <string.h>
 #include "core/assert_api.h"
 #include "core/divmodmul.h"
+#include "core/ensure.h"
 #include "core/error.h"
 #include "core/ma_api.h"
+#include "core/mathsupport.h"
 #include "core/minmax.h"
 #ifdef GT_THREADS_ENABLED
-#include "core/thread_api.h"
+#include "core/thread_pool.h"
 #endif
 #include "core/types_api.h"
 #include "extended/affinealign.h"
+#include "extended/linearalign_simd.h"
 #include "extended/maxcoordvalue.h"
 #include "extended/reconstructalignment.h"
 
@@ -262,6 +265,14 @@ static GtUword evaluateallAtabRtabcolumns(GtAffinealignDPentry *Atabcolumn,
 {
   GtUword colindex, gap_opening, gap_extension;
 
+  if (gt_linearalign_simd_evaluate_affine(scorehandler, useq, ustart, ulen,
+                                          vseq, vstart, vlen, midcolumn, edge,
+                                          Atabcolumn + ulen, Rtabcolumn + ulen))
+  {
+    return MIN3(Atabcolumn[ulen].Rvalue,
+                Atabcolumn[ulen].Dvalue,
+                Atabcolumn[ulen].Ivalue);
+  }
   gap_opening = gt_scorehandler_get_gap_opening(scorehandler);
   gap_extension = gt_scorehandler_get_gapscore(scorehandler);
 
@@ -409,8 +420,8 @@ static GtUword evaluateaffinecrosspoints(GtLinspaceManagement *spacemanager,
   GtAffineAlignRtabentry *Rtabcolumn = NULL;
 
 #ifdef GT_THREADS_ENABLED
-  GtThread *t1 = NULL, *t2 = NULL;
-  GtAffineCrosspointthreadinfo threadinfo1, threadinfo2;
+  GtTaskGroup *group = NULL;
+  GtAffineCrosspointthreadinfo threadinfo1;
 #endif
 
   if (vlen >= 2UL)
@@ -495,8 +506,9 @@ static GtUword evaluateaffinecrosspoints(GtLinspaceManagement *spacemanager,
                                                        from_edge, midtype,
                                                        threadcount);
             (*threadcount)++;
-            t1 = gt_thread_new(evaluateaffinecrosspoints_thread_caller,
-                               &threadinfo1, NULL);
+            group = gt_task_group_new(gt_thread_pool_get());
+            gt_task_group_submit(group, evaluateaffinecrosspoints_thread_caller,
+                                 &threadinfo1);
           }
 #endif
           break;
@@ -524,8 +536,9 @@ static GtUword evaluateaffinecrosspoints(GtLinspaceManagement *spacemanager,
                                                       threadcount);
 
            (*threadcount)++;
-           t1 = gt_thread_new(evaluateaffinecrosspoints_thread_caller,
-                               &threadinfo1, NULL);
+           group = gt_task_group_new(gt_thread_pool_get());
+           gt_task_group_submit(group, evaluateaffinecrosspoints_thread_caller,
+                                &threadinfo1);
           }
 #endif
           break;
@@ -543,47 +556,20 @@ static GtUword evaluateaffinecrosspoints(GtLinspaceManagement *spacemanager,
                 gt_assert(false);
       }
     }
-   /*bottom right corner */
-#ifdef GT_THREADS_ENABLED
-    if (*threadcount + 1 > gt_jobs)
-    {
-#endif
-      (void) evaluateaffinecrosspoints(spacemanager, scorehandler,
-                                          useq, ustart+midrow, ulen-midrow,
-                                          vseq, vstart+midcol, vlen-midcol,
-                                          Ctab+midcol,rowoffset+midrow,
-                                          midtype, to_edge, threadcount);
+   /* bottom right corner, computed by this thread while the upper left
+      one can be taken by an idle worker */
+    (void) evaluateaffinecrosspoints(spacemanager, scorehandler,
+                                     useq, ustart+midrow, ulen-midrow,
+                                     vseq, vstart+midcol, vlen-midcol,
+                                     Ctab+midcol,rowoffset+midrow,
+                                     midtype, to_edge, threadcount);
 #ifdef GT_THREADS_ENABLED
-    }
-    else
-    {
-      threadinfo2 = set_AffineCrosspointthreadinfo(spacemanager, scorehandler,
-                                                   useq, ustart + midrow,
-                                                   ulen - midrow,
-                                                   vseq, vstart + midcol,
-                                                   vlen - midcol,
-                                                   Ctab + midcol,
-                                                   rowoffset + midrow,
-                                                   midtype, to_edge,
-                                                   threadcount);
-      (*threadcount)++;
-      t2 = gt_thread_new(evaluateaffinecrosspoints_thread_caller,
-                         &threadinfo2, NULL);
-    }
-
-    if (t1 != NULL)
-    {
-      gt_thread_join(t1);
-      (*threadcount)--;
-      gt_thread_delete(t1);
-    }
-    if (t2 != NULL)
+    if (group != NULL)
     {
-      gt_thread_join(t2);
+      gt_task_group_join(group);
       (*threadcount)--;
-      gt_thread_delete(t2);
+      gt_task_group_delete(group);
     }
-
 #endif
     return distance;
   }
@@ -1223,3 +1209,71 @@ void gt_linearalign_affinegapcost_check_local(GT_UNUSED bool forward,
   }
   gt_alignment_delete(align);
 }
+
+/* compares the SIMD kernels with the scalar evaluation of the columns */
+int gt_linearalign_affinegapcost_unit_test(GtError *err)
+{
+  static const GtWord costs[][4] = {{0, 1, 3, 1}, {0, 4, 5, 2}, {1, 3, 0, 1}};
+  static const char *alphabets[] = {"acgt", "ACDEFGHIKLMNPQRSTVWY"};
+  GtAffinealignDPentry *Atabcolumn, lastentry[2];
+  GtAffineAlignRtabentry *Rtabcolumn, lastrtabentry[2];
+  GtUword i, j, ulen, vlen, midcol, alphasize, distance[2];
+  GtAffineAlignEdge edge;
+  GtScoreHandler *scorehandler;
+  GtUchar *useq, *vseq;
+  int had_err = 0, simd;
+  gt_error_check(err);
+
+  useq = gt_malloc(sizeof *useq * 500);
+  vseq = gt_malloc(sizeof *vseq * 500);
+  Atabcolumn = gt_malloc(sizeof *Atabcolumn * 501);
+  Rtabcolumn = gt_malloc(sizeof *Rtabcolumn * 501);
+  for (i = 0; !had_err && i < 300UL; i++)
+  {
+    const char *alphabet = alphabets[i % 2];
+    alphasize = strlen(alphabet);
+    ulen = 1 + gt_rand_max(499);
+    vlen = 2 + gt_rand_max(498);
+    midcol = gt_rand_max(vlen);
+    edge = (GtAffineAlignEdge) (i % 4);
+    for (j = 0; j < ulen; j++)
+      useq[j] = (GtUchar) alphabet[gt_rand_max(alphasize - 1)];
+    /* mostly similar sequences */
+    for (j = 0; j < vlen; j++)
+    {
+      vseq[j] = j < ulen && gt_rand_max(3) > 0
+                  ? useq[j] : (GtUchar) alphabet[gt_rand_max(alphasize - 1)];
+    }
+    scorehandler = gt_scorehandler_new(costs[i % 3][0], costs[i % 3][1],
+                                       costs[i % 3][2], costs[i % 3][3]);
+    gt_scorehandler_plain(scorehandler);
+    for (simd = 0; simd < 2; simd++)
+    {
+      gt_linearalign_simd_enable(simd ? true : false);
+      distance[simd] = evaluateallAtabRtabcolumns(Atabcolumn, Rtabcolumn,
+                                                  scorehandler,
+                                                  useq, 0, ulen,
+                                                  vseq, 0, vlen,
+                                                  midcol, edge);
+      lastentry[simd] = Atabcolumn[ulen];
+      lastrtabentry[simd] = Rtabcolumn[ulen];
+    }
+    gt_ensure(distance[0] == distance[1]);
+    gt_ensure(lastentry[0].Rvalue == lastentry[1].Rvalue);
+    gt_ensure(lastentry[0].Dvalue == lastentry[1].Dvalue);
+    gt_ensure(lastentry[0].Ivalue == lastentry[1].Ivalue);
+    gt_ensure(lastrtabentry[0].val_R.idx == lastrtabentry[1].val_R.idx);
+    gt_ensure(lastrtabentry[0].val_R.edge == lastrtabentry[1].val_R.edge);
+    gt_ensure(lastrtabentry[0].val_D.idx == lastrtabentry[1].val_D.idx);
+    gt_ensure(lastrtabentry[0].val_D.edge == lastrtabentry[1].val_D.edge);
+    gt_ensure(lastrtabentry[0].val_I.idx == lastrtabentry[1].val_I.idx);
+    gt_ensure(lastrtabentry[0].val_I.edge == lastrtabentry[1].val_I.edge);
+    gt_scorehandler_delete(scorehandler);
+  }
+  gt_linearalign_simd_enable(true);
+  gt_free(useq);
+  gt_free(vseq);
+  gt_free(Atabcolumn);
+  gt_free(Rtabcolumn);
+  return had_err;
+}
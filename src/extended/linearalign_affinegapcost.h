@@ -135,4 +135,6 @@ void            gt_linearalign_affinegapcost_check_local(GT_UNUSED bool forward,
                                                          GtUword ulen,
                                                          const GtUchar *vseq,
                                                          GtUword vlen);
+
+int             gt_linearalign_affinegapcost_unit_test(GtError *err);
 #endif
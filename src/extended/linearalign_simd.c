@@ -0,0 +1,464 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+#include "core/assert_api.h"
+#include "core/ma.h"
+#include "core/minmax.h"
+#include "extended/linearalign_simd.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GT_LINEARALIGN_SIMD_X86
+#include <immintrin.h>
+#endif
+
+/* sequences shorter than this are aligned by the scalar implementation */
+#define GT_LINEARALIGN_SIMD_MINULEN      32UL
+/* maximal number of different characters in <vseq>, each one needs a profile
+   of <ulen> bytes */
+#define GT_LINEARALIGN_SIMD_MAXPROFILES  32UL
+/* costs are 32-bit lane values, this is used as infinity */
+#define GT_LINEARALIGN_SIMD_INF          ((int32_t) 1 << 30)
+#define GT_LINEARALIGN_SIMD_MAXGAPCOST   ((GtWord) 1 << 15)
+
+/* index of <row> (counting from 0) in a striped column */
+#define GT_LINEARALIGN_SIMD_STRIPED(ROW, SEGLEN, LANES)\
+        ((ROW) % (SEGLEN) * (LANES) + (ROW) / (SEGLEN))
+/* crossing point entries of the affine kernel are packed into 32 bits */
+#define GT_LINEARALIGN_SIMD_PACK(IDX, EDGE)  ((int32_t) ((IDX) << 2 | (EDGE)))
+#define GT_LINEARALIGN_SIMD_IDX(V)           ((GtUword) (V) >> 2)
+#define GT_LINEARALIGN_SIMD_EDGE(V)          ((GtAffineAlignEdge) ((V) & 3))
+
+typedef enum {
+  GT_LINEARALIGN_SIMD_SCALAR,
+  GT_LINEARALIGN_SIMD_SSE41,
+  GT_LINEARALIGN_SIMD_AVX2
+} GtLinearalignSimdKernel;
+
+/* Replacement costs of the rows of <useq> in striped order, one profile per
+   character of <vseq>, built on first use. */
+typedef struct {
+  const GtScoreHandler *scorehandler;
+  const GtUchar *useq;
+  GtUword ustart,
+          ulen,
+          lanes,
+          seglen,
+          nof_profiles;
+  unsigned char *profiles;
+  int profileidx[UCHAR_MAX + 1];
+} GtLinearalignSimdProfile;
+
+typedef struct {
+  int32_t *R, *D, *I,   /* distance values */
+          *tR, *tD, *tI; /* packed crossing point entries */
+} GtLinearalignSimdAffineColumn;
+
+static bool linearalign_simd_enabled = true;
+
+void gt_linearalign_simd_enable(bool enable)
+{
+  linearalign_simd_enabled = enable;
+}
+
+static GtLinearalignSimdKernel linearalign_simd_kernel(void)
+{
+  if (!linearalign_simd_enabled)
+    return GT_LINEARALIGN_SIMD_SCALAR;
+#ifdef GT_LINEARALIGN_SIMD_X86
+  if (__builtin_cpu_supports("avx2"))
+    return GT_LINEARALIGN_SIMD_AVX2;
+  if (__builtin_cpu_supports("sse4.1"))
+    return GT_LINEARALIGN_SIMD_SSE41;
+#endif
+  return GT_LINEARALIGN_SIMD_SCALAR;
+}
+
+const char* gt_linearalign_simd_kernel_name(void)
+{
+  switch (linearalign_simd_kernel()) {
+    case GT_LINEARALIGN_SIMD_AVX2:
+      return "avx2";
+    case GT_LINEARALIGN_SIMD_SSE41:
+      return "sse4.1";
+    default:
+      return "scalar";
+  }
+}
+
+/* Checks whether the replacement costs of <scorehandler> for the given
+   sequences fit into the profiles and prepares <profile>. Stores the maximal
+   replacement cost in <maxcost>. */
+static bool linearalign_simd_profile_init(GtLinearalignSimdProfile *profile,
+                                          const GtScoreHandler *scorehandler,
+                                          const GtUchar *useq,
+                                          GtUword ustart,
+                                          GtUword ulen,
+                                          const GtUchar *vseq,
+                                          GtUword vstart,
+                                          GtUword vlen,
+                                          GtUword lanes,
+                                          GtUword *maxcost)
+{
+  bool uchars[UCHAR_MAX + 1] = {false}, vchars[UCHAR_MAX + 1] = {false};
+  GtUword idx, a, b, nof_vchars = 0;
+  GtWord cost;
+
+  if (ulen < GT_LINEARALIGN_SIMD_MINULEN)
+    return false;
+  for (idx = 0; idx < ulen; idx++)
+    uchars[useq[ustart + idx]] = true;
+  for (idx = 0; idx < vlen; idx++)
+  {
+    if (!vchars[vseq[vstart + idx]])
+    {
+      vchars[vseq[vstart + idx]] = true;
+      if (++nof_vchars > GT_LINEARALIGN_SIMD_MAXPROFILES)
+        return false;
+    }
+  }
+  *maxcost = 0;
+  for (a = 0; a <= UCHAR_MAX; a++)
+  {
+    if (!uchars[a])
+      continue;
+    for (b = 0; b <= UCHAR_MAX; b++)
+    {
+      if (!vchars[b])
+        continue;
+      cost = gt_scorehandler_get_replacement(scorehandler, (GtUchar) a,
+                                             (GtUchar) b);
+      if (cost < 0 || cost > UCHAR_MAX)
+        return false;
+      *maxcost = MAX(*maxcost, (GtUword) cost);
+    }
+  }
+  profile->scorehandler = scorehandler;
+  profile->useq = useq;
+  profile->ustart = ustart;
+  profile->ulen = ulen;
+  profile->lanes = lanes;
+  profile->seglen = (ulen + lanes - 1) / lanes;
+  profile->nof_profiles = 0;
+  profile->profiles = gt_calloc(nof_vchars * profile->seglen * lanes,
+                                sizeof *profile->profiles);
+  for (b = 0; b <= UCHAR_MAX; b++)
+    profile->profileidx[b] = -1;
+  return true;
+}
+
+#ifdef GT_LINEARALIGN_SIMD_X86
+
+static const unsigned char* linearalign_simd_profile(GtLinearalignSimdProfile
+                                                     *profile, GtUchar b)
+{
+  const GtUword size = profile->seglen * profile->lanes;
+  unsigned char *prof;
+  GtUword row;
+
+  if (profile->profileidx[b] < 0)
+  {
+    prof = profile->profiles + profile->nof_profiles * size;
+    /* padding rows keep cost 0 */
+    for (row = 0; row < profile->ulen; row++)
+    {
+      prof[GT_LINEARALIGN_SIMD_STRIPED(row, profile->seglen, profile->lanes)]
+        = (unsigned char) gt_scorehandler_get_replacement(
+                               profile->scorehandler,
+                               profile->useq[profile->ustart + row], b);
+    }
+    profile->profileidx[b] = (int) profile->nof_profiles++;
+  }
+  return profile->profiles + (GtUword) profile->profileidx[b] * size;
+}
+
+static inline int32_t linearalign_simd_add(int32_t value, int32_t cost)
+{
+  return value == GT_LINEARALIGN_SIMD_INF ? value : value + cost;
+}
+
+static inline int32_t linearalign_simd_min3(int32_t a, int32_t b, int32_t c)
+{
+  return MIN(MIN(a, b), c);
+}
+
+static void linearalign_simd_affine_column_init(GtLinearalignSimdAffineColumn
+                                                *column, int32_t *space,
+                                                GtUword size)
+{
+  column->R = space;
+  column->D = column->R + size;
+  column->I = column->D + size;
+  column->tR = column->I + size;
+  column->tD = column->tR + size;
+  column->tI = column->tD + size;
+}
+
+/* Initializes the first column (in <prev>) and the crossing point entries of
+   both columns like firstAtabRtabcolumn() in linearalign_affinegapcost.c. The
+   values of row 0 are stored in <p0>, its crossing point entries in <t0>. */
+static void linearalign_simd_affine_firstcolumn(GtLinearalignSimdAffineColumn
+                                                *prev,
+                                                GtLinearalignSimdAffineColumn
+                                                *cur,
+                                                int32_t *p0,
+                                                int32_t *t0,
+                                                GtUword seglen,
+                                                GtUword lanes,
+                                                int32_t gap_opening,
+                                                int32_t gap_extension,
+                                                GtAffineAlignEdge edge)
+{
+  int32_t prevR, prevD;
+  GtUword row, k;
+
+  p0[0] = p0[1] = p0[2] = GT_LINEARALIGN_SIMD_INF;
+  switch (edge) {
+    case Affine_R:
+      p0[0] = 0;
+      break;
+    case Affine_D:
+      p0[1] = 0;
+      break;
+    case Affine_I:
+      p0[2] = 0;
+      break;
+    default:
+      p0[0] = 0;
+      p0[1] = p0[2] = gap_opening;
+  }
+  t0[0] = GT_LINEARALIGN_SIMD_PACK(0, Affine_R);
+  t0[1] = GT_LINEARALIGN_SIMD_PACK(0, Affine_D);
+  t0[2] = GT_LINEARALIGN_SIMD_PACK(0, Affine_I);
+  prevR = p0[0];
+  prevD = p0[1];
+  for (row = 1; row <= seglen * lanes; row++)
+  {
+    k = GT_LINEARALIGN_SIMD_STRIPED(row - 1, seglen, lanes);
+    prev->R[k] = prev->I[k] = GT_LINEARALIGN_SIMD_INF;
+    prev->D[k] = linearalign_simd_min3(
+                   linearalign_simd_add(prevR, gap_opening + gap_extension),
+                   linearalign_simd_add(prevD, gap_extension),
+                   linearalign_simd_add(prevD, gap_opening + gap_extension));
+    prevR = prev->R[k];
+    prevD = prev->D[k];
+    prev->tR[k] = cur->tR[k] = GT_LINEARALIGN_SIMD_PACK(row, Affine_R);
+    prev->tD[k] = cur->tD[k] = GT_LINEARALIGN_SIMD_PACK(row, Affine_D);
+    prev->tI[k] = cur->tI[k] = GT_LINEARALIGN_SIMD_PACK(row, Affine_I);
+  }
+}
+
+static GtWord linearalign_simd_affine_value(int32_t value)
+{
+  return value == GT_LINEARALIGN_SIMD_INF ? GT_WORD_MAX : (GtWord) value;
+}
+
+static void linearalign_simd_affine_rnode(GtAffineAlignRnode *rnode,
+                                          int32_t packed)
+{
+  rnode->idx = GT_LINEARALIGN_SIMD_IDX(packed);
+  rnode->edge = GT_LINEARALIGN_SIMD_EDGE(packed);
+}
+
+static void linearalign_simd_affine_result(GtAffinealignDPentry *lastentry,
+                                           GtAffineAlignRtabentry
+                                           *lastrtabentry,
+                                           const GtLinearalignSimdAffineColumn
+                                           *column, GtUword k)
+{
+  lastentry->Rvalue = linearalign_simd_affine_value(column->R[k]);
+  lastentry->Dvalue = linearalign_simd_affine_value(column->D[k]);
+  lastentry->Ivalue = linearalign_simd_affine_value(column->I[k]);
+  lastentry->Redge = lastentry->Dedge = lastentry->Iedge = Affine_X;
+  linearalign_simd_affine_rnode(&lastrtabentry->val_R, column->tR[k]);
+  linearalign_simd_affine_rnode(&lastrtabentry->val_D, column->tD[k]);
+  linearalign_simd_affine_rnode(&lastrtabentry->val_I, column->tI[k]);
+}
+
+#define GT_SIMD_NAME(N)        N##_sse41
+#define GT_SIMD_TARGET         __attribute__((target("sse4.1")))
+#define GT_SIMD_LANES          4UL
+#define GT_SIMD_VEC            __m128i
+#define GT_SIMD_SET1(X)        _mm_set1_epi32(X)
+#define GT_SIMD_LOAD(P)        _mm_loadu_si128((const __m128i *) (P))
+#define GT_SIMD_STORE(P,V)     _mm_storeu_si128((__m128i *) (P), V)
+#define GT_SIMD_ADD(A,B)       _mm_add_epi32(A, B)
+#define GT_SIMD_MIN(A,B)       _mm_min_epi32(A, B)
+#define GT_SIMD_GT(A,B)        _mm_cmpgt_epi32(A, B)
+#define GT_SIMD_EQ(A,B)        _mm_cmpeq_epi32(A, B)
+#define GT_SIMD_AND(A,B)       _mm_and_si128(A, B)
+#define GT_SIMD_OR(A,B)        _mm_or_si128(A, B)
+#define GT_SIMD_BLEND(A,B,M)   _mm_blendv_epi8(A, B, M)
+#define GT_SIMD_ANY(M)         (_mm_movemask_epi8(M) != 0)
+#define GT_SIMD_ALL(M)         (_mm_movemask_epi8(M) == 0xffff)
+#define GT_SIMD_SHIFT_IN(V,X)  _mm_insert_epi32(_mm_slli_si128(V, 4), X, 0)
+#define GT_SIMD_PROFILE(P)     _mm_cvtepu8_epi32(\
+                                 _mm_cvtsi32_si128(*(const int32_t *) (P)))
+#include "extended/linearalign_simd.inc"
+#undef GT_SIMD_NAME
+#undef GT_SIMD_TARGET
+#undef GT_SIMD_LANES
+#undef GT_SIMD_VEC
+#undef GT_SIMD_SET1
+#undef GT_SIMD_LOAD
+#undef GT_SIMD_STORE
+#undef GT_SIMD_ADD
+#undef GT_SIMD_MIN
+#undef GT_SIMD_GT
+#undef GT_SIMD_EQ
+#undef GT_SIMD_AND
+#undef GT_SIMD_OR
+#undef GT_SIMD_BLEND
+#undef GT_SIMD_ANY
+#undef GT_SIMD_ALL
+#undef GT_SIMD_SHIFT_IN
+#undef GT_SIMD_PROFILE
+
+#define GT_SIMD_NAME(N)        N##_avx2
+#define GT_SIMD_TARGET         __attribute__((target("avx2")))
+#define GT_SIMD_LANES          8UL
+#define GT_SIMD_VEC            __m256i
+#define GT_SIMD_SET1(X)        _mm256_set1_epi32(X)
+#define GT_SIMD_LOAD(P)        _mm256_loadu_si256((const __m256i *) (P))
+#define GT_SIMD_STORE(P,V)     _mm256_storeu_si256((__m256i *) (P), V)
+#define GT_SIMD_ADD(A,B)       _mm256_add_epi32(A, B)
+#define GT_SIMD_MIN(A,B)       _mm256_min_epi32(A, B)
+#define GT_SIMD_GT(A,B)        _mm256_cmpgt_epi32(A, B)
+#define GT_SIMD_EQ(A,B)        _mm256_cmpeq_epi32(A, B)
+#define GT_SIMD_AND(A,B)       _mm256_and_si256(A, B)
+#define GT_SIMD_OR(A,B)        _mm256_or_si256(A, B)
+#define GT_SIMD_BLEND(A,B,M)   _mm256_blendv_epi8(A, B, M)
+#define GT_SIMD_ANY(M)         (_mm256_movemask_epi8(M) != 0)
+#define GT_SIMD_ALL(M)         (_mm256_movemask_epi8(M) == -1)
+#define GT_SIMD_SHIFT_IN(V,X)  _mm256_blend_epi32(\
+                                 _mm256_permutevar8x32_epi32(V,\
+                                   _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6)),\
+                                 _mm256_set1_epi32(X), 1)
+#define GT_SIMD_PROFILE(P)     _mm256_cvtepu8_epi32(\
+                                 _mm_loadl_epi64((const __m128i *) (P)))
+#include "extended/linearalign_simd.inc"
+
+#endif
+
+bool gt_linearalign_simd_evaluate(const GtScoreHandler *scorehandler,
+                                  const GtUchar *useq,
+                                  GtUword ustart,
+                                  GtUword ulen,
+                                  const GtUchar *vseq,
+                                  GtUword vstart,
+                                  GtUword vlen,
+                                  GtUword midcolumn,
+                                  GtUword *distance,
+                                  GtUword *midrow)
+{
+  GtLinearalignSimdKernel kernel = linearalign_simd_kernel();
+  GtLinearalignSimdProfile profile;
+  GtUword maxcost;
+  GtWord gapcost;
+
+  gt_assert(scorehandler && distance && midrow);
+  if (kernel == GT_LINEARALIGN_SIMD_SCALAR)
+    return false;
+  gapcost = gt_scorehandler_get_gapscore(scorehandler);
+  if (gapcost < 0 || gapcost > GT_LINEARALIGN_SIMD_MAXGAPCOST ||
+      !linearalign_simd_profile_init(&profile, scorehandler, useq, ustart,
+                                     ulen, vseq, vstart, vlen,
+                                     kernel == GT_LINEARALIGN_SIMD_AVX2
+                                       ? 8UL : 4UL, &maxcost)) {
+    return false;
+  }
+  /* all values (including those of the padding rows) must fit into 32 bits */
+  if ((profile.seglen * profile.lanes + vlen + 1) *
+      MAX(maxcost, (GtUword) gapcost) >= (GtUword) GT_LINEARALIGN_SIMD_INF)
+  {
+    gt_free(profile.profiles);
+    return false;
+  }
+#ifdef GT_LINEARALIGN_SIMD_X86
+  if (kernel == GT_LINEARALIGN_SIMD_AVX2)
+  {
+    linearalign_simd_linear_avx2(&profile, vseq, vstart, vlen, midcolumn,
+                                 (int32_t) gapcost, distance, midrow);
+  }
+  else
+  {
+    linearalign_simd_linear_sse41(&profile, vseq, vstart, vlen, midcolumn,
+                                  (int32_t) gapcost, distance, midrow);
+  }
+#endif
+  gt_free(profile.profiles);
+  return true;
+}
+
+bool gt_linearalign_simd_evaluate_affine(const GtScoreHandler *scorehandler,
+                                         const GtUchar *useq,
+                                         GtUword ustart,
+                                         GtUword ulen,
+                                         const GtUchar *vseq,
+                                         GtUword vstart,
+                                         GtUword vlen,
+                                         GtUword midcolumn,
+                                         GtAffineAlignEdge edge,
+                                         GtAffinealignDPentry *lastentry,
+                                         GtAffineAlignRtabentry *lastrtabentry)
+{
+  GtLinearalignSimdKernel kernel = linearalign_simd_kernel();
+  GtLinearalignSimdProfile profile;
+  GtUword maxcost;
+  GtWord gap_opening, gap_extension;
+
+  gt_assert(scorehandler && lastentry && lastrtabentry);
+  if (kernel == GT_LINEARALIGN_SIMD_SCALAR)
+    return false;
+  gap_opening = gt_scorehandler_get_gap_opening(scorehandler);
+  gap_extension = gt_scorehandler_get_gapscore(scorehandler);
+  if (gap_opening < 0 || gap_opening > GT_LINEARALIGN_SIMD_MAXGAPCOST ||
+      gap_extension < 0 || gap_extension > GT_LINEARALIGN_SIMD_MAXGAPCOST ||
+      !linearalign_simd_profile_init(&profile, scorehandler, useq, ustart,
+                                     ulen, vseq, vstart, vlen,
+                                     kernel == GT_LINEARALIGN_SIMD_AVX2
+                                       ? 8UL : 4UL, &maxcost)) {
+    return false;
+  }
+  /* the crossing points are packed with the edge into 32 bits */
+  if (profile.seglen * profile.lanes >= ((GtUword) 1 << 29) ||
+      (profile.seglen * profile.lanes + vlen + 2) *
+      (maxcost + (GtUword) (gap_opening + gap_extension))
+      >= (GtUword) GT_LINEARALIGN_SIMD_INF)
+  {
+    gt_free(profile.profiles);
+    return false;
+  }
+#ifdef GT_LINEARALIGN_SIMD_X86
+  if (kernel == GT_LINEARALIGN_SIMD_AVX2)
+  {
+    linearalign_simd_affine_avx2(&profile, vseq, vstart, vlen, midcolumn,
+                                 (int32_t) gap_opening, (int32_t) gap_extension,
+                                 edge, lastentry, lastrtabentry);
+  }
+  else
+  {
+    linearalign_simd_affine_sse41(&profile, vseq, vstart, vlen, midcolumn,
+                                  (int32_t) gap_opening,
+                                  (int32_t) gap_extension,
+                                  edge, lastentry, lastrtabentry);
+  }
+#endif
+  gt_free(profile.profiles);
+  return true;
+}
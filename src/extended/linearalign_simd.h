@@ -0,0 +1,75 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef LINEARALIGN_SIMD_H
+#define LINEARALIGN_SIMD_H
+
+#include <stdbool.h>
+#include "core/types_api.h"
+#include "extended/linearalign_affinegapcost.h"
+#include "extended/scorehandler.h"
+
+/* This module contains striped (Farrar-style) SIMD versions of the column
+   evaluation used to find the crossing points of a global alignment in linear
+   space. The kernels are selected at runtime (AVX2 or SSE4.1 on x86) and
+   compute exactly the same distances and crossing points as the scalar
+   implementations in linearalign.c and linearalign_affinegapcost.c, including
+   the way ties are broken. All functions return false if no kernel can be
+   used for the given input, in which case the caller falls back to its scalar
+   implementation. */
+
+/* Evaluates all DP columns of <useq>[<ustart>..<ustart>+<ulen>-1] against
+   <vseq>[<vstart>..<vstart>+<vlen>-1] with linear gap costs given by
+   <scorehandler> and stores the distance in <distance> and the row in which
+   an optimal path crosses column <midcolumn> in <midrow>. */
+bool        gt_linearalign_simd_evaluate(const GtScoreHandler *scorehandler,
+                                         const GtUchar *useq,
+                                         GtUword ustart,
+                                         GtUword ulen,
+                                         const GtUchar *vseq,
+                                         GtUword vstart,
+                                         GtUword vlen,
+                                         GtUword midcolumn,
+                                         GtUword *distance,
+                                         GtUword *midrow);
+
+/* Like <gt_linearalign_simd_evaluate>, but for affine gap costs. The alignment
+   starts with an edge of type <edge>. The DP entry and the crossing point
+   entry of the last row of the last column are stored in <lastentry> and
+   <lastrtabentry>. */
+bool        gt_linearalign_simd_evaluate_affine(const GtScoreHandler
+                                                *scorehandler,
+                                                const GtUchar *useq,
+                                                GtUword ustart,
+                                                GtUword ulen,
+                                                const GtUchar *vseq,
+                                                GtUword vstart,
+                                                GtUword vlen,
+                                                GtUword midcolumn,
+                                                GtAffineAlignEdge edge,
+                                                GtAffinealignDPentry
+                                                *lastentry,
+                                                GtAffineAlignRtabentry
+                                                *lastrtabentry);
+
+/* Enables or disables the use of the SIMD kernels (enabled by default). */
+void        gt_linearalign_simd_enable(bool enable);
+
+/* Returns the name of the kernel used for new computations ("avx2", "sse4.1"
+   or "scalar"). */
+const char* gt_linearalign_simd_kernel_name(void);
+
+#endif
@@ -16,8 +16,10 @@
 */
 
 #include <stdio.h>
+#include "core/chardef.h"
 #include "core/encseq.h"
 #include "core/ma.h"
+#include "core/minmax.h"
 #include "core/seq.h"
 #include "core/score_function.h"
 #include "core/unused_api.h"
@@ -34,13 +36,23 @@ const GtMatchIteratorClass* gt_match_iterator_sw_class(void);
 #define gt_match_iterator_sw_cast(M)\
         gt_match_iterator_cast(gt_match_iterator_sw_class(), M)
 
+/* number of sequences of <es2> aligned with a sequence of <es1> at once */
+#define GT_MATCH_ITERATOR_SW_BATCHSIZE  256UL
+
 typedef struct {
   GtScoreFunction *sf;
   GtEncseq *es1, *es2;
   GtUword seqno_es1,
-                seqno_es2,
-                min_len,
-                max_edist;
+          seqno_es2,
+          min_len,
+          max_edist,
+          batchsize,
+          batchpos;
+  GtSeq *seq_a,
+        **seqs_b;
+  GtAlignment **alignments;
+  char *a, *b;
+  GtUword a_size, b_size;
   bool firstali;
 } GtMatchIteratorSWMembers;
 
@@ -49,59 +61,185 @@ struct GtMatchIteratorSW {
   GtMatchIteratorSWMembers *pvt;
 };
 
+/* Return a lower bound for the score of a local alignment of at least
+   <min_len> columns with at most <max_edist> of them not being identities and
+   at most <max_wildcards> of them being identities of wildcards. Characters
+   decoded from an encoded sequence are identical if and only if they have the
+   same code. */
+static GtWord match_iterator_sw_min_score(const GtScoreFunction *sf,
+                                          unsigned int u_alpha_size,
+                                          unsigned int v_alpha_size,
+                                          GtUword min_len, GtUword max_edist,
+                                          GtUword max_wildcards)
+{
+  const int **scores = gt_score_function_get_scores(sf);
+  GtWord minid = GT_WORD_MAX, minwildcard, minother, bound = GT_WORD_MAX,
+         edist[3], wildcards = (GtWord) max_wildcards;
+  unsigned int c, d;
+  int i;
+
+  for (c = 0; c + 1 < MIN(u_alpha_size, v_alpha_size); c++)
+    minid = MIN(minid, (GtWord) scores[c][c]);
+  minwildcard = (GtWord) scores[u_alpha_size - 1][v_alpha_size - 1];
+  if (wildcards > 0 && minwildcard > 0) {
+    /* wildcard identities are just identities */
+    minid = MIN(minid, minwildcard);
+    wildcards = 0;
+  }
+  if (minid <= 0) {
+    /* arbitrarily long alignments of any score may pass */
+    return 1;
+  }
+  minother = MIN(gt_score_function_get_deletion_score(sf),
+                 gt_score_function_get_insertion_score(sf));
+  for (c = 0; c < u_alpha_size; c++) {
+    for (d = 0; d < v_alpha_size; d++)
+      minother = MIN(minother, (GtWord) scores[c][d]);
+  }
+  /* the bound is piecewise linear in the number of non-identities */
+  edist[0] = 0;
+  edist[1] = MIN(MAX((GtWord) min_len - wildcards, 0), (GtWord) max_edist);
+  edist[2] = (GtWord) max_edist;
+  for (i = 0; i < 3; i++) {
+    GtWord identities = MAX((GtWord) min_len - edist[i] - wildcards, 0);
+    bound = MIN(bound, identities * minid + wildcards * MIN(minwildcard, 0)
+                       + edist[i] * minother);
+  }
+  return MAX(bound, 1);
+}
+
+static GtUword match_iterator_sw_count_wildcards(GtSeq *seq)
+{
+  const GtUchar *enc;
+  GtUword i, count = 0;
+  if (!gt_seq_length(seq))
+    return 0;
+  enc = gt_seq_get_encoded(seq);
+  for (i = 0; i < gt_seq_length(seq); i++) {
+    if (enc[i] == WILDCARD)
+      count++;
+  }
+  return count;
+}
+
+static void match_iterator_sw_delete_batch(GtMatchIteratorSWMembers *pvt)
+{
+  GtUword k;
+  for (k = 0; k < pvt->batchsize; k++) {
+    gt_alignment_delete(pvt->alignments[k]);
+    pvt->alignments[k] = NULL;
+    gt_seq_delete(pvt->seqs_b[k]);
+  }
+  pvt->batchsize = pvt->batchpos = 0;
+}
+
+/* Align the current sequence of <es1> with the next batch of sequences of
+   <es2>, starting with <seqno_es2>. Only alignments which may pass the
+   filter criteria are computed. */
+static void match_iterator_sw_align_batch(GtMatchIteratorSWMembers *pvt)
+{
+  GtUword k, seqlen, seqpos, offset, total, wildcards = 0;
+
+  pvt->batchsize = MIN(GT_MATCH_ITERATOR_SW_BATCHSIZE,
+                       gt_encseq_num_of_sequences(pvt->es2) - pvt->seqno_es2);
+  for (total = 0, k = 0; k < pvt->batchsize; k++)
+    total += gt_encseq_seqlength(pvt->es2, pvt->seqno_es2 + k);
+  if (!pvt->b || total > pvt->b_size) {
+    pvt->b = gt_realloc(pvt->b, sizeof (char) * MAX(total, 1UL));
+    pvt->b_size = total;
+  }
+  for (offset = 0, k = 0; k < pvt->batchsize; k++) {
+    seqlen = gt_encseq_seqlength(pvt->es2, pvt->seqno_es2 + k);
+    if (seqlen) {
+      seqpos = gt_encseq_seqstartpos(pvt->es2, pvt->seqno_es2 + k);
+      gt_encseq_extract_decoded(pvt->es2, pvt->b + offset, seqpos,
+                                seqpos + seqlen - 1);
+    }
+    pvt->seqs_b[k] = gt_seq_new(pvt->b + offset, seqlen,
+                                gt_encseq_alphabet(pvt->es2));
+    wildcards = MAX(wildcards,
+                    match_iterator_sw_count_wildcards(pvt->seqs_b[k]));
+    offset += seqlen;
+  }
+  /* wildcard identities are limited by the wildcards of both sequences */
+  if (wildcards)
+    wildcards = MIN(wildcards, match_iterator_sw_count_wildcards(pvt->seq_a));
+  gt_swalign_batch(pvt->alignments, pvt->seq_a, pvt->seqs_b, pvt->batchsize,
+                   pvt->sf,
+                   match_iterator_sw_min_score(pvt->sf,
+                             gt_alphabet_size(gt_encseq_alphabet(pvt->es1)),
+                             gt_alphabet_size(gt_encseq_alphabet(pvt->es2)),
+                             pvt->min_len, pvt->max_edist, wildcards));
+  pvt->batchpos = 0;
+}
+
+static void match_iterator_sw_load_query(GtMatchIteratorSWMembers *pvt)
+{
+  GtUword seqlen, seqpos;
+  gt_seq_delete(pvt->seq_a);
+  seqlen = gt_encseq_seqlength(pvt->es1, pvt->seqno_es1);
+  if (!pvt->a || seqlen > pvt->a_size) {
+    pvt->a = gt_realloc(pvt->a, sizeof (char) * MAX(seqlen, 1UL));
+    pvt->a_size = seqlen;
+  }
+  if (seqlen) {
+    seqpos = gt_encseq_seqstartpos(pvt->es1, pvt->seqno_es1);
+    gt_encseq_extract_decoded(pvt->es1, pvt->a, seqpos, seqpos + seqlen - 1);
+  }
+  pvt->seq_a = gt_seq_new(pvt->a, seqlen, gt_encseq_alphabet(pvt->es1));
+}
+
 static GtMatchIteratorStatus gt_match_iterator_sw_next(GtMatchIterator *mi,
                                                       GT_UNUSED GtMatch **match,
                                                       GT_UNUSED GtError *err)
 {
   GtMatchIteratorSW *mis;
-  GtSeq *seq_a, *seq_b;
-  char *a, *b;
+  GtMatchIteratorSWMembers *pvt;
   const char *adesc, *bdesc;
   GtAlignment *ali = NULL;
-  GtUword seqlen_a, seqlen_b, seqpos;
+  GtUword seqlen_a, seqlen_b, seqno_b;
   GtRange arng, brng;
   gt_assert(mi && match);
 
   mis = gt_match_iterator_sw_cast(mi);
+  pvt = mis->pvt;
   while (true) {
-    if (!mis->pvt->firstali)
-      mis->pvt->seqno_es2++;
-    if (mis->pvt->seqno_es2 == gt_encseq_num_of_sequences(mis->pvt->es2)) {
-      mis->pvt->seqno_es1++;
-      if (mis->pvt->seqno_es1 == gt_encseq_num_of_sequences(mis->pvt->es1))
-        return GT_MATCHER_STATUS_END;
-      mis->pvt->seqno_es2 = 0;
+    if (pvt->batchpos == pvt->batchsize) {
+      if (pvt->firstali) {
+        if (!gt_encseq_num_of_sequences(pvt->es1) ||
+            !gt_encseq_num_of_sequences(pvt->es2)) {
+          return GT_MATCHER_STATUS_END;
+        }
+        match_iterator_sw_load_query(pvt);
+        pvt->firstali = false;
+      }
+      else {
+        pvt->seqno_es2 += pvt->batchsize;
+        match_iterator_sw_delete_batch(pvt);
+        if (pvt->seqno_es2 == gt_encseq_num_of_sequences(pvt->es2)) {
+          pvt->seqno_es1++;
+          if (pvt->seqno_es1 == gt_encseq_num_of_sequences(pvt->es1))
+            return GT_MATCHER_STATUS_END;
+          pvt->seqno_es2 = 0;
+          match_iterator_sw_load_query(pvt);
+        }
+      }
+      match_iterator_sw_align_batch(pvt);
     }
-    seqlen_a = gt_encseq_seqlength(mis->pvt->es1, mis->pvt->seqno_es1);
-    seqlen_b = gt_encseq_seqlength(mis->pvt->es2, mis->pvt->seqno_es2);
-    /* XXX: reuse buffers for performance improvement */
-    a = gt_malloc(seqlen_a * sizeof (char));
-    seqpos = gt_encseq_seqstartpos(mis->pvt->es1, mis->pvt->seqno_es1);
-    gt_encseq_extract_decoded(mis->pvt->es1, a, seqpos, seqpos + seqlen_a - 1);
-    b = gt_malloc(seqlen_b * sizeof (char));
-    seqpos = gt_encseq_seqstartpos(mis->pvt->es2, mis->pvt->seqno_es2);
-    gt_encseq_extract_decoded(mis->pvt->es1, b, seqpos, seqpos + seqlen_b - 1);
-    seq_a = gt_seq_new(a, seqlen_a, gt_encseq_alphabet(mis->pvt->es1));
-    seq_b = gt_seq_new(b, seqlen_b, gt_encseq_alphabet(mis->pvt->es2));
-    ali = gt_swalign(seq_a, seq_b, mis->pvt->sf);
-    mis->pvt->firstali = false;
-    if (ali && gt_alignment_get_length(ali) >= mis->pvt->min_len
-          && gt_alignment_eval(ali) <= mis->pvt->max_edist) {
+    ali = pvt->alignments[pvt->batchpos++];
+    if (ali && gt_alignment_get_length(ali) >= pvt->min_len
+          && gt_alignment_eval(ali) <= pvt->max_edist) {
       break;
     }
-    gt_alignment_delete(ali);
-    gt_seq_delete(seq_a);
-    gt_seq_delete(seq_b);
-    gt_free(a);
-    gt_free(b);
   }
+  seqno_b = pvt->seqno_es2 + pvt->batchpos - 1;
   arng = gt_alignment_get_urange(ali);
   brng = gt_alignment_get_vrange(ali);
-  adesc = gt_encseq_description(mis->pvt->es1, &seqlen_a, mis->pvt->seqno_es1);
-  bdesc = gt_encseq_description(mis->pvt->es2, &seqlen_b, mis->pvt->seqno_es2);
+  adesc = gt_encseq_description(pvt->es1, &seqlen_a, pvt->seqno_es1);
+  bdesc = gt_encseq_description(pvt->es2, &seqlen_b, seqno_b);
   *match = gt_match_sw_new("", "",
-                           mis->pvt->seqno_es1,
-                           mis->pvt->seqno_es2,
+                           pvt->seqno_es1,
+                           seqno_b,
                            gt_alignment_get_length(ali),
                            gt_alignment_eval(ali),
                            arng.start, brng.start,
@@ -109,11 +247,6 @@ static GtMatchIteratorStatus gt_match_iterator_sw_next(GtMatchIterator *mi,
                            GT_MATCH_DIRECT);
   gt_match_set_seqid1_nt(*match, adesc, seqlen_a);
   gt_match_set_seqid2_nt(*match, bdesc, seqlen_b);
-  gt_alignment_delete(ali);
-  gt_seq_delete(seq_a);
-  gt_seq_delete(seq_b);
-  gt_free(a);
-  gt_free(b);
   return GT_MATCHER_STATUS_OK;
 }
 
@@ -136,6 +269,10 @@ GtMatchIterator* gt_match_iterator_sw_new(GtEncseq *es1, GtEncseq *es2,
   mis->pvt->sf = gt_score_function_ref(sf);
   mis->pvt->min_len = min_len;
   mis->pvt->max_edist = max_edist;
+  mis->pvt->seqs_b = gt_malloc(sizeof (GtSeq*)
+                               * GT_MATCH_ITERATOR_SW_BATCHSIZE);
+  mis->pvt->alignments = gt_calloc(GT_MATCH_ITERATOR_SW_BATCHSIZE,
+                                   sizeof (GtAlignment*));
   mis->pvt->firstali = true;
   return mi;
 }
@@ -145,6 +282,12 @@ static void gt_match_iterator_sw_free(GtMatchIterator *mi)
   GtMatchIteratorSW *mis;
   if (!mi) return;
   mis = gt_match_iterator_sw_cast(mi);
+  match_iterator_sw_delete_batch(mis->pvt);
+  gt_seq_delete(mis->pvt->seq_a);
+  gt_free(mis->pvt->seqs_b);
+  gt_free(mis->pvt->alignments);
+  gt_free(mis->pvt->a);
+  gt_free(mis->pvt->b);
   gt_encseq_delete(mis->pvt->es1);
   gt_encseq_delete(mis->pvt->es2);
   gt_score_function_delete(mis->pvt->sf);
@@ -0,0 +1,864 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include <string.h>
+#include "core/array_api.h"
+#include "core/assert_api.h"
+#include "core/ensure.h"
+#include "core/hashmap_api.h"
+#include "core/hashtable.h"
+#include "core/ma_api.h"
+#include "core/minmax.h"
+#include "core/str_api.h"
+#include "core/symbol_api.h"
+#include "core/undef_api.h"
+#include "core/unused_api.h"
+#include "extended/feature_node.h"
+#include "extended/feature_type.h"
+#include "extended/packed_features.h"
+
+/* node flags */
+#define PF_STRAND_MASK     0x7
+#define PF_PHASE_OFFSET    3
+#define PF_PHASE_MASK      0x3
+#define PF_SCORE_DEFINED   (1 << 5)
+#define PF_MULTI           (1 << 6)
+#define PF_PSEUDO          (1 << 7)
+
+/* size of the blocks the string pool is allocated in */
+#define PF_POOL_CHUNKSIZE  ((size_t) 1 << 16)
+
+typedef struct {
+  char *data;
+  size_t used,
+         size;
+} PackedFeaturesChunk;
+
+struct GtPackedFeatures {
+  /* the nodes, the offset arrays have one entry more than there are nodes */
+  const char **types,
+             **sources;
+  GtUword *starts,
+          *ends,
+          *representatives,
+          *child_offsets,
+          *attribute_offsets,
+          nof_nodes,
+          allocated_nodes;
+  float *scores;
+  unsigned char *flags;
+  /* the children of all nodes */
+  GtUword *children,
+          nof_children,
+          allocated_children;
+  /* the attributes of all nodes */
+  const char **attribute_names,
+             **attribute_values;
+  GtUword nof_attributes,
+          allocated_attributes;
+  /* the graphs */
+  GtUword *roots,
+          nof_graphs,
+          allocated_graphs;
+  const char **seqids;
+  /* the string pool, <strings> indexes the pooled strings */
+  GtHashtable *strings;
+  GtArray *chunks;
+  /* used while adding a graph, released by <gt_packed_features_compact()> */
+  GtArray *queue;
+  GtHashmap *node_numbers;
+};
+
+GtPackedFeatures* gt_packed_features_new(void)
+{
+  GtPackedFeatures *pf = gt_calloc(1, sizeof *pf);
+  pf->child_offsets = gt_calloc(1, sizeof (GtUword));
+  pf->attribute_offsets = gt_calloc(1, sizeof (GtUword));
+  pf->chunks = gt_array_new(sizeof (PackedFeaturesChunk));
+  return pf;
+}
+
+static GtHashtable* packed_features_string_index_new(void)
+{
+  HashElemInfo string_index = {
+    gt_ht_cstr_elem_hash, { NULL }, sizeof (char*), gt_ht_cstr_elem_cmp, NULL,
+    NULL
+  };
+  return gt_hashtable_new(string_index);
+}
+
+/* Creates the helper structures needed to add a graph to <pf> if they have
+   been released. The index of the string pool is rebuilt from the chunks, in
+   which the strings are stored back to back. */
+static void packed_features_prepare_add(GtPackedFeatures *pf)
+{
+  GtUword i;
+  if (pf->strings)
+    return;
+  pf->strings = packed_features_string_index_new();
+  for (i = 0; i < gt_array_size(pf->chunks); i++) {
+    PackedFeaturesChunk *chunk = gt_array_get(pf->chunks, i);
+    char *pooled = chunk->data;
+    while (pooled < chunk->data + chunk->used) {
+      (void) gt_hashtable_add(pf->strings, &pooled);
+      pooled += strlen(pooled) + 1;
+    }
+  }
+  pf->queue = gt_array_new(sizeof (GtFeatureNode*));
+  pf->node_numbers = gt_hashmap_new(GT_HASH_DIRECT, NULL, NULL);
+}
+
+/* Returns the copy of <cstr> in the string pool of <pf>. The strings are
+   stored back to back without any alignment. */
+static const char* packed_features_pool_string(GtPackedFeatures *pf,
+                                               const char *cstr)
+{
+  PackedFeaturesChunk *chunk;
+  char *pooled, **entry;
+  size_t length;
+  if ((entry = gt_hashtable_get(pf->strings, &cstr)))
+    return *entry;
+  length = strlen(cstr) + 1;
+  chunk = gt_array_size(pf->chunks) ? gt_array_get_last(pf->chunks) : NULL;
+  if (!chunk || length > chunk->size - chunk->used) {
+    PackedFeaturesChunk new_chunk;
+    new_chunk.size = MAX(length, PF_POOL_CHUNKSIZE);
+    new_chunk.data = gt_malloc(new_chunk.size);
+    new_chunk.used = 0;
+    gt_array_add(pf->chunks, new_chunk);
+    chunk = gt_array_get_last(pf->chunks);
+  }
+  pooled = chunk->data + chunk->used;
+  memcpy(pooled, cstr, length);
+  chunk->used += length;
+  (void) gt_hashtable_add(pf->strings, &pooled);
+  return pooled;
+}
+
+static void packed_features_add_attribute(const char *attr_name,
+                                          const char *attr_value, void *data)
+{
+  GtPackedFeatures *pf = data;
+  if (pf->nof_attributes == pf->allocated_attributes) {
+    pf->allocated_attributes = pf->allocated_attributes
+                               ? 2 * pf->allocated_attributes : 16UL;
+    pf->attribute_names = gt_realloc(pf->attribute_names,
+                                     pf->allocated_attributes
+                                     * sizeof (const char*));
+    pf->attribute_values = gt_realloc(pf->attribute_values,
+                                      pf->allocated_attributes
+                                      * sizeof (const char*));
+  }
+  pf->attribute_names[pf->nof_attributes] =
+    packed_features_pool_string(pf, attr_name);
+  pf->attribute_values[pf->nof_attributes++] =
+    packed_features_pool_string(pf, attr_value);
+}
+
+/* Returns the number of <fn> in the graph currently added, relative to its
+   root. <fn> is queued for packing if it has not been seen before. */
+static GtUword packed_features_number(GtPackedFeatures *pf, GtFeatureNode *fn)
+{
+  /* store number + 1 to distinguish number 0 from an undefined entry */
+  GtUword number = (GtUword) gt_hashmap_get(pf->node_numbers, fn);
+  if (!number) {
+    gt_array_add(pf->queue, fn);
+    number = gt_array_size(pf->queue);
+    gt_hashmap_add(pf->node_numbers, fn, (void*) number);
+  }
+  return number - 1;
+}
+
+static int packed_features_add_child(GtFeatureNode *child, void *data,
+                                     GT_UNUSED GtError *err)
+{
+  GtPackedFeatures *pf = data;
+  if (pf->nof_children == pf->allocated_children) {
+    pf->allocated_children = pf->allocated_children
+                             ? 2 * pf->allocated_children : 16UL;
+    pf->children = gt_realloc(pf->children,
+                              pf->allocated_children * sizeof (GtUword));
+  }
+  pf->children[pf->nof_children++] = pf->roots[pf->nof_graphs]
+                                     + packed_features_number(pf, child);
+  return 0;
+}
+
+static void packed_features_add_node(GtPackedFeatures *pf, GtFeatureNode *fn)
+{
+  GtUword node = pf->nof_nodes;
+  GtRange range;
+  unsigned char flags;
+
+  if (pf->nof_nodes == pf->allocated_nodes) {
+    GtUword allocated = pf->allocated_nodes ? 2 * pf->allocated_nodes : 64UL;
+    pf->types = gt_realloc(pf->types, allocated * sizeof (const char*));
+    pf->sources = gt_realloc(pf->sources, allocated * sizeof (const char*));
+    pf->starts = gt_realloc(pf->starts, allocated * sizeof (GtUword));
+    pf->ends = gt_realloc(pf->ends, allocated * sizeof (GtUword));
+    pf->representatives = gt_realloc(pf->representatives,
+                                     allocated * sizeof (GtUword));
+    pf->child_offsets = gt_realloc(pf->child_offsets,
+                                   (allocated + 1) * sizeof (GtUword));
+    pf->attribute_offsets = gt_realloc(pf->attribute_offsets,
+                                       (allocated + 1) * sizeof (GtUword));
+    pf->scores = gt_realloc(pf->scores, allocated * sizeof (float));
+    pf->flags = gt_realloc(pf->flags, allocated * sizeof (unsigned char));
+    pf->allocated_nodes = allocated;
+  }
+
+  flags = (unsigned char) gt_feature_node_get_strand(fn)
+          | (unsigned char) gt_feature_node_get_phase(fn) << PF_PHASE_OFFSET;
+  if (gt_feature_node_is_pseudo(fn)) {
+    flags |= PF_PSEUDO;
+    pf->types[node] = NULL;
+  }
+  else
+    pf->types[node] = gt_feature_node_get_type(fn);
+  pf->sources[node] = gt_feature_node_has_source(fn)
+                      ? packed_features_pool_string(pf,
+                                               gt_feature_node_get_source(fn))
+                      : NULL;
+  range = gt_genome_node_get_range((GtGenomeNode*) fn);
+  pf->starts[node] = range.start;
+  pf->ends[node] = range.end;
+  pf->representatives[node] = GT_UNDEF_UWORD;
+  if (gt_feature_node_is_multi(fn))
+    flags |= PF_MULTI;
+  if (gt_feature_node_score_is_defined(fn)) {
+    flags |= PF_SCORE_DEFINED;
+    pf->scores[node] = gt_feature_node_get_score(fn);
+  }
+  else
+    pf->scores[node] = GT_UNDEF_FLOAT;
+  pf->flags[node] = flags;
+
+  gt_feature_node_foreach_attribute(fn, packed_features_add_attribute, pf);
+  pf->attribute_offsets[node + 1] = pf->nof_attributes;
+  (void) gt_feature_node_traverse_direct_children(fn, pf,
+                                                  packed_features_add_child,
+                                                  NULL);
+  pf->child_offsets[node + 1] = pf->nof_children;
+  pf->nof_nodes++;
+}
+
+GtUword gt_packed_features_add(GtPackedFeatures *pf, GtFeatureNode *fn)
+{
+  GtUword i, root = pf->nof_nodes;
+  gt_assert(pf && fn);
+
+  packed_features_prepare_add(pf);
+  if (pf->nof_graphs == pf->allocated_graphs) {
+    pf->allocated_graphs = pf->allocated_graphs
+                           ? 2 * pf->allocated_graphs : 16UL;
+    /* one more root marks the end of the last graph */
+    pf->roots = gt_realloc(pf->roots,
+                           (pf->allocated_graphs + 1) * sizeof (GtUword));
+    pf->seqids = gt_realloc(pf->seqids,
+                            pf->allocated_graphs * sizeof (const char*));
+  }
+  pf->roots[pf->nof_graphs] = root;
+  pf->seqids[pf->nof_graphs] =
+    packed_features_pool_string(pf,
+                                gt_str_get(gt_genome_node_get_seqid(
+                                                       (GtGenomeNode*) fn)));
+
+  /* pack the nodes in breadth-first order, the queue grows while the children
+     of the queued nodes are added */
+  gt_array_reset(pf->queue);
+  gt_hashmap_reset(pf->node_numbers);
+  (void) packed_features_number(pf, fn);
+  for (i = 0; i < gt_array_size(pf->queue); i++)
+    packed_features_add_node(pf, *(GtFeatureNode**) gt_array_get(pf->queue,
+                                                                  i));
+
+  /* now that all nodes have numbers, link the multi-features */
+  for (i = 0; i < gt_array_size(pf->queue); i++) {
+    GtFeatureNode *node = *(GtFeatureNode**) gt_array_get(pf->queue, i),
+                  *rep;
+    GtUword number;
+    if (!(pf->flags[root + i] & PF_MULTI))
+      continue;
+    rep = gt_feature_node_get_multi_representative(node);
+    /* a representative outside of this graph cannot be referenced, the node
+       becomes its own representative then */
+    number = (GtUword) gt_hashmap_get(pf->node_numbers, rep);
+    pf->representatives[root + i] = root + (number ? number - 1 : i);
+  }
+  pf->roots[++pf->nof_graphs] = pf->nof_nodes;
+  return pf->nof_graphs - 1;
+}
+
+void gt_packed_features_compact(GtPackedFeatures *pf)
+{
+  gt_assert(pf);
+  if (pf->nof_nodes && pf->nof_nodes < pf->allocated_nodes) {
+    GtUword n = pf->nof_nodes;
+    pf->types = gt_realloc(pf->types, n * sizeof (const char*));
+    pf->sources = gt_realloc(pf->sources, n * sizeof (const char*));
+    pf->starts = gt_realloc(pf->starts, n * sizeof (GtUword));
+    pf->ends = gt_realloc(pf->ends, n * sizeof (GtUword));
+    pf->representatives = gt_realloc(pf->representatives,
+                                     n * sizeof (GtUword));
+    pf->child_offsets = gt_realloc(pf->child_offsets,
+                                   (n + 1) * sizeof (GtUword));
+    pf->attribute_offsets = gt_realloc(pf->attribute_offsets,
+                                       (n + 1) * sizeof (GtUword));
+    pf->scores = gt_realloc(pf->scores, n * sizeof (float));
+    pf->flags = gt_realloc(pf->flags, n * sizeof (unsigned char));
+    pf->allocated_nodes = n;
+  }
+  if (pf->nof_children && pf->nof_children < pf->allocated_children) {
+    pf->allocated_children = pf->nof_children;
+    pf->children = gt_realloc(pf->children,
+                              pf->allocated_children * sizeof (GtUword));
+  }
+  if (pf->nof_attributes && pf->nof_attributes < pf->allocated_attributes) {
+    pf->allocated_attributes = pf->nof_attributes;
+    pf->attribute_names = gt_realloc(pf->attribute_names,
+                                     pf->allocated_attributes
+                                     * sizeof (const char*));
+    pf->attribute_values = gt_realloc(pf->attribute_values,
+                                      pf->allocated_attributes
+                                      * sizeof (const char*));
+  }
+  if (pf->nof_graphs && pf->nof_graphs < pf->allocated_graphs) {
+    pf->allocated_graphs = pf->nof_graphs;
+    pf->roots = gt_realloc(pf->roots,
+                           (pf->allocated_graphs + 1) * sizeof (GtUword));
+    pf->seqids = gt_realloc(pf->seqids,
+                            pf->allocated_graphs * sizeof (const char*));
+  }
+  /* recreated by the next <gt_packed_features_add()> */
+  gt_hashtable_delete(pf->strings);
+  pf->strings = NULL;
+  gt_array_delete(pf->queue);
+  pf->queue = NULL;
+  gt_hashmap_delete(pf->node_numbers);
+  pf->node_numbers = NULL;
+}
+
+GtUword gt_packed_features_num_of_graphs(const GtPackedFeatures *pf)
+{
+  gt_assert(pf);
+  return pf->nof_graphs;
+}
+
+GtUword gt_packed_features_num_of_nodes(const GtPackedFeatures *pf)
+{
+  gt_assert(pf);
+  return pf->nof_nodes;
+}
+
+GtUword gt_packed_features_get_root(const GtPackedFeatures *pf, GtUword graph)
+{
+  gt_assert(pf && graph < pf->nof_graphs);
+  return pf->roots[graph];
+}
+
+GtFeatureNode* gt_packed_features_get_graph(const GtPackedFeatures *pf,
+                                            GtUword graph)
+{
+  GtUword i, j, root, nof_nodes;
+  GtFeatureNode **features;
+  bool *has_parent;
+  GtStr *seqid, *source = NULL;
+  GtFeatureNode *fn;
+  gt_assert(pf && graph < pf->nof_graphs);
+
+  root = pf->roots[graph];
+  nof_nodes = pf->roots[graph + 1] - root;
+  features = gt_malloc(nof_nodes * sizeof *features);
+  has_parent = gt_calloc(nof_nodes, sizeof *has_parent);
+  seqid = gt_str_new_cstr(pf->seqids[graph]);
+  for (i = 0; i < nof_nodes; i++) {
+    GtUword node = root + i, k;
+    GtStrand strand = pf->flags[node] & PF_STRAND_MASK;
+    if (pf->flags[node] & PF_PSEUDO) {
+      features[i] = gt_feature_node_cast(
+                      gt_feature_node_new_pseudo(seqid, pf->starts[node],
+                                                 pf->ends[node], strand));
+    }
+    else {
+      features[i] = gt_feature_node_cast(
+                      gt_feature_node_new(seqid, pf->types[node],
+                                          pf->starts[node], pf->ends[node],
+                                          strand));
+    }
+    fn = features[i];
+    if (pf->sources[node]) {
+      /* consecutive nodes usually have the same source, share it */
+      if (!source || strcmp(gt_str_get(source), pf->sources[node])) {
+        gt_str_delete(source);
+        source = gt_str_new_cstr(pf->sources[node]);
+      }
+      gt_feature_node_set_source(fn, source);
+    }
+    gt_feature_node_set_phase(fn, (pf->flags[node] >> PF_PHASE_OFFSET)
+                                  & PF_PHASE_MASK);
+    if (pf->flags[node] & PF_SCORE_DEFINED)
+      gt_feature_node_set_score(fn, pf->scores[node]);
+    for (k = pf->attribute_offsets[node]; k < pf->attribute_offsets[node + 1];
+         k++) {
+      gt_feature_node_add_attribute(fn, pf->attribute_names[k],
+                                    pf->attribute_values[k]);
+    }
+  }
+  /* connect the nodes, in the original order of the children */
+  for (i = 0; i < nof_nodes; i++) {
+    GtUword node = root + i;
+    for (j = pf->child_offsets[node]; j < pf->child_offsets[node + 1]; j++) {
+      GtUword child = pf->children[j] - root;
+      /* the parents share the ownership of a child */
+      if (has_parent[child])
+        gt_genome_node_ref((GtGenomeNode*) features[child]);
+      else
+        has_parent[child] = true;
+      gt_feature_node_add_child(features[i], features[child]);
+    }
+  }
+  /* restore the multi-features, the representatives first */
+  for (i = 0; i < nof_nodes; i++) {
+    if (pf->representatives[root + i] == root + i)
+      gt_feature_node_make_multi_representative(features[i]);
+  }
+  for (i = 0; i < nof_nodes; i++) {
+    GtUword rep = pf->representatives[root + i];
+    if (rep != GT_UNDEF_UWORD && rep != root + i)
+      gt_feature_node_set_multi_representative(features[i],
+                                               features[rep - root]);
+  }
+  fn = features[0];
+  gt_str_delete(source);
+  gt_str_delete(seqid);
+  gt_free(has_parent);
+  gt_free(features);
+  return fn;
+}
+
+int gt_packed_features_traverse(const GtPackedFeatures *pf, GtUword graph,
+                                GtPackedFeaturesTraverseFunc func, void *data,
+                                GtError *err)
+{
+  GtUword node;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(pf && graph < pf->nof_graphs && func);
+  for (node = pf->roots[graph]; !had_err && node < pf->roots[graph + 1];
+       node++) {
+    had_err = func(pf, node, data, err);
+  }
+  return had_err;
+}
+
+const char* gt_packed_features_get_seqid(const GtPackedFeatures *pf,
+                                         GtUword node)
+{
+  GtUword left = 0, right;
+  gt_assert(pf && node < pf->nof_nodes);
+  /* find the last graph whose root is not after <node> */
+  right = pf->nof_graphs;
+  while (left + 1 < right) {
+    GtUword mid = left + (right - left) / 2;
+    if (pf->roots[mid] <= node)
+      left = mid;
+    else
+      right = mid;
+  }
+  return pf->seqids[left];
+}
+
+const char* gt_packed_features_get_source(const GtPackedFeatures *pf,
+                                          GtUword node)
+{
+  gt_assert(pf && node < pf->nof_nodes);
+  return pf->sources[node] ? pf->sources[node] : ".";
+}
+
+bool gt_packed_features_has_source(const GtPackedFeatures *pf, GtUword node)
+{
+  gt_assert(pf && node < pf->nof_nodes);
+  return pf->sources[node] != NULL;
+}
+
+const char* gt_packed_features_get_type(const GtPackedFeatures *pf,
+                                        GtUword node)
+{
+  gt_assert(pf && node < pf->nof_nodes);
+  return pf->types[node];
+}
+
+GtRange gt_packed_features_get_range(const GtPackedFeatures *pf, GtUword node)
+{
+  GtRange range;
+  gt_assert(pf && node < pf->nof_nodes);
+  range.start = pf->starts[node];
+  range.end = pf->ends[node];
+  return range;
+}
+
+GtStrand gt_packed_features_get_strand(const GtPackedFeatures *pf,
+                                       GtUword node)
+{
+  gt_assert(pf && node < pf->nof_nodes);
+  return pf->flags[node] & PF_STRAND_MASK;
+}
+
+GtPhase gt_packed_features_get_phase(const GtPackedFeatures *pf, GtUword node)
+{
+  gt_assert(pf && node < pf->nof_nodes);
+  return (pf->flags[node] >> PF_PHASE_OFFSET) & PF_PHASE_MASK;
+}
+
+bool gt_packed_features_score_is_defined(const GtPackedFeatures *pf,
+                                         GtUword node)
+{
+  gt_assert(pf && node < pf->nof_nodes);
+  return pf->flags[node] & PF_SCORE_DEFINED;
+}
+
+float gt_packed_features_get_score(const GtPackedFeatures *pf, GtUword node)
+{
+  gt_assert(pf && node < pf->nof_nodes);
+  gt_assert(pf->flags[node] & PF_SCORE_DEFINED);
+  return pf->scores[node];
+}
+
+bool gt_packed_features_is_pseudo(const GtPackedFeatures *pf, GtUword node)
+{
+  gt_assert(pf && node < pf->nof_nodes);
+  return pf->flags[node] & PF_PSEUDO;
+}
+
+bool gt_packed_features_is_multi(const GtPackedFeatures *pf, GtUword node)
+{
+  gt_assert(pf && node < pf->nof_nodes);
+  return pf->flags[node] & PF_MULTI;
+}
+
+GtUword gt_packed_features_get_multi_representative(const GtPackedFeatures *pf,
+                                                    GtUword node)
+{
+  gt_assert(pf && node < pf->nof_nodes);
+  gt_assert(pf->flags[node] & PF_MULTI);
+  return pf->representatives[node];
+}
+
+const char* gt_packed_features_get_attribute(const GtPackedFeatures *pf,
+                                             GtUword node,
+                                             const char *attr_name)
+{
+  GtUword i;
+  gt_assert(pf && node < pf->nof_nodes && attr_name);
+  for (i = pf->attribute_offsets[node]; i < pf->attribute_offsets[node + 1];
+       i++) {
+    if (!strcmp(pf->attribute_names[i], attr_name))
+      return pf->attribute_values[i];
+  }
+  return NULL;
+}
+
+GtUword gt_packed_features_number_of_attributes(const GtPackedFeatures *pf,
+                                                GtUword node)
+{
+  gt_assert(pf && node < pf->nof_nodes);
+  return pf->attribute_offsets[node + 1] - pf->attribute_offsets[node];
+}
+
+const char* gt_packed_features_get_attribute_name(const GtPackedFeatures *pf,
+                                                  GtUword node, GtUword i)
+{
+  gt_assert(pf && node < pf->nof_nodes);
+  gt_assert(i < gt_packed_features_number_of_attributes(pf, node));
+  return pf->attribute_names[pf->attribute_offsets[node] + i];
+}
+
+const char* gt_packed_features_get_attribute_value(const GtPackedFeatures *pf,
+                                                   GtUword node, GtUword i)
+{
+  gt_assert(pf && node < pf->nof_nodes);
+  gt_assert(i < gt_packed_features_number_of_attributes(pf, node));
+  return pf->attribute_values[pf->attribute_offsets[node] + i];
+}
+
+GtUword gt_packed_features_number_of_children(const GtPackedFeatures *pf,
+                                              GtUword node)
+{
+  gt_assert(pf && node < pf->nof_nodes);
+  return pf->child_offsets[node + 1] - pf->child_offsets[node];
+}
+
+GtUword gt_packed_features_get_child(const GtPackedFeatures *pf, GtUword node,
+                                     GtUword i)
+{
+  gt_assert(pf && node < pf->nof_nodes);
+  gt_assert(i < gt_packed_features_number_of_children(pf, node));
+  return pf->children[pf->child_offsets[node] + i];
+}
+
+void gt_packed_features_delete(GtPackedFeatures *pf)
+{
+  GtUword i;
+  if (!pf) return;
+  for (i = 0; i < gt_array_size(pf->chunks); i++)
+    gt_free(((PackedFeaturesChunk*) gt_array_get(pf->chunks, i))->data);
+  gt_array_delete(pf->chunks);
+  gt_hashtable_delete(pf->strings);
+  gt_array_delete(pf->queue);
+  gt_hashmap_delete(pf->node_numbers);
+  gt_free(pf->types);
+  gt_free(pf->sources);
+  gt_free(pf->starts);
+  gt_free(pf->ends);
+  gt_free(pf->representatives);
+  gt_free(pf->child_offsets);
+  gt_free(pf->attribute_offsets);
+  gt_free(pf->scores);
+  gt_free(pf->flags);
+  gt_free(pf->children);
+  gt_free(pf->attribute_names);
+  gt_free(pf->attribute_values);
+  gt_free(pf->roots);
+  gt_free(pf->seqids);
+  gt_free(pf);
+}
+
+static int packed_features_count_node(GT_UNUSED const GtPackedFeatures *pf,
+                                      GT_UNUSED GtUword node, void *data,
+                                      GT_UNUSED GtError *err)
+{
+  GtUword *nof_nodes = data;
+  (*nof_nodes)++;
+  return 0;
+}
+
+/* compares node <a> of <pf_a> with node <b> of <pf_b>, the node numbers of the
+   children and representatives are compared relative to their roots */
+static int packed_features_compare_nodes(const GtPackedFeatures *pf_a,
+                                         GtUword root_a, GtUword a,
+                                         const GtPackedFeatures *pf_b,
+                                         GtUword root_b, GtUword b,
+                                         GtError *err)
+{
+  GtRange range_a, range_b;
+  GtUword i;
+  int had_err = 0;
+  gt_error_check(err);
+
+  gt_ensure(!strcmp(gt_packed_features_get_seqid(pf_a, a),
+                    gt_packed_features_get_seqid(pf_b, b)));
+  gt_ensure(gt_packed_features_get_type(pf_a, a) ==
+            gt_packed_features_get_type(pf_b, b));
+  gt_ensure(gt_packed_features_has_source(pf_a, a) ==
+            gt_packed_features_has_source(pf_b, b));
+  gt_ensure(!strcmp(gt_packed_features_get_source(pf_a, a),
+                    gt_packed_features_get_source(pf_b, b)));
+  range_a = gt_packed_features_get_range(pf_a, a);
+  range_b = gt_packed_features_get_range(pf_b, b);
+  gt_ensure(!gt_range_compare(&range_a, &range_b));
+  gt_ensure(gt_packed_features_get_strand(pf_a, a) ==
+            gt_packed_features_get_strand(pf_b, b));
+  gt_ensure(gt_packed_features_get_phase(pf_a, a) ==
+            gt_packed_features_get_phase(pf_b, b));
+  gt_ensure(gt_packed_features_score_is_defined(pf_a, a) ==
+            gt_packed_features_score_is_defined(pf_b, b));
+  if (!had_err && gt_packed_features_score_is_defined(pf_a, a)) {
+    gt_ensure(gt_packed_features_get_score(pf_a, a) ==
+              gt_packed_features_get_score(pf_b, b));
+  }
+  gt_ensure(gt_packed_features_is_pseudo(pf_a, a) ==
+            gt_packed_features_is_pseudo(pf_b, b));
+  gt_ensure(gt_packed_features_is_multi(pf_a, a) ==
+            gt_packed_features_is_multi(pf_b, b));
+  if (!had_err && gt_packed_features_is_multi(pf_a, a)) {
+    gt_ensure(gt_packed_features_get_multi_representative(pf_a, a) - root_a ==
+              gt_packed_features_get_multi_representative(pf_b, b) - root_b);
+  }
+  gt_ensure(gt_packed_features_number_of_attributes(pf_a, a) ==
+            gt_packed_features_number_of_attributes(pf_b, b));
+  for (i = 0; !had_err && i < gt_packed_features_number_of_attributes(pf_a, a);
+       i++) {
+    gt_ensure(!strcmp(gt_packed_features_get_attribute_name(pf_a, a, i),
+                      gt_packed_features_get_attribute_name(pf_b, b, i)));
+    gt_ensure(!strcmp(gt_packed_features_get_attribute_value(pf_a, a, i),
+                      gt_packed_features_get_attribute_value(pf_b, b, i)));
+  }
+  gt_ensure(gt_packed_features_number_of_children(pf_a, a) ==
+            gt_packed_features_number_of_children(pf_b, b));
+  for (i = 0; !had_err && i < gt_packed_features_number_of_children(pf_a, a);
+       i++) {
+    gt_ensure(gt_packed_features_get_child(pf_a, a, i) - root_a ==
+              gt_packed_features_get_child(pf_b, b, i) - root_b);
+  }
+  return had_err;
+}
+
+int gt_packed_features_unit_test(GtError *err)
+{
+  GtPackedFeatures *pf, *repacked;
+  GtGenomeNode *gn, *gene, *mrna_a, *mrna_b, *exon, *cds_a, *cds_b, *pseudo;
+  GtFeatureNode *fn;
+  GtArray *nodes;
+  GtStr *seqid, *source;
+  GtUword i, j, root, node, nof_nodes;
+  GtRange range;
+  int had_err = 0;
+  gt_error_check(err);
+
+  nodes = gt_array_new(sizeof (GtGenomeNode*));
+  seqid = gt_str_new_cstr("seqid");
+  source = gt_str_new_cstr("source");
+
+  gn = gt_feature_node_new_standard_gene();
+  gt_array_add(nodes, gn);
+
+  /* a gene whose two transcripts share an exon and have a multi-feature CDS */
+  gene = gt_feature_node_new(seqid, gt_ft_gene, 100, 900, GT_STRAND_FORWARD);
+  gt_feature_node_set_source((GtFeatureNode*) gene, source);
+  gt_feature_node_set_score((GtFeatureNode*) gene, 0.5);
+  gt_feature_node_add_attribute((GtFeatureNode*) gene, "ID", "gene1");
+  gt_feature_node_add_attribute((GtFeatureNode*) gene, "Name", "foo");
+  mrna_a = gt_feature_node_new(seqid, gt_ft_mRNA, 100, 900,
+                               GT_STRAND_FORWARD);
+  mrna_b = gt_feature_node_new(seqid, gt_ft_mRNA, 100, 800,
+                               GT_STRAND_FORWARD);
+  gt_feature_node_add_attribute((GtFeatureNode*) mrna_b, "Name", "foo");
+  exon = gt_feature_node_new(seqid, gt_ft_exon, 100, 200, GT_STRAND_FORWARD);
+  cds_a = gt_feature_node_new(seqid, gt_ft_CDS, 150, 200, GT_STRAND_FORWARD);
+  cds_b = gt_feature_node_new(seqid, gt_ft_CDS, 300, 400, GT_STRAND_FORWARD);
+  gt_feature_node_set_phase((GtFeatureNode*) cds_b, GT_PHASE_TWO);
+  gt_feature_node_make_multi_representative((GtFeatureNode*) cds_a);
+  gt_feature_node_set_multi_representative((GtFeatureNode*) cds_b,
+                                           (GtFeatureNode*) cds_a);
+  gt_feature_node_add_child((GtFeatureNode*) gene, (GtFeatureNode*) mrna_a);
+  gt_feature_node_add_child((GtFeatureNode*) gene, (GtFeatureNode*) mrna_b);
+  gt_feature_node_add_child((GtFeatureNode*) mrna_a, (GtFeatureNode*) exon);
+  gt_feature_node_add_child((GtFeatureNode*) mrna_b,
+                            (GtFeatureNode*) gt_genome_node_ref(exon));
+  gt_feature_node_add_child((GtFeatureNode*) mrna_a, (GtFeatureNode*) cds_a);
+  gt_feature_node_add_child((GtFeatureNode*) mrna_a, (GtFeatureNode*) cds_b);
+  gt_array_add(nodes, gene);
+
+  /* a pseudo-feature */
+  pseudo = gt_feature_node_new_pseudo(seqid, 950, 1000, GT_STRAND_REVERSE);
+  gn = gt_feature_node_new(seqid, gt_ft_gene, 950, 960, GT_STRAND_REVERSE);
+  gt_feature_node_add_child((GtFeatureNode*) pseudo, (GtFeatureNode*) gn);
+  gn = gt_feature_node_new(seqid, gt_ft_gene, 970, 1000, GT_STRAND_REVERSE);
+  gt_feature_node_add_child((GtFeatureNode*) pseudo, (GtFeatureNode*) gn);
+  gt_array_add(nodes, pseudo);
+
+  pf = gt_packed_features_new();
+  for (i = 0; !had_err && i < gt_array_size(nodes); i++) {
+    /* adding after compacting has to rebuild the index of the string pool */
+    if (i == 2)
+      gt_packed_features_compact(pf);
+    gt_ensure(gt_packed_features_add(pf, *(GtFeatureNode**)
+                                         gt_array_get(nodes, i)) == i);
+  }
+  gt_packed_features_compact(pf);
+  gt_ensure(gt_packed_features_num_of_graphs(pf) == gt_array_size(nodes));
+
+  /* the shared exon is stored once: gene, 2 mRNAs, exon, 2 CDS */
+  if (!had_err) {
+    root = gt_packed_features_get_root(pf, 1);
+    gt_ensure(gt_packed_features_get_root(pf, 2) - root == 6);
+    nof_nodes = 0;
+    had_err = gt_packed_features_traverse(pf, 1, packed_features_count_node,
+                                          &nof_nodes, err);
+    gt_ensure(nof_nodes == 6);
+  }
+  if (!had_err) {
+    gt_ensure(!strcmp(gt_packed_features_get_seqid(pf, root), "seqid"));
+    gt_ensure(gt_packed_features_get_type(pf, root) == gt_symbol(gt_ft_gene));
+    gt_ensure(!strcmp(gt_packed_features_get_source(pf, root), "source"));
+    gt_ensure(gt_packed_features_score_is_defined(pf, root));
+    gt_ensure(gt_packed_features_get_score(pf, root) == 0.5);
+    gt_ensure(!strcmp(gt_packed_features_get_attribute(pf, root, "Name"),
+                      "foo"));
+    gt_ensure(!gt_packed_features_get_attribute(pf, root, "Parent"));
+    gt_ensure(!strcmp(gt_packed_features_get_attribute_name(pf, root, 0),
+                      "ID"));
+    gt_ensure(gt_packed_features_number_of_children(pf, root) == 2);
+  }
+  for (i = 0; !had_err && i < 2; i++) {
+    GtUword mrna = gt_packed_features_get_child(pf, root, i), exon_node;
+    /* equal strings are pooled */
+    if (gt_packed_features_get_attribute(pf, mrna, "Name")) {
+      gt_ensure(gt_packed_features_get_attribute(pf, mrna, "Name") ==
+                gt_packed_features_get_attribute(pf, root, "Name"));
+    }
+    gt_ensure(!gt_packed_features_has_source(pf, mrna));
+    gt_ensure(!strcmp(gt_packed_features_get_source(pf, mrna), "."));
+    /* both transcripts have the same exon */
+    exon_node = gt_packed_features_get_child(pf, mrna, 0);
+    gt_ensure(gt_packed_features_get_type(pf, exon_node) ==
+              gt_symbol(gt_ft_exon));
+    gt_ensure(exon_node == gt_packed_features_get_child(pf,
+                             gt_packed_features_get_child(pf, root, 1 - i),
+                             0));
+    for (j = 1; !had_err && j < gt_packed_features_number_of_children(pf, mrna);
+         j++) {
+      node = gt_packed_features_get_child(pf, mrna, j);
+      gt_ensure(gt_packed_features_get_type(pf, node) ==
+                gt_symbol(gt_ft_CDS));
+      gt_ensure(gt_packed_features_is_multi(pf, node));
+      range = gt_packed_features_get_range(pf,
+                gt_packed_features_get_multi_representative(pf, node));
+      gt_ensure(range.start == 150 && range.end == 200);
+    }
+  }
+  if (!had_err) {
+    root = gt_packed_features_get_root(pf, 2);
+    gt_ensure(gt_packed_features_is_pseudo(pf, root));
+    gt_ensure(!gt_packed_features_get_type(pf, root));
+    gt_ensure(gt_packed_features_get_strand(pf, root) == GT_STRAND_REVERSE);
+    gt_ensure(gt_packed_features_get_seqid(pf, root + 1) ==
+              gt_packed_features_get_seqid(pf,
+                                           gt_packed_features_get_root(pf,
+                                                                       1)));
+  }
+
+  /* unpacking and packing again must result in the same nodes */
+  repacked = gt_packed_features_new();
+  for (i = 0; !had_err && i < gt_packed_features_num_of_graphs(pf); i++) {
+    fn = gt_packed_features_get_graph(pf, i);
+    gt_ensure(gt_packed_features_add(repacked, fn) == i);
+    gt_genome_node_delete((GtGenomeNode*) fn);
+  }
+  gt_ensure(gt_packed_features_num_of_nodes(repacked) ==
+            gt_packed_features_num_of_nodes(pf));
+  for (i = 0; !had_err && i < gt_packed_features_num_of_graphs(pf); i++) {
+    GtUword root_a = gt_packed_features_get_root(pf, i),
+            root_b = gt_packed_features_get_root(repacked, i),
+            end = i + 1 < gt_packed_features_num_of_graphs(pf)
+                  ? gt_packed_features_get_root(pf, i + 1)
+                  : gt_packed_features_num_of_nodes(pf);
+    for (j = root_a; !had_err && j < end; j++) {
+      had_err = packed_features_compare_nodes(pf, root_a, j, repacked, root_b,
+                                              root_b + j - root_a, err);
+    }
+  }
+
+  gt_packed_features_delete(repacked);
+  gt_packed_features_delete(pf);
+  for (i = 0; i < gt_array_size(nodes); i++)
+    gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(nodes, i));
+  gt_array_delete(nodes);
+  gt_str_delete(source);
+  gt_str_delete(seqid);
+  return had_err;
+}
@@ -0,0 +1,147 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef PACKED_FEATURES_H
+#define PACKED_FEATURES_H
+
+#include "core/error_api.h"
+#include "core/phase_api.h"
+#include "core/range_api.h"
+#include "core/strand_api.h"
+#include "extended/feature_node_api.h"
+
+/* A <GtPackedFeatures> object stores immutable feature node graphs in a
+   compact form meant for holding large annotations in memory. All nodes of
+   all added graphs are kept in flat per-field arrays and addressed by their
+   node number, the children of a node are stored as a range of node numbers,
+   and all strings (sequence IDs, sources, attribute tags and values) are
+   stored only once in a string pool. The nodes of one graph are numbered
+   consecutively in breadth-first order, starting with its root. Nodes with
+   multiple parents are stored only once.
+   The origin (filename and line number) and observers of the feature nodes
+   are not stored. */
+typedef struct GtPackedFeatures GtPackedFeatures;
+
+/* Function called for each node number <node> of <packed_features> in
+   <gt_packed_features_traverse()>. A return value != 0 stops the traversal. */
+typedef int (*GtPackedFeaturesTraverseFunc)(const GtPackedFeatures
+                                            *packed_features, GtUword node,
+                                            void *data, GtError *err);
+
+/* Return a new empty <GtPackedFeatures> object. */
+GtPackedFeatures* gt_packed_features_new(void);
+/* Add a packed copy of the feature node graph with root <fn> to
+   <packed_features> and return the number of the new graph. <fn> is not
+   modified. A multi-feature whose representative is not part of the graph
+   becomes its own representative. */
+GtUword           gt_packed_features_add(GtPackedFeatures *packed_features,
+                                         GtFeatureNode *fn);
+/* Release the memory <packed_features> holds for adding further graphs, that
+   is, the reserved space in the node arrays and the index of the string pool.
+   Call this after the last graph has been added. Graphs can still be added
+   afterwards, but the first <gt_packed_features_add()> has to rebuild the
+   index of the string pool. */
+void              gt_packed_features_compact(GtPackedFeatures
+                                             *packed_features);
+/* Return the number of graphs in <packed_features>. */
+GtUword           gt_packed_features_num_of_graphs(const GtPackedFeatures
+                                                   *packed_features);
+/* Return the total number of nodes in <packed_features>. */
+GtUword           gt_packed_features_num_of_nodes(const GtPackedFeatures
+                                                  *packed_features);
+/* Return the number of the root node of graph <graph>. The nodes of <graph>
+   are numbered from the root up to (excluding) the root of graph
+   <graph> + 1. */
+GtUword           gt_packed_features_get_root(const GtPackedFeatures
+                                              *packed_features, GtUword graph);
+/* Return a new feature node graph equal to graph <graph> of
+   <packed_features>. The caller is responsible to delete it. */
+GtFeatureNode*    gt_packed_features_get_graph(const GtPackedFeatures
+                                               *packed_features,
+                                               GtUword graph);
+/* Call <func> for each node of graph <graph> of <packed_features> in the
+   order of the node numbers, that is, in breadth-first order, and each node
+   only once. Returns the first value != 0 returned by <func>, 0 otherwise. */
+int               gt_packed_features_traverse(const GtPackedFeatures
+                                              *packed_features, GtUword graph,
+                                              GtPackedFeaturesTraverseFunc func,
+                                              void *data, GtError *err);
+
+/* The following functions correspond to the <GtFeatureNode> functions of the
+   same name, for node <node> of <packed_features>. The returned strings stay
+   valid as long as <packed_features> exists, except for the type, which is
+   a symbol (see <gt_symbol()>). */
+const char*       gt_packed_features_get_seqid(const GtPackedFeatures
+                                               *packed_features, GtUword node);
+const char*       gt_packed_features_get_source(const GtPackedFeatures
+                                                *packed_features, GtUword node);
+bool              gt_packed_features_has_source(const GtPackedFeatures
+                                                *packed_features, GtUword node);
+/* Returns NULL for pseudo-features. */
+const char*       gt_packed_features_get_type(const GtPackedFeatures
+                                              *packed_features, GtUword node);
+GtRange           gt_packed_features_get_range(const GtPackedFeatures
+                                               *packed_features, GtUword node);
+GtStrand          gt_packed_features_get_strand(const GtPackedFeatures
+                                                *packed_features, GtUword node);
+GtPhase           gt_packed_features_get_phase(const GtPackedFeatures
+                                               *packed_features, GtUword node);
+bool              gt_packed_features_score_is_defined(const GtPackedFeatures
+                                                      *packed_features,
+                                                      GtUword node);
+float             gt_packed_features_get_score(const GtPackedFeatures
+                                               *packed_features, GtUword node);
+bool              gt_packed_features_is_pseudo(const GtPackedFeatures
+                                               *packed_features, GtUword node);
+bool              gt_packed_features_is_multi(const GtPackedFeatures
+                                              *packed_features, GtUword node);
+/* Return the node number of the representative of multi-feature <node>. */
+GtUword           gt_packed_features_get_multi_representative(const
+                                                              GtPackedFeatures
+                                                              *packed_features,
+                                                              GtUword node);
+const char*       gt_packed_features_get_attribute(const GtPackedFeatures
+                                                   *packed_features,
+                                                   GtUword node,
+                                                   const char *attr_name);
+GtUword           gt_packed_features_number_of_attributes(const
+                                                          GtPackedFeatures
+                                                          *packed_features,
+                                                          GtUword node);
+/* Return the tag of the <i>-th attribute of <node>, in the order in which the
+   attributes were added to the original feature node. */
+const char*       gt_packed_features_get_attribute_name(const GtPackedFeatures
+                                                        *packed_features,
+                                                        GtUword node,
+                                                        GtUword i);
+/* Return the value of the <i>-th attribute of <node>. */
+const char*       gt_packed_features_get_attribute_value(const GtPackedFeatures
+                                                         *packed_features,
+                                                         GtUword node,
+                                                         GtUword i);
+GtUword           gt_packed_features_number_of_children(const GtPackedFeatures
+                                                        *packed_features,
+                                                        GtUword node);
+/* Return the node number of the <i>-th direct child of <node>. */
+GtUword           gt_packed_features_get_child(const GtPackedFeatures
+                                               *packed_features, GtUword node,
+                                               GtUword i);
+void              gt_packed_features_delete(GtPackedFeatures *packed_features);
+
+int               gt_packed_features_unit_test(GtError *err);
+
+#endif
@@ -28,6 +28,7 @@ struct GtSelectStream
   const GtNodeStream parent_instance;
   GtNodeStream *in_stream;
   GtNodeVisitor *select_visitor; /* the actual work is done in the visitor */
+  bool in_stream_done;
 };
 
 const GtNodeStreamClass* gt_select_stream_class(void);
@@ -49,6 +50,12 @@ static int select_stream_next(GtNodeStream *ns, GtGenomeNode **gn, GtError *err)
     return 0;
   }
 
+  /* the nodes held back by the visitor have been returned already */
+  if (fs->in_stream_done) {
+    *gn = NULL;
+    return 0;
+  }
+
   /* no nodes in the buffer -> get new nodes */
   while (!(had_err = gt_node_stream_next(fs->in_stream, gn, err)) && *gn) {
     gt_assert(*gn && !had_err);
@@ -67,6 +74,15 @@ static int select_stream_next(GtNodeStream *ns, GtGenomeNode **gn, GtError *err)
 
   /* either we have an error or no new node */
   gt_assert(had_err || !*gn);
+
+  /* the input is exhausted, get the nodes the visitor still holds back */
+  if (!had_err) {
+    fs->in_stream_done = true;
+    if (!(had_err = gt_select_visitor_flush(fs->select_visitor, err)) &&
+        gt_select_visitor_node_buffer_size(fs->select_visitor)) {
+      *gn = gt_select_visitor_get_node(fs->select_visitor);
+    }
+  }
   return had_err;
 }
 
@@ -107,6 +123,7 @@ GtNodeStream* gt_select_stream_new(GtNodeStream *in_stream, GtStr *seqid,
   GtSelectStream *select_stream = gt_select_stream_cast(ns);
   gt_assert(in_stream);
   select_stream->in_stream = gt_node_stream_ref(in_stream);
+  select_stream->in_stream_done = false;
   select_stream->select_visitor =
     gt_select_visitor_new(seqid, source, contain_range, overlap_range, strand,
                           targetstrand, has_CDS, max_gene_length, max_gene_num,
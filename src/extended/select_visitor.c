@@ -20,6 +20,8 @@
 #include "core/ma.h"
 #include "core/minmax.h"
 #include "core/queue_api.h"
+#include "core/thread_api.h"
+#include "core/thread_pool.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "extended/feature_node.h"
@@ -29,11 +31,23 @@
 #include "extended/script_filter.h"
 #include "extended/select_visitor.h"
 
+/* number of feature nodes collected for the script filters before they are
+   evaluated in parallel */
+#define SELECT_VISITOR_BATCH_SIZE 1024UL
+/* number of feature nodes a thread evaluates in one go */
+#define SELECT_VISITOR_GRAIN_SIZE 16UL
+
 typedef enum {
   GT_SELECT_AND,
   GT_SELECT_OR
 } GtSelectLogic;
 
+typedef struct {
+  GtFeatureNode *fn;
+  bool select_node,
+       run_script_filters;
+} GtSelectVisitorPendingNode;
+
 struct GtSelectVisitor {
   const GtNodeVisitor parent_instance;
   GtQueue *node_buffer;
@@ -57,46 +71,99 @@ struct GtSelectVisitor {
   GtSelectLogic select_logic;
   bool is_lua;
   GtArray *script_filters;
+  /* With multiple threads, feature nodes are collected in <pending> (together
+     with all nodes following them) and the script filters are evaluated for a
+     whole batch in parallel. Every thread needs its own Lua states, so
+     additional sets of script filters are created on demand. */
+  GtArray *pending,
+          *filter_sets,
+          *idle_filter_sets;
+  GtMutex *filter_sets_lock;
   GtSelectNodeFunc drophandler;
   void *data;
 };
 
+typedef struct {
+  GtSelectVisitor *select_visitor;
+  GtUword error_index; /* the first pending node the evaluation failed for */
+  GtStr *error_msg;
+} GtSelectVisitorBatchInfo;
+
 #define select_visitor_cast(GV)\
         gt_node_visitor_cast(gt_select_visitor_class(), GV)
 
+static int select_visitor_evaluate_pending(GtSelectVisitor *fv, GtError *err);
+
+static void select_visitor_script_filters_delete(GtArray *script_filters)
+{
+  GtUword i;
+  for (i = 0; i < gt_array_size(script_filters); i++) {
+    gt_script_filter_delete(*(GtScriptFilter**)
+                            gt_array_get(script_filters, i));
+  }
+  gt_array_delete(script_filters);
+}
+
+static GtArray* select_visitor_script_filters_new(GtStrArray *select_files,
+                                                  GtError *err)
+{
+  GtArray *script_filters = gt_array_new(sizeof (GtScriptFilter*));
+  GtUword i;
+  for (i = 0; i < gt_str_array_size(select_files); i++) {
+    GtScriptFilter *sf;
+    if (!(sf = gt_script_filter_new_unsafe(gt_str_array_get(select_files, i),
+                                           err))) {
+      select_visitor_script_filters_delete(script_filters);
+      return NULL;
+    }
+    gt_array_add(script_filters, sf);
+  }
+  return script_filters;
+}
+
 static void select_visitor_free(GtNodeVisitor *nv)
 {
-  int i;
+  GtUword i;
   GtSelectVisitor *select_visitor = select_visitor_cast(nv);
   gt_str_delete(select_visitor->source);
   gt_str_delete(select_visitor->seqid);
-  if (gt_array_size(select_visitor->script_filters) > 0) {
-    for (i = 0; i < gt_array_size(select_visitor->script_filters); i++) {
-      GtScriptFilter *todelete =
-            *(GtScriptFilter**) gt_array_get(select_visitor->script_filters, i);
-      gt_script_filter_delete(todelete);
-    }
+  select_visitor_script_filters_delete(select_visitor->script_filters);
+  for (i = 0; i < gt_array_size(select_visitor->pending); i++) {
+    GtSelectVisitorPendingNode *pn = gt_array_get(select_visitor->pending, i);
+    gt_genome_node_delete((GtGenomeNode*) pn->fn);
   }
-  gt_array_delete(select_visitor->script_filters);
+  gt_array_delete(select_visitor->pending);
+  for (i = 0; i < gt_array_size(select_visitor->filter_sets); i++) {
+    select_visitor_script_filters_delete(*(GtArray**)
+                                         gt_array_get(select_visitor
+                                                      ->filter_sets, i));
+  }
+  gt_array_delete(select_visitor->filter_sets);
+  gt_array_delete(select_visitor->idle_filter_sets);
+  gt_mutex_delete(select_visitor->filter_sets_lock);
   gt_queue_delete(select_visitor->node_buffer);
 }
 
 static int select_visitor_comment_node(GtNodeVisitor *nv, GtCommentNode *c,
-                                       GT_UNUSED GtError *err)
+                                       GtError *err)
 {
   GtSelectVisitor *select_visitor;
   gt_error_check(err);
   select_visitor = select_visitor_cast(nv);
+  if (select_visitor_evaluate_pending(select_visitor, err))
+    return -1;
   gt_queue_add(select_visitor->node_buffer, c);
   return 0;
 }
 
 static int select_visitor_meta_node(GtNodeVisitor *nv, GtMetaNode *mn,
-                                    GT_UNUSED GtError *err)
+                                    GtError *err)
 {
   GtSelectVisitor *select_visitor;
   gt_error_check(err);
   select_visitor = select_visitor_cast(nv);
+  if (select_visitor_evaluate_pending(select_visitor, err))
+    return -1;
   gt_queue_add(select_visitor->node_buffer, mn);
   return 0;
 }
@@ -207,6 +274,115 @@ static int filter_lua(GtArray *filters, GtFeatureNode *fn, GtSelectLogic logic,
   return had_err;
 }
 
+/* Returns a set of script filters which is not used by another thread. */
+static GtArray* select_visitor_acquire_script_filters(GtSelectVisitor *fv,
+                                                      GtError *err)
+{
+  GtArray *script_filters = NULL;
+  gt_mutex_lock(fv->filter_sets_lock);
+  if (gt_array_size(fv->idle_filter_sets))
+    script_filters = *(GtArray**) gt_array_pop(fv->idle_filter_sets);
+  gt_mutex_unlock(fv->filter_sets_lock);
+  if (!script_filters &&
+      (script_filters = select_visitor_script_filters_new(fv->select_files,
+                                                          err))) {
+    gt_mutex_lock(fv->filter_sets_lock);
+    gt_array_add(fv->filter_sets, script_filters);
+    gt_mutex_unlock(fv->filter_sets_lock);
+  }
+  return script_filters;
+}
+
+static void select_visitor_release_script_filters(GtSelectVisitor *fv,
+                                                  GtArray *script_filters)
+{
+  gt_mutex_lock(fv->filter_sets_lock);
+  gt_array_add(fv->idle_filter_sets, script_filters);
+  gt_mutex_unlock(fv->filter_sets_lock);
+}
+
+static void select_visitor_evaluate_range(GtUword start, GtUword end,
+                                          void *data)
+{
+  GtSelectVisitorBatchInfo *info = data;
+  GtSelectVisitor *fv = info->select_visitor;
+  GtArray *script_filters;
+  GtUword i = start;
+  GtError *err = gt_error_new();
+  int had_err = 0;
+
+  if (!(script_filters = select_visitor_acquire_script_filters(fv, err)))
+    had_err = -1;
+  for (; !had_err && i < end; i++) {
+    GtSelectVisitorPendingNode *pn = gt_array_get(fv->pending, i);
+    if (pn->run_script_filters) {
+      if ((had_err = filter_lua(script_filters, pn->fn, fv->select_logic,
+                                &pn->select_node, err))) {
+        break;
+      }
+    }
+  }
+  if (script_filters)
+    select_visitor_release_script_filters(fv, script_filters);
+  if (had_err) {
+    /* report the error for the first node, as a serial evaluation would */
+    gt_mutex_lock(fv->filter_sets_lock);
+    if (info->error_index == GT_UNDEF_UWORD || i < info->error_index) {
+      info->error_index = i;
+      gt_str_set(info->error_msg, gt_error_get(err));
+    }
+    gt_mutex_unlock(fv->filter_sets_lock);
+  }
+  gt_error_delete(err);
+}
+
+static void select_visitor_handle_node(GtSelectVisitor *fv, GtFeatureNode *fn,
+                                       bool select_node, bool had_err,
+                                       GtError *err)
+{
+  if (select_node && !had_err)
+    fv->drophandler((GtGenomeNode*) fn, fv->data, err);
+
+  if (select_node)
+    gt_genome_node_delete((GtGenomeNode*) fn);
+  else
+    gt_queue_add(fv->node_buffer, fn);
+}
+
+/* Evaluates the script filters for the pending feature nodes of <fv> in
+   parallel and hands all pending nodes on in their original order. */
+static int select_visitor_evaluate_pending(GtSelectVisitor *fv, GtError *err)
+{
+  GtSelectVisitorBatchInfo info;
+  GtUword i;
+  int had_err = 0;
+  gt_error_check(err);
+
+  if (!gt_array_size(fv->pending))
+    return 0;
+  info.select_visitor = fv;
+  info.error_index = GT_UNDEF_UWORD;
+  info.error_msg = gt_str_new();
+  gt_thread_pool_parallel_for(gt_thread_pool_get(), 0,
+                              gt_array_size(fv->pending),
+                              SELECT_VISITOR_GRAIN_SIZE,
+                              select_visitor_evaluate_range, &info);
+  if (info.error_index != GT_UNDEF_UWORD) {
+    gt_error_set(err, "%s", gt_str_get(info.error_msg));
+    had_err = -1;
+  }
+  for (i = 0; i < gt_array_size(fv->pending); i++) {
+    GtSelectVisitorPendingNode *pn = gt_array_get(fv->pending, i);
+    if (i < info.error_index)
+      select_visitor_handle_node(fv, pn->fn, pn->select_node, false, err);
+    else
+      gt_genome_node_delete((GtGenomeNode*) pn->fn);
+  }
+  gt_array_reset(fv->pending);
+  gt_str_delete(info.error_msg);
+  return had_err;
+}
+
 static int select_visitor_feature_node(GtNodeVisitor *nv,
                                        GtFeatureNode *fn,
                                        GtError *err)
@@ -274,27 +450,40 @@ static int select_visitor_feature_node(GtNodeVisitor *nv,
                                          fv->single_intron_factor);
   }
 
+  if (fv->pending && (!select_node || gt_array_size(fv->pending))) {
+    /* evaluate the script filters later, nodes which are decided already have
+       to wait for the pending ones to keep the order */
+    GtSelectVisitorPendingNode pn;
+    pn.fn = fn;
+    pn.select_node = select_node;
+    pn.run_script_filters = !select_node;
+    gt_array_add(fv->pending, pn);
+    if (gt_array_size(fv->pending) >= SELECT_VISITOR_BATCH_SIZE) {
+      /* in case of an error the caller still owns <fn> and deletes it */
+      gt_genome_node_ref((GtGenomeNode*) fn);
+      if (!(had_err = select_visitor_evaluate_pending(fv, err)))
+        gt_genome_node_delete((GtGenomeNode*) fn);
+    }
+    return had_err;
+  }
+
   if (fv->is_lua && !select_node)
     had_err = filter_lua(fv->script_filters, fn, fv->select_logic,
                          &select_node, err);
 
-  if (select_node && !had_err)
-    fv->drophandler((GtGenomeNode*) fn, fv->data, err);
-
-  if (select_node)
-    gt_genome_node_delete((GtGenomeNode*) fn);
-  else
-    gt_queue_add(fv->node_buffer, fn);
+  select_visitor_handle_node(fv, fn, select_node, had_err, err);
 
   return had_err;
 }
 
 static int select_visitor_region_node(GtNodeVisitor *nv, GtRegionNode *rn,
-                                      GT_UNUSED GtError *err)
+                                      GtError *err)
 {
   GtSelectVisitor *select_visitor;
   gt_error_check(err);
   select_visitor = select_visitor_cast(nv);
+  if (select_visitor_evaluate_pending(select_visitor, err))
+    return -1;
   if (!gt_str_length(select_visitor->seqid) || /* no seqid was specified */
       !gt_str_cmp(select_visitor->seqid,       /* or seqids are equal */
                gt_genome_node_get_seqid((GtGenomeNode*) rn))) {
@@ -325,11 +514,13 @@ static int select_visitor_region_node(GtNodeVisitor *nv, GtRegionNode *rn,
 }
 
 static int select_visitor_sequence_node(GtNodeVisitor *nv, GtSequenceNode *sn,
-                                        GT_UNUSED GtError *err)
+                                        GtError *err)
 {
   GtSelectVisitor *select_visitor;
   gt_error_check(err);
   select_visitor = select_visitor_cast(nv);
+  if (select_visitor_evaluate_pending(select_visitor, err))
+    return -1;
   if (!gt_str_length(select_visitor->seqid) || /* no seqid was specified */
       !gt_str_cmp(select_visitor->seqid,       /* or seqids are equal */
                   gt_genome_node_get_seqid((GtGenomeNode*) sn))) {
@@ -343,11 +534,13 @@ static int select_visitor_sequence_node(GtNodeVisitor *nv, GtSequenceNode *sn,
 }
 
 static int select_visitor_eof_node(GtNodeVisitor *nv, GtEOFNode *eofn,
-                                   GT_UNUSED GtError *err)
+                                   GtError *err)
 {
   GtSelectVisitor *select_visitor;
   gt_error_check(err);
   select_visitor = select_visitor_cast(nv);
+  if (select_visitor_evaluate_pending(select_visitor, err))
+    return -1;
   gt_queue_add(select_visitor->node_buffer, eofn);
   return 0;
 }
@@ -416,22 +609,22 @@ GtNodeVisitor* gt_select_visitor_new(GtStr *seqid,
   select_visitor->is_lua = false;
 
   if (gt_str_array_size(select_visitor->select_files) > 0) {
-    int i;
     select_visitor->is_lua = true;
-    select_visitor->script_filters = gt_array_new(sizeof (GtScriptFilter*));
-    for (i = 0; i < gt_str_array_size(select_visitor->select_files); i++) {
-      GtScriptFilter *sf;
-      sf = gt_script_filter_new_unsafe(
-                                  gt_str_array_get(select_visitor->select_files,
-                                                   i),
-                                err);
-      if (!sf) {
-        gt_node_visitor_delete(nv);
-        return NULL;
-        break;
-      } else {
-        gt_array_add(select_visitor->script_filters, sf);
-      }
+    if (!(select_visitor->script_filters =
+            select_visitor_script_filters_new(select_visitor->select_files,
+                                              err))) {
+      gt_node_visitor_delete(nv);
+      return NULL;
+    }
+    if (gt_jobs > 1) {
+      select_visitor->pending =
+        gt_array_new(sizeof (GtSelectVisitorPendingNode));
+      select_visitor->filter_sets = gt_array_new(sizeof (GtArray*));
+      select_visitor->idle_filter_sets = gt_array_new(sizeof (GtArray*));
+      /* the script filters loaded here are used by one of the threads */
+      gt_array_add(select_visitor->idle_filter_sets,
+                   select_visitor->script_filters);
+      select_visitor->filter_sets_lock = gt_mutex_new();
     }
   }
   if (strcmp(gt_str_get(select_logic), "AND") == 0) {
@@ -470,3 +663,10 @@ void gt_select_visitor_set_drophandler(GtSelectVisitor *fv,
   fv->drophandler = fp;
   fv->data = data;
 }
+
+int gt_select_visitor_flush(GtNodeVisitor *nv, GtError *err)
+{
+  GtSelectVisitor *select_visitor = select_visitor_cast(nv);
+  gt_error_check(err);
+  return select_visitor_evaluate_pending(select_visitor, err);
+}
@@ -47,6 +47,10 @@ void           gt_select_visitor_set_single_intron_factor(GtNodeVisitor*,
                                                           double);
 GtUword  gt_select_visitor_node_buffer_size(GtNodeVisitor*);
 GtGenomeNode*  gt_select_visitor_get_node(GtNodeVisitor*);
+/* Moves the feature nodes which are held back to evaluate the Lua filters for
+   several nodes in parallel to the node buffer (or drops them). Has to be
+   called after the last node has been visited. */
+int            gt_select_visitor_flush(GtNodeVisitor*, GtError*);
 void           gt_select_visitor_set_drophandler(GtSelectVisitor *fv,
                                                  GtSelectNodeFunc fp,
                                                  void *data);
@@ -15,25 +15,475 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <stdio.h>
+#include <string.h>
 #include "core/array.h"
 #include "core/assert_api.h"
 #include "core/class_alloc_lock.h"
+#include "core/ensure.h"
+#include "core/fa.h"
+#include "core/hashmap_api.h"
+#include "core/ma_api.h"
+#include "core/unused_api.h"
+#include "core/xansi_api.h"
+#include "extended/array_in_stream_api.h"
 #include "extended/eof_node_api.h"
+#include "extended/feature_node_iterator_api.h"
+#include "extended/feature_node_rep.h"
 #include "extended/genome_node.h"
+#include "extended/genome_node_serializer.h"
 #include "extended/node_stream_api.h"
+#include "extended/priority_queue.h"
+#include "extended/sequence_node_api.h"
 #include "extended/sort_stream.h"
+#include "extended/union_find.h"
+
+/* a node kept in memory. Nodes comparing equal are sorted by <seqnum>, their
+   position in the input, so that the sorting is stable however the nodes are
+   distributed over runs. */
+typedef struct {
+  GtGenomeNode *gn;
+  GtUword seqnum;
+} GtSortStreamNode;
+
+/* a sorted run of nodes stored in a temporary file, or the nodes kept in
+   memory if <fp> is NULL. A file stores the position in the input before each
+   serialized node. */
+typedef struct {
+  FILE *fp;
+  GtGenomeNodeSerializer *serializer;
+  GtGenomeNode *current; /* the smallest node of the run not delivered yet */
+  GtUword seqnum, /* the position of <current> in the input */
+          level; /* the number of merges the run resulted from */
+} GtSortStreamRun;
 
 struct GtSortStream {
   const GtNodeStream parent_instance;
   GtNodeStream *in_stream;
-  GtUword idx;
-  GtArray *nodes;
+  GtUword idx,
+          nof_nodes, /* number of nodes read so far */
+          memlimit,
+          memused,
+          memheld,
+          max_fanin;
+  GtArray *nodes,
+          *runs;
+  GtSortStreamRun memory_run;
+  GtPriorityQueue *merge_queue;
+  GtGenomeNode *lookahead;
   bool sorted;
 };
 
 #define gt_sort_stream_cast(GS)\
         gt_node_stream_cast(gt_sort_stream_class(), GS);
 
+static void add_attribute_size(const char *attr_name, const char *attr_value,
+                               void *data)
+{
+  GtUword *size = data;
+  *size += strlen(attr_name) + strlen(attr_value) + 2;
+}
+
+static int add_feature_size(GtFeatureNode *fn, void *data,
+                            GT_UNUSED GtError *err)
+{
+  GtUword *size = data;
+  *size += sizeof (GtFeatureNode);
+  gt_feature_node_foreach_attribute(fn, add_attribute_size, size);
+  return 0;
+}
+
+/* returns a rough estimate of the memory occupied by <gn> */
+static GtUword sort_stream_node_size(GtGenomeNode *gn)
+{
+  GtFeatureNode *fn;
+  GtSequenceNode *sn;
+  GtUword size = 0;
+  if ((fn = gt_feature_node_try_cast(gn))) {
+    (void) gt_feature_node_traverse_children(fn, &size, add_feature_size,
+                                             false, NULL);
+  }
+  else if ((sn = gt_sequence_node_try_cast(gn)))
+    size = gt_sequence_node_get_sequence_length(sn);
+  return size + sizeof (GtGenomeNode);
+}
+
+static void sort_stream_run_create(GtSortStreamRun *run, GtUword level)
+{
+  run->fp = gt_xtmpfp_generic(NULL, TMPFP_OPENBINARY | TMPFP_AUTOREMOVE);
+  run->serializer = gt_genome_node_serializer_new(run->fp);
+  run->current = NULL;
+  run->seqnum = 0;
+  run->level = level;
+}
+
+static void sort_stream_run_delete(GtSortStreamRun *run)
+{
+  gt_genome_node_delete(run->current);
+  run->current = NULL;
+  gt_genome_node_serializer_delete(run->serializer);
+  run->serializer = NULL;
+  gt_fa_xfclose(run->fp);
+  run->fp = NULL;
+}
+
+/* appends <gn> with its input position <seqnum> to the file of <run> */
+static int sort_stream_run_write(GtSortStreamRun *run, GtGenomeNode *gn,
+                                 GtUword seqnum, GtError *err)
+{
+  gt_xfwrite_one(&seqnum, run->fp);
+  return gt_genome_node_serializer_write(run->serializer, gn, err);
+}
+
+/* reads the next node of <run> into its <current> node */
+static int sort_stream_run_advance(GtSortStream *sort_stream,
+                                   GtSortStreamRun *run, GtError *err)
+{
+  GtSortStreamNode *node;
+  run->current = NULL;
+  if (run->serializer) {
+    if (gt_xfread_one(&run->seqnum, run->fp) != 1)
+      return 0; /* all nodes read */
+    return gt_genome_node_serializer_read(run->serializer, &run->current,
+                                          err);
+  }
+  if (sort_stream->idx < gt_array_size(sort_stream->nodes)) {
+    node = gt_array_get(sort_stream->nodes, sort_stream->idx);
+    run->current = node->gn;
+    run->seqnum = node->seqnum;
+    sort_stream->idx++;
+  }
+  return 0;
+}
+
+static int sort_stream_cmp(GtGenomeNode *gn_a, GtUword seqnum_a,
+                           GtGenomeNode *gn_b, GtUword seqnum_b)
+{
+  int rval = gt_genome_node_cmp(gn_a, gn_b);
+  if (rval)
+    return rval;
+  if (seqnum_a < seqnum_b)
+    return -1;
+  return seqnum_a == seqnum_b ? 0 : 1;
+}
+
+static int sort_stream_node_cmp(const void *a, const void *b)
+{
+  const GtSortStreamNode *node_a = a, *node_b = b;
+  return sort_stream_cmp(node_a->gn, node_a->seqnum, node_b->gn,
+                         node_b->seqnum);
+}
+
+static int sort_stream_run_cmp(const void *a, const void *b)
+{
+  const GtSortStreamRun *run_a = a, *run_b = b;
+  return sort_stream_cmp(run_a->current, run_a->seqnum, run_b->current,
+                         run_b->seqnum);
+}
+
+/* merges the consecutive <runs> into the new run <merged>. The merged runs
+   are deleted, <merged> has to be deleted by the caller (also on error). */
+static int sort_stream_merge_runs(GtSortStream *sort_stream,
+                                  GtSortStreamRun *runs, GtUword nof_runs,
+                                  GtSortStreamRun *merged, GtError *err)
+{
+  GtPriorityQueue *queue;
+  GtSortStreamRun *run;
+  GtUword i, level = 0;
+  int had_err = 0;
+  gt_error_check(err);
+  queue = gt_priority_queue_new(sort_stream_run_cmp, nof_runs);
+  for (i = 0; !had_err && i < nof_runs; i++) {
+    run = runs + i;
+    if (run->level > level)
+      level = run->level;
+    gt_genome_node_serializer_rewind(run->serializer);
+    had_err = sort_stream_run_advance(sort_stream, run, err);
+    if (!had_err && run->current)
+      gt_priority_queue_add(queue, run);
+  }
+  sort_stream_run_create(merged, level + 1);
+  while (!had_err && !gt_priority_queue_is_empty(queue)) {
+    run = gt_priority_queue_extract_min(queue);
+    had_err = sort_stream_run_write(merged, run->current, run->seqnum, err);
+    gt_genome_node_delete(run->current);
+    if (!had_err)
+      had_err = sort_stream_run_advance(sort_stream, run, err);
+    else
+      run->current = NULL;
+    if (!had_err && run->current)
+      gt_priority_queue_add(queue, run);
+  }
+  gt_priority_queue_delete(queue);
+  for (i = 0; i < nof_runs; i++)
+    sort_stream_run_delete(runs + i);
+  return had_err;
+}
+
+/* Merges the last runs as long as there are <max_fanin> of them which resulted
+   from the same number of merges. This keeps the number of open temporary
+   files logarithmic in the input size, every node is rewritten only once per
+   level. */
+static int sort_stream_merge_levels(GtSortStream *sort_stream, GtError *err)
+{
+  GtSortStreamRun merged, *last;
+  GtUword nof_runs;
+  int had_err = 0;
+  gt_error_check(err);
+  while (!had_err &&
+         (nof_runs = gt_array_size(sort_stream->runs)) >=
+         sort_stream->max_fanin) {
+    last = gt_array_get_last(sort_stream->runs);
+    if (((GtSortStreamRun*) gt_array_get(sort_stream->runs,
+                                         nof_runs - sort_stream->max_fanin))
+        ->level != last->level) {
+      break;
+    }
+    had_err = sort_stream_merge_runs(sort_stream,
+                                     gt_array_get(sort_stream->runs,
+                                                  nof_runs -
+                                                  sort_stream->max_fanin),
+                                     sort_stream->max_fanin, &merged, err);
+    gt_array_set_size(sort_stream->runs, nof_runs - sort_stream->max_fanin);
+    gt_array_add(sort_stream->runs, merged);
+  }
+  return had_err;
+}
+
+/* Marks the nodes in memory which are linked to another top-level node by a
+   multi-feature. Such a link cannot be serialized, these nodes are therefore
+   kept in memory, together with all nodes they are linked to. That includes
+   representatives without a member in memory and members whose representative
+   is not in memory, their counterparts might arrive later. Returns NULL if
+   no node is linked. */
+static bool* sort_stream_linked_nodes(GtSortStream *sort_stream)
+{
+  GtFeatureNodeIterator *fni;
+  GtFeatureNode *fn, *child, *rep;
+  GtHashmap *multi_nodes, *reps_with_members;
+  GtUnionFind *uf = NULL;
+  GtUword i, j, nof_nodes = gt_array_size(sort_stream->nodes);
+  bool *linked = NULL, *component_linked, any_multi = false,
+       any_linked = false;
+
+  /* map the multi-features in memory to the index of their top-level node */
+  multi_nodes = gt_hashmap_new(GT_HASH_DIRECT, NULL, NULL);
+  for (i = 0; i < nof_nodes; i++) {
+    if (!(fn = gt_feature_node_try_cast(((GtSortStreamNode*)
+                                         gt_array_get(sort_stream->nodes, i))
+                                        ->gn))) {
+      continue;
+    }
+    fni = gt_feature_node_iterator_new(fn);
+    while ((child = gt_feature_node_iterator_next(fni))) {
+      if (gt_feature_node_is_multi(child) &&
+          !gt_hashmap_get(multi_nodes, child)) {
+        gt_hashmap_add(multi_nodes, child, (void*) (i + 1));
+        any_multi = true;
+      }
+    }
+    gt_feature_node_iterator_delete(fni);
+  }
+  if (!any_multi) {
+    gt_hashmap_delete(multi_nodes);
+    return NULL;
+  }
+
+  linked = gt_calloc(nof_nodes, sizeof *linked);
+  reps_with_members = gt_hashmap_new(GT_HASH_DIRECT, NULL, NULL);
+  uf = gt_union_find_new(nof_nodes);
+  for (i = 0; i < nof_nodes; i++) {
+    if (!(fn = gt_feature_node_try_cast(((GtSortStreamNode*)
+                                         gt_array_get(sort_stream->nodes, i))
+                                        ->gn))) {
+      continue;
+    }
+    fni = gt_feature_node_iterator_new(fn);
+    while ((child = gt_feature_node_iterator_next(fni))) {
+      if (!gt_feature_node_is_multi(child) ||
+          (rep = gt_feature_node_get_multi_representative(child)) == child) {
+        continue;
+      }
+      gt_hashmap_add(reps_with_members, rep, rep);
+      if (!(j = (GtUword) gt_hashmap_get(multi_nodes, rep)))
+        linked[i] = any_linked = true;
+      else if (--j != i) {
+        gt_union_find_union(uf, i, j);
+        linked[i] = linked[j] = any_linked = true;
+      }
+    }
+    gt_feature_node_iterator_delete(fni);
+  }
+  /* representatives whose members are all somewhere else */
+  for (i = 0; i < nof_nodes; i++) {
+    if (!(fn = gt_feature_node_try_cast(((GtSortStreamNode*)
+                                         gt_array_get(sort_stream->nodes, i))
+                                        ->gn))) {
+      continue;
+    }
+    fni = gt_feature_node_iterator_new(fn);
+    while ((child = gt_feature_node_iterator_next(fni))) {
+      if (gt_feature_node_is_multi(child) &&
+          gt_feature_node_get_multi_representative(child) == child &&
+          !gt_hashmap_get(reps_with_members, child)) {
+        linked[i] = any_linked = true;
+      }
+    }
+    gt_feature_node_iterator_delete(fni);
+  }
+
+  if (any_linked) {
+    /* extend the marks to complete components */
+    component_linked = gt_calloc(nof_nodes, sizeof *component_linked);
+    for (i = 0; i < nof_nodes; i++) {
+      if (linked[i])
+        component_linked[gt_union_find_find(uf, i)] = true;
+    }
+    for (i = 0; i < nof_nodes; i++)
+      linked[i] = component_linked[gt_union_find_find(uf, i)];
+    gt_free(component_linked);
+  }
+  else {
+    gt_free(linked);
+    linked = NULL;
+  }
+  gt_union_find_delete(uf);
+  gt_hashmap_delete(reps_with_members);
+  gt_hashmap_delete(multi_nodes);
+  return linked;
+}
+
+/* sorts the nodes collected so far and writes them to a new run, except for
+   the nodes which are linked by multi-features */
+static int sort_stream_spill_run(GtSortStream *sort_stream, GtError *err)
+{
+  GtSortStreamRun run;
+  GtArray *held;
+  GtUword i;
+  bool *linked;
+  int had_err = 0;
+  gt_error_check(err);
+  linked = sort_stream_linked_nodes(sort_stream);
+  held = gt_array_new(sizeof (GtSortStreamNode));
+  sort_stream->memheld = 0;
+  if (linked) {
+    GtSortStreamNode *nodes = gt_array_get_space(sort_stream->nodes);
+    GtUword nof_spilled = 0;
+    for (i = 0; i < gt_array_size(sort_stream->nodes); i++) {
+      if (linked[i]) {
+        gt_array_add(held, nodes[i]);
+        sort_stream->memheld += sort_stream_node_size(nodes[i].gn);
+      }
+      else
+        nodes[nof_spilled++] = nodes[i];
+    }
+    gt_array_set_size(sort_stream->nodes, nof_spilled);
+    gt_free(linked);
+  }
+  if (gt_array_size(sort_stream->nodes)) {
+    gt_array_sort(sort_stream->nodes, sort_stream_node_cmp);
+    sort_stream_run_create(&run, 0);
+    for (i = 0; i < gt_array_size(sort_stream->nodes); i++) {
+      GtSortStreamNode *node = gt_array_get(sort_stream->nodes, i);
+      if (!had_err)
+        had_err = sort_stream_run_write(&run, node->gn, node->seqnum, err);
+      gt_genome_node_delete(node->gn);
+    }
+    gt_array_add(sort_stream->runs, run);
+  }
+  gt_array_reset(sort_stream->nodes);
+  gt_array_add_array(sort_stream->nodes, held);
+  gt_array_delete(held);
+  sort_stream->memused = sort_stream->memheld;
+  if (!had_err)
+    had_err = sort_stream_merge_levels(sort_stream, err);
+  return had_err;
+}
+
+/* prepares the k-way merge of all runs and the nodes kept in memory, merging
+   groups of consecutive runs beforehand until at most <max_fanin> are left */
+static int sort_stream_start_merge(GtSortStream *sort_stream, GtError *err)
+{
+  GtSortStreamRun merged, *run;
+  GtArray *merged_runs;
+  GtUword i, nof_runs, nof_merged;
+  int had_err = 0;
+  gt_error_check(err);
+  while (!had_err &&
+         gt_array_size(sort_stream->runs) + 1 > sort_stream->max_fanin) {
+    nof_runs = gt_array_size(sort_stream->runs);
+    merged_runs = gt_array_new(sizeof (GtSortStreamRun));
+    for (i = 0; i < nof_runs; i += nof_merged) {
+      nof_merged = nof_runs - i < sort_stream->max_fanin
+                   ? nof_runs - i : sort_stream->max_fanin;
+      run = gt_array_get(sort_stream->runs, i);
+      if (had_err || nof_merged == 1) {
+        /* keep the remaining runs to delete them in any case */
+        GtUword j;
+        for (j = 0; j < nof_merged; j++)
+          gt_array_add(merged_runs, run[j]);
+      }
+      else {
+        had_err = sort_stream_merge_runs(sort_stream, run, nof_merged, &merged,
+                                         err);
+        gt_array_add(merged_runs, merged);
+      }
+    }
+    gt_array_delete(sort_stream->runs);
+    sort_stream->runs = merged_runs;
+  }
+  if (!had_err) {
+    nof_runs = gt_array_size(sort_stream->runs);
+    sort_stream->merge_queue =
+      gt_priority_queue_new(sort_stream_run_cmp, nof_runs + 1);
+    gt_array_sort(sort_stream->nodes, sort_stream_node_cmp);
+    had_err = sort_stream_run_advance(sort_stream, &sort_stream->memory_run,
+                                      err);
+    if (!had_err && sort_stream->memory_run.current) {
+      gt_priority_queue_add(sort_stream->merge_queue,
+                            &sort_stream->memory_run);
+    }
+  }
+  for (i = 0; !had_err && i < gt_array_size(sort_stream->runs); i++) {
+    run = gt_array_get(sort_stream->runs, i);
+    gt_genome_node_serializer_rewind(run->serializer);
+    had_err = sort_stream_run_advance(sort_stream, run, err);
+    if (!had_err && run->current)
+      gt_priority_queue_add(sort_stream->merge_queue, run);
+  }
+  return had_err;
+}
+
+/* delivers the next node in sorted order, either from memory or by merging
+   the sorted runs */
+static int sort_stream_next_sorted(GtSortStream *sort_stream,
+                                   GtGenomeNode **gn, GtError *err)
+{
+  GtSortStreamRun *run;
+  int had_err = 0;
+  gt_error_check(err);
+  *gn = NULL;
+  if (sort_stream->lookahead) {
+    *gn = sort_stream->lookahead;
+    sort_stream->lookahead = NULL;
+  }
+  else if (sort_stream->merge_queue) {
+    if (!gt_priority_queue_is_empty(sort_stream->merge_queue)) {
+      run = gt_priority_queue_extract_min(sort_stream->merge_queue);
+      *gn = run->current;
+      had_err = sort_stream_run_advance(sort_stream, run, err);
+      if (!had_err && run->current)
+        gt_priority_queue_add(sort_stream->merge_queue, run);
+    }
+  }
+  else if (sort_stream->idx < gt_array_size(sort_stream->nodes)) {
+    *gn = ((GtSortStreamNode*) gt_array_get(sort_stream->nodes,
+                                            sort_stream->idx))->gn;
+    sort_stream->idx++;
+  }
+  return had_err;
+}
+
 static int gt_sort_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
                                GtError *err)
 {
@@ -49,48 +499,60 @@ static int gt_sort_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
                                            err)) && node) {
       if ((eofn = gt_eof_node_try_cast(node)))
         gt_genome_node_delete(node); /* get rid of EOF nodes */
-      else
-        gt_array_add(sort_stream->nodes, node);
+      else {
+        GtSortStreamNode sort_node;
+        sort_node.gn = node;
+        sort_node.seqnum = sort_stream->nof_nodes++;
+        gt_array_add(sort_stream->nodes, sort_node);
+        if (sort_stream->memlimit) {
+          sort_stream->memused += sort_stream_node_size(node);
+          /* the nodes held back by the last spill do not count */
+          if (sort_stream->memused - sort_stream->memheld >
+              sort_stream->memlimit &&
+              (had_err = sort_stream_spill_run(sort_stream, err))) {
+            break;
+          }
+        }
+      }
     }
     if (!had_err) {
-      gt_genome_nodes_sort_stable(sort_stream->nodes);
-      sort_stream->sorted = true;
+      if (gt_array_size(sort_stream->runs))
+        had_err = sort_stream_start_merge(sort_stream, err);
+      else
+        gt_array_sort(sort_stream->nodes, sort_stream_node_cmp);
     }
+    if (!had_err)
+      sort_stream->sorted = true;
   }
 
   if (!had_err) {
     gt_assert(sort_stream->sorted);
-    if (sort_stream->idx < gt_array_size(sort_stream->nodes)) {
-      *gn = *(GtGenomeNode**) gt_array_get(sort_stream->nodes,
-                                           sort_stream->idx);
-      sort_stream->idx++;
-      /* join region nodes with the same sequence ID */
-      if (gt_region_node_try_cast(*gn)) {
-        GtRange range_a, range_b;
-        while (sort_stream->idx < gt_array_size(sort_stream->nodes)) {
-          node = *(GtGenomeNode**) gt_array_get(sort_stream->nodes,
-                                                sort_stream->idx);
-          if (!gt_region_node_try_cast(node) ||
-              gt_str_cmp(gt_genome_node_get_seqid(*gn),
-                         gt_genome_node_get_seqid(node))) {
-            /* the next node is not a region node with the same ID */
-            break;
-          }
-          range_a = gt_genome_node_get_range(*gn);
-          range_b = gt_genome_node_get_range(node);
-          range_a = gt_range_join(&range_a, &range_b);
-          gt_genome_node_set_range(*gn, &range_a);
-          gt_genome_node_delete(node);
-          sort_stream->idx++;
+    had_err = sort_stream_next_sorted(sort_stream, gn, err);
+    /* join region nodes with the same sequence ID */
+    if (!had_err && *gn && gt_region_node_try_cast(*gn)) {
+      GtRange range_a, range_b;
+      while (!(had_err = sort_stream_next_sorted(sort_stream, &node, err)) &&
+             node) {
+        if (!gt_region_node_try_cast(node) ||
+            gt_str_cmp(gt_genome_node_get_seqid(*gn),
+                       gt_genome_node_get_seqid(node))) {
+          /* the next node is not a region node with the same ID */
+          sort_stream->lookahead = node;
+          break;
         }
+        range_a = gt_genome_node_get_range(*gn);
+        range_b = gt_genome_node_get_range(node);
+        range_a = gt_range_join(&range_a, &range_b);
+        gt_genome_node_set_range(*gn, &range_a);
+        gt_genome_node_delete(node);
+      }
+      if (had_err) {
+        gt_genome_node_delete(*gn);
+        *gn = NULL;
       }
-      return 0;
     }
-  }
-
-  if (!had_err) {
-    gt_array_reset(sort_stream->nodes);
-    *gn = NULL;
+    if (!had_err && !*gn)
+      gt_array_reset(sort_stream->nodes);
   }
 
   return had_err;
@@ -101,10 +563,16 @@ static void gt_sort_stream_free(GtNodeStream *ns)
   GtUword i;
   GtSortStream *sort_stream = gt_sort_stream_cast(ns);
   for (i = sort_stream->idx; i < gt_array_size(sort_stream->nodes); i++) {
-    gt_genome_node_delete(*(GtGenomeNode**)
-                          gt_array_get(sort_stream->nodes, i));
+    gt_genome_node_delete(((GtSortStreamNode*)
+                           gt_array_get(sort_stream->nodes, i))->gn);
   }
   gt_array_delete(sort_stream->nodes);
+  for (i = 0; i < gt_array_size(sort_stream->runs); i++)
+    sort_stream_run_delete(gt_array_get(sort_stream->runs, i));
+  gt_array_delete(sort_stream->runs);
+  gt_genome_node_delete(sort_stream->memory_run.current);
+  gt_priority_queue_delete(sort_stream->merge_queue);
+  gt_genome_node_delete(sort_stream->lookahead);
   gt_node_stream_delete(sort_stream->in_stream);
 }
 
@@ -129,6 +597,154 @@ GtNodeStream* gt_sort_stream_new(GtNodeStream *in_stream)
   sort_stream->in_stream = gt_node_stream_ref(in_stream);
   sort_stream->sorted = false;
   sort_stream->idx = 0;
-  sort_stream->nodes = gt_array_new(sizeof (GtGenomeNode*));
+  sort_stream->nof_nodes = 0;
+  sort_stream->nodes = gt_array_new(sizeof (GtSortStreamNode));
+  sort_stream->runs = gt_array_new(sizeof (GtSortStreamRun));
+  sort_stream->merge_queue = NULL;
+  sort_stream->lookahead = NULL;
+  sort_stream->memlimit = 0;
+  sort_stream->memused = 0;
+  sort_stream->memheld = 0;
+  sort_stream->max_fanin = GT_SORT_STREAM_MAX_FANIN;
+  sort_stream->memory_run.fp = NULL;
+  sort_stream->memory_run.serializer = NULL;
+  sort_stream->memory_run.current = NULL;
+  sort_stream->memory_run.seqnum = 0;
+  sort_stream->memory_run.level = 0;
   return ns;
 }
+
+void gt_sort_stream_set_memlimit(GtSortStream *sort_stream, GtUword memlimit)
+{
+  gt_assert(sort_stream && !sort_stream->sorted);
+  sort_stream->memlimit = memlimit;
+}
+
+void gt_sort_stream_set_max_fanin(GtSortStream *sort_stream,
+                                  GtUword max_fanin)
+{
+  gt_assert(sort_stream && !sort_stream->sorted && max_fanin >= 2);
+  sort_stream->max_fanin = max_fanin;
+}
+
+int gt_sort_stream_unit_test(GtError *err)
+{
+  GtNodeStream *in_stream, *sort_stream;
+  GtFeatureNodeIterator *fni;
+  GtFeatureNode *cds, *rep = NULL;
+  GtGenomeNode *gn;
+  GtArray *nodes, *sorted;
+  GtStr *seqid;
+  GtUword i, start, max_fanin, nof_members;
+  char buf[BUFSIZ];
+  int had_err = 0;
+  gt_error_check(err);
+
+  seqid = gt_str_new_cstr("seqid");
+  for (max_fanin = 2; !had_err && max_fanin <= 3; max_fanin++) {
+    /* genes in reverse order, three of them share a multi-feature CDS */
+    nodes = gt_array_new(sizeof (GtGenomeNode*));
+    for (i = 0; i < 20; i++) {
+      start = (20 - i) * 100;
+      gn = gt_feature_node_new(seqid, "gene", start, start + 50,
+                               GT_STRAND_FORWARD);
+      if (i == 3 || i == 8 || i == 12) {
+        cds = (GtFeatureNode*) gt_feature_node_new(seqid, "CDS", start,
+                                                   start + 10,
+                                                   GT_STRAND_FORWARD);
+        if (i == 3) {
+          gt_feature_node_make_multi_representative(cds);
+          rep = cds;
+        }
+        else
+          gt_feature_node_set_multi_representative(cds, rep);
+        gt_feature_node_add_child((GtFeatureNode*) gn, cds);
+      }
+      gt_array_add(nodes, gn);
+    }
+    in_stream = gt_array_in_stream_new(nodes, NULL, err);
+    sort_stream = gt_sort_stream_new(in_stream);
+    /* write every node which is not held back to its own run */
+    gt_sort_stream_set_memlimit((GtSortStream*) sort_stream, 1);
+    gt_sort_stream_set_max_fanin((GtSortStream*) sort_stream, max_fanin);
+    sorted = gt_array_new(sizeof (GtGenomeNode*));
+    while (!(had_err = gt_node_stream_next(sort_stream, &gn, err)) && gn)
+      gt_array_add(sorted, gn);
+    gt_ensure(gt_array_size(sorted) == 20);
+    nof_members = 0;
+    for (i = 0; !had_err && i < gt_array_size(sorted); i++) {
+      gn = *(GtGenomeNode**) gt_array_get(sorted, i);
+      gt_ensure(gt_genome_node_get_start(gn) == (i + 1) * 100);
+      fni = gt_feature_node_iterator_new_direct((GtFeatureNode*) gn);
+      while (!had_err && (cds = gt_feature_node_iterator_next(fni))) {
+        /* the multi-feature links survived the sorting */
+        gt_ensure(gt_feature_node_is_multi(cds));
+        if (!had_err && gt_genome_node_get_start((GtGenomeNode*) cds) == 1700)
+          gt_ensure(gt_feature_node_get_multi_representative(cds) == cds);
+        else if (!had_err) {
+          gt_ensure(gt_genome_node_get_start((GtGenomeNode*)
+                                        gt_feature_node_get_multi_representative
+                                        (cds)) == 1700);
+          nof_members++;
+        }
+      }
+      gt_feature_node_iterator_delete(fni);
+    }
+    gt_ensure(nof_members == 2);
+    for (i = 0; i < gt_array_size(sorted); i++)
+      gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(sorted, i));
+    gt_array_delete(sorted);
+    gt_node_stream_delete(sort_stream);
+    gt_node_stream_delete(in_stream);
+    gt_array_delete(nodes);
+  }
+
+  for (max_fanin = 2; !had_err && max_fanin <= 3; max_fanin++) {
+    /* genes with equal ranges keep their input order, including the genes
+       held back because of their multi-feature CDS */
+    nodes = gt_array_new(sizeof (GtGenomeNode*));
+    for (i = 0; i < 12; i++) {
+      start = (i % 3 + 1) * 100;
+      gn = gt_feature_node_new(seqid, "gene", start, start + 50,
+                               GT_STRAND_FORWARD);
+      (void) snprintf(buf, BUFSIZ, GT_WU, i);
+      gt_feature_node_add_attribute((GtFeatureNode*) gn, "n", buf);
+      if (i == 3 || i == 6 || i == 10) {
+        cds = (GtFeatureNode*) gt_feature_node_new(seqid, "CDS", start,
+                                                   start + 10,
+                                                   GT_STRAND_FORWARD);
+        if (i == 3) {
+          gt_feature_node_make_multi_representative(cds);
+          rep = cds;
+        }
+        else
+          gt_feature_node_set_multi_representative(cds, rep);
+        gt_feature_node_add_child((GtFeatureNode*) gn, cds);
+      }
+      gt_array_add(nodes, gn);
+    }
+    in_stream = gt_array_in_stream_new(nodes, NULL, err);
+    sort_stream = gt_sort_stream_new(in_stream);
+    gt_sort_stream_set_memlimit((GtSortStream*) sort_stream, 1);
+    gt_sort_stream_set_max_fanin((GtSortStream*) sort_stream, max_fanin);
+    sorted = gt_array_new(sizeof (GtGenomeNode*));
+    while (!(had_err = gt_node_stream_next(sort_stream, &gn, err)) && gn)
+      gt_array_add(sorted, gn);
+    gt_ensure(gt_array_size(sorted) == 12);
+    for (i = 0; !had_err && i < gt_array_size(sorted); i++) {
+      gn = *(GtGenomeNode**) gt_array_get(sorted, i);
+      gt_ensure(gt_genome_node_get_start(gn) == (i / 4 + 1) * 100);
+      (void) snprintf(buf, BUFSIZ, GT_WU, (i % 4) * 3 + i / 4);
+      gt_ensure(!strcmp(gt_feature_node_get_attribute((GtFeatureNode*) gn,
+                                                      "n"), buf));
+    }
+    for (i = 0; i < gt_array_size(sorted); i++)
+      gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(sorted, i));
+    gt_array_delete(sorted);
+    gt_node_stream_delete(sort_stream);
+    gt_node_stream_delete(in_stream);
+    gt_array_delete(nodes);
+  }
+  gt_str_delete(seqid);
+  return had_err;
+}
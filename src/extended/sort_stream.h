@@ -20,6 +20,18 @@
 
 #include "extended/sort_stream_api.h"
 
+/* the default maximal number of runs which are merged at once, every run keeps
+   a temporary file open */
+#define GT_SORT_STREAM_MAX_FANIN  16
+
 const GtNodeStreamClass* gt_sort_stream_class(void);
+/* Merge at most <max_fanin> (>= 2) sorted runs at once, larger numbers of runs
+   are merged in several passes. Must be called before the first node is
+   retrieved from <sort_stream>. */
+void                     gt_sort_stream_set_max_fanin(GtSortStream
+                                                      *sort_stream,
+                                                      GtUword max_fanin);
+
+int                      gt_sort_stream_unit_test(GtError *err);
 
 #endif
@@ -27,5 +27,12 @@ typedef struct GtSortStream GtSortStream;
 /* Create a <GtSortStream*> which sorts the genome nodes it retrieves from
    <in_stream> and returns them unmodified, but in sorted order. */
 GtNodeStream* gt_sort_stream_new(GtNodeStream *in_stream);
+/* Limit the memory <sort_stream> uses to hold genome nodes to roughly
+   <memlimit> bytes. Whenever the limit is exceeded, the nodes collected so far
+   are sorted and written to a temporary file. These sorted runs are merged
+   afterwards. A <memlimit> of 0 (the default) keeps all nodes in memory.
+   Must be called before the first node is retrieved from <sort_stream>. */
+void          gt_sort_stream_set_memlimit(GtSortStream *sort_stream,
+                                          GtUword memlimit);
 
 #endif
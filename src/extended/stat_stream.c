@@ -18,8 +18,10 @@
 #include "core/assert_api.h"
 #include "core/class_alloc_lock.h"
 #include "extended/eof_node_api.h"
+#include "extended/feature_node_api.h"
 #include "extended/genome_node.h"
-#include "extended/stat_stream_api.h"
+#include "extended/packed_features.h"
+#include "extended/stat_stream.h"
 #include "extended/stat_visitor.h"
 #include "extended/node_stream_api.h"
 
@@ -27,6 +29,7 @@ struct GtStatStream {
   const GtNodeStream parent_instance;
   GtNodeStream *in_stream;
   GtNodeVisitor *stat_visitor;
+  GtPackedFeatures *packed_features; /* NULL unless the features are packed */
   GtUword number_of_DAGs;
 };
 
@@ -38,6 +41,8 @@ const GtNodeStreamClass* gt_stat_stream_class(void);
 static int stat_stream_next(GtNodeStream *ns, GtGenomeNode **gn, GtError *err)
 {
   GtStatStream *stat_stream;
+  GtFeatureNode *fn;
+  GtUword i;
   int had_err;
   gt_error_check(err);
   stat_stream = stat_stream_cast(ns);
@@ -47,8 +52,24 @@ static int stat_stream_next(GtNodeStream *ns, GtGenomeNode **gn, GtError *err)
     if (*gn) {
       if (!gt_eof_node_try_cast(*gn)) /* do not count EOF nodes */
         stat_stream->number_of_DAGs++;
-      had_err = gt_genome_node_accept(*gn, stat_stream->stat_visitor, err);
-      gt_assert(!had_err); /* the status visitor is sane */
+      if (stat_stream->packed_features && (fn = gt_feature_node_try_cast(*gn)))
+        (void) gt_packed_features_add(stat_stream->packed_features, fn);
+      else {
+        had_err = gt_genome_node_accept(*gn, stat_stream->stat_visitor, err);
+        gt_assert(!had_err); /* the status visitor is sane */
+      }
+    }
+    else if (stat_stream->packed_features) {
+      /* all features have been packed */
+      gt_packed_features_compact(stat_stream->packed_features);
+      for (i = 0;
+           i < gt_packed_features_num_of_graphs(stat_stream->packed_features);
+           i++) {
+        gt_stat_visitor_visit_packed_graph(stat_stream->stat_visitor,
+                                           stat_stream->packed_features, i);
+      }
+      gt_packed_features_delete(stat_stream->packed_features);
+      stat_stream->packed_features = NULL;
     }
   }
   return had_err;
@@ -57,6 +78,7 @@ static int stat_stream_next(GtNodeStream *ns, GtGenomeNode **gn, GtError *err)
 static void stat_stream_free(GtNodeStream *ns)
 {
   GtStatStream *stat_stream = stat_stream_cast(ns);
+  gt_packed_features_delete(stat_stream->packed_features);
   gt_node_visitor_delete(stat_stream->stat_visitor);
   gt_node_stream_delete(stat_stream->in_stream);
 }
@@ -90,9 +112,16 @@ GtNodeStream* gt_stat_stream_new(GtNodeStream *in_stream,
                                          exon_length_distri, exon_number_distri,
                                          intron_length_distri,
                                          cds_length_distri, used_sources);
+  ss->packed_features = NULL;
   return ns;
 }
 
+void gt_stat_stream_pack_features(GtStatStream *ss)
+{
+  gt_assert(ss && !ss->number_of_DAGs && !ss->packed_features);
+  ss->packed_features = gt_packed_features_new();
+}
+
 void gt_stat_stream_show_stats(GtStatStream *ss, GtFile *outfp)
 {
   gt_file_xprintf(outfp, "parsed genome node DAGs: "GT_WU"\n",
@@ -15,12 +15,14 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include "core/array.h"
 #include "core/assert_api.h"
 #include "core/class_alloc_lock.h"
 #include "core/compat.h"
 #include "core/cstr_table_api.h"
 #include "core/disc_distri_api.h"
 #include "core/string_distri.h"
+#include "core/strcmp_api.h"
 #include "core/unused_api.h"
 #include "extended/feature_node.h"
 #include "extended/node_visitor_api.h"
@@ -81,61 +83,74 @@ static int add_exon_or_cds_number(GtFeatureNode *fn, void *data,
   return 0;
 }
 
-static void compute_source_statistics(GtFeatureNode *fn,
+static void compute_source_statistics(const char *source,
                                       GtCstrTable *used_sources)
 {
-  const char *source;
-  gt_assert(fn && used_sources);
-  source = gt_feature_node_get_source(fn);
+  gt_assert(source && used_sources);
   if (!gt_cstr_table_get(used_sources, source))
     gt_cstr_table_add(used_sources, source);
 }
 
-static void compute_type_statistics(GtFeatureNode *fn, GtStatVisitor *sv)
+static bool has_type(const char *type, const char *wanted)
 {
-  GtRange range;
-  gt_assert(fn && sv);
-  if (gt_feature_node_has_type(fn, gt_ft_gene)) {
+  return type && !gt_strcmp(type, wanted);
+}
+
+/* <has_CDS> is only used for genes and mRNAs */
+static void compute_type_statistics(const char *type, GtRange range,
+                                    bool has_CDS, bool score_is_defined,
+                                    float score, GtStatVisitor *sv)
+{
+  gt_assert(sv);
+  if (has_type(type, gt_ft_gene)) {
     sv->number_of_genes++;
-    if (gt_feature_node_has_CDS(fn))
+    if (has_CDS)
       sv->number_of_protein_coding_genes++;
-    if (sv->gene_length_distribution) {
-      range = gt_genome_node_get_range((GtGenomeNode*) fn);
+    if (sv->gene_length_distribution)
       gt_disc_distri_add(sv->gene_length_distribution, gt_range_length(&range));
-    }
-    if (sv->gene_score_distribution && gt_feature_node_score_is_defined(fn)) {
-      gt_disc_distri_add(sv->gene_score_distribution,
-                         gt_feature_node_get_score(fn) * 100.0);
-    }
+    if (sv->gene_score_distribution && score_is_defined)
+      gt_disc_distri_add(sv->gene_score_distribution, score * 100.0);
   }
-  else if (gt_feature_node_has_type(fn, gt_ft_mRNA)) {
+  else if (has_type(type, gt_ft_mRNA)) {
     sv->number_of_mRNAs++;
-    if (gt_feature_node_has_CDS(fn))
+    if (has_CDS)
       sv->number_of_protein_coding_mRNAs++;
   }
-  else if (gt_feature_node_has_type(fn, gt_ft_exon)) {
+  else if (has_type(type, gt_ft_exon)) {
     sv->number_of_exons++;
     if (sv->exon_length_distribution) {
-      range = gt_genome_node_get_range((GtGenomeNode*) fn);
       gt_disc_distri_add(sv->exon_length_distribution,
                          gt_range_length(&range));
     }
   }
-  else if (gt_feature_node_has_type(fn, gt_ft_CDS)) {
+  else if (has_type(type, gt_ft_CDS)) {
     sv->number_of_CDSs++;
   }
-  else if (gt_feature_node_has_type(fn, gt_ft_intron)) {
-    gt_string_distri_add(sv->type_counts, gt_feature_node_get_type(fn));
+  else if (has_type(type, gt_ft_intron)) {
+    gt_string_distri_add(sv->type_counts, type);
     if (sv->intron_length_distribution) {
-      range = gt_genome_node_get_range((GtGenomeNode*) fn);
       gt_disc_distri_add(sv->intron_length_distribution,
                          gt_range_length(&range));
     }
   }
-  else if (gt_feature_node_has_type(fn, gt_ft_LTR_retrotransposon)) {
+  else if (has_type(type, gt_ft_LTR_retrotransposon)) {
     sv->number_of_LTR_retrotransposons++;
   } else {
-    gt_string_distri_add(sv->type_counts, gt_feature_node_get_type(fn));
+    gt_string_distri_add(sv->type_counts, type);
+  }
+}
+
+/* adds the exon number and CDS length gathered from the children of a node in
+   <exon_number_for_distri> and <cds_length_for_distri> */
+static void compute_children_statistics(GtStatVisitor *sv)
+{
+  if (sv->exon_number_distribution && sv->exon_number_for_distri) {
+    gt_disc_distri_add(sv->exon_number_distribution,
+                       sv->exon_number_for_distri);
+  }
+  if (sv->cds_length_distribution && sv->cds_length_for_distri) {
+    gt_disc_distri_add(sv->cds_length_distribution,
+                       sv->cds_length_for_distri);
   }
 }
 
@@ -151,8 +166,16 @@ static int compute_statistics(GtFeatureNode *fn, void *data, GtError *err)
     sv->number_of_multi_features++;
   }
   if (sv->used_sources)
-    compute_source_statistics(fn, sv->used_sources);
-  compute_type_statistics(fn, sv);
+    compute_source_statistics(gt_feature_node_get_source(fn),
+                              sv->used_sources);
+  compute_type_statistics(gt_feature_node_get_type(fn),
+                          gt_genome_node_get_range((GtGenomeNode*) fn),
+                          (gt_feature_node_has_type(fn, gt_ft_gene) ||
+                           gt_feature_node_has_type(fn, gt_ft_mRNA)) &&
+                          gt_feature_node_has_CDS(fn),
+                          gt_feature_node_score_is_defined(fn),
+                          gt_feature_node_score_is_defined(fn)
+                          ? gt_feature_node_get_score(fn) : 0.0, sv);
   if (sv->exon_number_distribution || sv->cds_length_distribution) {
     sv->exon_number_for_distri = 0;
     sv->cds_length_for_distri = 0;
@@ -160,16 +183,67 @@ static int compute_statistics(GtFeatureNode *fn, void *data, GtError *err)
                                                     add_exon_or_cds_number,
                                                     err);
     gt_assert(!rval); /* add_exon_or_cds_number() is sane */
-    if (sv->exon_number_distribution && sv->exon_number_for_distri) {
-      gt_disc_distri_add(sv->exon_number_distribution,
-                         sv->exon_number_for_distri);
+    compute_children_statistics(sv);
+  }
+  return 0;
+}
+
+/* returns true if <node> of <pf> or one of its descendants is a CDS */
+static bool packed_has_CDS(const GtPackedFeatures *pf, GtUword node,
+                           GtArray *stack)
+{
+  GtUword i;
+  gt_array_reset(stack);
+  gt_array_add(stack, node);
+  while (gt_array_size(stack)) {
+    node = *(GtUword*) gt_array_pop(stack);
+    if (has_type(gt_packed_features_get_type(pf, node), gt_ft_CDS))
+      return true;
+    for (i = 0; i < gt_packed_features_number_of_children(pf, node); i++) {
+      GtUword child = gt_packed_features_get_child(pf, node, i);
+      gt_array_add(stack, child);
     }
-    if (sv->cds_length_distribution && sv->cds_length_for_distri) {
-      gt_disc_distri_add(sv->cds_length_distribution,
-                         sv->cds_length_for_distri);
+  }
+  return false;
+}
+
+static void compute_packed_statistics(GtStatVisitor *sv,
+                                      const GtPackedFeatures *pf, GtUword node,
+                                      GtArray *stack)
+{
+  const char *type = gt_packed_features_get_type(pf, node);
+  GtRange range;
+  GtUword i, child;
+  bool score_is_defined = gt_packed_features_score_is_defined(pf, node);
+  if (gt_packed_features_is_multi(pf, node) &&
+      gt_packed_features_get_multi_representative(pf, node) == node) {
+    sv->number_of_multi_features++;
+  }
+  if (sv->used_sources)
+    compute_source_statistics(gt_packed_features_get_source(pf, node),
+                              sv->used_sources);
+  compute_type_statistics(type, gt_packed_features_get_range(pf, node),
+                          (has_type(type, gt_ft_gene) ||
+                           has_type(type, gt_ft_mRNA)) &&
+                          packed_has_CDS(pf, node, stack),
+                          score_is_defined,
+                          score_is_defined
+                          ? gt_packed_features_get_score(pf, node) : 0.0, sv);
+  if (sv->exon_number_distribution || sv->cds_length_distribution) {
+    sv->exon_number_for_distri = 0;
+    sv->cds_length_for_distri = 0;
+    for (i = 0; i < gt_packed_features_number_of_children(pf, node); i++) {
+      child = gt_packed_features_get_child(pf, node, i);
+      type = gt_packed_features_get_type(pf, child);
+      if (has_type(type, gt_ft_exon))
+        sv->exon_number_for_distri++;
+      else if (has_type(type, gt_ft_CDS)) {
+        range = gt_packed_features_get_range(pf, child);
+        sv->cds_length_for_distri += gt_range_length(&range);
+      }
     }
+    compute_children_statistics(sv);
   }
-  return 0;
 }
 
 static int stat_visitor_feature_node(GtNodeVisitor *nv, GtFeatureNode *fn,
@@ -249,6 +323,44 @@ static void gt_stat_print_string_distri_item(const char *string,
   gt_file_xprintf(outfp, "%ss: "GT_WU"\n", string, occurrences);
 }
 
+void gt_stat_visitor_visit_packed_graph(GtNodeVisitor *nv,
+                                        const GtPackedFeatures *pf,
+                                        GtUword graph)
+{
+  GtStatVisitor *sv = stat_visitor_cast(nv);
+  GtArray *node_stack, *cds_stack;
+  GtUword node, i, nof_children;
+  gt_assert(pf);
+  node_stack = gt_array_new(sizeof (GtUword));
+  cds_stack = gt_array_new(sizeof (GtUword));
+  /* visit the nodes like gt_feature_node_traverse_children() does, that is, a
+     node with several parents is visited once per parent and a pseudo-node is
+     skipped */
+  node = gt_packed_features_get_root(pf, graph);
+  if (gt_packed_features_is_pseudo(pf, node)) {
+    nof_children = gt_packed_features_number_of_children(pf, node);
+    for (i = 0; i < nof_children; i++) {
+      GtUword child = gt_packed_features_get_child(pf, node,
+                                                   nof_children - i - 1);
+      gt_array_add(node_stack, child);
+    }
+  }
+  else
+    gt_array_add(node_stack, node);
+  while (gt_array_size(node_stack)) {
+    node = *(GtUword*) gt_array_pop(node_stack);
+    compute_packed_statistics(sv, pf, node, cds_stack);
+    nof_children = gt_packed_features_number_of_children(pf, node);
+    for (i = 0; i < nof_children; i++) {
+      GtUword child = gt_packed_features_get_child(pf, node,
+                                                   nof_children - i - 1);
+      gt_array_add(node_stack, child);
+    }
+  }
+  gt_array_delete(cds_stack);
+  gt_array_delete(node_stack);
+}
+
 void gt_stat_visitor_show_stats(GtNodeVisitor *nv, GtFile *outfp)
 {
   GtStatVisitor *sv = stat_visitor_cast(nv);
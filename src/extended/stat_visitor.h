@@ -22,6 +22,7 @@
 typedef struct GtStatVisitor GtStatVisitor;
 
 #include "extended/node_visitor.h"
+#include "extended/packed_features.h"
 
 const GtNodeVisitorClass* gt_stat_visitor_class(void);
 GtNodeVisitor*            gt_stat_visitor_new(bool gene_length_distri,
@@ -31,6 +32,12 @@ GtNodeVisitor*            gt_stat_visitor_new(bool gene_length_distri,
                                               bool intron_length_distri,
                                               bool cds_length_distri,
                                               bool used_sources);
+/* Gather the statistics of graph <graph> of <pf> as if the feature node graph
+   it has been packed from was visited. */
+void                      gt_stat_visitor_visit_packed_graph(
+                                                    GtNodeVisitor*,
+                                                    const GtPackedFeatures *pf,
+                                                    GtUword graph);
 void                      gt_stat_visitor_show_stats(GtNodeVisitor*, GtFile*);
 
 #endif
@@ -16,13 +16,29 @@
 */
 
 #include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "core/alphabet_api.h"
 #include "core/array2dim_api.h"
 #include "core/assert_api.h"
 #include "core/chardef.h"
+#include "core/ensure.h"
+#include "core/ma.h"
+#include "core/mathsupport.h"
 #include "core/minmax.h"
+#include "core/score_matrix.h"
 #include "core/undef_api.h"
 #include "extended/swalign.h"
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GT_SWALIGN_SIMD_X86
+#include <immintrin.h>
+#endif
+
+/* the SIMD kernels compute with saturated 16-bit scores, lanes reaching this
+   value are recomputed by the scalar code */
+#define GT_SWALIGN_SIMD_MAX  INT16_MAX
+
 typedef struct {
   GtUword x,
           y;
@@ -156,3 +172,345 @@ GtAlignment* gt_swalign(GtSeq *u, GtSeq *v, const GtScoreFunction *sf)
                               gt_score_function_get_insertion_score(sf),
                               gt_seq_get_alphabet(u), gt_seq_get_alphabet(v));
 }
+
+/* Return the maximal score of a local alignment of <u> and <v>, computed in
+   linear space. <column> must provide space for <ulen> entries. */
+static GtWord swalign_score_only(GtWord *column,
+                                 const GtUchar *u, GtUword ulen,
+                                 const GtUchar *v, GtUword vlen,
+                                 const int **scores,
+                                 int deletion_score, int insertion_score,
+                                 unsigned int u_alpha_size,
+                                 unsigned int v_alpha_size)
+{
+  GtUword i, j;
+  GtWord diagscore, upscore, score, maxscore = 0;
+  for (i = 0; i < ulen; i++)
+    column[i] = 0;
+  for (j = 0; j < vlen; j++) {
+    int vval = (int) ((v[j] == WILDCARD) ? v_alpha_size - 1 : v[j]);
+    diagscore = upscore = 0;
+    for (i = 0; i < ulen; i++) {
+      int uval = (int) ((u[i] == WILDCARD) ? u_alpha_size - 1 : u[i]);
+      score = MAX(MAX(diagscore + scores[uval][vval],
+                      upscore + deletion_score),
+                  column[i] + insertion_score);
+      if (score < 0)
+        score = 0;
+      diagscore = column[i];
+      column[i] = upscore = score;
+      if (score > maxscore)
+        maxscore = score;
+    }
+  }
+  return maxscore;
+}
+
+typedef void (*GtSWAlignBatchKernel)(GtWord *maxscores,
+                                     const GtUchar *u,
+                                     GtUword ulen,
+                                     const GtUchar **vseqs,
+                                     const GtUword *vlens,
+                                     GtUword nof_vseqs,
+                                     const int **scores,
+                                     unsigned int u_alpha_size,
+                                     unsigned int v_alpha_size,
+                                     int deletion_score,
+                                     int insertion_score,
+                                     int16_t *column,
+                                     int16_t *profile);
+
+#ifdef GT_SWALIGN_SIMD_X86
+
+#define GT_SIMD_NAME(N)        N##_sse2
+#define GT_SIMD_TARGET         __attribute__((target("sse2")))
+#define GT_SIMD_LANES          8UL
+#define GT_SIMD_VEC            __m128i
+#define GT_SIMD_SET1(X)        _mm_set1_epi16(X)
+#define GT_SIMD_LOAD(P)        _mm_loadu_si128((const __m128i *) (P))
+#define GT_SIMD_STORE(P,V)     _mm_storeu_si128((__m128i *) (P), V)
+#define GT_SIMD_ADDS(A,B)      _mm_adds_epi16(A, B)
+#define GT_SIMD_MAX(A,B)       _mm_max_epi16(A, B)
+#include "extended/swalign_simd.inc"
+#undef GT_SIMD_NAME
+#undef GT_SIMD_TARGET
+#undef GT_SIMD_LANES
+#undef GT_SIMD_VEC
+#undef GT_SIMD_SET1
+#undef GT_SIMD_LOAD
+#undef GT_SIMD_STORE
+#undef GT_SIMD_ADDS
+#undef GT_SIMD_MAX
+
+#define GT_SIMD_NAME(N)        N##_avx2
+#define GT_SIMD_TARGET         __attribute__((target("avx2")))
+#define GT_SIMD_LANES          16UL
+#define GT_SIMD_VEC            __m256i
+#define GT_SIMD_SET1(X)        _mm256_set1_epi16(X)
+#define GT_SIMD_LOAD(P)        _mm256_loadu_si256((const __m256i *) (P))
+#define GT_SIMD_STORE(P,V)     _mm256_storeu_si256((__m256i *) (P), V)
+#define GT_SIMD_ADDS(A,B)      _mm256_adds_epi16(A, B)
+#define GT_SIMD_MAX(A,B)       _mm256_max_epi16(A, B)
+#include "extended/swalign_simd.inc"
+#undef GT_SIMD_NAME
+#undef GT_SIMD_TARGET
+#undef GT_SIMD_LANES
+#undef GT_SIMD_VEC
+#undef GT_SIMD_SET1
+#undef GT_SIMD_LOAD
+#undef GT_SIMD_STORE
+#undef GT_SIMD_ADDS
+#undef GT_SIMD_MAX
+
+#endif
+
+/* Return the batch kernel supported by the CPU (or NULL) and store its number
+   of lanes in <lanes>. */
+static GtSWAlignBatchKernel swalign_batch_kernel(GtUword *lanes)
+{
+#ifdef GT_SWALIGN_SIMD_X86
+  if (__builtin_cpu_supports("avx2")) {
+    *lanes = 16UL;
+    return swalign_batch_kernel_avx2;
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    *lanes = 8UL;
+    return swalign_batch_kernel_sse2;
+  }
+#endif
+  *lanes = 1UL;
+  return NULL;
+}
+
+/* Return true if all scores fit into the saturated 16-bit lanes of the
+   kernels and the gap scores are not positive (the latter allows to pad
+   shorter sequences with minimal scores). */
+static bool swalign_batch_scores_fit(const int **scores,
+                                     unsigned int u_alpha_size,
+                                     unsigned int v_alpha_size,
+                                     int deletion_score, int insertion_score)
+{
+  unsigned int c, d;
+  if (deletion_score > 0 || deletion_score < INT16_MIN ||
+      insertion_score > 0 || insertion_score < INT16_MIN) {
+    return false;
+  }
+  for (c = 0; c < u_alpha_size; c++) {
+    for (d = 0; d < v_alpha_size; d++) {
+      if (scores[c][d] <= INT16_MIN || scores[c][d] >= GT_SWALIGN_SIMD_MAX)
+        return false;
+    }
+  }
+  return true;
+}
+
+typedef struct {
+  GtUword length,
+          idx;
+} GtSWAlignBatchEntry;
+
+static int swalign_batch_entry_cmp(const void *a, const void *b)
+{
+  const GtSWAlignBatchEntry *ea = a, *eb = b;
+  if (ea->length != eb->length)
+    return ea->length < eb->length ? -1 : 1;
+  return ea->idx < eb->idx ? -1 : (ea->idx > eb->idx ? 1 : 0);
+}
+
+static void swalign_batch_scores(GtWord *maxscores, GtSeq *u, GtSeq **vseqs,
+                                 GtUword num_of_vseqs,
+                                 const GtScoreFunction *sf,
+                                 GtSWAlignBatchKernel kernel, GtUword lanes)
+{
+  const int **scores = gt_score_function_get_scores(sf);
+  int deletion_score = gt_score_function_get_deletion_score(sf),
+      insertion_score = gt_score_function_get_insertion_score(sf);
+  unsigned int u_alpha_size = gt_alphabet_size(gt_seq_get_alphabet(u)),
+               v_alpha_size;
+  GtUword i, k, ulen = gt_seq_length(u);
+  const GtUchar *u_enc;
+  GtWord *column;
+
+  if (!num_of_vseqs)
+    return;
+  v_alpha_size = gt_alphabet_size(gt_seq_get_alphabet(vseqs[0]));
+  for (k = 1; kernel && k < num_of_vseqs; k++) {
+    if (gt_alphabet_size(gt_seq_get_alphabet(vseqs[k])) != v_alpha_size)
+      kernel = NULL;
+  }
+  if (kernel && !swalign_batch_scores_fit(scores, u_alpha_size, v_alpha_size,
+                                          deletion_score, insertion_score)) {
+    kernel = NULL;
+  }
+  u_enc = ulen ? gt_seq_get_encoded(u) : NULL;
+  column = gt_malloc(sizeof *column * (ulen + 1));
+  if (kernel && ulen) {
+    GtSWAlignBatchEntry *entries;
+    const GtUchar **v_encs;
+    GtUchar *u_mapped;
+    GtUword *vlens;
+    GtWord *lanescores;
+    int16_t *simdcolumn, *profile;
+
+    /* sort the sequences by length to keep the lanes of a batch busy */
+    entries = gt_malloc(sizeof *entries * num_of_vseqs);
+    for (k = 0; k < num_of_vseqs; k++) {
+      entries[k].length = gt_seq_length(vseqs[k]);
+      entries[k].idx = k;
+    }
+    qsort(entries, (size_t) num_of_vseqs, sizeof *entries,
+          swalign_batch_entry_cmp);
+    u_mapped = gt_malloc(sizeof *u_mapped * ulen);
+    for (i = 0; i < ulen; i++) {
+      u_mapped[i] = (GtUchar) ((u_enc[i] == WILDCARD) ? u_alpha_size - 1
+                                                      : u_enc[i]);
+    }
+    v_encs = gt_malloc(sizeof *v_encs * lanes);
+    vlens = gt_malloc(sizeof *vlens * lanes);
+    lanescores = gt_malloc(sizeof *lanescores * lanes);
+    simdcolumn = gt_malloc(sizeof *simdcolumn * ulen * lanes);
+    profile = gt_malloc(sizeof *profile * u_alpha_size * lanes);
+    for (k = 0; k < num_of_vseqs; k += lanes) {
+      GtUword l, nof_lanes = MIN(lanes, num_of_vseqs - k);
+      for (l = 0; l < nof_lanes; l++) {
+        GtSeq *v = vseqs[entries[k + l].idx];
+        vlens[l] = gt_seq_length(v);
+        v_encs[l] = vlens[l] ? gt_seq_get_encoded(v) : NULL;
+      }
+      kernel(lanescores, u_mapped, ulen, v_encs, vlens, nof_lanes, scores,
+             u_alpha_size, v_alpha_size, deletion_score, insertion_score,
+             simdcolumn, profile);
+      for (l = 0; l < nof_lanes; l++) {
+        if (lanescores[l] == GT_SWALIGN_SIMD_MAX) {
+          lanescores[l] = swalign_score_only(column, u_enc, ulen, v_encs[l],
+                                             vlens[l], scores, deletion_score,
+                                             insertion_score, u_alpha_size,
+                                             v_alpha_size);
+        }
+        maxscores[entries[k + l].idx] = lanescores[l];
+      }
+    }
+    gt_free(entries);
+    gt_free(u_mapped);
+    gt_free(v_encs);
+    gt_free(vlens);
+    gt_free(lanescores);
+    gt_free(simdcolumn);
+    gt_free(profile);
+  }
+  else {
+    for (k = 0; k < num_of_vseqs; k++) {
+      GtUword vlen = gt_seq_length(vseqs[k]);
+      if (!ulen || !vlen)
+        maxscores[k] = 0;
+      else {
+        maxscores[k] =
+          swalign_score_only(column, u_enc, ulen,
+                             gt_seq_get_encoded(vseqs[k]), vlen, scores,
+                             deletion_score, insertion_score, u_alpha_size,
+                             gt_alphabet_size(gt_seq_get_alphabet(vseqs[k])));
+      }
+    }
+  }
+  gt_free(column);
+}
+
+void gt_swalign_batch_scores(GtWord *scores, GtSeq *u, GtSeq **vseqs,
+                             GtUword num_of_vseqs, const GtScoreFunction *sf)
+{
+  GtSWAlignBatchKernel kernel;
+  GtUword lanes;
+  gt_assert(scores && u && (vseqs || !num_of_vseqs) && sf);
+  kernel = swalign_batch_kernel(&lanes);
+  swalign_batch_scores(scores, u, vseqs, num_of_vseqs, sf, kernel, lanes);
+}
+
+void gt_swalign_batch(GtAlignment **alignments, GtSeq *u, GtSeq **vseqs,
+                      GtUword num_of_vseqs, const GtScoreFunction *sf,
+                      GtWord min_score)
+{
+  GtWord *scores;
+  GtUword k;
+  gt_assert(alignments && u && (vseqs || !num_of_vseqs) && sf);
+  scores = gt_malloc(sizeof *scores * (num_of_vseqs + 1));
+  gt_swalign_batch_scores(scores, u, vseqs, num_of_vseqs, sf);
+  for (k = 0; k < num_of_vseqs; k++) {
+    /* only the hits are traced back */
+    if (scores[k] > 0 && scores[k] >= min_score)
+      alignments[k] = gt_swalign(u, vseqs[k], sf);
+    else
+      alignments[k] = NULL;
+  }
+  gt_free(scores);
+}
+
+int gt_swalign_unit_test(GtError *err)
+{
+  static const int matchscores[][4] = {{2, -1, -2, -3},  /* linear gaps */
+                                       {1, -1, -1, -1},
+                                       {5, -4, -8, -8},
+                                       {20000, -20000, -100, -100}};
+  GtSWAlignBatchKernel kernel;
+  GtAlphabet *alphabet;
+  GtScoreMatrix *sm;
+  GtScoreFunction *sf;
+  GtSeq *u, **vseqs;
+  GtAlignment **alignments;
+  GtWord scores[2][100];
+  char useq[200], vseqs_orig[100][200];
+  const char *characters = "acgtn";
+  GtUword i, j, k, lanes, ulen, num_of_vseqs;
+  unsigned int c, d;
+  int had_err = 0;
+  gt_error_check(err);
+
+  kernel = swalign_batch_kernel(&lanes);
+  vseqs = gt_malloc(sizeof *vseqs * 100);
+  alignments = gt_malloc(sizeof *alignments * 100);
+  for (i = 0; !had_err && i < 40UL; i++) {
+    const int *ms = matchscores[i % 4];
+    alphabet = gt_alphabet_new_dna();
+    sm = gt_score_matrix_new(alphabet);
+    for (c = 0; c < gt_alphabet_size(alphabet); c++) {
+      for (d = 0; d < gt_alphabet_size(alphabet); d++)
+        gt_score_matrix_set_score(sm, c, d, c == d ? ms[0] : ms[1]);
+    }
+    sf = gt_score_function_new(sm, ms[2], ms[3]);
+    ulen = gt_rand_max(199);
+    for (j = 0; j < ulen; j++)
+      useq[j] = characters[gt_rand_max(4)];
+    u = gt_seq_new(useq, ulen, alphabet);
+    num_of_vseqs = gt_rand_max(99);
+    for (k = 0; k < num_of_vseqs; k++) {
+      GtUword vlen = gt_rand_max(199);
+      /* similar and random sequences of varying lengths */
+      for (j = 0; j < vlen; j++) {
+        vseqs_orig[k][j] = (k % 2 && j < ulen && gt_rand_max(5) > 0)
+                             ? useq[j] : characters[gt_rand_max(4)];
+      }
+      vseqs[k] = gt_seq_new(vseqs_orig[k], vlen, alphabet);
+    }
+    /* compare the kernel of this CPU with the scalar computation */
+    swalign_batch_scores(scores[0], u, vseqs, num_of_vseqs, sf, NULL, 1UL);
+    swalign_batch_scores(scores[1], u, vseqs, num_of_vseqs, sf, kernel, lanes);
+    gt_swalign_batch(alignments, u, vseqs, num_of_vseqs, sf, 1);
+    for (k = 0; !had_err && k < num_of_vseqs; k++) {
+      gt_ensure(scores[0][k] == scores[1][k]);
+      gt_ensure((scores[0][k] > 0) == (alignments[k] != NULL));
+      if (!had_err && alignments[k] && ms[2] == ms[3]) {
+        gt_ensure(gt_alignment_eval_with_score(alignments[k], true, ms[0],
+                                               ms[1], ms[2]) == scores[0][k]);
+      }
+    }
+    for (k = 0; k < num_of_vseqs; k++) {
+      gt_alignment_delete(alignments[k]);
+      gt_seq_delete(vseqs[k]);
+    }
+    gt_seq_delete(u);
+    gt_score_function_delete(sf);
+    gt_alphabet_delete(alphabet);
+  }
+  gt_free(vseqs);
+  gt_free(alignments);
+  return had_err;
+}
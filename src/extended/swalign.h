@@ -27,4 +27,22 @@
    If no such alignment was found, NULL is returned. */
 GtAlignment* gt_swalign(GtSeq *u, GtSeq *v, const GtScoreFunction*);
 
+/* Store the scores of the optimal local alignments of <u> with each of the
+   <num_of_vseqs> sequences in <vseqs> in <scores>. Only the scores are
+   computed, in linear space. If the CPU supports it, <u> is aligned with
+   several sequences of <vseqs> at once, one sequence per SIMD lane. */
+void         gt_swalign_batch_scores(GtWord *scores, GtSeq *u, GtSeq **vseqs,
+                                     GtUword num_of_vseqs,
+                                     const GtScoreFunction*);
+/* (locally) align <u> with each of the <num_of_vseqs> sequences in <vseqs>.
+   The scores are computed with gt_swalign_batch_scores(), only for sequences
+   with a positive score of at least <min_score> an optimal alignment is
+   computed with gt_swalign() and stored in <alignments>. For all other
+   sequences NULL is stored. */
+void         gt_swalign_batch(GtAlignment **alignments, GtSeq *u,
+                              GtSeq **vseqs, GtUword num_of_vseqs,
+                              const GtScoreFunction*, GtWord min_score);
+
+int          gt_swalign_unit_test(GtError*);
+
 #endif
@@ -0,0 +1,230 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/array.h"
+#include "core/assert_api.h"
+#include "core/class_alloc_lock.h"
+#include "core/queue.h"
+#include "core/thread_api.h"
+#include "extended/genome_node.h"
+#include "extended/node_stream_api.h"
+#include "extended/threaded_stream.h"
+
+/* number of nodes handed over at once */
+#define GT_THREADED_STREAM_BATCHSIZE  256
+/* maximal number of batches waiting to be consumed */
+#define GT_THREADED_STREAM_MAXBATCHES 16
+
+struct GtThreadedStream {
+  const GtNodeStream parent_instance;
+  GtNodeStream *in_stream;
+#ifdef GT_THREADS_ENABLED
+  GtThread *thread;
+  GtMutex *mutex;
+  GtCond *batch_added,
+         *batch_removed;
+  GtQueue *batches;     /* full batches, shared with the producer */
+  GtArray *current;     /* batch currently served from */
+  GtUword current_idx;
+  GtError *in_err;      /* error raised by the producer */
+  int in_had_err;
+  bool started,
+       finished,        /* the producer has added its last batch */
+       cancelled,       /* the consumer is not interested in further nodes */
+       done;            /* the producer has been joined */
+#endif
+};
+
+#define gt_threaded_stream_cast(NS)\
+        gt_node_stream_cast(gt_threaded_stream_class(), NS)
+
+#ifdef GT_THREADS_ENABLED
+
+static void threaded_stream_delete_batch(GtArray *batch, GtUword from)
+{
+  GtUword i;
+  if (!batch) return;
+  for (i = from; i < gt_array_size(batch); i++)
+    gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(batch, i));
+  gt_array_delete(batch);
+}
+
+static void* threaded_stream_producer(void *data)
+{
+  GtThreadedStream *ts = data;
+  GtArray *batch;
+  GtGenomeNode *gn;
+  bool last = false;
+  int had_err = 0;
+  gt_assert(ts);
+  batch = gt_array_new(sizeof (GtGenomeNode*));
+  while (!last) {
+    had_err = gt_node_stream_next(ts->in_stream, &gn, ts->in_err);
+    if (had_err || !gn)
+      last = true;
+    else
+      gt_array_add(batch, gn);
+    if (last || gt_array_size(batch) == GT_THREADED_STREAM_BATCHSIZE) {
+      gt_mutex_lock(ts->mutex);
+      while (!ts->cancelled &&
+             gt_queue_size(ts->batches) == GT_THREADED_STREAM_MAXBATCHES) {
+        gt_cond_wait(ts->batch_removed, ts->mutex);
+      }
+      if (ts->cancelled) {
+        ts->finished = true;
+        gt_mutex_unlock(ts->mutex);
+        threaded_stream_delete_batch(batch, 0);
+        return NULL;
+      }
+      gt_queue_add(ts->batches, batch);
+      if (last) {
+        ts->in_had_err = had_err;
+        ts->finished = true;
+      }
+      gt_cond_signal(ts->batch_added);
+      gt_mutex_unlock(ts->mutex);
+      if (!last)
+        batch = gt_array_new(sizeof (GtGenomeNode*));
+    }
+  }
+  return NULL;
+}
+
+static int threaded_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
+                                GtError *err)
+{
+  GtThreadedStream *ts;
+  gt_error_check(err);
+  ts = gt_threaded_stream_cast(ns);
+
+  if (!ts->started) {
+    ts->started = true;
+    if (!(ts->thread = gt_thread_new(threaded_stream_producer, ts, err))) {
+      ts->done = true;
+      return -1;
+    }
+  }
+
+  for (;;) {
+    /* serve from the current batch */
+    if (ts->current && ts->current_idx < gt_array_size(ts->current)) {
+      *gn = *(GtGenomeNode**) gt_array_get(ts->current, ts->current_idx++);
+      return 0;
+    }
+    gt_array_delete(ts->current);
+    ts->current = NULL;
+    if (ts->done)
+      break;
+    /* fetch the next batch */
+    gt_mutex_lock(ts->mutex);
+    while (!gt_queue_size(ts->batches) && !ts->finished)
+      gt_cond_wait(ts->batch_added, ts->mutex);
+    if (gt_queue_size(ts->batches)) {
+      ts->current = gt_queue_get(ts->batches);
+      ts->current_idx = 0;
+      gt_cond_signal(ts->batch_removed);
+      gt_mutex_unlock(ts->mutex);
+      continue;
+    }
+    gt_mutex_unlock(ts->mutex);
+    /* the producer is finished and all its batches have been served */
+    gt_thread_join(ts->thread);
+    gt_thread_delete(ts->thread);
+    ts->thread = NULL;
+    ts->done = true;
+    if (ts->in_had_err) {
+      gt_error_set(err, "%s", gt_error_get(ts->in_err));
+      return ts->in_had_err;
+    }
+  }
+
+  *gn = NULL;
+  return 0;
+}
+
+static void threaded_stream_free(GtNodeStream *ns)
+{
+  GtThreadedStream *ts = gt_threaded_stream_cast(ns);
+  if (ts->thread) {
+    /* stop the producer */
+    gt_mutex_lock(ts->mutex);
+    ts->cancelled = true;
+    gt_cond_broadcast(ts->batch_removed);
+    gt_mutex_unlock(ts->mutex);
+    gt_thread_join(ts->thread);
+    gt_thread_delete(ts->thread);
+  }
+  threaded_stream_delete_batch(ts->current, ts->current_idx);
+  while (gt_queue_size(ts->batches))
+    threaded_stream_delete_batch(gt_queue_get(ts->batches), 0);
+  gt_queue_delete(ts->batches);
+  gt_cond_delete(ts->batch_added);
+  gt_cond_delete(ts->batch_removed);
+  gt_mutex_delete(ts->mutex);
+  gt_error_delete(ts->in_err);
+  gt_node_stream_delete(ts->in_stream);
+}
+
+#else
+
+static int threaded_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
+                                GtError *err)
+{
+  GtThreadedStream *ts;
+  gt_error_check(err);
+  ts = gt_threaded_stream_cast(ns);
+  return gt_node_stream_next(ts->in_stream, gn, err);
+}
+
+static void threaded_stream_free(GtNodeStream *ns)
+{
+  GtThreadedStream *ts = gt_threaded_stream_cast(ns);
+  gt_node_stream_delete(ts->in_stream);
+}
+
+#endif
+
+const GtNodeStreamClass* gt_threaded_stream_class(void)
+{
+  static const GtNodeStreamClass *nsc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!nsc) {
+    nsc = gt_node_stream_class_new(sizeof (GtThreadedStream),
+                                   threaded_stream_free,
+                                   threaded_stream_next);
+  }
+  gt_class_alloc_lock_leave();
+  return nsc;
+}
+
+GtNodeStream* gt_threaded_stream_new(GtNodeStream *in_stream)
+{
+  GtNodeStream *ns;
+  GtThreadedStream *ts;
+  gt_assert(in_stream);
+  ns = gt_node_stream_create(gt_threaded_stream_class(),
+                             gt_node_stream_is_sorted(in_stream));
+  ts = gt_threaded_stream_cast(ns);
+  ts->in_stream = gt_node_stream_ref(in_stream);
+#ifdef GT_THREADS_ENABLED
+  ts->mutex = gt_mutex_new();
+  ts->batch_added = gt_cond_new();
+  ts->batch_removed = gt_cond_new();
+  ts->batches = gt_queue_new();
+  ts->in_err = gt_error_new();
+#endif
+  return ns;
+}
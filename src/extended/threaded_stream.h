@@ -0,0 +1,35 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef THREADED_STREAM_H
+#define THREADED_STREAM_H
+
+#include "extended/node_stream_api.h"
+
+/* Implements the <GtNodeStream> interface. A <GtThreadedStream> pulls the
+   nodes of its <in_stream> in a separate thread and hands them over in
+   batches through a bounded buffer. That is, all streams preceding a
+   <GtThreadedStream> run concurrently to the streams following it, which
+   allows to pipeline a chain of node streams over several cores.
+   The order of the nodes is retained and an error occurring in <in_stream>
+   is reported after all nodes preceding it have been delivered.
+   If threads are not enabled, nodes are simply passed through. */
+typedef struct GtThreadedStream GtThreadedStream;
+
+const GtNodeStreamClass* gt_threaded_stream_class(void);
+GtNodeStream*            gt_threaded_stream_new(GtNodeStream *in_stream);
+
+#endif
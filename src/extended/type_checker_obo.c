@@ -15,10 +15,28 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#ifndef _WIN32
+#include <dirent.h>
+#include <sys/types.h>
+#include <unistd.h>
+#else
+#include <direct.h>
+#include <process.h>
+#endif
 #include "core/cstr_api.h"
 #include "core/cstr_table.h"
+#include "core/fa.h"
+#include "core/fileutils_api.h"
 #include "core/ma.h"
+#include "core/md5_encoder_api.h"
+#include "core/minmax.h"
+#include "core/unused_api.h"
 #include "extended/obo_parse_tree.h"
 #include "extended/type_checker_obo.h"
 #include "extended/type_checker_rep.h"
@@ -29,8 +47,24 @@ struct GtTypeCheckerOBO {
   GtStr *description;
   GtCstrTable *feature_node_types;
   GtTypeGraph *type_graph;
+  void *cache_map; /* compiled type graph, if read from the cache */
 };
 
+#define GT_TYPE_CHECKER_OBO_CACHE_MAGIC     "GTOBOC01"
+#define GT_TYPE_CHECKER_OBO_CACHE_MAGICLEN  8
+#define GT_TYPE_CHECKER_OBO_CACHE_SUFFIX    ".gtobo"
+/* temporary cache files older than this (in seconds) are left over from
+   interrupted runs */
+#define GT_TYPE_CHECKER_OBO_CACHE_TMP_AGE   3600
+
+/* The cache file starts with this header, followed by the compiled type
+   graph. */
+typedef struct {
+  char magic[GT_TYPE_CHECKER_OBO_CACHE_MAGICLEN];
+  GtUword wordsize;
+  unsigned char md5[16]; /* of the OBO file contents */
+} GtTypeCheckerOBOCacheHeader;
+
 #define gt_type_checker_obo_cast(FTF)\
         gt_type_checker_cast(gt_type_checker_obo_class(), FTF)
 
@@ -38,6 +72,7 @@ static void gt_type_checker_obo_free(GtTypeChecker *tc)
 {
   GtTypeCheckerOBO *tco = gt_type_checker_obo_cast(tc);
   gt_type_graph_delete(tco->type_graph);
+  gt_fa_xmunmap(tco->cache_map);
   gt_cstr_table_delete(tco->feature_node_types);
   gt_str_delete(tco->description);
 }
@@ -135,10 +170,199 @@ static int create_feature_nodes(GtTypeCheckerOBO *tco,
   return -1;
 }
 
+static void make_dir(const char *path)
+{
+  /* failures show up when the cache file is written */
+#ifndef _WIN32
+  (void) mkdir(path, S_IRWXU | S_IRWXG | S_IRWXO);
+#else
+  (void) _mkdir(path);
+#endif
+}
+
+/* creates the directory <path>, including missing parent directories */
+static void make_cache_dir(const char *path)
+{
+  char *dir = gt_cstr_dup(path), *sep;
+  for (sep = strchr(dir + 1, '/'); sep; sep = strchr(sep + 1, '/')) {
+    *sep = '\0';
+    make_dir(dir);
+    *sep = '/';
+  }
+  make_dir(dir);
+  gt_free(dir);
+}
+
+/* Returns the directory in which compiled OBO files are cached, creating it
+   if necessary, or NULL if caching is disabled. */
+static GtStr* get_cache_dir(void)
+{
+  const char *env;
+  GtStr *cache_dir;
+  if ((env = getenv("GT_OBO_CACHE_DIR"))) {
+    if (!*env)
+      return NULL;
+    make_cache_dir(env);
+    return gt_str_new_cstr(env);
+  }
+  if ((env = getenv("XDG_CACHE_HOME")) && *env)
+    cache_dir = gt_str_new_cstr(env);
+  else if ((env = getenv("HOME")) && *env) {
+    cache_dir = gt_str_new_cstr(env);
+    gt_str_append_cstr(cache_dir, "/.cache");
+  }
+  else
+    return NULL;
+  gt_str_append_cstr(cache_dir, "/genometools");
+  make_cache_dir(gt_str_get(cache_dir));
+  return cache_dir;
+}
+
+/* Removes the temporary files (see write_cache()) in <cache_dir> which were
+   left over by interrupted runs. Files of concurrent runs are younger. */
+static void remove_stale_tmp_files(GT_UNUSED const char *cache_dir)
+{
+#ifndef _WIN32
+  struct dirent *entry;
+  struct stat sb;
+  const char *pid;
+  GtStr *path;
+  time_t now;
+  DIR *dir;
+  if (!(dir = opendir(cache_dir)))
+    return;
+  path = gt_str_new();
+  now = time(NULL);
+  while ((entry = readdir(dir))) {
+    if (!(pid = strstr(entry->d_name, GT_TYPE_CHECKER_OBO_CACHE_SUFFIX ".")))
+      continue;
+    pid += strlen(GT_TYPE_CHECKER_OBO_CACHE_SUFFIX ".");
+    if (!*pid || strspn(pid, "0123456789") != strlen(pid))
+      continue;
+    gt_str_set(path, cache_dir);
+    gt_str_append_char(path, '/');
+    gt_str_append_cstr(path, entry->d_name);
+    if (!stat(gt_str_get(path), &sb) && S_ISREG(sb.st_mode) &&
+        now - sb.st_mtime > GT_TYPE_CHECKER_OBO_CACHE_TMP_AGE) {
+      (void) remove(gt_str_get(path));
+    }
+  }
+  gt_str_delete(path);
+  (void) closedir(dir);
+#endif
+}
+
+/* Computes the MD5 hash of the contents of <obo_file_path> in <md5> and
+   returns the path of the corresponding cache file, or NULL if the file cannot
+   be read or caching is disabled. */
+static GtStr* get_cache_path(const char *obo_file_path, unsigned char *md5)
+{
+  char buf[BUFSIZ], md5str[33];
+  GtMD5Encoder *enc;
+  GtStr *cache_path;
+  size_t len, i;
+  FILE *fp;
+  if (!(cache_path = get_cache_dir()))
+    return NULL;
+  remove_stale_tmp_files(gt_str_get(cache_path));
+  if (!(fp = gt_fa_fopen(obo_file_path, "rb", NULL))) {
+    gt_str_delete(cache_path);
+    return NULL;
+  }
+  enc = gt_md5_encoder_new();
+  while ((len = fread(buf, sizeof (char), sizeof (buf), fp)) > 0) {
+    for (i = 0; i < len; i += 64)
+      gt_md5_encoder_add_block(enc, buf + i, (GtUword) MIN(64, len - i));
+  }
+  gt_md5_encoder_finish(enc, md5, md5str);
+  gt_md5_encoder_delete(enc);
+  gt_fa_fclose(fp);
+  gt_str_append_char(cache_path, '/');
+  gt_str_append_cstr(cache_path, md5str);
+  gt_str_append_cstr(cache_path, GT_TYPE_CHECKER_OBO_CACHE_SUFFIX);
+  return cache_path;
+}
+
+static void add_feature_nodes_from_graph(GtTypeCheckerOBO *tco)
+{
+  GtUword i;
+  for (i = 0; i < gt_type_graph_num_of_types(tco->type_graph); i++) {
+    const char *id = gt_type_graph_get_id(tco->type_graph, i),
+               *name = gt_type_graph_get_name(tco->type_graph, i);
+    if (!gt_cstr_table_get(tco->feature_node_types, id))
+      gt_cstr_table_add(tco->feature_node_types, id);
+    if (!gt_cstr_table_get(tco->feature_node_types, name))
+      gt_cstr_table_add(tco->feature_node_types, name);
+  }
+}
+
+/* Reads the type graph from the cache file <cache_path> if it exists and
+   belongs to the OBO file with hash <md5>. */
+static bool read_cache(GtTypeCheckerOBO *tco, const char *cache_path,
+                       const unsigned char *md5)
+{
+  GtTypeCheckerOBOCacheHeader header;
+  size_t len;
+  void *map;
+  if (!gt_file_exists(cache_path)
+      || !(map = gt_fa_mmap_read(cache_path, &len, NULL)))
+    return false;
+  if (len >= sizeof (header))
+    memcpy(&header, map, sizeof (header));
+  if (len < sizeof (header)
+      || memcmp(header.magic, GT_TYPE_CHECKER_OBO_CACHE_MAGIC,
+                GT_TYPE_CHECKER_OBO_CACHE_MAGICLEN)
+      || header.wordsize != sizeof (GtUword)
+      || memcmp(header.md5, md5, sizeof (header.md5))
+      || !(tco->type_graph =
+             gt_type_graph_new_compiled((char*) map + sizeof (header),
+                                        (GtUword) (len - sizeof (header)),
+                                        NULL))) {
+    gt_fa_xmunmap(map);
+    return false;
+  }
+  tco->cache_map = map;
+  add_feature_nodes_from_graph(tco);
+  return true;
+}
+
+/* Writes the type graph to the cache file <cache_path>. The file is written
+   under a temporary name first, so that concurrent runs never read a partial
+   cache file. Failures are ignored, the type graph is then compiled again on
+   the next run. */
+static void write_cache(GtTypeCheckerOBO *tco, const char *cache_path,
+                        const unsigned char *md5)
+{
+  GtTypeCheckerOBOCacheHeader header;
+  GtStr *tmp_path;
+  FILE *fp;
+  bool ok;
+  tmp_path = gt_str_new_cstr(cache_path);
+  gt_str_append_char(tmp_path, '.');
+  gt_str_append_uword(tmp_path, (GtUword) getpid());
+  if (!(fp = gt_fa_fopen(gt_str_get(tmp_path), "wb", NULL))) {
+    gt_str_delete(tmp_path);
+    return;
+  }
+  memset(&header, 0, sizeof (header));
+  memcpy(header.magic, GT_TYPE_CHECKER_OBO_CACHE_MAGIC,
+         GT_TYPE_CHECKER_OBO_CACHE_MAGICLEN);
+  header.wordsize = sizeof (GtUword);
+  memcpy(header.md5, md5, sizeof (header.md5));
+  ok = fwrite(&header, sizeof (header), (size_t) 1, fp) == (size_t) 1
+       && !gt_type_graph_write_compiled(tco->type_graph, fp, NULL);
+  gt_fa_fclose(fp);
+  if (!ok || rename(gt_str_get(tmp_path), cache_path))
+    (void) remove(gt_str_get(tmp_path));
+  gt_str_delete(tmp_path);
+}
+
 GtTypeChecker* gt_type_checker_obo_new(const char *obo_file_path, GtError *err)
 {
   GtTypeCheckerOBO *tco;
   GtTypeChecker *tc;
+  unsigned char md5[16];
+  GtStr *cache_path;
   gt_error_check(err);
   gt_assert(obo_file_path);
   tc = gt_type_checker_create(gt_type_checker_obo_class());
@@ -146,10 +370,17 @@ GtTypeChecker* gt_type_checker_obo_new(const char *obo_file_path, GtError *err)
   tco->description= gt_str_new_cstr("OBO file ");
   gt_str_append_cstr(tco->description, obo_file_path);
   tco->feature_node_types = gt_cstr_table_new();
-  tco->type_graph = gt_type_graph_new();
-  if (create_feature_nodes(tco, obo_file_path, err)) {
-    gt_type_checker_delete(tc);
-    return NULL;
+  cache_path = get_cache_path(obo_file_path, md5);
+  if (!cache_path || !read_cache(tco, gt_str_get(cache_path), md5)) {
+    tco->type_graph = gt_type_graph_new();
+    if (create_feature_nodes(tco, obo_file_path, err)) {
+      gt_str_delete(cache_path);
+      gt_type_checker_delete(tc);
+      return NULL;
+    }
+    if (cache_path)
+      write_cache(tco, gt_str_get(cache_path), md5);
   }
+  gt_str_delete(cache_path);
   return tc;
 }
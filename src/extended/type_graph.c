@@ -16,7 +16,7 @@
 
 #include <string.h>
 #include "core/array_api.h"
-#include "core/bool_matrix.h"
+#include "core/bittab_api.h"
 #include "core/cstr_api.h"
 #include "core/hashmap_api.h"
 #include "core/ma_api.h"
@@ -28,41 +28,69 @@
 #define MEMBER_OF         "member_of"
 #define INTEGRAL_PART_OF  "integral_part_of"
 
+/* adjacency lists of all nodes, the targets of node i are stored in
+   targets[offsets[i]] to targets[offsets[i+1]-1] */
+typedef struct {
+  GtUword *offsets,
+          *targets;
+} GtTypeGraphEdges;
+
 struct GtTypeGraph {
-  GtHashmap *name2id, /* maps from name to SO ID */
-            *id2name,
-            *nodemap; /* maps SO ID to actual node */
-  GtArray *nodes;
-  GtBoolMatrix *part_of_out_edges,
-               *part_of_in_edges;
-  bool ready;
+  GtHashmap *nodemap; /* maps SO IDs and names (symbols) to actual node */
+  GtArray *nodes,
+          *names;
+  GtTypeGraphEdges is_a_parents,
+                   is_a_children,
+                   part_of_children;
+  /* columns of the reachability matrices, computed on first use: column p
+     has bit c set if the node with number c is_a (part_of, respectively) the
+     node with number p */
+  GtBittab **is_a_columns,
+           **part_of_columns;
+  GtUword *queue;
+  bool ready,
+       compiled; /* edges point into compiled form owned by the caller */
 };
 
 GtTypeGraph* gt_type_graph_new(void)
 {
-  GtTypeGraph *type_graph = gt_malloc(sizeof (GtTypeGraph));
-  type_graph->name2id = gt_hashmap_new(GT_HASH_DIRECT, NULL, NULL);
-  type_graph->id2name = gt_hashmap_new(GT_HASH_DIRECT, NULL, NULL);
+  GtTypeGraph *type_graph = gt_calloc(1, sizeof (GtTypeGraph));
   type_graph->nodemap = gt_hashmap_new(GT_HASH_DIRECT, NULL, NULL);
   type_graph->nodes = gt_array_new(sizeof (GtTypeNode*));
-  type_graph->part_of_out_edges = gt_bool_matrix_new();
-  type_graph->part_of_in_edges = gt_bool_matrix_new();
+  type_graph->names = gt_array_new(sizeof (const char*));
   type_graph->ready = false;
   return type_graph;
 }
 
+static void type_graph_edges_delete(GtTypeGraphEdges *edges)
+{
+  gt_free(edges->offsets);
+  gt_free(edges->targets);
+}
+
 void gt_type_graph_delete(GtTypeGraph *type_graph)
 {
   GtUword i;
   if (!type_graph) return;
-  gt_bool_matrix_delete(type_graph->part_of_in_edges);
-  gt_bool_matrix_delete(type_graph->part_of_out_edges);
+  if (type_graph->ready) {
+    for (i = 0; i < gt_array_size(type_graph->nodes); i++) {
+      gt_bittab_delete(type_graph->is_a_columns[i]);
+      gt_bittab_delete(type_graph->part_of_columns[i]);
+    }
+  }
+  gt_free(type_graph->is_a_columns);
+  gt_free(type_graph->part_of_columns);
+  gt_free(type_graph->queue);
+  if (!type_graph->compiled) {
+    type_graph_edges_delete(&type_graph->part_of_children);
+    type_graph_edges_delete(&type_graph->is_a_children);
+    type_graph_edges_delete(&type_graph->is_a_parents);
+  }
   for (i = 0; i < gt_array_size(type_graph->nodes); i++)
     gt_type_node_delete(*(GtTypeNode**) gt_array_get(type_graph->nodes, i));
+  gt_array_delete(type_graph->names);
   gt_array_delete(type_graph->nodes);
   gt_hashmap_delete(type_graph->nodemap);
-  gt_hashmap_delete(type_graph->id2name);
-  gt_hashmap_delete(type_graph->name2id);
   gt_free(type_graph);
 }
 
@@ -82,10 +110,10 @@ void gt_type_graph_add_stanza(GtTypeGraph *type_graph,
   gt_assert(name_value);
   gt_assert(!gt_hashmap_get(type_graph->nodemap, id_value));
   node = gt_type_node_new(gt_array_size(type_graph->nodes), id_value);
-  gt_hashmap_add(type_graph->name2id, (char*) name_value, (char*) id_value);
-  gt_hashmap_add(type_graph->id2name, (char*) id_value, (char*) name_value);
+  gt_hashmap_add(type_graph->nodemap, (char*) name_value, node);
   gt_hashmap_add(type_graph->nodemap, (char*) id_value, node);
   gt_array_add(type_graph->nodes, node);
+  gt_array_add(type_graph->names, name_value);
   buf = gt_str_new();
   /* store is_a entries in node, if necessary */
   if ((size = gt_obo_stanza_size(stanza, "is_a"))) {
@@ -127,85 +155,433 @@ void gt_type_graph_add_stanza(GtTypeGraph *type_graph,
   gt_str_delete(buf);
 }
 
+/* Stores the <nof_edges> edges given as (source, target) pairs in <pairs>
+   as adjacency lists in <edges>, from target to source if <reverse> is
+   true. */
+static void type_graph_edges_init(GtTypeGraphEdges *edges, const GtArray *pairs,
+                                  GtUword nof_nodes, bool reverse)
+{
+  const GtUword *pair = gt_array_get_space(pairs);
+  GtUword i, nof_edges = gt_array_size(pairs) / 2;
+  edges->offsets = gt_calloc(nof_nodes + 1, sizeof (GtUword));
+  edges->targets = gt_malloc(nof_edges * sizeof (GtUword));
+  for (i = 0; i < nof_edges; i++)
+    edges->offsets[pair[2 * i + reverse] + 1]++;
+  for (i = 0; i < nof_nodes; i++)
+    edges->offsets[i + 1] += edges->offsets[i];
+  /* fill in the targets, using the offsets as insertion points for now */
+  for (i = 0; i < nof_edges; i++) {
+    edges->targets[edges->offsets[pair[2 * i + reverse]]++]
+      = pair[2 * i + !reverse];
+  }
+  for (i = nof_nodes; i > 0; i--)
+    edges->offsets[i] = edges->offsets[i - 1];
+  edges->offsets[0] = 0;
+}
+
+static GtUword type_graph_node_num(GtTypeGraph *type_graph, const char *id)
+{
+  GtTypeNode *node = gt_hashmap_get(type_graph->nodemap, id);
+  gt_assert(node);
+  return gt_type_node_num(node);
+}
+
+static void type_graph_alloc_columns(GtTypeGraph *type_graph)
+{
+  GtUword nof_nodes = gt_array_size(type_graph->nodes);
+  type_graph->is_a_columns = gt_calloc(nof_nodes, sizeof (GtBittab*));
+  type_graph->part_of_columns = gt_calloc(nof_nodes, sizeof (GtBittab*));
+  type_graph->queue = gt_malloc(nof_nodes * sizeof (GtUword));
+}
+
 static void create_vertices(GtTypeGraph *type_graph)
 {
-  GtUword i, j;
-  GtTypeNode *parent;
-  const char *id;
+  GtUword i, j, nof_nodes = gt_array_size(type_graph->nodes);
+  GtArray *is_a_pairs, *part_of_pairs;
   gt_assert(type_graph && !type_graph->ready);
+  is_a_pairs = gt_array_new(sizeof (GtUword));
+  part_of_pairs = gt_array_new(sizeof (GtUword));
   /* iterate over nodes */
-  for (i = 0; i < gt_array_size(type_graph->nodes); i++) {
+  for (i = 0; i < nof_nodes; i++) {
     GtTypeNode *node = *(GtTypeNode**) gt_array_get(type_graph->nodes, i);
     /* process is_a parents */
     for (j = 0; j < gt_type_node_is_a_size(node); j++) {
-      id = gt_type_node_is_a_get(node, j);
-      parent = gt_hashmap_get(type_graph->nodemap, id);
-      gt_assert(parent);
-      gt_type_node_add_is_a_vertex(node, parent);
+      GtUword parent = type_graph_node_num(type_graph,
+                                           gt_type_node_is_a_get(node, j));
+      gt_array_add(is_a_pairs, i);
+      gt_array_add(is_a_pairs, parent);
     }
     /* process part_of parents */
     for (j = 0; j < gt_type_node_part_of_size(node); j++) {
-      id = gt_type_node_part_of_get(node, j);
-      parent = gt_hashmap_get(type_graph->nodemap, id);
-      gt_assert(parent);
-      gt_bool_matrix_set(type_graph->part_of_out_edges, gt_type_node_num(node),
-                         gt_type_node_num(parent), true);
-      gt_bool_matrix_set(type_graph->part_of_in_edges, gt_type_node_num(parent),
-                         gt_type_node_num(node), true);
+      GtUword parent = type_graph_node_num(type_graph,
+                                           gt_type_node_part_of_get(node, j));
+      gt_array_add(part_of_pairs, i);
+      gt_array_add(part_of_pairs, parent);
     }
   }
+  type_graph_edges_init(&type_graph->is_a_parents, is_a_pairs, nof_nodes,
+                        false);
+  type_graph_edges_init(&type_graph->is_a_children, is_a_pairs, nof_nodes,
+                        true);
+  type_graph_edges_init(&type_graph->part_of_children, part_of_pairs,
+                        nof_nodes, true);
+  gt_array_delete(part_of_pairs);
+  gt_array_delete(is_a_pairs);
+  type_graph_alloc_columns(type_graph);
 }
 
-bool gt_type_graph_is_partof(GtTypeGraph *type_graph, const char *parent_type,
-                             const char *child_type)
+/* Adds all targets of <node> in <edges> not yet set in <visited> to
+   <visited> and to the <queue>. */
+static void type_graph_enqueue_targets(const GtTypeGraphEdges *edges,
+                                       GtUword node, GtBittab *visited,
+                                       GtUword *queue, GtUword *queue_end)
 {
-  const char *parent_id, *child_id;
-  GtTypeNode *parent_node, *child_node;
-  gt_assert(type_graph && parent_type && child_type);
+  GtUword i;
+  for (i = edges->offsets[node]; i < edges->offsets[node + 1]; i++) {
+    if (!gt_bittab_bit_is_set(visited, edges->targets[i])) {
+      gt_bittab_set_bit(visited, edges->targets[i]);
+      queue[(*queue_end)++] = edges->targets[i];
+    }
+  }
+}
+
+/* Returns <node> and all its is_a ancestors, using <queue>. */
+static GtBittab* type_graph_is_a_ancestors(GtTypeGraph *type_graph,
+                                           GtUword node, GtUword *queue)
+{
+  GtBittab *ancestors = gt_bittab_new(gt_array_size(type_graph->nodes));
+  GtUword queue_start = 0, queue_end = 0;
+  gt_bittab_set_bit(ancestors, node);
+  queue[queue_end++] = node;
+  while (queue_start < queue_end) {
+    type_graph_enqueue_targets(&type_graph->is_a_parents,
+                               queue[queue_start++], ancestors, queue,
+                               &queue_end);
+  }
+  return ancestors;
+}
+
+/* Computes the column of the is_a matrix for <parent>, that is, <parent> and
+   all its is_a descendants. */
+static GtBittab* type_graph_is_a_column(GtTypeGraph *type_graph,
+                                        GtUword parent)
+{
+  GtBittab *column = gt_bittab_new(gt_array_size(type_graph->nodes));
+  GtUword *queue = type_graph->queue, queue_start = 0, queue_end = 0;
+  gt_bittab_set_bit(column, parent);
+  queue[queue_end++] = parent;
+  while (queue_start < queue_end) {
+    type_graph_enqueue_targets(&type_graph->is_a_children,
+                               queue[queue_start++], column, queue,
+                               &queue_end);
+  }
+  return column;
+}
+
+/* Computes the column of the part_of matrix for <parent>, that is, all nodes
+   from which <parent> can be reached via part_of and is_a edges.
+
+   Part_of relations are inherited along is_a edges towards the <parent>:
+   if X is_a Y and Z part_of Y, then Z part_of X, for all X on an is_a path
+   from <parent> to Y.
+
+   Example from Sequence Ontology (we are looking at mRNA and exon, see
+   http://www.sequenceontology.org/browser/current_svn/term/SO:0000234 and
+   http://www.sequenceontology.org/browser/current_svn/term/SO:0000147,
+   respectively):
+
+   * mRNA is_a mature_transcript
+   * mature_transcript is_a transcript
+   * transcript_region part_of transcript
+
+   Therefore (transient edges):
+
+   * transcript_region part_of mRNA
+   * transcript_region part_of mature_transcript
+
+   The search runs backwards from <parent>, so the inherited part_of children
+   of a node X on such a path are the part_of children of the is_a ancestors
+   of X. */
+static GtBittab* type_graph_part_of_column(GtTypeGraph *type_graph,
+                                           GtUword parent)
+{
+  GtUword nof_nodes = gt_array_size(type_graph->nodes),
+          *queue = type_graph->queue, *ancestor_queue,
+          queue_start = 0, queue_end = 0;
+  GtBittab *column, *path;
+  column = gt_bittab_new(nof_nodes);
+  ancestor_queue = gt_malloc(nof_nodes * sizeof (GtUword));
+  path = type_graph_is_a_ancestors(type_graph, parent, ancestor_queue);
+  gt_bittab_set_bit(column, parent);
+  queue[queue_end++] = parent;
+  while (queue_start < queue_end) {
+    GtUword node = queue[queue_start++];
+    type_graph_enqueue_targets(&type_graph->is_a_children, node, column, queue,
+                               &queue_end);
+    type_graph_enqueue_targets(&type_graph->part_of_children, node, column,
+                               queue, &queue_end);
+    if (gt_bittab_bit_is_set(path, node)) {
+      /* <node> is on an is_a path from <parent>, it inherits the part_of
+         children of its is_a ancestors */
+      GtBittab *ancestors = type_graph_is_a_ancestors(type_graph, node,
+                                                      ancestor_queue);
+      GtUword ancestor;
+      for (ancestor  = gt_bittab_get_first_bitnum(ancestors);
+           ancestor != gt_bittab_get_last_bitnum(ancestors);
+           ancestor  = gt_bittab_get_next_bitnum(ancestors, ancestor)) {
+        if (ancestor != node) {
+          type_graph_enqueue_targets(&type_graph->part_of_children, ancestor,
+                                     column, queue, &queue_end);
+        }
+      }
+      gt_bittab_delete(ancestors);
+    }
+  }
+  gt_bittab_delete(path);
+  gt_free(ancestor_queue);
+  return column;
+}
+
+static GtUword type_graph_type_num(GtTypeGraph *type_graph, const char *type)
+{
+  GtTypeNode *node;
   /* make sure graph is built */
   if (!type_graph->ready) {
     create_vertices(type_graph);
     type_graph->ready = true;
   }
-  /* get parent ID, if the type is not mappable to an ID, assume it is the ID */
-  if (!(parent_id = gt_hashmap_get(type_graph->name2id, parent_type)))
-    parent_id = parent_type;
-  /* get child ID, if the type is not mappable to an ID, assmue it is the ID */
-  if (!(child_id = gt_hashmap_get(type_graph->name2id, child_type)))
-    child_id = child_type;
-  /* get parent node */
-  parent_node = gt_hashmap_get(type_graph->nodemap, parent_id);
-  gt_assert(parent_node);
-  /* get child node */
-  child_node = gt_hashmap_get(type_graph->nodemap, child_id);
-  gt_assert(child_node);
-  /* check for parent */
-  return gt_type_node_has_parent(child_node, parent_node,
-                                 type_graph->part_of_out_edges,
-                                 type_graph->part_of_in_edges,
-                                 type_graph->nodes, type_graph->id2name, 0);
+  /* <type> is a symbol, either a name or an ID */
+  node = gt_hashmap_get(type_graph->nodemap, type);
+  gt_assert(node);
+  return gt_type_node_num(node);
+}
+
+bool gt_type_graph_is_partof(GtTypeGraph *type_graph, const char *parent_type,
+                             const char *child_type)
+{
+  GtUword parent, child;
+  gt_assert(type_graph && parent_type && child_type);
+  parent = type_graph_type_num(type_graph, parent_type);
+  child = type_graph_type_num(type_graph, child_type);
+  if (!type_graph->part_of_columns[parent]) {
+    type_graph->part_of_columns[parent] =
+                                  type_graph_part_of_column(type_graph, parent);
+  }
+  return gt_bittab_bit_is_set(type_graph->part_of_columns[parent], child);
 }
 
 bool gt_type_graph_is_a(GtTypeGraph *type_graph, const char *parent_type,
                         const char *child_type)
 {
-  const char *parent_id, *child_id;
-  GtTypeNode *child_node;
+  GtUword parent, child;
   gt_assert(type_graph && parent_type && child_type);
-  /* make sure graph is built */
+  /* unknown parent types are no ancestors of any type */
+  if (!gt_hashmap_get(type_graph->nodemap, parent_type))
+    return false;
+  parent = type_graph_type_num(type_graph, parent_type);
+  child = type_graph_type_num(type_graph, child_type);
+  if (!type_graph->is_a_columns[parent]) {
+    type_graph->is_a_columns[parent] = type_graph_is_a_column(type_graph,
+                                                              parent);
+  }
+  return gt_bittab_bit_is_set(type_graph->is_a_columns[parent], child);
+}
+
+GtUword gt_type_graph_num_of_types(const GtTypeGraph *type_graph)
+{
+  gt_assert(type_graph);
+  return gt_array_size(type_graph->nodes);
+}
+
+const char* gt_type_graph_get_id(const GtTypeGraph *type_graph, GtUword num)
+{
+  gt_assert(type_graph && num < gt_type_graph_num_of_types(type_graph));
+  return gt_type_node_id(*(GtTypeNode**) gt_array_get(type_graph->nodes,
+                                                      num));
+}
+
+const char* gt_type_graph_get_name(const GtTypeGraph *type_graph, GtUword num)
+{
+  gt_assert(type_graph && num < gt_type_graph_num_of_types(type_graph));
+  return *(const char**) gt_array_get(type_graph->names, num);
+}
+
+/* The compiled form consists of the header, followed by the offsets of the
+   ID and name of each type in the string pool, the adjacency lists of is_a
+   parents, is_a children and part_of children (offsets and targets each) and
+   the string pool. */
+typedef struct {
+  GtUword nof_types,
+          nof_is_a,
+          nof_part_of,
+          strpool_size;
+} GtTypeGraphCompiledHeader;
+
+/* Returns true if all is_a and part_of parents refer to types in the
+   graph. */
+static bool type_graph_is_closed(GtTypeGraph *type_graph)
+{
+  GtUword i, j;
+  for (i = 0; i < gt_array_size(type_graph->nodes); i++) {
+    GtTypeNode *node = *(GtTypeNode**) gt_array_get(type_graph->nodes, i);
+    for (j = 0; j < gt_type_node_is_a_size(node); j++) {
+      if (!gt_hashmap_get(type_graph->nodemap, gt_type_node_is_a_get(node, j)))
+        return false;
+    }
+    for (j = 0; j < gt_type_node_part_of_size(node); j++) {
+      if (!gt_hashmap_get(type_graph->nodemap,
+                          gt_type_node_part_of_get(node, j)))
+        return false;
+    }
+  }
+  return true;
+}
+
+static bool type_graph_write_words(const GtUword *words, GtUword nof_words,
+                                   FILE *fp)
+{
+  return fwrite(words, sizeof (GtUword), (size_t) nof_words, fp)
+         == (size_t) nof_words;
+}
+
+int gt_type_graph_write_compiled(GtTypeGraph *type_graph, FILE *fp,
+                                 GtError *err)
+{
+  GtTypeGraphCompiledHeader header;
+  GtUword i, offset = 0, *offsets;
+  bool ok;
+  gt_error_check(err);
+  gt_assert(type_graph && fp);
   if (!type_graph->ready) {
+    if (!type_graph_is_closed(type_graph)) {
+      gt_error_set(err, "type graph refers to undefined types");
+      return -1;
+    }
     create_vertices(type_graph);
     type_graph->ready = true;
   }
-  /* get parent ID, if the type is not mappable to an ID, assume it is the ID */
-  if (!(parent_id = gt_hashmap_get(type_graph->name2id, parent_type)))
-    parent_id = parent_type;
-  /* get child ID, if the type is not mappable to an ID, assume it is the ID */
-  if (!(child_id = gt_hashmap_get(type_graph->name2id, child_type)))
-    child_id = child_type;
-  /* get child node */
-  child_node = gt_hashmap_get(type_graph->nodemap, child_id);
-  gt_assert(child_node);
-  /* check for parent */
-  return gt_type_node_is_a(child_node, parent_id);
+  header.nof_types = gt_type_graph_num_of_types(type_graph);
+  header.nof_is_a = type_graph->is_a_parents.offsets[header.nof_types];
+  header.nof_part_of = type_graph->part_of_children.offsets[header.nof_types];
+  offsets = gt_malloc(2 * header.nof_types * sizeof (GtUword));
+  for (i = 0; i < header.nof_types; i++) {
+    offsets[i] = offset;
+    offset += strlen(gt_type_graph_get_id(type_graph, i)) + 1;
+    offsets[header.nof_types + i] = offset;
+    offset += strlen(gt_type_graph_get_name(type_graph, i)) + 1;
+  }
+  header.strpool_size = offset;
+  ok = fwrite(&header, sizeof (header), (size_t) 1, fp) == (size_t) 1
+       && type_graph_write_words(offsets, 2 * header.nof_types, fp)
+       && type_graph_write_words(type_graph->is_a_parents.offsets,
+                                 header.nof_types + 1, fp)
+       && type_graph_write_words(type_graph->is_a_parents.targets,
+                                 header.nof_is_a, fp)
+       && type_graph_write_words(type_graph->is_a_children.offsets,
+                                 header.nof_types + 1, fp)
+       && type_graph_write_words(type_graph->is_a_children.targets,
+                                 header.nof_is_a, fp)
+       && type_graph_write_words(type_graph->part_of_children.offsets,
+                                 header.nof_types + 1, fp)
+       && type_graph_write_words(type_graph->part_of_children.targets,
+                                 header.nof_part_of, fp);
+  for (i = 0; ok && i < header.nof_types; i++) {
+    const char *id = gt_type_graph_get_id(type_graph, i),
+               *name = gt_type_graph_get_name(type_graph, i);
+    ok = fwrite(id, sizeof (char), strlen(id) + 1, fp) == strlen(id) + 1
+         && fwrite(name, sizeof (char), strlen(name) + 1, fp)
+              == strlen(name) + 1;
+  }
+  gt_free(offsets);
+  if (!ok) {
+    gt_error_set(err, "could not write compiled type graph");
+    return -1;
+  }
+  return 0;
+}
+
+/* Points <edges> to the adjacency lists at <*data>, which must fit into the
+   <*size> remaining bytes, and advances <*data> behind them. */
+static bool type_graph_edges_map(GtTypeGraphEdges *edges, const GtUword **data,
+                                 GtUword *size, GtUword nof_nodes,
+                                 GtUword nof_edges)
+{
+  GtUword i;
+  if (*size / sizeof (GtUword) < nof_nodes + 1 + nof_edges)
+    return false;
+  edges->offsets = (GtUword*) *data;
+  edges->targets = (GtUword*) *data + nof_nodes + 1;
+  *data += nof_nodes + 1 + nof_edges;
+  *size -= (nof_nodes + 1 + nof_edges) * sizeof (GtUword);
+  if (edges->offsets[0] != 0 || edges->offsets[nof_nodes] != nof_edges)
+    return false;
+  for (i = 0; i < nof_nodes; i++) {
+    if (edges->offsets[i] > edges->offsets[i + 1])
+      return false;
+  }
+  for (i = 0; i < nof_edges; i++) {
+    if (edges->targets[i] >= nof_nodes)
+      return false;
+  }
+  return true;
+}
+
+GtTypeGraph* gt_type_graph_new_compiled(const void *data, GtUword size,
+                                        GtError *err)
+{
+  GtTypeGraphCompiledHeader header;
+  GtTypeGraph *type_graph;
+  const GtUword *words, *offsets;
+  const char *strpool;
+  GtUword i;
+  bool ok;
+  gt_error_check(err);
+  gt_assert(data);
+  if (size < sizeof (header)) {
+    gt_error_set(err, "compiled type graph is truncated");
+    return NULL;
+  }
+  memcpy(&header, data, sizeof (header));
+  words = (const GtUword*) ((const char*) data + sizeof (header));
+  size -= sizeof (header);
+  offsets = words;
+  ok = size / sizeof (GtUword) / 2 >= header.nof_types;
+  if (ok) {
+    words += 2 * header.nof_types;
+    size -= 2 * header.nof_types * sizeof (GtUword);
+  }
+  type_graph = gt_type_graph_new();
+  type_graph->compiled = true;
+  ok = ok
+       && type_graph_edges_map(&type_graph->is_a_parents, &words, &size,
+                               header.nof_types, header.nof_is_a)
+       && type_graph_edges_map(&type_graph->is_a_children, &words, &size,
+                               header.nof_types, header.nof_is_a)
+       && type_graph_edges_map(&type_graph->part_of_children, &words, &size,
+                               header.nof_types, header.nof_part_of)
+       && size == header.strpool_size && size > 0;
+  strpool = (const char*) words;
+  if (ok && strpool[size - 1] != '\0')
+    ok = false;
+  for (i = 0; ok && i < 2 * header.nof_types; i++) {
+    if (offsets[i] >= size)
+      ok = false;
+  }
+  if (!ok) {
+    gt_error_set(err, "compiled type graph is corrupt");
+    gt_type_graph_delete(type_graph);
+    return NULL;
+  }
+  for (i = 0; i < header.nof_types; i++) {
+    const char *id_value = gt_symbol(strpool + offsets[i]),
+               *name_value = gt_symbol(strpool + offsets[header.nof_types + i]);
+    GtTypeNode *node = gt_type_node_new(i, id_value);
+    gt_hashmap_add(type_graph->nodemap, (char*) name_value, node);
+    gt_hashmap_add(type_graph->nodemap, (char*) id_value, node);
+    gt_array_add(type_graph->nodes, node);
+    gt_array_add(type_graph->names, name_value);
+  }
+  type_graph_alloc_columns(type_graph);
+  type_graph->ready = true;
+  return type_graph;
 }
@@ -17,6 +17,8 @@
 #ifndef TYPE_GRAPH_H
 #define TYPE_GRAPH_H
 
+#include <stdio.h>
+#include "core/error_api.h"
 #include "extended/obo_stanza.h"
 
 typedef struct GtTypeGraph GtTypeGraph;
@@ -31,5 +33,18 @@ bool         gt_type_graph_is_partof(GtTypeGraph *type_graph,
 bool         gt_type_graph_is_a(GtTypeGraph *type_graph,
                                 const char *parent_type,
                                 const char *child_type);
+GtUword      gt_type_graph_num_of_types(const GtTypeGraph *type_graph);
+const char*  gt_type_graph_get_id(const GtTypeGraph *type_graph, GtUword num);
+const char*  gt_type_graph_get_name(const GtTypeGraph *type_graph,
+                                    GtUword num);
+/* Writes <type_graph> in a compiled form to <fp>, from which it can be
+   restored with <gt_type_graph_new_compiled()>. */
+int          gt_type_graph_write_compiled(GtTypeGraph *type_graph, FILE *fp,
+                                          GtError *err);
+/* Returns a new type graph from the compiled form of <size> bytes at <data>,
+   which must be aligned to a word boundary and stay valid until the type
+   graph is deleted. Returns NULL and sets <err> if <data> is corrupt. */
+GtTypeGraph* gt_type_graph_new_compiled(const void *data, GtUword size,
+                                        GtError *err);
 
 #endif
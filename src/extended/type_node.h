@@ -17,32 +17,19 @@
 #ifndef TYPE_NODE_H
 #define TYPE_NODE_H
 
-#include "core/bool_matrix.h"
+#include "core/types_api.h"
 
 typedef struct GtTypeNode GtTypeNode;
 
 GtTypeNode*   gt_type_node_new(GtUword num, const char *id);
 void          gt_type_node_delete(GtTypeNode*);
 GtUword       gt_type_node_num(const GtTypeNode*);
+const char*   gt_type_node_id(const GtTypeNode*);
 void          gt_type_node_is_a_add(GtTypeNode*, const char*);
 const char*   gt_type_node_is_a_get(const GtTypeNode*, GtUword);
 GtUword       gt_type_node_is_a_size(const GtTypeNode*);
 void          gt_type_node_part_of_add(GtTypeNode*, const char*);
 const char*   gt_type_node_part_of_get(const GtTypeNode*, GtUword);
 GtUword       gt_type_node_part_of_size(const GtTypeNode*);
-void          gt_type_node_add_is_a_vertex(GtTypeNode *src,
-                                           const GtTypeNode *dst);
-/* Checks if the given <node> has a parent with the given <id>.
-   <node> and <id> have to be mapped to the SO ID already!.
-   The <id2name> mapping is optional and is only used for debugging output.
-   The <indentlevel> is also used for debugging output and is increased in every
-   recursive call. */
-bool          gt_type_node_has_parent(GtTypeNode *node, GtTypeNode *pnode,
-                                      GtBoolMatrix *part_of_out_edges,
-                                      GtBoolMatrix *part_of_in_edges,
-                                      GtArray *node_list, GtHashmap *id2name,
-                                      unsigned int indentlevel);
-bool          gt_type_node_is_a(GtTypeNode *child_node,
-                                const char *parent_id);
 
 #endif
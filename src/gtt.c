@@ -17,6 +17,7 @@
 
 #include "gtt.h"
 #include "core/alphabet.h"
+#include "core/arena.h"
 #include "core/array.h"
 #include "core/array2dim_api.h"
 #include "core/array2dim_sparse.h"
@@ -39,17 +40,22 @@
 #include "core/dlist.h"
 #include "core/dyn_bittab.h"
 #include "core/encseq.h"
+#include "core/file.h"
+#include "core/file_readahead.h"
 #include "core/grep_api.h"
 #include "core/hashmap.h"
 #include "core/hashtable.h"
+#include "core/interval_index.h"
 #include "core/interval_tree.h"
 #include "core/mathsupport.h"
 #include "core/md5_seqid.h"
+#include "core/ordered_ring.h"
 #include "core/quality.h"
 #include "core/queue.h"
 #include "core/sequence_buffer.h"
 #include "core/splitter.h"
 #include "core/symbol.h"
+#include "core/thread_pool.h"
 #include "core/tokenizer.h"
 #include "core/trans_table.h"
 #include "core/translator.h"
@@ -62,25 +68,32 @@
 #include "extended/evaluator.h"
 #include "extended/feature_in_stream.h"
 #include "extended/feature_index.h"
+#include "extended/feature_index_mapped.h"
 #include "extended/feature_index_memory.h"
 #include "extended/feature_node.h"
 #include "extended/feature_node_iterator_api.h"
 #include "extended/genome_node.h"
+#include "extended/genome_node_serializer.h"
 #include "extended/gff3_escaping.h"
 #include "extended/golomb.h"
 #include "extended/hmm.h"
 #include "extended/huffcode.h"
 #include "extended/intset.h"
 #include "extended/kmer_database.h"
+#include "extended/linearalign.h"
+#include "extended/linearalign_affinegapcost.h"
 #include "extended/luaserialize.h"
 #include "extended/multieoplist.h"
+#include "extended/packed_features.h"
 #include "extended/popcount_tab.h"
 #include "extended/priority_queue.h"
 #include "extended/ranked_list.h"
 #include "extended/rbtree.h"
 #include "extended/rmq.h"
+#include "extended/sort_stream.h"
 #include "extended/splicedseq.h"
 #include "extended/string_matching.h"
+#include "extended/swalign.h"
 #include "extended/tag_value_map.h"
 #include "extended/uint64hashtable.h"
 #include "ltr/gt_ltrclustering.h"
@@ -283,6 +296,7 @@ GtHashmap* gtt_unit_tests(void)
 
   gt_hashmap_add(unit_tests, "alphabet class", gt_alphabet_unit_test);
   gt_hashmap_add(unit_tests, "alignment class", gt_alignment_unit_test);
+  gt_hashmap_add(unit_tests, "arena class", gt_arena_unit_test);
   gt_hashmap_add(unit_tests, "array class", gt_array_unit_test);
   gt_hashmap_add(unit_tests, "array example", gt_array_example);
   gt_hashmap_add(unit_tests, "array2dim example", gt_array2dim_example);
@@ -326,9 +340,14 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "feature node iterator example",
                                              gt_feature_node_iterator_example);
   gt_hashmap_add(unit_tests, "feature node class", gt_feature_node_unit_test);
+  gt_hashmap_add(unit_tests, "file class", gt_file_unit_test);
+  gt_hashmap_add(unit_tests, "file read-ahead class",
+                 gt_file_readahead_unit_test);
   gt_hashmap_add(unit_tests, "feature in stream class",
                                                 gt_feature_in_stream_unit_test);
   gt_hashmap_add(unit_tests, "genome node class", gt_genome_node_unit_test);
+  gt_hashmap_add(unit_tests, "genome node serializer class",
+                 gt_genome_node_serializer_unit_test);
   gt_hashmap_add(unit_tests, "gff3 escaping module",
                                                     gt_gff3_escaping_unit_test);
   gt_hashmap_add(unit_tests, "grep module", gt_grep_unit_test);
@@ -337,19 +356,30 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "hashtable class", gt_hashtable_unit_test);
   gt_hashmap_add(unit_tests, "hmm class", gt_hmm_unit_test);
   gt_hashmap_add(unit_tests, "huffman coding class", gt_huffman_unit_test);
+  gt_hashmap_add(unit_tests, "interval index class",
+                 gt_interval_index_unit_test);
   gt_hashmap_add(unit_tests, "interval tree class", gt_interval_tree_unit_test);
   gt_hashmap_add(unit_tests, "intset classes", gt_intset_unit_test);
   gt_hashmap_add(unit_tests, "karlin altschul class",
                                              gt_karlin_altschul_stat_unit_test);
   gt_hashmap_add(unit_tests, "kmer_database class", gt_kmer_database_unit_test);
+  gt_hashmap_add(unit_tests, "linear space alignment module",
+                 gt_linearalign_unit_test);
+  gt_hashmap_add(unit_tests, "linear space affine alignment module",
+                 gt_linearalign_affinegapcost_unit_test);
   gt_hashmap_add(unit_tests, "Lua serializer module",
                                                    gt_lua_serializer_unit_test);
+  gt_hashmap_add(unit_tests, "mapped feature index class",
+                 gt_feature_index_mapped_unit_test);
   gt_hashmap_add(unit_tests, "mathsupport module", gt_mathsupport_unit_test);
   gt_hashmap_add(unit_tests, "memory allocator module", gt_ma_unit_test);
   gt_hashmap_add(unit_tests, "multieoplist", gt_multieoplist_unit_test);
   gt_hashmap_add(unit_tests, "MD5 seqid module", gt_md5_seqid_unit_test);
   gt_hashmap_add(unit_tests, "rdj: suffix-prefix matches list module",
                                                           gt_spmlist_unit_test);
+  gt_hashmap_add(unit_tests, "ordered ring class", gt_ordered_ring_unit_test);
+  gt_hashmap_add(unit_tests, "packed features class",
+                 gt_packed_features_unit_test);
   gt_hashmap_add(unit_tests, "PBS finder module",
                                             gt_ltrdigest_pbs_visitor_unit_test);
   gt_hashmap_add(unit_tests, "popcount sorted tab", gt_popcount_tab_unit_test);
@@ -366,14 +396,18 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "safearith module", gt_safearith_unit_test);
   gt_hashmap_add(unit_tests, "sequence buffer class",
                                                   gt_sequence_buffer_unit_test);
+  gt_hashmap_add(unit_tests, "sort stream class", gt_sort_stream_unit_test);
   gt_hashmap_add(unit_tests, "splicedseq class", gt_splicedseq_unit_test);
   gt_hashmap_add(unit_tests, "splitter class", gt_splitter_unit_test);
   gt_hashmap_add(unit_tests, "string class", gt_str_unit_test);
   gt_hashmap_add(unit_tests, "string matching module",
                                                   gt_string_matching_unit_test);
+  gt_hashmap_add(unit_tests, "Smith-Waterman alignment module",
+                 gt_swalign_unit_test);
   gt_hashmap_add(unit_tests, "symbol module", gt_symbol_unit_test);
   gt_hashmap_add(unit_tests, "tag value map class", gt_tag_value_map_unit_test);
   gt_hashmap_add(unit_tests, "tag value map example", gt_tag_value_map_example);
+  gt_hashmap_add(unit_tests, "thread pool class", gt_thread_pool_unit_test);
   gt_hashmap_add(unit_tests, "tokenizer class", gt_tokenizer_unit_test);
   gt_hashmap_add(unit_tests, "translator class", gt_translator_unit_test);
   gt_hashmap_add(unit_tests, "transtable class", gt_trans_table_unit_test);
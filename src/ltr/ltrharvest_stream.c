@@ -276,6 +276,21 @@ typedef struct
   unsigned int left, right;
 } LTRMotifmismatches;
 
+/* The following function returns the characters of <lo->encseq> from
+   <startpos> to <endpos>. The motif checks below look at each position of a
+   vicinity several times, so the vicinity is extracted only once. */
+static GtUchar *ltrharvest_extract_vicinity(const GtLTRharvestStream *lo,
+                                            GtUword startpos,
+                                            GtUword endpos)
+{
+  GtUchar *vicinity;
+
+  gt_assert(startpos <= endpos);
+  vicinity = gt_malloc(sizeof (*vicinity) * (endpos - startpos + 1));
+  gt_encseq_extract_encoded(lo->encseq, vicinity, startpos, endpos);
+  return vicinity;
+}
+
 /* The following function searches for TSDs and/or a specified palindromic
    motif at the 5' border of the left LTR and 3' border of the right LTR.
    Thereby, all maximal repeats from the vicinity are processed one after
@@ -309,11 +324,24 @@ static void searchforbestTSDandormotifatborders(const SubRepeatInfo
        rep < subrepeatinfo->repeats.spaceRepeat +
              subrepeatinfo->repeats.nextfreeRepeat; rep++)
   {
+    GtUchar *leftvicinity, *rightvicinity;
+    GtUword maxshift;
+
     /* motifpos1 is the first position after the left repeat */
     motifpos1 = rep->pos1 + rep->len;
     /* motifpos2 is two positions before the right repeat */
     motifpos2 = rep->pos1 + rep->offset - 2;
-
+    if (rep->len + 1 <= subrepeatinfo->tsd_lmin)
+    {
+      continue;
+    }
+    maxshift = rep->len - subrepeatinfo->tsd_lmin;
+    /* leftvicinity[maxshift - back] is the character at motifpos1 - back,
+       rightvicinity[forward] the character at motifpos2 + forward */
+    leftvicinity = ltrharvest_extract_vicinity(lo, motifpos1 - maxshift,
+                                               motifpos1 + 1);
+    rightvicinity = ltrharvest_extract_vicinity(lo, motifpos2,
+                                                motifpos2 + 1 + maxshift);
     for (back = 0; back < rep->len - subrepeatinfo->tsd_lmin + 1; back++)
     {
       for (forward = 0;
@@ -321,30 +349,19 @@ static void searchforbestTSDandormotifatborders(const SubRepeatInfo
            forward++)
       {
         tmp_mm.left = tmp_mm.right = 0;
-        if (gt_encseq_get_encoded_char(/* Random access */ lo->encseq,
-                                       motifpos1 - back, GT_READMODE_FORWARD)
-            != lo->motif->firstleft)
+        if (leftvicinity[maxshift - back] != lo->motif->firstleft)
         {
           tmp_mm.left++;
         }
-        if (gt_encseq_get_encoded_char(/* Random access */ lo->encseq,
-                                              motifpos1 + 1 - back,
-                                              GT_READMODE_FORWARD)
-            != lo->motif->secondleft)
+        if (leftvicinity[maxshift + 1 - back] != lo->motif->secondleft)
         {
           tmp_mm.left++;
         }
-        if (gt_encseq_get_encoded_char(/* Random access */ lo->encseq,
-                                              motifpos2 + forward,
-                                              GT_READMODE_FORWARD)
-            != lo->motif->firstright)
+        if (rightvicinity[forward] != lo->motif->firstright)
         {
           tmp_mm.right++;
         }
-        if (gt_encseq_get_encoded_char(/* Random access */ lo->encseq,
-                                              motifpos2 + 1 + forward,
-                                              GT_READMODE_FORWARD)
-            != lo->motif->secondright)
+        if (rightvicinity[forward + 1] != lo->motif->secondright)
         {
           tmp_mm.right++;
         }
@@ -416,6 +433,8 @@ static void searchforbestTSDandormotifatborders(const SubRepeatInfo
         }
       }
     }
+    gt_free(leftvicinity);
+    gt_free(rightvicinity);
   }
 }
 
@@ -431,6 +450,7 @@ static void searchformotifonlyborders(const GtLTRharvestStream *lo,
 {
   bool motif1 = false,
        motif2 = false;
+  GtUchar *vicinity = NULL;
   LTRMotifmismatches tmp_mm;
   unsigned int motifmismatches_frombestmatch = 0;
   GtUword idx,
@@ -439,16 +459,18 @@ static void searchformotifonlyborders(const GtLTRharvestStream *lo,
          difffromoldboundary = 0;
 
   /**** search for left motif around leftLTR_5 ****/
+  if (startleftLTR < endleftLTR)
+  {
+    vicinity = ltrharvest_extract_vicinity(lo, startleftLTR, endleftLTR);
+  }
   for (idx = startleftLTR; idx < endleftLTR; idx++)
   {
     tmp_mm.left = 0;
-    if (gt_encseq_get_encoded_char(lo->encseq, idx, GT_READMODE_FORWARD)
-          != lo->motif->firstleft)
+    if (vicinity[idx - startleftLTR] != lo->motif->firstleft)
     {
       tmp_mm.left++;
     }
-    if (gt_encseq_get_encoded_char(lo->encseq, idx + 1, GT_READMODE_FORWARD)
-          != lo->motif->secondleft)
+    if (vicinity[idx + 1 - startleftLTR] != lo->motif->secondleft)
     {
       tmp_mm.left++;
     }
@@ -485,17 +507,21 @@ static void searchformotifonlyborders(const GtLTRharvestStream *lo,
   }
   motifmismatches->left += motifmismatches_frombestmatch;
   motifmismatches_frombestmatch = 0;
+  gt_free(vicinity);
+  vicinity = NULL;
 
+  if (startrightLTR < endrightLTR)
+  {
+    vicinity = ltrharvest_extract_vicinity(lo, startrightLTR, endrightLTR);
+  }
   for (idx = startrightLTR + 1; idx <= endrightLTR; idx++)
   {
     tmp_mm.right = 0;
-    if (gt_encseq_get_encoded_char(lo->encseq, idx, GT_READMODE_FORWARD)
-            != lo->motif->secondright)
+    if (vicinity[idx - startrightLTR] != lo->motif->secondright)
     {
       tmp_mm.right++;
     }
-    if (gt_encseq_get_encoded_char(lo->encseq, idx - 1, GT_READMODE_FORWARD)
-            != lo->motif->firstright)
+    if (vicinity[idx - 1 - startrightLTR] != lo->motif->firstright)
     {
       tmp_mm.right++;
     }
@@ -530,6 +556,7 @@ static void searchformotifonlyborders(const GtLTRharvestStream *lo,
     }
   }
   motifmismatches->right += motifmismatches_frombestmatch;
+  gt_free(vicinity);
   if (motif1 && motif2)
   {
     boundaries->motif_near_tsd = true;
@@ -555,6 +582,7 @@ static void searchformotifonlyinside(const GtLTRharvestStream *lo,
          oldrightLTR_5 = boundaries->rightLTR_5,
          difffromoldboundary = 0,
          idx;
+  GtUchar *vicinity = NULL;
   LTRMotifmismatches tmp_mm;
   unsigned int motifmismatches_frombestmatch = 0;
 
@@ -592,16 +620,18 @@ static void searchformotifonlyinside(const GtLTRharvestStream *lo,
   }
 
   /* Search for right motif around leftLTR_3 */
+  if (startleftLTR < endleftLTR)
+  {
+    vicinity = ltrharvest_extract_vicinity(lo, startleftLTR, endleftLTR);
+  }
   for (idx = startleftLTR + 1; idx <= endleftLTR; idx++)
   {
     tmp_mm.left = 0;
-    if (gt_encseq_get_encoded_char(lo->encseq, idx, GT_READMODE_FORWARD)
-              != lo->motif->secondright)
+    if (vicinity[idx - startleftLTR] != lo->motif->secondright)
     {
       tmp_mm.left++;
     }
-    if (gt_encseq_get_encoded_char(lo->encseq, idx - 1, GT_READMODE_FORWARD)
-              != lo->motif->firstright)
+    if (vicinity[idx - 1 - startleftLTR] != lo->motif->firstright)
     {
       tmp_mm.left++;
     }
@@ -638,18 +668,22 @@ static void searchformotifonlyinside(const GtLTRharvestStream *lo,
   }
   motifmismatches->left += motifmismatches_frombestmatch;
   motifmismatches_frombestmatch = 0;
+  gt_free(vicinity);
+  vicinity = NULL;
 
   /* Search for left motif around rightLTR_5 */
+  if (startrightLTR < endrightLTR)
+  {
+    vicinity = ltrharvest_extract_vicinity(lo, startrightLTR, endrightLTR);
+  }
   for (idx = startrightLTR ; idx < endrightLTR; idx++)
   {
     tmp_mm.right = 0;
-    if (gt_encseq_get_encoded_char(lo->encseq, idx, GT_READMODE_FORWARD)
-               != lo->motif->firstleft)
+    if (vicinity[idx - startrightLTR] != lo->motif->firstleft)
     {
       tmp_mm.right++;
     }
-    if (gt_encseq_get_encoded_char(lo->encseq, idx + 1, GT_READMODE_FORWARD)
-               != lo->motif->secondleft)
+    if (vicinity[idx + 1 - startrightLTR] != lo->motif->secondleft)
     {
       tmp_mm.right++;
     }
@@ -685,6 +719,7 @@ static void searchformotifonlyinside(const GtLTRharvestStream *lo,
     }
   }
   motifmismatches->right += motifmismatches_frombestmatch;
+  gt_free(vicinity);
   if (motif1 && motif2)
   {
     boundaries->motif_far_tsd = true;
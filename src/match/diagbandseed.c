@@ -42,7 +42,7 @@
 #include "match/sfx-suffixer.h"
 
 #ifdef GT_THREADS_ENABLED
-#include "core/thread_api.h"
+#include "core/thread_pool.h"
 #endif
 
 #define GT_DIAGBANDSEED_SEQNUM_UNDEF UINT_MAX
@@ -109,6 +109,7 @@ struct GtDiagbandseedExtendParams {
   bool use_apos;
   bool extendgreedy;
   bool extendxdrop;
+  bool extendbitparallel;
   bool weakends;
   bool benchmark;
   bool always_polished_ends;
@@ -186,6 +187,7 @@ GtDiagbandseedExtendParams *gt_diagbandseed_extend_params_new(
                                 GtXdropscore xdropbelowscore,
                                 bool extendgreedy,
                                 bool extendxdrop,
+                                bool extendbitparallel,
                                 GtUword maxalignedlendifference,
                                 GtUword history_size,
                                 GtUword perc_mat_history,
@@ -208,6 +210,7 @@ GtDiagbandseedExtendParams *gt_diagbandseed_extend_params_new(
   extp->xdropbelowscore = xdropbelowscore;
   extp->extendgreedy = extendgreedy;
   extp->extendxdrop = extendxdrop;
+  extp->extendbitparallel = extendbitparallel;
   extp->maxalignedlendifference = maxalignedlendifference;
   extp->history_size = history_size;
   extp->perc_mat_history = perc_mat_history;
@@ -363,6 +366,58 @@ static void gt_diagbandseed_get_kmers_kciter(GtDiagbandseedProcKmerInfo *pkinfo)
   gt_kmercodeiterator_delete(kc_iter);
 }
 
+/* Fetches the kmers from blocks of two bit encoded characters, in which the
+   wildcards and separators are marked. This is used instead of
+   GtKmercodeiterator if the sequence contains wildcards. */
+static void gt_diagbandseed_get_kmers_blockwise(GtDiagbandseedProcKmerInfo
+                                                *pkinfo)
+{
+  GtEncseqReader *esr;
+  GtEncseqBlock block;
+  const GtCodetype kmermask = GT_MASKRIGHT(pkinfo->seedlength);
+  const bool complement = GT_ISDIRCOMPLEMENT(pkinfo->readmode);
+  GtCodetype code = 0;
+  GtUword blockstart, validchars = 0;
+  bool firstinrange = true;
+
+  gt_assert(pkinfo != NULL && !GT_ISDIRREVERSE(pkinfo->readmode));
+  esr = gt_encseq_create_reader_with_readmode(pkinfo->encseq,
+                                              GT_READMODE_FORWARD, 0);
+  for (blockstart = gt_encseq_seqstartpos(pkinfo->encseq, pkinfo->seqnum);
+       blockstart < pkinfo->totallength;
+       blockstart += GT_ENCSEQ_BLOCKSIZE) {
+    GtUword idx, width = MIN((GtUword) GT_ENCSEQ_BLOCKSIZE,
+                             pkinfo->totallength - blockstart);
+
+    gt_encseq_extract_block(&block, pkinfo->encseq, esr, blockstart);
+    for (idx = 0; idx < width; idx++) {
+      GtCodetype cc;
+
+      if (block.specialmask & GT_ENCSEQ_BLOCKBIT(idx)) {
+        validchars = 0;
+        firstinrange = true;
+        continue;
+      }
+      cc = (block.tbe[GT_DIVBYUNITSIN2BITENC(idx)]
+            >> GT_MULT2(GT_UNITSIN2BITENC - 1 - GT_MODBYUNITSIN2BITENC(idx)))
+           & 3;
+      code = ((code << 2) | (complement ? 3 - cc : cc)) & kmermask;
+      if (validchars < (GtUword) pkinfo->seedlength) {
+        validchars++;
+      }
+      if (validchars == (GtUword) pkinfo->seedlength) {
+        gt_diagbandseed_processkmercode((void *) pkinfo,
+                                        firstinrange,
+                                        blockstart + idx + 1 -
+                                        pkinfo->seedlength,
+                                        code);
+        firstinrange = false;
+      }
+    }
+  }
+  gt_encseq_reader_delete(esr);
+}
+
 /* Return a sorted list of k-mers of given seedlength from specified encseq.
  * Only sequences in seqrange will be taken into account.
  * The caller is responsible for freeing the result. */
@@ -446,6 +501,9 @@ GtArrayGtDiagbandseedKmerPos gt_diagbandseed_get_kmers(const GtEncseq *encseq,
                                         NULL,
                                         pkinfo.prev_separator,
                                         pkinfo.totallength);
+  } else if (gt_encseq_has_twobitencoding(encseq)) {
+    /* Use blockwise access to the 2bit-enc with marked wildcards. */
+    gt_diagbandseed_get_kmers_blockwise(&pkinfo);
   } else {
     /* Use GtKmercodeiterator for encseq access */
     gt_diagbandseed_get_kmers_kciter(&pkinfo);
@@ -1429,6 +1487,9 @@ static int gt_diagbandseed_algorithm(const GtDiagbandseedInfo *arg,
     if (extp->benchmark) {
       gt_greedy_extend_matchinfo_silent_set(grextinfo);
     }
+    if (extp->extendbitparallel) {
+      gt_greedy_extend_matchinfo_bitparallel_set(grextinfo);
+    }
     processinfo = (void *)grextinfo;
   } else if (extp->extendxdrop) {
     GtXdropmatchinfo *xdropinfo = NULL;
@@ -1595,54 +1656,97 @@ typedef struct{
   const GtDiagbandseedInfo *arg;
   const GtArrayGtDiagbandseedKmerPos *alist;
   FILE *stream;
-  const GtRange *aseqranges;
-  const GtRange *bseqranges;
-  GtArray *combinations;
+  const GtRange *aseqrange;
+  const GtRange *bseqrange;
+  GtUwordPair partindex;
   int had_err;
   GtError *err;
 }GtDiagbandseedThreadInfo;
 
-static
-void gt_diagbandseed_thread_info_set(GtDiagbandseedThreadInfo *ti,
-                                     const GtDiagbandseedInfo *arg,
-                                     const GtArrayGtDiagbandseedKmerPos *alist,
-                                     FILE *stream,
-                                     const GtRange *aseqranges,
-                                     const GtRange *bseqranges,
-                                     GtArray *combinations,
-                                     GtError *err)
+static void *gt_diagbandseed_thread_algorithm(void *thread_info)
 {
-  gt_assert(ti != NULL);
-  ti->arg = arg;
-  ti->alist = alist;
-  ti->stream = stream;
-  ti->aseqranges = aseqranges;
-  ti->bseqranges = bseqranges;
-  ti->combinations = gt_array_clone(combinations);
-  ti->had_err = 0;
-  ti->err = err;
+  GtDiagbandseedThreadInfo *info = (GtDiagbandseedThreadInfo *)thread_info;
+
+  info->had_err = gt_diagbandseed_algorithm(info->arg,
+                                            info->alist,
+                                            info->stream,
+                                            info->aseqrange,
+                                            info->bseqrange,
+                                            info->partindex,
+                                            info->err);
+  return NULL;
 }
 
-static void *gt_diagbandseed_thread_algorithm(void *thread_info)
+/* Run the algorithm for the sequence range <aidx> of the first sequence set
+   and all chosen sequence ranges of the second one from <bidx> on, with one
+   task of the thread pool per combination. Idle threads steal the remaining
+   combinations, so large parts do not leave threads waiting. The output of
+   each but the first combination is buffered in a temporary file and copied
+   to stdout in the order of the combinations. */
+static int gt_diagbandseed_run_parallel(const GtDiagbandseedInfo *arg,
+                                     const GtArrayGtDiagbandseedKmerPos *alist,
+                                        const GtRange *aseqranges,
+                                        const GtRange *bseqranges,
+                                        GtUword aidx,
+                                        GtUword bidx,
+                                        const GtUwordPair *pick,
+                                        GtError *err)
 {
-  GtDiagbandseedThreadInfo *info = (GtDiagbandseedThreadInfo *)thread_info;
-  if (gt_array_size(info->combinations) != 0) {
-    const GtUwordPair *last = gt_array_get_last(info->combinations);
-    GtUwordPair *comb;
-
-    for (comb = gt_array_get_first(info->combinations); comb <= last; comb++) {
-      info->had_err = gt_diagbandseed_algorithm(info->arg,
-                                                info->alist,
-                                                info->stream,
-                                                info->aseqranges + comb->a,
-                                                info->bseqranges + comb->b,
-                                                *comb,
-                                                info->err);
-      if (info->had_err) break;
+  const bool bpick = pick->b != GT_UWORD_MAX ? true : false;
+  GtDiagbandseedThreadInfo *tinfo;
+  GtTaskGroup *group;
+  GtUword idx, num_runs = 0;
+  int had_err = 0;
+
+  gt_assert(bidx < arg->bnumseqranges);
+  tinfo = gt_malloc((arg->bnumseqranges - bidx) * sizeof *tinfo);
+  group = gt_task_group_new(gt_thread_pool_get());
+  for (/* Nothing */; bidx < arg->bnumseqranges; bidx++) {
+    if (!bpick || pick->b == bidx) {
+      GtDiagbandseedThreadInfo *ti = tinfo + num_runs;
+
+      ti->arg = arg;
+      ti->alist = alist;
+      ti->stream = num_runs == 0
+                     ? stdout
+                     : gt_xtmpfp_generic(NULL, TMPFP_OPENBINARY |
+                                               TMPFP_AUTOREMOVE);
+      ti->aseqrange = aseqranges + aidx;
+      ti->bseqrange = bseqranges + bidx;
+      ti->partindex.a = aidx;
+      ti->partindex.b = bidx;
+      ti->had_err = 0;
+      ti->err = gt_error_new();
+      num_runs++;
+      gt_task_group_submit(group, gt_diagbandseed_thread_algorithm, ti);
     }
   }
-  gt_array_delete(info->combinations);
-  return NULL;
+  gt_task_group_join(group);
+  gt_task_group_delete(group);
+
+  /* print the output of the combinations to stdout */
+  for (idx = 0; idx < num_runs; idx++) {
+    GtDiagbandseedThreadInfo *ti = tinfo + idx;
+
+    if (!had_err && ti->had_err) {
+      gt_error_set(err, "%s", gt_error_get(ti->err));
+      had_err = -1;
+    }
+    if (ti->stream != stdout) {
+      char buffer[BUFSIZ];
+      size_t nread;
+
+      rewind(ti->stream);
+      while ((nread = fread(buffer, sizeof (char), sizeof buffer,
+                            ti->stream)) > 0) {
+        gt_xfwrite(buffer, sizeof (char), nread, stdout);
+      }
+      gt_fa_xfclose(ti->stream);
+    }
+    gt_error_delete(ti->err);
+  }
+  gt_free(tinfo);
+  return had_err;
 }
 #endif
 
@@ -1684,19 +1788,6 @@ int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
   GtArrayGtDiagbandseedKmerPos alist;
   GtUword aidx, bidx;
   int had_err = 0;
-#ifdef GT_THREADS_ENABLED
-  GtDiagbandseedThreadInfo *tinfo = gt_malloc(gt_jobs * sizeof *tinfo);
-  FILE **stream;
-  unsigned int tidx;
-
-  /* create output streams */
-  stream = gt_malloc(gt_jobs * sizeof *stream);
-  stream[0] = stdout;
-  for (tidx = 1; !had_err && tidx < gt_jobs; tidx++) {
-    stream[tidx] = gt_xtmpfp_generic(NULL, TMPFP_OPENBINARY | TMPFP_AUTOREMOVE);
-  }
-#endif
-
   /* create all missing k-mer lists for bencseq */
   if (arg->use_kmerfile) {
     unsigned int count;
@@ -1777,164 +1868,20 @@ int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
         bidx++;
       }
 #ifdef GT_THREADS_ENABLED
-    } else if (!arg->use_kmerfile) {
-      const GtUword num_runs = bpick ? 1 : arg->bnumseqranges - bidx;
-      const GtUword num_runs_per_thread = (num_runs - 1) / gt_jobs + 1;
-      const GtUword num_threads = (num_runs - 1) / num_runs_per_thread + 1;
-      GtArray *combinations = gt_array_new(sizeof (GtUwordPair));
-      GtArray *threads = gt_array_new(sizeof (GtThread *));
-
-      gt_assert(bidx < arg->bnumseqranges);
-      gt_assert(num_threads <= gt_jobs);
-      gt_assert(!bpick || num_threads == 1);
-
-      /* start additional threads */
-      for (tidx = 1; !had_err && tidx < num_threads; tidx++) {
-        GtThread *thread;
-        GtUword idx;
-        bidx += num_runs_per_thread;
-        const GtUword end = MIN(bidx + num_runs_per_thread, arg->bnumseqranges);
-
-        for (idx = bidx; idx < end; idx++) {
-          GtUwordPair comb = {aidx, idx};
-          gt_array_add(combinations, comb);
-        }
-        gt_diagbandseed_thread_info_set(tinfo + tidx,
-                                        arg,
-                                        use_alist ? &alist : NULL,
-                                        stream[tidx],
-                                        aseqranges,
-                                        bseqranges,
-                                        combinations,
-                                        err);
-        gt_array_reset(combinations);
-        if ((thread = gt_thread_new(gt_diagbandseed_thread_algorithm,
-                                    tinfo + tidx, err)) != NULL) {
-          gt_array_add(threads, thread);
-        } else {
-          had_err = -1;
-        }
-      }
-
-      /* start main thread */
-      if (!had_err) {
-        GtUword idx;
-        bidx = self ? aidx : 0;
-        for (idx = bidx;
-             idx < MIN(bidx + num_runs_per_thread, arg->bnumseqranges);
-             ++idx) {
-          if (!bpick || pick->b == idx) {
-            GtUwordPair comb = {aidx, idx};
-            gt_array_add(combinations, comb);
-          }
-        }
-        gt_diagbandseed_thread_info_set(tinfo,
-                                        arg,
-                                        use_alist ? &alist : NULL,
-                                        stream[0],
-                                        aseqranges,
-                                        bseqranges,
-                                        combinations,
-                                        err);
-        gt_diagbandseed_thread_algorithm(tinfo);
-      }
-
-      /* clean up */
-      for (tidx = 0; tidx < gt_array_size(threads); tidx++) {
-        GtThread *thread = *(GtThread**) gt_array_get(threads, tidx);
-        if (!had_err) {
-          gt_thread_join(thread);
-        }
-        gt_thread_delete(thread);
-      }
-      gt_array_delete(threads);
-      for (tidx = 0; tidx < num_threads && !had_err; tidx++) {
-        had_err = tinfo[tidx].had_err;
-      }
-      gt_array_delete(combinations);
+    } else if (!had_err) {
+      had_err = gt_diagbandseed_run_parallel(arg,
+                                             use_alist ? &alist : NULL,
+                                             aseqranges,
+                                             bseqranges,
+                                             aidx,
+                                             bidx,
+                                             pick,
+                                             err);
     }
 #endif
     if (use_alist) {
       GT_FREEARRAY(&alist, GtDiagbandseedKmerPos);
     }
   }
-#ifdef GT_THREADS_ENABLED
-  if (gt_jobs > 1 && arg->use_kmerfile) {
-    GtArray *combinations[gt_jobs];
-    GtArray *threads = gt_array_new(sizeof (GtThread *));
-    GtUword counter = 0;
-    for (tidx = 0; tidx < gt_jobs; tidx++) {
-      combinations[tidx] = gt_array_new(sizeof (GtUwordPair));
-    }
-    for (aidx = 0; aidx < arg->anumseqranges; aidx++) {
-      if (apick && pick->a != aidx) continue;
-      for (bidx = self ? aidx : 0; bidx < arg->bnumseqranges; bidx++) {
-        if (!bpick || pick->b == bidx) {
-          GtUwordPair comb = {aidx, bidx};
-          gt_array_add(combinations[counter++ % gt_jobs], comb);
-        }
-      }
-    }
-
-    for (tidx = 1; !had_err && tidx < gt_jobs; tidx++) {
-      GtThread *thread;
-      gt_diagbandseed_thread_info_set(tinfo + tidx,
-                                      arg,
-                                      NULL,
-                                      stream[tidx],
-                                      aseqranges,
-                                      bseqranges,
-                                      combinations[tidx],
-                                      err);
-      if ((thread = gt_thread_new(gt_diagbandseed_thread_algorithm,
-                                  tinfo + tidx, err)) != NULL) {
-        gt_array_add(threads, thread);
-      } else {
-        had_err = -1;
-      }
-    }
-    /* start main thread */
-    if (!had_err) {
-      gt_diagbandseed_thread_info_set(tinfo,
-                                      arg,
-                                      NULL,
-                                      stream[0],
-                                      aseqranges,
-                                      bseqranges,
-                                      combinations[0],
-                                      err);
-      gt_diagbandseed_thread_algorithm(tinfo);
-    }
-
-    /* clean up */
-    for (tidx = 0; tidx < gt_array_size(threads); tidx++) {
-      GtThread *thread = *(GtThread**) gt_array_get(threads, tidx);
-      if (!had_err) {
-        gt_thread_join(thread);
-      }
-      gt_thread_delete(thread);
-    }
-    for (tidx = 0; tidx < gt_array_size(threads) && !had_err; tidx++) {
-      had_err = tinfo[tidx].had_err;
-    }
-    gt_array_delete(threads);
-    for (tidx = 0; tidx < gt_jobs; tidx++) {
-      gt_array_delete(combinations[tidx]);
-    }
-  }
-  gt_free(tinfo);
-
-  /* print the threads' output to stdout */
-  for (tidx = 1; tidx < gt_jobs; tidx++) {
-    char cc;
-    rewind(stream[tidx]);
-    while ((cc = fgetc(stream[tidx])) != EOF) {
-      putchar(cc);
-    }
-    gt_fa_xfclose(stream[tidx]);
-  }
-  gt_free(stream);
-
-#endif
   return had_err;
 }
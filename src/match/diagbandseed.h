@@ -65,6 +65,7 @@ GtDiagbandseedExtendParams *gt_diagbandseed_extend_params_new(
                               GtXdropscore xdropbelowscore,
                               bool extendgreedy,
                               bool extendxdrop,
+                              bool extendbitparallel,
                               GtUword maxalignedlendifference,
                               GtUword history_size,
                               GtUword perc_mat_history,
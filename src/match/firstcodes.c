@@ -31,7 +31,7 @@
 #include "core/unused_api.h"
 #include "core/minmax.h"
 #ifdef GT_THREADS_ENABLED
-#include "core/thread_api.h"
+#include "core/thread_pool.h"
 #endif
 #include "firstcodes-buf.h"
 #include "firstcodes-spacelog.h"
@@ -474,7 +474,6 @@ typedef struct
   GtFirstcodesintervalprocess_end itvprocess_end;
   void *itvprocessdata;
   GtError *err;
-  GtThread *thread;
 } GtSortRemainingThreadinfo;
 
 static void *gt_firstcodes_thread_caller_sortremaining(void *data)
@@ -528,12 +527,13 @@ static int gt_firstcodes_thread_sortremaining(
   unsigned int t;
   GtUword sum = 0, *endindexes;
   GtSortRemainingThreadinfo *threadinfo;
-  bool haserr = false;
+  GtTaskGroup *group;
 
   gt_assert(threads >= 2U);
   endindexes = gt_evenly_divide_part(fct,partminindex,partmaxindex,widthofpart,
                                      threads);
   threadinfo = gt_malloc(sizeof (*threadinfo) * threads);
+  group = gt_task_group_new(gt_thread_pool_get());
   for (t=0; t<threads; t++)
   {
     GtUword lb;
@@ -577,26 +577,15 @@ static int gt_firstcodes_thread_sortremaining(
                                      threadinfo[t].sumofwidth,
                                      threadinfo[t].sumofwidth - lb);
     sum += threadinfo[t].sumofwidth - lb;
-    threadinfo[t].thread
-      = gt_thread_new (gt_firstcodes_thread_caller_sortremaining,
-                       threadinfo + t,err);
-    if (threadinfo[t].thread == NULL)
-    {
-      haserr = true;
-    }
-  }
-  gt_assert (haserr || sum == widthofpart);
-  for (t=0; t<threads; t++)
-  {
-    if (!haserr)
-    {
-      gt_thread_join(threadinfo[t].thread);
-    }
-    gt_thread_delete(threadinfo[t].thread);
+    gt_task_group_submit(group,gt_firstcodes_thread_caller_sortremaining,
+                         threadinfo + t);
   }
+  gt_assert (sum == widthofpart);
+  gt_task_group_join(group);
+  gt_task_group_delete(group);
   gt_free(threadinfo);
   gt_free(endindexes);
-  return haserr ? -1 : 0;
+  return 0;
 }
 #endif
 
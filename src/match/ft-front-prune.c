@@ -173,7 +173,7 @@ static GtUchar ft_sequenceobject_get_char(Sequenceobject *seq,GtUword idx)
     gt_assert(idx < seq->substringlength);
     if (idx >= seq->cache_num_positions)
     {
-      GtUword idx, tostore;
+      GtUword tostore;
       const GtUword addamount = 256UL;
 
       tostore = MIN(seq->cache_num_positions + addamount,
@@ -186,11 +186,10 @@ static GtUchar ft_sequenceobject_get_char(Sequenceobject *seq,GtUword idx)
                        sizeof (GtUchar) * seq->sequence_cache->allocated);
         seq->cache_ptr = (GtUchar *) seq->sequence_cache->space;
       }
-      for (idx = seq->cache_num_positions; idx < tostore; idx++)
-      {
-        seq->cache_ptr[idx]
-          = gt_encseq_reader_next_encoded_char(seq->encseqreader);
-      }
+      gt_encseq_reader_next_encoded_chars(seq->encseqreader,
+                                          seq->cache_ptr +
+                                          seq->cache_num_positions,
+                                          tostore - seq->cache_num_positions);
       seq->cache_num_positions = tostore;
     }
     gt_assert(seq->cache_ptr != NULL && idx < seq->cache_num_positions);
@@ -983,3 +982,387 @@ GtUword front_prune_edist_inplace(
 #endif
   return diedout ? sumseqlength + 1 : distance;
 }
+
+#ifndef OUTSIDE_OF_GT
+/* The number of characters of the first sequence which are processed as one
+   segment by the bit-parallel extension, i.e. the number of rows of the
+   dynamic programming matrix represented by one bit vector. */
+#define GT_BITPARALLEL_SEGMENT_ROWS 64
+
+static void bitparallel_peq_fill(uint64_t *peq,Sequenceobject *useq,
+                                 GtUword upos,GtUword rows)
+{
+  GtUword idx;
+
+  for (idx = 0; idx < rows; idx++)
+  {
+    GtUchar cc = ft_sequenceobject_get_char(useq,upos + idx);
+
+    if (!ISSPECIAL(cc))
+    {
+      peq[cc] |= ((uint64_t) 1) << idx;
+    }
+  }
+}
+
+static void bitparallel_peq_clear(uint64_t *peq,Sequenceobject *useq,
+                                  GtUword upos,GtUword rows)
+{
+  GtUword idx;
+
+  for (idx = 0; idx < rows; idx++)
+  {
+    GtUchar cc = ft_sequenceobject_get_char(useq,upos + idx);
+
+    if (!ISSPECIAL(cc))
+    {
+      peq[cc] = 0;
+    }
+  }
+}
+
+/* One column of the edit distance computation of Myers/Hyyroe for the
+   vertical delta vectors <*vp> and <*vn>, with the first row being the
+   boundary row of a global alignment. The horizontal deltas are returned
+   in <*hp> and <*hn>. */
+static inline void bitparallel_column(uint64_t eq,uint64_t *vp,uint64_t *vn,
+                                      uint64_t *hp,uint64_t *hn)
+{
+  const uint64_t xv = eq | *vn,
+                 xh = (((eq & *vp) + *vp) ^ *vp) | eq;
+  uint64_t hp_shifted, hn_shifted;
+
+  *hp = *vn | ~(xh | *vp);
+  *hn = *vp & xh;
+  hp_shifted = (*hp << 1) | (uint64_t) 1;
+  hn_shifted = *hn << 1;
+  *vp = hn_shifted | ~(xv | hp_shifted);
+  *vn = hp_shifted & xv;
+}
+
+/* One column of the edit distance computation for one block of a matrix
+   with more than 64 rows, see Hyyroe (2003). <hin> is the horizontal delta
+   in the row above the block. The horizontal delta in the row marked by
+   <outbit> is returned. */
+static inline int bitparallel_block_column(uint64_t eq,uint64_t *vp,
+                                           uint64_t *vn,int hin,
+                                           uint64_t outbit)
+{
+  const uint64_t xv = eq | *vn;
+  uint64_t xh, hp, hn;
+  int hout = 0;
+
+  if (hin < 0)
+  {
+    eq |= (uint64_t) 1;
+  }
+  xh = (((eq & *vp) + *vp) ^ *vp) | eq;
+  hp = *vn | ~(xh | *vp);
+  hn = *vp & xh;
+  if (hp & outbit)
+  {
+    hout = 1;
+  } else
+  {
+    if (hn & outbit)
+    {
+      hout = -1;
+    }
+  }
+  hp <<= 1;
+  hn <<= 1;
+  if (hin < 0)
+  {
+    hn |= (uint64_t) 1;
+  } else
+  {
+    if (hin > 0)
+    {
+      hp |= (uint64_t) 1;
+    }
+  }
+  *vp = hn | ~(xv | hp);
+  *vn = hp & xv;
+  return hout;
+}
+
+#define BITPARALLEL_BLOCK_END(BLOCK)\
+        MIN(GT_BITPARALLEL_SEGMENT_ROWS * ((BLOCK) + 1),ulen)
+
+/* Returns the edit distance of the first <ulen> characters of <useq> and
+   the first <vlen> characters of <vseq>, which must be at most
+   <upperbound>. Only the blocks of rows which intersect the diagonal band
+   of all cells with a distance of at most <upperbound> are computed. A
+   block above the band delivers a delta of 1 to the block below it,
+   which overestimates only cells outside of the band. */
+static GtUword bitparallel_global_edist(Sequenceobject *useq,GtUword ulen,
+                                        Sequenceobject *vseq,GtUword vlen,
+                                        GtUword upperbound)
+{
+  const GtUword nofblocks = (ulen + GT_BITPARALLEL_SEGMENT_ROWS - 1)/
+                            GT_BITPARALLEL_SEGMENT_ROWS;
+  GtUword idx, col, alphasize = 0, firstblock = 0, lastblock, *blockscore,
+          distance;
+  uint64_t *peq, *vp, *vn;
+  GtUchar *uchars;
+
+  if (ulen == 0 || vlen == 0)
+  {
+    return ulen + vlen;
+  }
+  uchars = gt_malloc(sizeof *uchars * ulen);
+  for (idx = 0; idx < ulen; idx++)
+  {
+    uchars[idx] = ft_sequenceobject_get_char(useq,idx);
+    if (!ISSPECIAL(uchars[idx]) && uchars[idx] >= alphasize)
+    {
+      alphasize = (GtUword) uchars[idx] + 1;
+    }
+  }
+  peq = gt_calloc(MAX(alphasize,1) * nofblocks,sizeof *peq);
+  for (idx = 0; idx < ulen; idx++)
+  {
+    if (!ISSPECIAL(uchars[idx]))
+    {
+      peq[idx/GT_BITPARALLEL_SEGMENT_ROWS * alphasize + uchars[idx]]
+        |= ((uint64_t) 1) << (idx % GT_BITPARALLEL_SEGMENT_ROWS);
+    }
+  }
+  gt_free(uchars);
+  vp = gt_malloc(sizeof *vp * nofblocks);
+  vn = gt_malloc(sizeof *vn * nofblocks);
+  blockscore = gt_malloc(sizeof *blockscore * nofblocks);
+  /* blockscore[b] is the distance in the last row of block b */
+  lastblock = MIN(nofblocks - 1,upperbound/GT_BITPARALLEL_SEGMENT_ROWS);
+  for (idx = 0; idx <= lastblock; idx++)
+  {
+    vp[idx] = ~((uint64_t) 0);
+    vn[idx] = 0;
+    blockscore[idx] = BITPARALLEL_BLOCK_END(idx);
+  }
+  for (col = 1; col <= vlen; col++)
+  {
+    const GtUchar cc = ft_sequenceobject_get_char(vseq,col - 1);
+    int hin = 1;
+
+    while (lastblock + 1 < nofblocks &&
+           GT_BITPARALLEL_SEGMENT_ROWS * (lastblock + 1) < col + upperbound)
+    {
+      lastblock++;
+      vp[lastblock] = ~((uint64_t) 0);
+      vn[lastblock] = 0;
+      blockscore[lastblock] = blockscore[lastblock - 1] +
+                              BITPARALLEL_BLOCK_END(lastblock) -
+                              BITPARALLEL_BLOCK_END(lastblock - 1);
+    }
+    while (firstblock < lastblock &&
+           BITPARALLEL_BLOCK_END(firstblock) + upperbound < col)
+    {
+      firstblock++;
+    }
+    for (idx = firstblock; idx <= lastblock; idx++)
+    {
+      const uint64_t eq = ISSPECIAL(cc) || cc >= alphasize
+                            ? 0 : peq[idx * alphasize + cc],
+                     outbit = ((uint64_t) 1) <<
+                              ((BITPARALLEL_BLOCK_END(idx) - 1) %
+                               GT_BITPARALLEL_SEGMENT_ROWS);
+
+      hin = bitparallel_block_column(eq,vp + idx,vn + idx,hin,outbit);
+      blockscore[idx] += hin;
+    }
+  }
+  gt_assert(lastblock == nofblocks - 1);
+  distance = blockscore[lastblock];
+  gt_assert(distance <= upperbound);
+  gt_free(peq);
+  gt_free(vp);
+  gt_free(vn);
+  gt_free(blockscore);
+  return distance;
+}
+
+/* The score of an alignment of <alignedlen> characters with the given
+   <distance>. It is positive iff the error rate of the alignment is below
+   the error percentage, see <gt_querymatch_check_final>. */
+#define BITPARALLEL_SCORE(ALIGNEDLEN,DISTANCE)\
+        ((GtWord) (errorpercentage * (ALIGNEDLEN)) -\
+         (GtWord) (200 * (DISTANCE)))
+
+GtUword bitparallel_extend_edist(bool rightextension,
+                                 Polished_point *best_polished_point,
+                                 GtUword errorpercentage,
+                                 GtUword max_history,
+                                 GtUword minmatchpercentage,
+                                 GtUword maxalignedlendifference,
+                                 FTsequenceResources *ufsr,
+                                 GtUword ustart,
+                                 GtUword ulen,
+                                 GtUword vseqstartpos,
+                                 FTsequenceResources *vfsr,
+                                 GtUword vstart,
+                                 GtUword vlen)
+{
+  uint64_t peq[UCHAR_MAX + 1];
+  GtUword upos = 0, vpos = 0, distance = 0, rows, columns, col,
+          best_upos = 0, best_vpos = 0, best_distance = 0;
+  GtWord score = 0, best_score = 0;
+  /* the score of <max_history> columns with the allowed number of errors */
+  const GtWord xdropbelow = (GtWord) (2 * max_history *
+                                      (100 - MIN(minmatchpercentage, 100)));
+  Sequenceobject useq, vseq;
+
+  gt_assert(best_polished_point != NULL);
+  ft_sequenceobject_init(&useq,
+                         ufsr->extend_char_access,
+                         ufsr->encseq,
+                         rightextension,
+                         ufsr->readmode,
+                         0,
+                         ustart,
+                         ulen,
+                         ufsr->encseq_r,
+                         ufsr->sequence_cache,
+                         NULL,
+                         ufsr->totallength);
+  ft_sequenceobject_init(&vseq,
+                         vfsr->extend_char_access,
+                         vfsr->encseq,
+                         rightextension,
+                         vfsr->readmode,
+                         vseqstartpos,
+                         vstart,
+                         vlen,
+                         vfsr->encseq_r,
+                         vfsr->sequence_cache,
+                         vfsr->bytesequence,
+                         vfsr->totallength);
+  memset(peq,0,sizeof peq);
+  /* Align segments of GT_BITPARALLEL_SEGMENT_ROWS characters of the first
+     sequence globally with the prefix of the remaining second sequence
+     for which the score is maximal, until the accumulated score drops
+     too far below the best score. */
+  while (upos < ulen && vpos < vlen)
+  {
+    uint64_t vp = ~((uint64_t) 0), vn = 0, hp, hn, lastrowbit;
+    GtUword lastrow, segment_col = 0, segment_distance = 0;
+    GtWord segment_score = 0;
+
+    rows = MIN(GT_BITPARALLEL_SEGMENT_ROWS,ulen - upos);
+    columns = MIN(rows + maxalignedlendifference,vlen - vpos);
+    lastrowbit = ((uint64_t) 1) << (rows - 1);
+    lastrow = rows;
+    bitparallel_peq_fill(peq,&useq,upos,rows);
+    for (col = 1; col <= columns; col++)
+    {
+      GtUchar cc = ft_sequenceobject_get_char(&vseq,vpos + col - 1);
+      GtWord col_score;
+
+      bitparallel_column(ISSPECIAL(cc) ? 0 : peq[cc],&vp,&vn,&hp,&hn);
+      if (hp & lastrowbit)
+      {
+        lastrow++;
+      } else
+      {
+        if (hn & lastrowbit)
+        {
+          lastrow--;
+        }
+      }
+      col_score = BITPARALLEL_SCORE(rows + col,lastrow);
+      if (col == 1 || col_score > segment_score)
+      {
+        segment_score = col_score;
+        segment_col = col;
+        segment_distance = lastrow;
+      }
+    }
+    bitparallel_peq_clear(peq,&useq,upos,rows);
+    score += segment_score;
+    upos += rows;
+    vpos += segment_col;
+    distance += segment_distance;
+    if (score > best_score)
+    {
+      best_score = score;
+      best_upos = upos;
+      best_vpos = vpos;
+      best_distance = distance;
+    } else
+    {
+      if (score < best_score - xdropbelow)
+      {
+        break;
+      }
+    }
+  }
+  /* The end of the extension is only known up to a segment. Find the best
+     end point in the segment following the best one. */
+  if (best_upos < ulen && best_vpos < vlen)
+  {
+    uint64_t vp = ~((uint64_t) 0), vn = 0, hp, hn;
+    GtUword tail_row = 0, tail_col = 0, tail_distance = 0;
+    GtWord tail_score = 0;
+
+    rows = MIN(GT_BITPARALLEL_SEGMENT_ROWS,ulen - best_upos);
+    columns = MIN(rows + maxalignedlendifference,vlen - best_vpos);
+    bitparallel_peq_fill(peq,&useq,best_upos,rows);
+    for (col = 1; col <= columns; col++)
+    {
+      GtUchar cc = ft_sequenceobject_get_char(&vseq,best_vpos + col - 1);
+      GtUword row, lastrow,
+              firstrow = col > maxalignedlendifference
+                           ? col - maxalignedlendifference : 1;
+      GtUword row_distance = col;
+
+      bitparallel_column(ISSPECIAL(cc) ? 0 : peq[cc],&vp,&vn,&hp,&hn);
+      lastrow = MIN(rows,col + maxalignedlendifference);
+      for (row = 1; row <= lastrow; row++)
+      {
+        const uint64_t rowbit = ((uint64_t) 1) << (row - 1);
+
+        if (vp & rowbit)
+        {
+          row_distance++;
+        } else
+        {
+          if (vn & rowbit)
+          {
+            row_distance--;
+          }
+        }
+        if (row >= firstrow)
+        {
+          GtWord cell_score = BITPARALLEL_SCORE(row + col,row_distance);
+
+          if (cell_score > tail_score)
+          {
+            tail_score = cell_score;
+            tail_row = row;
+            tail_col = col;
+            tail_distance = row_distance;
+          }
+        }
+      }
+    }
+    bitparallel_peq_clear(peq,&useq,best_upos,rows);
+    best_upos += tail_row;
+    best_vpos += tail_col;
+    best_distance += tail_distance;
+  }
+  /* The segments are aligned independently, so the sum of their distances
+     is only an upper bound for the distance of the aligned prefixes. */
+  best_distance = bitparallel_global_edist(&useq,best_upos,&vseq,best_vpos,
+                                           best_distance);
+  best_polished_point->alignedlen = best_upos + best_vpos;
+  best_polished_point->row = best_upos;
+  best_polished_point->distance = best_distance;
+  best_polished_point->trimleft = 0;
+  /* an alignment with the given distance has at least as many indels as
+     the difference of the aligned lengths */
+  best_polished_point->max_mismatches
+    = best_distance - (best_upos > best_vpos ? best_upos - best_vpos
+                                             : best_vpos - best_upos);
+  return best_distance;
+}
+#endif
@@ -63,4 +63,30 @@ GtUword front_prune_edist_inplace(
                        GtUword vstart,
                        GtUword vlen);
 
+#ifndef OUTSIDE_OF_GT
+/* Extend an alignment of the sequences described by <ufsr> and <vfsr> from
+   <ustart> and <vstart> (as <front_prune_edist_inplace> does), using the
+   bit-parallel edit distance computation of Myers/Hyyroe on segments of
+   64 characters of the first sequence and at most
+   <maxalignedlendifference> more characters of the second sequence. The
+   extension stops when the score of the alignment, which is positive iff its
+   error rate is below <errorpercentage>, drops below the best score by more
+   than the score of <max_history> columns with <minmatchpercentage> percent
+   matches. The end point with the best score is stored in
+   <best_polished_point> and its distance is returned. */
+GtUword bitparallel_extend_edist(bool rightextension,
+                                 Polished_point *best_polished_point,
+                                 GtUword errorpercentage,
+                                 GtUword max_history,
+                                 GtUword minmatchpercentage,
+                                 GtUword maxalignedlendifference,
+                                 FTsequenceResources *ufsr,
+                                 GtUword ustart,
+                                 GtUword ulen,
+                                 GtUword vseqstartpos,
+                                 FTsequenceResources *vfsr,
+                                 GtUword vstart,
+                                 GtUword vlen);
+#endif
+
 #endif
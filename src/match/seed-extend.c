@@ -386,7 +386,8 @@ struct GtGreedyextendmatchinfo
   unsigned int userdefinedleastlength;
   GtExtendCharAccess extend_char_access;
   bool check_extend_symmetry,
-       silent;
+       silent,
+       bitparallel;
   Trimstat *trimstat;
   GtEncseqReader *encseq_r_in_u, *encseq_r_in_v;
   GtAllocatedMemory usequence_cache, vsequence_cache, frontspace_reservoir;
@@ -508,6 +509,7 @@ GtGreedyextendmatchinfo *gt_greedy_extend_matchinfo_new(
   ggemi->extend_char_access = extend_char_access;
   ggemi->check_extend_symmetry = false;
   ggemi->silent = false;
+  ggemi->bitparallel = false;
   ggemi->trimstat = NULL;
   return ggemi;
 }
@@ -547,6 +549,12 @@ void gt_greedy_extend_matchinfo_silent_set(GtGreedyextendmatchinfo *ggemi)
   ggemi->silent = true;
 }
 
+void gt_greedy_extend_matchinfo_bitparallel_set(GtGreedyextendmatchinfo *ggemi)
+{
+  gt_assert(ggemi != NULL);
+  ggemi->bitparallel = true;
+}
+
 void gt_greedy_extend_matchinfo_trimstat_set(GtGreedyextendmatchinfo *ggemi)
 {
   gt_assert(ggemi != NULL && ggemi->perc_mat_history > 0 &&
@@ -693,7 +701,7 @@ void gt_align_front_prune_edist(bool rightextension,
     {
       trimstrategy = ggemi->trimstrategy;
     }
-    gt_assert(iteration < ggemi->perc_mat_history);
+    gt_assert(iteration <= ggemi->perc_mat_history);
     distance = front_prune_edist_inplace(rightextension,
                                          &ggemi->frontspace_reservoir,
                                          NULL, /* trimstat */
@@ -948,28 +956,50 @@ static const GtQuerymatch *gt_extend_sesp(bool forxdrop,
                                     xdropmatchinfo->belowscore);
     } else
     {
-      (void) front_prune_edist_inplace(!rightextension,
-                                       &greedyextendmatchinfo->
-                                          frontspace_reservoir,
-                                       greedyextendmatchinfo->trimstat,
-                                       &left_best_polished_point,
-                                       greedyextendmatchinfo->left_front_trace,
-                                       greedyextendmatchinfo->pol_info,
-                                       greedyextendmatchinfo->trimstrategy,
-                                       greedyextendmatchinfo->history,
-                                       greedyextendmatchinfo->perc_mat_history,
-                                       greedyextendmatchinfo->
+      if (greedyextendmatchinfo->bitparallel)
+      {
+        (void) bitparallel_extend_edist(!rightextension,
+                                        &left_best_polished_point,
+                                        greedyextendmatchinfo->errorpercentage,
+                                        greedyextendmatchinfo->history,
+                                        greedyextendmatchinfo->perc_mat_history,
+                                        greedyextendmatchinfo->
                                           maxalignedlendifference,
-                                       greedyextendmatchinfo->showfrontinfo,
-                                       sesp->seedlen,
-                                       &ufsr,
-                                       uoffset,
-                                       ulen,
-                                       (query == NULL || query->seq != NULL)
-                                         ? 0 : sesp->queryseqstartpos,
-                                       &vfsr,
-                                       voffset,
-                                       vlen);
+                                        &ufsr,
+                                        uoffset,
+                                        ulen,
+                                        (query == NULL || query->seq != NULL)
+                                          ? 0 : sesp->queryseqstartpos,
+                                        &vfsr,
+                                        voffset,
+                                        vlen);
+      } else
+      {
+        (void) front_prune_edist_inplace(!rightextension,
+                                         &greedyextendmatchinfo->
+                                            frontspace_reservoir,
+                                         greedyextendmatchinfo->trimstat,
+                                         &left_best_polished_point,
+                                         greedyextendmatchinfo->
+                                            left_front_trace,
+                                         greedyextendmatchinfo->pol_info,
+                                         greedyextendmatchinfo->trimstrategy,
+                                         greedyextendmatchinfo->history,
+                                         greedyextendmatchinfo->
+                                            perc_mat_history,
+                                         greedyextendmatchinfo->
+                                            maxalignedlendifference,
+                                         greedyextendmatchinfo->showfrontinfo,
+                                         sesp->seedlen,
+                                         &ufsr,
+                                         uoffset,
+                                         ulen,
+                                         (query == NULL || query->seq != NULL)
+                                           ? 0 : sesp->queryseqstartpos,
+                                         &vfsr,
+                                         voffset,
+                                         vlen);
+      }
     }
   } else
   {
@@ -1052,28 +1082,50 @@ static const GtQuerymatch *gt_extend_sesp(bool forxdrop,
                                     xdropmatchinfo->belowscore);
     } else
     {
-      (void) front_prune_edist_inplace(rightextension,
-                                       &greedyextendmatchinfo->
-                                          frontspace_reservoir,
-                                       greedyextendmatchinfo->trimstat,
-                                       &right_best_polished_point,
-                                       greedyextendmatchinfo->right_front_trace,
-                                       greedyextendmatchinfo->pol_info,
-                                       greedyextendmatchinfo->trimstrategy,
-                                       greedyextendmatchinfo->history,
-                                       greedyextendmatchinfo->perc_mat_history,
-                                       greedyextendmatchinfo->
+      if (greedyextendmatchinfo->bitparallel)
+      {
+        (void) bitparallel_extend_edist(rightextension,
+                                        &right_best_polished_point,
+                                        greedyextendmatchinfo->errorpercentage,
+                                        greedyextendmatchinfo->history,
+                                        greedyextendmatchinfo->perc_mat_history,
+                                        greedyextendmatchinfo->
                                           maxalignedlendifference,
-                                       greedyextendmatchinfo->showfrontinfo,
-                                       sesp->seedlen,
-                                       &ufsr,
-                                       sesp->seedpos1 + sesp->seedlen,
-                                       ulen,
-                                       (query == NULL || query->seq != NULL)
-                                         ? 0 : sesp->queryseqstartpos,
-                                       &vfsr,
-                                       sesp->seedpos2 + sesp->seedlen,
-                                       vlen);
+                                        &ufsr,
+                                        sesp->seedpos1 + sesp->seedlen,
+                                        ulen,
+                                        (query == NULL || query->seq != NULL)
+                                          ? 0 : sesp->queryseqstartpos,
+                                        &vfsr,
+                                        sesp->seedpos2 + sesp->seedlen,
+                                        vlen);
+      } else
+      {
+        (void) front_prune_edist_inplace(rightextension,
+                                         &greedyextendmatchinfo->
+                                            frontspace_reservoir,
+                                         greedyextendmatchinfo->trimstat,
+                                         &right_best_polished_point,
+                                         greedyextendmatchinfo->
+                                            right_front_trace,
+                                         greedyextendmatchinfo->pol_info,
+                                         greedyextendmatchinfo->trimstrategy,
+                                         greedyextendmatchinfo->history,
+                                         greedyextendmatchinfo->
+                                            perc_mat_history,
+                                         greedyextendmatchinfo->
+                                            maxalignedlendifference,
+                                         greedyextendmatchinfo->showfrontinfo,
+                                         sesp->seedlen,
+                                         &ufsr,
+                                         sesp->seedpos1 + sesp->seedlen,
+                                         ulen,
+                                         (query == NULL || query->seq != NULL)
+                                           ? 0 : sesp->queryseqstartpos,
+                                         &vfsr,
+                                         sesp->seedpos2 + sesp->seedlen,
+                                         vlen);
+      }
     }
   } else
   {
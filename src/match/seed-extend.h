@@ -229,6 +229,12 @@ void gt_greedy_extend_matchinfo_check_extend_symmetry_set(
 
 void gt_greedy_extend_matchinfo_silent_set(GtGreedyextendmatchinfo *ggemi);
 
+/* Let the matchinfo object extend seeds with the bit-parallel edit distance
+   computation (see <bitparallel_extend_edist>) instead of the greedy
+   front algorithm. */
+
+void gt_greedy_extend_matchinfo_bitparallel_set(GtGreedyextendmatchinfo *ggemi);
+
 /* Set the trimstat in the matchinfo object. */
 
 void gt_greedy_extend_matchinfo_trimstat_set(GtGreedyextendmatchinfo *ggemi);
@@ -36,7 +36,7 @@
 #include "sfx-suffixgetset.h"
 #include "sfx-shortreadsort.h"
 #ifdef GT_THREADS_ENABLED
-#include "core/thread_api.h"
+#include "core/thread_pool.h"
 #endif
 
 #define ACCESSCHARRAND(POS)    gt_encseq_get_encoded_char(bsr->encseq,\
@@ -1655,7 +1655,6 @@ typedef struct
   GtUword totalwidth;
   GtBentsedgresources *bsr;
   unsigned int thread_num;
-  GtThread *thread;
 } GtBentsedg_partition_thread_info;
 
 static void *gt_bentsedg_partition_thread_caller(void *data)
@@ -1699,16 +1698,17 @@ void gt_threaded_partition_sortallbuckets(GtSuffixsortspace *suffixsortspace,
                        GtLogger *logger)
 {
   unsigned int tp, thread_parts;
-  bool haserr = false;
   GtBentsedg_partition_thread_info *th_tab;
   GtSuffixsortspace **sssp_tab;
+  GtTaskGroup *group;
 
   gt_assert(partition_for_threads != NULL);
   thread_parts = gt_suftabparts_numofparts(partition_for_threads);
   gt_assert(thread_parts > 1U);
   th_tab = gt_malloc(sizeof *th_tab * thread_parts);
   sssp_tab = gt_malloc(sizeof *sssp_tab * thread_parts);
-  for (tp = 0; !haserr && tp < thread_parts; tp++)
+  group = gt_task_group_new(gt_thread_pool_get());
+  for (tp = 0; tp < thread_parts; tp++)
   {
     th_tab[tp].thread_num = tp;
     th_tab[tp].numofchars = numofchars;
@@ -1736,21 +1736,11 @@ void gt_threaded_partition_sortallbuckets(GtSuffixsortspace *suffixsortspace,
       = processunsortedsuffixrange;
     th_tab[tp].bsr->processunsortedsuffixrangeinfo
       = processunsortedsuffixrangeinfo;
-    th_tab[tp].thread
-      = gt_thread_new (gt_bentsedg_partition_thread_caller,th_tab + tp,NULL);
-    if (th_tab[tp].thread == NULL)
-    {
-      haserr = true;
-    }
-  }
-  for (tp = 0; tp < thread_parts; tp++)
-  {
-    if (!haserr)
-    {
-      gt_thread_join(th_tab[tp].thread);
-    }
-    gt_thread_delete(th_tab[tp].thread);
+    gt_task_group_submit(group,gt_bentsedg_partition_thread_caller,
+                         th_tab + tp);
   }
+  gt_task_group_join(group);
+  gt_task_group_delete(group);
   for (tp = 0; tp < thread_parts; tp++)
   {
     bentsedgresources_delete(th_tab[tp].bsr, logger);
@@ -1758,7 +1748,6 @@ void gt_threaded_partition_sortallbuckets(GtSuffixsortspace *suffixsortspace,
   gt_suffixsortspace_delete_cloned(sssp_tab,thread_parts);
   gt_free(sssp_tab);
   gt_free(th_tab);
-  gt_assert(!haserr);
 }
 #else
 
@@ -1768,6 +1757,7 @@ typedef struct
   const GtBcktab *bcktab;
   GtCodetype code, mincode, maxcode;
   unsigned int rightchar;
+  GtUint64 *bucketiterstep;
   GtMutex *mutex;
 } GtBentsedgIterator;
 
@@ -1775,7 +1765,8 @@ static GtBentsedgIterator *gt_BentsedgIterator_new(GtCodetype mincode,
                                                    GtCodetype maxcode,
                                                    GtUword totalwidth,
                                                    unsigned int numofchars,
-                                                   const GtBcktab *bcktab)
+                                                   const GtBcktab *bcktab,
+                                                   GtUint64 *bucketiterstep)
 {
   GtBentsedgIterator *bentsedg_iterator = gt_malloc(sizeof *bentsedg_iterator);
 
@@ -1786,11 +1777,13 @@ static GtBentsedgIterator *gt_BentsedgIterator_new(GtCodetype mincode,
   bentsedg_iterator->rightchar = (unsigned int) (mincode % numofchars);
   bentsedg_iterator->bcktab = bcktab;
   bentsedg_iterator->bucketnumber = 0;
+  bentsedg_iterator->bucketiterstep = bucketiterstep;
   bentsedg_iterator->mutex = gt_mutex_new();
   return bentsedg_iterator;
 }
 
 static bool gt_BentsedgIterator_next(GtBucketspecification *bucketspec,
+                                     GtCodetype *code,
                                      GtBentsedgIterator *bs_it)
 {
   if (bs_it->code <= bs_it->maxcode)
@@ -1801,7 +1794,11 @@ static bool gt_BentsedgIterator_next(GtBucketspecification *bucketspec,
                                                  bs_it->maxcode,
                                                  bs_it->totalwidth,
                                                  bs_it->rightchar);
-    bs_it->code++;
+    *code = bs_it->code++;
+    if (bs_it->bucketiterstep != NULL)
+    {
+      (*bs_it->bucketiterstep)++;
+    }
     return true;
   } else
   {
@@ -1818,127 +1815,77 @@ static void gt_BentsedgIterator_delete(GtBentsedgIterator *bs_it)
   }
 }
 
+/* The lcp-values of a bucket depend on the last suffix of the previous
+   bucket, and the .lcp and .llv files are written sequentially. Hence the
+   buckets are sorted in any order, but the lcp-values of the sorted buckets
+   are processed in the order of the bucket numbers: a thread which has
+   sorted bucket <i> waits until <nextrequest> equals <i>. */
 typedef struct
 {
-  GtUword bucketnumber;
-} GtPriorecord;
-
-typedef struct
-{
-  GtUword capacity, numofelements;
-  GtPriorecord *elements;
-} GtBentsedgePrioqueue;
-
-static GtBentsedgePrioqueue *gt_bs_priority_queue_new(GtUword numofelements)
-{
-  GtBentsedgePrioqueue *pq = gt_malloc(sizeof *pq);
-
-  pq->elements = gt_malloc(sizeof (*pq->elements) * numofelements);
-  pq->capacity = numofelements;
-  pq->numofelements = 0;
-  return pq;
-}
-
-static bool gt_bs_priority_queue_is_empty(const GtBentsedgePrioqueue *pq)
-{
-  gt_assert(pq != NULL);
-  return pq->numofelements == 0 ? true : false;
-}
-
-static void gt_bs_priority_queue_add(GtBentsedgePrioqueue *pq,
-                                     GtPriorecord priorecord)
-{
-  GtPriorecord *ptr;
-
-  gt_assert(pq != NULL);
-  if (pq->numofelements >= pq->capacity)
-  {
-    pq->capacity *= 2;
-    pq->elements = gt_realloc(pq->elements,sizeof *pq->elements * pq->capacity);
-  }
-  /* store elements in reverse order, i.e.\ with the minimum element
-     at the last index; shift elements to the right until an element larger
-     or equal than the key is found. */
-  for (ptr = pq->elements + pq->numofelements;
-       ptr > pq->elements && (ptr-1)->bucketnumber < priorecord.bucketnumber;
-       ptr--)
-  {
-    *ptr = *(ptr-1);
-  }
-  pq->numofelements++;
-  gt_assert(ptr >= pq->elements && ptr < pq->elements + pq->numofelements);
-  *ptr = priorecord;
-}
-
-static void gt_bs_priority_queue_delete_min(GtBentsedgePrioqueue *pq)
-{
-  gt_assert(pq != NULL && !gt_bs_priority_queue_is_empty(pq));
-  pq->numofelements--;
-}
-
-const GtUword gt_bs_priority_queue_min_bucketnumber(
-                                              const GtBentsedgePrioqueue *pq)
-{
-  gt_assert(pq != NULL && !gt_bs_priority_queue_is_empty(pq));
-  return pq->elements[pq->numofelements-1].bucketnumber;
-}
-
-static void gt_bs_priority_queue_delete(GtBentsedgePrioqueue *pq)
-{
-  if (pq != NULL)
-  {
-    gt_free(pq->elements);
-    gt_free(pq);
-  }
-}
-
-typedef struct
-{
-  GtBentsedgePrioqueue *queue;
   GtUword nextrequest;
+  GtOutlcpinfo *outlcpinfo;
+  const GtBcktab *bcktab;
   GtMutex *mutex;
+  GtCond *turn;
 } GtBentsedgSynchronizer;
 
-static GtBentsedgSynchronizer *gt_bendsedgSynchronizer_new(void)
+static GtBentsedgSynchronizer *gt_bendsedgSynchronizer_new(
+                                                      GtOutlcpinfo *outlcpinfo,
+                                                      const GtBcktab *bcktab)
 {
   GtBentsedgSynchronizer *bs_sync = gt_malloc(sizeof *bs_sync);
 
-  bs_sync->queue = gt_bs_priority_queue_new(gt_jobs);
   bs_sync->nextrequest = 0;
+  bs_sync->outlcpinfo = outlcpinfo;
+  bs_sync->bcktab = bcktab;
   bs_sync->mutex = gt_mutex_new();
+  bs_sync->turn = gt_cond_new();
   return bs_sync;
 }
 
 static void gt_bendsedgSynchronizer_process(GtBentsedgSynchronizer *bs_sync,
-                                            GtUword bucketnumber)
+                                            GtUword bucketnumber,
+                                            GtCodetype code,
+                                            unsigned int prefixlength,
+                                            const GtSuffixsortspace *sssp,
+                                            GtLcpvalues *tableoflcpvalues,
+                                            const GtBucketspecification
+                                              *bucketspec)
 {
-  gt_assert(bs_sync != NULL);
-  if (bs_sync->nextrequest == bucketnumber)
+  gt_assert(bs_sync != NULL && bs_sync->outlcpinfo != NULL);
+  gt_mutex_lock(bs_sync->mutex);
+  while (bs_sync->nextrequest < bucketnumber)
   {
-    bs_sync->nextrequest++;
-    while (!gt_bs_priority_queue_is_empty(bs_sync->queue) &&
-           gt_bs_priority_queue_min_bucketnumber(bs_sync->queue) ==
-           bs_sync->nextrequest)
-    {
-      gt_bs_priority_queue_delete_min(bs_sync->queue);
-      bs_sync->nextrequest++;
-    }
-  } else
+    gt_cond_wait(bs_sync->turn,bs_sync->mutex);
+  }
+  gt_assert(bs_sync->nextrequest == bucketnumber);
+  gt_Outlcpinfo_prebucket(bs_sync->outlcpinfo,code,bucketspec->left);
+  if (bucketspec->nonspecialsinbucket > 0)
   {
-    GtPriorecord priorecord;
-    gt_assert(bs_sync->nextrequest < bucketnumber);
-    priorecord.bucketnumber = bucketnumber;
-    gt_bs_priority_queue_add(bs_sync->queue,priorecord);
+    gt_Outlcpinfo_nonspecialsbucket(bs_sync->outlcpinfo,
+                                    prefixlength,
+                                    sssp,
+                                    tableoflcpvalues,
+                                    bucketspec,
+                                    code);
   }
+  gt_Outlcpinfo_postbucket(bs_sync->outlcpinfo,
+                           prefixlength,
+                           sssp,
+                           bs_sync->bcktab,
+                           bucketspec,
+                           code);
+  bs_sync->nextrequest++;
+  gt_cond_broadcast(bs_sync->turn);
+  gt_mutex_unlock(bs_sync->mutex);
 }
 
 static void gt_bendsedgSynchronizer_delete(GtBentsedgSynchronizer *bs_sync)
 {
   if (bs_sync != NULL)
   {
-    gt_assert(gt_bs_priority_queue_is_empty(bs_sync->queue));
+    gt_cond_delete(bs_sync->turn);
     gt_mutex_delete(bs_sync->mutex);
-    gt_bs_priority_queue_delete(bs_sync->queue);
     gt_free(bs_sync);
   }
 }
@@ -1947,9 +1894,11 @@ typedef struct
 {
   GtBentsedgresources *bsr;
   unsigned int prefixlength, thread_num;
+  GtLcpvalues *tableoflcpvalues; /* private to the thread, NULL if the
+                                    lcp-values are not required */
   GtBentsedgIterator *bs_it; /* shared, _next-function needs a mutex */
-  GtBentsedgSynchronizer *bs_sync; /* shared _process-function needs a mutex */
-  GtThread *thread;
+  GtBentsedgSynchronizer *bs_sync; /* shared, NULL if the lcp-values are not
+                                      required */
 } GtBentsedg_stream_thread_info;
 
 static void *gt_bentsedg_stream_thread_caller(void *data)
@@ -1960,29 +1909,46 @@ static void *gt_bentsedg_stream_thread_caller(void *data)
   while (true)
   {
     GtBucketspecification bucketspec;
+    GtCodetype code;
     GtUword bucketnumber;
 
     gt_mutex_lock(thinfo->bs_it->mutex);
-    if (!gt_BentsedgIterator_next(&bucketspec,thinfo->bs_it))
+    if (!gt_BentsedgIterator_next(&bucketspec,&code,thinfo->bs_it))
     {
       gt_mutex_unlock(thinfo->bs_it->mutex);
       break;
     }
     bucketnumber = thinfo->bs_it->bucketnumber++;
     gt_mutex_unlock(thinfo->bs_it->mutex);
+    if (thinfo->tableoflcpvalues != NULL)
+    {
+      thinfo->tableoflcpvalues->numoflargelcpvalues = 0;
+    }
     if (bucketspec.nonspecialsinbucket > 1UL)
     {
       gt_sort_bentleysedgewick(thinfo->bsr,bucketspec.left,
                                bucketspec.nonspecialsinbucket,
                                (GtUword) thinfo->prefixlength);
     }
-    gt_mutex_lock(thinfo->bs_sync->mutex);
-    gt_bendsedgSynchronizer_process(thinfo->bs_sync,bucketnumber);
-    gt_mutex_unlock(thinfo->bs_sync->mutex);
+    if (thinfo->bs_sync != NULL)
+    {
+      gt_bendsedgSynchronizer_process(thinfo->bs_sync,
+                                      bucketnumber,
+                                      code,
+                                      thinfo->prefixlength,
+                                      thinfo->bsr->sssp,
+                                      thinfo->tableoflcpvalues,
+                                      &bucketspec);
+    }
   }
   return NULL;
 }
 
+/* Sort the buckets with codes from <mincode> to <maxcode> with <gt_jobs>
+   tasks, each of which repeatedly takes the next unsorted bucket from a
+   shared iterator. The result does not depend on the number of jobs. If
+   <outlcpinfo> is not NULL, then the lcp-values are computed and output
+   exactly as in <gt_sortallbuckets>. */
 void gt_threaded_stream_sortallbuckets(GtSuffixsortspace *suffixsortspace,
                        const GtEncseq *encseq,
                        GtReadmode readmode,
@@ -1992,25 +1958,37 @@ void gt_threaded_stream_sortallbuckets(GtSuffixsortspace *suffixsortspace,
                        GtUword sumofwidth,
                        unsigned int numofchars,
                        unsigned int prefixlength,
+                       GtOutlcpinfo *outlcpinfo,
                        unsigned int sortmaxdepth,
                        const Sfxstrategy *sfxstrategy,
                        GtProcessunsortedsuffixrange processunsortedsuffixrange,
                        void *processunsortedsuffixrangeinfo,
+                       GtUint64 *bucketiterstep,
                        GtLogger *logger)
 {
   GtBentsedgIterator *bs_it;
-  GtBentsedgSynchronizer *bs_sync;
+  GtBentsedgSynchronizer *bs_sync = NULL;
   unsigned int tp;
-  bool haserr = false;
   GtBentsedg_stream_thread_info *th_tab;
   GtSuffixsortspace **sssp_tab;
+  GtTaskGroup *group;
 
   gt_assert(gt_jobs > 1U);
   th_tab = gt_malloc(sizeof *th_tab * gt_jobs);
   sssp_tab = gt_malloc(sizeof *sssp_tab * gt_jobs);
-  bs_it = gt_BentsedgIterator_new(mincode,maxcode,sumofwidth,numofchars,bcktab);
-  bs_sync = gt_bendsedgSynchronizer_new();
-  for (tp = 0; !haserr && tp < gt_jobs; tp++)
+  bs_it = gt_BentsedgIterator_new(mincode,maxcode,sumofwidth,numofchars,bcktab,
+                                  bucketiterstep);
+  if (outlcpinfo != NULL)
+  {
+    /* the reservoir is still needed for the lcp-values of the specials
+       and for the buffer of the small lcp-values written to file */
+    (void) gt_Outlcpinfo_resizereservoir(outlcpinfo,bcktab);
+    bs_sync = gt_bendsedgSynchronizer_new(outlcpinfo,bcktab);
+  }
+  /* each task takes buckets from the shared iterator until it is exhausted,
+     so the tasks need their own sort resources but not one thread each */
+  group = gt_task_group_new(gt_thread_pool_get());
+  for (tp = 0; tp < gt_jobs; tp++)
   {
     th_tab[tp].thread_num = tp;
     th_tab[tp].prefixlength = prefixlength;
@@ -2028,38 +2006,41 @@ void gt_threaded_stream_sortallbuckets(GtSuffixsortspace *suffixsortspace,
                                            bcktab,
                                            sortmaxdepth,
                                            sfxstrategy,
-                                           false);
+                                           outlcpinfo != NULL ? true : false);
+    if (outlcpinfo != NULL)
+    {
+      th_tab[tp].tableoflcpvalues
+        = gt_lcpvalues_new(gt_bcktab_maxbucketsize(bcktab));
+      th_tab[tp].bsr->tableoflcpvalues = th_tab[tp].tableoflcpvalues;
+      if (th_tab[tp].bsr->srsw != NULL)
+      {
+        gt_shortreadsort_assigntableoflcpvalues(th_tab[tp].bsr->srsw,
+                                                th_tab[tp].tableoflcpvalues);
+      }
+    } else
+    {
+      th_tab[tp].tableoflcpvalues = NULL;
+    }
     th_tab[tp].bsr->processunsortedsuffixrange
       = processunsortedsuffixrange;
     th_tab[tp].bsr->processunsortedsuffixrangeinfo
       = processunsortedsuffixrangeinfo;
     th_tab[tp].bs_it = bs_it;
     th_tab[tp].bs_sync = bs_sync;
-    th_tab[tp].thread
-      = gt_thread_new (gt_bentsedg_stream_thread_caller,th_tab + tp,NULL);
-    if (th_tab[tp].thread == NULL)
-    {
-      haserr = true;
-    }
-  }
-  for (tp = 0; tp < gt_jobs; tp++)
-  {
-    if (!haserr)
-    {
-      gt_thread_join(th_tab[tp].thread);
-    }
-    gt_thread_delete(th_tab[tp].thread);
+    gt_task_group_submit(group,gt_bentsedg_stream_thread_caller,th_tab + tp);
   }
+  gt_task_group_join(group);
+  gt_task_group_delete(group);
   for (tp = 0; tp < gt_jobs; tp++)
   {
     bentsedgresources_delete(th_tab[tp].bsr, logger);
+    gt_lcpvalues_delete(th_tab[tp].tableoflcpvalues);
   }
   gt_suffixsortspace_delete_cloned(sssp_tab,gt_jobs);
   gt_BentsedgIterator_delete(bs_it);
   gt_bendsedgSynchronizer_delete(bs_sync);
   gt_free(sssp_tab);
   gt_free(th_tab);
-  gt_assert(!haserr);
 }
 #endif
 #endif
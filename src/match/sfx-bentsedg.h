@@ -94,10 +94,12 @@ void gt_threaded_stream_sortallbuckets(GtSuffixsortspace *suffixsortspace,
                        GtUword sumofwidth,
                        unsigned int numofchars,
                        unsigned int prefixlength,
+                       GtOutlcpinfo *outlcpinfo,
                        unsigned int sortmaxdepth,
                        const Sfxstrategy *sfxstrategy,
                        GtProcessunsortedsuffixrange processunsortedsuffixrange,
                        void *processunsortedsuffixrangeinfo,
+                       GtUint64 *bucketiterstep,
                        GtLogger *logger);
 #endif
 #endif
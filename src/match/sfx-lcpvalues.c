@@ -347,6 +347,33 @@ static size_t gt_tableoflcpvalues_realloc(GtLcpvalues *tableoflcpvalues,
   return 0;
 }
 
+GtLcpvalues *gt_lcpvalues_new(GtUword numofentries)
+{
+  GtLcpvalues *tableoflcpvalues = gt_malloc(sizeof *tableoflcpvalues);
+
+  tableoflcpvalues->bucketoflcpvalues = NULL;
+#ifndef NDEBUG
+  tableoflcpvalues->isset = NULL;
+#endif
+  tableoflcpvalues->numofentries = 0;
+  tableoflcpvalues->numoflargelcpvalues = 0;
+  tableoflcpvalues->lcptaboffset = 0;
+  (void) gt_tableoflcpvalues_realloc(tableoflcpvalues,numofentries);
+  return tableoflcpvalues;
+}
+
+void gt_lcpvalues_delete(GtLcpvalues *tableoflcpvalues)
+{
+  if (tableoflcpvalues != NULL)
+  {
+    gt_free(tableoflcpvalues->bucketoflcpvalues);
+#ifndef NDEBUG
+    gt_free(tableoflcpvalues->isset);
+#endif
+    gt_free(tableoflcpvalues);
+  }
+}
+
 void gt_Outlcpinfo_reinit(GtOutlcpinfo *outlcpinfo,
                           unsigned int numofchars,
                           unsigned int prefixlength,
@@ -369,6 +396,7 @@ void gt_Outlcpinfo_reinit(GtOutlcpinfo *outlcpinfo,
 }
 
 static void outlcpvalues(Lcpsubtab *lcpsubtab,
+                         const GtLcpvalues *tableoflcpvalues,
                          GtUword width,
                          GtUword posoffset)
 {
@@ -377,21 +405,21 @@ static void outlcpvalues(Lcpsubtab *lcpsubtab,
 
   gt_assert(lcpsubtab != NULL && lcpsubtab->lcp2file != NULL);
   lcpsubtab->lcp2file->largelcpvalues.nextfreeLargelcpvalue = 0;
-  if (lcpsubtab->tableoflcpvalues.numoflargelcpvalues > 0 &&
-      lcpsubtab->tableoflcpvalues.numoflargelcpvalues >=
+  if (tableoflcpvalues->numoflargelcpvalues > 0 &&
+      tableoflcpvalues->numoflargelcpvalues >=
       lcpsubtab->lcp2file->largelcpvalues.allocatedLargelcpvalue)
   {
     lcpsubtab->lcp2file->largelcpvalues.spaceLargelcpvalue
       = gt_realloc(lcpsubtab->lcp2file->largelcpvalues.spaceLargelcpvalue,
                    sizeof (*lcpsubtab->lcp2file->largelcpvalues.
                            spaceLargelcpvalue) *
-                   lcpsubtab->tableoflcpvalues.numoflargelcpvalues);
+                   tableoflcpvalues->numoflargelcpvalues);
     lcpsubtab->lcp2file->largelcpvalues.allocatedLargelcpvalue
-      = lcpsubtab->tableoflcpvalues.numoflargelcpvalues;
+      = tableoflcpvalues->numoflargelcpvalues;
   }
   for (idx=0; idx<width; idx++)
   {
-    lcpvalue = gt_lcptab_getvalue(&lcpsubtab->tableoflcpvalues,0,idx);
+    lcpvalue = gt_lcptab_getvalue(tableoflcpvalues,0,idx);
     if (lcpsubtab->lcp2file->maxbranchdepth < lcpvalue)
     {
       lcpsubtab->lcp2file->maxbranchdepth = lcpvalue;
@@ -660,6 +688,7 @@ void gt_Outlcpinfo_nonspecialsbucket(GtOutlcpinfo *outlcpinfo,
     if (outlcpinfo->lcpsubtab.lcp2file != NULL)
     {
       outlcpvalues(&outlcpinfo->lcpsubtab,
+                   tableoflcpvalues,
                    bucketspec->nonspecialsinbucket,
                    bucketspec->left);
     } else
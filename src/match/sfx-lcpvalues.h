@@ -99,6 +99,12 @@ typedef void (*GtFinalProcessBucket)(void *,
 const GtLcpvaluetype *gt_lcptab_getptr(const GtLcpvalues *tableoflcpvalues,
                                        GtUword subbucketleft);
 
+/* Return a table for <numofentries> lcp-values, to be used as private
+   workspace when the buckets are sorted by more than one thread. */
+GtLcpvalues *gt_lcpvalues_new(GtUword numofentries);
+
+void gt_lcpvalues_delete(GtLcpvalues *tableoflcpvalues);
+
 GtOutlcpinfo *gt_Outlcpinfo_new(const char *indexname,
                                 unsigned int numofchars,
                                 unsigned int prefixlength,
@@ -0,0 +1,330 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "core/arraydef.h"
+#include "core/chardef.h"
+#include "core/encseq.h"
+#include "core/fa.h"
+#include "core/ma_api.h"
+#include "core/minmax.h"
+#include "core/str_api.h"
+#include "core/thread_pool.h"
+#include "core/xansi_api.h"
+#include "esa-fileend.h"
+#include "esa-map.h"
+#include "lcpoverflow.h"
+#include "sarr-def.h"
+#include "sfx-outprj.h"
+#include "sfx-philcp.h"
+
+GT_DECLAREARRAYSTRUCT(Largelcpvalue);
+
+#define GT_PHILCP_UNDEF      GT_UWORD_MAX
+#define GT_PHILCP_MINWIDTH   ((GtUword) 1 << 10)
+#define GT_PHILCP_GRAINSIZE  ((GtUword) 1 << 16)
+#define GT_PHILCP_ZEROBUFFER 4096
+
+typedef struct
+{
+  const GtEncseq *encseq;
+  GtReadmode readmode;
+  GtUword totallength, rangestart, *phitab;
+} GtPhilcpinfo;
+
+static void gt_philcp_suftab_rewind(Suffixarray *suffixarray)
+{
+#if defined (_LP64) || defined (_WIN64)
+  if (suffixarray->suftabstream_GtUword.fp == NULL)
+  {
+    rewind(suffixarray->suftabstream_uint32_t.fp);
+    suffixarray->suftabstream_uint32_t.nextread = 0;
+    suffixarray->suftabstream_uint32_t.nextfree = 0;
+    return;
+  }
+#endif
+  rewind(suffixarray->suftabstream_GtUword.fp);
+  suffixarray->suftabstream_GtUword.nextread = 0;
+  suffixarray->suftabstream_GtUword.nextfree = 0;
+}
+
+static GtUword gt_philcp_suftab_next(Suffixarray *suffixarray)
+{
+  GtUword value = 0;
+  GT_UNUSED int retval;
+
+#if defined (_LP64) || defined (_WIN64)
+  if (suffixarray->suftabstream_GtUword.fp == NULL)
+  {
+    uint32_t readvalue = 0;
+
+    retval = gt_readnextfromstream_uint32_t(&readvalue,
+                                          &suffixarray->suftabstream_uint32_t);
+    gt_assert(retval == 1);
+    return (GtUword) readvalue;
+  }
+#endif
+  retval = gt_readnextfromstream_GtUword(&value,
+                                         &suffixarray->suftabstream_GtUword);
+  gt_assert(retval == 1);
+  return value;
+}
+
+/* replace the phi-values of the positions <rangestart> + [<start>,<end>) by
+   the lcp-values of the suffixes at these positions and their predecessors
+   in the suffix array. The lcp-value of a position is at least the
+   lcp-value of the preceding position minus 1, so each part starts with 0
+   and from then on only extends the previous value. */
+static void gt_philcp_plcp(GtUword start, GtUword end, void *data)
+{
+  const GtPhilcpinfo *info = data;
+  GtUword idx, lcpvalue = 0;
+
+  for (idx = start; idx < end; idx++)
+  {
+    const GtUword pos = info->rangestart + idx,
+                  previous = info->phitab[idx];
+
+    if (previous != GT_PHILCP_UNDEF)
+    {
+      const GtUword lastoffset = info->totallength - MAX(pos,previous);
+
+      while (lcpvalue < lastoffset)
+      {
+        GtUchar cc1 = gt_encseq_get_encoded_char(info->encseq,pos + lcpvalue,
+                                                 info->readmode),
+                cc2 = gt_encseq_get_encoded_char(info->encseq,
+                                                 previous + lcpvalue,
+                                                 info->readmode);
+        if (cc1 != cc2 || ISSPECIAL(cc1))
+        {
+          break;
+        }
+        lcpvalue++;
+      }
+      info->phitab[idx] = lcpvalue;
+      if (lcpvalue > 0)
+      {
+        lcpvalue--;
+      }
+    } else
+    {
+      info->phitab[idx] = 0;
+      lcpvalue = 0;
+    }
+  }
+}
+
+static int gt_philcp_zerofile(const char *indexname,
+                              GtUword numofentries,
+                              GtError *err)
+{
+  uint8_t zeros[GT_PHILCP_ZEROBUFFER] = {0};
+  FILE *fp = gt_fa_fopen_with_suffix(indexname,GT_LCPTABSUFFIX,"wb",err);
+
+  if (fp == NULL)
+  {
+    return -1;
+  }
+  while (numofentries > 0)
+  {
+    size_t width = (size_t) MIN(numofentries,(GtUword) GT_PHILCP_ZEROBUFFER);
+
+    gt_xfwrite(zeros,sizeof *zeros,width,fp);
+    numofentries -= (GtUword) width;
+  }
+  gt_fa_fclose(fp);
+  return 0;
+}
+
+static int gt_philcp_compare_largelcpvalue(const void *a,const void *b)
+{
+  const Largelcpvalue *va = a, *vb = b;
+
+  if (va->position < vb->position)
+  {
+    return -1;
+  }
+  return va->position > vb->position ? 1 : 0;
+}
+
+int gt_lcptab_phi_fromfile(const char *indexname,
+                           GtUword maximumspace,
+                           GtLogger *logger,
+                           GtError *err)
+{
+  bool haserr = false;
+  Suffixarray suffixarray;
+  GtArrayLargelcpvalue largelcpvalues;
+  GtPhilcpinfo info;
+  GtUword numofentries = 0, width = 0, maxbranchdepth = 0;
+  double lcptabsum = 0.0;
+  uint8_t *lcptab = NULL;
+  GtStr *lcpfilename = NULL;
+
+  gt_error_check(err);
+  if (streamsuffixarray(&suffixarray,SARR_ESQTAB | SARR_SUFTAB,indexname,
+                        logger,err) != 0)
+  {
+    return -1;
+  }
+  GT_INITARRAY(&largelcpvalues,Largelcpvalue);
+  info.phitab = NULL;
+  info.encseq = suffixarray.encseq;
+  info.readmode = suffixarray.readmode;
+  info.totallength = gt_encseq_total_length(suffixarray.encseq);
+  numofentries = info.totallength + 1;
+  if (suffixarray.numberofallsortedsuffixes != numofentries)
+  {
+    gt_error_set(err,"index %s does not contain all "GT_WU" suffixes",
+                 indexname,numofentries);
+    haserr = true;
+  }
+  if (!haserr && gt_philcp_zerofile(indexname,numofentries,err) != 0)
+  {
+    haserr = true;
+  }
+  if (!haserr)
+  {
+    size_t lcpfilesize;
+
+    lcpfilename = gt_str_new_cstr(indexname);
+    gt_str_append_cstr(lcpfilename,GT_LCPTABSUFFIX);
+    lcptab = gt_fa_mmap_write(gt_str_get(lcpfilename),&lcpfilesize,err);
+    if (lcptab == NULL)
+    {
+      haserr = true;
+    } else
+    {
+      gt_assert(lcpfilesize == (size_t) numofentries);
+    }
+  }
+  if (!haserr)
+  {
+    if (maximumspace == 0)
+    {
+      width = numofentries;
+    } else
+    {
+      width = MIN(numofentries,
+                  MAX(maximumspace/sizeof *info.phitab,GT_PHILCP_MINWIDTH));
+    }
+    info.phitab = gt_malloc(sizeof *info.phitab * width);
+    gt_logger_log(logger,"compute lcp values for ranges of "GT_WU
+                  " positions",width);
+  }
+  for (info.rangestart = 0;
+       !haserr && info.rangestart < numofentries;
+       info.rangestart += width)
+  {
+    const GtUword rangewidth = MIN(width,numofentries - info.rangestart);
+    GtUword idx, previous = GT_PHILCP_UNDEF;
+
+    for (idx = 0; idx < rangewidth; idx++)
+    {
+      info.phitab[idx] = GT_PHILCP_UNDEF;
+    }
+    for (idx = 0; idx < numofentries; idx++)
+    {
+      const GtUword pos = gt_philcp_suftab_next(&suffixarray);
+
+      if (pos >= info.rangestart && pos - info.rangestart < rangewidth)
+      {
+        info.phitab[pos - info.rangestart] = previous;
+      }
+      previous = pos;
+    }
+    gt_philcp_suftab_rewind(&suffixarray);
+    gt_thread_pool_parallel_for(gt_thread_pool_get(),0,rangewidth,
+                                GT_PHILCP_GRAINSIZE,gt_philcp_plcp,&info);
+    for (idx = 0; idx < numofentries; idx++)
+    {
+      const GtUword pos = gt_philcp_suftab_next(&suffixarray);
+
+      if (pos >= info.rangestart && pos - info.rangestart < rangewidth)
+      {
+        const GtUword lcpvalue = info.phitab[pos - info.rangestart];
+
+        if (lcpvalue < (GtUword) LCPOVERFLOW)
+        {
+          lcptab[idx] = (uint8_t) lcpvalue;
+        } else
+        {
+          Largelcpvalue *largelcpvalueptr;
+
+          GT_GETNEXTFREEINARRAY(largelcpvalueptr,&largelcpvalues,
+                                Largelcpvalue,1024);
+          largelcpvalueptr->position = idx;
+          largelcpvalueptr->value = lcpvalue;
+          lcptab[idx] = LCPOVERFLOW;
+        }
+        if (maxbranchdepth < lcpvalue)
+        {
+          maxbranchdepth = lcpvalue;
+        }
+        lcptabsum += (double) lcpvalue;
+      }
+    }
+    gt_philcp_suftab_rewind(&suffixarray);
+  }
+  gt_free(info.phitab);
+  if (lcptab != NULL)
+  {
+    gt_fa_xmunmap(lcptab);
+  }
+  if (!haserr)
+  {
+    FILE *outfpllvtab = gt_fa_fopen_with_suffix(indexname,
+                                                GT_LARGELCPTABSUFFIX,"wb",err);
+    if (outfpllvtab == NULL)
+    {
+      haserr = true;
+    } else
+    {
+      if (largelcpvalues.nextfreeLargelcpvalue > 0)
+      {
+        qsort(largelcpvalues.spaceLargelcpvalue,
+              (size_t) largelcpvalues.nextfreeLargelcpvalue,
+              sizeof *largelcpvalues.spaceLargelcpvalue,
+              gt_philcp_compare_largelcpvalue);
+        gt_xfwrite(largelcpvalues.spaceLargelcpvalue,
+                   sizeof *largelcpvalues.spaceLargelcpvalue,
+                   (size_t) largelcpvalues.nextfreeLargelcpvalue,
+                   outfpllvtab);
+      }
+      gt_fa_fclose(outfpllvtab);
+    }
+  }
+  if (!haserr && gt_outprjfile(indexname,
+                               suffixarray.readmode,
+                               suffixarray.encseq,
+                               suffixarray.numberofallsortedsuffixes,
+                               suffixarray.prefixlength,
+                               largelcpvalues.nextfreeLargelcpvalue,
+                               lcptabsum/suffixarray.numberofallsortedsuffixes,
+                               maxbranchdepth,
+                               &suffixarray.longest,
+                               err) != 0)
+  {
+    haserr = true;
+  }
+  GT_FREEARRAY(&largelcpvalues,Largelcpvalue);
+  gt_str_delete(lcpfilename);
+  gt_freesuffixarray(&suffixarray);
+  return haserr ? -1 : 0;
+}
@@ -0,0 +1,42 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef SFX_PHILCP_H
+#define SFX_PHILCP_H
+
+#include "core/error_api.h"
+#include "core/logger.h"
+#include "core/types_api.h"
+
+/* Compute the lcp table of the enhanced suffix array <indexname> from its
+   encoded sequence and suffix table and write it to the files with suffixes
+   <.lcp> and <.llv>. The project file is rewritten with the corresponding
+   lcp statistics. The lcp values are computed in text order by the
+   phi-algorithm, in parallel with <gt_jobs> threads. The suffix table is not
+   kept in memory, but read from its file twice for each range of text
+   positions processed at once. If <maximumspace> is 0, all positions are
+   processed in a single range. Otherwise the width of the ranges is chosen
+   such that the table of phi-values requires at most <maximumspace> bytes.
+   The small lcp values are written to the memory mapped <.lcp> file, the
+   large lcp values are collected in memory. Returns -1 and sets <err> on
+   error, 0 otherwise. */
+int gt_lcptab_phi_fromfile(const char *indexname,
+                           GtUword maximumspace,
+                           GtLogger *logger,
+                           GtError *err);
+
+#endif
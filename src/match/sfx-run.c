@@ -27,12 +27,15 @@
 #include "core/encseq_metadata.h"
 #include "core/fa.h"
 #include "core/logger.h"
+#include "core/ma_api.h"
 #include "core/readmode.h"
 #include "core/showtime.h"
+#include "core/thread_pool.h"
 #include "core/timer_api.h"
 #include "core/unused_api.h"
 #include "core/xansi_api.h"
 #include "core/mathsupport.h"
+#include "core/minmax.h"
 #include "esa-fileend.h"
 #include "esa-shulen.h"
 #include "giextract.h"
@@ -170,6 +173,42 @@ static int initoutfileinfo(Outfileinfo *outfileinfo,
   return haserr  ? -1 : 0;
 }
 
+typedef struct
+{
+  const GtSuffixsortspace *suffixsortspace;
+  const GtEncseq *encseq;
+  GtReadmode readmode;
+  GtUword offset;
+  GtUchar *buffer;
+} Bwttabfillinfo;
+
+static void bwttab_fill(GtUword start, GtUword end, void *data)
+{
+  Bwttabfillinfo *fillinfo = (Bwttabfillinfo *) data;
+  GtUword idx, startpos;
+
+  for (idx = start; idx < end; idx++)
+  {
+    startpos = gt_suffixsortspace_getdirect(fillinfo->suffixsortspace,
+                                            fillinfo->offset + idx);
+    if (startpos == 0)
+    {
+      fillinfo->buffer[idx] = (GtUchar) UNDEFBWTCHAR;
+    } else
+    {
+      /* Random access */
+      fillinfo->buffer[idx] = gt_encseq_get_encoded_char(fillinfo->encseq,
+                                                         startpos - 1,
+                                                         fillinfo->readmode);
+    }
+  }
+}
+
+/* the bwt-characters are determined by random access to the sequence, so
+   they are computed blockwise in parallel and written by the caller */
+#define GT_BWTTAB_BLOCKSIZE   ((GtUword) 1 << 20)
+#define GT_BWTTAB_GRAINSIZE   ((GtUword) 1 << 14)
+
 static int bwttab2file(Outfileinfo *outfileinfo,
                        const GtSuffixsortspace *suffixsortspace,
                        GtReadmode readmode,
@@ -179,32 +218,27 @@ static int bwttab2file(Outfileinfo *outfileinfo,
   bool haserr = false;
 
   gt_error_check(err);
-  if (outfileinfo->outfpbwttab != NULL)
+  if (outfileinfo->outfpbwttab != NULL && numberofsuffixes > 0)
   {
-    GtUword startpos, pos;
-    GtUchar cc = 0;
-
-    for (pos=0; pos < numberofsuffixes; pos++)
+    Bwttabfillinfo fillinfo;
+
+    fillinfo.suffixsortspace = suffixsortspace;
+    fillinfo.encseq = outfileinfo->encseq;
+    fillinfo.readmode = readmode;
+    fillinfo.buffer = gt_malloc(sizeof (*fillinfo.buffer) *
+                                MIN(numberofsuffixes,GT_BWTTAB_BLOCKSIZE));
+    for (fillinfo.offset = 0; fillinfo.offset < numberofsuffixes;
+         fillinfo.offset += GT_BWTTAB_BLOCKSIZE)
     {
-      startpos = gt_suffixsortspace_getdirect(suffixsortspace,pos);
-      if (startpos == 0)
-      {
-        cc = (GtUchar) UNDEFBWTCHAR;
-      } else
-      {
-        if (outfileinfo->outfpbwttab != NULL)
-        {
-          /* Random access */
-          cc = gt_encseq_get_encoded_char(outfileinfo->encseq,
-                                          startpos - 1,
-                                          readmode);
-        }
-      }
-      if (outfileinfo->outfpbwttab != NULL)
-      {
-        gt_xfwrite(&cc,sizeof (GtUchar),(size_t) 1,outfileinfo->outfpbwttab);
-      }
+      GtUword width = MIN(numberofsuffixes - fillinfo.offset,
+                          GT_BWTTAB_BLOCKSIZE);
+
+      gt_thread_pool_parallel_for(gt_thread_pool_get(),0,width,
+                                  GT_BWTTAB_GRAINSIZE,bwttab_fill,&fillinfo);
+      gt_xfwrite(fillinfo.buffer,sizeof (*fillinfo.buffer),(size_t) width,
+                 outfileinfo->outfpbwttab);
     }
+    gt_free(fillinfo.buffer);
   }
   return haserr ? -1 : 0;
 }
@@ -20,6 +20,8 @@
 #include "core/unused_api.h"
 #include "core/timer_api.h"
 #include "core/mathsupport.h"
+#include "core/thread_api.h"
+#include "core/thread_pool.h"
 #include "sfx-lwcheck.h"
 #include "bare-encseq.h"
 #include "sfx-sain.h"
@@ -67,7 +69,8 @@ typedef struct
   GtReadmode readmode; /* only relevant for encseq and bare_encseq */
   const GtBareEncseq *bare_encseq;
   GtSainSeqtype seqtype;
-  bool bucketfillptrpoints2suftab,
+  bool parallel, /* use the parallel variants of the scans */
+       bucketfillptrpoints2suftab,
        bucketsizepoints2suftab,
        roundtablepoints2suftab;
 } GtSainseq;
@@ -81,6 +84,120 @@ static bool gt_sain_decideforfastmethod(GtUword maxvalue,
          ? true : false;
 }
 
+/* If more than one job is requested, long sequences are processed by the
+   parallel variants of the character counting, the classification of the
+   suffixes and the induction scans. These divide the sequence into <gt_jobs>
+   parts or precompute the characters needed by the induction scans
+   blockwise, and deliver the same suffix array as the sequential variants. */
+
+#define GT_SAIN_PARALLEL_MINLENGTH ((GtUword) 1 << 16)
+#define GT_SAIN_INDUCE_BLOCKSIZE   ((GtUword) 1 << 16)
+#define GT_SAIN_INDUCE_GRAINSIZE   ((GtUword) 1 << 12)
+
+static bool gt_sain_decideforparallel(GtUword len,GtUword numofchars)
+{
+  /* the parallel counting requires <numofchars> counters per part */
+  return gt_jobs > 1U && len >= GT_SAIN_PARALLEL_MINLENGTH &&
+         numofchars * gt_jobs <= len ? true : false;
+}
+
+static GtUword gt_sain_partstart(const GtSainseq *sainseq,GtUword part)
+{
+  return (GtUword) (((GtUint64) sainseq->totallength * part)/gt_jobs);
+}
+
+typedef struct
+{
+  const GtSainseq *sainseq;
+  GtUsainindextype *partcounts, /* <numofchars> counters for each part */
+                   *suftab; /* NULL when counting the Sstar suffixes */
+  GtUword *countSstartype;
+} GtSainPartinfo;
+
+static void gt_sain_countchars_parts(GtUword start,GtUword end,void *data)
+{
+  const GtSainPartinfo *partinfo = (const GtSainPartinfo *) data;
+  const GtSainseq *sainseq = partinfo->sainseq;
+  GtUword part;
+
+  for (part = start; part < end; part++)
+  {
+    GtUsainindextype *count = partinfo->partcounts + part * sainseq->numofchars;
+    GtUword position, partend = gt_sain_partstart(sainseq,part+1);
+
+    for (position = gt_sain_partstart(sainseq,part); position < partend;
+         position++)
+    {
+      if (sainseq->seqtype == GT_SAIN_PLAINSEQ)
+      {
+        count[sainseq->seq.plainseq[position]]++;
+      } else
+      {
+        gt_assert(sainseq->seqtype == GT_SAIN_INTSEQ &&
+                  (GtUword) sainseq->seq.array[position] <
+                  sainseq->numofchars);
+        count[sainseq->seq.array[position]]++;
+      }
+    }
+  }
+}
+
+static void gt_sain_countchars(GtSainseq *sainseq)
+{
+  GtUword charidx;
+
+  gt_assert(sainseq->seqtype == GT_SAIN_PLAINSEQ ||
+            sainseq->seqtype == GT_SAIN_INTSEQ);
+  for (charidx = 0; charidx < sainseq->numofchars; charidx++)
+  {
+    sainseq->bucketsize[charidx] = 0;
+  }
+  if (sainseq->parallel)
+  {
+    GtSainPartinfo partinfo;
+    GtUword part;
+
+    partinfo.sainseq = sainseq;
+    partinfo.partcounts = gt_calloc((size_t) (gt_jobs * sainseq->numofchars),
+                                    sizeof (*partinfo.partcounts));
+    gt_thread_pool_parallel_for(gt_thread_pool_get(),0,(GtUword) gt_jobs,1UL,
+                                gt_sain_countchars_parts,&partinfo);
+    for (part = 0; part < (GtUword) gt_jobs; part++)
+    {
+      const GtUsainindextype *count
+        = partinfo.partcounts + part * sainseq->numofchars;
+
+      for (charidx = 0; charidx < sainseq->numofchars; charidx++)
+      {
+        sainseq->bucketsize[charidx] += count[charidx];
+      }
+    }
+    gt_free(partinfo.partcounts);
+  } else
+  {
+    if (sainseq->seqtype == GT_SAIN_PLAINSEQ)
+    {
+      const GtUchar *cptr;
+
+      for (cptr = sainseq->seq.plainseq;
+           cptr < sainseq->seq.plainseq + sainseq->totallength; cptr++)
+      {
+        sainseq->bucketsize[*cptr]++;
+      }
+    } else
+    {
+      const GtUsainindextype *cptr;
+
+      for (cptr = sainseq->seq.array;
+           cptr < sainseq->seq.array + sainseq->totallength; cptr++)
+      {
+        gt_assert((GtUword) *cptr < sainseq->numofchars);
+        sainseq->bucketsize[*cptr]++;
+      }
+    }
+  }
+}
+
 static void gt_sain_allocate_tmpspace(GtSainseq *sainseq,
                                       GtUword maxvalue,
                                       GtUword len)
@@ -121,7 +238,8 @@ static GtSainseq *gt_sainseq_new_from_encseq(const GtEncseq *encseq,
   sainseq->readmode = readmode;
   sainseq->totallength = gt_encseq_total_length(encseq);
   sainseq->numofchars = (GtUword) gt_encseq_alphabetnumofchars(encseq);
-
+  sainseq->parallel = gt_sain_decideforparallel(sainseq->totallength,
+                                                sainseq->numofchars);
   gt_sain_allocate_tmpspace(sainseq,sainseq->totallength+GT_COMPAREOFFSET,
                                     sainseq->totallength);
   for (idx = 0; idx<sainseq->numofchars; idx++)
@@ -143,7 +261,6 @@ static GtSainseq *gt_sainseq_new_from_encseq(const GtEncseq *encseq,
 static GtSainseq *gt_sainseq_new_from_plainseq(const GtUchar *plainseq,
                                                GtUword len)
 {
-  const GtUchar *cptr;
   GtSainseq *sainseq = (GtSainseq *) gt_malloc(sizeof *sainseq);
 
   sainseq->seqtype = GT_SAIN_PLAINSEQ;
@@ -152,11 +269,9 @@ static GtSainseq *gt_sainseq_new_from_plainseq(const GtUchar *plainseq,
   sainseq->numofchars = UCHAR_MAX+1;
   sainseq->bare_encseq = NULL;
   sainseq->readmode = GT_READMODE_FORWARD;
+  sainseq->parallel = gt_sain_decideforparallel(len,sainseq->numofchars);
   gt_sain_allocate_tmpspace(sainseq,len+1,len);
-  for (cptr = sainseq->seq.plainseq; cptr < sainseq->seq.plainseq + len; cptr++)
-  {
-    sainseq->bucketsize[*cptr]++;
-  }
+  gt_sain_countchars(sainseq);
   return sainseq;
 }
 
@@ -173,6 +288,8 @@ static GtSainseq *gt_sainseq_new_from_bare_encseq(const GtBareEncseq
   sainseq->numofchars = gt_bare_encseq_numofchars(bare_encseq);
   sainseq->bare_encseq = bare_encseq;
   sainseq->readmode = readmode;
+  sainseq->parallel = gt_sain_decideforparallel(sainseq->totallength,
+                                                sainseq->numofchars);
   gt_sain_allocate_tmpspace(sainseq,sainseq->totallength+GT_COMPAREOFFSET,
                             sainseq->totallength);
   for (idx = 0; idx<sainseq->numofchars; idx++)
@@ -199,8 +316,6 @@ static GtSainseq *gt_sainseq_new_from_array(GtUsainindextype *arr,
                                             GtUsainindextype firstusable,
                                             GtUword suftabentries)
 {
-  GtUword charidx;
-  GtUsainindextype *cptr;
   GtSainseq *sainseq = (GtSainseq *) gt_malloc(sizeof *sainseq);
 
   sainseq->seqtype = GT_SAIN_INTSEQ;
@@ -209,6 +324,7 @@ static GtSainseq *gt_sainseq_new_from_array(GtUsainindextype *arr,
   sainseq->bare_encseq = NULL;
   sainseq->readmode = GT_READMODE_FORWARD;
   sainseq->numofchars = numofchars;
+  sainseq->parallel = gt_sain_decideforparallel(len,numofchars);
   gt_assert((GtUword) firstusable < suftabentries);
   if (suftabentries - firstusable >= numofchars)
   {
@@ -264,15 +380,7 @@ static GtSainseq *gt_sainseq_new_from_array(GtUsainindextype *arr,
     sainseq->roundtable = NULL;
   }
   sainseq->sstarfirstcharcount = NULL;
-  for (charidx = 0; charidx < sainseq->numofchars; charidx++)
-  {
-    sainseq->bucketsize[charidx] = 0;
-  }
-  for (cptr = arr; cptr < arr + sainseq->totallength; cptr++)
-  {
-    gt_assert((GtUword) *cptr < numofchars);
-    sainseq->bucketsize[*cptr]++;
-  }
+  gt_sain_countchars(sainseq);
   return sainseq;
 }
 
@@ -666,10 +774,368 @@ static void gt_sain_induceStypes2fromspecialranges(const GtSainseq *sainseq,
 
 #include "match/sfx-sain.inc"
 
+/* Determine the character at position <end> of the sequence and whether the
+   suffix starting there is of S-type, i.e. the state of the right-to-left
+   scan when it enters the part ending at <end>. */
+static void gt_sain_partboundary(const GtSainseq *sainseq,GtUword end,
+                                 GtUword *nextcc,bool *nextisStype)
+{
+  if (end == sainseq->totallength)
+  {
+    *nextcc = GT_UNIQUEINT(sainseq->totallength);
+    *nextisStype = true;
+  } else
+  {
+    GtUword position, cc = gt_sainseq_getchar(sainseq,end),
+            othercc = GT_UNIQUEINT(sainseq->totallength);
+
+    /* all suffixes in a run of equal characters have the same type */
+    for (position = end + 1; position < sainseq->totallength; position++)
+    {
+      GtUword runcc = gt_sainseq_getchar(sainseq,position);
+
+      if (runcc != cc)
+      {
+        othercc = runcc;
+        break;
+      }
+    }
+    *nextcc = cc;
+    *nextisStype = cc < othercc ? true : false;
+  }
+}
+
+static void gt_sain_insertSstar_parts(GtUword start,GtUword end,void *data)
+{
+  const GtSainPartinfo *partinfo = (const GtSainPartinfo *) data;
+  const GtSainseq *sainseq = partinfo->sainseq;
+  GtUword part;
+
+  for (part = start; part < end; part++)
+  {
+    GtUsainindextype *count = partinfo->partcounts + part * sainseq->numofchars;
+    GtUword nextcc, countSstartype = 0,
+            partstart = gt_sain_partstart(sainseq,part),
+            partend = gt_sain_partstart(sainseq,part+1);
+    bool nextisStype;
+    GtUsainindextype position;
+    GtEncseqReader *esr = NULL;
+
+    if (partstart == partend)
+    {
+      partinfo->countSstartype[part] = 0;
+      continue;
+    }
+    gt_sain_partboundary(sainseq,partend,&nextcc,&nextisStype);
+    if (sainseq->seqtype == GT_SAIN_ENCSEQ)
+    {
+      esr = gt_encseq_create_reader_with_readmode(sainseq->seq.encseq,
+                              gt_readmode_inverse_direction(sainseq->readmode),
+                              sainseq->totallength - partend);
+    }
+    for (position = (GtUsainindextype) (partend - 1); /* Nothing */;
+         position--)
+    {
+      GtUword currentcc;
+      bool currentisStype;
+
+      if (esr != NULL)
+      {
+        GtUchar tmpcc = gt_encseq_reader_next_encoded_char(esr);
+
+        currentcc = ISSPECIAL(tmpcc) ? GT_UNIQUEINT(position)
+                                     : (GtUword) tmpcc;
+      } else
+      {
+        currentcc = gt_sainseq_getchar(sainseq,(GtUword) position);
+      }
+      currentisStype = (currentcc < nextcc ||
+                        (currentcc == nextcc && nextisStype)) ? true : false;
+      if (!currentisStype && nextisStype)
+      {
+        countSstartype++;
+        if (partinfo->suftab == NULL)
+        {
+          count[nextcc]++;
+        } else
+        {
+          partinfo->suftab[--count[nextcc]] = position;
+        }
+      }
+      nextisStype = currentisStype;
+      nextcc = currentcc;
+      if ((GtUword) position == partstart)
+      {
+        break;
+      }
+    }
+    gt_encseq_reader_delete(esr);
+    partinfo->countSstartype[part] = countSstartype;
+  }
+}
+
+/* The parts are scanned twice: first the Sstar suffixes are counted for each
+   part and bucket, then they are inserted into the area of their bucket
+   reserved for the part. Within each bucket, the parts are ordered as in the
+   right-to-left scan of the sequential variant. */
+static GtUword gt_sain_parallel_insertSstarsuffixes(GtSainseq *sainseq,
+                                                    GtUsainindextype *suftab)
+{
+  GtSainPartinfo partinfo;
+  GtUword charidx, part, countSstartype = 0;
+
+  partinfo.sainseq = sainseq;
+  partinfo.partcounts = gt_calloc((size_t) (gt_jobs * sainseq->numofchars),
+                                  sizeof (*partinfo.partcounts));
+  partinfo.countSstartype = gt_malloc(sizeof (*partinfo.countSstartype) *
+                                      gt_jobs);
+  partinfo.suftab = NULL;
+  gt_thread_pool_parallel_for(gt_thread_pool_get(),0,(GtUword) gt_jobs,1UL,
+                              gt_sain_insertSstar_parts,&partinfo);
+  gt_sain_endbuckets(sainseq);
+  for (charidx = 0; charidx < sainseq->numofchars; charidx++)
+  {
+    GtUsainindextype fill = sainseq->bucketfillptr[charidx];
+
+    for (part = (GtUword) gt_jobs; part > 0; part--)
+    {
+      GtUsainindextype *count
+        = partinfo.partcounts + (part - 1) * sainseq->numofchars + charidx,
+        countSstar = *count;
+
+      *count = fill;
+      fill -= countSstar;
+      if (sainseq->seqtype != GT_SAIN_INTSEQ)
+      {
+        sainseq->sstarfirstcharcount[charidx] += countSstar;
+      }
+    }
+    sainseq->bucketfillptr[charidx] = fill;
+  }
+  partinfo.suftab = suftab;
+  gt_thread_pool_parallel_for(gt_thread_pool_get(),0,(GtUword) gt_jobs,1UL,
+                              gt_sain_insertSstar_parts,&partinfo);
+  for (part = 0; part < (GtUword) gt_jobs; part++)
+  {
+    countSstartype += partinfo.countSstartype[part];
+  }
+  gt_free(partinfo.countSstartype);
+  gt_free(partinfo.partcounts);
+  gt_assert(GT_MULT2(countSstartype) <= sainseq->totallength);
+  return countSstartype;
+}
+
+/* For the suffix preceding the suffix at <position> + 1, return its first
+   character and store in <value> the entry to be induced into its bucket. A
+   return value of at least <numofchars> means that nothing is induced. */
+static GtUword gt_sain_inducedvalue(const GtSainseq *sainseq,
+                                    GtSsainindextype position,
+                                    bool ltype,
+                                    GtSsainindextype *value)
+{
+  GtUword currentcc = gt_sainseq_getchar(sainseq,(GtUword) position);
+
+  if (currentcc < sainseq->numofchars)
+  {
+    if (ltype)
+    {
+      *value = (position > 0 &&
+                gt_sainseq_getchar(sainseq,(GtUword) (position-1)) < currentcc)
+               ? ~position : position;
+    } else
+    {
+      *value = (position == 0 ||
+                gt_sainseq_getchar(sainseq,(GtUword) (position-1)) > currentcc)
+               ? ~position : position;
+    }
+  }
+  return currentcc;
+}
+
+/* The induction scans are inherently sequential, but their character
+   accesses only depend on the values read from the suffix array. So for
+   each block of the suffix array, these values are saved and the induced
+   entries are computed in parallel. The sequential scan then uses these
+   entries, unless the value has been overwritten by the scan itself. */
+typedef struct
+{
+  const GtSainseq *sainseq;
+  const GtSsainindextype *suftab;
+  GtSsainindextype *saved, *induced;
+  GtUsainindextype *inducedcc;
+  bool ltype;
+} GtSainInduceblock;
+
+static GtSainInduceblock *gt_sain_induceblock_new(const GtSainseq *sainseq,
+                                                  GtUword nonspecialentries,
+                                                  bool ltype)
+{
+  GtSainInduceblock *block = gt_malloc(sizeof *block);
+  const GtUword blocksize = MIN(nonspecialentries,GT_SAIN_INDUCE_BLOCKSIZE);
+
+  block->sainseq = sainseq;
+  block->suftab = NULL;
+  block->saved = gt_malloc(sizeof (*block->saved) * blocksize);
+  block->induced = gt_malloc(sizeof (*block->induced) * blocksize);
+  block->inducedcc = gt_malloc(sizeof (*block->inducedcc) * blocksize);
+  block->ltype = ltype;
+  return block;
+}
+
+static void gt_sain_induceblock_delete(GtSainInduceblock *block)
+{
+  if (block != NULL)
+  {
+    gt_free(block->saved);
+    gt_free(block->induced);
+    gt_free(block->inducedcc);
+    gt_free(block);
+  }
+}
+
+static void gt_sain_induceblock_prepare(GtUword start,GtUword end,void *data)
+{
+  GtSainInduceblock *block = (GtSainInduceblock *) data;
+  GtUword idx;
+
+  for (idx = start; idx < end; idx++)
+  {
+    GtSsainindextype position = block->saved[idx] = block->suftab[idx];
+
+    block->inducedcc[idx] = (GtUsainindextype) block->sainseq->numofchars;
+    if (position > 0)
+    {
+      GtUword currentcc = gt_sain_inducedvalue(block->sainseq,position - 1,
+                                               block->ltype,
+                                               block->induced + idx);
+      if (currentcc < block->sainseq->numofchars)
+      {
+        block->inducedcc[idx] = (GtUsainindextype) currentcc;
+      }
+    }
+  }
+}
+
+static GtUword gt_sain_induceblock_get(const GtSainInduceblock *block,
+                                       GtUword idx,
+                                       GtSsainindextype position,
+                                       GtSsainindextype *value)
+{
+  if (position == block->saved[idx])
+  {
+    *value = block->induced[idx];
+    return (GtUword) block->inducedcc[idx];
+  }
+  return gt_sain_inducedvalue(block->sainseq,position - 1,block->ltype,value);
+}
+
+static void gt_sain_parallel_induceLtypesuffixes2(const GtSainseq *sainseq,
+                                                  GtSsainindextype *suftab,
+                                                  GtUword nonspecialentries)
+{
+  GtUword lastupdatecc = 0, blockstart;
+  GtUsainindextype *fillptr = sainseq->bucketfillptr;
+  GtSsainindextype *bucketptr = NULL;
+  GtSainInduceblock *block = gt_sain_induceblock_new(sainseq,nonspecialentries,
+                                                     true);
+
+  for (blockstart = 0; blockstart < nonspecialentries;
+       blockstart += GT_SAIN_INDUCE_BLOCKSIZE)
+  {
+    GtUword idx, width = MIN(nonspecialentries - blockstart,
+                             GT_SAIN_INDUCE_BLOCKSIZE);
+
+    block->suftab = suftab + blockstart;
+    gt_thread_pool_parallel_for(gt_thread_pool_get(),0,width,
+                                GT_SAIN_INDUCE_GRAINSIZE,
+                                gt_sain_induceblock_prepare,block);
+    for (idx = 0; idx < width; idx++)
+    {
+      GtSsainindextype *suftabptr = suftab + blockstart + idx,
+                       position = *suftabptr;
+
+      *suftabptr = ~position;
+      if (position > 0)
+      {
+        GtSsainindextype value = 0;
+        GtUword currentcc = gt_sain_induceblock_get(block,idx,position,
+                                                    &value);
+
+        if (currentcc < sainseq->numofchars)
+        {
+          gt_assert(currentcc > 0);
+          GT_SAINUPDATEBUCKETPTR(currentcc);
+          gt_assert(bucketptr != NULL && suftabptr < bucketptr);
+          *bucketptr++ = value;
+        }
+      }
+    }
+  }
+  gt_sain_induceblock_delete(block);
+}
+
+static void gt_sain_parallel_induceStypesuffixes2(const GtSainseq *sainseq,
+                                                  GtSsainindextype *suftab,
+                                                  GtUword nonspecialentries)
+{
+  GtUword lastupdatecc = 0, blockend;
+  GtUsainindextype *fillptr = sainseq->bucketfillptr;
+  GtSsainindextype *bucketptr = NULL;
+  GtSainInduceblock *block = gt_sain_induceblock_new(sainseq,nonspecialentries,
+                                                     false);
+
+  gt_sain_special_singleSinduction2(sainseq,
+                                    suftab,
+                                    (GtSsainindextype) sainseq->totallength,
+                                    nonspecialentries);
+  if (sainseq->seqtype == GT_SAIN_ENCSEQ ||
+      sainseq->seqtype == GT_SAIN_BARE_ENCSEQ)
+  {
+    gt_sain_induceStypes2fromspecialranges(sainseq,suftab,nonspecialentries);
+  }
+  for (blockend = nonspecialentries; blockend > 0; /* Nothing */)
+  {
+    GtUword idx, width = MIN(blockend,GT_SAIN_INDUCE_BLOCKSIZE);
+
+    blockend -= width;
+    block->suftab = suftab + blockend;
+    gt_thread_pool_parallel_for(gt_thread_pool_get(),0,width,
+                                GT_SAIN_INDUCE_GRAINSIZE,
+                                gt_sain_induceblock_prepare,block);
+    for (idx = width; idx > 0; idx--)
+    {
+      GtSsainindextype *suftabptr = suftab + blockend + idx - 1,
+                       position = *suftabptr;
+
+      if (position > 0)
+      {
+        GtSsainindextype value = 0;
+        GtUword currentcc = gt_sain_induceblock_get(block,idx - 1,position,
+                                                    &value);
+
+        if (currentcc < sainseq->numofchars)
+        {
+          GT_SAINUPDATEBUCKETPTR(currentcc);
+          gt_assert(bucketptr != NULL && bucketptr - 1 < suftabptr);
+          *(--bucketptr) = value;
+        }
+      } else
+      {
+        *suftabptr = ~position;
+      }
+    }
+  }
+  gt_sain_induceblock_delete(block);
+}
+
 static GtUword gt_sain_insertSstarsuffixes(GtSainseq *sainseq,
                                            GtUsainindextype *suftab,
                                            GtLogger *logger)
 {
+  if (sainseq->parallel)
+  {
+    return gt_sain_parallel_insertSstarsuffixes(sainseq,suftab);
+  }
   switch (sainseq->seqtype)
   {
     case GT_SAIN_PLAINSEQ:
@@ -932,6 +1398,11 @@ static void gt_sain_induceLtypesuffixes2(const GtSainseq *sainseq,
                                          GtSsainindextype *suftab,
                                          GtUword nonspecialentries)
 {
+  if (sainseq->parallel)
+  {
+    gt_sain_parallel_induceLtypesuffixes2(sainseq,suftab,nonspecialentries);
+    return;
+  }
   switch (sainseq->seqtype)
   {
     case GT_SAIN_PLAINSEQ:
@@ -954,6 +1425,11 @@ static void gt_sain_induceStypesuffixes2(const GtSainseq *sainseq,
                                          GtSsainindextype *suftab,
                                          GtUword nonspecialentries)
 {
+  if (sainseq->parallel)
+  {
+    gt_sain_parallel_induceStypesuffixes2(sainseq,suftab,nonspecialentries);
+    return;
+  }
   switch (sainseq->seqtype)
   {
     case GT_SAIN_PLAINSEQ:
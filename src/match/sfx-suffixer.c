@@ -2086,9 +2086,13 @@ static void gt_sfxiterator_preparethispart(Sfxiterator *sfi)
     gt_bcktab_determinemaxsize(sfi->bcktab, sfi->currentmincode,
                                sfi->currentmaxcode,sumofwidthforpart);
 #ifdef GT_THREADS_ENABLED
-    if (GT_SFX_THREADS_JOBS > 1U
+    /* the difference cover sorts into the lcp-table of <sfi->outlcpinfo>,
+       which cannot be shared by several threads */
+    if (GT_SFX_THREADS_JOBS > 1U &&
+        (sfi->dcov == NULL || sfi->outlcpinfo == NULL)
 #ifdef GT_THREADS_PARTITION
         &&
+        sfi->outlcpinfo == NULL &&
         sfi->partitions_for_threads != NULL &&
         gt_suftabparts_numofparts(sfi->partitions_for_threads[sfi->part]) > 1U
 #endif
@@ -2119,10 +2123,12 @@ static void gt_sfxiterator_preparethispart(Sfxiterator *sfi)
                                  sumofwidthforpart,
                                  sfi->numofchars,
                                  sfi->prefixlength,
+                                 sfi->outlcpinfo,
                                  sortmaxdepth,
                                  &sfi->sfxstrategy,
                                  processunsortedsuffixrange,
                                  processunsortedsuffixrangeinfo,
+                                 &sfi->bucketiterstep,
                                  sfi->logger);
 #endif
     } else
@@ -76,6 +76,7 @@ int gt_clean_runner(GT_UNUSED int argc, GT_UNUSED const char **argv,
   remove_pattern_in_current_dir(GT_SDSTABFILESUFFIX);
   remove_pattern_in_current_dir(GT_OISTABFILESUFFIX);
   remove_pattern_in_current_dir(GT_MD5TABFILESUFFIX);
+  remove_pattern_in_current_dir(GT_BCSTABFILESUFFIX);
 #else
   /* XXX */
   gt_error_set(err, "gt_clean_runner() not implemented");
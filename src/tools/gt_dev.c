@@ -28,7 +28,9 @@
 #include "gth/gt_gthmkbssmfiles.h"
 #include "tools/gt_compressedbits.h"
 #include "tools/gt_consensus_sa.h"
+#include "tools/gt_esalcp.h"
 #include "tools/gt_extracttarget.h"
+#include "tools/gt_featureindexbench.h"
 #include "tools/gt_gdiffcalc.h"
 #include "tools/gt_guessprot.h"
 #include "tools/gt_idxlocali.h"
@@ -39,6 +41,7 @@
 #include "tools/gt_paircmp.h"
 #include "tools/gt_parsexrf.h"
 #include "tools/gt_patternmatch.h"
+#include "tools/gt_readbench.h"
 #include "tools/gt_readreads.h"
 #include "tools/gt_regioncov.h"
 #include "tools/gt_sain.h"
@@ -49,6 +52,7 @@
 #include "tools/gt_show_seedext.h"
 #include "tools/gt_skproto.h"
 #include "tools/gt_sortbench.h"
+#include "tools/gt_symbolbench.h"
 #include "tools/gt_trieins.h"
 
 #include "tools/gt_dev.h"
@@ -70,7 +74,9 @@ static void* gt_dev_arguments_new(void)
   gt_toolbox_add(dev_toolbox, "trieins", gt_trieins);
   gt_toolbox_add_tool(dev_toolbox, "compbits", gt_compressedbits());
   gt_toolbox_add_tool(dev_toolbox, "consensus_sa", gt_consensus_sa_tool());
+  gt_toolbox_add_tool(dev_toolbox, "esalcp", gt_esalcp());
   gt_toolbox_add_tool(dev_toolbox, "extracttarget", gt_extracttarget());
+  gt_toolbox_add_tool(dev_toolbox, "featureindexbench", gt_featureindexbench());
   gt_toolbox_add_tool(dev_toolbox, "gdiffcalc", gt_gdiffcalc());
   gt_toolbox_add_tool(dev_toolbox, "gthbssmrmsd", gt_gthbssmrmsd());
   gt_toolbox_add_tool(dev_toolbox, "gthbssmtrain", gt_gthbssmtrain());
@@ -79,6 +85,7 @@ static void* gt_dev_arguments_new(void)
   gt_toolbox_add_tool(dev_toolbox, "linspace_align", gt_linspace_align());
   gt_toolbox_add_tool(dev_toolbox, "magicmatch", gt_magicmatch());
   gt_toolbox_add_tool(dev_toolbox, "parsexrf", gt_parsexrf());
+  gt_toolbox_add_tool(dev_toolbox, "readbench", gt_readbench());
   gt_toolbox_add_tool(dev_toolbox, "readreads", gt_readreads());
   gt_toolbox_add_tool(dev_toolbox, "sain", gt_sain());
   gt_toolbox_add_tool(dev_toolbox, "sambam", gt_sam_interface());
@@ -88,6 +95,7 @@ static void* gt_dev_arguments_new(void)
   gt_toolbox_add_tool(dev_toolbox, "show_seedext", gt_show_seedext());
   gt_toolbox_add_tool(dev_toolbox, "skproto", gt_skproto());
   gt_toolbox_add_tool(dev_toolbox, "sortbench", gt_sortbench());
+  gt_toolbox_add_tool(dev_toolbox, "symbolbench", gt_symbolbench());
   return dev_toolbox;
 }
 
@@ -148,6 +148,7 @@ static void show_encoded_statistics(GtStrArray *infiles, const char *indexname)
   enc_size += index_size(indexname, GT_DESTABFILESUFFIX);
   enc_size += index_size(indexname, GT_SDSTABFILESUFFIX);
   enc_size += index_size(indexname, GT_OISTABFILESUFFIX);
+  enc_size += index_size(indexname, GT_BCSTABFILESUFFIX);
   printf("encoded sequence file(s) are %.1f%% of original file size\n",
          ((double) enc_size / orig_size) * 100.0);
 }
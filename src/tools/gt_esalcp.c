@@ -0,0 +1,141 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include "core/ma.h"
+#include "core/unused_api.h"
+#include "core/option_api.h"
+#include "core/logger.h"
+#include "tools/gt_esalcp.h"
+#include "match/sfx-philcp.h"
+
+typedef struct
+{
+  bool verbose;
+  GtUword maximumspace;
+  GtStr *indexname,
+        *memlimitarg;
+  GtOption *refoptionmemlimit;
+} GtEsalcpArguments;
+
+static void* gt_esalcp_arguments_new(void)
+{
+  GtEsalcpArguments *arguments = gt_calloc((size_t) 1, sizeof *arguments);
+  arguments->indexname = gt_str_new();
+  arguments->memlimitarg = gt_str_new();
+  arguments->maximumspace = 0UL; /* in bytes */
+  return arguments;
+}
+
+static void gt_esalcp_arguments_delete(void *tool_arguments)
+{
+  GtEsalcpArguments *arguments = tool_arguments;
+  if (!arguments) return;
+  gt_str_delete(arguments->indexname);
+  gt_str_delete(arguments->memlimitarg);
+  gt_option_delete(arguments->refoptionmemlimit);
+  gt_free(arguments);
+}
+
+static GtOptionParser* gt_esalcp_option_parser_new(void *tool_arguments)
+{
+  GtEsalcpArguments *arguments = tool_arguments;
+  GtOptionParser *op;
+  GtOption *option;
+
+  gt_assert(arguments);
+
+  /* init */
+  op = gt_option_parser_new("[option ...] -ii indexname",
+                            "Compute the lcp table of an enhanced suffix "
+                            "array from its suffix table.");
+
+  /* -ii */
+  option = gt_option_new_string("ii", "specify the input index",
+                                arguments->indexname, NULL);
+  gt_option_parser_add_option(op, option);
+  gt_option_is_mandatory(option);
+
+  /* -memlimit */
+  option = gt_option_new_string("memlimit",
+                       "specify maximal amount of memory to be used for the "
+                       "phi-table (in bytes, the keywords 'MB' and 'GB' are "
+                       "allowed); if the limit is smaller than the table for "
+                       "the whole sequence, the suffix table is read several "
+                       "times",
+                       arguments->memlimitarg, NULL);
+  gt_option_parser_add_option(op, option);
+  arguments->refoptionmemlimit = gt_option_ref(option);
+
+  /* -v */
+  option = gt_option_new_verbose(&arguments->verbose);
+  gt_option_parser_add_option(op, option);
+
+  return op;
+}
+
+static int gt_esalcp_arguments_check(int rest_argc,
+                                     void *tool_arguments,
+                                     GtError *err)
+{
+  GtEsalcpArguments *arguments = tool_arguments;
+  int had_err = 0;
+
+  gt_error_check(err);
+  if (rest_argc != 0)
+  {
+    gt_error_set(err,"unnecessary arguments");
+    had_err = -1;
+  }
+  if (!had_err && gt_option_is_set(arguments->refoptionmemlimit))
+  {
+    had_err = gt_option_parse_spacespec(&arguments->maximumspace,
+                                        "memlimit",
+                                        arguments->memlimitarg,
+                                        err);
+  }
+  return had_err;
+}
+
+static int gt_esalcp_runner(GT_UNUSED int argc,
+                            GT_UNUSED const char **argv,
+                            GT_UNUSED int parsed_args,
+                            void *tool_arguments,
+                            GtError *err)
+{
+  GtEsalcpArguments *arguments = tool_arguments;
+  GtLogger *logger;
+  int had_err;
+
+  gt_error_check(err);
+  gt_assert(arguments);
+  logger = gt_logger_new(arguments->verbose, GT_LOGGER_DEFLT_PREFIX, stdout);
+  had_err = gt_lcptab_phi_fromfile(gt_str_get(arguments->indexname),
+                                   arguments->maximumspace,
+                                   logger,
+                                   err);
+  gt_logger_delete(logger);
+  return had_err;
+}
+
+GtTool* gt_esalcp(void)
+{
+  return gt_tool_new(gt_esalcp_arguments_new,
+                     gt_esalcp_arguments_delete,
+                     gt_esalcp_option_parser_new,
+                     gt_esalcp_arguments_check,
+                     gt_esalcp_runner);
+}
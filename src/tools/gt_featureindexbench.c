@@ -0,0 +1,275 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include <stdlib.h>
+#include <sys/time.h>
+#include "core/fileutils_api.h"
+#include "core/hashmap_api.h"
+#include "core/ma.h"
+#include "core/mathsupport.h"
+#include "core/str_array_api.h"
+#include "core/unused_api.h"
+#include "core/xposix.h"
+#include "extended/anno_db_gfflike_api.h"
+#include "extended/feature_index_api.h"
+#include "extended/feature_stream_api.h"
+#include "extended/gff3_in_stream.h"
+#include "extended/rdb_api.h"
+#ifdef HAVE_SQLITE
+#include "extended/rdb_sqlite_api.h"
+#endif
+#include "tools/gt_featureindexbench.h"
+
+typedef struct {
+  GtStr *filename;
+  GtUword queries,
+          width;
+  bool force;
+} FeatureIndexBenchArguments;
+
+static void* gt_featureindexbench_arguments_new(void)
+{
+  FeatureIndexBenchArguments *arguments = gt_calloc((size_t) 1,
+                                                    sizeof *arguments);
+  arguments->filename = gt_str_new();
+  return arguments;
+}
+
+static void gt_featureindexbench_arguments_delete(void *tool_arguments)
+{
+  FeatureIndexBenchArguments *arguments = tool_arguments;
+  if (!arguments) return;
+  gt_str_delete(arguments->filename);
+  gt_free(arguments);
+}
+
+static GtOptionParser* gt_featureindexbench_option_parser_new(void
+                                                              *tool_arguments)
+{
+  FeatureIndexBenchArguments *arguments = tool_arguments;
+  GtOptionParser *op;
+  GtOption *option;
+  gt_assert(arguments);
+
+  op = gt_option_parser_new("[option ...] -filename db GFF3_file [...]",
+                            "Benchmark loading GFF3 files into a SQLite "
+                            "feature index and querying it for random "
+                            "ranges.\nUse gt -seed to repeat a run with the "
+                            "same queries.");
+
+  option = gt_option_new_string("filename", "filename for feature database",
+                                arguments->filename, NULL);
+  gt_option_is_mandatory(option);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_bool("force", "overwrite an existing database",
+                              &arguments->force, false);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword("queries", "number of random range queries",
+                               &arguments->queries, 1000);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword_min("width", "width of the query ranges",
+                                   &arguments->width, 10000, 1);
+  gt_option_parser_add_option(op, option);
+
+  gt_option_parser_set_min_args(op, 1);
+  return op;
+}
+
+#ifdef HAVE_SQLITE
+static double gt_featureindexbench_seconds(void)
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+static int gt_featureindexbench_cmp_double(const void *a, const void *b)
+{
+  double x = *(const double*) a, y = *(const double*) b;
+  return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+static int gt_featureindexbench_delete_node(void *key, GT_UNUSED void *value,
+                                            GT_UNUSED void *data,
+                                            GT_UNUSED GtError *err)
+{
+  gt_genome_node_delete((GtGenomeNode*) key);
+  return 0;
+}
+
+static int gt_featureindexbench_load(FeatureIndexBenchArguments *arguments,
+                                     GtRDB *rdb, GtAnnoDBSchema *adb,
+                                     int nof_files, const char **files,
+                                     GtError *err)
+{
+  GtNodeStream *in_stream, *feature_stream;
+  GtFeatureIndex *fi;
+  double start;
+  int had_err = 0;
+
+  start = gt_featureindexbench_seconds();
+  if (!(fi = gt_anno_db_schema_get_feature_index(adb, rdb, err)))
+    return -1;
+  in_stream = gt_gff3_in_stream_new_unsorted(nof_files, files);
+  feature_stream = gt_feature_stream_new(in_stream, fi);
+  had_err = gt_node_stream_pull(feature_stream, err);
+  gt_node_stream_delete(feature_stream);
+  gt_node_stream_delete(in_stream);
+  /* deleting the index finishes the bulk load (R*Tree, indexes) */
+  gt_feature_index_delete(fi);
+  if (!had_err) {
+    printf("# load\t%s\t%.3fs\n", gt_str_get(arguments->filename),
+           gt_featureindexbench_seconds() - start);
+  }
+  return had_err;
+}
+
+static int gt_featureindexbench_query(FeatureIndexBenchArguments *arguments,
+                                      GtRDB *rdb, GtAnnoDBSchema *adb,
+                                      GtError *err)
+{
+  GtFeatureIndex *fi;
+  GtStrArray *seqids = NULL;
+  GtHashmap *handed_out;
+  GtArray *results;
+  GtUword i, nof_results = 0;
+  double *latencies, total = 0.0;
+  int had_err = 0;
+
+  if (!(fi = gt_anno_db_schema_get_feature_index(adb, rdb, err)))
+    return -1;
+  if (!(seqids = gt_feature_index_get_seqids(fi, err)))
+    had_err = -1;
+  if (!had_err && gt_str_array_size(seqids) == 0) {
+    gt_error_set(err, "feature index '%s' is empty",
+                 gt_str_get(arguments->filename));
+    had_err = -1;
+  }
+  /* the feature index caches the nodes it hands out and returns the same
+     nodes again, so delete each of them only once at the end */
+  handed_out = gt_hashmap_new(GT_HASH_DIRECT, NULL, NULL);
+  results = gt_array_new(sizeof (GtGenomeNode*));
+  latencies = gt_calloc(arguments->queries + 1, sizeof (double));
+  for (i = 0; !had_err && i < arguments->queries; i++) {
+    const char *seqid;
+    GtRange seqrng, qryrng;
+    GtUword j;
+    double start;
+
+    seqid = gt_str_array_get(seqids, gt_str_array_size(seqids) > 1
+                                     ? gt_rand_max(gt_str_array_size(seqids)
+                                                   - 1)
+                                     : 0);
+    had_err = gt_feature_index_get_range_for_seqid(fi, &seqrng, seqid, err);
+    if (!had_err) {
+      qryrng.start = seqrng.start;
+      if (gt_range_length(&seqrng) > arguments->width)
+        qryrng.start += gt_rand_max(gt_range_length(&seqrng)
+                                    - arguments->width);
+      qryrng.end = qryrng.start + arguments->width - 1;
+      gt_array_reset(results);
+      start = gt_featureindexbench_seconds();
+      had_err = gt_feature_index_get_features_for_range(fi, results, seqid,
+                                                        &qryrng, err);
+      latencies[i] = gt_featureindexbench_seconds() - start;
+      total += latencies[i];
+    }
+    for (j = 0; !had_err && j < gt_array_size(results); j++) {
+      gt_hashmap_add(handed_out, *(GtGenomeNode**) gt_array_get(results, j),
+                     (void*) 1);
+    }
+    nof_results += gt_array_size(results);
+  }
+  if (!had_err && arguments->queries > 0) {
+    qsort(latencies, arguments->queries, sizeof (double),
+          gt_featureindexbench_cmp_double);
+    printf("# query\t"GT_WU" queries\t"GT_WU" bp\t"GT_WU" results\t"
+           "%.3fs\t%.1f us/query\tmedian %.1f us\tmax %.1f us\n",
+           arguments->queries, arguments->width, nof_results, total,
+           total * 1000000.0 / arguments->queries,
+           latencies[arguments->queries / 2] * 1000000.0,
+           latencies[arguments->queries - 1] * 1000000.0);
+  }
+  (void) gt_hashmap_foreach(handed_out, gt_featureindexbench_delete_node,
+                            NULL, NULL);
+  gt_hashmap_delete(handed_out);
+  gt_array_delete(results);
+  gt_free(latencies);
+  gt_str_array_delete(seqids);
+  gt_feature_index_delete(fi);
+  return had_err;
+}
+#endif
+
+static int gt_featureindexbench_runner(GT_UNUSED int argc,
+                                       GT_UNUSED const char **argv,
+                                       GT_UNUSED int parsed_args,
+                                       void *tool_arguments, GtError *err)
+{
+  FeatureIndexBenchArguments *arguments = tool_arguments;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(arguments);
+
+#ifdef HAVE_SQLITE
+  {
+    GtAnnoDBSchema *adb = NULL;
+    GtRDB *rdb = NULL;
+
+    if (gt_file_exists(gt_str_get(arguments->filename))) {
+      if (arguments->force) {
+        gt_xunlink(gt_str_get(arguments->filename));
+      } else {
+        gt_error_set(err, "file \"%s\" exists already. use option -force to "
+                     "overwrite", gt_str_get(arguments->filename));
+        had_err = -1;
+      }
+    }
+    if (!had_err) {
+      if (!(rdb = gt_rdb_sqlite_new(gt_str_get(arguments->filename), err)))
+        had_err = -1;
+    }
+    if (!had_err) {
+      adb = gt_anno_db_gfflike_new();
+      had_err = gt_featureindexbench_load(arguments, rdb, adb,
+                                          argc - parsed_args,
+                                          argv + parsed_args, err);
+    }
+    if (!had_err)
+      had_err = gt_featureindexbench_query(arguments, rdb, adb, err);
+    gt_anno_db_schema_delete(adb);
+    gt_rdb_delete(rdb);
+  }
+#else
+  gt_error_set(err, "GenomeTools was compiled without SQLite support");
+  had_err = -1;
+#endif
+
+  return had_err;
+}
+
+GtTool* gt_featureindexbench(void)
+{
+  return gt_tool_new(gt_featureindexbench_arguments_new,
+                     gt_featureindexbench_arguments_delete,
+                     gt_featureindexbench_option_parser_new,
+                     NULL,
+                     gt_featureindexbench_runner);
+}
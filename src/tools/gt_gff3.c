@@ -16,9 +16,11 @@
 */
 
 #include <string.h>
+#include "core/array.h"
 #include "core/ma.h"
 #include "core/option_api.h"
 #include "core/output_file_api.h"
+#include "core/thread_api.h"
 #include "core/undef_api.h"
 #include "core/versionfunc.h"
 #include "extended/add_introns_stream_api.h"
@@ -34,6 +36,7 @@
 #include "extended/merge_feature_stream_api.h"
 #include "extended/set_source_visitor_api.h"
 #include "extended/sort_stream.h"
+#include "extended/threaded_stream.h"
 #include "extended/typecheck_info.h"
 #include "extended/visitor_stream_api.h"
 #include "extended/xrfcheck_info.h"
@@ -55,6 +58,8 @@ typedef struct {
        show,
        fixboundaries;
   GtWord offset;
+  GtUword sortmemlimit,
+          sortfanin;
   GtStr *offsetfile, *newsource;
   GtUword width;
   GtTypecheckInfo *tci;
@@ -94,7 +99,7 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
   GtOption *sort_option, *load_option, *strict_option, *tidy_option,
            *mergefeat_option, *addintrons_option, *offset_option,
            *offsetfile_option, *setsource_option, *sortlines_option,
-           *sortnum_option, *option;
+           *sortnum_option, *sortmemlimit_option, *option;
   gt_assert(arguments);
 
   /* init */
@@ -123,6 +128,27 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
   gt_option_parser_add_option(op, sortnum_option);
   gt_option_exclude(sortlines_option, sortnum_option);
 
+  /* -sortmemlimit */
+  option = gt_option_new_uword("sortmemlimit", "limit the memory used for "
+                               "sorting to roughly the given number of "
+                               "megabytes, sorted parts of the input are "
+                               "stored in temporary files and merged "
+                               "afterwards (0 = no limit)",
+                               &arguments->sortmemlimit, 0);
+  gt_option_imply_either_3(option, sort_option, sortlines_option,
+                           sortnum_option);
+  gt_option_parser_add_option(op, option);
+  sortmemlimit_option = option;
+
+  /* -sortfanin */
+  option = gt_option_new_uword_min("sortfanin", "merge at most the given "
+                                   "number of temporary files at once",
+                                   &arguments->sortfanin,
+                                   GT_SORT_STREAM_MAX_FANIN, 2);
+  gt_option_imply(option, sortmemlimit_option);
+  gt_option_is_development_option(option);
+  gt_option_parser_add_option(op, option);
+
   /* -strict */
   strict_option = gt_option_new_bool("strict", "be very strict during GFF3 "
                                      "parsing (stricter than the specification "
@@ -243,6 +269,21 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
   return op;
 }
 
+/* If more than one job was requested, let the streams up to <in_stream> run in
+   a thread of their own (at most <gt_jobs> - 1 additional threads are used,
+   including the parse workers of the GFF3 input stream). */
+static GtNodeStream* gff3_pipeline_stage(GtNodeStream *in_stream,
+                                         GtArray *stages)
+{
+  GtNodeStream *threaded_stream;
+  gt_assert(in_stream && stages);
+  if (gt_array_size(stages) + 1 >= gt_jobs)
+    return in_stream;
+  threaded_stream = gt_threaded_stream_new(in_stream);
+  gt_array_add(stages, threaded_stream);
+  return threaded_stream;
+}
+
 static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
                           void *tool_arguments, GtError *err)
 {
@@ -257,10 +298,13 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
                *set_source_stream = NULL,
                *gff3_out_stream = NULL,
                *last_stream;
+  GtArray *stages;
+  GtUword i;
   int had_err = 0;
 
   gt_error_check(err);
   gt_assert(arguments);
+  stages = gt_array_new(sizeof (GtNodeStream*));
 
   /* create a gff3 input stream */
   gff3_in_stream = gt_gff3_in_stream_new_unsorted(argc - parsed_args,
@@ -321,7 +365,14 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
   /* create sort stream (if necessary) */
   if (!had_err && (arguments->sort || arguments->sortlines ||
                    arguments->sortnum)) {
+    last_stream = gff3_pipeline_stage(last_stream, stages);
     sort_stream = gt_sort_stream_new(last_stream);
+    if (arguments->sortmemlimit) {
+      gt_sort_stream_set_memlimit((GtSortStream*) sort_stream,
+                                  arguments->sortmemlimit << 20);
+      gt_sort_stream_set_max_fanin((GtSortStream*) sort_stream,
+                                   arguments->sortfanin);
+    }
     last_stream = sort_stream;
   }
 
@@ -335,6 +386,7 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
   /* create addintrons stream (if necessary) */
   if (!had_err && arguments->addintrons) {
     gt_assert(last_stream);
+    last_stream = gff3_pipeline_stage(last_stream, stages);
     add_introns_stream = gt_add_introns_stream_new(last_stream);
     last_stream = add_introns_stream;
   }
@@ -343,12 +395,14 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
   if (!had_err && gt_str_length(arguments->newsource) > 0) {
     gt_assert(last_stream);
     GtNodeVisitor *ssv = gt_set_source_visitor_new(arguments->newsource);
+    last_stream = gff3_pipeline_stage(last_stream, stages);
     set_source_stream = gt_visitor_stream_new(last_stream, ssv);
     last_stream = set_source_stream;
   }
 
   /* create gff3 output stream */
   if (!had_err && arguments->show) {
+    last_stream = gff3_pipeline_stage(last_stream, stages);
     if (arguments->sortlines) {
       gff3_out_stream = gt_gff3_linesorted_out_stream_new(last_stream,
                                                           arguments->outfp);
@@ -379,6 +433,14 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
     last_stream = gff3_out_stream;
   }
 
+  /* the jobs not taken by pipeline stages are used for parsing, so that no
+     more than <gt_jobs> threads run in total */
+  if (!had_err && gt_array_size(stages) + 1 < gt_jobs) {
+    gt_gff3_in_stream_enable_parallel_parsing((GtGFF3InStream*) gff3_in_stream,
+                                              gt_jobs - 1 -
+                                              gt_array_size(stages));
+  }
+
   /* pull the features through the stream and free them afterwards */
   if (!had_err)
     had_err = gt_node_stream_pull(last_stream, err);
@@ -391,6 +453,9 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
   gt_node_stream_delete(add_introns_stream);
   gt_node_stream_delete(set_source_stream);
   gt_node_stream_delete(gff3_in_stream);
+  for (i = 0; i < gt_array_size(stages); i++)
+    gt_node_stream_delete(*(GtNodeStream**) gt_array_get(stages, i));
+  gt_array_delete(stages);
   gt_type_checker_delete(type_checker);
   gt_xrf_checker_delete(xrf_checker);
 
@@ -38,6 +38,7 @@
 #include "extended/diagonalbandalign_affinegapcost.h"
 #include "extended/linearalign.h"
 #include "extended/linearalign_affinegapcost.h"
+#include "extended/linearalign_simd.h"
 #include "extended/linspace_management.h"
 #include "extended/scorehandler.h"
 #include "tools/gt_linspace_align.h"
@@ -69,7 +70,8 @@ typedef struct{
              showsequences,
              scoreonly, /* dev option generate alignment, but do not show it*/
              wildcardshow, /* show symbol wildcards in output*/
-             spacetime; /* write space peak and time overall on stdout*/
+             spacetime, /* write space peak and time overall on stdout*/
+             simd; /* use SIMD kernels if the CPU supports them */
   GtUword timesquarefactor; /*factor to specified termination of recursion
                               and call 2dim algorithm */
 } GtLinspaceArguments;
@@ -139,7 +141,7 @@ static GtOptionParser* gt_linspace_align_option_parser_new(void *tool_arguments)
            *optionaffinecosts, *optionoutputfile, *optionshowscore,
            *optionshowsequences, *optiondiagonal, *optiondiagonalbonds,
            *optionsimilarity, *optiontsfactor, *optionspacetime,
-           *optionscoreonly, *optionwildcardsymbol;
+           *optionscoreonly, *optionwildcardsymbol, *optionsimd;
 
   gt_assert(arguments);
 
@@ -207,6 +209,11 @@ static GtOptionParser* gt_linspace_align_option_parser_new(void *tool_arguments)
                                        &arguments->spacetime, false);
   gt_option_parser_add_option(op, optionspacetime);
 
+  optionsimd = gt_option_new_bool("simd", "use SIMD kernels for the linear "
+                                  "space algorithms if the CPU supports them",
+                                  &arguments->simd, true);
+  gt_option_parser_add_option(op, optionsimd);
+
   /* -str */
   optionstrings = gt_option_new_string_array("ss", "input, use two strings",
                                              arguments->strings);
@@ -287,6 +294,7 @@ static GtOptionParser* gt_linspace_align_option_parser_new(void *tool_arguments)
   /* development option(s) */
   gt_option_is_development_option(optionspacetime);
   gt_option_is_development_option(optionscoreonly);/*only useful to test*/
+  gt_option_is_development_option(optionsimd);
 
   return op;
 }
@@ -755,6 +763,7 @@ static int gt_linspace_align_runner(GT_UNUSED int argc,
   align = gt_alignment_new();
   spacemanager = gt_linspace_management_new();
   gt_linspace_management_set_TSfactor(spacemanager,arguments->timesquarefactor);
+  gt_linearalign_simd_enable(arguments->simd);
 
   /* get sequences */
   if (gt_str_array_size(arguments->strings) > 0)
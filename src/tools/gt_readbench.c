@@ -0,0 +1,181 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/file.h"
+#include "core/ma.h"
+#include "core/parseutils_api.h"
+#include "core/str.h"
+#include "core/timer_api.h"
+#include "core/unused_api.h"
+#include "tools/gt_readbench.h"
+
+#define GT_READBENCH_COPYSIZE  8192
+
+typedef struct {
+  GtStr *mode;
+  GtUword runs;
+} ReadBenchArguments;
+
+static void* gt_readbench_arguments_new(void)
+{
+  ReadBenchArguments *arguments = gt_calloc((size_t) 1, sizeof *arguments);
+  arguments->mode = gt_str_new();
+  return arguments;
+}
+
+static void gt_readbench_arguments_delete(void *tool_arguments)
+{
+  ReadBenchArguments *arguments = tool_arguments;
+  if (!arguments) return;
+  gt_str_delete(arguments->mode);
+  gt_free(arguments);
+}
+
+static const char *gt_readbench_mode_names[]
+  = {"block", "line", "char", "copy", NULL};
+
+static GtOptionParser* gt_readbench_option_parser_new(void *tool_arguments)
+{
+  ReadBenchArguments *arguments = tool_arguments;
+  GtOptionParser *op;
+  GtOption *option;
+  gt_assert(arguments);
+
+  op = gt_option_parser_new("[option ...] file [...]",
+                            "Benchmark the read throughput of GtFile on plain, "
+                            "gzip and bzip2 compressed files.");
+
+  option = gt_option_new_choice("mode", "read mode\n"
+                                "block: zero-copy blocks "
+                                "(gt_file_xread_block())\n"
+                                "line: lines (gt_str_read_next_line_generic())"
+                                "\n"
+                                "char: single characters (gt_file_xfgetc())\n"
+                                "copy: copy into a buffer of "
+                                "8192 bytes (gt_file_xread())",
+                                arguments->mode, gt_readbench_mode_names[0],
+                                gt_readbench_mode_names);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword_min("runs", "number of times each file is read",
+                                   &arguments->runs, 1, 1);
+  gt_option_parser_add_option(op, option);
+
+  gt_option_parser_set_min_args(op, 1);
+  return op;
+}
+
+/* returns the number of bytes read from <file> with the given <mode> */
+static GtUint64 gt_readbench_read(GtFile *file, const char *mode,
+                                  GtUint64 *checksum)
+{
+  GtUint64 nof_bytes = 0;
+  if (!strcmp(mode, "block")) {
+    const char *block;
+    GtUword length;
+    while ((length = gt_file_xread_block(file, &block)) > 0) {
+      nof_bytes += length;
+      *checksum += (unsigned char) block[length - 1];
+    }
+  }
+  else if (!strcmp(mode, "line")) {
+    GtStr *line = gt_str_new();
+    int rval;
+    do {
+      rval = gt_str_read_next_line_generic(line, file);
+      /* count the newline, too */
+      nof_bytes += gt_str_length(line) + (rval ? 0 : 1);
+      *checksum += gt_str_length(line);
+      gt_str_reset(line);
+    } while (!rval);
+    gt_str_delete(line);
+  }
+  else if (!strcmp(mode, "char")) {
+    int cc;
+    while ((cc = gt_file_xfgetc(file)) != EOF) {
+      nof_bytes++;
+      *checksum += cc;
+    }
+  }
+  else {
+    char buf[GT_READBENCH_COPYSIZE];
+    int length;
+    gt_assert(!strcmp(mode, "copy"));
+    while ((length = gt_file_xread(file, buf, sizeof buf)) > 0) {
+      nof_bytes += length;
+      *checksum += (unsigned char) buf[length - 1];
+    }
+  }
+  return nof_bytes;
+}
+
+static int gt_readbench_runner(int argc, const char **argv, int parsed_args,
+                               void *tool_arguments, GtError *err)
+{
+  ReadBenchArguments *arguments = tool_arguments;
+  GtStr *elapsed = gt_str_new();
+  int arg, had_err = 0;
+  gt_error_check(err);
+  gt_assert(arguments);
+
+  for (arg = parsed_args; !had_err && arg < argc; arg++) {
+    GtUint64 nof_bytes = 0, checksum = 0;
+    GtTimer *timer;
+    GtFile *file;
+    GtUword run;
+    double seconds;
+
+    timer = gt_timer_new();
+    gt_timer_start(timer);
+    for (run = 0; !had_err && run < arguments->runs; run++) {
+      if (!(file = gt_file_new(argv[arg], "r", err)))
+        had_err = -1;
+      else {
+        nof_bytes += gt_readbench_read(file, gt_str_get(arguments->mode),
+                                       &checksum);
+        gt_file_delete(file);
+      }
+    }
+    if (!had_err) {
+      gt_str_reset(elapsed);
+      gt_timer_get_formatted(timer, GT_WD".%06ld", elapsed);
+      if (gt_parse_double(&seconds, gt_str_get(elapsed)))
+        seconds = 0.0;
+      printf("%s\t%s\t"GT_LLU" bytes\t%.3fs", argv[arg],
+             gt_str_get(arguments->mode), nof_bytes, seconds);
+      if (seconds > 0.0 && nof_bytes > 0) {
+        printf("\t%.2f MB/s\t%.2f s/GB",
+               (double) nof_bytes / seconds / (1 << 20),
+               seconds / ((double) nof_bytes / (1 << 30)));
+      }
+      printf("\t(checksum "GT_LLU")\n", checksum);
+    }
+    gt_timer_delete(timer);
+  }
+
+  gt_str_delete(elapsed);
+  return had_err;
+}
+
+GtTool* gt_readbench(void)
+{
+  return gt_tool_new(gt_readbench_arguments_new,
+                     gt_readbench_arguments_delete,
+                     gt_readbench_option_parser_new,
+                     NULL,
+                     gt_readbench_runner);
+}
@@ -56,6 +56,7 @@ typedef struct {
   bool dbs_verify;
   bool weakends;
   bool onlyseeds;
+  bool bitparallel;
   bool overlappingseeds;
   /* xdrop extension options */
   GtOption *se_option_xdrop;
@@ -125,7 +126,7 @@ static GtOptionParser* gt_seed_extend_option_parser_new(void *tool_arguments)
     *op_len, *op_err, *op_xbe, *op_sup, *op_frq, *op_mem, *op_ali, *op_bia,
     *op_onl, *op_weakends, *op_relax_polish,
     *op_verify_alignment, *op_spdist, *op_display,
-    *op_norev, *op_nofwd, *op_part, *op_pick, *op_overl;
+    *op_norev, *op_nofwd, *op_part, *op_pick, *op_overl, *op_bit;
 
   static GtRange seedpairdistance_defaults = {1UL, GT_UWORD_MAX};
   gt_assert(arguments != NULL);
@@ -276,6 +277,18 @@ static GtOptionParser* gt_seed_extend_option_parser_new(void *tool_arguments)
   gt_option_is_development_option(op_onl);
   gt_option_parser_add_option(op, op_onl);
 
+  /* -bitparallel */
+  op_bit = gt_option_new_bool("bitparallel",
+                              "Extend seeds using bit-parallel edit distance "
+                              "computation (Myers) instead of the greedy "
+                              "front algorithm",
+                              &arguments->bitparallel,
+                              false);
+  gt_option_exclude(op_bit, op_onl);
+  gt_option_exclude(op_bit, op_xdr);
+  gt_option_is_development_option(op_bit);
+  gt_option_parser_add_option(op, op_bit);
+
   /* -history */
   op_his = gt_option_new_uword_min_max("history",
                                        "Size of (mis)match history in range [1"
@@ -747,6 +760,9 @@ static int gt_seed_extend_runner(int argc,
   if (!had_err) {
     GtEncseqLoader *encseq_loader = gt_encseq_loader_new();
     gt_encseq_loader_require_multiseq_support(encseq_loader);
+    /* all sequences are read when collecting the k-mers, so let the system
+       read the sequence files ahead */
+    gt_encseq_loader_set_mmap_advice(encseq_loader, GT_FA_ADVICE_WILLNEED);
 
     /* Load encseq A */
     aencseq = gt_encseq_loader_load(encseq_loader,
@@ -953,6 +969,7 @@ static int gt_seed_extend_runner(int argc,
                                              arguments->se_xdropbelowscore,
                                              extendgreedy,
                                              extendxdrop,
+                                             arguments->bitparallel,
                                              arguments->se_maxalilendiff,
                                              arguments->se_historysize,
                                              arguments->se_perc_match_hist,
@@ -22,7 +22,7 @@
 #include "extended/genome_node.h"
 #include "extended/gff3_in_stream.h"
 #include "extended/sort_stream_api.h"
-#include "extended/stat_stream_api.h"
+#include "extended/stat_stream.h"
 #include "tools/gt_stat.h"
 
 typedef struct {
@@ -34,6 +34,7 @@ typedef struct {
        cds_length_distribution,
        used_sources,
        addintrons,
+       packed,
        verbose;
   GtOutputFileInfo *ofi;
   GtFile *outfp;
@@ -112,6 +113,15 @@ static GtOptionParser* gt_stat_option_parser_new(void *tool_arguments)
                               &arguments->addintrons, false);
   gt_option_parser_add_option(op, option);
 
+  /* -packed */
+  option = gt_option_new_bool("packed", "keep all features in memory in a "
+                              "packed form and compute the statistics from "
+                              "there (requires space proportional to the input "
+                              "file size(s))",
+                              &arguments->packed, false);
+  gt_option_is_development_option(option);
+  gt_option_parser_add_option(op, option);
+
   /* -v */
   option = gt_option_new_verbose(&arguments->verbose);
   gt_option_parser_add_option(op, option);
@@ -126,7 +136,7 @@ static int gt_stat_runner(int argc, const char **argv, int parsed_args,
                           void *tool_arguments, GtError *err)
 {
   StatArguments *arguments = tool_arguments;
-  GtNodeStream *gff3_in_stream, *sort_stream, *add_introns_stream = NULL,
+  GtNodeStream *gff3_in_stream, *sort_stream = NULL, *add_introns_stream = NULL,
                *stat_stream;
   int had_err;
   gt_error_check(err);
@@ -153,6 +163,8 @@ static int gt_stat_runner(int argc, const char **argv, int parsed_args,
                                    arguments->intron_length_distribution,
                                    arguments->cds_length_distribution,
                                    arguments->used_sources);
+  if (arguments->packed)
+    gt_stat_stream_pack_features((GtStatStream*) stat_stream);
 
   /* pull the features through the stream , compute the statistics, and free
      them afterwards */
@@ -164,6 +176,8 @@ static int gt_stat_runner(int argc, const char **argv, int parsed_args,
 
   /* free */
   gt_node_stream_delete(stat_stream);
+  gt_node_stream_delete(add_introns_stream);
+  gt_node_stream_delete(sort_stream);
   gt_node_stream_delete(gff3_in_stream);
 
   return had_err;
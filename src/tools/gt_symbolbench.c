@@ -0,0 +1,185 @@
+/*
+  Copyright (c) 2015 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include <stdint.h>
+#include <sys/time.h>
+#include "core/atomic.h"
+#include "core/cstr_api.h"
+#include "core/cstr_table_api.h"
+#include "core/ma.h"
+#include "core/multithread_api.h"
+#include "core/str_api.h"
+#include "core/symbol.h"
+#include "core/thread_api.h"
+#include "core/unused_api.h"
+#include "tools/gt_symbolbench.h"
+
+typedef struct {
+  GtUword symbols,
+          lookups;
+  bool baseline;
+} SymbolBenchArguments;
+
+typedef struct {
+  SymbolBenchArguments *arguments;
+  char **names;
+  GtCstrTable *table; /* only used by the baseline */
+  GtMutex *mutex;
+  unsigned int next_thread;
+} SymbolBenchInfo;
+
+static void* gt_symbolbench_arguments_new(void)
+{
+  SymbolBenchArguments *arguments = gt_calloc((size_t) 1, sizeof *arguments);
+  return arguments;
+}
+
+static void gt_symbolbench_arguments_delete(void *tool_arguments)
+{
+  SymbolBenchArguments *arguments = tool_arguments;
+  if (!arguments) return;
+  gt_free(arguments);
+}
+
+static GtOptionParser* gt_symbolbench_option_parser_new(void *tool_arguments)
+{
+  SymbolBenchArguments *arguments = tool_arguments;
+  GtOptionParser *op;
+  GtOption *option;
+  gt_assert(arguments);
+
+  op = gt_option_parser_new("[option ...]",
+                            "Benchmark interning symbols from concurrent "
+                            "threads.\nUse gt -j to set the number of "
+                            "threads.");
+
+  option = gt_option_new_uword_min("symbols", "number of distinct symbols",
+                                   &arguments->symbols, 10000, 1);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword("lookups", "number of lookups per thread",
+                               &arguments->lookups, 1000000);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_bool("baseline", "intern into a single string table "
+                              "guarded by a global mutex instead of using "
+                              "gt_symbol()", &arguments->baseline, false);
+  gt_option_parser_add_option(op, option);
+
+  gt_option_parser_set_max_args(op, 0);
+  return op;
+}
+
+static double gt_symbolbench_seconds(void)
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+static const char* gt_symbolbench_baseline(SymbolBenchInfo *info,
+                                           const char *cstr)
+{
+  const char *symbol;
+  gt_mutex_lock(info->mutex);
+  if (!(symbol = gt_cstr_table_get(info->table, cstr))) {
+    gt_cstr_table_add(info->table, cstr);
+    symbol = gt_cstr_table_get(info->table, cstr);
+  }
+  gt_mutex_unlock(info->mutex);
+  return symbol;
+}
+
+static void* gt_symbolbench_thread(void *data)
+{
+  SymbolBenchInfo *info = data;
+  GtUword i;
+  /* a private xorshift generator, rand() would serialize the threads */
+  uint64_t state = 0x9e3779b97f4a7c15ULL
+                   * (gt_atomic_increment(&info->next_thread) + 1);
+  for (i = 0; i < info->arguments->lookups; i++) {
+    const char *name, *symbol;
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    name = info->names[state % info->arguments->symbols];
+    if (info->arguments->baseline)
+      symbol = gt_symbolbench_baseline(info, name);
+    else
+      symbol = gt_symbol(name);
+    gt_assert(symbol);
+  }
+  return NULL;
+}
+
+static int gt_symbolbench_runner(GT_UNUSED int argc,
+                                 GT_UNUSED const char **argv,
+                                 GT_UNUSED int parsed_args,
+                                 void *tool_arguments, GtError *err)
+{
+  SymbolBenchArguments *arguments = tool_arguments;
+  SymbolBenchInfo info;
+  GtStr *name;
+  GtUword i;
+  double start, seconds;
+  int had_err;
+  gt_error_check(err);
+  gt_assert(arguments);
+
+  /* the prefix keeps the benchmark symbols apart from all others */
+  name = gt_str_new();
+  info.names = gt_malloc(arguments->symbols * sizeof (char*));
+  for (i = 0; i < arguments->symbols; i++) {
+    gt_str_reset(name);
+    gt_str_append_cstr(name, "symbolbench ");
+    gt_str_append_uword(name, i);
+    info.names[i] = gt_cstr_dup(gt_str_get(name));
+  }
+  gt_str_delete(name);
+  info.arguments = arguments;
+  info.table = arguments->baseline ? gt_cstr_table_new() : NULL;
+  info.mutex = gt_mutex_new();
+  info.next_thread = 0;
+
+  start = gt_symbolbench_seconds();
+  had_err = gt_multithread(gt_symbolbench_thread, &info, err);
+  seconds = gt_symbolbench_seconds() - start;
+  if (!had_err) {
+    GtUword total = gt_jobs * arguments->lookups;
+    printf("# %s\t%u threads\t"GT_WU" symbols\t"GT_WU" lookups\t%.3fs\t"
+           "%.2f Mlookups/s\n",
+           arguments->baseline ? "baseline" : "symbol", gt_jobs,
+           arguments->symbols, total, seconds,
+           seconds > 0.0 ? total / seconds / 1000000.0 : 0.0);
+  }
+
+  gt_mutex_delete(info.mutex);
+  gt_cstr_table_delete(info.table);
+  for (i = 0; i < arguments->symbols; i++)
+    gt_free(info.names[i]);
+  gt_free(info.names);
+  return had_err;
+}
+
+GtTool* gt_symbolbench(void)
+{
+  return gt_tool_new(gt_symbolbench_arguments_new,
+                     gt_symbolbench_arguments_delete,
+                     gt_symbolbench_option_parser_new,
+                     NULL,
+                     gt_symbolbench_runner);
+}
@@ -191,6 +191,117 @@ AATESTSEQS.each do |s|
   end
 end
 
+(DNATESTSEQS + AATESTSEQS).each do |s|
+  Name "gt encseq blockcompress #{s.split('/').last}"
+  Keywords "encseq gt_encseq_encode gt_encseq_decode blockcompress"
+  Test do
+    run_test "#{$bin}gt encseq encode -lossless -indexname ref #{s}"
+    run_test "#{$bin}gt encseq encode -lossless -sat blockcompress " + \
+             "-indexname bc #{s}"
+    run_test "#{$bin}gt encseq check bc"
+    readmodes = DNATESTSEQS.include?(s) ? DNAREADMODES : STDREADMODES
+    readmodes.each do |readmode|
+      run_test "#{$bin}gt encseq decode -dir #{readmode} bc"
+      run "#{$bin}gt encseq decode -dir #{readmode} ref | " + \
+          "diff - #{last_stdout}"
+    end
+    run_test "#{$bin}gt encseq decode -lossless bc"
+    run "#{$bin}gt encseq decode -lossless ref | diff - #{last_stdout}"
+  end
+end
+
+Name "gt encseq blockcompress similar genomes"
+Keywords "encseq gt_encseq_encode blockcompress"
+Test do
+  rng = Random.new(42)
+  genome = Array.new(50000) { "ACGT"[rng.rand(4)] }
+  File.open("genomes.fna", "w") do |f|
+    10.times do |g|
+      copy = genome.map { |c| rng.rand < 0.005 ? "ACGT"[rng.rand(4)] : c }
+      copy.insert(rng.rand(copy.length), "N" * 100)
+      f.puts ">genome#{g}", copy.join.scan(/.{1,70}/)
+    end
+  end
+  run_test "#{$bin}gt encseq encode -sat bit -indexname bit genomes.fna"
+  run_test "#{$bin}gt encseq encode -sat blockcompress -indexname bc " + \
+           "genomes.fna"
+  run_test "#{$bin}gt encseq check bc"
+  run_test "#{$bin}gt encseq decode bc"
+  run "#{$bin}gt encseq decode bit | diff - #{last_stdout}"
+  bcsize = File.size("bc.esq") + File.size("bc.bcs")
+  if bcsize * 3 > File.size("bit.esq")
+    raise "blockcompress uses #{bcsize} bytes, bit uses " + \
+          "#{File.size("bit.esq")} bytes"
+  end
+end
+
+Name "gt encseq blockcompress reproducible output"
+Keywords "encseq gt_encseq_encode blockcompress threads"
+Test do
+  inputs = "#{$testdata}Atinsert.fna #{$testdata}U89959_genomic.fas"
+  # MALLOC_PERTURB_ makes glibc fill new allocations with different bytes
+  [[1, 0], [1, 165], [4, 77]].each do |jobs, perturb|
+    run_test "env MALLOC_PERTURB_=#{perturb} #{$bin}gt -j #{jobs} " + \
+             "encseq encode -sat blockcompress -indexname bc#{jobs}_" + \
+             "#{perturb} #{inputs}"
+  end
+  run "cmp bc1_0.bcs bc1_165.bcs"
+  run "cmp bc1_0.bcs bc4_77.bcs"
+end
+
+Name "gt encseq blockcompress corrupt index"
+Keywords "encseq gt_encseq_decode blockcompress"
+Test do
+  run_test "#{$bin}gt encseq encode -sat blockcompress -indexname bc " + \
+           "#{$testdata}at1MB"
+  File.truncate("bc.bcs", File.size("bc.bcs") - 8)
+  run_test "#{$bin}gt encseq decode bc", :retval => 1
+  grep(last_stderr, /corrupt compressed sequence in bc.bcs/)
+  run_test "#{$bin}gt encseq encode -sat blockcompress -indexname bc " + \
+           "#{$testdata}at1MB"
+  File.open("bc.bcs", "r+b") { |f| f.write([~0].pack("Q")) }
+  run_test "#{$bin}gt encseq decode bc", :retval => 1
+  grep(last_stderr, /corrupt compressed sequence in bc.bcs/)
+end
+
+[["Atinsert.fna", "RandomN.fna", "Duplicate.fna", "Ecoli-section1.fna"],
+ ["sw100K1.fsa", "sw100K2.fsa"]].each do |files|
+  Name "gt encseq encode multiple files in parallel #{files.first}"
+  Keywords "encseq gt_encseq_encode threads"
+  Test do
+    inputs = files.map { |f| "#{$testdata}#{f}" }.join(" ")
+    [1, 4].each do |jobs|
+      run_test "#{$bin}gt -j #{jobs} encseq encode -des -sds -md5 " + \
+               "-lossless -indexname idx#{jobs} #{inputs}"
+    end
+    Dir.glob("idx1.*").each do |file|
+      run "cmp #{file} #{file.sub("idx1", "idx4")}"
+    end
+  end
+end
+
+
+# EMBL files must not contain blank lines only
+[["Atinsert.fna", "Duplicate.fna", "blank.fna"],
+ ["Atinsert.embl", "Duplicate.embl", "empty.fna"],
+ ["Atinsert.gbk", "Duplicate.gbk", "blank.fna"]].each do |first, last, empty|
+  Name "gt encseq encode multiple files in parallel with empty file " + \
+       "#{first.split('.').last}"
+  Keywords "encseq gt_encseq_encode threads"
+  Test do
+    File.open("empty.fna", "w") {}
+    File.open("blank.fna", "w") { |f| f.puts "", "  " }
+    inputs = "#{$testdata}#{first} empty.fna #{empty} " + \
+             "#{$testdata}#{last} empty.fna"
+    [1, 4].each do |jobs|
+      run_test "#{$bin}gt -j #{jobs} encseq encode -des -sds -md5 " + \
+               "-lossless -indexname idx#{jobs} #{inputs}"
+    end
+    Dir.glob("idx1.*").each do |file|
+      run "cmp #{file} #{file.sub("idx1", "idx4")}"
+    end
+  end
+end
 
 fastafiles = ["Atinsert.fna",
               "Duplicate.fna",
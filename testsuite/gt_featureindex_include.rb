@@ -65,4 +65,62 @@ if not $arguments["nordb"] then
     end
   end
 
+  [["chr1", 148000000, 148100000],
+   ["chr22", 30000000, 31000000],
+   ["chrX", 122500000, 122600000]].each do |seqid, from, to|
+    Name "gt featureindex range query vs. parser (#{seqid}:#{from}-#{to})"
+    Keywords "gt_featureindex"
+    Test do
+      file = "#{$testdata}/encode_known_genes_Mar07.gff3"
+      run "#{$bin}gt mkfeatureindex -filename tmp.db #{file}", :maxtime => 1200
+      # the index only returns the children overlapping the range as well,
+      # so compare the top-level features
+      run "#{$bin}gt featureindex -seqid #{seqid} -range #{from} #{to} " + \
+          "-retain no -filename tmp.db | awk '$3 == \"gene\"' > out.gff3"
+      run "#{$bin}gt gff3 -retainids no #{file} | " + \
+          "#{$bin}gt select -seqid #{seqid} -overlap #{from} #{to} | " + \
+          "awk '$3 == \"gene\"'"
+      run "diff out.gff3 #{last_stdout}"
+      run "grep -c . out.gff3"
+      grep(last_stdout, /^[1-9]/)
+    end
+  end
+
+  # databases created before the R*Tree was introduced get it on first open,
+  # read-only ones are queried through the B-tree indexes instead
+  if system("which sqlite3 > /dev/null 2>&1") then
+    [false, true].each do |readonly|
+      Name "gt featureindex (database without R*Tree, " + \
+           "#{readonly ? "read-only" : "writable"})"
+      Keywords "gt_featureindex"
+      Test do
+        file = "#{$testdata}/eden.gff3"
+        run "#{$bin}gt mkfeatureindex -filename tmp.db #{file}"
+        run "sqlite3 tmp.db 'DROP TABLE features_rtree'"
+        run "chmod a-w tmp.db" if readonly
+        run "#{$bin}gt featureindex -seqid ctg123 -range 1000 2000 " + \
+            "-retain no -filename tmp.db | awk '$3 == \"gene\"' > out.gff3"
+        run "#{$bin}gt gff3 -retainids no #{file} | " + \
+            "#{$bin}gt select -seqid ctg123 -overlap 1000 2000 | " + \
+            "awk '$3 == \"gene\"'"
+        run "diff out.gff3 #{last_stdout}"
+        run "grep -c . out.gff3"
+        grep(last_stdout, /^[1-9]/)
+        run "chmod u+w tmp.db" if readonly
+      end
+    end
+  end
+
+  Name "gt dev featureindexbench"
+  Keywords "gt_featureindex featureindexbench"
+  Test do
+    run_test "#{$bin}gt dev featureindexbench -filename bench.db " + \
+             "-queries 100 #{$testdata}/eden.gff3"
+    grep(last_stdout, /^# load\tbench.db/)
+    grep(last_stdout, /^# query\t100 queries/)
+    run_test "#{$bin}gt dev featureindexbench -filename bench.db " + \
+             "#{$testdata}/eden.gff3", :retval => 1
+    grep(last_stderr, /exists already/)
+  end
+
 end
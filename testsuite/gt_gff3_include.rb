@@ -323,6 +323,122 @@ Test do
   run "diff #{last_stdout} #{$testdata}addintrons.out"
 end
 
+Name "gt gff3 pipelined (-j 4 -sort -addintrons)"
+Keywords "gt_gff3 threads"
+Test do
+  run_test "#{$bin}gt gff3 -sort -addintrons " + \
+           "#{$testdata}encode_known_genes_Mar07.gff3"
+  run "mv #{last_stdout} sequential.gff3"
+  run_test "#{$bin}gt -j 4 gff3 -sort -addintrons " + \
+           "#{$testdata}encode_known_genes_Mar07.gff3"
+  run "diff #{last_stdout} sequential.gff3"
+end
+
+Name "gt gff3 pipelined (-j 4 -addintrons -setsource)"
+Keywords "gt_gff3 threads"
+Test do
+  run_test "#{$bin}gt gff3 -addintrons -setsource foo " + \
+           "#{$testdata}encode_known_genes_Mar07.gff3"
+  run "mv #{last_stdout} sequential.gff3"
+  run_test "#{$bin}gt -j 4 gff3 -addintrons -setsource foo " + \
+           "#{$testdata}encode_known_genes_Mar07.gff3"
+  run "diff #{last_stdout} sequential.gff3"
+end
+
+Name "gt gff3 pipelined (-j 4, error)"
+Keywords "gt_gff3 threads"
+Test do
+  run_test("#{$bin}gt -j 4 gff3 -sort -addintrons " + \
+           "#{$testdata}gt_gff3_fail_1.gff3", :retval => 1)
+end
+
+["fasta_seq.gff3", "minimal_fasta.gff3", "standard_gene_as_tree.gff3",
+ "encode_known_genes_Mar07.gff3"].each do |file|
+  Name "gt gff3 parallel parsing (#{file})"
+  Keywords "gt_gff3 threads"
+  Test do
+    run_test "#{$bin}gt gff3 #{$testdata}#{file}"
+    run "mv #{last_stdout} sequential.gff3"
+    run_test "#{$bin}gt -j 3 gff3 #{$testdata}#{file}"
+    run "diff #{last_stdout} sequential.gff3"
+    run_test "#{$bin}gt -j 3 gff3 < #{$testdata}#{file}"
+    run "diff #{last_stdout} sequential.gff3"
+  end
+end
+
+# the diagnostics do not depend on the parallel parsing either
+[["attribute_w_multiple_equals.gff3", 1, 1], ["blank_attributes.gff3", 0, 0],
+ ["empty_attribute_value.gff3", 1, 0],
+ ["illegal_uppercase_attribute.gff3", 1, 0],
+ ["gt_gff3_range_check.gff3", 1, 1], ["gt_gff3_undefined_range.gff3", 1, 0],
+ ["corrupt_large.gff3", 1, 1]].each do |file, retval, tidy_retval|
+  [["", retval], ["-tidy", tidy_retval]].each do |opt, rv|
+    Name "gt gff3 parallel parsing #{opt} (#{file})"
+    Keywords "gt_gff3 threads"
+    Test do
+      run_test "#{$bin}gt gff3 #{opt} #{$testdata}#{file}", :retval => rv
+      run "mv #{last_stderr} sequential.err"
+      run_test "#{$bin}gt -j 3 gff3 #{opt} #{$testdata}#{file}", :retval => rv
+      run "diff #{last_stderr} sequential.err"
+    end
+  end
+end
+
+Name "gt gff3 -sort -sortmemlimit"
+Keywords "gt_gff3 sortmemlimit"
+Test do
+  files = "#{$testdata}U89959_sas.gff3 " + \
+          "#{$testdata}encode_known_genes_Mar07.gff3 " + \
+          "#{$testdata}standard_gene_as_dag.gff3 " + \
+          "#{$testdata}standard_fasta_example.gff3"
+  run_test "#{$bin}gt gff3 -sort #{files}"
+  run "mv #{last_stdout} in_memory.gff3"
+  run_test "#{$bin}gt gff3 -sort -sortmemlimit 1 #{files}"
+  run "diff #{last_stdout} in_memory.gff3"
+end
+
+Name "gt gff3 -sort -sortmemlimit (multi-pass merge)"
+Keywords "gt_gff3 sortmemlimit"
+Test do
+  files = "#{$testdata}encode_known_genes_Mar07.gff3 " + \
+          "#{$testdata}U89959_sas.gff3"
+  run_test "#{$bin}gt gff3 -sort #{files}"
+  run "mv #{last_stdout} in_memory.gff3"
+  [2, 3].each do |fanin|
+    run_test "#{$bin}gt gff3 -sort -sortmemlimit 1 -sortfanin #{fanin} " + \
+             "#{files}"
+    run "diff #{last_stdout} in_memory.gff3"
+  end
+end
+
+Name "gt gff3 -sort -sortmemlimit (equal ranges)"
+Keywords "gt_gff3 sortmemlimit"
+Test do
+  # enough genes with equal ranges to spill several runs
+  File.open("ties.gff3", "w") do |f|
+    f.puts "##gff-version 3"
+    20000.times do |i|
+      start = (i % 7) * 100 + 1
+      f.puts "seq1\t.\tgene\t#{start}\t#{start + 50}\t.\t+\t.\t" + \
+             "Name=gene#{i};Note=#{"x" * 40}"
+    end
+  end
+  run_test "#{$bin}gt gff3 -sort ties.gff3"
+  run "mv #{last_stdout} in_memory.gff3"
+  [2, 16].each do |fanin|
+    run_test "#{$bin}gt gff3 -sort -sortmemlimit 1 -sortfanin #{fanin} " + \
+             "ties.gff3"
+    run "diff #{last_stdout} in_memory.gff3"
+  end
+end
+
+Name "gt gff3 -sortmemlimit (without -sort)"
+Keywords "gt_gff3 sortmemlimit"
+Test do
+  run_test("#{$bin}gt gff3 -sortmemlimit 1 #{$testdata}standard_gene_as_dag.gff3",
+           :retval => 1)
+end
+
 Name "gt gff3 test option -setsource"
 Keywords "gt_gff3"
 Test do
@@ -641,6 +757,30 @@ Test do
   run_test "#{$bin}gt gff3 -typecheck so #{obo_gff3_file}"
 end
 
+# exon and intron are transcript_region, which is part_of transcript, so
+# they are part_of mRNA through mRNA is_a mature_transcript is_a transcript
+Name "gt gff3 -typecheck so (inherited part_of)"
+Keywords "gt_gff3 typecheck"
+Test do
+  run_test "#{$bin}gt gff3 -typecheck so " +
+           "#{$testdata}typecheck_partof_inherited.gff3"
+end
+
+[["primary_transcript", "mRNA"],
+ ["mRNA", "polypeptide"],
+ ["exon", "intron"]].each_with_index do |types, i|
+  parent, child = types
+  Name "gt gff3 -typecheck so (inherited part_of, #{child} in #{parent})"
+  Keywords "gt_gff3 typecheck"
+  Test do
+    run_test("#{$bin}gt gff3 -typecheck so " +
+             "#{$testdata}typecheck_partof_inherited_fail#{i+1}.gff3",
+             :retval => 1)
+    grep last_stderr, "type '#{child}' on line 8 .* is not part-of parent " +
+                      "feature with type '#{parent}'"
+  end
+end
+
 Name "gt gff3 -typecheck so-xp"
 Keywords "gt_gff3 typecheck"
 Test do
@@ -37,6 +37,57 @@ Test do
   grep last_stdout, "input is valid GFF3"
 end
 
+Name "gt gff3validator -typecheck so.obo (cached)"
+Keywords "gt_gff3validator typecheck"
+Test do
+  run "mkdir cache"
+  run_test "env GT_OBO_CACHE_DIR=cache #{$bin}gt gff3validator -typecheck so " +
+           "#{$testdata}transient_edges_bug.gff3"
+  grep last_stdout, "input is valid GFF3"
+  run "ls cache/*.gtobo"
+  run_test "env GT_OBO_CACHE_DIR=cache #{$bin}gt gff3validator -typecheck so " +
+           "#{$testdata}transient_edges_bug.gff3"
+  grep last_stdout, "input is valid GFF3"
+  run_test("env GT_OBO_CACHE_DIR=cache #{$bin}gt gff3validator -typecheck so " +
+           "#{$testdata}typecheck_not_partof.gff3", :retval => 1)
+  grep last_stderr, "is not part-of parent feature with type 'CDS'"
+end
+
+Name "gt gff3validator -typecheck so.obo (new cache directory)"
+Keywords "gt_gff3validator typecheck"
+Test do
+  run_test "env GT_OBO_CACHE_DIR=new/cache #{$bin}gt gff3validator " +
+           "-typecheck so #{$testdata}transient_edges_bug.gff3"
+  grep last_stdout, "input is valid GFF3"
+  run "ls new/cache/*.gtobo"
+end
+
+Name "gt gff3validator -typecheck so.obo (stale temporary cache files)"
+Keywords "gt_gff3validator typecheck"
+Test do
+  run "mkdir cache"
+  run "touch -t 200001010000 cache/0123456789abcdef0123456789abcdef.gtobo.42"
+  run "touch cache/fedcba9876543210fedcba9876543210.gtobo.43"
+  run_test "env GT_OBO_CACHE_DIR=cache #{$bin}gt gff3validator -typecheck so " +
+           "#{$testdata}transient_edges_bug.gff3"
+  grep last_stdout, "input is valid GFF3"
+  run "test ! -e cache/0123456789abcdef0123456789abcdef.gtobo.42"
+  run "test -e cache/fedcba9876543210fedcba9876543210.gtobo.43"
+  run "ls cache/*.gtobo"
+end
+
+Name "gt gff3validator -typecheck so.obo (corrupt cache)"
+Keywords "gt_gff3validator typecheck"
+Test do
+  run "mkdir cache"
+  run_test "env GT_OBO_CACHE_DIR=cache #{$bin}gt gff3validator -typecheck so " +
+           "#{$testdata}transient_edges_bug.gff3"
+  run "for f in cache/*.gtobo; do head -c 1000 $f > tmp; mv tmp $f; done"
+  run_test "env GT_OBO_CACHE_DIR=cache #{$bin}gt gff3validator -typecheck so " +
+           "#{$testdata}transient_edges_bug.gff3"
+  grep last_stdout, "input is valid GFF3"
+end
+
 Name "gt gff3validator corrupt file"
 Keywords "gt_gff3validator"
 Test do
@@ -54,6 +54,26 @@ Test do
   end
 end
 
+[["-dna", "Ecoli-section1.fna", "Ecoli-section2.fna", "-l 0 1 1"],
+ ["-dna", "Ecoli-section1.fna", "Ecoli-section2.fna", "-a 0 4 4 1"],
+ ["-protein", "nGASP/protein_10.fas", "nGASP/protein_short.fas",
+  "-l #{$testdata}BLOSUM62 \" -1\""],
+ ["-protein", "nGASP/protein_10.fas", "nGASP/protein_short.fas",
+  "-a #{$testdata}BLOSUM62 \" -3\" \" -1\""]].each do |type, f1, f2, costs|
+  Name "gt linspace_align global #{type} #{costs} (with and without SIMD)"
+  Keywords "gt_linspace_align simd"
+  Test do
+    run_test "#{$bin}gt dev linspace_align -ff #{$testdata}#{f1} " \
+             "#{$testdata}#{f2} #{type} -global #{costs} -showscore " \
+             "-simd no", :maxtime => 180
+    temp = last_stdout
+    run_test "#{$bin}gt dev linspace_align -ff #{$testdata}#{f1} " \
+             "#{$testdata}#{f2} #{type} -global #{costs} -showscore",
+             :maxtime => 180
+    run "diff #{last_stdout} #{temp}"
+  end
+end
+
 1.upto(3) do |i|
   Name "gt linspace_align local lin gap test #{i}"
   Keywords "gt_linspace_align"
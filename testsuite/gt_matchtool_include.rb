@@ -117,3 +117,12 @@ Test do
   run_test "#{$bin}gt matchtool -type BLASTOUT -matchfile #{$testdata}matchtool_blast.match.bz2"
   run "diff #{last_stdout} #{$testdata}matchtool_blast.out"
 end
+
+Name "gt matchtool test (Smith-Waterman)"
+Keywords "gt_matchtool sw"
+Test do
+  run_test "#{$bin}gt encseq encode -indexname cds #{$testdata}U89959_cds.fas"
+  run_test "#{$bin}gt matchtool -type SW -db cds -query cds -swminlen 30 " +
+           "-swmaxedist 2"
+  run "diff #{last_stdout} #{$testdata}matchtool_sw_cds.out"
+end
@@ -0,0 +1,32 @@
+["block", "line", "char", "copy"].each do |mode|
+  Name "gt readbench (-mode #{mode})"
+  Keywords "gt_readbench"
+  Test do
+    run_test "#{$bin}gt dev readbench -mode #{mode} -runs 2 " + \
+             "#{$testdata}matchtool_blast.match " + \
+             "#{$testdata}matchtool_blast.match.gz " + \
+             "#{$testdata}matchtool_blast.match.bz2"
+    run "cut -f 3,7 #{last_stdout} | uniq | wc -l"
+    grep(last_stdout, /^\s*1$/)
+  end
+end
+
+["block", "line"].each do |mode|
+  Name "gt readbench (-mode #{mode}, read-ahead)"
+  Keywords "gt_readbench readahead"
+  Test do
+    run_test "#{$bin}gt -j 4 dev readbench -mode #{mode} " + \
+             "#{$testdata}matchtool_blast.match " + \
+             "#{$testdata}matchtool_blast.match.gz " + \
+             "#{$testdata}matchtool_blast_bgzf.match.gz " + \
+             "#{$testdata}matchtool_blast.match.bz2"
+    run "cut -f 3,7 #{last_stdout} | uniq | wc -l"
+    grep(last_stdout, /^\s*1$/)
+  end
+end
+
+Name "gt readbench (nonexistent file)"
+Keywords "gt_readbench"
+Test do
+  run_test("#{$bin}gt dev readbench nonexistent_file", :retval => 1)
+end
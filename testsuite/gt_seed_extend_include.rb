@@ -11,6 +11,35 @@ def split_output(key)
   grep "#{key}.coords", /^\d+ \d+ \d+ \d+ \d+ \d+ \d+\.\d+$/
 end
 
+# Write <number> sequences to db.fna and mutated copies of them to
+# query.fna. The first and last 20 bases are not mutated, so that the
+# best alignment of each pair covers both sequences completely.
+def gen_mutated_pairs(seed, number, errperc)
+  rgen = Random.new(seed)
+  alphabet = "acgt"
+  File.open("db.fna", "w") do |fpdb|
+    File.open("query.fna", "w") do |fpquery|
+      number.times do |seqnum|
+        len = 150 + rgen.rand(250)
+        dbseq = Array.new(len) { alphabet[rgen.rand(4)] }.join
+        queryseq = dbseq.chars.each_with_index.map do |cc, idx|
+          if idx < 20 or idx >= len - 20 or rgen.rand * 100 >= errperc
+            cc
+          else
+            case rgen.rand(3)
+            when 0 then alphabet[rgen.rand(4)]
+            when 1 then ""
+            else cc + alphabet[rgen.rand(4)]
+            end
+          end
+        end.join
+        fpdb.puts ">db#{seqnum}\n#{dbseq}"
+        fpquery.puts ">query#{seqnum}\n#{queryseq}"
+      end
+    end
+  end
+end
+
 seeds = [170039800390891361279027638963673934519,
          189224055964190192145211745471700259490,
          80497492730600996116307599313171942911,
@@ -137,6 +166,56 @@ Test do
   end
 end
 
+# Bit-parallel extension
+Name "gt seed_extend: bitparallel, history, maxalilendiff, cam"
+Keywords "gt_seed_extend extendgreedy bitparallel"
+Test do
+  run_test build_encseq("at1MB", "#{$testdata}at1MB")
+  for history in [10, 64] do
+    for maxalilendiff in [0, 10] do
+      for cam in ["encseq", "encseq_reader"] do
+        run_test "#{$bin}gt seed_extend -bitparallel -history #{history} " +
+                 "-maxalilendiff #{maxalilendiff} -cam #{cam} -a " +
+                 "-verify-alignment -ii at1MB", :retval => 0
+      end
+    end
+  end
+  run_test "#{$bin}gt seed_extend -bitparallel -extendxdrop -ii at1MB",
+           :retval => 1
+end
+
+# Compare bit-parallel extension with greedy and xdrop extension
+Name "gt seed_extend: bitparallel, compare with greedy and xdrop"
+Keywords "gt_seed_extend extendgreedy extendxdrop bitparallel"
+Test do
+  for seed in seeds[0..3] do
+    for errperc in [2, 8, 12] do
+      gen_mutated_pairs(seed, 10, errperc)
+      run_test build_encseq("query", "query.fna")
+      run_test build_encseq("db", "db.fna")
+      ["extendgreedy", "extendxdrop", "bitparallel"].each do |ext|
+        run_test "#{$bin}gt seed_extend -#{ext} -l 100 -no-reverse " +
+                 "-ii db -qii query -kmerfile no"
+        run "grep '^[0-9]' #{last_stdout}"
+        run "sort #{last_stdout}"
+        run "mv #{last_stdout} #{ext}.matches"
+        run "cut -f 1-7 -d ' ' #{ext}.matches"
+        run "mv #{last_stdout} #{ext}.coords"
+      end
+      # the extensions must end at the same positions
+      run "cmp -s bitparallel.coords extendgreedy.coords"
+      run "cmp -s bitparallel.coords extendxdrop.coords"
+      # the exact distance must not exceed the one of the greedy alignment
+      File.readlines("bitparallel.matches").
+        zip(File.readlines("extendgreedy.matches")).each do |bp, greedy|
+        if bp.split[8].to_i > greedy.split[8].to_i
+          raise TestFailed, "bitparallel distance exceeds greedy distance"
+        end
+      end
+    end
+  end
+end
+
 # Invalid arguments
 Name "gt seed_extend: failure"
 Keywords "gt_seed_extend failure"
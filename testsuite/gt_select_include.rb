@@ -357,6 +357,39 @@ Name "gt select test (dropped to file (4))"
    run "diff nh_file04.gff3 #{$testdata}filter_nh_file04.gff3"
 end
 
+Name "gt select test (-rule_files, -j 4)"
+Keywords "gt_select"
+Test do
+  run_test "#{$bin}gt -j 4 select -dropped_file nh_file01.gff3 -rule_files " +
+           "#{$testdata}gtscripts/filter_test_orflength.lua -- " +
+           "#{$testdata}filter_luafilter_test.gff3"
+  run "diff #{last_stdout} #{$testdata}filter_luafilter_filtered_orfs.gff3"
+  run "diff nh_file01.gff3 #{$testdata}filter_nh_file01.gff3"
+end
+
+Name "gt select test (-rule_files, -j 4, many nodes)"
+Keywords "gt_select"
+Test do
+  run_test "#{$bin}gt select -strand + -dropped_file dropped_j1.gff3 " +
+           "-rule_files #{$testdata}gtscripts/filter_test_nodetype.lua -- " +
+           "#{$testdata}encode_known_genes_Mar07.gff3"
+  run "mv #{last_stdout} selected_j1.gff3"
+  run_test "#{$bin}gt -j 4 select -strand + -dropped_file dropped_j4.gff3 " +
+           "-rule_files #{$testdata}gtscripts/filter_test_nodetype.lua -- " +
+           "#{$testdata}encode_known_genes_Mar07.gff3"
+  run "diff #{last_stdout} selected_j1.gff3"
+  run "diff dropped_j4.gff3 dropped_j1.gff3"
+end
+
+Name "gt select test (-rule_files, -j 4, wrong function name)"
+Keywords "gt_select"
+Test do
+  run_test "#{$bin}gt -j 4 select -rule_files " +
+           "#{$testdata}gtscripts/filter_test_wrong_function_name.lua -- " +
+           "#{$testdata}encode_known_genes_Mar07.gff3", :retval => 1
+  grep last_stderr, /error/
+end
+
 Name "gt select test (lua syntax fail)"
 Keywords "gt_select"
 Test do
@@ -14,6 +14,24 @@ Test do
   run "test -e out.png"
 end
 
+Name "gt sketch short test (feature index file)"
+Keywords "gt_sketch feature_index"
+Test do
+  ["png", "svg"].each do |format|
+    run_test "#{$bin}gt sketch -showrecmaps -format #{format} " + \
+             "-writeindex idx ref.#{format} " + \
+             "#{$testdata}gff3_file_1_short.txt", :maxtime => 600
+    run "mv #{last_stdout} ref.recmaps"
+    run_test "#{$bin}gt sketch -showrecmaps -format #{format} " + \
+             "-input index out.#{format} idx", :maxtime => 600
+    run "diff #{last_stdout} ref.recmaps"
+    run "cmp out.#{format} ref.#{format}"
+  end
+  run_test "#{$bin}gt sketch -input index out.png " + \
+           "#{$testdata}gff3_file_1_short.txt", :retval => 1
+  grep(last_stderr, /is not a feature index file/)
+end
+
 Name "gt sketch short test (unknown output format)"
 Keywords "gt_sketch"
 Test do
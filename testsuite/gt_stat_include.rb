@@ -101,3 +101,24 @@ Keywords "gt_stat"
 Test do
   run_test "#{$bin}gt stat #{$testdata}minimal_fasta.gff3"
 end
+
+# the statistics do not depend on whether the features are packed
+["standard_gene_as_tree.gff3", "standard_gene_as_dag.gff3",
+ "standard_fasta_example_with_id.gff3", "encode_known_genes_Mar07.gff3",
+ "gt_eval_ltr_test_1.in", "multi_feature_simple.gff3"].each do |file|
+  Name "gt stat -packed (#{file})"
+  Keywords "gt_stat packed"
+  Test do
+    options = "-genelengthdistri -genescoredistri -exonlengthdistri " +
+              "-exonnumberdistri -intronlengthdistri -cdslengthdistri -source"
+    run_test "#{$bin}gt stat #{options} #{$testdata}#{file}"
+    run "mv #{last_stdout} unpacked.out"
+    run_test "#{$bin}gt stat -packed #{options} #{$testdata}#{file}"
+    run "diff #{last_stdout} unpacked.out"
+    run_test "#{$bin}gt stat -addintrons #{options} #{$testdata}#{file}"
+    run "mv #{last_stdout} unpacked.out"
+    run_test "#{$bin}gt stat -packed -addintrons #{options} " +
+             "#{$testdata}#{file}"
+    run "diff #{last_stdout} unpacked.out"
+  end
+end
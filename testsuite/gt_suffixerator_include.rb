@@ -283,6 +283,72 @@ Test do
   end
 end
 
+Name "gt suffixerator -j 4 same as -j 1"
+Keywords "gt_suffixerator threads"
+Test do
+  ["at1MB","Atinsert.fna","sw100K1.fsa"].each do |filename|
+    [1,3].each do |parts|
+      ["","-dc 64"].each do |dcarg|
+        [1,4].each do |jobs|
+          run_test "#{$bin}gt -j #{jobs} suffixerator -pl -parts #{parts} " +
+                   "#{dcarg} #{outoptions} -indexname sfx#{jobs} " +
+                   "-db #{$testdata}#{filename}"
+        end
+        ["suf","lcp","llv","bwt","bck"].each do |suffix|
+          run "cmp sfx1.#{suffix} sfx4.#{suffix}"
+        end
+      end
+    end
+  end
+  run_test "#{$bin}gt dev sfxmap #{outoptions} -v -esa sfx4", :maxtime => 600
+end
+
+Name "gt dev esalcp same as gt suffixerator -lcp"
+Keywords "gt_suffixerator esalcp"
+Test do
+  ["at1MB","Atinsert.fna","Duplicate.fna","sw100K1.fsa"].each do |filename|
+    run_test "#{$bin}gt suffixerator -suf -lcp -tis -indexname sfx " +
+             "-db #{$testdata}#{filename}"
+    ["lcp","llv"].each do |suffix|
+      run "cp sfx.#{suffix} ref.#{suffix}"
+    end
+    ["","-memlimit 1MB"].each do |memlimit|
+      [1,4].each do |jobs|
+        run_test "#{$bin}gt -j #{jobs} dev esalcp -ii sfx #{memlimit}"
+        ["lcp","llv"].each do |suffix|
+          run "cmp sfx.#{suffix} ref.#{suffix}"
+        end
+      end
+    end
+    run_test "#{$bin}gt dev sfxmap -suf -lcp -tis -v -esa sfx",
+             :maxtime => 600
+  end
+end
+
+Name "gt dev sain -j 4 same as -j 1 and gt suffixerator"
+Keywords "gt_suffixerator sain threads"
+Test do
+  ["at100K1","Atinsert.fna","at1MB"].each do |filename|
+    [1,4].each do |jobs|
+      run_test "#{$bin}gt -j #{jobs} dev sain -suf -fcheck -dna " +
+               "-fasta #{$testdata}#{filename}"
+      run "mv #{filename}.suf sain#{jobs}.suf"
+    end
+    run "cmp sain1.suf sain4.suf"
+    run_test "#{$bin}gt suffixerator -suf -dna -indexname sfx " +
+             "-db #{$testdata}#{filename}"
+    # gt dev sain stores 32-bit entries, gt suffixerator GtUword entries
+    sainsuftab = File.binread("sain1.suf").unpack("L*")
+    sfxsuftab = File.binread("sfx.suf")
+    sfxsuftab = sfxsuftab.unpack(sfxsuftab.length == 4 * sainsuftab.length ?
+                                 "L*" : "Q*")
+    if sainsuftab != sfxsuftab
+      raise TestFailed, "suffix arrays of gt dev sain and gt suffixerator " +
+                        "differ for #{filename}"
+    end
+  end
+end
+
 Name "gt suffixerator bwt"
 Keywords "gt_suffixerator"
 Test do
@@ -392,7 +458,8 @@ if $gttestdata then
               "TransProt11")
 end
 
-SATS = ["direct", "bytecompress", "eqlen", "bit", "uchar", "ushort", "uint32"]
+SATS = ["direct", "bytecompress", "eqlen", "bit", "uchar", "ushort", "uint32",
+        "blockcompress"]
 
 EQLENDNAFILE = {:filename => "#{$testdata}test1.fasta",
                 :desc => "equal length DNA",
@@ -0,0 +1,11 @@
+["", "-baseline"].each do |opt|
+  Name "gt symbolbench #{opt}"
+  Keywords "gt_symbolbench"
+  Test do
+    [1, 4].each do |jobs|
+      run "#{$bin}gt -j #{jobs} dev symbolbench #{opt} -symbols 1000 " +
+          "-lookups 10000"
+      grep last_stdout, /#{jobs} threads\t1000 symbols\t#{jobs * 10000} lookups/
+    end
+  end
+end